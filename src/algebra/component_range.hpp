@@ -0,0 +1,136 @@
+// LITMUS: An Automated Molecular Integrals Generator
+// Copyright 2022 Z. Rinkevicius, KTH, Sweden.
+// E-mail: rinkevic@kth.se
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef component_range_hpp
+#define component_range_hpp
+
+#include <cstddef>
+#include <iterator>
+
+/// Lazy view over the components of a tensor like object in canonical order
+/// (the order of its components() vector). The i-th component is built on
+/// dereference by the owner's index accessor, so iterating the view allocates
+/// no vector of components. The view keeps a copy of the owner, so it stays
+/// valid when created from a temporary.
+template <class T, class C>
+class ComponentRange
+{
+public:
+    /// The index accessor of the owner, e.g. &Tensor::component.
+    using Accessor = C (T::*)(const int) const;
+
+    /// Forward iterator over the component indices of the view.
+    class Iterator
+    {
+        /// The view being iterated.
+        const ComponentRange* _range;
+
+        /// The canonical index of the current component.
+        int _index;
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+
+        using value_type = C;
+
+        using difference_type = std::ptrdiff_t;
+
+        using pointer = void;
+
+        using reference = C;
+
+        /// Creates an iterator at the given canonical index of a view.
+        /// @param range The view to iterate.
+        /// @param index The canonical index of the current component.
+        Iterator(const ComponentRange* range, const int index) : _range(range), _index(index) {}
+
+        /// Builds the current component.
+        /// @return The current component.
+        C operator*() const { return (*_range)[_index]; }
+
+        /// Advances to the next component.
+        /// @return This iterator.
+        Iterator& operator++()
+        {
+            _index++;
+
+            return *this;
+        }
+
+        /// Advances to the next component.
+        /// @return The iterator before advancing.
+        Iterator operator++(int)
+        {
+            auto other = *this;
+
+            _index++;
+
+            return other;
+        }
+
+        /// Compares this iterator with other iterator.
+        /// @param other The other iterator to compare.
+        /// @return true if iterators are equal, false otherwise.
+        bool operator==(const Iterator& other) const { return _index == other._index; }
+
+        /// Compares this iterator with other iterator.
+        /// @param other The other iterator to compare.
+        /// @return true if iterators are not equal, false otherwise.
+        bool operator!=(const Iterator& other) const { return _index != other._index; }
+    };
+
+private:
+    /// The owner of the components.
+    T _owner;
+
+    /// The index accessor of the owner.
+    Accessor _accessor;
+
+    /// The number of components.
+    int _size;
+
+public:
+    /// Creates a view over the components of an owner.
+    /// @param owner The owner of the components.
+    /// @param accessor The index accessor of the owner.
+    /// @param size The number of components of the owner.
+    ComponentRange(const T& owner, const Accessor accessor, const int size)
+        : _owner(owner), _accessor(accessor), _size(size)
+    {
+    }
+
+    /// Builds the component at a canonical index.
+    /// @param index The canonical index of the component.
+    /// @return The component.
+    C operator[](const int index) const { return (_owner.*_accessor)(index); }
+
+    /// Gets the number of components in this view.
+    /// @return The number of components.
+    std::size_t size() const { return static_cast<std::size_t>(_size); }
+
+    /// Checks if this view is empty.
+    /// @return true if this view has no components, false otherwise.
+    bool empty() const { return _size == 0; }
+
+    /// @return The iterator at the first component.
+    Iterator begin() const { return Iterator(this, 0); }
+
+    /// @return The iterator past the last component.
+    Iterator end() const { return Iterator(this, _size); }
+};
+
+#endif /* component_range_hpp */
@@ -23,6 +23,7 @@
 #include "operator.hpp"
 #include "integral_component.hpp"
 #include "components.hpp"
+#include "component_range.hpp"
 
 /// Integral class.
 template <class T, class U>
@@ -172,6 +173,22 @@ public:
     template <class V, class W>
     VIntegralComponents<V, W> components() const;
     
+    /// Gets number of integral components, the product of prefix, integrand,
+    /// bra and ket component counts, without creating them.
+    /// @return The number of integral components.
+    int number_of_components() const;
+    
+    /// Creates the integral component at the given position of components().
+    /// @param index The canonical index of integral component.
+    /// @return The integral component.
+    template <class V, class W>
+    IntegralComponent<V, W> component(const int index) const;
+    
+    /// Creates a lazy view of integral components in canonical order.
+    /// @return The range of integral components.
+    template <class V, class W>
+    ComponentRange<Integral, IntegralComponent<V, W>> component_range() const;
+    
     /// Creates a vector with diagonal integral components of this integral.
     /// @return The vector of integral components.
     template <class V, class W>
@@ -467,7 +484,7 @@ template <class T, class U>
 bool
 Integral<T, U>::is_simple_integrand() const
 {
-    return _integrand.components().size() == 1;
+    return _integrand.number_of_components() == 1;
 }
 
 template <class T, class U>
@@ -552,37 +569,85 @@ Integral<T, U>::components() const
 {
     VIntegralComponents<V, W> vcomps;
     
-    if (!_prefixes.empty())
+    vcomps.reserve(number_of_components());
+    
+    for (const auto& tcomp : component_range<V, W>())
     {
-        for (const auto& prefix : make_components<OperatorComponent>(_prefixes))
-        {
-            for (const auto& opcomp : _integrand.components())
-            {
-                for (const auto& bra : _bra.components())
-                {
-                    for (const auto& ket : _ket.components())
-                    {
-                        vcomps.push_back(IntegralComponent<V, W>(bra, ket, opcomp, _order, prefix));
-                    }
-                }
-            }
-        }
+        vcomps.push_back(tcomp);
     }
-    else
+    
+    return vcomps;
+}
+
+template <class T, class U>
+int
+Integral<T, U>::number_of_components() const
+{
+    int ncomps = _integrand.number_of_components() * _bra.number_of_components() * _ket.number_of_components();
+    
+    for (const auto& prefix : _prefixes)
     {
-        for (const auto& opcomp : _integrand.components())
-        {
-            for (const auto& bra : _bra.components())
-            {
-                for (const auto& ket : _ket.components())
-                {
-                    vcomps.push_back(IntegralComponent<V, W>(bra, ket, opcomp, _order));
-                }
-            }
-        }
+        ncomps *= prefix.number_of_components();
     }
     
-    return vcomps;
+    return ncomps;
+}
+
+template <class T, class U>
+template <class V, class W>
+IntegralComponent<V, W>
+Integral<T, U>::component(const int index) const
+{
+    // mixed radix decomposition of index: ket components run fastest, then bra,
+    // integrand, and prefix components (the last prefix fastest)
+    
+    const auto nkets = _ket.number_of_components();
+    
+    const auto nbras = _bra.number_of_components();
+    
+    const auto nops = _integrand.number_of_components();
+    
+    int offset = index;
+    
+    const auto ket = _ket.component(offset % nkets);
+    
+    offset /= nkets;
+    
+    const auto bra = _bra.component(offset % nbras);
+    
+    offset /= nbras;
+    
+    const auto opcomp = _integrand.component(offset % nops);
+    
+    offset /= nops;
+    
+    if (_prefixes.empty())
+    {
+        return IntegralComponent<V, W>(bra, ket, opcomp, _order);
+    }
+    
+    VOperatorComponents prefix(_prefixes.size());
+    
+    for (size_t i = _prefixes.size(); i > 0; i--)
+    {
+        const auto npcomps = _prefixes[i - 1].number_of_components();
+        
+        prefix[i - 1] = _prefixes[i - 1].component(offset % npcomps);
+        
+        offset /= npcomps;
+    }
+    
+    return IntegralComponent<V, W>(bra, ket, opcomp, _order, prefix);
+}
+
+template <class T, class U>
+template <class V, class W>
+ComponentRange<Integral<T, U>, IntegralComponent<V, W>>
+Integral<T, U>::component_range() const
+{
+    return ComponentRange<Integral<T, U>, IntegralComponent<V, W>>(*this,
+                                                                   &Integral<T, U>::template component<V, W>,
+                                                                   number_of_components());
 }
 
 template <class T, class U>
@@ -138,3 +138,15 @@ OneCenter::components() const
     
     return tcomps;
 }
+
+int
+OneCenter::number_of_components() const
+{
+    return _shape.number_of_components();
+}
+
+OneCenterComponent
+OneCenter::component(const int index) const
+{
+    return OneCenterComponent(_name, _shape.component(index));
+}
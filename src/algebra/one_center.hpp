@@ -98,6 +98,15 @@ public:
     /// Creates a vector with one center expansion components of this one center expansion.
     /// @return The vector of one center expansion components.
     VOneCenterComponents components() const;
+    
+    /// Gets number of one center expansion components without creating them.
+    /// @return The number of one center expansion components.
+    int number_of_components() const;
+    
+    /// Creates the one center expansion component at the given position of components().
+    /// @param index The canonical index of one center expansion component.
+    /// @return The one center expansion component.
+    OneCenterComponent component(const int index) const;
 };
 
 #endif /* one_center_hpp */
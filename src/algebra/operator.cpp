@@ -165,3 +165,21 @@ Operator::components() const
     
     return opcomps;
 }
+
+int
+Operator::number_of_components() const
+{
+    return _shape.number_of_components();
+}
+
+OperatorComponent
+Operator::component(const int index) const
+{
+    return OperatorComponent(_name, _shape.component(index), _target, _center);
+}
+
+ComponentRange<Operator, OperatorComponent>
+Operator::component_range() const
+{
+    return ComponentRange<Operator, OperatorComponent>(*this, &Operator::component, number_of_components());
+}
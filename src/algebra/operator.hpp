@@ -98,6 +98,19 @@ public:
     /// Creates a vector with operator components of this operator.
     /// @return The vector of operator components.
     VOperatorComponents components() const;
+    
+    /// Gets number of operator components without creating them.
+    /// @return The number of operator components.
+    int number_of_components() const;
+    
+    /// Creates the operator component at the given position of components().
+    /// @param index The canonical index of operator component.
+    /// @return The operator component.
+    OperatorComponent component(const int index) const;
+    
+    /// Creates a lazy view of operator components in canonical order.
+    /// @return The range of operator components.
+    ComponentRange<Operator, OperatorComponent> component_range() const;
 };
 
 using VOperators = std::vector<Operator>;
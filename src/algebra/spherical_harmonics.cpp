@@ -358,6 +358,30 @@ solid_harmonic(const int l, const int m, std::map<std::pair<int, int>, Polynomia
     return memo.emplace(key, std::move(out)).first->second;
 }
 
+/// Computes the integral of the monomial u_x^a u_y^b u_z^c over the unit
+/// sphere, divided by 4pi: (a - 1)!! (b - 1)!! (c - 1)!! / (a + b + c + 1)!!
+/// for even powers, zero otherwise.
+/// @param a The power of u_x.
+/// @param b The power of u_y.
+/// @param c The power of u_z.
+/// @return The integral over the unit sphere divided by 4pi.
+double
+sphere_monomial(const int a, const int b, const int c)
+{
+    if ((a % 2 == 1) || (b % 2 == 1) || (c % 2 == 1)) return 0.0;
+
+    double value = 1.0;
+
+    for (const auto power : {a, b, c})
+    {
+        for (int i = power - 1; i > 1; i -= 2) value *= i;
+    }
+
+    for (int i = a + b + c + 1; i > 1; i -= 2) value /= i;
+
+    return value;
+}
+
 }  // namespace
 
 SphericalFactor::SphericalFactor()
@@ -481,4 +505,33 @@ two_center_spherical_factors(const int la,
     return terms;
 }
 
+double
+angular_integral(const int              l,
+                 const int              m,
+                 const int              lambda,
+                 const int              mu,
+                 const TensorComponent& monomial)
+{
+    // with Y = sqrt((2l + 1) / 4pi) S, the 4pi of the sphere integral cancels
+    // against the two normalization factors.
+
+    double value = 0.0;
+
+    for (const auto& [lcomp, lfact] : spherical_factors(l, m))
+    {
+        for (const auto& [rcomp, rfact] : spherical_factors(lambda, mu))
+        {
+            const auto a = lcomp['x'] + rcomp['x'] + monomial['x'];
+
+            const auto b = lcomp['y'] + rcomp['y'] + monomial['y'];
+
+            const auto c = lcomp['z'] + rcomp['z'] + monomial['z'];
+
+            value += lfact.value() * rfact.value() * sphere_monomial(a, b, c);
+        }
+    }
+
+    return std::sqrt(static_cast<double>((2 * l + 1) * (2 * lambda + 1))) * value;
+}
+
 }  // namespace sphar
@@ -141,6 +141,28 @@ VSphericalPairTerms two_center_spherical_factors(const int la,
                                                  const int bra_component,
                                                  const int ket_component);
 
+/// Computes the angular integral of two unit-normalized real spherical
+/// harmonics and a Cartesian monomial over the unit sphere,
+///
+///     Omega = int Y_{l,m}(u) Y_{lambda,mu}(u) u_x^i u_y^j u_z^k dOmega,
+///
+/// which is the angular factor of a semilocal (projected) ECP integral: the
+/// projector carries Y_{l,m}, and the shell expanded about the ECP center
+/// contributes Y_{lambda,mu} and the monomial. The harmonics are the solid
+/// harmonics above scaled by sqrt((2l + 1) / 4pi).
+/// @param l The projector angular momentum (l >= 0).
+/// @param m The projector order, with -l <= m <= l.
+/// @param lambda The expansion angular momentum (lambda >= 0).
+/// @param mu The expansion order, with -lambda <= mu <= lambda.
+/// @param monomial The Cartesian monomial u_x^i u_y^j u_z^k.
+/// @return The angular integral (zero when either (l, m) or (lambda, mu) is
+///         out of range).
+double angular_integral(const int              l,
+                        const int              m,
+                        const int              lambda,
+                        const int              mu,
+                        const TensorComponent& monomial);
+
 }  // namespace sphar
 
 #endif /* spherical_harmonics_hpp */
@@ -107,3 +107,40 @@ Tensor::components() const
     
     return vtcomps;
 }
+
+int
+Tensor::number_of_components() const
+{
+    return (_order + 1) * (_order + 2) / 2;
+}
+
+TensorComponent
+Tensor::component(const int index) const
+{
+    // components are ordered by descending x, then descending y axial value:
+    // the block with axial value ax along X holds order - ax + 1 components
+    
+    int offset = index;
+    
+    for (int ax = _order; ax >= 0; ax--)
+    {
+        if (const int nyz = _order - ax + 1; offset < nyz)
+        {
+            const int ay = _order - ax - offset;
+            
+            return TensorComponent(ax, ay, _order - ax - ay);
+        }
+        else
+        {
+            offset -= nyz;
+        }
+    }
+    
+    return TensorComponent();
+}
+
+ComponentRange<Tensor, TensorComponent>
+Tensor::component_range() const
+{
+    return ComponentRange<Tensor, TensorComponent>(*this, &Tensor::component, number_of_components());
+}
@@ -20,6 +20,7 @@
 #include <string>
 
 #include "tensor_component.hpp"
+#include "component_range.hpp"
 
 /// Tensor class.
 class Tensor
@@ -69,6 +70,20 @@ public:
     /// Creates a vector with tensor components of this tensor.
     /// @return The vector of tensor components.
     VTensorComponents components() const;
+    
+    /// Gets number of tensor components, (order + 1)(order + 2)/2, without
+    /// creating them.
+    /// @return The number of tensor components.
+    int number_of_components() const;
+    
+    /// Creates the tensor component at the given position of components().
+    /// @param index The canonical index of tensor component.
+    /// @return The tensor component.
+    TensorComponent component(const int index) const;
+    
+    /// Creates a lazy view of tensor components in canonical order.
+    /// @return The range of tensor components.
+    ComponentRange<Tensor, TensorComponent> component_range() const;
 };
 
 using VTensors = std::vector<Tensor>;
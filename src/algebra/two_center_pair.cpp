@@ -154,3 +154,17 @@ TwoCenterPair::components() const
     
     return t2pcomps;
 }
+
+int
+TwoCenterPair::number_of_components() const
+{
+    return _shapes[0].number_of_components() * _shapes[1].number_of_components();
+}
+
+TwoCenterPairComponent
+TwoCenterPair::component(const int index) const
+{
+    const auto ncomps = _shapes[1].number_of_components();
+    
+    return TwoCenterPairComponent(_names, {_shapes[0].component(index / ncomps), _shapes[1].component(index % ncomps)});
+}
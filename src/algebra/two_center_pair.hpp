@@ -100,6 +100,15 @@ public:
     /// Creates a vector with two center pair components of this two center pair.
     /// @return The vector of two center pair components.
     VTwoCenterPairComponents components() const;
+    
+    /// Gets number of two center pair components without creating them.
+    /// @return The number of two center pair components.
+    int number_of_components() const;
+    
+    /// Creates the two center pair component at the given position of components().
+    /// @param index The canonical index of two center pair component.
+    /// @return The two center pair component.
+    TwoCenterPairComponent component(const int index) const;
 };
 
 #endif /* two_center_pair_hpp */
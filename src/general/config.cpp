@@ -129,6 +129,33 @@ Config::get_int_array(const std::string& key, const std::vector<int>& fallback)
     return has(key) ? get_int_array(key) : fallback;
 }
 
+void
+Config::add_run(Config run)
+{
+    _runs.push_back(std::move(run));
+}
+
+std::vector<Config>
+Config::runs() const
+{
+    if (_runs.empty()) return {*this};
+
+    std::vector<Config> configs;
+
+    for (const auto& run : _runs)
+    {
+        Config config;
+
+        config._values = _values;
+
+        for (const auto& [key, value] : run._values) config._values[key] = value;
+
+        configs.push_back(config);
+    }
+
+    return configs;
+}
+
 namespace {  // unnamed namespace for parsing helpers
 
 /// Removes leading and trailing ASCII whitespace.
@@ -269,6 +296,12 @@ parse_string(const std::string& text)
 
     std::size_t lineno = 0;
 
+    // assignments go to the top-level table until the first run header
+
+    Config run;
+
+    bool in_run = false;
+
     while (std::getline(stream, line))
     {
         lineno++;
@@ -277,6 +310,23 @@ parse_string(const std::string& text)
 
         if (content.empty()) continue;
 
+        if (content.front() == '[')
+        {
+            if (content != "[[run]]")
+            {
+                throw ConfigError("config: line " + std::to_string(lineno) +
+                                  ": unsupported table header '" + content + "', expected '[[run]]'");
+            }
+
+            if (in_run) config.add_run(run);
+
+            run = Config();
+
+            in_run = true;
+
+            continue;
+        }
+
         const auto eq = content.find('=');
 
         if (eq == std::string::npos)
@@ -292,9 +342,13 @@ parse_string(const std::string& text)
             throw ConfigError("config: line " + std::to_string(lineno) + ": empty key");
         }
 
-        config.set(key, parse_value(trim(content.substr(eq + 1)), lineno));
+        auto& table = in_run ? run : config;
+
+        table.set(key, parse_value(trim(content.substr(eq + 1)), lineno));
     }
 
+    if (in_run) config.add_run(run);
+
     return config;
 }
 
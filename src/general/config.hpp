@@ -37,6 +37,9 @@ public:
 /// Supported value types are string, integer, boolean, and integer array.
 /// Values are read back through the typed accessors, each of which has an
 /// overload taking a fallback used when the key is absent.
+///
+/// A configuration may also hold run tables (the '[[run]]' sections of a
+/// config file); the top-level keys then act as defaults shared by every run.
 class Config
 {
 public:
@@ -97,15 +100,28 @@ public:
     /// @return The integer array, or the fallback.
     std::vector<int> get_int_array(const std::string& key, const std::vector<int>& fallback) const;
 
+    /// Appends a run table.
+    /// @param run The run table (its keys override the top-level keys).
+    void add_run(Config run);
+
+    /// Expands the configuration into the runs it describes.
+    /// @return The run tables merged over the top-level keys, in declaration
+    ///         order, or the configuration itself when it holds no run tables.
+    std::vector<Config> runs() const;
+
 private:
     /// Returns the stored value for a key, throwing ConfigError if absent.
     const Value& _at(const std::string& key) const;
 
     /// The parsed key/value bindings.
     std::map<std::string, Value> _values;
+
+    /// The run tables, in declaration order.
+    std::vector<Config> _runs;
 };
 
-/// Parses configuration text (the contents of a config file).
+/// Parses configuration text (the contents of a config file). A '[[run]]'
+/// header opens a new run table, which collects the assignments that follow it.
 /// @param text The configuration text.
 /// @return The parsed configuration (throws ConfigError on a malformed line).
 Config parse_string(const std::string& text);
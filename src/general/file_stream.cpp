@@ -18,8 +18,8 @@
 
 namespace ost { // ost namespace
     
-    void write_code_lines(      std::ofstream& fstream, 
-                          const VCodeLines&    lines)
+    void write_code_lines(      std::ostream& fstream,
+                          const VCodeLines&   lines)
     {
         for (const auto& [nspacers, offset, nends, str] : lines)
         {
@@ -18,6 +18,7 @@
 #define file_stream_hpp
 
 #include <fstream>
+#include <ostream>
 #include <string>
 #include <tuple>
 #include <vector>
@@ -28,11 +29,11 @@ using VCodeLines = std::vector<TCodeLine>;
 
 namespace ost { // ost namespace
     
-    /// Writes vector of code lines to file stream.
+    /// Writes vector of code lines to output stream.
     /// @param lines the vector of code lines.
-    /// @param fstream the file stream.
-    void write_code_lines(      std::ofstream& fstream,
-                          const VCodeLines&    lines);
+    /// @param fstream the output (file or string) stream.
+    void write_code_lines(      std::ostream& fstream,
+                          const VCodeLines&   lines);
 
 } // ost namespace
 
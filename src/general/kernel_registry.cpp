@@ -0,0 +1,595 @@
+// LITMUS: An Automated Molecular Integrals Generator
+// Copyright 2022 Z. Rinkevicius, KTH, Sweden.
+// E-mail: rinkevic@kth.se
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "kernel_registry.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <iomanip>
+#include <map>
+#include <optional>
+#include <set>
+#include <sstream>
+
+namespace ost {  // ost namespace
+
+namespace {  // unnamed namespace for kernel analysis helpers
+
+/// A source token and its offset in the comment-stripped text.
+struct Token
+{
+    std::string text;
+
+    std::size_t pos;
+};
+
+/// The parts of a single-kernel definition needed to deduplicate it.
+struct KernelInfo
+{
+    /// The normalized body.
+    std::string body;
+
+    /// The qualified namespace enclosing the kernel.
+    std::string ns;
+
+    /// The kernel name.
+    std::string name;
+
+    /// The definition head, from 'auto' up to the opening brace.
+    std::string signature;
+
+    /// The parameter names, in order.
+    std::vector<std::string> params;
+
+    /// Whether the trailing return type is void.
+    bool returns_void;
+};
+
+/// Checks whether a token is an identifier.
+bool
+is_identifier(const std::string& token)
+{
+    return !token.empty() && (std::isalpha(static_cast<unsigned char>(token[0])) || (token[0] == '_'));
+}
+
+/// Replaces comments by blanks, keeping offsets and newlines intact.
+std::string
+strip_comments(const std::string& text)
+{
+    auto result = text;
+
+    std::size_t i = 0;
+
+    while (i < result.size())
+    {
+        if (result[i] == '"')
+        {
+            for (i++; (i < result.size()) && (result[i] != '"'); i++)
+            {
+                if (result[i] == '\\') i++;
+            }
+
+            i++;
+        }
+        else if (result.compare(i, 2, "//") == 0)
+        {
+            for (; (i < result.size()) && (result[i] != '\n'); i++) result[i] = ' ';
+        }
+        else if (result.compare(i, 2, "/*") == 0)
+        {
+            const auto end = std::min(result.find("*/", i + 2), result.size() - 2) + 2;
+
+            for (; i < end; i++)
+            {
+                if (result[i] != '\n') result[i] = ' ';
+            }
+        }
+        else
+        {
+            i++;
+        }
+    }
+
+    return result;
+}
+
+/// Splits comment-free source text into tokens: identifiers, numbers, string
+/// literals, '::' and '->', and single punctuation characters.
+std::vector<Token>
+tokenize(const std::string& text)
+{
+    std::vector<Token> tokens;
+
+    std::size_t i = 0;
+
+    while (i < text.size())
+    {
+        const auto ch = static_cast<unsigned char>(text[i]);
+
+        const auto start = i;
+
+        if (std::isspace(ch))
+        {
+            i++;
+
+            continue;
+        }
+
+        if (std::isalpha(ch) || (ch == '_'))
+        {
+            while ((i < text.size()) && (std::isalnum(static_cast<unsigned char>(text[i])) || (text[i] == '_'))) i++;
+        }
+        else if (std::isdigit(ch))
+        {
+            while (i < text.size())
+            {
+                const auto cur = text[i];
+
+                const auto sign = ((cur == '+') || (cur == '-')) && ((text[i - 1] == 'e') || (text[i - 1] == 'E'));
+
+                if (!(std::isalnum(static_cast<unsigned char>(cur)) || (cur == '.') || sign)) break;
+
+                i++;
+            }
+        }
+        else if (ch == '"')
+        {
+            for (i++; (i < text.size()) && (text[i] != '"'); i++)
+            {
+                if (text[i] == '\\') i++;
+            }
+
+            i++;
+        }
+        else if ((text.compare(i, 2, "::") == 0) || (text.compare(i, 2, "->") == 0))
+        {
+            i += 2;
+        }
+        else
+        {
+            i++;
+        }
+
+        tokens.push_back({text.substr(start, i - start), start});
+    }
+
+    return tokens;
+}
+
+/// Finds the token closing the bracket opened at the given index.
+/// @return The index of the closing token, or the number of tokens if unmatched.
+std::size_t
+matching_bracket(const std::vector<Token>& tokens, const std::size_t index, const std::string& open, const std::string& close)
+{
+    int depth = 0;
+
+    for (auto i = index; i < tokens.size(); i++)
+    {
+        if (tokens[i].text == open) depth++;
+
+        if ((tokens[i].text == close) && (--depth == 0)) return i;
+    }
+
+    return tokens.size();
+}
+
+/// Analyzes a .cpp file holding a single kernel definition.
+/// @param file The generated file.
+/// @return The kernel parts, or nothing if the file is not a single-kernel definition.
+std::optional<KernelInfo>
+analyze(const GeneratedFile& file)
+{
+    if ((file.name.size() < 4) || (file.name.compare(file.name.size() - 4, 4, ".cpp") != 0)) return std::nullopt;
+
+    const auto stem = file.name.substr(0, file.name.size() - 4);
+
+    const auto text = strip_comments(file.content);
+
+    const auto tokens = tokenize(text);
+
+    // exactly one 'auto name(' definition head, enclosed only by namespaces
+
+    std::size_t head = tokens.size();
+
+    std::vector<std::string> scopes;
+
+    std::vector<std::string> namespaces;
+
+    for (std::size_t i = 0; (i + 2) < tokens.size(); i++)
+    {
+        const auto& tok = tokens[i].text;
+
+        if ((tok == "auto") && is_identifier(tokens[i + 1].text) && (tokens[i + 2].text == "("))
+        {
+            if (head != tokens.size()) return std::nullopt;
+
+            for (const auto& scope : scopes)
+            {
+                if (scope.empty()) return std::nullopt;
+            }
+
+            namespaces = scopes;
+
+            head = i;
+        }
+
+        if (tok == "namespace")
+        {
+            std::string name;
+
+            auto j = i + 1;
+
+            for (; (j < tokens.size()) && (tokens[j].text != "{"); j++) name += tokens[j].text;
+
+            if (j == tokens.size()) return std::nullopt;
+
+            scopes.push_back(name);
+
+            i = j;
+        }
+        else if (tok == "{")
+        {
+            scopes.push_back("");
+        }
+        else if (tok == "}")
+        {
+            if (scopes.empty()) return std::nullopt;
+
+            scopes.pop_back();
+        }
+    }
+
+    if (head == tokens.size()) return std::nullopt;
+
+    KernelInfo info;
+
+    info.name = tokens[head + 1].text;
+
+    for (const auto& scope : namespaces) info.ns += (info.ns.empty() ? "" : "::") + scope;
+
+    // parameter names: the last identifier of each parameter declaration; an
+    // unnamed parameter (a single identifier besides cv-qualifiers) ends in its
+    // type, which must not be renamed
+
+    const auto rparen = matching_bracket(tokens, head + 2, "(", ")");
+
+    if (rparen == tokens.size()) return std::nullopt;
+
+    int depth = 0;
+
+    std::size_t nidents = 0;
+
+    for (auto i = head + 3; i < rparen; i++)
+    {
+        const auto& tok = tokens[i].text;
+
+        if ((tok == "(") || (tok == "<") || (tok == "[")) depth++;
+
+        if ((tok == ")") || (tok == ">") || (tok == "]")) depth--;
+
+        if ((depth == 0) && (tok == ",")) continue;
+
+        if (is_identifier(tok) && (tok != "const")) nidents++;
+
+        if (((i + 1) == rparen) || ((depth == 0) && (tokens[i + 1].text == ",")))
+        {
+            if (!is_identifier(tok) || (nidents < 2)) return std::nullopt;
+
+            info.params.push_back(tok);
+
+            nidents = 0;
+        }
+    }
+
+    // trailing return type and body
+
+    auto lbrace = rparen + 1;
+
+    for (; (lbrace < tokens.size()) && (tokens[lbrace].text != "{"); lbrace++)
+    {
+        if (tokens[lbrace].text == ";") return std::nullopt;
+    }
+
+    if (lbrace == tokens.size()) return std::nullopt;
+
+    info.returns_void = ((lbrace - rparen) == 3) && (tokens[rparen + 1].text == "->") && (tokens[rparen + 2].text == "void");
+
+    const auto rbrace = matching_bracket(tokens, lbrace, "{", "}");
+
+    if (rbrace == tokens.size()) return std::nullopt;
+
+    for (auto i = rbrace + 1; i < tokens.size(); i++)
+    {
+        if (tokens[i].text != "}") return std::nullopt;
+    }
+
+    info.signature = text.substr(tokens[head].pos, tokens[lbrace].pos - tokens[head].pos);
+
+    while (!info.signature.empty() && std::isspace(static_cast<unsigned char>(info.signature.back()))) info.signature.pop_back();
+
+    // the kernel, parameter, and local names are abstracted away; locals are
+    // the identifiers declared after a fundamental type or 'auto'
+
+    const std::set<std::string> types = {"auto", "double", "float", "int", "size_t", "bool", "char"};
+
+    const std::set<std::string> ends = {"=", ";", "[", ",", ")", ":"};
+
+    std::set<std::string> renamed(info.params.begin(), info.params.end());
+
+    renamed.insert(info.name);
+
+    for (auto i = lbrace; (i + 2) < rbrace; i++)
+    {
+        if (types.count(tokens[i].text) == 0) continue;
+
+        auto j = i + 1;
+
+        while ((tokens[j].text == "&") || (tokens[j].text == "*")) j++;
+
+        if (is_identifier(tokens[j].text) && (ends.count(tokens[j + 1].text) > 0)) renamed.insert(tokens[j].text);
+    }
+
+    // a body calling unqualified functions resolves them in its own namespace,
+    // so it only matches kernels in the same namespace
+
+    const std::set<std::string> keywords = {"if", "for", "while", "switch", "return", "sizeof", "decltype"};
+
+    bool local_calls = false;
+
+    for (auto i = lbrace + 1; i < rbrace; i++)
+    {
+        const auto& prev = tokens[i - 1].text;
+
+        if (is_identifier(tokens[i].text) && (tokens[i + 1].text == "(") && (prev != "::") && (prev != ".") && (prev != "->") &&
+            (keywords.count(tokens[i].text) == 0) && (types.count(tokens[i].text) == 0) && (renamed.count(tokens[i].text) == 0))
+        {
+            local_calls = true;
+        }
+    }
+
+    // normalized stream: file-level preamble without the kernel's own header
+    // include and namespace lines, then the renamed definition
+
+    std::map<std::string, std::string> aliases;
+
+    std::ostringstream body;
+
+    if (local_calls) body << "namespace " << info.ns << " ";
+
+    for (std::size_t i = 0; i < head; i++)
+    {
+        if ((tokens[i].text == "#") && ((i + 2) < head) && (tokens[i + 1].text == "include") && (tokens[i + 2].text == ("\"" + stem + ".hpp\"")))
+        {
+            i += 2;
+
+            continue;
+        }
+
+        if (tokens[i].text == "namespace")
+        {
+            while (tokens[i].text != "{") i++;
+
+            continue;
+        }
+
+        body << tokens[i].text << " ";
+    }
+
+    for (auto i = head; i <= rbrace; i++)
+    {
+        const auto& tok = tokens[i].text;
+
+        if (renamed.count(tok) > 0)
+        {
+            const auto alias = aliases.emplace(tok, "$" + std::to_string(aliases.size())).first->second;
+
+            body << alias << " ";
+        }
+        else
+        {
+            body << tok << " ";
+        }
+    }
+
+    info.body = body.str();
+
+    return info;
+}
+
+/// Writes the forwarding definition of a duplicate kernel.
+/// @param stem The file stem of the duplicate.
+/// @param dup The duplicate kernel.
+/// @param canon_stem The file stem of the canonical kernel.
+/// @param canon The canonical kernel.
+/// @param hash The normalized body hash.
+/// @return The forwarding .cpp file text.
+std::string
+forward_definition(const std::string& stem, const KernelInfo& dup, const std::string& canon_stem, const KernelInfo& canon, const std::string& hash)
+{
+    std::ostringstream os;
+
+    os << "#include \"" << stem << ".hpp\"\n\n";
+
+    os << "#include \"" << canon_stem << ".hpp\"\n\n";
+
+    if (!dup.ns.empty()) os << "namespace " << dup.ns << " { // " << dup.ns << " namespace\n\n";
+
+    os << "// Same body as " << canon.ns << "::" << canon.name << " (kernel hash " << hash << ").\n";
+
+    os << dup.signature << "\n{\n    ";
+
+    if (!dup.returns_void) os << "return ";
+
+    os << (canon.ns.empty() ? "" : canon.ns + "::") << canon.name << "(";
+
+    for (std::size_t i = 0; i < dup.params.size(); i++) os << (i > 0 ? ", " : "") << dup.params[i];
+
+    os << ");\n}\n\n";
+
+    if (!dup.ns.empty()) os << "} // " << dup.ns << " namespace\n";
+
+    return os.str();
+}
+
+/// Formats a hash as 16 hexadecimal digits.
+std::string
+hex_hash(const std::uint64_t hash)
+{
+    std::ostringstream os;
+
+    os << std::hex << std::setw(16) << std::setfill('0') << hash;
+
+    return os.str();
+}
+
+/// Counts the lines of a text.
+std::size_t
+number_of_lines(const std::string& text)
+{
+    return static_cast<std::size_t>(std::count(text.begin(), text.end(), '\n'));
+}
+
+}  // namespace
+
+std::uint64_t
+fnv1a_hash(const std::string& text)
+{
+    std::uint64_t hash = 14695981039346656037ULL;
+
+    for (const auto ch : text)
+    {
+        hash ^= static_cast<unsigned char>(ch);
+
+        hash *= 1099511628211ULL;
+    }
+
+    return hash;
+}
+
+void
+KernelRegistry::add(const GeneratedFile& file)
+{
+    const auto index = _entries.size();
+
+    Entry entry{file, "", index, ""};
+
+    if (const auto info = analyze(file))
+    {
+        entry.body = info->body;
+
+        const auto [it, added] = _canonicals.emplace(info->body, index);
+
+        if (!added)
+        {
+            const auto& canon = _entries[it->second].file;
+
+            const auto canon_info = analyze(canon);
+
+            const auto stem = [](const std::string& name) { return name.substr(0, name.size() - 4); };
+
+            entry.canonical = it->second;
+
+            entry.forward = forward_definition(stem(file.name), *info, stem(canon.name), *canon_info, hex_hash(fnv1a_hash(info->body)));
+        }
+    }
+
+    _entries.push_back(entry);
+}
+
+std::size_t
+KernelRegistry::number_of_kernels() const
+{
+    return static_cast<std::size_t>(std::count_if(_entries.begin(), _entries.end(), [](const Entry& entry) { return !entry.body.empty(); }));
+}
+
+std::size_t
+KernelRegistry::number_of_duplicates() const
+{
+    return static_cast<std::size_t>(std::count_if(_entries.begin(), _entries.end(), [](const Entry& entry) { return !entry.forward.empty(); }));
+}
+
+std::vector<GeneratedFile>
+KernelRegistry::files() const
+{
+    std::vector<GeneratedFile> files;
+
+    for (const auto& entry : _entries)
+    {
+        files.push_back(entry.forward.empty() ? entry.file : GeneratedFile{entry.file.name, entry.forward});
+    }
+
+    return files;
+}
+
+std::vector<GeneratedFile>
+KernelRegistry::forwarded_files() const
+{
+    std::vector<GeneratedFile> files;
+
+    for (const auto& entry : _entries)
+    {
+        if (!entry.forward.empty()) files.push_back({entry.file.name, entry.forward});
+    }
+
+    return files;
+}
+
+std::string
+KernelRegistry::report() const
+{
+    std::map<std::size_t, std::vector<std::size_t>> groups;
+
+    std::size_t saved_lines = 0;
+
+    for (std::size_t i = 0; i < _entries.size(); i++)
+    {
+        const auto& entry = _entries[i];
+
+        if (entry.forward.empty()) continue;
+
+        groups[entry.canonical].push_back(i);
+
+        const auto lines = number_of_lines(entry.file.content);
+
+        const auto fwd_lines = number_of_lines(entry.forward);
+
+        if (lines > fwd_lines) saved_lines += lines - fwd_lines;
+    }
+
+    std::ostringstream os;
+
+    const auto nkernels = number_of_kernels();
+
+    const auto nduplicates = number_of_duplicates();
+
+    os << "Kernel registry: " << nkernels << " kernels, " << (nkernels - nduplicates) << " unique bodies.\n";
+
+    for (const auto& [canon, dups] : groups)
+    {
+        os << "  " << hex_hash(fnv1a_hash(_entries[canon].body)) << "  " << _entries[canon].file.name << " <-";
+
+        for (const auto dup : dups) os << " " << _entries[dup].file.name;
+
+        os << "\n";
+    }
+
+    os << "Forwarded " << nduplicates << " duplicate kernels to canonical copies: "
+       << nduplicates << " fewer kernel bodies to compile, " << saved_lines << " lines saved.\n";
+
+    return os.str();
+}
+
+}  // namespace ost
@@ -0,0 +1,92 @@
+// LITMUS: An Automated Molecular Integrals Generator
+// Copyright 2022 Z. Rinkevicius, KTH, Sweden.
+// E-mail: rinkevic@kth.se
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef kernel_registry_hpp
+#define kernel_registry_hpp
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "output_sink.hpp"
+
+namespace ost {  // ost namespace
+
+/// Cross-family registry of generated kernel definitions. Every registered .cpp
+/// file holding a single 'auto name(...) -> type { ... }' kernel is reduced to
+/// a normalized body: comments, whitespace, its own header include, and the
+/// names of the kernel, its parameters and its locals are abstracted away. The
+/// first kernel registered with a given normalized body becomes canonical;
+/// later ones are rewritten as forwarding definitions that call it, so only one
+/// copy of each body is compiled. Files that are not single-kernel definitions
+/// pass through unchanged.
+class KernelRegistry
+{
+    /// A registered file and, for a duplicate kernel, its forwarding rewrite.
+    struct Entry
+    {
+        /// The file as generated.
+        GeneratedFile file;
+
+        /// The normalized kernel body (empty if the file is not a kernel).
+        std::string body;
+
+        /// The index of the canonical entry (its own index if canonical).
+        std::size_t canonical;
+
+        /// The forwarding definition replacing a duplicate kernel.
+        std::string forward;
+    };
+
+    /// The registered files, in registration order.
+    std::vector<Entry> _entries;
+
+    /// The canonical entry index of every normalized body.
+    std::unordered_map<std::string, std::size_t> _canonicals;
+
+public:
+    /// Registers a generated file.
+    /// @param file The generated file.
+    void add(const GeneratedFile& file);
+
+    /// @return The number of registered kernel definitions.
+    std::size_t number_of_kernels() const;
+
+    /// @return The number of kernels rewritten as forwarding definitions.
+    std::size_t number_of_duplicates() const;
+
+    /// @return The registered files, with duplicate kernels replaced by their
+    ///         forwarding definitions, in registration order.
+    std::vector<GeneratedFile> files() const;
+
+    /// @return The duplicate files only, as rewritten.
+    std::vector<GeneratedFile> forwarded_files() const;
+
+    /// @return A report of the duplicate groups (by body hash) and the compile
+    ///         units and kernel lines saved.
+    std::string report() const;
+};
+
+/// Computes the 64-bit FNV-1a hash of a text (stable across platforms).
+/// @param text The text to hash.
+/// @return The hash value.
+std::uint64_t fnv1a_hash(const std::string& text);
+
+}  // namespace ost
+
+#endif /* kernel_registry_hpp */
@@ -0,0 +1,73 @@
+// LITMUS: An Automated Molecular Integrals Generator
+// Copyright 2022 Z. Rinkevicius, KTH, Sweden.
+// E-mail: rinkevic@kth.se
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "output_sink.hpp"
+
+#include <fstream>
+#include <stdexcept>
+
+namespace ost {  // ost namespace
+
+DirectorySink::DirectorySink(const std::string& directory)
+
+    : _directory(directory)
+{
+}
+
+void
+DirectorySink::write(const GeneratedFile& file)
+{
+    const auto path = _directory + "/" + file.name;
+
+    std::ofstream fstream(path.c_str(), std::ios_base::trunc);
+
+    fstream << file.content;
+
+    fstream.close();
+
+    if (!fstream)
+    {
+        throw std::runtime_error("output: cannot write file '" + path + "'");
+    }
+}
+
+void
+MemorySink::write(const GeneratedFile& file)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    for (auto& stored : _files)
+    {
+        if (stored.name == file.name)
+        {
+            stored.content = file.content;
+
+            return;
+        }
+    }
+
+    _files.push_back(file);
+}
+
+std::vector<GeneratedFile>
+MemorySink::files() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    return _files;
+}
+
+}  // namespace ost
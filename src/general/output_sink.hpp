@@ -0,0 +1,89 @@
+// LITMUS: An Automated Molecular Integrals Generator
+// Copyright 2022 Z. Rinkevicius, KTH, Sweden.
+// E-mail: rinkevic@kth.se
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef output_sink_hpp
+#define output_sink_hpp
+
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace ost {  // ost namespace
+
+/// A generated source file: its name (relative to the output location) and
+/// its full text.
+struct GeneratedFile
+{
+    /// The file name, e.g. "ObaraSaikaTwoCenterOverlapPP.hpp".
+    std::string name;
+
+    /// The file contents.
+    std::string content;
+};
+
+/// The destination of generated source files. Generators hand every file they
+/// produce to a sink instead of opening output streams themselves, so the same
+/// generator can write to disk or into memory. Implementations must accept
+/// concurrent writes.
+class OutputSink
+{
+public:
+    virtual ~OutputSink() = default;
+
+    /// Stores a generated file, replacing any earlier file of the same name.
+    /// @param file The generated file.
+    virtual void write(const GeneratedFile& file) = 0;
+};
+
+/// Writes generated files into a directory (by default the current working
+/// directory, as litmus.x does).
+class DirectorySink : public OutputSink
+{
+    /// The output directory.
+    std::string _directory;
+
+public:
+    /// Creates a directory sink.
+    /// @param directory The existing output directory.
+    explicit DirectorySink(const std::string& directory = ".");
+
+    /// Writes a file into the output directory (throws std::runtime_error if
+    /// the file cannot be written).
+    /// @param file The generated file.
+    void write(const GeneratedFile& file) override;
+};
+
+/// Collects generated files in memory, in the order they were first written.
+class MemorySink : public OutputSink
+{
+    /// The collected files.
+    std::vector<GeneratedFile> _files;
+
+    /// Guards the collected files against concurrent writes.
+    mutable std::mutex _mutex;
+
+public:
+    /// Stores a file in memory; a rewritten file keeps its original position.
+    /// @param file The generated file.
+    void write(const GeneratedFile& file) override;
+
+    /// @return The collected files.
+    std::vector<GeneratedFile> files() const;
+};
+
+}  // namespace ost
+
+#endif /* output_sink_hpp */
@@ -0,0 +1,429 @@
+// LITMUS: An Automated Molecular Integrals Generator
+// Copyright 2022 Z. Rinkevicius, KTH, Sweden.
+// E-mail: rinkevic@kth.se
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "reference_integrals.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <sstream>
+
+namespace refint {  // refint namespace
+
+namespace {  // unnamed namespace for Hermite expansion helpers
+
+/// The constant pi in extended precision.
+constexpr long double pi = 3.141592653589793238462643383279502884L;
+
+/// The Gaussian product of two primitives: the combined exponent, the product
+/// center P, and the per-axis (P - A), (P - B) distances and exp(-mu X_AB^2)
+/// prefactors of the McMurchie-Davidson expansion.
+struct GaussianProduct
+{
+    long double                p;
+    std::array<long double, 3> center;
+    std::array<long double, 3> pa;
+    std::array<long double, 3> pb;
+    std::array<long double, 3> kab;
+};
+
+GaussianProduct
+gaussian_product(const Primitive& bra, const Primitive& ket)
+{
+    GaussianProduct prod;
+
+    prod.p = bra.exponent + ket.exponent;
+
+    const auto mu = bra.exponent * ket.exponent / prod.p;
+
+    for (int i = 0; i < 3; i++)
+    {
+        prod.center[i] = (bra.exponent * bra.center[i] + ket.exponent * ket.center[i]) / prod.p;
+
+        prod.pa[i] = prod.center[i] - bra.center[i];
+
+        prod.pb[i] = prod.center[i] - ket.center[i];
+
+        const auto ab = bra.center[i] - ket.center[i];
+
+        prod.kab[i] = std::exp(-mu * ab * ab);
+    }
+
+    return prod;
+}
+
+/// The Hermite expansion coefficient E^{ij}_t of a Gaussian product along one
+/// axis, by the McMurchie-Davidson recurrence on i (then j).
+long double
+hermite_coef(const GaussianProduct& prod, const int axis, const int i, const int j, const int t)
+{
+    if ((t < 0) || (t > (i + j))) return 0.0L;
+
+    if ((i == 0) && (j == 0)) return prod.kab[axis];
+
+    const auto fe = 0.5L / prod.p;
+
+    if (j == 0)
+    {
+        return fe * hermite_coef(prod, axis, i - 1, j, t - 1) + prod.pa[axis] * hermite_coef(prod, axis, i - 1, j, t) +
+               (t + 1) * hermite_coef(prod, axis, i - 1, j, t + 1);
+    }
+
+    return fe * hermite_coef(prod, axis, i, j - 1, t - 1) + prod.pb[axis] * hermite_coef(prod, axis, i, j - 1, t) +
+           (t + 1) * hermite_coef(prod, axis, i, j - 1, t + 1);
+}
+
+/// The Hermite expansion E^{ab}_{tuv} of a primitive pair, as (t, u, v,
+/// coefficient) tuples with non-zero coefficients only.
+std::vector<std::pair<std::array<int, 3>, long double>>
+hermite_expansion(const GaussianProduct& prod, const Primitive& bra, const Primitive& ket)
+{
+    std::array<std::vector<long double>, 3> coefs;
+
+    for (int k = 0; k < 3; k++)
+    {
+        const auto i = bra.powers[k];
+
+        const auto j = ket.powers[k];
+
+        for (int t = 0; t <= i + j; t++) coefs[k].push_back(hermite_coef(prod, k, i, j, t));
+    }
+
+    std::vector<std::pair<std::array<int, 3>, long double>> terms;
+
+    for (int t = 0; t < static_cast<int>(coefs[0].size()); t++)
+    {
+        for (int u = 0; u < static_cast<int>(coefs[1].size()); u++)
+        {
+            for (int v = 0; v < static_cast<int>(coefs[2].size()); v++)
+            {
+                const auto value = coefs[0][t] * coefs[1][u] * coefs[2][v];
+
+                if (value != 0.0L) terms.push_back({{t, u, v}, value});
+            }
+        }
+    }
+
+    return terms;
+}
+
+/// The Hermite Coulomb integrals R^0_{tuv}(alpha, R) for t + u + v <= order,
+/// tabulated bottom-up over the auxiliary index n.
+class HermiteCoulomb
+{
+    int _order;
+
+    std::vector<long double> _values;
+
+    std::size_t
+    _index(const int n, const int t, const int u, const int v) const
+    {
+        const std::size_t dim = _order + 1;
+
+        return ((static_cast<std::size_t>(n) * dim + t) * dim + u) * dim + v;
+    }
+
+public:
+    HermiteCoulomb(const int order, const long double alpha, const std::array<long double, 3>& rpc)
+        : _order(order)
+    {
+        const std::size_t dim = order + 1;
+
+        _values.assign(dim * dim * dim * dim, 0.0L);
+
+        const auto arg = alpha * (rpc[0] * rpc[0] + rpc[1] * rpc[1] + rpc[2] * rpc[2]);
+
+        long double fact = 1.0L;
+
+        for (int n = 0; n <= order; n++)
+        {
+            _values[_index(n, 0, 0, 0)] = fact * boys_function(n, arg);
+
+            fact *= -2.0L * alpha;
+        }
+
+        for (int s = 1; s <= order; s++)
+        {
+            for (int n = 0; n <= order - s; n++)
+            {
+                for (int t = 0; t <= s; t++)
+                {
+                    for (int u = 0; u <= s - t; u++)
+                    {
+                        const auto v = s - t - u;
+
+                        long double value = 0.0L;
+
+                        if (t > 0)
+                        {
+                            value = rpc[0] * at(n + 1, t - 1, u, v);
+
+                            if (t > 1) value += (t - 1) * at(n + 1, t - 2, u, v);
+                        }
+                        else if (u > 0)
+                        {
+                            value = rpc[1] * at(n + 1, t, u - 1, v);
+
+                            if (u > 1) value += (u - 1) * at(n + 1, t, u - 2, v);
+                        }
+                        else
+                        {
+                            value = rpc[2] * at(n + 1, t, u, v - 1);
+
+                            if (v > 1) value += (v - 1) * at(n + 1, t, u, v - 2);
+                        }
+
+                        _values[_index(n, t, u, v)] = value;
+                    }
+                }
+            }
+        }
+    }
+
+    long double
+    at(const int n, const int t, const int u, const int v) const
+    {
+        return _values[_index(n, t, u, v)];
+    }
+};
+
+/// The one-dimensional overlap of a Gaussian product for Cartesian powers (i, j).
+long double
+overlap_1d(const GaussianProduct& prod, const int axis, const int i, const int j)
+{
+    if ((i < 0) || (j < 0)) return 0.0L;
+
+    return hermite_coef(prod, axis, i, j, 0) * std::sqrt(pi / prod.p);
+}
+
+/// The sum of the Cartesian powers of a primitive.
+int
+ang_mom(const Primitive& prim)
+{
+    return prim.powers[0] + prim.powers[1] + prim.powers[2];
+}
+
+}  // namespace
+
+long double
+boys_function(const int order, const long double argument)
+{
+    // small arguments: the series F_n(t) = exp(-t) sum_k (2t)^k / (2n+1)(2n+3)...(2n+2k+1)
+    // has positive terms only and converges to full extended precision.
+
+    if (argument < 50.0L)
+    {
+        auto term = 1.0L / (2 * order + 1);
+
+        auto sum = term;
+
+        for (int k = 1; k < 2000; k++)
+        {
+            term *= 2.0L * argument / (2 * order + 2 * k + 1);
+
+            sum += term;
+
+            if (term < sum * std::numeric_limits<long double>::epsilon()) break;
+        }
+
+        return std::exp(-argument) * sum;
+    }
+
+    // large arguments: F_0 from the error function, then the upward recurrence,
+    // which is stable for t > n.
+
+    const auto rt = std::sqrt(argument);
+
+    auto value = 0.5L * std::sqrt(pi) * std::erf(rt) / rt;
+
+    const auto ext = std::exp(-argument);
+
+    for (int n = 0; n < order; n++)
+    {
+        value = ((2 * n + 1) * value - ext) / (2.0L * argument);
+    }
+
+    return value;
+}
+
+long double
+overlap(const std::array<Primitive, 2>& prims)
+{
+    const auto prod = gaussian_product(prims[0], prims[1]);
+
+    long double value = 1.0L;
+
+    for (int k = 0; k < 3; k++)
+    {
+        value *= overlap_1d(prod, k, prims[0].powers[k], prims[1].powers[k]);
+    }
+
+    return value;
+}
+
+long double
+kinetic_energy(const std::array<Primitive, 2>& prims)
+{
+    const auto prod = gaussian_product(prims[0], prims[1]);
+
+    const auto b = prims[1].exponent;
+
+    std::array<long double, 3> sval;
+
+    std::array<long double, 3> tval;
+
+    for (int k = 0; k < 3; k++)
+    {
+        const auto i = prims[0].powers[k];
+
+        const auto j = prims[1].powers[k];
+
+        sval[k] = overlap_1d(prod, k, i, j);
+
+        // -1/2 d^2/dx^2 acting on the ket primitive
+
+        tval[k] = b * (2 * j + 1) * sval[k] - 2.0L * b * b * overlap_1d(prod, k, i, j + 2) -
+                  0.5L * j * (j - 1) * overlap_1d(prod, k, i, j - 2);
+    }
+
+    return tval[0] * sval[1] * sval[2] + sval[0] * tval[1] * sval[2] + sval[0] * sval[1] * tval[2];
+}
+
+long double
+nuclear_potential(const std::array<Primitive, 2>& prims, const std::array<long double, 3>& point)
+{
+    const auto prod = gaussian_product(prims[0], prims[1]);
+
+    const std::array<long double, 3> rpc = {prod.center[0] - point[0],
+                                            prod.center[1] - point[1],
+                                            prod.center[2] - point[2]};
+
+    const HermiteCoulomb rints(ang_mom(prims[0]) + ang_mom(prims[1]), prod.p, rpc);
+
+    long double value = 0.0L;
+
+    for (const auto& [tuv, coef] : hermite_expansion(prod, prims[0], prims[1]))
+    {
+        value += coef * rints.at(0, tuv[0], tuv[1], tuv[2]);
+    }
+
+    return 2.0L * pi / prod.p * value;
+}
+
+long double
+electron_repulsion(const std::array<Primitive, 4>& prims)
+{
+    const auto bra = gaussian_product(prims[0], prims[1]);
+
+    const auto ket = gaussian_product(prims[2], prims[3]);
+
+    const auto alpha = bra.p * ket.p / (bra.p + ket.p);
+
+    const std::array<long double, 3> rpq = {bra.center[0] - ket.center[0],
+                                            bra.center[1] - ket.center[1],
+                                            bra.center[2] - ket.center[2]};
+
+    const auto order = ang_mom(prims[0]) + ang_mom(prims[1]) + ang_mom(prims[2]) + ang_mom(prims[3]);
+
+    const HermiteCoulomb rints(order, alpha, rpq);
+
+    const auto ket_terms = hermite_expansion(ket, prims[2], prims[3]);
+
+    long double value = 0.0L;
+
+    for (const auto& [tuv, bcoef] : hermite_expansion(bra, prims[0], prims[1]))
+    {
+        for (const auto& [kuv, kcoef] : ket_terms)
+        {
+            const auto sign = ((kuv[0] + kuv[1] + kuv[2]) % 2 == 0) ? 1.0L : -1.0L;
+
+            value += sign * bcoef * kcoef * rints.at(0, tuv[0] + kuv[0], tuv[1] + kuv[1], tuv[2] + kuv[2]);
+        }
+    }
+
+    return 2.0L * std::pow(pi, 2.5L) / (bra.p * ket.p * std::sqrt(bra.p + ket.p)) * value;
+}
+
+Primitive
+random_primitive(std::mt19937& engine, const int ang_mom)
+{
+    std::uniform_real_distribution<double> log_exp(std::log(0.1), std::log(10.0));
+
+    std::uniform_real_distribution<double> coord(-1.5, 1.5);
+
+    Primitive prim;
+
+    prim.exponent = std::exp(static_cast<long double>(log_exp(engine)));
+
+    for (auto& value : prim.center) value = coord(engine);
+
+    const auto i = std::uniform_int_distribution<int>(0, ang_mom)(engine);
+
+    const auto j = std::uniform_int_distribution<int>(0, ang_mom - i)(engine);
+
+    prim.powers = {i, j, ang_mom - i - j};
+
+    return prim;
+}
+
+void
+ErrorStats::add(const double value, const long double reference)
+{
+    const auto rval = static_cast<double>(reference);
+
+    const auto error = std::fabs(static_cast<double>(static_cast<long double>(value) - reference));
+
+    const auto mag = std::max(std::fabs(rval), std::numeric_limits<double>::min());
+
+    const auto ulp = std::nextafter(mag, std::numeric_limits<double>::infinity()) - mag;
+
+    _max_abs = std::max(_max_abs, error);
+
+    _max_ulp = std::max(_max_ulp, error / ulp);
+
+    _count++;
+}
+
+std::size_t
+ErrorStats::count() const
+{
+    return _count;
+}
+
+double
+ErrorStats::max_abs() const
+{
+    return _max_abs;
+}
+
+double
+ErrorStats::max_ulp() const
+{
+    return _max_ulp;
+}
+
+std::string
+ErrorStats::summary() const
+{
+    std::ostringstream os;
+
+    os << _count << " values: max abs " << std::scientific << _max_abs << ", max ulp " << std::defaultfloat
+       << _max_ulp;
+
+    return os.str();
+}
+
+}  // namespace refint
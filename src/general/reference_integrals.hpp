@@ -0,0 +1,155 @@
+// LITMUS: An Automated Molecular Integrals Generator
+// Copyright 2022 Z. Rinkevicius, KTH, Sweden.
+// E-mail: rinkevic@kth.se
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef reference_integrals_hpp
+#define reference_integrals_hpp
+
+#include <array>
+#include <cstddef>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace refint {  // refint namespace
+
+/// An unnormalized primitive Cartesian Gaussian
+/// (x - Ax)^i (y - Ay)^j (z - Az)^k exp(-alpha |r - A|^2).
+struct Primitive
+{
+    /// The Gaussian exponent alpha.
+    long double exponent = 1.0L;
+
+    /// The center A.
+    std::array<long double, 3> center = {0.0L, 0.0L, 0.0L};
+
+    /// The Cartesian powers (i, j, k).
+    std::array<int, 3> powers = {0, 0, 0};
+};
+
+/// A geometric derivative request: the index of the differentiated primitive and
+/// the Cartesian axis (0 = x, 1 = y, 2 = z).
+using GeomDerivative = std::pair<std::size_t, int>;
+
+/// Computes the Boys function F_n(t) in extended precision.
+/// @param order The order n of the Boys function.
+/// @param argument The argument t (>= 0).
+/// @return The value of F_n(t).
+long double boys_function(const int order, const long double argument);
+
+/// Computes the overlap integral (a|b) by McMurchie-Davidson Hermite expansion.
+/// @param prims The bra (a) and ket (b) primitives.
+/// @return The overlap integral.
+long double overlap(const std::array<Primitive, 2>& prims);
+
+/// Computes the kinetic energy integral (a|-1/2 nabla^2|b).
+/// @param prims The bra (a) and ket (b) primitives.
+/// @return The kinetic energy integral.
+long double kinetic_energy(const std::array<Primitive, 2>& prims);
+
+/// Computes the nuclear potential integral (a|1/|r-C||b) of a unit positive
+/// charge; callers scale it by -Z for a nuclear attraction.
+/// @param prims The bra (a) and ket (b) primitives.
+/// @param point The position C of the charge.
+/// @return The nuclear potential integral.
+long double nuclear_potential(const std::array<Primitive, 2>&   prims,
+                              const std::array<long double, 3>& point);
+
+/// Computes the electron repulsion integral (ab|cd) in chemists' notation.
+/// @param prims The a, b, c, and d primitives.
+/// @return The electron repulsion integral.
+long double electron_repulsion(const std::array<Primitive, 4>& prims);
+
+/// Differentiates an integral over primitives with respect to primitive centers,
+/// applying d/dA_i g_a = 2 alpha g_{a+1_i} - a_i g_{a-1_i} once per requested
+/// derivative. Any of the functions above (bound by a lambda) can be passed.
+/// @param func The integral, a callable taking std::array<Primitive, N>.
+/// @param prims The primitives of the integral.
+/// @param drvs The geometric derivatives to apply, outermost first.
+/// @return The differentiated integral.
+template <std::size_t N, class F>
+long double
+geom_derivative(const F&                           func,
+                const std::array<Primitive, N>&    prims,
+                const std::vector<GeomDerivative>& drvs)
+{
+    if (drvs.empty()) return func(prims);
+
+    const auto [index, axis] = drvs.front();
+
+    const std::vector<GeomDerivative> inner(drvs.begin() + 1, drvs.end());
+
+    auto upper = prims;
+
+    upper[index].powers[axis]++;
+
+    auto value = 2.0L * prims[index].exponent * geom_derivative(func, upper, inner);
+
+    if (const auto power = prims[index].powers[axis]; power > 0)
+    {
+        auto lower = prims;
+
+        lower[index].powers[axis]--;
+
+        value -= power * geom_derivative(func, lower, inner);
+    }
+
+    return value;
+}
+
+/// Draws a random primitive of the given angular momentum, with an exponent
+/// spread log-uniformly over [0.1, 10] and a center in a 3 bohr cube.
+/// @param engine The random number engine.
+/// @param ang_mom The angular momentum (sum of the Cartesian powers).
+/// @return The random primitive.
+Primitive random_primitive(std::mt19937& engine, const int ang_mom);
+
+/// Error statistics of computed values against extended-precision references:
+/// the largest absolute error and the largest error in units in the last place
+/// (ulp) of the double-rounded reference.
+class ErrorStats
+{
+    /// The number of compared values.
+    std::size_t _count = 0;
+
+    /// The largest absolute error.
+    double _max_abs = 0.0;
+
+    /// The largest error in ulps.
+    double _max_ulp = 0.0;
+
+public:
+    /// Records the error of a computed value.
+    /// @param value The computed value.
+    /// @param reference The extended-precision reference value.
+    void add(const double value, const long double reference);
+
+    /// @return The number of compared values.
+    std::size_t count() const;
+
+    /// @return The largest absolute error.
+    double max_abs() const;
+
+    /// @return The largest error in ulps.
+    double max_ulp() const;
+
+    /// @return The one-line report "<n> values: max abs <e>, max ulp <u>".
+    std::string summary() const;
+};
+
+}  // namespace refint
+
+#endif /* reference_integrals_hpp */
@@ -106,6 +106,14 @@ parse_operator_type(const std::string& value)
     if (key == "kineticenergy")     return OperatorType::kinetic_energy;
     if (key == "nuclearpotential")  return OperatorType::nuclear_potential;
     if (key == "electronrepulsion") return OperatorType::electron_repulsion;
+    if ((key == "longrangeelectronrepulsion") || (key == "erfelectronrepulsion"))
+    {
+        return OperatorType::long_range_electron_repulsion;
+    }
+    if ((key == "shortrangeelectronrepulsion") || (key == "erfcelectronrepulsion"))
+    {
+        return OperatorType::short_range_electron_repulsion;
+    }
     if (key == "dipolemomentum")    return OperatorType::dipole_momentum;
     if (key == "linearmomentum")    return OperatorType::linear_momentum;
     if ((key == "local") || (key == "localecp"))         return OperatorType::local_ecp;
@@ -120,7 +128,8 @@ parse_operator_type(const std::string& value)
 
     throw ConfigError("config: unknown operator_type '" + value +
                       "'; valid: overlap, kinetic_energy, nuclear_potential, "
-                      "electron_repulsion, dipole_momentum, linear_momentum, local_ecp, "
+                      "electron_repulsion, long_range_electron_repulsion, "
+                      "short_range_electron_repulsion, dipole_momentum, linear_momentum, local_ecp, "
                       "projected_ecp, three_center_overlap, three_center_r2, three_center_r_dot_r2");
 }
 
@@ -144,6 +153,46 @@ parse_signature(const std::string& value)
     throw ConfigError("config: unknown signature '" + value + "'; valid: VeloxChemScreened");
 }
 
+Precision
+parse_precision(const std::string& value)
+{
+    const auto key = normalize(value);
+
+    if ((key == "fp64") || (key == "double")) return Precision::fp64;
+
+    if ((key == "fp32") || (key == "float") || (key == "single")) return Precision::fp32;
+
+    if (key == "mixed") return Precision::mixed;
+
+    throw ConfigError("config: unknown precision '" + value + "'; valid: fp64, fp32, mixed");
+}
+
+KernelForm
+parse_kernel_form(const std::string& value)
+{
+    const auto key = normalize(value);
+
+    if (key == "unrolled") return KernelForm::unrolled;
+
+    if ((key == "templated") || (key == "template")) return KernelForm::templated;
+
+    throw ConfigError("config: unknown kernel_form '" + value + "'; valid: unrolled, templated");
+}
+
+EriMethod
+parse_eri_method(const std::string& value)
+{
+    const auto key = normalize(value);
+
+    if ((key == "obarasaika") || (key == "os")) return EriMethod::obara_saika;
+
+    if (key == "rys") return EriMethod::rys;
+
+    if ((key == "auto") || (key == "automatic")) return EriMethod::automatic;
+
+    throw ConfigError("config: unknown eri_method '" + value + "'; valid: obara_saika, rys, auto");
+}
+
 }  // namespace
 
 RunConfiguration
@@ -208,6 +257,51 @@ make_run_configuration(const Config& config)
         run_config.signature = parse_signature(config.get_string("signature"));
     }
 
+    if (config.has("precision"))
+    {
+        run_config.precision = parse_precision(config.get_string("precision"));
+    }
+
+    if (config.has("kernel_form"))
+    {
+        run_config.kernel_form = parse_kernel_form(config.get_string("kernel_form"));
+    }
+
+    if (config.has("eri_method"))
+    {
+        run_config.eri_method = parse_eri_method(config.get_string("eri_method"));
+    }
+
+    // templated kernels exist only for the HRR transfers
+
+    if (run_config.kernel_form == KernelForm::templated)
+    {
+        const auto& rtype = run_config.recursion_type;
+
+        const bool hrr = rtype && ((*rtype == RecursionType::hrr_bra_ket) || (*rtype == RecursionType::hrr_bra) ||
+                                   (*rtype == RecursionType::hrr_ket));
+
+        if (!hrr)
+        {
+            throw ConfigError("config: kernel_form 'templated' requires an hrr_bra_ket, hrr_bra, or "
+                              "hrr_ket recursion_type");
+        }
+    }
+
+    // Rys kernels exist only for four-center electron repulsion integrals
+
+    if (run_config.eri_method != EriMethod::obara_saika)
+    {
+        const bool eri4c = (run_config.integral_type == IntegralType::four_center) &&
+                           (run_config.operator_type == OperatorType::electron_repulsion);
+
+        if (!eri4c)
+        {
+            throw ConfigError("config: eri_method '" + to_string(run_config.eri_method) +
+                              "' requires a four_center electron_repulsion integral_type");
+        }
+    }
+
     // validate the angular momentum range
 
     if (run_config.min_ang_mom < 0)
@@ -225,6 +319,21 @@ make_run_configuration(const Config& config)
     return run_config;
 }
 
+void
+check_legacy_precision(const Config& config, const std::string& type)
+{
+    if (!config.has("precision")) return;
+
+    const auto value = config.get_string("precision");
+
+    if (parse_precision(value) != Precision::fp64)
+    {
+        throw ConfigError("config: precision '" + value + "' is not supported by '" + type +
+                          "' runs; legacy generators emit fp64 kernels only, use the "
+                          "integral_type/recursion_type schema for fp32 or mixed");
+    }
+}
+
 std::string
 to_string(Hardware value)
 {
@@ -284,6 +393,8 @@ to_string(OperatorType value)
         case OperatorType::kinetic_energy:        return "kinetic energy";
         case OperatorType::nuclear_potential:     return "nuclear potential";
         case OperatorType::electron_repulsion:    return "electron repulsion";
+        case OperatorType::long_range_electron_repulsion:  return "long range electron repulsion";
+        case OperatorType::short_range_electron_repulsion: return "short range electron repulsion";
         case OperatorType::dipole_momentum:       return "dipole momentum";
         case OperatorType::linear_momentum:       return "linear momentum";
         case OperatorType::local_ecp:             return "local";
@@ -296,6 +407,13 @@ to_string(OperatorType value)
     return "overlap";
 }
 
+bool
+is_range_separated(OperatorType value)
+{
+    return (value == OperatorType::long_range_electron_repulsion) ||
+           (value == OperatorType::short_range_electron_repulsion);
+}
+
 std::string
 to_string(StorageForm value)
 {
@@ -318,4 +436,68 @@ to_string(Signature value)
     return "VeloxChemScreened";
 }
 
+std::string
+to_string(Precision value)
+{
+    switch (value)
+    {
+        case Precision::fp64:  return "fp64";
+        case Precision::fp32:  return "fp32";
+        case Precision::mixed: return "mixed";
+    }
+
+    return "fp64";
+}
+
+std::string
+to_string(KernelForm value)
+{
+    switch (value)
+    {
+        case KernelForm::unrolled:  return "unrolled";
+        case KernelForm::templated: return "templated";
+    }
+
+    return "unrolled";
+}
+
+std::string
+to_string(EriMethod value)
+{
+    switch (value)
+    {
+        case EriMethod::obara_saika: return "obara_saika";
+        case EriMethod::rys:         return "rys";
+        case EriMethod::automatic:   return "auto";
+    }
+
+    return "obara_saika";
+}
+
+std::string
+primitive_type(Precision value)
+{
+    switch (value)
+    {
+        case Precision::fp64:  return "double";
+        case Precision::fp32:  return "float";
+        case Precision::mixed: return "float";
+    }
+
+    return "double";
+}
+
+std::string
+accumulator_type(Precision value)
+{
+    switch (value)
+    {
+        case Precision::fp64:  return "double";
+        case Precision::fp32:  return "float";
+        case Precision::mixed: return "double";
+    }
+
+    return "double";
+}
+
 }  // namespace cfg
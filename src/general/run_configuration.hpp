@@ -57,12 +57,17 @@ enum class RecursionType
 
 /// The integrand operator of an integral. The spellings mirror the labels the
 /// generators recognize (see to_string), so they round-trip into generated code.
+/// The range-separated Coulomb operators erf(w r)/r (long range) and
+/// erfc(w r)/r (short range) are generated as fused kernels taking w and the
+/// weights of the full and attenuated terms at run time.
 enum class OperatorType
 {
     overlap,
     kinetic_energy,
     nuclear_potential,
     electron_repulsion,
+    long_range_electron_repulsion,
+    short_range_electron_repulsion,
     dipole_momentum,
     linear_momentum,
     local_ecp,
@@ -84,6 +89,37 @@ enum class Signature
     veloxchem_screened
 };
 
+/// The floating-point precision of the generated kernels: everything in double
+/// (fp64), everything in float (fp32), or float primitive buffers accumulated
+/// into double contracted results (mixed).
+enum class Precision
+{
+    fp64,
+    fp32,
+    mixed
+};
+
+/// The shape of the generated HRR kernels: one fully unrolled function per
+/// target (unrolled), or constexpr coefficient tables consumed by a single
+/// compute<LA, LB>() template whose loops are unrolled by the compiler
+/// (templated).
+enum class KernelForm
+{
+    unrolled,
+    templated
+};
+
+/// The electron repulsion scheme of the generated four-center kernels:
+/// Obara-Saika VRR/HRR call trees (obara_saika), Rys quadrature over 2D
+/// integral recursions (rys), or a per-quadruple choice of the cheaper of the
+/// two by the operation-count cost model (automatic).
+enum class EriMethod
+{
+    obara_saika,
+    rys,
+    automatic
+};
+
 /// A validated code-generation run configuration.
 ///
 /// Built from a parsed Config by make_run_configuration(), which applies the
@@ -119,6 +155,15 @@ struct RunConfiguration
 
     /// The generated kernel signature convention (default: VeloxChemScreened).
     Signature signature = Signature::veloxchem_screened;
+
+    /// The generated kernel floating-point precision (default: fp64).
+    Precision precision = Precision::fp64;
+
+    /// The generated HRR kernel form (default: unrolled).
+    KernelForm kernel_form = KernelForm::unrolled;
+
+    /// The four-center electron repulsion scheme (default: obara_saika).
+    EriMethod eri_method = EriMethod::obara_saika;
 };
 
 /// Builds a validated run configuration from a parsed config.
@@ -128,6 +173,13 @@ struct RunConfiguration
 ///         momentum).
 RunConfiguration make_run_configuration(const Config& config);
 
+/// Validates the precision of a legacy ('type' schema) run: the legacy
+/// generators emit fp64 kernels only.
+/// @param config The parsed key/value configuration.
+/// @param type The legacy run type (for error messages); throws ConfigError on
+///         an unknown precision or any precision other than fp64.
+void check_legacy_precision(const Config& config, const std::string& type);
+
 /// @param value The hardware value.
 /// @return The canonical string spelling of a hardware value.
 std::string to_string(Hardware value);
@@ -149,6 +201,10 @@ std::string to_string(RecursionType value);
 ///         the generators recognize, e.g. "electron repulsion").
 std::string to_string(OperatorType value);
 
+/// @param value The operator-type value.
+/// @return True for the range-separated (erf/erfc attenuated) Coulomb operators.
+bool is_range_separated(OperatorType value);
+
 /// @param value The storage-form value.
 /// @return The canonical string spelling of a storage-form value.
 std::string to_string(StorageForm value);
@@ -157,6 +213,28 @@ std::string to_string(StorageForm value);
 /// @return The canonical string spelling of a signature value.
 std::string to_string(Signature value);
 
+/// @param value The precision value.
+/// @return The canonical string spelling of a precision value.
+std::string to_string(Precision value);
+
+/// @param value The kernel-form value.
+/// @return The canonical string spelling of a kernel-form value.
+std::string to_string(KernelForm value);
+
+/// @param value The ERI-method value.
+/// @return The canonical string spelling of an ERI-method value.
+std::string to_string(EriMethod value);
+
+/// @param value The precision value.
+/// @return The C++ type of the primitive (uncontracted) integral buffers: float
+///         for fp32 and mixed, double for fp64.
+std::string primitive_type(Precision value);
+
+/// @param value The precision value.
+/// @return The C++ type contracted integrals are accumulated and returned in:
+///         float for fp32, double for fp64 and mixed.
+std::string accumulator_type(Precision value);
+
 }  // namespace cfg
 
 #endif /* run_configuration_hpp */
@@ -0,0 +1,133 @@
+// LITMUS: An Automated Molecular Integrals Generator
+// Copyright 2022 Z. Rinkevicius, KTH, Sweden.
+// E-mail: rinkevic@kth.se
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "emitter_utils.hpp"
+
+#include "string_formater.hpp"
+
+namespace emit {  // emit namespace
+
+std::string
+precision_file_tag(cfg::Precision precision)
+{
+    // the switch carries no default, so a new Precision trips -Wswitch here
+
+    switch (precision)
+    {
+        case cfg::Precision::fp64:
+            return "";
+
+        case cfg::Precision::fp32:
+            return "Fp32";
+
+        case cfg::Precision::mixed:
+            return "Mixed";
+    }
+
+    return std::string();  // unreachable: every Precision is handled above
+}
+
+std::string
+precision_namespace(const std::string& ns, cfg::Precision precision)
+{
+    const auto tag = precision_file_tag(precision);
+
+    return tag.empty() ? ns : ns + "::" + fstr::lowercase(tag);
+}
+
+std::string
+osfunc_call(const std::string& name, const std::string& type)
+{
+    return "osfunc::" + name + ((type == "float") ? "<float>" : "");
+}
+
+std::vector<std::string>
+range_separation_docs(cfg::OperatorType op)
+{
+    if (!cfg::is_range_separated(op)) return {};
+
+    const auto term = (op == cfg::OperatorType::long_range_electron_repulsion) ? std::string("erf")
+                                                                                : std::string("erfc");
+
+    return {"/// @param omega The range-separation parameter w.",
+            "/// @param alpha The weight of the full Coulomb term 1/|r-r'|.",
+            "/// @param beta The weight of the attenuated term " + term + "(w|r-r'|)/|r-r'|; both terms",
+            "///        come from one pass through the recurrences."};
+}
+
+void
+add_eri_seeds(VCodeLines&        body,
+              cfg::OperatorType  op,
+              const std::string& type,
+              const std::string& args,
+              const std::string& seed,
+              const int          lmax,
+              const std::string& distance)
+{
+    const auto bra_ket = "(" + seed.substr(0, seed.size() / 2) + "|";
+
+    const auto ket_bra = "|" + seed.substr(seed.size() / 2) + ")";
+
+    body.push_back({1, 0, 1, "// Boys function arguments T = rho " + distance + "^2 and values F_m(T), m = 0, ..., " +
+                                 std::to_string(lmax)});
+    body.push_back({1, 0, 1, "const auto bt = " + osfunc_call("compute_boys_argument", type) + "(" + args + ");"});
+    body.push_back({1, 0, 1, "const auto bf = " + osfunc_call("compute_boys_function", type) + "(bt, " +
+                                 std::to_string(lmax) + ");"});
+    body.push_back({0, 0, 1, ""});
+
+    if (!cfg::is_range_separated(op))
+    {
+        body.push_back({1, 0, 1, "// primitive " + bra_ket + "1/|r-r'|" + ket_bra + "^m seeds"});
+
+        for (int m = 0; m <= lmax; m++)
+        {
+            body.push_back({1, 0, 1, "const auto " + seed + "_" + std::to_string(m) + " = " +
+                                         osfunc_call("compute_electron_repulsion", type) + "(" + args + ", bf, " +
+                                         std::to_string(m) + ");"});
+        }
+
+        body.push_back({0, 0, 1, ""});
+
+        return;
+    }
+
+    const auto long_range = (op == cfg::OperatorType::long_range_electron_repulsion);
+
+    body.push_back({1, 0, 1, "// attenuated Boys function arguments T w^2 / (w^2 + rho) and values, m = 0, ..., " +
+                                 std::to_string(lmax)});
+    body.push_back({1, 0, 1, "const auto bt_w = " + osfunc_call("compute_boys_argument", type) + "(" + args +
+                                 ", omega);"});
+    body.push_back({1, 0, 1, "const auto bf_w = " + osfunc_call("compute_boys_function", type) + "(bt_w, " +
+                                 std::to_string(lmax) + ");"});
+    body.push_back({0, 0, 1, ""});
+
+    const auto weights = long_range ? std::string("alpha, beta") : std::string("alpha + beta, -beta");
+
+    body.push_back({1, 0, 1, "// fused primitive " + bra_ket + "alpha/|r-r'| + beta " +
+                                 (long_range ? "erf" : "erfc") + "(w|r-r'|)/|r-r'|" + ket_bra + "^m seeds" +
+                                 (long_range ? "" : " (erfc = 1 - erf)")});
+
+    for (int m = 0; m <= lmax; m++)
+    {
+        body.push_back({1, 0, 1, "const auto " + seed + "_" + std::to_string(m) + " = " +
+                                     osfunc_call("compute_range_separated_electron_repulsion", type) + "(" + args +
+                                     ", bf, bf_w, " + std::to_string(m) + ", omega, " + weights + ");"});
+    }
+
+    body.push_back({0, 0, 1, ""});
+}
+
+}  // namespace emit
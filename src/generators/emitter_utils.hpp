@@ -0,0 +1,80 @@
+// LITMUS: An Automated Molecular Integrals Generator
+// Copyright 2022 Z. Rinkevicius, KTH, Sweden.
+// E-mail: rinkevic@kth.se
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef emitter_utils_hpp
+#define emitter_utils_hpp
+
+#include <string>
+#include <vector>
+
+#include "file_stream.hpp"
+#include "run_configuration.hpp"
+
+/// Helpers shared by the new-style C++/CPU two-, three- and four-center emitters.
+namespace emit {  // emit namespace
+
+/// The file-name tag of a precision: none for fp64 (the default kernels keep
+/// their names), "Fp32" or "Mixed" otherwise.
+/// @param precision The precision.
+/// @return The file-name tag.
+std::string precision_file_tag(cfg::Precision precision);
+
+/// The namespace of the workflow kernels of a precision: the operator namespace
+/// for fp64, a nested "fp32"/"mixed" namespace otherwise (the kernels differ
+/// only in return type, so they cannot overload).
+/// @param ns The operator namespace, e.g. "os2c::ovl".
+/// @param precision The precision.
+/// @return The kernel namespace.
+std::string precision_namespace(const std::string& ns, cfg::Precision precision);
+
+/// A call to an osfunc helper in the given value type: the helpers default to
+/// double, so only float is spelled out, e.g. "osfunc::compute_pb<float>".
+/// @param name The helper name, e.g. "compute_pb".
+/// @param type The value type name.
+/// @return The qualified helper name.
+std::string osfunc_call(const std::string& name, const std::string& type);
+
+/// The documentation lines of the runtime range-separation parameters of a
+/// fused kernel; none for an unattenuated operator.
+/// @param op The integrand operator type.
+/// @return The documentation lines.
+std::vector<std::string> range_separation_docs(cfg::OperatorType op);
+
+/// Adds the Boys function values and the order-indexed seeds, e.g. (s|o|s)^m or
+/// (ss|o|ss)^m, to a kernel body. A range-separated operator also needs the
+/// attenuated Boys values F_m(T w^2 / (w^2 + rho)); its seeds fuse the full and
+/// the attenuated terms, alpha (..|1/|r-r'||..)^m + beta (..|erf(w|r-r'|)/|r-r'||..)^m,
+/// so the Coulomb recurrences run once for both (erfc enters as 1 - erf, i.e.
+/// with weights alpha + beta and -beta).
+/// @param body The kernel body lines to append to.
+/// @param op The integrand operator type.
+/// @param type The primitive value type.
+/// @param args The leading seed helper arguments, e.g. "pair" or "bra, ket".
+/// @param seed The seed name prefix, e.g. "ss" or "ssss".
+/// @param lmax The highest seed order.
+/// @param distance The distance entering the Boys argument, "|AB|" for two
+///        centers or "|PQ|" for the Gaussian product centers.
+void add_eri_seeds(VCodeLines&        body,
+                   cfg::OperatorType  op,
+                   const std::string& type,
+                   const std::string& args,
+                   const std::string& seed,
+                   const int          lmax,
+                   const std::string& distance);
+
+}  // namespace emit
+
+#endif /* emitter_utils_hpp */
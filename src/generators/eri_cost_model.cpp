@@ -0,0 +1,143 @@
+// LITMUS: An Automated Molecular Integrals Generator
+// Copyright 2022 Z. Rinkevicius, KTH, Sweden.
+// E-mail: rinkevic@kth.se
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "eri_cost_model.hpp"
+
+#include <algorithm>
+
+#include "v4i_eri_driver.hpp"
+
+namespace {  // cost model helpers
+
+/// The number of Cartesian components of a shell of angular momentum l.
+/// @param l The angular momentum.
+/// @return The Cartesian component count.
+long
+cartesian_count(int l)
+{
+    return (l + 1) * (l + 2) / 2;
+}
+
+/// The Cartesian row count of a four-center integral block (ab|o|cd).
+/// @param integral The four-center integral.
+/// @return The Cartesian component count of the block.
+long
+cartesian_rows(const I4CIntegral& integral)
+{
+    return cartesian_count(integral[0]) * cartesian_count(integral[1]) * cartesian_count(integral[2]) *
+           cartesian_count(integral[3]);
+}
+
+}  // namespace
+
+namespace cost {  // cost namespace
+
+int
+rys_roots(const I4CIntegral& integral)
+{
+    return (integral[0] + integral[1] + integral[2] + integral[3]) / 2 + 1;
+}
+
+long
+obara_saika_flops(const SI4CIntegrals& bra_hrr_ints,
+                  const SI4CIntegrals& ket_hrr_ints,
+                  const SI4CIntegrals& vrr_ints)
+{
+    const auto eri_drv = V4IElectronRepulsionDriver();
+
+    long flops = 0;
+
+    // Boys function (table lookup and Taylor expansion of the top order, then
+    // downward recursion) and the (ss|ss)^m seeds
+
+    int mmax = 0;
+
+    for (const auto& tint : vrr_ints)
+    {
+        mmax = std::max(mmax, tint[0] + tint[1] + tint[2] + tint[3] + tint.order());
+    }
+
+    flops += 20 + 5 * (mmax + 1);
+
+    // vertical recurrence: B on the bra side, then D on the ket side
+
+    for (const auto& tint : vrr_ints)
+    {
+        if ((tint[1] + tint[3]) == 0) continue;
+
+        const auto terms = (tint[1] > 0) ? eri_drv.bra_vrr(tint).size() : eri_drv.ket_vrr(tint).size();
+
+        flops += 2 * static_cast<long>(terms) * cartesian_rows(tint);
+    }
+
+    // horizontal recurrences: ket steps with c > 0, bra steps with a > 0
+
+    for (const auto& tint : ket_hrr_ints)
+    {
+        if (tint[2] > 0) flops += 2 * static_cast<long>(eri_drv.ket_hrr(tint).size()) * cartesian_rows(tint);
+    }
+
+    for (const auto& tint : bra_hrr_ints)
+    {
+        if (tint[0] > 0) flops += 2 * static_cast<long>(eri_drv.bra_hrr(tint).size()) * cartesian_rows(tint);
+    }
+
+    return flops;
+}
+
+long
+rys_flops(const I4CIntegral& integral)
+{
+    const long la = integral[0];
+
+    const long lb = integral[1];
+
+    const long lc = integral[2];
+
+    const long ld = integral[3];
+
+    const long nab = la + lb;
+
+    const long ncd = lc + ld;
+
+    // roots and weights by piecewise polynomial fits (about ten terms each),
+    // then per root the B00, B10, B01 coefficients and the C00, D00 of each axis
+
+    const long nroots = rys_roots(integral);
+
+    long per_root = 35;
+
+    // 2D vertical recurrence: up to three terms per G(n, m) entry
+
+    per_root += 3 * 4 * (nab + 1) * (ncd + 1);
+
+    // stepwise bra transfer I(i, j, m) = I(i+1, j-1, m) + AB I(i, j-1, m)
+
+    for (long j = 1; j <= lb; j++) per_root += 3 * 2 * (nab - j + 1) * (ncd + 1);
+
+    // stepwise ket transfer over the (la, lb) bra entries
+
+    for (long l = 1; l <= ld; l++) per_root += 3 * 2 * (la + 1) * (lb + 1) * (ncd - l + 1);
+
+    // assembly: w Ix Iy Iz accumulated into every Cartesian component
+
+    per_root += 4 * cartesian_rows(integral);
+
+    return 50 * nroots + nroots * per_root;
+}
+
+}  // namespace cost
@@ -0,0 +1,56 @@
+// LITMUS: An Automated Molecular Integrals Generator
+// Copyright 2022 Z. Rinkevicius, KTH, Sweden.
+// E-mail: rinkevic@kth.se
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef eri_cost_model_hpp
+#define eri_cost_model_hpp
+
+#include "t4c_defs.hpp"
+
+namespace cost {  // cost namespace
+
+/// The number of Rys quadrature roots that integrate a four-center electron
+/// repulsion integral exactly: the integrand polynomial in t^2 has degree
+/// L = la + lb + lc + ld, so N = L/2 + 1 roots suffice.
+/// @param integral The target four-center integral (ab|o|cd).
+/// @return The number of Rys roots.
+int rys_roots(const I4CIntegral& integral);
+
+/// Estimates the floating-point operation count of one primitive quadruple of
+/// an Obara-Saika kernel: the Boys function and (ss|ss)^m seeds, every VRR step
+/// (two operations per recursion term and Cartesian row), and every HRR step
+/// (two operations per recursion term and Cartesian row). The HRR steps are
+/// counted per primitive too, i.e. for uncontracted shells, which is the usual
+/// case at the angular momenta where the choice matters.
+/// @param bra_hrr_ints The bra HRR integrals of the target.
+/// @param ket_hrr_ints The ket HRR integrals of the target.
+/// @param vrr_ints The VRR integrals (base and rest) of the target.
+/// @return The estimated operation count.
+long obara_saika_flops(const SI4CIntegrals& bra_hrr_ints,
+                       const SI4CIntegrals& ket_hrr_ints,
+                       const SI4CIntegrals& vrr_ints);
+
+/// Estimates the floating-point operation count of one primitive quadruple of
+/// a Rys quadrature kernel: the roots and weights, and per root the 2D vertical
+/// recurrence and the stepwise 2D horizontal transfers on each axis, plus the
+/// w Ix Iy Iz assembly of every Cartesian component.
+/// @param integral The target four-center integral (ab|o|cd).
+/// @return The estimated operation count.
+long rys_flops(const I4CIntegral& integral);
+
+}  // namespace cost
+
+#endif /* eri_cost_model_hpp */
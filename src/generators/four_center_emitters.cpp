@@ -0,0 +1,1171 @@
+// LITMUS: An Automated Molecular Integrals Generator
+// Copyright 2022 Z. Rinkevicius, KTH, Sweden.
+// E-mail: rinkevic@kth.se
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "four_center_emitters.hpp"
+
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "config.hpp"
+#include "emitter_utils.hpp"
+#include "file_stream.hpp"
+#include "operator.hpp"
+#include "string_formater.hpp"
+#include "tensor.hpp"
+
+#include "eri_cost_model.hpp"
+#include "t4c_utils.hpp"
+#include "v4i_eri_driver.hpp"
+
+namespace {  // C++/CPU emitter helpers
+
+/// The naming tags for an integrand operator: the (C++17 nested) namespace the
+/// kernel lives in and the CamelCase label used in its file name.
+struct OperatorTags
+{
+    /// The fully-qualified kernel namespace, e.g. "os4c::eri".
+    std::string ns;
+
+    /// The operator namespace shared by the kernel families, e.g. "eri".
+    std::string tag;
+
+    /// The CamelCase operator label used in file names, e.g. "ElectronRepulsion".
+    std::string file_label;
+
+    /// The human-readable operator caption for documentation.
+    std::string caption;
+};
+
+/// Maps an integrand operator to its naming tags. Only the operators the
+/// four-center generator currently supports are named; the rest fall through to
+/// a thrown error. The switch carries no default, so a new OperatorType trips
+/// -Wswitch here.
+/// @param op The integrand operator type.
+/// @return The naming tags for the operator.
+OperatorTags
+operator_tags(cfg::OperatorType op)
+{
+    switch (op)
+    {
+        case cfg::OperatorType::electron_repulsion:
+            return {"os4c::eri", "eri", "ElectronRepulsion", "electron repulsion"};
+
+        case cfg::OperatorType::long_range_electron_repulsion:
+            return {"os4c::erf", "erf", "LongRangeElectronRepulsion", "long-range electron repulsion"};
+
+        case cfg::OperatorType::short_range_electron_repulsion:
+            return {"os4c::erfc", "erfc", "ShortRangeElectronRepulsion", "short-range electron repulsion"};
+
+        // remaining operators have no four-center kernel yet
+        case cfg::OperatorType::overlap:
+        case cfg::OperatorType::kinetic_energy:
+        case cfg::OperatorType::nuclear_potential:
+        case cfg::OperatorType::dipole_momentum:
+        case cfg::OperatorType::linear_momentum:
+        case cfg::OperatorType::three_center_overlap:
+        case cfg::OperatorType::three_center_r2:
+        case cfg::OperatorType::three_center_r_dot_r2:
+        case cfg::OperatorType::local_ecp:
+        case cfg::OperatorType::projected_ecp:
+            break;
+    }
+
+    throw cfg::ConfigError("four-center emitter: operator '" + cfg::to_string(op) +
+                           "' has no four-center kernel naming");
+}
+
+/// The lowercase spectroscopic shell label (s, p, d, f, ...) of an angular
+/// momentum.
+/// @param ang_mom The angular momentum.
+/// @return The lowercase shell label.
+std::string
+shell_label(int ang_mom)
+{
+    return fstr::lowercase(Tensor(ang_mom).label());
+}
+
+/// The number of Cartesian components of a shell of angular momentum l,
+/// (l + 1)(l + 2)/2.
+/// @param l The angular momentum.
+/// @return The Cartesian component count.
+int
+cartesian_count(int l)
+{
+    return (l + 1) * (l + 2) / 2;
+}
+
+/// The Cartesian row count of a pair of shells.
+/// @param la The angular momentum of the first shell.
+/// @param lb The angular momentum of the second shell.
+/// @return The Cartesian component count of the pair.
+int
+cartesian_count(int la, int lb)
+{
+    return cartesian_count(la) * cartesian_count(lb);
+}
+
+/// The Cartesian row count of a four-center integral block (ab|o|cd).
+/// @param integral The four-center integral.
+/// @return The Cartesian component count of the block.
+int
+cartesian_rows(const I4CIntegral& integral)
+{
+    return cartesian_count(integral[0], integral[1]) * cartesian_count(integral[2], integral[3]);
+}
+
+/// The shell labels of a four-center integral, e.g. (SP|o|SD) -> "spsd".
+/// @param integral The four-center integral.
+/// @return The concatenated shell labels.
+std::string
+shells_label(const I4CIntegral& integral)
+{
+    return shell_label(integral[0]) + shell_label(integral[1]) + shell_label(integral[2]) +
+           shell_label(integral[3]);
+}
+
+/// The order-indexed name of a primitive integral, e.g. (SP|o|SD)^1 -> "spsd_1".
+/// @param integral The four-center integral.
+/// @return The primitive variable name.
+std::string
+primitive_name(const I4CIntegral& integral)
+{
+    return shells_label(integral) + "_" + std::to_string(integral.order());
+}
+
+/// The name of a contracted Cartesian integral block, e.g. (SP|o|PD) -> "csppd".
+/// @param integral The four-center integral.
+/// @return The contracted variable name.
+std::string
+contracted_name(const I4CIntegral& integral)
+{
+    return "c" + shells_label(integral);
+}
+
+/// The kernel function name for a target integral, e.g. "compute_s_p_p_d".
+/// @param integral The target four-center integral.
+/// @return The function name.
+std::string
+kernel_func_name(const I4CIntegral& integral)
+{
+    return "compute_" + shell_label(integral[0]) + "_" + shell_label(integral[1]) + "_" +
+           shell_label(integral[2]) + "_" + shell_label(integral[3]);
+}
+
+/// The base file name (no extension) for a target integral's kernel, e.g.
+/// "ObaraSaikaFourCenterElectronRepulsionSPPD"; the .hpp/.cpp pair share it.
+/// @param scheme The integral scheme prefix, "ObaraSaika" or "Rys".
+/// @param run_config The run configuration (selects operator and precision).
+/// @param integral The target four-center integral.
+/// @return The base file name.
+std::string
+kernel_file_name(const std::string& scheme, const cfg::RunConfiguration& run_config, const I4CIntegral& integral)
+{
+    return scheme + "FourCenter" + operator_tags(run_config.operator_type).file_label +
+           Tensor(integral[0]).label() + Tensor(integral[1]).label() + Tensor(integral[2]).label() +
+           Tensor(integral[3]).label() + emit::precision_file_tag(run_config.precision);
+}
+
+/// The return type of a kernel for a storage form. The switch carries no
+/// default, so a new StorageForm trips -Wswitch here.
+/// @param form The storage form.
+/// @param precision The precision (selects the contracted value type).
+/// @return The return type name.
+std::string
+return_type(cfg::StorageForm form, cfg::Precision precision)
+{
+    switch (form)
+    {
+        case cfg::StorageForm::veloxchem_sparse:
+            return "osfunc::CArray<" + cfg::accumulator_type(precision) + ">";
+    }
+
+    return std::string();  // unreachable: every StorageForm is handled above
+}
+
+/// The input parameters of a kernel for a signature, as "type name" fragments.
+/// The screened signature takes a screened pair block on each side. The switch
+/// carries no default, so a new Signature trips -Wswitch here.
+/// @param signature The kernel signature convention.
+/// @return The input parameter fragments.
+std::vector<std::string>
+input_params(cfg::Signature signature)
+{
+    switch (signature)
+    {
+        case cfg::Signature::veloxchem_screened:
+            return {"const osfunc::CBasisFunctionPair& bra", "const osfunc::CBasisFunctionPair& ket"};
+    }
+
+    return {};  // unreachable: every Signature is handled above
+}
+
+/// The header includes a kernel needs for its return and input types.
+/// @param run_config The run configuration (selects storage form and signature).
+/// @return The include lines (with quotes).
+std::vector<std::string>
+kernel_includes(const cfg::RunConfiguration& run_config)
+{
+    std::vector<std::string> vstr;
+
+    switch (run_config.storage_form)
+    {
+        case cfg::StorageForm::veloxchem_sparse:
+            vstr.push_back("#include \"Array.hpp\"");
+            break;
+    }
+
+    switch (run_config.signature)
+    {
+        case cfg::Signature::veloxchem_screened:
+            vstr.push_back("#include \"BasisFunctionPair.hpp\"");
+            break;
+    }
+
+    return vstr;
+}
+
+/// Formats a four-center integral as a "(AB|operator|CD)" caption for use in
+/// generated comments.
+/// @param integral The four-center integral.
+/// @return The caption.
+std::string
+integral_caption(const I4CIntegral& integral)
+{
+    return "(" + Tensor(integral[0]).label() + Tensor(integral[1]).label() + "|" + integral.integrand().name() +
+           "|" + Tensor(integral[2]).label() + Tensor(integral[3]).label() + ")";
+}
+
+/// Appends the Cartesian-to-spherical transformation of a contracted block
+/// (ab|o|cd) into buffer, as a ket half transformation (ab|c'd') followed by a
+/// bra half transformation (a'b'|c'd'). Each spherical row reads only the
+/// Cartesian rows with non-zero solid-harmonic factors, with equal factor
+/// magnitudes grouped (see t4c::sparse_sum), instead of the dense
+/// osfunc::transform over the full Cartesian block.
+/// @param body The kernel body code lines.
+/// @param acc_type The accumulator type of the contracted block.
+/// @param source The contracted Cartesian block name.
+/// @param integral The target four-center integral.
+void
+add_sparse_transform(VCodeLines& body, const std::string& acc_type, const std::string& source, const I4CIntegral& integral)
+{
+    const auto ncart_ab = cartesian_count(integral[0], integral[1]);
+
+    const auto ncart_cd = cartesian_count(integral[2], integral[3]);
+
+    const auto nsph_cd = (2 * integral[2] + 1) * (2 * integral[3] + 1);
+
+    // one half transformation of pair (l0, l1), looping over the Cartesian (ket)
+    // or spherical (bra) rows of the other pair
+
+    const auto add_half = [&](const std::string& src, const std::string& dst, const std::string& loop,
+                              const int l0, const int l1, const int nloop, const bool ket) {
+        std::vector<std::vector<t4c::SparseTerm>> rows;
+
+        std::vector<std::size_t> sources;
+
+        for (int i = 0; i < 2 * l0 + 1; i++)
+        {
+            for (int j = 0; j < 2 * l1 + 1; j++)
+            {
+                std::vector<t4c::SparseTerm> terms;
+
+                for (const auto& [cart, coef] : t4c::spherical_pair_terms(l0, l1, i, j))
+                {
+                    terms.push_back({"c_" + std::to_string(cart), coef});
+
+                    if (std::find(sources.begin(), sources.end(), cart) == sources.end()) sources.push_back(cart);
+                }
+
+                rows.push_back(terms);
+            }
+        }
+
+        std::sort(sources.begin(), sources.end());
+
+        const auto row_label = [&](const std::size_t row, const int stride) {
+            return ket ? std::to_string(stride) + " * " + loop + " + " + std::to_string(row)
+                       : std::to_string(stride) + " * " + std::to_string(row) + " + " + loop;
+        };
+
+        body.push_back({1, 0, 1, "for (std::size_t " + loop + " = 0; " + loop + " < " + std::to_string(nloop) + "; " +
+                                     loop + "++)"});
+        body.push_back({1, 0, 1, "{"});
+
+        for (const auto row : sources)
+        {
+            body.push_back({2, 0, 1, "const auto c_" + std::to_string(row) + " = " + src + ".data(" +
+                                         row_label(row, ket ? ncart_cd : nsph_cd) + ");"});
+        }
+
+        body.push_back({0, 0, 1, ""});
+
+        for (std::size_t i = 0; i < rows.size(); i++)
+        {
+            body.push_back({2, 0, 1, "auto s_" + std::to_string(i) + " = " + dst + ".data(" +
+                                         row_label(i, nsph_cd) + ");"});
+        }
+
+        body.push_back({0, 0, 1, ""});
+        body.push_back({2, 0, 1, "#pragma omp simd"});
+        body.push_back({2, 0, 1, "for (std::size_t k = 0; k < ncols; k++)"});
+        body.push_back({2, 0, 1, "{"});
+
+        for (std::size_t i = 0; i < rows.size(); i++)
+        {
+            body.push_back({3, 0, 1, "s_" + std::to_string(i) + "[k] = " + t4c::sparse_sum(rows[i]) + ";"});
+        }
+
+        body.push_back({2, 0, 1, "}"});
+        body.push_back({1, 0, 1, "}"});
+    };
+
+    body.push_back({1, 0, 1, "// sparse transformation to spherical form, ket then bra half: every"});
+    body.push_back({1, 0, 1, "// spherical row reads only Cartesian rows with non-zero factors"});
+    body.push_back({1, 0, 2, "osfunc::CArray<" + acc_type + "> half(" + std::to_string(ncart_ab * nsph_cd) +
+                                 ", ncols);"});
+
+    add_half(source, "half", "ab", integral[2], integral[3], ncart_ab, true);
+
+    body.push_back({0, 0, 1, ""});
+
+    add_half("half", "buffer", "cd", integral[0], integral[1], nsph_cd, false);
+}
+
+/// The kernel signature, as code lines, broken across lines and aligned under
+/// the function name when there is more than one input parameter.
+/// @param run_config The run configuration (selects inputs and return type).
+/// @param integral The target integral (names the function).
+/// @param terminus Whether to terminate with a ';' (declaration).
+/// @return The signature lines.
+std::vector<std::string>
+signature_lines(const cfg::RunConfiguration& run_config, const I4CIntegral& integral, const bool terminus)
+{
+    std::vector<std::string> vstr;
+
+    const auto name = kernel_func_name(integral) + "(";
+
+    const auto spacer = std::string(name.size(), ' ');
+
+    auto params = input_params(run_config.signature);
+
+    if (cfg::is_range_separated(run_config.operator_type))
+    {
+        params.insert(params.end(), {"const double omega", "const double alpha", "const double beta"});
+    }
+
+    const auto tail = ") -> " + return_type(run_config.storage_form, run_config.precision) + (terminus ? ";" : "");
+
+    for (std::size_t i = 0; i < params.size(); i++)
+    {
+        const auto head = (i == 0) ? name : spacer;
+
+        const auto last = (i + 1 == params.size());
+
+        vstr.push_back(head + params[i] + (last ? tail : ","));
+    }
+
+    return vstr;
+}
+
+/// Writes the kernel declaration header (.hpp) shared by the Obara-Saika and Rys
+/// kernels of a target.
+/// @param run_config The run configuration (selects the signature).
+/// @param integral The target four-center integral.
+/// @param ns The kernel namespace.
+/// @param base The base file name of the kernel.
+/// @param sink The output sink receiving the header.
+void
+write_kernel_hpp(const cfg::RunConfiguration& run_config,
+                 const I4CIntegral&           integral,
+                 const std::string&           ns,
+                 const std::string&           base,
+                 ost::OutputSink&             sink)
+{
+    const auto tags = operator_tags(run_config.operator_type);
+
+    const auto guard = base + "_hpp";
+
+    auto lines = VCodeLines();
+
+    lines.push_back({0, 0, 1, "#ifndef " + guard});
+    lines.push_back({0, 0, 2, "#define " + guard});
+
+    for (const auto& include : kernel_includes(run_config))
+    {
+        lines.push_back({0, 0, 1, include});
+    }
+    lines.push_back({0, 0, 1, ""});
+
+    lines.push_back({0, 0, 2, "namespace " + ns + " {  // " + tags.caption +
+                                  " four-center integrals"});
+
+    lines.push_back({0, 0, 1, "/// @brief Computes " + integral_caption(integral) +
+                                  " integrals for screened bra and ket pairs of basis"});
+    lines.push_back({0, 0, 1, "/// functions."});
+    lines.push_back({0, 0, 1, "/// @param bra The screened bra pair of basis functions."});
+    lines.push_back({0, 0, 1, "/// @param ket The screened ket pair of basis functions."});
+
+    for (const auto& label : emit::range_separation_docs(run_config.operator_type))
+    {
+        lines.push_back({0, 0, 1, label});
+    }
+
+    lines.push_back({0, 0, 1, "/// @return The matrix of computed integrals, one (bra pair, ket pair)"});
+    lines.push_back({0, 0, 1, "///         combination per column."});
+
+    lines.push_back({0, 0, 1, "auto"});
+
+    for (const auto& label : signature_lines(run_config, integral, true))
+    {
+        lines.push_back({0, 0, 1, label});
+    }
+
+    lines.push_back({0, 0, 2, "}  // namespace " + ns});
+
+    lines.push_back({0, 0, 1, "#endif /* " + guard + " */"});
+
+    std::ostringstream fstream;
+
+    ost::write_code_lines(fstream, lines);
+
+    sink.write({base + ".hpp", fstream.str()});
+}
+
+/// The four-center emitter for the C++ language on CPU hardware. Produces a
+/// header/definition pair whose body lays out the Boys-seeded workflow (Boys
+/// values -> bra and ket VRR -> contraction -> ket HRR -> bra HRR -> spherical
+/// store) over a screened bra pair block and a screened ket pair block.
+class CppCpuFourCenterEmitter : public FourCenterEmitter
+{
+    /// Writes the kernel definition (.cpp) carrying the computation workflow.
+    void _write_cpp(const cfg::RunConfiguration& run_config,
+                    const I4CIntegral&           integral,
+                    const SI4CIntegrals&         bra_hrr_ints,
+                    const SI4CIntegrals&         ket_hrr_ints,
+                    const SI4CIntegrals&         vrr_base_ints,
+                    const SI4CIntegrals&         vrr_rest_ints,
+                    ost::OutputSink&             sink) const;
+
+public:
+    void emit(const cfg::RunConfiguration& run_config,
+              const I4CIntegral&           integral,
+              const SI4CIntegrals&         bra_hrr_ints,
+              const SI4CIntegrals&         ket_hrr_ints,
+              const SI4CIntegrals&         vrr_base_ints,
+              const SI4CIntegrals&         vrr_rest_ints,
+              ost::OutputSink&             sink) const override;
+};
+
+void
+CppCpuFourCenterEmitter::_write_cpp(const cfg::RunConfiguration& run_config,
+                                    const I4CIntegral&           integral,
+                                    const SI4CIntegrals&         bra_hrr_ints,
+                                    const SI4CIntegrals&         ket_hrr_ints,
+                                    const SI4CIntegrals&         vrr_base_ints,
+                                    const SI4CIntegrals&         vrr_rest_ints,
+                                    ost::OutputSink&             sink) const
+{
+    const auto tags = operator_tags(run_config.operator_type);
+
+    const auto ns = emit::precision_namespace(tags.ns, run_config.precision);
+
+    const auto base = kernel_file_name("ObaraSaika", run_config, integral);
+
+    // primitive integrals are held in the primitive type, contracted integrals
+    // and the result in the accumulator type; the kernel headers are tagged to
+    // match.
+    const auto type = cfg::primitive_type(run_config.precision);
+
+    const auto acc_type = cfg::accumulator_type(run_config.precision);
+
+    const auto cart_tag = (type == "float") ? std::string("Fp32") : std::string();
+
+    const auto hrr_tag = (acc_type == "float") ? std::string("Fp32") : std::string();
+
+    const int la = integral[0];
+
+    const int lb = integral[1];
+
+    const int lc = integral[2];
+
+    const int ld = integral[3];
+
+    const int lmax = la + lb + lc + ld;
+
+    const int nspher = (2 * la + 1) * (2 * lb + 1) * (2 * lc + 1) * (2 * ld + 1);
+
+    // order the VRR closure and the HRR base by total angular momentum, lowest
+    // first: every recursion term sits strictly below the integral it builds.
+    const auto by_l = [](const I4CIntegral& a, const I4CIntegral& b) {
+        const auto la = a[0] + a[1] + a[2] + a[3];
+
+        const auto lb = b[0] + b[1] + b[2] + b[3];
+
+        if (la != lb) return la < lb;
+
+        return a < b;
+    };
+
+    std::vector<I4CIntegral> vrr_ordered(vrr_base_ints.begin(), vrr_base_ints.end());
+
+    vrr_ordered.insert(vrr_ordered.end(), vrr_rest_ints.begin(), vrr_rest_ints.end());
+
+    std::sort(vrr_ordered.begin(), vrr_ordered.end(), by_l);
+
+    std::vector<I4CIntegral> base_ordered(vrr_base_ints.begin(), vrr_base_ints.end());
+
+    std::sort(base_ordered.begin(), base_ordered.end(), by_l);
+
+    // the HRR steps, lowest transferred momentum first (each step consumes the
+    // row below it): the ket steps (c > 0) build the (0b'|cd) row the bra steps
+    // (a > 0) consume.
+    const auto hrr_steps = [](const SI4CIntegrals& tints, const int center) {
+        std::vector<I4CIntegral> steps;
+
+        for (const auto& tint : tints)
+        {
+            if (tint[center] > 0) steps.push_back(tint);
+        }
+
+        std::sort(steps.begin(), steps.end(), [center](const I4CIntegral& a, const I4CIntegral& b) {
+            if (a[center] != b[center]) return a[center] < b[center];
+
+            return a < b;
+        });
+
+        return steps;
+    };
+
+    const auto ket_ordered = hrr_steps(ket_hrr_ints, 2);
+
+    const auto bra_ordered = hrr_steps(bra_hrr_ints, 0);
+
+    const auto eri_drv = V4IElectronRepulsionDriver();
+
+    // build the body and the set of os4c kernel headers it calls.
+    auto body = VCodeLines();
+
+    std::set<std::string> headers;
+
+    body.push_back({1, 0, 1, "// number of screened bra and ket pairs"});
+    body.push_back({1, 0, 1, "const auto ncols = bra.number_of_pairs() * ket.number_of_pairs();"});
+    body.push_back({0, 0, 1, ""});
+
+    body.push_back({1, 0, 1, "// spherical (2*la+1) x (2*lb+1) x (2*lc+1) x (2*ld+1) result, one (bra pair,"});
+    body.push_back({1, 0, 1, "// ket pair) combination per column"});
+    body.push_back({1, 0, 1, "osfunc::CArray<" + acc_type + "> buffer(" + std::to_string(nspher) +
+                                 ", ncols);"});
+    body.push_back({0, 0, 1, ""});
+
+    body.push_back({1, 0, 1, "// number of primitive (bra pair, ket pair) combinations per column"});
+    body.push_back({1, 0, 1, "const auto nprims = bra.number_of_primitive_pairs() * ket.number_of_primitive_pairs();"});
+    body.push_back({0, 0, 1, ""});
+
+    emit::add_eri_seeds(body, run_config.operator_type, type, "bra, ket", "ssss", lmax, "|PQ|");
+
+    if (lmax == 0)
+    {
+        // (ss|ss): the contracted zeroth-order seeds are the spherical result.
+        body.push_back({1, 0, 1, "// (ss|ss): the contracted zeroth-order seeds are the result"});
+        body.push_back({1, 0, 1, "osfunc::contract(buffer, ssss_0);"});
+    }
+    else
+    {
+        // the bra VRR steps with PB = P - B and WP = W - P, the ket VRR with
+        // QD = Q - D and WQ = W - Q; only the distances some step consumes are
+        // computed.
+        const auto has_bra_vrr = std::any_of(vrr_ordered.begin(), vrr_ordered.end(), [](const I4CIntegral& tint) {
+            return tint[1] > 0;
+        });
+
+        const auto has_ket_vrr = std::any_of(vrr_ordered.begin(), vrr_ordered.end(), [](const I4CIntegral& tint) {
+            return (tint[1] == 0) && (tint[3] > 0);
+        });
+
+        body.push_back({1, 0, 1, "// P - B, W - P, Q - D and W - Q distances consumed by the vertical recurrence"});
+
+        if (has_bra_vrr)
+        {
+            body.push_back({1, 0, 1, "const auto pb = " + emit::osfunc_call("compute_pb", type) + "(bra);"});
+            body.push_back({1, 0, 1, "const auto wp = " + emit::osfunc_call("compute_wp", type) + "(bra, ket);"});
+        }
+
+        if (has_ket_vrr)
+        {
+            body.push_back({1, 0, 1, "const auto qd = " + emit::osfunc_call("compute_qd", type) + "(ket);"});
+            body.push_back({1, 0, 1, "const auto wq = " + emit::osfunc_call("compute_wq", type) + "(bra, ket);"});
+        }
+
+        body.push_back({0, 0, 1, ""});
+
+        // vertical recurrence: each step takes exactly the terms the
+        // V4IElectronRepulsionDriver expands it into, in the driver's order.
+        body.push_back({1, 0, 1, "// vertical recurrence: order-indexed primitive Cartesian integrals"});
+
+        for (const auto& tint : vrr_ordered)
+        {
+            if ((tint[1] + tint[3]) == 0) continue;  // the (ss|ss)^m seeds are "ssss_m"
+
+            const auto on_bra = (tint[1] > 0);
+
+            std::string args = "bra, ket, ";
+
+            for (const auto& rint : (on_bra ? eri_drv.bra_vrr(tint) : eri_drv.ket_vrr(tint)))
+            {
+                args += primitive_name(rint) + ", ";
+            }
+
+            args += on_bra ? "pb, wp, " : "qd, wq, ";
+
+            const auto name = primitive_name(tint);
+
+            body.push_back({1, 0, 1, "osfunc::CArray<" + type + "> " + name + "(nprims * " +
+                                         std::to_string(cartesian_rows(tint)) + ", ncols);"});
+            body.push_back({1, 0, 1, "os4c::vrr::eri::compute_" + shell_label(tint[1]) + "_" +
+                                         shell_label(tint[3]) + "(" + args + name + ");"});
+
+            headers.insert("ObaraSaikaFourCenterElectronRepulsionVrr" + Tensor(tint[1]).label() +
+                           Tensor(tint[3]).label() + cart_tag + ".hpp");
+        }
+
+        body.push_back({0, 0, 1, ""});
+
+        // contract the zeroth-order VRR integrals the HRR steps consume.
+        body.push_back({1, 0, 1, "// contract the base integrals consumed by the horizontal recurrences"});
+
+        for (const auto& tint : base_ordered)
+        {
+            body.push_back({1, 0, 1, "osfunc::CArray<" + acc_type + "> " + contracted_name(tint) + "(" +
+                                         std::to_string(cartesian_rows(tint)) + ", ncols);"});
+            body.push_back({1, 0, 1, "osfunc::contract(" + contracted_name(tint) + ", " +
+                                         primitive_name(tint) + ");"});
+        }
+
+        body.push_back({0, 0, 1, ""});
+
+        // ket horizontal recurrence: (0b|c,d) from (0b|c-1,d+1) and (0b|c-1,d)
+        // with CD distances; the xx kernels are generic in the bra momenta.
+        if (!ket_ordered.empty())
+        {
+            body.push_back({1, 0, 1, "// ket horizontal recurrence on contracted Cartesian integrals"});
+            body.push_back({1, 0, 1, "const auto cd = " + emit::osfunc_call("compute_cd", acc_type) + "(ket);"});
+
+            for (const auto& tint : ket_ordered)
+            {
+                std::string args = std::to_string(cartesian_count(tint[0], tint[1])) + ", ";
+
+                for (const auto& rint : eri_drv.ket_hrr(tint))
+                {
+                    args += contracted_name(rint) + ", ";
+                }
+
+                const auto name = contracted_name(tint);
+
+                body.push_back({1, 0, 1, "osfunc::CArray<" + acc_type + "> " + name + "(" +
+                                             std::to_string(cartesian_rows(tint)) + ", ncols);"});
+                body.push_back({1, 0, 1, "os4c::hrr::compute_xx_" + shell_label(tint[2]) + "_" +
+                                             shell_label(tint[3]) + "(" + args + "cd, " + name + ");"});
+
+                headers.insert("ObaraSaikaFourCenterHrrXX" + Tensor(tint[2]).label() +
+                               Tensor(tint[3]).label() + hrr_tag + ".hpp");
+            }
+
+            body.push_back({0, 0, 1, ""});
+        }
+
+        // bra horizontal recurrence: (a,b|cd) from (a-1,b+1|cd) and (a-1,b|cd)
+        // with AB distances; the xx kernels are generic in the ket momenta.
+        if (!bra_ordered.empty())
+        {
+            body.push_back({1, 0, 1, "// bra horizontal recurrence on contracted Cartesian integrals"});
+            body.push_back({1, 0, 1, "const auto ab = " + emit::osfunc_call("compute_ab", acc_type) + "(bra);"});
+
+            for (const auto& tint : bra_ordered)
+            {
+                std::string args = std::to_string(cartesian_count(tint[2], tint[3])) + ", ";
+
+                for (const auto& rint : eri_drv.bra_hrr(tint))
+                {
+                    args += contracted_name(rint) + ", ";
+                }
+
+                const auto name = contracted_name(tint);
+
+                body.push_back({1, 0, 1, "osfunc::CArray<" + acc_type + "> " + name + "(" +
+                                             std::to_string(cartesian_rows(tint)) + ", ncols);"});
+                body.push_back({1, 0, 1, "os4c::hrr::compute_" + shell_label(tint[0]) + "_" +
+                                             shell_label(tint[1]) + "_xx(" + args + "ab, " + name + ");"});
+
+                headers.insert("ObaraSaikaFourCenterHrr" + Tensor(tint[0]).label() + Tensor(tint[1]).label() +
+                               "XX" + hrr_tag + ".hpp");
+            }
+
+            body.push_back({0, 0, 1, ""});
+        }
+
+        add_sparse_transform(body, acc_type, contracted_name(integral), integral);
+    }
+
+    body.push_back({0, 0, 1, ""});
+    body.push_back({1, 0, 1, "return buffer;"});
+
+    // assemble the file: includes, namespace, signature, body.
+    auto lines = VCodeLines();
+
+    lines.push_back({0, 0, 2, "#include \"" + base + ".hpp\""});
+
+    lines.push_back({0, 0, 1, "#include <cmath>"});
+    lines.push_back({0, 0, 1, "#include <cstddef>"});
+    lines.push_back({0, 0, 1, ""});
+
+    lines.push_back({0, 0, 1, "#include \"ObaraSaikaFunc.hpp\""});
+
+    for (const auto& header : headers) lines.push_back({0, 0, 1, "#include \"" + header + "\""});
+
+    lines.push_back({0, 0, 1, ""});
+
+    lines.push_back({0, 0, 2, "namespace " + ns + " {  // " + tags.caption +
+                                  " four-center integrals"});
+
+    lines.push_back({0, 0, 1, "auto"});
+
+    for (const auto& label : signature_lines(run_config, integral, false))
+    {
+        lines.push_back({0, 0, 1, label});
+    }
+
+    lines.push_back({0, 0, 1, "{"});
+
+    for (const auto& line : body) lines.push_back(line);
+
+    lines.push_back({0, 0, 2, "}"});
+
+    lines.push_back({0, 0, 1, "}  // namespace " + ns});
+
+    std::ostringstream fstream;
+
+    ost::write_code_lines(fstream, lines);
+
+    sink.write({base + ".cpp", fstream.str()});
+}
+
+void
+CppCpuFourCenterEmitter::emit(const cfg::RunConfiguration& run_config,
+                              const I4CIntegral&           integral,
+                              const SI4CIntegrals&         bra_hrr_ints,
+                              const SI4CIntegrals&         ket_hrr_ints,
+                              const SI4CIntegrals&         vrr_base_ints,
+                              const SI4CIntegrals&         vrr_rest_ints,
+                              ost::OutputSink&             sink) const
+{
+    const auto ns = emit::precision_namespace(operator_tags(run_config.operator_type).ns, run_config.precision);
+
+    write_kernel_hpp(run_config, integral, ns, kernel_file_name("ObaraSaika", run_config, integral), sink);
+
+    _write_cpp(run_config, integral, bra_hrr_ints, ket_hrr_ints, vrr_base_ints, vrr_rest_ints, sink);
+}
+
+/// The Rys quadrature four-center emitter for the C++ language on CPU hardware.
+/// Produces a header/definition pair with the same signature as the
+/// Obara-Saika kernel whose body evaluates the roots and weights once per
+/// primitive quadruple, runs the 2D vertical recurrence and horizontal transfers
+/// of rys4c (RysFourCenterRecursions.hpp) per root and axis, and assembles
+/// w Ix Iy Iz into every primitive Cartesian component before contraction and
+/// the spherical store. It needs no recursion groups: the 2D recursions are
+/// generic in the angular momenta.
+class CppCpuRysFourCenterEmitter : public FourCenterEmitter
+{
+    /// Writes the kernel definition (.cpp) carrying the quadrature workflow.
+    void _write_cpp(const cfg::RunConfiguration& run_config,
+                    const I4CIntegral&           integral,
+                    ost::OutputSink&             sink) const;
+
+public:
+    void emit(const cfg::RunConfiguration& run_config,
+              const I4CIntegral&           integral,
+              const SI4CIntegrals&         bra_hrr_ints,
+              const SI4CIntegrals&         ket_hrr_ints,
+              const SI4CIntegrals&         vrr_base_ints,
+              const SI4CIntegrals&         vrr_rest_ints,
+              ost::OutputSink&             sink) const override;
+};
+
+void
+CppCpuRysFourCenterEmitter::_write_cpp(const cfg::RunConfiguration& run_config,
+                                       const I4CIntegral&           integral,
+                                       ost::OutputSink&             sink) const
+{
+    const auto tags = operator_tags(run_config.operator_type);
+
+    const auto ns = emit::precision_namespace("rys4c::" + tags.tag, run_config.precision);
+
+    const auto base = kernel_file_name("Rys", run_config, integral);
+
+    // the quadrature and the primitive integrals are held in the primitive
+    // type, contracted integrals and the result in the accumulator type.
+    const auto type = cfg::primitive_type(run_config.precision);
+
+    const auto acc_type = cfg::accumulator_type(run_config.precision);
+
+    const int la = integral[0];
+
+    const int lb = integral[1];
+
+    const int lc = integral[2];
+
+    const int ld = integral[3];
+
+    const int nroots = cost::rys_roots(integral);
+
+    const int nspher = (2 * la + 1) * (2 * lb + 1) * (2 * lc + 1) * (2 * ld + 1);
+
+    const int ncart = cartesian_rows(integral);
+
+    const auto ng = std::to_string((la + lb + 1) * (lc + ld + 1));
+
+    const auto ni = std::to_string((la + 1) * (lb + 1) * (lc + 1) * (ld + 1));
+
+    const auto moms = std::to_string(la) + ", " + std::to_string(lb) + ", " + std::to_string(lc) + ", " +
+                      std::to_string(ld);
+
+    // the (ix, iy, iz) offsets of every Cartesian component into the 2D
+    // integrals I(i, j, k, l) of each axis, in the a, b, c, d component order of
+    // the contracted block.
+    std::vector<std::string> entries;
+
+    for (const auto& ca : Tensor(la).components())
+    {
+        for (const auto& cb : Tensor(lb).components())
+        {
+            for (const auto& cc : Tensor(lc).components())
+            {
+                for (const auto& cd : Tensor(ld).components())
+                {
+                    std::string entry = "{";
+
+                    for (const auto axis : {'x', 'y', 'z'})
+                    {
+                        const auto idx = ((ca[axis] * (lb + 1) + cb[axis]) * (lc + 1) + cc[axis]) * (ld + 1) + cd[axis];
+
+                        entry += std::to_string(idx) + ((axis == 'z') ? "}" : ", ");
+                    }
+
+                    entries.push_back(entry);
+                }
+            }
+        }
+    }
+
+    auto body = VCodeLines();
+
+    body.push_back({1, 0, 1, "// number of screened bra and ket pairs"});
+    body.push_back({1, 0, 1, "const auto ncols = bra.number_of_pairs() * ket.number_of_pairs();"});
+    body.push_back({0, 0, 1, ""});
+
+    body.push_back({1, 0, 1, "// spherical (2*la+1) x (2*lb+1) x (2*lc+1) x (2*ld+1) result, one (bra pair,"});
+    body.push_back({1, 0, 1, "// ket pair) combination per column"});
+    body.push_back({1, 0, 1, "osfunc::CArray<" + acc_type + "> buffer(" + std::to_string(nspher) +
+                                 ", ncols);"});
+    body.push_back({0, 0, 1, ""});
+
+    body.push_back({1, 0, 1, "// number of primitive (bra pair, ket pair) combinations per column"});
+    body.push_back({1, 0, 1, "const auto nprims = bra.number_of_primitive_pairs() * ket.number_of_primitive_pairs();"});
+    body.push_back({0, 0, 1, ""});
+
+    body.push_back({1, 0, 1, "// Rys quadrature over " + std::to_string(nroots) +
+                                 " roots: per primitive combination the weights (scaled by"});
+    body.push_back({1, 0, 1, "// the (ss|1/|r-r'||ss) prefactor), the B00, B10, B01, C00 and D00 coefficients"});
+    body.push_back({1, 0, 1, "// of the 2D recurrence, and the A - B and C - D distances"});
+    body.push_back({1, 0, 1, "const auto rys = " + emit::osfunc_call("compute_rys_quadrature", type) + "(bra, ket, " +
+                                 std::to_string(nroots) + ");"});
+    body.push_back({0, 0, 1, ""});
+
+    body.push_back({1, 0, 1, "// (ix, iy, iz) offsets of each Cartesian component into the 2D integrals"});
+    body.push_back({1, 0, 1, "static constexpr int index[" + std::to_string(ncart) + "][3] = {"});
+
+    for (std::size_t i = 0; i < entries.size(); i += 6)
+    {
+        const auto last = std::min(i + 6, entries.size());
+
+        std::string label;
+
+        for (std::size_t j = i; j < last; j++)
+        {
+            label += entries[j] + ((j + 1 == last) ? "" : ", ");
+        }
+
+        if (last < entries.size()) label += ",";
+
+        body.push_back({2, 0, 1, label});
+    }
+
+    body.push_back({1, 0, 2, "};"});
+
+    body.push_back({1, 0, 1, "// primitive Cartesian integrals (zero-initialized), accumulated over the roots;"});
+    body.push_back({1, 0, 1, "// component k spans the nprims * ncols elements of prim.data(k)"});
+    body.push_back({1, 0, 1, "osfunc::CArray<" + type + "> prim(nprims * " + std::to_string(ncart) + ", ncols);"});
+    body.push_back({0, 0, 1, ""});
+    body.push_back({1, 0, 2, "const auto nelems = nprims * ncols;"});
+
+    body.push_back({1, 0, 1, "for (int r = 0; r < " + std::to_string(nroots) + "; r++)"});
+    body.push_back({1, 0, 1, "{"});
+    body.push_back({2, 0, 1, "const auto w = rys.weights(r);"});
+    body.push_back({0, 0, 1, ""});
+    body.push_back({2, 0, 1, "const auto b00 = rys.b00(r);"});
+    body.push_back({2, 0, 1, "const auto b10 = rys.b10(r);"});
+    body.push_back({2, 0, 1, "const auto b01 = rys.b01(r);"});
+    body.push_back({0, 0, 1, ""});
+
+    for (const auto axis : {'x', 'y', 'z'})
+    {
+        const auto label = std::string(1, axis);
+
+        const auto index = std::to_string(axis - 'x');
+
+        body.push_back({2, 0, 1, "const auto c00_" + label + " = rys.c00(r, " + index + ");"});
+        body.push_back({2, 0, 1, "const auto d00_" + label + " = rys.d00(r, " + index + ");"});
+        body.push_back({2, 0, 1, "const auto ab_" + label + " = rys.ab(" + index + ");"});
+        body.push_back({2, 0, 2, "const auto cd_" + label + " = rys.cd(" + index + ");"});
+    }
+
+    body.push_back({2, 0, 1, "#pragma omp simd"});
+    body.push_back({2, 0, 1, "for (std::size_t i = 0; i < nelems; i++)"});
+    body.push_back({2, 0, 1, "{"});
+    body.push_back({3, 0, 1, "// 2D integrals G(n, m), n <= la + lb and m <= lc + ld, per axis"});
+    body.push_back({3, 0, 2, type + " gx[" + ng + "], gy[" + ng + "], gz[" + ng + "];"});
+
+    for (const auto axis : {'x', 'y', 'z'})
+    {
+        const auto label = std::string(1, axis);
+
+        body.push_back({3, 0, 1, "rys4c::vrr_2d<" + std::to_string(la + lb) + ", " + std::to_string(lc + ld) +
+                                     ">(c00_" + label + "[i], d00_" + label + "[i], b00[i], b10[i], b01[i], g" +
+                                     label + ");"});
+    }
+
+    body.push_back({0, 0, 1, ""});
+    body.push_back({3, 0, 1, "// transfer to the bra and ket shells: I(i, j, k, l) per axis"});
+    body.push_back({3, 0, 2, type + " ix[" + ni + "], iy[" + ni + "], iz[" + ni + "];"});
+
+    for (const auto axis : {'x', 'y', 'z'})
+    {
+        const auto label = std::string(1, axis);
+
+        body.push_back({3, 0, 1, "rys4c::hrr_2d<" + moms + ">(g" + label + ", ab_" + label + "[i], cd_" + label +
+                                     "[i], i" + label + ");"});
+    }
+
+    body.push_back({0, 0, 1, ""});
+    body.push_back({3, 0, 1, "// assemble w Ix Iy Iz into every Cartesian component"});
+    body.push_back({3, 0, 1, "for (int k = 0; k < " + std::to_string(ncart) + "; k++)"});
+    body.push_back({3, 0, 1, "{"});
+    body.push_back({4, 0, 1, "prim.data(k)[i] += w[i] * ix[index[k][0]] * iy[index[k][1]] * iz[index[k][2]];"});
+    body.push_back({3, 0, 1, "}"});
+    body.push_back({2, 0, 1, "}"});
+    body.push_back({1, 0, 2, "}"});
+
+    body.push_back({1, 0, 1, "// contract to Cartesian (ab|cd)"});
+    body.push_back({1, 0, 1, "osfunc::CArray<" + acc_type + "> " + contracted_name(integral) + "(" +
+                                 std::to_string(ncart) + ", ncols);"});
+    body.push_back({1, 0, 2, "osfunc::contract(" + contracted_name(integral) + ", prim);"});
+
+    add_sparse_transform(body, acc_type, contracted_name(integral), integral);
+
+    body.push_back({0, 0, 1, ""});
+    body.push_back({1, 0, 1, "return buffer;"});
+
+    // assemble the file: includes, namespace, signature, body.
+    auto lines = VCodeLines();
+
+    lines.push_back({0, 0, 2, "#include \"" + base + ".hpp\""});
+
+    lines.push_back({0, 0, 1, "#include <cmath>"});
+    lines.push_back({0, 0, 1, "#include <cstddef>"});
+    lines.push_back({0, 0, 1, ""});
+
+    lines.push_back({0, 0, 1, "#include \"ObaraSaikaFunc.hpp\""});
+    lines.push_back({0, 0, 1, "#include \"RysFourCenterRecursions.hpp\""});
+    lines.push_back({0, 0, 1, "#include \"RysFunc.hpp\""});
+    lines.push_back({0, 0, 1, ""});
+
+    lines.push_back({0, 0, 2, "namespace " + ns + " {  // " + tags.caption +
+                                  " four-center integrals"});
+
+    lines.push_back({0, 0, 1, "auto"});
+
+    for (const auto& label : signature_lines(run_config, integral, false))
+    {
+        lines.push_back({0, 0, 1, label});
+    }
+
+    lines.push_back({0, 0, 1, "{"});
+
+    for (const auto& line : body) lines.push_back(line);
+
+    lines.push_back({0, 0, 2, "}"});
+
+    lines.push_back({0, 0, 1, "}  // namespace " + ns});
+
+    std::ostringstream fstream;
+
+    ost::write_code_lines(fstream, lines);
+
+    sink.write({base + ".cpp", fstream.str()});
+}
+
+void
+CppCpuRysFourCenterEmitter::emit(const cfg::RunConfiguration& run_config,
+                                 const I4CIntegral&           integral,
+                                 const SI4CIntegrals&         /* bra_hrr_ints */,
+                                 const SI4CIntegrals&         /* ket_hrr_ints */,
+                                 const SI4CIntegrals&         /* vrr_base_ints */,
+                                 const SI4CIntegrals&         /* vrr_rest_ints */,
+                                 ost::OutputSink&             sink) const
+{
+    const auto ns = emit::precision_namespace("rys4c::" + operator_tags(run_config.operator_type).tag,
+                                        run_config.precision);
+
+    write_kernel_hpp(run_config, integral, ns, kernel_file_name("Rys", run_config, integral), sink);
+
+    _write_cpp(run_config, integral, sink);
+}
+
+}  // namespace
+
+std::unique_ptr<FourCenterEmitter>
+make_four_center_emitter(const cfg::RunConfiguration& run_config)
+{
+    switch (run_config.hardware)
+    {
+        case cfg::Hardware::cpu:
+        {
+            switch (run_config.language)
+            {
+                case cfg::Language::cpp:
+                    return std::make_unique<CppCpuFourCenterEmitter>();
+            }
+
+            break;
+        }
+    }
+
+    throw cfg::ConfigError("four-center generator: no emitter for hardware '" +
+                           cfg::to_string(run_config.hardware) + "' and language '" +
+                           cfg::to_string(run_config.language) + "'");
+}
+
+std::unique_ptr<FourCenterEmitter>
+make_rys_four_center_emitter(const cfg::RunConfiguration& run_config)
+{
+    switch (run_config.hardware)
+    {
+        case cfg::Hardware::cpu:
+        {
+            switch (run_config.language)
+            {
+                case cfg::Language::cpp:
+                    return std::make_unique<CppCpuRysFourCenterEmitter>();
+            }
+
+            break;
+        }
+    }
+
+    throw cfg::ConfigError("four-center generator: no Rys emitter for hardware '" +
+                           cfg::to_string(run_config.hardware) + "' and language '" +
+                           cfg::to_string(run_config.language) + "'");
+}
+
+std::string
+format_rys_recursion_kernels()
+{
+    std::ostringstream os;
+
+    os << "/// 2D vertical recurrence of one Rys root along one axis: the integrals\n";
+    os << "/// G(n, m), n = 0, ..., N on the bra and m = 0, ..., M on the ket, stored\n";
+    os << "/// row-major in g, from G(0, 0) = 1 (the weight carries the prefactor) and\n";
+    os << "///   G(n + 1, 0) = C00 G(n, 0) + n B10 G(n - 1, 0),\n";
+    os << "///   G(n, m + 1) = D00 G(n, m) + m B01 G(n, m - 1) + n B00 G(n - 1, m).\n";
+    os << "template <int N, int M, class T>\n";
+    os << "inline void\n";
+    os << "vrr_2d(const T c00, const T d00, const T b00, const T b10, const T b01, T* g)\n";
+    os << "{\n";
+    os << "    g[0] = T(1);\n\n";
+    os << "    for (int n = 1; n <= N; n++)\n";
+    os << "    {\n";
+    os << "        g[n * (M + 1)] = c00 * g[(n - 1) * (M + 1)];\n\n";
+    os << "        if (n > 1) g[n * (M + 1)] += T(n - 1) * b10 * g[(n - 2) * (M + 1)];\n";
+    os << "    }\n\n";
+    os << "    for (int n = 0; n <= N; n++)\n";
+    os << "    {\n";
+    os << "        for (int m = 1; m <= M; m++)\n";
+    os << "        {\n";
+    os << "            auto v = d00 * g[n * (M + 1) + m - 1];\n\n";
+    os << "            if (m > 1) v += T(m - 1) * b01 * g[n * (M + 1) + m - 2];\n\n";
+    os << "            if (n > 0) v += T(n) * b00 * g[(n - 1) * (M + 1) + m - 1];\n\n";
+    os << "            g[n * (M + 1) + m] = v;\n";
+    os << "        }\n";
+    os << "    }\n";
+    os << "}\n\n";
+
+    os << "/// 2D horizontal transfer of one Rys root along one axis: the integrals\n";
+    os << "/// I(i, j, k, l), i <= LA, j <= LB, k <= LC, l <= LD, stored row-major in\n";
+    os << "/// out, from the G(n, m) of vrr_2d<LA + LB, LC + LD> by the stepwise\n";
+    os << "///   I(i, j, m) = I(i + 1, j - 1, m) + AB I(i, j - 1, m) on the bra and\n";
+    os << "///   I(i, j, k, l) = I(i, j, k + 1, l - 1) + CD I(i, j, k, l - 1) on the ket.\n";
+    os << "template <int LA, int LB, int LC, int LD, class T>\n";
+    os << "inline void\n";
+    os << "hrr_2d(const T* g, const T ab, const T cd, T* out)\n";
+    os << "{\n";
+    os << "    constexpr int NAB = LA + LB;\n\n";
+    os << "    constexpr int NCD = LC + LD;\n\n";
+    os << "    // bra transfer: h[j][i][m] for i <= NAB - j\n";
+    os << "    T h[LB + 1][NAB + 1][NCD + 1];\n\n";
+    os << "    for (int i = 0; i <= NAB; i++)\n";
+    os << "    {\n";
+    os << "        for (int m = 0; m <= NCD; m++) h[0][i][m] = g[i * (NCD + 1) + m];\n";
+    os << "    }\n\n";
+    os << "    for (int j = 1; j <= LB; j++)\n";
+    os << "    {\n";
+    os << "        for (int i = 0; i <= NAB - j; i++)\n";
+    os << "        {\n";
+    os << "            for (int m = 0; m <= NCD; m++) h[j][i][m] = h[j - 1][i + 1][m] + ab * h[j - 1][i][m];\n";
+    os << "        }\n";
+    os << "    }\n\n";
+    os << "    // ket transfer of every bra (i, j) entry: t[l][k] for k <= NCD - l\n";
+    os << "    for (int i = 0; i <= LA; i++)\n";
+    os << "    {\n";
+    os << "        for (int j = 0; j <= LB; j++)\n";
+    os << "        {\n";
+    os << "            T t[LD + 1][NCD + 1];\n\n";
+    os << "            for (int m = 0; m <= NCD; m++) t[0][m] = h[j][i][m];\n\n";
+    os << "            for (int l = 1; l <= LD; l++)\n";
+    os << "            {\n";
+    os << "                for (int k = 0; k <= NCD - l; k++) t[l][k] = t[l - 1][k + 1] + cd * t[l - 1][k];\n";
+    os << "            }\n\n";
+    os << "            for (int k = 0; k <= LC; k++)\n";
+    os << "            {\n";
+    os << "                for (int l = 0; l <= LD; l++) out[((i * (LB + 1) + j) * (LC + 1) + k) * (LD + 1) + l] = t[l][k];\n";
+    os << "            }\n";
+    os << "        }\n";
+    os << "    }\n";
+    os << "}\n";
+
+    return os.str();
+}
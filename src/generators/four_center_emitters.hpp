@@ -0,0 +1,72 @@
+// LITMUS: An Automated Molecular Integrals Generator
+// Copyright 2022 Z. Rinkevicius, KTH, Sweden.
+// E-mail: rinkevic@kth.se
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef four_center_emitters_hpp
+#define four_center_emitters_hpp
+
+#include <memory>
+#include <string>
+
+#include "output_sink.hpp"
+#include "run_configuration.hpp"
+#include "t4c_defs.hpp"
+
+class FourCenterEmitter
+{
+public:
+    virtual ~FourCenterEmitter() = default;
+
+    /// Emits the source files that compute the target four-center integral.
+    /// @param run_config The validated run configuration (selects the signature
+    ///        and storage form the emitted kernel branches on).
+    /// @param integral The target four-center integral (ab|o|cd).
+    /// @param bra_hrr_ints The bra HRR integrals, from the (0b'|o|cd) row up to
+    ///        the target.
+    /// @param ket_hrr_ints The ket HRR integrals, from the (0b'|o|0d') seeds up
+    ///        to the (0b'|o|cd) row.
+    /// @param vrr_base_ints The VRR base integrals (seeds) HRR consumes.
+    /// @param vrr_rest_ints The remaining VRR integrals generated to evaluate the
+    ///        base (the full VRR group minus the base).
+    /// @param sink The output sink receiving the emitted files.
+    virtual void emit(const cfg::RunConfiguration& run_config,
+                      const I4CIntegral&           integral,
+                      const SI4CIntegrals&         bra_hrr_ints,
+                      const SI4CIntegrals&         ket_hrr_ints,
+                      const SI4CIntegrals&         vrr_base_ints,
+                      const SI4CIntegrals&         vrr_rest_ints,
+                      ost::OutputSink&             sink) const = 0;
+};
+
+std::unique_ptr<FourCenterEmitter>
+make_four_center_emitter(const cfg::RunConfiguration& run_config);
+
+/// Creates the Rys quadrature four-center emitter for the configured hardware
+/// and language. Its kernels share the signature and header layout of the
+/// Obara-Saika ones but live in rys4c and ignore the recursion groups.
+/// @param run_config The validated run configuration.
+/// @return The Rys quadrature emitter.
+std::unique_ptr<FourCenterEmitter>
+make_rys_four_center_emitter(const cfg::RunConfiguration& run_config);
+
+/// Builds the body of the shared RysFourCenterRecursions.hpp header: the
+/// vrr_2d<N, M>() vertical recurrence and hrr_2d<LA, LB, LC, LD>() horizontal
+/// transfers of the 2D Ix, Iy, Iz integrals of one root and axis, generic in
+/// the value type.
+/// @return The generated header body (within namespace rys4c).
+std::string format_rys_recursion_kernels();
+
+#endif /* four_center_emitters_hpp */
@@ -0,0 +1,330 @@
+// LITMUS: An Automated Molecular Integrals Generator
+// Copyright 2022 Z. Rinkevicius, KTH, Sweden.
+// E-mail: rinkevic@kth.se
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "four_center_generators.hpp"
+
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include "config.hpp"
+#include "operator.hpp"
+#include "tensor.hpp"
+
+#include "eri_cost_model.hpp"
+#include "four_center_emitters.hpp"
+
+#include "v4i_eri_driver.hpp"
+
+I4CIntegral
+FourCenterGenerator::_get_integral(const cfg::RunConfiguration& run_config,
+                                   const std::array<int, 4>&    ang_moms) const
+{
+    // bra (A, B) and ket (C, D) pair expansion centers
+
+    const auto bra = I2CPair("GA", ang_moms[0], "GB", ang_moms[1]);
+
+    const auto ket = I2CPair("GC", ang_moms[2], "GD", ang_moms[3]);
+
+    // select the integrand operator from the configured operator type
+
+    switch (run_config.operator_type)
+    {
+        case cfg::OperatorType::electron_repulsion:
+            return I4CIntegral(bra, ket, Operator("1/|r-r'|"), 0, {});
+
+        case cfg::OperatorType::long_range_electron_repulsion:
+            return I4CIntegral(bra, ket, Operator("erf(w|r-r'|)/|r-r'|"), 0, {});
+
+        case cfg::OperatorType::short_range_electron_repulsion:
+            return I4CIntegral(bra, ket, Operator("erfc(w|r-r'|)/|r-r'|"), 0, {});
+
+        // remaining operators are not handled by this routine yet
+        case cfg::OperatorType::overlap:
+        case cfg::OperatorType::kinetic_energy:
+        case cfg::OperatorType::nuclear_potential:
+        case cfg::OperatorType::dipole_momentum:
+        case cfg::OperatorType::linear_momentum:
+        case cfg::OperatorType::three_center_overlap:
+        case cfg::OperatorType::three_center_r2:
+        case cfg::OperatorType::three_center_r_dot_r2:
+        case cfg::OperatorType::local_ecp:
+        case cfg::OperatorType::projected_ecp:
+            break;
+    }
+
+    throw cfg::ConfigError("four-center generator: operator '" +
+                           cfg::to_string(run_config.operator_type) +
+                           "' is not supported for four-center integrals");
+}
+
+SI4CIntegrals
+FourCenterGenerator::_generate_bra_hrr_integral_group(const cfg::RunConfiguration& run_config,
+                                                      const I4CIntegral&           integral) const
+{
+    // the bra HRR transfers momentum from B to A: (ab|cd) from (a-1,b+1|cd) and
+    // (a-1,b|cd). The driver closes on the a = 0 row.
+
+    switch (run_config.operator_type)
+    {
+        case cfg::OperatorType::electron_repulsion:
+        case cfg::OperatorType::long_range_electron_repulsion:
+        case cfg::OperatorType::short_range_electron_repulsion:
+        {
+            return V4IElectronRepulsionDriver().create_bra_hrr_recursion({integral,});
+        }
+
+        // remaining operators are not handled by this routine yet
+        case cfg::OperatorType::overlap:
+        case cfg::OperatorType::kinetic_energy:
+        case cfg::OperatorType::nuclear_potential:
+        case cfg::OperatorType::dipole_momentum:
+        case cfg::OperatorType::linear_momentum:
+        case cfg::OperatorType::three_center_overlap:
+        case cfg::OperatorType::three_center_r2:
+        case cfg::OperatorType::three_center_r_dot_r2:
+        case cfg::OperatorType::local_ecp:
+        case cfg::OperatorType::projected_ecp:
+            break;
+    }
+
+    throw cfg::ConfigError("four-center generator: operator '" +
+                           cfg::to_string(run_config.operator_type) +
+                           "' is not supported for four-center integrals");
+}
+
+SI4CIntegrals
+FourCenterGenerator::_generate_ket_hrr_integral_group(const cfg::RunConfiguration& run_config,
+                                                      const SI4CIntegrals&         bra_ints) const
+{
+    // the ket HRR transfers momentum from D to C for every (0b'|cd) the bra HRR
+    // consumes; rows with c = 0 are VRR seeds already.
+
+    switch (run_config.operator_type)
+    {
+        case cfg::OperatorType::electron_repulsion:
+        case cfg::OperatorType::long_range_electron_repulsion:
+        case cfg::OperatorType::short_range_electron_repulsion:
+        {
+            V4IElectronRepulsionDriver eri_drv;
+
+            SI4CIntegrals tints;
+
+            for (const auto& tint : bra_ints)
+            {
+                if ((tint[0] == 0) && (tint[2] > 0))
+                {
+                    const auto ctints = eri_drv.create_ket_hrr_recursion({tint,});
+
+                    tints.insert(ctints.cbegin(), ctints.cend());
+                }
+            }
+
+            return tints;
+        }
+
+        // remaining operators are not handled by this routine yet
+        case cfg::OperatorType::overlap:
+        case cfg::OperatorType::kinetic_energy:
+        case cfg::OperatorType::nuclear_potential:
+        case cfg::OperatorType::dipole_momentum:
+        case cfg::OperatorType::linear_momentum:
+        case cfg::OperatorType::three_center_overlap:
+        case cfg::OperatorType::three_center_r2:
+        case cfg::OperatorType::three_center_r_dot_r2:
+        case cfg::OperatorType::local_ecp:
+        case cfg::OperatorType::projected_ecp:
+            break;
+    }
+
+    throw cfg::ConfigError("four-center generator: operator '" +
+                           cfg::to_string(run_config.operator_type) +
+                           "' is not supported for four-center integrals");
+}
+
+SI4CIntegrals
+FourCenterGenerator::_generate_vrr_base_integral_group(const SI4CIntegrals& bra_ints,
+                                                       const SI4CIntegrals& ket_ints) const
+{
+    SI4CIntegrals tints;
+
+    for (const auto& tint : bra_ints)
+    {
+        if ((tint[0] == 0) && (tint[2] == 0)) tints.insert(tint);
+    }
+
+    for (const auto& tint : ket_ints)
+    {
+        if ((tint[0] == 0) && (tint[2] == 0)) tints.insert(tint);
+    }
+
+    return tints;
+}
+
+SI4CIntegrals
+FourCenterGenerator::_generate_vrr_integral_group(const cfg::RunConfiguration& run_config,
+                                                  const SI4CIntegrals&         base) const
+{
+    switch (run_config.operator_type)
+    {
+        case cfg::OperatorType::electron_repulsion:
+        case cfg::OperatorType::long_range_electron_repulsion:
+        case cfg::OperatorType::short_range_electron_repulsion:
+        {
+            return V4IElectronRepulsionDriver().create_vrr_recursion(base);
+        }
+
+        // remaining operators are not handled by this routine yet
+        case cfg::OperatorType::overlap:
+        case cfg::OperatorType::kinetic_energy:
+        case cfg::OperatorType::nuclear_potential:
+        case cfg::OperatorType::dipole_momentum:
+        case cfg::OperatorType::linear_momentum:
+        case cfg::OperatorType::three_center_overlap:
+        case cfg::OperatorType::three_center_r2:
+        case cfg::OperatorType::three_center_r_dot_r2:
+        case cfg::OperatorType::local_ecp:
+        case cfg::OperatorType::projected_ecp:
+            break;
+    }
+
+    throw cfg::ConfigError("four-center generator: operator '" +
+                           cfg::to_string(run_config.operator_type) +
+                           "' is not supported for four-center integrals");
+}
+
+bool
+FourCenterGenerator::_use_rys(const cfg::RunConfiguration& run_config,
+                              const I4CIntegral&           integral,
+                              const SI4CIntegrals&         bra_hrr_ints,
+                              const SI4CIntegrals&         ket_hrr_ints,
+                              const SI4CIntegrals&         vrr_ints) const
+{
+    switch (run_config.eri_method)
+    {
+        case cfg::EriMethod::obara_saika:
+            return false;
+
+        case cfg::EriMethod::rys:
+            return true;
+
+        case cfg::EriMethod::automatic:
+            return cost::rys_flops(integral) < cost::obara_saika_flops(bra_hrr_ints, ket_hrr_ints, vrr_ints);
+    }
+
+    return false;  // unreachable: every EriMethod is handled above
+}
+
+void
+FourCenterGenerator::generate(const cfg::RunConfiguration& run_config) const
+{
+    ost::DirectorySink sink;
+
+    generate(run_config, sink);
+}
+
+void
+FourCenterGenerator::generate(const cfg::RunConfiguration& run_config,
+                              ost::OutputSink&             sink) const
+{
+    // loop over the bra (A, B) and ket (C, D) angular momenta within
+    // [min_ang_mom, max_ang_mom], with B >= A and D >= C as both pairs are
+    // symmetric; a narrow range regenerates just the high-L quadruples. For each
+    // target split the work into the bra HRR, ket HRR, VRR base, and remaining
+    // VRR integrals. The eri_method selects the Obara-Saika or the Rys quadrature
+    // kernel of each quadruple; in automatic mode the cost model picks the one
+    // with the lower operation count.
+
+    const auto emitter = make_four_center_emitter(run_config);
+
+    const auto rys_emitter = (run_config.eri_method == cfg::EriMethod::obara_saika)
+                                 ? std::unique_ptr<FourCenterEmitter>()
+                                 : make_rys_four_center_emitter(run_config);
+
+    bool has_rys = false;
+
+    const auto lmin = run_config.min_ang_mom;
+
+    const auto lmax = run_config.max_ang_mom;
+
+    for (int i = lmin; i <= lmax; i++)
+    {
+        for (int j = i; j <= lmax; j++)
+        {
+            for (int k = lmin; k <= lmax; k++)
+            {
+                for (int l = k; l <= lmax; l++)
+                {
+                    const auto integral = _get_integral(run_config, {i, j, k, l});
+
+                    const auto bra_hrr_ints = _generate_bra_hrr_integral_group(run_config, integral);
+
+                    const auto ket_hrr_ints = _generate_ket_hrr_integral_group(run_config, bra_hrr_ints);
+
+                    const auto vrr_base_ints = _generate_vrr_base_integral_group(bra_hrr_ints, ket_hrr_ints);
+
+                    const auto vrr_ints = _generate_vrr_integral_group(run_config, vrr_base_ints);
+
+                    SI4CIntegrals vrr_rest_ints;
+
+                    for (const auto& tint : vrr_ints)
+                    {
+                        if (vrr_base_ints.count(tint) == 0) vrr_rest_ints.insert(tint);
+                    }
+
+                    if (_use_rys(run_config, integral, bra_hrr_ints, ket_hrr_ints, vrr_ints))
+                    {
+                        rys_emitter->emit(run_config, integral, bra_hrr_ints, ket_hrr_ints, vrr_base_ints,
+                                          vrr_rest_ints, sink);
+
+                        has_rys = true;
+
+                        std::cout << "Generated " << integral.label() << " Rys kernel ("
+                                  << cost::rys_roots(integral) << " roots)" << std::endl;
+                    }
+                    else
+                    {
+                        emitter->emit(run_config, integral, bra_hrr_ints, ket_hrr_ints, vrr_base_ints,
+                                      vrr_rest_ints, sink);
+
+                        std::cout << "Generated " << integral.label() << " kernel ("
+                                  << bra_hrr_ints.size() << " bra HRR, " << ket_hrr_ints.size() << " ket HRR, "
+                                  << vrr_base_ints.size() << " VRR base, " << vrr_rest_ints.size() << " VRR rest)"
+                                  << std::endl;
+                    }
+                }
+            }
+        }
+    }
+
+    // the 2D recursions are generic in the angular momenta: one header serves
+    // every Rys kernel
+
+    if (has_rys)
+    {
+        std::ostringstream fstream;
+
+        fstream << "#ifndef RysFourCenterRecursions_hpp\n";
+        fstream << "#define RysFourCenterRecursions_hpp\n\n";
+        fstream << "namespace rys4c {  // Rys quadrature 2D recursions\n\n";
+        fstream << format_rys_recursion_kernels() << "\n";
+        fstream << "}  // namespace rys4c\n\n";
+        fstream << "#endif /* RysFourCenterRecursions_hpp */\n";
+
+        sink.write({"RysFourCenterRecursions.hpp", fstream.str()});
+    }
+}
@@ -0,0 +1,105 @@
+// LITMUS: An Automated Molecular Integrals Generator
+// Copyright 2022 Z. Rinkevicius, KTH, Sweden.
+// E-mail: rinkevic@kth.se
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef four_center_generators_hpp
+#define four_center_generators_hpp
+
+#include <array>
+
+#include "output_sink.hpp"
+#include "run_configuration.hpp"
+#include "t4c_defs.hpp"
+
+class FourCenterGenerator
+{
+    /// Builds the base four-center integral (ab|o|cd) for the configured operator
+    /// and the given angular momenta.
+    /// @param run_config The run configuration (selects the integrand operator).
+    /// @param ang_moms The angular momenta of the bra pair (A, B) and the ket
+    ///        pair (C, D) centers.
+    /// @return The four-center integral.
+    I4CIntegral _get_integral(const cfg::RunConfiguration& run_config,
+                              const std::array<int, 4>&    ang_moms) const;
+
+    /// Builds the bra HRR integrals for a target (ab|o|cd): the target itself and
+    /// every (a'b'|o|cd) the bra horizontal recurrence transfers momentum
+    /// through, down to the (0b'|o|cd) row.
+    /// @param run_config The run configuration (selects the recursion driver).
+    /// @param integral The target four-center integral (ab|o|cd).
+    /// @return The set of bra HRR integrals.
+    SI4CIntegrals _generate_bra_hrr_integral_group(const cfg::RunConfiguration& run_config,
+                                                   const I4CIntegral&           integral) const;
+
+    /// Builds the ket HRR integrals that produce the (0b'|o|cd) row of the bra
+    /// HRR group, down to the (0b'|o|0d') seeds.
+    /// @param run_config The run configuration (selects the recursion driver).
+    /// @param bra_ints The bra HRR integral group of a target.
+    /// @return The set of ket HRR integrals.
+    SI4CIntegrals _generate_ket_hrr_integral_group(const cfg::RunConfiguration& run_config,
+                                                   const SI4CIntegrals&         bra_ints) const;
+
+    /// Selects the VRR base integrals consumed by the HRR steps: the (0b'|o|0d')
+    /// members of the bra and ket HRR groups.
+    /// @param bra_ints The bra HRR integral group of a target.
+    /// @param ket_ints The ket HRR integral group of a target.
+    /// @return The set of VRR base integrals needed by HRR.
+    SI4CIntegrals _generate_vrr_base_integral_group(const SI4CIntegrals& bra_ints,
+                                                    const SI4CIntegrals& ket_ints) const;
+
+    /// Runs the vertical recursion down from the given VRR base integrals: the
+    /// bra VRR reduces B to (00|o|0d)^m, the ket VRR reduces those to the
+    /// (00|o|00)^m seeds.
+    /// @param run_config The run configuration (selects the recursion driver).
+    /// @param base The VRR base integrals (output from HRR) to recurse down from.
+    /// @return The complete set of VRR integrals.
+    SI4CIntegrals _generate_vrr_integral_group(const cfg::RunConfiguration& run_config,
+                                               const SI4CIntegrals&         base) const;
+
+    /// Decides whether a target is emitted as a Rys quadrature kernel: always
+    /// or never for an explicit eri_method, by the operation-count cost model
+    /// (cost::rys_flops against cost::obara_saika_flops) in automatic mode.
+    /// @param run_config The run configuration (selects the ERI method).
+    /// @param integral The target four-center integral.
+    /// @param bra_hrr_ints The bra HRR integral group of the target.
+    /// @param ket_hrr_ints The ket HRR integral group of the target.
+    /// @param vrr_ints The complete VRR integral group of the target.
+    /// @return True for a Rys kernel, false for an Obara-Saika kernel.
+    bool _use_rys(const cfg::RunConfiguration& run_config,
+                  const I4CIntegral&           integral,
+                  const SI4CIntegrals&         bra_hrr_ints,
+                  const SI4CIntegrals&         ket_hrr_ints,
+                  const SI4CIntegrals&         vrr_ints) const;
+
+public:
+    /// Creates a four-center integrals code generator.
+    FourCenterGenerator() = default;
+
+    /// Generates the selected four-center integrals for every quadruple of
+    /// angular momenta in [min_ang_mom, max_ang_mom] (B >= A and D >= C, the
+    /// pairs are symmetric) into the current working directory.
+    /// @param run_config The validated run configuration.
+    void generate(const cfg::RunConfiguration& run_config) const;
+
+    /// Generates the selected four-center integrals for every quadruple of
+    /// angular momenta in [min_ang_mom, max_ang_mom] into an output sink.
+    /// @param run_config The validated run configuration.
+    /// @param sink The output sink receiving the emitted files.
+    void generate(const cfg::RunConfiguration& run_config,
+                  ost::OutputSink&             sink) const;
+};
+
+#endif /* four_center_generators_hpp */
@@ -40,7 +40,7 @@ G2CFuncBodyDriver::write_func_body(      std::ofstream&         fstream,
         lines.push_back({1, 0, 2, label});
     }
 
-    _add_loop_start(lines, integral);
+    _add_loop_start(lines, integral, 0);
     
     _add_call_tree(lines, vrr_integrals, integral);
     
@@ -51,6 +51,50 @@ G2CFuncBodyDriver::write_func_body(      std::ofstream&         fstream,
     ost::write_code_lines(fstream, lines);
 }
 
+void
+G2CFuncBodyDriver::write_batch_func_body(      std::ofstream&         fstream,
+                                         const SI2CIntegrals&         vrr_integrals,
+                                         const I2CIntegral&           integral,
+                                         const int                    grid_screening) const
+{
+    auto lines = VCodeLines();
+    
+    lines.push_back({0, 0, 1, "{"});
+    
+    for (const auto& label : _get_gtos_def())
+    {
+        lines.push_back({1, 0, 2, label});
+    }
+    
+    for (const auto& label : _get_batch_variables_def(integral))
+    {
+        lines.push_back({1, 0, 2, label});
+    }
+    
+    _add_batch_loop_start(lines);
+    
+    // primitive loops of single pair kernel are nested two levels deeper
+    
+    auto prim_lines = VCodeLines();
+    
+    _add_loop_start(prim_lines, integral, grid_screening);
+    
+    _add_call_tree(prim_lines, vrr_integrals, integral);
+    
+    for (auto& line : prim_lines)
+    {
+        std::get<0>(line) += 2;
+    }
+    
+    lines.insert(lines.end(), prim_lines.begin(), prim_lines.end());
+    
+    _add_batch_loop_end(lines, vrr_integrals, integral);
+    
+    lines.push_back({0, 0, 1, "}"});
+    
+    ost::write_code_lines(fstream, lines);
+}
+
 std::vector<std::string>
 G2CFuncBodyDriver::_get_gtos_def() const
 {
@@ -144,6 +188,42 @@ G2CFuncBodyDriver::_get_variables_def(const I2CIntegral& integral) const
     return vstr;
 }
 
+std::vector<std::string>
+G2CFuncBodyDriver::_get_batch_variables_def(const I2CIntegral& integral) const
+{
+    std::vector<std::string> vstr;
+    
+    vstr.push_back("// define pi constant");
+        
+    vstr.push_back("const double fpi = mathconst::pi_value();");
+    
+    vstr.push_back("// set up coordinates of basis functions");
+    
+    vstr.push_back("const auto bra_gto_coords = bra_gto_block.coordinates();");
+    
+    vstr.push_back("const auto ket_gto_coords = ket_gto_block.coordinates();");
+    
+    vstr.push_back("// set up number of basis functions in ket range");
+    
+    vstr.push_back("const auto ket_dim = ket_range.second - ket_range.first;");
+    
+    if (_need_boys_func(integral))
+    {
+        auto order = integral[0] + integral[1] + integral.integrand().shape().order();
+        
+        for (const auto& prefix : integral.prefixes())
+        {
+            order += prefix.shape().order();
+        }
+        
+        vstr.push_back("// setup Boys function data");
+        
+        vstr.push_back("const CBoysFunc<" + std::to_string(order) + "> bf_table;");
+    }
+    
+    return vstr;
+}
+
 bool
 G2CFuncBodyDriver::_need_boys_func(const I2CIntegral& integral) const
 {
@@ -156,7 +236,8 @@ G2CFuncBodyDriver::_need_boys_func(const I2CIntegral& integral) const
 
 void
 G2CFuncBodyDriver::_add_loop_start(      VCodeLines&  lines,
-                                   const I2CIntegral& integral) const
+                                   const I2CIntegral& integral,
+                                   const int          grid_screening) const
 {
     lines.push_back({1, 0, 2, "// loop over primitives"});
     
@@ -226,6 +307,8 @@ G2CFuncBodyDriver::_add_loop_start(      VCodeLines&  lines,
     
     lines.push_back({3, 0, 2, "t2cfunc::comp_distances_pc(cart_buffer, 0, gcoords_x, gcoords_y, gcoords_z, p_x, p_y, p_z);"});
     
+    if (grid_screening > 0) _add_grid_screening(lines, grid_screening);
+    
     if (_need_boys_func(integral))
     {
         lines.push_back({3, 0, 2, "// compute Boys function arguments"});
@@ -238,6 +321,93 @@ G2CFuncBodyDriver::_add_loop_start(      VCodeLines&  lines,
     }
 }
 
+void
+G2CFuncBodyDriver::_add_batch_loop_start(VCodeLines& lines) const
+{
+    lines.push_back({1, 0, 2, "// loop over basis function pairs in GTOs block ranges"});
+    
+    lines.push_back({1, 0, 1, "for (auto bra_igto = bra_range.first; bra_igto < bra_range.second; bra_igto++)"});
+    
+    lines.push_back({1, 0, 1, "{"});
+    
+    lines.push_back({2, 0, 2, "// set up Cartesian A coordinates"});
+    
+    lines.push_back({2, 0, 2, "const auto a_xyz = bra_gto_coords[bra_igto].coordinates();"});
+    
+    lines.push_back({2, 0, 2, "const auto a_x = a_xyz[0];"});
+    
+    lines.push_back({2, 0, 2, "const auto a_y = a_xyz[1];"});
+    
+    lines.push_back({2, 0, 2, "const auto a_z = a_xyz[2];"});
+    
+    lines.push_back({2, 0, 1, "for (auto ket_igto = ket_range.first; ket_igto < ket_range.second; ket_igto++)"});
+    
+    lines.push_back({2, 0, 1, "{"});
+    
+    lines.push_back({3, 0, 2, "// set up Cartesian B coordinates"});
+    
+    lines.push_back({3, 0, 2, "const auto b_xyz = ket_gto_coords[ket_igto].coordinates();"});
+    
+    lines.push_back({3, 0, 2, "const auto b_x = b_xyz[0];"});
+    
+    lines.push_back({3, 0, 2, "const auto b_y = b_xyz[1];"});
+    
+    lines.push_back({3, 0, 2, "const auto b_z = b_xyz[2];"});
+    
+    lines.push_back({3, 0, 2, "// compute overlap between A and B centers"});
+    
+    lines.push_back({3, 0, 2, "const auto ab_x = a_x - b_x;"});
+    
+    lines.push_back({3, 0, 2, "const auto ab_y = a_y - b_y;"});
+    
+    lines.push_back({3, 0, 2, "const auto ab_z = a_z - b_z;"});
+    
+    lines.push_back({3, 0, 2, "const double rab2 = ab_x * ab_x + ab_y * ab_y + ab_z * ab_z;"});
+    
+    lines.push_back({3, 0, 2, "// reset contracted integrals of basis function pair"});
+    
+    lines.push_back({3, 0, 2, "cart_buffer.zero();"});
+}
+
+void
+G2CFuncBodyDriver::_add_grid_screening(      VCodeLines& lines,
+                                       const int         grid_screening) const
+{
+    // (s|A|s) = fovl 2 (p / pi)^1/2 F_0(p R(PC)^2) <= fovl min(2 (p / pi)^1/2, 1 / R(PC))
+    
+    lines.push_back({3, 0, 1, "// screen primitive pair: skip it if negligible at all grid points in block"});
+    
+    lines.push_back({3, 0, 1, "{"});
+    
+    lines.push_back({4, 0, 2, "const auto nelems = cart_buffer.number_of_columns();"});
+    
+    lines.push_back({4, 0, 1, "const auto pc_x = cart_buffer.data();"});
+    
+    lines.push_back({4, 0, 1, "const auto pc_y = &(cart_buffer.data()[nelems]);"});
+    
+    lines.push_back({4, 0, 2, "const auto pc_z = &(cart_buffer.data()[2 * nelems]);"});
+    
+    lines.push_back({4, 0, 2, "double rmin2 = std::numeric_limits<double>::max();"});
+    
+    lines.push_back({4, 0, 1, "#pragma omp simd reduction(min : rmin2)"});
+    
+    lines.push_back({4, 0, 1, "for (size_t k = 0; k < nelems; k++)"});
+    
+    lines.push_back({4, 0, 1, "{"});
+    
+    lines.push_back({5, 0, 2, "const auto r2 = pc_x[k] * pc_x[k] + pc_y[k] * pc_y[k] + pc_z[k] * pc_z[k];"});
+    
+    lines.push_back({5, 0, 1, "rmin2 = (r2 < rmin2) ? r2 : rmin2;"});
+    
+    lines.push_back({4, 0, 2, "}"});
+    
+    lines.push_back({4, 0, 2, "const auto fbound = std::fabs(fovl) * std::min(2.0 * std::sqrt((a_exp + b_exp) / fpi), 1.0 / std::sqrt(rmin2));"});
+    
+    lines.push_back({4, 0, 1, "if (fbound < 1.0e-" + std::to_string(grid_screening) + ") continue;"});
+    
+    lines.push_back({3, 0, 2, "}"});
+}
+
 void
 G2CFuncBodyDriver::_add_loop_end(      VCodeLines&    lines,
                                  const SI2CIntegrals& integrals,
@@ -249,7 +419,7 @@ G2CFuncBodyDriver::_add_loop_end(      VCodeLines&    lines,
     
     const auto refpos = _get_position(integral, integrals, integral);
     
-    const auto ncomps = integral.components<T1CPair, T1CPair>().size();
+    const auto ncomps = integral.number_of_components();
     
     std::string label = "t2cfunc::reduce(cart_buffer, ";
     
@@ -281,6 +451,52 @@ G2CFuncBodyDriver::_add_loop_end(      VCodeLines&    lines,
     std::cout << " *** (" << std::to_string(integral[0]) << "," << std::to_string(integral[1]) << ") = " << std::to_string(refpos + 2 * ncomps) << std::endl; 
 }
 
+void
+G2CFuncBodyDriver::_add_batch_loop_end(      VCodeLines&    lines,
+                                       const SI2CIntegrals& integrals,
+                                       const I2CIntegral&   integral) const
+{
+    lines.push_back({5, 0, 2, "// reduce integrals"});
+    
+    const auto refpos = _get_position(integral, integrals, integral);
+    
+    const auto ncomps = integral.number_of_components();
+    
+    std::string label = "t2cfunc::reduce(cart_buffer, ";
+    
+    label += std::to_string(refpos + ncomps) + ", ";
+    
+    label += std::to_string(refpos) + ", ";
+    
+    label += std::to_string(ncomps) + ");";
+    
+    lines.push_back({5, 0, 1, label});
+    
+    lines.push_back({4, 0, 1, "}"});
+    
+    lines.push_back({3, 0, 2, "}"});
+    
+    const auto nsph = t2c::number_of_spherical_components(std::array<int, 2>({integral[0], integral[1]}));
+    
+    lines.push_back({3, 0, 2, "// transform integrals of basis function pair into its rows of spherical buffer"});
+    
+    label = "const auto spher_row = ((bra_igto - bra_range.first) * ket_dim + ket_igto - ket_range.first) * ";
+    
+    lines.push_back({3, 0, 2, label + std::to_string(nsph) + ";"});
+    
+    label = "t2cfunc::transform<"  + std::to_string(integral[0]);
+    
+    label += ", " + std::to_string(integral[1]) + ">(spher_buffer, spher_row, cart_buffer, ";
+    
+    label += std::to_string(refpos + ncomps) + ");";
+    
+    lines.push_back({3, 0, 1, label});
+    
+    lines.push_back({2, 0, 1, "}"});
+    
+    lines.push_back({1, 0, 1, "}"});
+}
+
 void
 G2CFuncBodyDriver::_add_call_tree(      VCodeLines&            lines,
                                   const SI2CIntegrals&         integrals,
@@ -429,7 +645,7 @@ G2CFuncBodyDriver::_get_position(const I2CIntegral&   integral,
     {
         if (tint == integral) return pos;
         
-        pos += tint.components<T1CPair, T1CPair>().size();
+        pos += tint.number_of_components();
     }
     
     return 0;
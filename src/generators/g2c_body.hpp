@@ -37,11 +37,28 @@ class G2CFuncBodyDriver
     /// @return The vector of ket factors in compute function.
     std::vector<std::string> _get_variables_def(const I2CIntegral& integral) const;
     
+    /// Generates vector of GTOs pairs range definitions in grid-batched compute function.
+    /// @param integral The base two center integral.
+    /// @return The vector of GTOs pairs range definitions.
+    std::vector<std::string> _get_batch_variables_def(const I2CIntegral& integral) const;
+    
     /// Adds loop start definitions to code lines container.
     /// @param lines The code lines container to which loop start definition are added.
     /// @param integral The base two center integral.
+    /// @param grid_screening The grid points block screening threshold exponent (0 = off).
     void _add_loop_start(      VCodeLines&  lines,
-                         const I2CIntegral& integral) const;
+                         const I2CIntegral& integral,
+                         const int          grid_screening) const;
+    
+    /// Adds loops over basis function pairs of grid-batched compute function to code lines container.
+    /// @param lines The code lines container to which loop start definition are added.
+    void _add_batch_loop_start(VCodeLines& lines) const;
+    
+    /// Adds screening of primitive pair against block of grid points to code lines container.
+    /// @param lines The code lines container to which screening definition is added.
+    /// @param grid_screening The grid points block screening threshold exponent.
+    void _add_grid_screening(      VCodeLines& lines,
+                             const int         grid_screening) const;
     
     /// Adds loop end definitions to code lines container.
     /// @param lines The code lines container to which loop start definition are added.
@@ -51,6 +68,14 @@ class G2CFuncBodyDriver
                        const SI2CIntegrals& integrals,
                        const I2CIntegral&   integral) const;
     
+    /// Adds loop end definitions of grid-batched compute function to code lines container.
+    /// @param lines The code lines container to which loop end definition are added.
+    /// @param integrals The set of inetrgals.
+    /// @param integral The base two center integral.
+    void _add_batch_loop_end(      VCodeLines&    lines,
+                             const SI2CIntegrals& integrals,
+                             const I2CIntegral&   integral) const;
+    
     /// Adds call tree for recursion.
     /// @param lines The code lines container to which loop start definition are added.
     /// @param integrals The set of inetrgals.
@@ -187,6 +212,16 @@ public:
                          const I2CIntegral&           integral,
                          const std::array<int, 3>& geom_drvs,
                          const bool                   use_rs) const;
+    
+    /// Writes body of grid-batched compute function.
+    /// @param fstream the file stream.
+    /// @param vrr_integrals The set of inetrgals in vertical recursion.
+    /// @param integral The base two center integral.
+    /// @param grid_screening The grid points block screening threshold exponent (0 = off).
+    void write_batch_func_body(      std::ofstream&         fstream,
+                               const SI2CIntegrals&         vrr_integrals,
+                               const I2CIntegral&           integral,
+                               const int                    grid_screening) const;
 };
 
 #endif /* g2c_body_hpp */
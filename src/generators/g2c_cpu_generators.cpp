@@ -16,6 +16,8 @@
 
 #include "g2c_cpu_generators.hpp"
 
+#include <stdexcept>
+
 #include "string_formater.hpp"
 #include "file_stream.hpp"
 
@@ -34,7 +36,9 @@ void
 G2CCPUGenerator::generate(const std::string&           label,
                           const int                    max_ang_mom,
                           const std::array<int, 3>&    geom_drvs,
-                          const bool                   use_rs) const
+                          const bool                   use_rs,
+                          const bool                   grid_batch,
+                          const int                    grid_screening) const
 {
     if (_is_available(label))
     {
@@ -52,7 +56,14 @@ G2CCPUGenerator::generate(const std::string&           label,
 
                             const auto integrals = _generate_integral_group(integral, geom_drvs);
 
-                            _write_cpp_header(integrals, integral, use_rs);
+                            if (grid_batch)
+                            {
+                                _write_batch_cpp_header(integrals, integral, use_rs, grid_screening);
+                            }
+                            else
+                            {
+                                _write_cpp_header(integrals, integral, use_rs);
+                            }
                             
                             if ((i + j) > 0)
                             {
@@ -68,11 +79,7 @@ G2CCPUGenerator::generate(const std::string&           label,
     }
     else
     {
-        std::cerr << "*** ERROR *** Unsupported type of two-center integral: ";
-        
-        std::cerr << label << " !!!" << std::endl;
-        
-        std::exit(EXIT_FAILURE);
+        throw std::invalid_argument("Unsupported type of two-center integral: " + label);
     }
 }
 
@@ -150,9 +157,12 @@ G2CCPUGenerator::_generate_integral_group(const I2CIntegral&        integral,
 
 std::string
 G2CCPUGenerator::_file_name(const I2CIntegral& integral,
-                            const bool         use_rs) const
+                            const bool         use_rs,
+                            const bool         grid_batch) const
 {
-    std::string label = (use_rs) ? "GridErfRec" : "GridRec";
+    std::string label = (grid_batch) ? "GridBatch" : "Grid";
+    
+    label += (use_rs) ? "ErfRec" : "Rec";
     
     label += integral.label();
     
@@ -164,15 +174,15 @@ G2CCPUGenerator::_write_cpp_header(const SI2CIntegrals&         integrals,
                                    const I2CIntegral&           integral,
                                    const bool                   use_rs) const
 {
-    auto fname = _file_name(integral, use_rs) + ".hpp";
+    auto fname = _file_name(integral, use_rs, false) + ".hpp";
         
     std::ofstream fstream;
                
     fstream.open(fname.c_str(), std::ios_base::trunc);
     
-    _write_hpp_defines(fstream, integral,  use_rs, false, true);
+    _write_hpp_defines(fstream, integral,  use_rs, false, false, true);
     
-    _write_hpp_includes(fstream, integrals, integral, use_rs);
+    _write_hpp_includes(fstream, integrals, integral, use_rs, false);
     
     _write_namespace(fstream, integral, true);
     
@@ -194,7 +204,46 @@ G2CCPUGenerator::_write_cpp_header(const SI2CIntegrals&         integrals,
 
     _write_namespace(fstream, integral, false);
         
-    _write_hpp_defines(fstream, integral, use_rs, false, false);
+    _write_hpp_defines(fstream, integral, use_rs, false, false, false);
+    
+    fstream.close();
+}
+
+void
+G2CCPUGenerator::_write_batch_cpp_header(const SI2CIntegrals& integrals,
+                                         const I2CIntegral&   integral,
+                                         const bool           use_rs,
+                                         const int            grid_screening) const
+{
+    auto fname = _file_name(integral, use_rs, true) + ".hpp";
+        
+    std::ofstream fstream;
+               
+    fstream.open(fname.c_str(), std::ios_base::trunc);
+    
+    _write_hpp_defines(fstream, integral,  use_rs, true, false, true);
+    
+    _write_hpp_includes(fstream, integrals, integral, use_rs, true);
+    
+    _write_namespace(fstream, integral, true);
+    
+    G2CDocuDriver docs_drv;
+
+    G2CDeclDriver decl_drv;
+
+    G2CFuncBodyDriver func_drv;
+
+    docs_drv.write_batch_doc_str(fstream, integral, use_rs);
+    
+    decl_drv.write_batch_func_decl(fstream, integral, use_rs, false);
+    
+    func_drv.write_batch_func_body(fstream, integrals, integral, grid_screening);
+    
+    fstream << std::endl;
+
+    _write_namespace(fstream, integral, false);
+        
+    _write_hpp_defines(fstream, integral, use_rs, true, false, false);
     
     fstream.close();
 }
@@ -203,10 +252,11 @@ void
 G2CCPUGenerator::_write_hpp_defines(      std::ofstream&         fstream,
                                     const I2CIntegral&           integral,
                                     const bool                   use_rs,
+                                    const bool                   grid_batch,
                                     const bool                   is_prim_rec,
                                     const bool                   start) const
 {
-    auto fname = (is_prim_rec) ? t2c::grid_prim_file_name(integral) : _file_name(integral, use_rs) + "_hpp";
+    auto fname = (is_prim_rec) ? t2c::grid_prim_file_name(integral) : _file_name(integral, use_rs, grid_batch) + "_hpp";
     
     auto lines = VCodeLines();
  
@@ -228,7 +278,8 @@ void
 G2CCPUGenerator::_write_hpp_includes(      std::ofstream&         fstream,
                                      const SI2CIntegrals&         integrals,
                                      const I2CIntegral&           integral,
-                                     const bool                   use_rs) const
+                                     const bool                   use_rs,
+                                     const bool                   grid_batch) const
 {
     auto lines = VCodeLines();
     
@@ -239,6 +290,13 @@ G2CCPUGenerator::_write_hpp_includes(      std::ofstream&         fstream,
     lines.push_back({0, 0, 1, "#include <utility>"});
     
     lines.push_back({0, 0, 1, "#include <cmath>"});
+    
+    if (grid_batch)
+    {
+        lines.push_back({0, 0, 1, "#include <algorithm>"});
+        
+        lines.push_back({0, 0, 1, "#include <limits>"});
+    }
         
     lines.push_back({0, 0, 1, "#include \"GtoBlock.hpp\""});
     
@@ -304,7 +362,7 @@ G2CCPUGenerator::_write_prim_cpp_header(const I2CIntegral& integral) const
                
     fstream.open(fname.c_str(), std::ios_base::trunc);
     
-    _write_hpp_defines(fstream, integral, false, true, true);
+    _write_hpp_defines(fstream, integral, false, false, true, true);
     
     _write_prim_hpp_includes(fstream, integral);
     
@@ -320,7 +378,7 @@ G2CCPUGenerator::_write_prim_cpp_header(const I2CIntegral& integral) const
     
     _write_namespace(fstream, integral, false);
     
-    _write_hpp_defines(fstream, integral, false, true, false);
+    _write_hpp_defines(fstream, integral, false, false, true, false);
     
     fstream.close();
 }
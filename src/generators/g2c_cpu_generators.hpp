@@ -51,9 +51,11 @@ class G2CCPUGenerator
     /// Gets file name of file with recursion functions for two center integral.
     /// @param integral The base two center integral.
     /// @param use_rs The flag for use of range-separated Coulomb interactions.
+    /// @param grid_batch The flag for grid-batched compute functions.
     /// @return The file name.
     std::string _file_name(const I2CIntegral& integral,
-                           const bool         use_rs) const;
+                           const bool         use_rs,
+                           const bool         grid_batch) const;
     
     /// Writes header file for recursion.
     /// @param integrals The set of unique integrals.
@@ -63,15 +65,27 @@ class G2CCPUGenerator
                            const I2CIntegral&   integral,
                            const bool           use_rs) const;
     
+    /// Writes header file for grid-batched recursion.
+    /// @param integrals The set of unique integrals.
+    /// @param integral The base two center integral.
+    /// @param use_rs The flag for use of range-separated Coulomb interactions.
+    /// @param grid_screening The grid points block screening threshold exponent (0 = off).
+    void _write_batch_cpp_header(const SI2CIntegrals& integrals,
+                                 const I2CIntegral&   integral,
+                                 const bool           use_rs,
+                                 const int            grid_screening) const;
+    
     /// Writes definitions of define for header file.
     /// @param fstream the file stream.
     /// @param integral The base two center integral.
     /// @param use_rs The flag for use of range-separated Coulomb interactions.
+    /// @param grid_batch The flag for grid-batched compute functions.
     /// @param is_prim_rec The flag to indicate primitive recurion.
     /// @param start The flag to indicate position of define (start or end).
     void _write_hpp_defines(      std::ofstream&         fstream,
                             const I2CIntegral&           integral,
                             const bool                   use_rs,
+                            const bool                   grid_batch,
                             const bool                   is_prim_rec,
                             const bool                   start) const;
     
@@ -80,10 +94,12 @@ class G2CCPUGenerator
     /// @param integrals The set of unique integrals.
     /// @param integral The base two center integral.
     /// @param use_rs The flag for use of range-separated Coulomb interactions.
+    /// @param grid_batch The flag for grid-batched compute functions.
     void _write_hpp_includes(      std::ofstream&         fstream,
                              const SI2CIntegrals&         integrals,
                              const I2CIntegral&           integral,
-                             const bool                   use_rs) const;
+                             const bool                   use_rs,
+                             const bool                   grid_batch) const;
     
     /// Writes namespace definition to file stream.
     /// @param fstream the file stream.
@@ -122,10 +138,16 @@ public:
     /// @param max_ang_mom The maximum angular momentum of A and B centers.
     /// @param geom_drvs The geometrical derivative of bra side, integrand, and  ket side.
     /// @param use_rs The flag for use of range-separated Coulomb interactions.
+    /// @param grid_batch The flag for grid-batched compute functions, which evaluate all basis function
+    /// pairs of given GTOs block ranges on a block of grid points.
+    /// @param grid_screening The grid points block screening threshold exponent (0 = off); only used by
+    /// grid-batched compute functions.
     void generate(const std::string&           label,
                   const int                    max_ang_mom,
                   const std::array<int, 3>&    geom_drvs,
-                  const bool                   use_rs) const;
+                  const bool                   use_rs,
+                  const bool                   grid_batch,
+                  const int                    grid_screening) const;
 };
 
 #endif /* g2c_cpu_generators_hpp */
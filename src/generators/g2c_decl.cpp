@@ -47,6 +47,44 @@ G2CDeclDriver::write_func_decl(      std::ofstream&         fstream,
     ost::write_code_lines(fstream, lines);
 }
 
+void
+G2CDeclDriver::write_batch_func_decl(      std::ofstream&         fstream,
+                                     const I2CIntegral&           integral,
+                                     const bool                   use_rs,
+                                     const bool                   terminus) const
+{
+    auto lines = VCodeLines();
+    
+    lines.push_back({0, 0, 1, "auto"});
+    
+    auto name = t2c::grid_batch_compute_func_name(integral, use_rs) + "(";
+    
+    lines.push_back({0, 0, 1, name + "CSubMatrix& spher_buffer,"});
+    
+    const auto spacer = std::string(name.size(), ' ');
+    
+    lines.push_back({0, 0, 1, spacer + "CSubMatrix& cart_buffer,"});
+    
+    lines.push_back({0, 0, 1, spacer + "const std::vector<double>& gcoords_x,"});
+    
+    lines.push_back({0, 0, 1, spacer + "const std::vector<double>& gcoords_y,"});
+    
+    lines.push_back({0, 0, 1, spacer + "const std::vector<double>& gcoords_z,"});
+    
+    lines.push_back({0, 0, 1, spacer + "const std::vector<double>& gweights,"});
+    
+    lines.push_back({0, 0, 1, spacer + "const CGtoBlock& bra_gto_block,"});
+    
+    lines.push_back({0, 0, 1, spacer + "const CGtoBlock& ket_gto_block,"});
+    
+    for (const auto& label : _get_ranges_str(integral, use_rs, terminus))
+    {
+        lines.push_back({0, 0, 1, label});
+    }
+    
+    ost::write_code_lines(fstream, lines);
+}
+
 std::vector<std::string>
 G2CDeclDriver::_get_distributor_str(const I2CIntegral& integral,
                                     const bool         use_rs) const
@@ -108,3 +146,23 @@ G2CDeclDriver::_get_indices_str(const I2CIntegral& integral,
    
     return vstr;
 }
+
+std::vector<std::string>
+G2CDeclDriver::_get_ranges_str(const I2CIntegral& integral,
+                               const bool         use_rs,
+                               const bool         terminus) const
+{
+    std::vector<std::string> vstr;
+    
+    auto name = t2c::grid_batch_compute_func_name(integral, use_rs) + "(";
+    
+    const auto spacer = std::string(name.size(), ' ');
+    
+    const auto tsymbol = (terminus) ? ";" : "";
+    
+    vstr.push_back(spacer + "const std::pair<size_t, size_t>& bra_range,");
+            
+    vstr.push_back(spacer + "const std::pair<size_t, size_t>& ket_range) -> void" + tsymbol);
+   
+    return vstr;
+}
@@ -49,6 +49,15 @@ class G2CDeclDriver
     std::vector<std::string> _get_indices_str(const I2CIntegral& integral,
                                               const bool         use_rs,
                                               const bool         terminus) const;
+    
+    /// Generates vector of GTOs block range strings for grid-batched compute function.
+    /// @param integral The base two center integral.
+    /// @param use_rs The flag for use of range-separated Coulomb interactions.
+    /// @param terminus The flag to add termination symbol.
+    /// @return The vector of GTOs block range strings.
+    std::vector<std::string> _get_ranges_str(const I2CIntegral& integral,
+                                             const bool         use_rs,
+                                             const bool         terminus) const;
 
 public:
     /// Creates a two-center functions declaration generator.
@@ -63,6 +72,16 @@ public:
                          const I2CIntegral&           integral,
                          const bool                   use_rs,
                          const bool                   terminus) const;
+    
+    /// Writes declaration for grid-batched compute function.
+    /// @param fstream the file stream.
+    /// @param integral The base two center integral.
+    /// @param use_rs The flag for use of range-separated Coulomb interactions.
+    /// @param terminus The flag to add termination symbol.
+    void write_batch_func_decl(      std::ofstream&         fstream,
+                               const I2CIntegral&           integral,
+                               const bool                   use_rs,
+                               const bool                   terminus) const;
 };
 
 #endif /* g2c_decl_hpp */
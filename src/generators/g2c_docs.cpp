@@ -47,6 +47,46 @@ G2CDocuDriver::write_doc_str(      std::ofstream&         fstream,
     ost::write_code_lines(fstream, lines);
 }
 
+void
+G2CDocuDriver::write_batch_doc_str(      std::ofstream&         fstream,
+                                   const I2CIntegral&           integral,
+                                   const bool                   use_rs) const
+{
+    auto lines = VCodeLines();
+    
+    auto label = _get_compute_str(integral, use_rs);
+    
+    label.replace(label.find("for pair of basis functions on given grid."), std::string::npos,
+                  "for all pairs of basis functions in given ranges on block of grid points.");
+    
+    lines.push_back({0, 0, 1, label});
+    
+    const auto nsph = t2c::number_of_spherical_components(std::array<int, 2>({integral[0], integral[1]}));
+    
+    label = "/// Integrals of pair (i, j) are stored in spherical buffer from row ((i - bra_range.first) * ";
+    
+    label += "(ket_range.second - ket_range.first) + j - ket_range.first) * " + std::to_string(nsph) + ".";
+    
+    lines.push_back({0, 0, 1, label});
+    
+    for (const auto& label : _get_distributor_str(use_rs))
+    {
+        lines.push_back({0, 0, 1, label});
+    }
+    
+    for (const auto& label : _get_gto_blocks_str(integral))
+    {
+        lines.push_back({0, 0, 1, label});
+    }
+    
+    for (const auto& label : _get_ranges_str())
+    {
+        lines.push_back({0, 0, 1, label});
+    }
+    
+    ost::write_code_lines(fstream, lines);
+}
+
 std::string
 G2CDocuDriver::_get_compute_str(const I2CIntegral& integral,
                                 const bool         use_rs) const
@@ -121,3 +161,15 @@ G2CDocuDriver::_get_indices_str() const
     
     return vstr;
 }
+
+std::vector<std::string>
+G2CDocuDriver::_get_ranges_str() const
+{
+    std::vector<std::string> vstr;
+
+    vstr.push_back("/// @param bra_range The range [first, last) of basis functions on bra side.");
+        
+    vstr.push_back("/// @param ket_range The range [first, last) of basis functions on ket side.");
+    
+    return vstr;
+}
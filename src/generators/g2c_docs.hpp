@@ -47,6 +47,10 @@ class G2CDocuDriver
     /// @return The vector of indices strings.
     std::vector<std::string> _get_indices_str() const;
     
+    /// Generates vector of GTOs block range strings.
+    /// @return The vector of GTOs block range strings.
+    std::vector<std::string> _get_ranges_str() const;
+    
 public:
     /// Creates a two-center documentation generator.
     G2CDocuDriver() = default;
@@ -59,6 +63,14 @@ public:
                        const I2CIntegral&           integral,
                        const bool                   use_rs) const;
     
+    /// Writes documentation string for grid-batched compute function.
+    /// @param fstream the file stream.
+    /// @param integral The base two center integral.
+    /// @param use_rs The flag for use of range-separated Coulomb interactions.
+    void write_batch_doc_str(      std::ofstream&         fstream,
+                             const I2CIntegral&           integral,
+                             const bool                   use_rs) const;
+    
 };
 
 #endif /* g2c_docs_hpp */
@@ -0,0 +1,74 @@
+// LITMUS: An Automated Molecular Integrals Generator
+// Copyright 2022 Z. Rinkevicius, KTH, Sweden.
+// E-mail: rinkevic@kth.se
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ltm.hpp"
+
+#include "four_center_generators.hpp"
+#include "three_center_generators.hpp"
+#include "two_center_generators.hpp"
+#include "two_center_hrr_generators.hpp"
+#include "two_center_vrr_generators.hpp"
+
+namespace ltm {  // ltm namespace
+
+void
+generate(const cfg::RunConfiguration& run_config,
+         ost::OutputSink&             sink)
+{
+    if (run_config.recursion_type)
+    {
+        switch (*run_config.recursion_type)
+        {
+            case cfg::RecursionType::hrr_bra_ket:
+            case cfg::RecursionType::hrr_bra:
+            case cfg::RecursionType::hrr_ket:
+                TwoCenterHrrGenerator().generate(run_config, sink);
+                return;
+
+            case cfg::RecursionType::vrr_cartesian:
+            case cfg::RecursionType::vrr_spherical:
+                TwoCenterVrrGenerator().generate(run_config, sink);
+                return;
+        }
+    }
+
+    switch (*run_config.integral_type)
+    {
+        case cfg::IntegralType::two_center:
+            TwoCenterGenerator().generate(run_config, sink);
+            return;
+
+        case cfg::IntegralType::three_center:
+            ThreeCenterGenerator().generate(run_config, sink);
+            return;
+
+        case cfg::IntegralType::four_center:
+            FourCenterGenerator().generate(run_config, sink);
+            return;
+    }
+}
+
+std::vector<ost::GeneratedFile>
+generate(const cfg::RunConfiguration& run_config)
+{
+    ost::MemorySink sink;
+
+    generate(run_config, sink);
+
+    return sink.files();
+}
+
+}  // namespace ltm
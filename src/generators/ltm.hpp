@@ -0,0 +1,45 @@
+// LITMUS: An Automated Molecular Integrals Generator
+// Copyright 2022 Z. Rinkevicius, KTH, Sweden.
+// E-mail: rinkevic@kth.se
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ltm_hpp
+#define ltm_hpp
+
+#include <vector>
+
+#include "output_sink.hpp"
+#include "run_configuration.hpp"
+
+/// The embeddable generator interface of the libltm library: runs the generator
+/// selected by a new-style run configuration without going through litmus.x or
+/// the current working directory.
+namespace ltm {  // ltm namespace
+
+/// Generates the source files of a run into an output sink.
+/// @param run_config The validated run configuration (the generators throw
+///        cfg::ConfigError on an operator they do not support).
+/// @param sink The output sink receiving the generated files.
+void generate(const cfg::RunConfiguration& run_config,
+              ost::OutputSink&             sink);
+
+/// Generates the source files of a run in memory.
+/// @param run_config The validated run configuration (the generators throw
+///        cfg::ConfigError on an operator they do not support).
+/// @return The generated files, in generation order.
+std::vector<ost::GeneratedFile> generate(const cfg::RunConfiguration& run_config);
+
+}  // namespace ltm
+
+#endif /* ltm_hpp */
@@ -26,7 +26,9 @@ T2CFuncBodyDriver::write_func_body(      std::ofstream&         fstream,
                                    const I2CIntegral&           integral,
                                    const std::array<int, 3>& geom_drvs, 
                                    const std::pair<bool, bool>& rec_form,
-                                   const bool                   use_rs) const
+                                   const bool                   use_rs,
+                                   const int                    prim_screening,
+                                   const bool                   trans_inv) const
 {
     auto lines = VCodeLines();
     
@@ -42,12 +44,12 @@ T2CFuncBodyDriver::write_func_body(      std::ofstream&         fstream,
         lines.push_back({1, 0, 2, label});
     }
     
-    for (const auto& label : _get_ket_variables_def(integral))
+    for (const auto& label : _get_ket_variables_def(integral, false))
     {
         lines.push_back({1, 0, 2, label});
     }
     
-    for (const auto& label : _get_buffers_def(vrr_integrals, integral, geom_drvs))
+    for (const auto& label : _get_buffers_def(vrr_integrals, integral, geom_drvs, false, trans_inv))
     {
         lines.push_back({1, 0, 2, label});
     }
@@ -57,25 +59,83 @@ T2CFuncBodyDriver::write_func_body(      std::ofstream&         fstream,
         lines.push_back({1, 0, 2, label});
     }
     
-    _add_loop_start(lines, integral);
+    _add_loop_start(lines, integral, false, trans_inv);
     
-    _add_ket_loop_start(lines, integral, rec_form);
+    _add_ket_loop_start(lines, integral, rec_form, prim_screening);
     
-    _add_auxilary_integrals(lines, vrr_integrals, integral, rec_form, false);
+    _add_auxilary_integrals(lines, vrr_integrals, integral, rec_form, false, false);
     
-    _add_sum_loop_start(lines, integral, rec_form, use_rs); 
+    _add_sum_loop_start(lines, integral, rec_form, use_rs, false); 
     
-    _add_auxilary_integrals(lines, vrr_integrals, integral, rec_form, true);
+    _add_auxilary_integrals(lines, vrr_integrals, integral, rec_form, true, false);
     
-    _add_call_tree(lines, vrr_integrals, integral, rec_form);
+    _add_call_tree(lines, vrr_integrals, integral, rec_form, false);
     
     _add_geom_call_tree(lines, geom_integrals, vrr_integrals, integral, geom_drvs, rec_form);
     
-    _add_sum_loop_end(lines, vrr_integrals, integral, rec_form);
+    _add_sum_loop_end(lines, vrr_integrals, integral, rec_form, false);
     
     _add_ket_loop_end(lines, vrr_integrals, integral, rec_form);
     
-    _add_loop_end(lines, integral, rec_form);
+    _add_loop_end(lines, integral, rec_form, trans_inv);
+    
+    lines.push_back({0, 0, 1, "}"});
+    
+    ost::write_code_lines(fstream, lines);
+}
+
+void
+T2CFuncBodyDriver::write_point_batch_func_body(      std::ofstream& fstream,
+                                               const SI2CIntegrals& vrr_integrals,
+                                               const I2CIntegral&   integral,
+                                               const int            prim_screening,
+                                               const int            point_batch) const
+{
+    const std::pair<bool, bool> rec_form({true, false});
+    
+    auto lines = VCodeLines();
+    
+    lines.push_back({0, 0, 1, "{"});
+    
+    lines.push_back({1, 0, 2, "// number of external Gaussians computed together in SIMD lanes"});
+    
+    lines.push_back({1, 0, 2, "const size_t npblock = " + std::to_string(point_batch) + ";"});
+    
+    for (const auto& label : _get_external_data_def(integral, rec_form))
+    {
+        lines.push_back({1, 0, 2, label});
+    }
+    
+    for (const auto& label : _get_gtos_def())
+    {
+        lines.push_back({1, 0, 2, label});
+    }
+    
+    for (const auto& label : _get_ket_variables_def(integral, true))
+    {
+        lines.push_back({1, 0, 2, label});
+    }
+    
+    for (const auto& label : _get_buffers_def(vrr_integrals, integral, {0, 0, 0}, true, false))
+    {
+        lines.push_back({1, 0, 2, label});
+    }
+    
+    _add_loop_start(lines, integral, true, false);
+    
+    _add_ket_loop_start(lines, integral, rec_form, prim_screening);
+    
+    _add_sum_loop_start(lines, integral, rec_form, false, true);
+    
+    _add_auxilary_integrals(lines, vrr_integrals, integral, rec_form, true, true);
+    
+    _add_call_tree(lines, vrr_integrals, integral, rec_form, true);
+    
+    _add_sum_loop_end(lines, vrr_integrals, integral, rec_form, true);
+    
+    _add_ket_loop_end(lines, vrr_integrals, integral, rec_form);
+    
+    _add_loop_end(lines, integral, rec_form, false);
     
     lines.push_back({0, 0, 1, "}"});
     
@@ -229,12 +289,32 @@ T2CFuncBodyDriver::_get_gtos_def() const
 }
 
 std::vector<std::string>
-T2CFuncBodyDriver::_get_ket_variables_def(const I2CIntegral& integral) const
+T2CFuncBodyDriver::_get_ket_variables_def(const I2CIntegral& integral,
+                                          const bool         point_batch) const
 {
     std::vector<std::string> vstr;
     
     vstr.push_back("// allocate aligned 2D arrays for ket side");
     
+    if (point_batch)
+    {
+        // exponents and normalization factors of external Gaussians follow ket side factors
+        
+        const auto nelems = _get_number_of_factors(integral) + 2;
+        
+        vstr.push_back("CSimdArray<double> factors(" + std::to_string(nelems) +  ", npblock * ket_npgtos);");
+    }
+    else
+    {
+        vstr.push_back("CSimdArray<double> factors(" + std::to_string(_get_number_of_factors(integral)) +  ", ket_npgtos);");
+    }
+
+    return vstr;
+}
+
+size_t
+T2CFuncBodyDriver::_get_number_of_factors(const I2CIntegral& integral) const
+{
     size_t nelems = 8;
     
     if (_need_center_p(integral)) nelems += 3;
@@ -247,15 +327,15 @@ T2CFuncBodyDriver::_get_ket_variables_def(const I2CIntegral& integral) const
     
     if (_need_distances_gc(integral)) nelems += 3;
     
-    vstr.push_back("CSimdArray<double> factors(" + std::to_string(nelems) +  ", ket_npgtos);");
-
-    return vstr;
+    return nelems;
 }
 
 std::vector<std::string>
-T2CFuncBodyDriver::_get_buffers_def(const SI2CIntegrals& integrals,
-                                    const I2CIntegral&   integral,
-                                    const std::array<int, 3>& geom_drvs) const
+T2CFuncBodyDriver::_get_buffers_def(const SI2CIntegrals&      integrals,
+                                    const I2CIntegral&        integral,
+                                    const std::array<int, 3>& geom_drvs,
+                                    const bool                point_batch,
+                                    const bool                trans_inv) const
 {
     std::vector<std::string> vstr;
     
@@ -265,21 +345,21 @@ T2CFuncBodyDriver::_get_buffers_def(const SI2CIntegrals& integrals,
     
     for (const auto& tint : integrals)
     {
-        icomps += tint.components<T1CPair, T1CPair>().size();
+        icomps += tint.number_of_components();
     }
     
     if (_need_geom_drvs(geom_drvs))
     {
-        icomps += integral.components<T1CPair, T1CPair>().size();
+        icomps += integral.number_of_components();
     }
     
-    auto label = "CSimdArray<double> pbuffer(" + std::to_string(icomps) + ", ket_npgtos);";
+    auto label = "CSimdArray<double> pbuffer(" + std::to_string(icomps) + ((point_batch) ? ", npblock * ket_npgtos);" : ", ket_npgtos);");
     
     vstr.push_back(label);
     
     vstr.push_back("// allocate aligned contracted integrals");
     
-    icomps = integral.components<T1CPair, T1CPair>().size();
+    icomps = integral.number_of_components();
     
     label = "CSimdArray<double> cbuffer(" + std::to_string(icomps) + ", 1);";
     
@@ -287,25 +367,44 @@ T2CFuncBodyDriver::_get_buffers_def(const SI2CIntegrals& integrals,
     
     if ((integral[0] + integral[1]) > 0)
     {
-        const auto angpair = std::array<int, 2>({integral[0], integral[1]});
-        
-        icomps = t2c::number_of_spherical_components(angpair);
-        
-        icomps *= integral.integrand().components().size();
-        
-        if (const auto prefixes = integral.prefixes(); !prefixes.empty())
-        {
-            icomps *= make_components<OperatorComponent>(prefixes).size();
-        }
+        icomps = _get_number_of_components(integral);
         
         label = "CSimdArray<double> sbuffer(" + std::to_string(icomps) + ", 1);";
         
         vstr.push_back(label);
     }
     
+    if (trans_inv)
+    {
+        vstr.push_back("// allocate aligned bra and ket side derivatives");
+        
+        icomps = 2 * _get_number_of_components(integral);
+        
+        vstr.push_back("CSimdArray<double> gbuffer(" + std::to_string(icomps) + ", 1);");
+    }
+    
     return vstr;
 }
 
+size_t
+T2CFuncBodyDriver::_get_number_of_components(const I2CIntegral& integral) const
+{
+    if ((integral[0] + integral[1]) == 0) return integral.number_of_components();
+    
+    const auto angpair = std::array<int, 2>({integral[0], integral[1]});
+    
+    auto icomps = t2c::number_of_spherical_components(angpair);
+    
+    icomps *= integral.integrand().number_of_components();
+    
+    if (const auto prefixes = integral.prefixes(); !prefixes.empty())
+    {
+        icomps *= make_components<OperatorComponent>(prefixes).size();
+    }
+    
+    return icomps;
+}
+
 std::vector<std::string>
 T2CFuncBodyDriver::_get_boys_function_def(const I2CIntegral& integral) const
 {
@@ -335,7 +434,9 @@ T2CFuncBodyDriver::_get_boys_function_def(const I2CIntegral& integral) const
 
 void
 T2CFuncBodyDriver::_add_loop_start(      VCodeLines&  lines,
-                                   const I2CIntegral& integral) const
+                                   const I2CIntegral& integral,
+                                   const bool         point_batch,
+                                   const bool         trans_inv) const
 {
     lines.push_back({1, 0, 2, "// set up ket partitioning"});
 
@@ -364,6 +465,11 @@ T2CFuncBodyDriver::_add_loop_start(      VCodeLines&  lines,
         lines.push_back({2, 0, 2, "sbuffer.set_active_width(ket_width);"});
     }
     
+    if (trans_inv)
+    {
+        lines.push_back({2, 0, 2, "gbuffer.set_active_width(ket_width);"});
+    }
+    
     lines.push_back({2, 0, 2, "cbuffer.set_active_width(ket_width);"});
     
     lines.push_back({2, 0, 2, "pbuffer.set_active_width(ket_width);"});
@@ -372,6 +478,31 @@ T2CFuncBodyDriver::_add_loop_start(      VCodeLines&  lines,
     {
         lines.push_back({2, 0, 2, "bf_data.set_active_width(ket_width);"});
     }
+    
+    if (point_batch)
+    {
+        // ket exponents, normalization factors, and coordinates are shared by all points in batch
+        
+        lines.push_back({2, 0, 2, "// replicate ket side data into SIMD lanes of all points in batch"});
+        
+        lines.push_back({2, 0, 2, "const auto ket_lanes = ket_width * ket_npgtos;"});
+        
+        lines.push_back({2, 0, 1, "for (size_t m = 0; m < 5; m++)"});
+        
+        lines.push_back({2, 0, 1, "{"});
+        
+        lines.push_back({3, 0, 2, "auto fvals = factors.data(m);"});
+        
+        lines.push_back({3, 0, 1, "for (size_t p = 1; p < npblock; p++)"});
+        
+        lines.push_back({3, 0, 1, "{"});
+        
+        lines.push_back({4, 0, 1, "std::copy(fvals, fvals + ket_lanes, fvals + p * ket_lanes);"});
+        
+        lines.push_back({3, 0, 1, "}"});
+        
+        lines.push_back({2, 0, 2, "}"});
+    }
 
     lines.push_back({2, 0, 2, "// loop over contracted basis functions on bra side"});
     
@@ -394,7 +525,8 @@ T2CFuncBodyDriver::_add_loop_start(      VCodeLines&  lines,
 void
 T2CFuncBodyDriver::_add_loop_end(      VCodeLines&  lines,
                                  const I2CIntegral& integral,
-                                 const std::pair<bool, bool>& rec_form) const
+                                 const std::pair<bool, bool>& rec_form,
+                                 const bool                   trans_inv) const
 {
     std::string label;
     
@@ -407,15 +539,41 @@ T2CFuncBodyDriver::_add_loop_end(      VCodeLines&  lines,
         lines.push_back({3, 0, 2, label});
     }
     
-    if ((integral[0] + integral[1]) > 0)
-    {
-        label = "distributor.distribute(sbuffer, ";
-    }
-    else
+    const auto buffer = ((integral[0] + integral[1]) > 0) ? std::string("sbuffer") : std::string("cbuffer");
+    
+    if (trans_inv)
     {
-        label = "distributor.distribute(cbuffer, ";
+        // bra side derivatives are computed once, ket side ones follow them with opposite sign
+        
+        const auto ncomps = std::to_string(_get_number_of_components(integral));
+        
+        lines.push_back({3, 0, 2, "// translational invariance: d/dB = -d/dA"});
+        
+        lines.push_back({3, 0, 1, "for (size_t n = 0; n < " + ncomps + "; n++)"});
+        
+        lines.push_back({3, 0, 1, "{"});
+        
+        lines.push_back({4, 0, 2, "const auto avals = " + buffer + ".data(n);"});
+        
+        lines.push_back({4, 0, 2, "auto ga_vals = gbuffer.data(n);"});
+        
+        lines.push_back({4, 0, 2, "auto gb_vals = gbuffer.data(" + ncomps + " + n);"});
+        
+        lines.push_back({4, 0, 1, "for (size_t k = 0; k < ket_width; k++)"});
+        
+        lines.push_back({4, 0, 1, "{"});
+        
+        lines.push_back({5, 0, 2, "ga_vals[k] = avals[k];"});
+        
+        lines.push_back({5, 0, 1, "gb_vals[k] = -avals[k];"});
+        
+        lines.push_back({4, 0, 1, "}"});
+        
+        lines.push_back({3, 0, 2, "}"});
     }
     
+    label = "distributor.distribute(" + ((trans_inv) ? std::string("gbuffer") : buffer) + ", ";
+    
     label += "bra_gto_indices, ket_gto_indices, ";
             
     label += std::to_string(integral[0]) + ", ";
@@ -434,7 +592,8 @@ T2CFuncBodyDriver::_add_loop_end(      VCodeLines&  lines,
 void
 T2CFuncBodyDriver::_add_ket_loop_start(      VCodeLines&            lines,
                                        const I2CIntegral&           integral,
-                                       const std::pair<bool, bool>& rec_form) const
+                                       const std::pair<bool, bool>& rec_form,
+                                       const int                    prim_screening) const
 {
     lines.push_back({3, 0, 1, "for (size_t k = 0; k < bra_npgtos; k++)"});
     
@@ -443,6 +602,8 @@ T2CFuncBodyDriver::_add_ket_loop_start(      VCodeLines&            lines,
     lines.push_back({4, 0, 2, "const auto a_exp = bra_gto_exps[k * bra_ncgtos + j];"});
 
     lines.push_back({4, 0, 2, "const auto a_norm = bra_gto_norms[k * bra_ncgtos + j];"});
+    
+    if (prim_screening > 0) _add_prim_screening(lines, integral, prim_screening);
 
     if (_need_center_p(integral))
     {
@@ -509,6 +670,85 @@ T2CFuncBodyDriver::_add_ket_loop_start(      VCodeLines&            lines,
     }
 }
 
+void
+T2CFuncBodyDriver::_add_prim_screening(      VCodeLines&  lines,
+                                       const I2CIntegral& integral,
+                                       const int          prim_screening) const
+{
+    // factors: ket exponents (0), ket normalization factors (1), R(AB) distances (5-7)
+    
+    lines.push_back({4, 0, 1, "// screen primitive pairs: skip bra primitive if (s|s) bound is negligible against all ket primitives"});
+    
+    lines.push_back({4, 0, 1, "{"});
+    
+    lines.push_back({5, 0, 1, "const auto b_exps = factors.data(0);"});
+    
+    lines.push_back({5, 0, 1, "const auto b_norms = factors.data(1);"});
+    
+    lines.push_back({5, 0, 1, "const auto ab_x = factors.data(5);"});
+    
+    lines.push_back({5, 0, 1, "const auto ab_y = factors.data(6);"});
+    
+    lines.push_back({5, 0, 2, "const auto ab_z = factors.data(7);"});
+    
+    lines.push_back({5, 0, 2, "const auto nelems = pbuffer.number_of_active_elements();"});
+    
+    lines.push_back({5, 0, 2, "double fmax = 0.0;"});
+    
+    lines.push_back({5, 0, 1, "#pragma omp simd aligned(b_exps, b_norms, ab_x, ab_y, ab_z : 64) reduction(max : fmax)"});
+    
+    lines.push_back({5, 0, 1, "for (size_t l = 0; l < nelems; l++)"});
+    
+    lines.push_back({5, 0, 1, "{"});
+    
+    lines.push_back({6, 0, 2, "const auto fe = a_exp + b_exps[l];"});
+    
+    lines.push_back({6, 0, 2, "const auto fz = a_exp * b_exps[l] / fe;"});
+    
+    lines.push_back({6, 0, 2, "const auto r2ab = ab_x[l] * ab_x[l] + ab_y[l] * ab_y[l] + ab_z[l] * ab_z[l];"});
+    
+    lines.push_back({6, 0, 2, "const auto fss = " + _get_prim_screening_bound(integral) + ";"});
+    
+    lines.push_back({6, 0, 1, "fmax = (fss > fmax) ? fss : fmax;"});
+    
+    lines.push_back({5, 0, 2, "}"});
+    
+    lines.push_back({5, 0, 1, "if (fmax < 1.0e-" + std::to_string(prim_screening) + ") continue;"});
+    
+    lines.push_back({4, 0, 2, "}"});
+}
+
+std::string
+T2CFuncBodyDriver::_get_prim_screening_bound(const I2CIntegral& integral) const
+{
+    const auto name = integral.integrand().name();
+    
+    // kinetic energy: (s|T|s) = zeta (3 - 2 zeta R_AB^2) (s|s), bounded by zeta (3 + 2 zeta R_AB^2) (s|s)
+    
+    if (name == "T")
+    {
+        return "std::fabs(a_norm * b_norms[l]) * fz * (3.0 + 2.0 * fz * r2ab) * (3.141592653589793 / fe) * std::sqrt(3.141592653589793 / fe) * std::exp(-fz * r2ab)";
+    }
+    
+    // nuclear potential: (s|A|s) = 2 pi / p exp(-zeta R_AB^2) F_0(p R_PC^2) per unit charge and F_0 <= 1
+    
+    if ((name == "A") || (name == "AG"))
+    {
+        return "std::fabs(a_norm * b_norms[l]) * (6.283185307179586 / fe) * std::exp(-fz * r2ab)";
+    }
+    
+    // electron repulsion: (s|s) = 2 pi^5/2 / (a b sqrt(p)) F_0(zeta R_AB^2) and F_0(T) <= min(1, sqrt(pi / (4 T)))
+    
+    if (name == "1/|r-r'|")
+    {
+        return "std::fabs(a_norm * b_norms[l]) * 34.98683665524972 / (a_exp * b_exps[l] * std::sqrt(fe)) * ((fz * r2ab > 0.7853981633974483) ? 0.886226925452758 / std::sqrt(fz * r2ab) : 1.0)";
+    }
+    
+    // overlap, and overlap bound for remaining integrands: (s|s) = (pi / p)^3/2 exp(-zeta R_AB^2)
+    
+    return "std::fabs(a_norm * b_norms[l]) * (3.141592653589793 / fe) * std::sqrt(3.141592653589793 / fe) * std::exp(-fz * r2ab)";
+}
+
 void
 T2CFuncBodyDriver::_add_ket_loop_end(      VCodeLines&            lines,
                                      const SI2CIntegrals&         integrals,
@@ -529,7 +769,7 @@ T2CFuncBodyDriver::_add_ket_loop_end(      VCodeLines&            lines,
             
             for (const auto& tint : integrals)
             {
-                icomps += tint.components<T1CPair, T1CPair>().size();
+                icomps += tint.number_of_components();
             }
             
             label += std::to_string(icomps)  + ", ";
@@ -547,7 +787,8 @@ void
 T2CFuncBodyDriver::_add_sum_loop_start(      VCodeLines&            lines,
                                        const I2CIntegral&           integral,
                                        const std::pair<bool, bool>& rec_form,
-                                       const bool                   use_rs) const
+                                       const bool                   use_rs,
+                                       const bool                   point_batch) const
 {
     if (rec_form.first)
     {
@@ -562,7 +803,7 @@ T2CFuncBodyDriver::_add_sum_loop_start(      VCodeLines&            lines,
         {
             lines.push_back({4, 0, 2, "const size_t npoints = coords.size();"});
                 
-            lines.push_back({4, 0, 1, "for (size_t l = 0; l < npoints; l++)"});
+            lines.push_back({4, 0, 1, (point_batch) ? "for (size_t l = 0; l < npoints; l += npblock)" : "for (size_t l = 0; l < npoints; l++)"});
         }
         else
         {
@@ -570,29 +811,33 @@ T2CFuncBodyDriver::_add_sum_loop_start(      VCodeLines&            lines,
         }
         
         lines.push_back({4, 0, 1, "{"});
-       
-        if (_need_distances_pc(integral))
+        
+        if (_is_three_center_overlap(integral))
+        {
+            _add_point_factors(lines, integral, point_batch);
+        }
+        else if (_need_distances_pc(integral))
         {
             const auto label = std::to_string(_get_index_pc(integral));
         
             lines.push_back({5, 0, 2, "t2cfunc::comp_distances_pc(factors, " + label + ", 8, coords[l]);"});
         }
         
-        if (_need_distances_ga(integral))
+        if (_need_distances_ga(integral) && !_is_three_center_overlap(integral))
         {
             const auto label = std::to_string(_get_index_ga(integral));
         
             lines.push_back({5, 0, 2, "t2cfunc::comp_distances_ga(factors, " + label + ", 8, r_a, coords[l], a_exp, exgtos[l]);"});
         }
         
-        if (_need_distances_gb(integral))
+        if (_need_distances_gb(integral) && !_is_three_center_overlap(integral))
         {
             const auto label = std::to_string(_get_index_gb(integral));
         
             lines.push_back({5, 0, 2, "t2cfunc::comp_distances_gb(factors, " + label + ", 8, 2, coords[l], a_exp, exgtos[l]);"});
         }
         
-        if (_need_distances_gc(integral))
+        if (_need_distances_gc(integral) && !_is_three_center_overlap(integral))
         {
             const auto label = std::to_string(_get_index_gc(integral));
         
@@ -621,11 +866,189 @@ T2CFuncBodyDriver::_add_sum_loop_start(      VCodeLines&            lines,
     }
 }
 
+void
+T2CFuncBodyDriver::_add_point_factors(      VCodeLines&  lines,
+                                      const I2CIntegral& integral,
+                                      const bool         point_batch) const
+{
+    // Gaussian product center G = (p P + g C) / (p + g) is shared by R(GA), R(GB), R(GC)
+    
+    const auto need_ga = _need_distances_ga(integral);
+    
+    const auto need_gb = _need_distances_gb(integral);
+    
+    const auto need_gc = _need_distances_gc(integral);
+    
+    const auto need_g = need_ga || need_gb || need_gc;
+    
+    std::vector<std::pair<std::string, int>> rows({{"pc", _get_index_pc(integral)},});
+    
+    if (need_ga) rows.push_back({"ga", _get_index_ga(integral)});
+    
+    if (need_gb) rows.push_back({"gb", _get_index_gb(integral)});
+    
+    if (need_gc) rows.push_back({"gc", _get_index_gc(integral)});
+    
+    std::string aligned = "p_x, p_y, p_z";
+    
+    if (point_batch)
+    {
+        // points past end of grid are padded with last point and zero normalization factor
+        
+        const auto idx_cexps = _get_number_of_factors(integral);
+        
+        lines.push_back({5, 0, 1, "// set up point factors in single pass over ket side of each point in batch"});
+        
+        lines.push_back({5, 0, 1, "for (size_t p = 0; p < npblock; p++)"});
+        
+        lines.push_back({5, 0, 1, "{"});
+        
+        lines.push_back({6, 0, 2, "const auto ipt = std::min(l + p, npoints - 1);"});
+        
+        lines.push_back({6, 0, 2, "const auto r_c = coords[ipt].coordinates();"});
+        
+        lines.push_back({6, 0, 2, "const auto g_exp = exgtos[ipt];"});
+        
+        lines.push_back({6, 0, 2, "const auto g_fact = ((l + p) < npoints) ? exgtos[npoints + ipt] : 0.0;"});
+        
+        lines.push_back({6, 0, 1, "auto g_exps = factors.data(" + std::to_string(idx_cexps) + ");"});
+        
+        lines.push_back({6, 0, 2, "auto g_facts = factors.data(" + std::to_string(idx_cexps + 1) + ");"});
+        
+        aligned = "g_exps, g_facts, " + aligned;
+    }
+    else
+    {
+        lines.push_back({5, 0, 1, "// set up point factors in single pass over ket side"});
+        
+        lines.push_back({5, 0, 1, "{"});
+        
+        lines.push_back({6, 0, 2, "const auto r_c = coords[l].coordinates();"});
+        
+        if (need_g) lines.push_back({6, 0, 2, "const auto g_exp = exgtos[l];"});
+    }
+    
+    if (need_g)
+    {
+        lines.push_back({6, 0, 2, "const auto b_exps = factors.data(0);"});
+        
+        aligned = "b_exps, " + aligned;
+    }
+    
+    if (need_ga) lines.push_back({6, 0, 2, "const auto r_axyz = r_a.coordinates();"});
+    
+    if (need_gb)
+    {
+        lines.push_back({6, 0, 1, "const auto b_x = factors.data(2);"});
+        
+        lines.push_back({6, 0, 1, "const auto b_y = factors.data(3);"});
+        
+        lines.push_back({6, 0, 2, "const auto b_z = factors.data(4);"});
+        
+        aligned += ", b_x, b_y, b_z";
+    }
+    
+    lines.push_back({6, 0, 1, "const auto p_x = factors.data(8);"});
+    
+    lines.push_back({6, 0, 1, "const auto p_y = factors.data(9);"});
+    
+    lines.push_back({6, 0, 2, "const auto p_z = factors.data(10);"});
+    
+    for (const auto& [name, index] : rows)
+    {
+        lines.push_back({6, 0, 1, "auto " + name + "_x = factors.data(" + std::to_string(index) + ");"});
+        
+        lines.push_back({6, 0, 1, "auto " + name + "_y = factors.data(" + std::to_string(index + 1) + ");"});
+        
+        lines.push_back({6, 0, 2, "auto " + name + "_z = factors.data(" + std::to_string(index + 2) + ");"});
+        
+        aligned += ", " + name + "_x, " + name + "_y, " + name + "_z";
+    }
+    
+    if (point_batch)
+    {
+        lines.push_back({6, 0, 1, "#pragma omp simd aligned(" + aligned + " : 64)"});
+        
+        lines.push_back({6, 0, 1, "for (size_t m = p * ket_lanes; m < (p + 1) * ket_lanes; m++)"});
+        
+        lines.push_back({6, 0, 1, "{"});
+        
+        lines.push_back({7, 0, 1, "g_exps[m] = g_exp;"});
+        
+        lines.push_back({7, 0, 2, "g_facts[m] = g_fact;"});
+    }
+    else
+    {
+        lines.push_back({6, 0, 2, "const auto nelems = pbuffer.number_of_active_elements();"});
+        
+        lines.push_back({6, 0, 1, "#pragma omp simd aligned(" + aligned + " : 64)"});
+        
+        lines.push_back({6, 0, 1, "for (size_t m = 0; m < nelems; m++)"});
+        
+        lines.push_back({6, 0, 1, "{"});
+    }
+    
+    lines.push_back({7, 0, 1, "pc_x[m] = p_x[m] - r_c[0];"});
+    
+    lines.push_back({7, 0, 1, "pc_y[m] = p_y[m] - r_c[1];"});
+    
+    lines.push_back({7, 0, (need_g) ? 2 : 1, "pc_z[m] = p_z[m] - r_c[2];"});
+    
+    if (need_g)
+    {
+        lines.push_back({7, 0, 2, "const auto fe = a_exp + b_exps[m];"});
+        
+        lines.push_back({7, 0, 2, "const auto fi = 1.0 / (fe + g_exp);"});
+        
+        lines.push_back({7, 0, 1, "const auto g_x = (fe * p_x[m] + g_exp * r_c[0]) * fi;"});
+        
+        lines.push_back({7, 0, 1, "const auto g_y = (fe * p_y[m] + g_exp * r_c[1]) * fi;"});
+        
+        lines.push_back({7, 0, 1, "const auto g_z = (fe * p_z[m] + g_exp * r_c[2]) * fi;"});
+        
+        const std::vector<std::pair<std::string, std::array<std::string, 3>>> gdists({
+            {"ga", {"r_axyz[0]", "r_axyz[1]", "r_axyz[2]"}},
+            {"gb", {"b_x[m]", "b_y[m]", "b_z[m]"}},
+            {"gc", {"r_c[0]", "r_c[1]", "r_c[2]"}},
+        });
+        
+        for (const auto& [name, coords] : gdists)
+        {
+            if ((name == "ga") && !need_ga) continue;
+            
+            if ((name == "gb") && !need_gb) continue;
+            
+            if ((name == "gc") && !need_gc) continue;
+            
+            lines.push_back({0, 0, 1, ""});
+            
+            lines.push_back({7, 0, 1, name + "_x[m] = g_x - " + coords[0] + ";"});
+            
+            lines.push_back({7, 0, 1, name + "_y[m] = g_y - " + coords[1] + ";"});
+            
+            lines.push_back({7, 0, 1, name + "_z[m] = g_z - " + coords[2] + ";"});
+        }
+    }
+    
+    lines.push_back({6, 0, 1, "}"});
+    
+    lines.push_back({5, 0, 2, "}"});
+}
+
+bool
+T2CFuncBodyDriver::_is_three_center_overlap(const I2CIntegral& integral) const
+{
+    const auto name = integral.integrand().name();
+    
+    return (name == "G(r)") || (name == "GX(r)") || (name == "GR2(r)") || (name == "GR.R2(r)");
+}
+
 void
 T2CFuncBodyDriver::_add_sum_loop_end(      VCodeLines&            lines,
                                      const SI2CIntegrals&         integrals,
                                      const I2CIntegral&           integral,
-                                     const std::pair<bool, bool>& rec_form) const
+                                     const std::pair<bool, bool>& rec_form,
+                                     const bool                   point_batch) const
 {
     if (rec_form.first)
     {
@@ -641,7 +1064,7 @@ T2CFuncBodyDriver::_add_sum_loop_end(      VCodeLines&            lines,
             
             for (const auto& tint : integrals)
             {
-                icomps += tint.components<T1CPair, T1CPair>().size();
+                icomps += tint.number_of_components();
             }
             
             label += std::to_string(icomps)  + ", ";
@@ -665,7 +1088,7 @@ T2CFuncBodyDriver::_add_sum_loop_end(      VCodeLines&            lines,
             if (iorder == 4) label += "hexadecapoles, 15, l, ";
         }
         
-        label += "ket_width, ket_npgtos);";
+        label += (point_batch) ? "ket_width, npblock * ket_npgtos);" : "ket_width, ket_npgtos);";
     
         lines.push_back({5, 0, 1, label});
         
@@ -678,10 +1101,17 @@ T2CFuncBodyDriver::_add_auxilary_integrals(      VCodeLines&            lines,
                                            const SI2CIntegrals&         integrals,
                                            const I2CIntegral&           integral,
                                            const std::pair<bool, bool>& rec_form,
-                                           const bool                   in_sum_loop) const
+                                           const bool                   in_sum_loop,
+                                           const bool                   point_batch) const
 {
     const auto spacer = (rec_form.first) ? 5 : 4;
     
+    // point-batched seeds read exponents and normalization factors of external Gaussians from factors
+    
+    const auto idx_cexps = std::to_string(_get_number_of_factors(integral));
+    
+    const auto idx_cfacts = std::to_string(_get_number_of_factors(integral) + 1);
+    
     for (const auto& tint : integrals)
     {
         if (!tint.is_simple()) continue;
@@ -736,7 +1166,14 @@ T2CFuncBodyDriver::_add_auxilary_integrals(      VCodeLines&            lines,
                 {
                     const auto label = std::to_string(_get_position(tint, integrals)) + ", " + std::to_string(_get_position(sint, integrals));
                     
-                    lines.push_back({spacer, 0, 2, "t3ovlrec::comp_prim_overlap_ss(pbuffer, " + label + ", factors, " + std::to_string(_get_index_pc(integral)) + ", a_exp, exgtos[l], exgtos[npoints + l]);"});
+                    if (point_batch)
+                    {
+                        lines.push_back({spacer, 0, 2, "t3ovlrec::comp_prim_point_batch_overlap_ss(pbuffer, " + label + ", factors, " + std::to_string(_get_index_pc(integral)) + ", a_exp, " + idx_cexps + ", " + idx_cfacts + ");"});
+                    }
+                    else
+                    {
+                        lines.push_back({spacer, 0, 2, "t3ovlrec::comp_prim_overlap_ss(pbuffer, " + label + ", factors, " + std::to_string(_get_index_pc(integral)) + ", a_exp, exgtos[l], exgtos[npoints + l]);"});
+                    }
                 }
             }
             
@@ -792,7 +1229,14 @@ T2CFuncBodyDriver::_add_auxilary_integrals(      VCodeLines&            lines,
                 {
                     const auto label = std::to_string(_get_position(tint, integrals)) + ", " + std::to_string(_get_position(sint, integrals));
                     
-                    lines.push_back({spacer, 0, 2, "t3r2rec::comp_prim_r2_ss(pbuffer, " + label + ", factors, " + std::to_string(_get_index_gc(integral)) + ", a_exp, exgtos[l]);"});
+                    if (point_batch)
+                    {
+                        lines.push_back({spacer, 0, 2, "t3r2rec::comp_prim_point_batch_r2_ss(pbuffer, " + label + ", factors, " + std::to_string(_get_index_gc(integral)) + ", a_exp, " + idx_cexps + ");"});
+                    }
+                    else
+                    {
+                        lines.push_back({spacer, 0, 2, "t3r2rec::comp_prim_r2_ss(pbuffer, " + label + ", factors, " + std::to_string(_get_index_gc(integral)) + ", a_exp, exgtos[l]);"});
+                    }
                 }
             }
         
@@ -817,7 +1261,14 @@ T2CFuncBodyDriver::_add_auxilary_integrals(      VCodeLines&            lines,
                     const auto label = std::to_string(_get_position(tint, integrals))               + ", " + std::to_string(_get_position(sint, integrals))
                                + ", " + std::to_string(_get_position(r2int, integrals));
                     
-                    lines.push_back({spacer, 0, 2, "t3rr2rec::comp_prim_r_r2_ss(pbuffer, " + label + ", factors, " + std::to_string(_get_index_gc(integral)) + ", a_exp, exgtos[l]);"});
+                    if (point_batch)
+                    {
+                        lines.push_back({spacer, 0, 2, "t3rr2rec::comp_prim_point_batch_r_r2_ss(pbuffer, " + label + ", factors, " + std::to_string(_get_index_gc(integral)) + ", a_exp, " + idx_cexps + ");"});
+                    }
+                    else
+                    {
+                        lines.push_back({spacer, 0, 2, "t3rr2rec::comp_prim_r_r2_ss(pbuffer, " + label + ", factors, " + std::to_string(_get_index_gc(integral)) + ", a_exp, exgtos[l]);"});
+                    }
                 }
             }
         }
@@ -829,10 +1280,15 @@ void
 T2CFuncBodyDriver::_add_call_tree(      VCodeLines&            lines,
                                   const SI2CIntegrals&         integrals,
                                   const I2CIntegral&           integral,
-                                  const std::pair<bool, bool>& rec_form) const
+                                  const std::pair<bool, bool>& rec_form,
+                                  const bool                   point_batch) const
 {
     const int spacer = (rec_form.first) ? 5 : 4;
     
+    // point-batched recursion reads exponents of external Gaussians from factors
+    
+    const auto exgto_label = (point_batch) ? ", " + std::to_string(_get_number_of_factors(integral)) : std::string(", exgtos[l]");
+    
     for (const auto& tint : integrals)
     {
         if (!tint.is_simple()) continue;
@@ -841,7 +1297,7 @@ T2CFuncBodyDriver::_add_call_tree(      VCodeLines&            lines,
         
         if ((tint[0] != 0) || (tint[1] != 0) || (tint.integrand().name() == "GX(r)"))
         {
-            const auto name = t2c::prim_compute_func_name(tint);
+            const auto name = (point_batch && t2c::need_point_exponent(tint)) ? t2c::point_batch_prim_compute_func_name(tint) : t2c::prim_compute_func_name(tint);
             
             auto label = t2c::namespace_label(tint) + "::" + name + "(pbuffer, ";
             
@@ -906,7 +1362,7 @@ T2CFuncBodyDriver::_add_call_tree(      VCodeLines&            lines,
                     (tint.integrand().name() == "GR2(r)")
                     )
                 {
-                    label += ", exgtos[l]"; 
+                    label += exgto_label;
                 }
             }
             else
@@ -930,7 +1386,7 @@ T2CFuncBodyDriver::_add_call_tree(      VCodeLines&            lines,
         {
             if ((tint[0] != 0) || (tint[1] != 0))
             {
-                const auto name = t2c::prim_compute_func_name(tint);
+                const auto name = (point_batch) ? t2c::point_batch_prim_compute_func_name(tint) : t2c::prim_compute_func_name(tint);
                 
                 auto label = t2c::namespace_label(tint) + "::" + name + "(pbuffer, ";
                 
@@ -942,7 +1398,7 @@ T2CFuncBodyDriver::_add_call_tree(      VCodeLines&            lines,
                 
                 if (_need_exponents(tint))
                 {
-                    label += "a_exp, exgtos[l]";
+                    label += "a_exp" + exgto_label;
                 }
                 else
                 {
@@ -981,7 +1437,7 @@ T2CFuncBodyDriver::_add_geom_call_tree(      VCodeLines&            lines,
         
         for (const auto& tint : vrr_integrals)
         {
-            icomps += tint.components<T1CPair, T1CPair>().size();
+            icomps += tint.number_of_components();
         }
         
         label += std::to_string(icomps)  + ", ";
@@ -991,11 +1447,11 @@ T2CFuncBodyDriver::_add_geom_call_tree(      VCodeLines&            lines,
             label += std::to_string(_get_position(cint, vrr_integrals)) + ", ";
         }
         
-        label += std::to_string(integral.integrand().shape().components().size()) + ", ";
+        label += std::to_string(integral.integrand().shape().number_of_components()) + ", ";
         
         if (geom_drvs[2] == 0)
         {
-            label += std::to_string(Tensor(integral[1]).components().size()) + ", ";
+            label += std::to_string(Tensor(integral[1]).number_of_components()) + ", ";
         }
         
         if (geom_drvs[2] > 0) label += "factors, ";
@@ -1043,7 +1499,7 @@ T2CFuncBodyDriver::_get_position(const I2CIntegral&   integral,
     {
         if (tint == integral) return pos;
         
-        pos += tint.components<T1CPair, T1CPair>().size();
+        pos += tint.number_of_components();
     }
     
     return 0;
@@ -41,17 +41,33 @@ class T2CFuncBodyDriver
     
     /// Generates vector of ket factors in compute function.
     /// @param integral The base two center integral.
+    /// @param point_batch The flag for point-batched compute function.
     /// @return The vector of ket factors in compute function.
-    std::vector<std::string> _get_ket_variables_def(const I2CIntegral& integral) const;
+    std::vector<std::string> _get_ket_variables_def(const I2CIntegral& integral,
+                                                    const bool         point_batch) const;
+    
+    /// Gets number of ket side factors in compute function.
+    /// @param integral The base two center integral.
+    /// @return The number of ket side factors.
+    size_t _get_number_of_factors(const I2CIntegral& integral) const;
     
     /// Generates vector of buffers in compute function.
     /// @param integrals The set of inetrgals.
     /// @param integral The base two center integral.
     /// @param geom_drvs The geometrical derivative of bra side, integrand, and  ket side.
+    /// @param point_batch The flag for point-batched compute function.
+    /// @param trans_inv The flag to add ket side derivatives obtained by translational invariance.
     /// @return The vector of buffers in compute function.
-    std::vector<std::string> _get_buffers_def(const SI2CIntegrals& integrals,
-                                              const I2CIntegral&   integral,
-                                              const std::array<int, 3>& geom_drvs) const;
+    std::vector<std::string> _get_buffers_def(const SI2CIntegrals&      integrals,
+                                              const I2CIntegral&        integral,
+                                              const std::array<int, 3>& geom_drvs,
+                                              const bool                point_batch,
+                                              const bool                trans_inv) const;
+    
+    /// Gets number of distributed integral components of compute function.
+    /// @param integral The base two center integral.
+    /// @return The number of distributed integral components.
+    size_t _get_number_of_components(const I2CIntegral& integral) const;
     
     /// Generates vector of Boys function definitions in compute function.
     /// @param integral The base two center integral.
@@ -61,24 +77,63 @@ class T2CFuncBodyDriver
     /// Adds loop start definitions to code lines container.
     /// @param lines The code lines container to which loop start definition are added.
     /// @param integral The base two center integral.
+    /// @param point_batch The flag for point-batched compute function.
+    /// @param trans_inv The flag to add ket side derivatives obtained by translational invariance.
     void _add_loop_start(      VCodeLines&  lines,
-                         const I2CIntegral& integral) const;
+                         const I2CIntegral& integral,
+                         const bool         point_batch,
+                         const bool         trans_inv) const;
     
-    /// Adds loop end definitions to code lines container.
+    /// Adds loop end definitions to code lines container. If requested, bra side derivatives are
+    /// followed by ket side derivatives written as their negative, d/dB = -d/dA.
     /// @param lines The code lines container to which loop start definition are added.
     /// @param integral The base two center integral.
     /// @param rec_form The recursion form for two center integrals (summation, convolution flags).
+    /// @param trans_inv The flag to add ket side derivatives obtained by translational invariance.
     void _add_loop_end(      VCodeLines&  lines,
                        const I2CIntegral& integral,
-                       const std::pair<bool, bool>& rec_form) const;
+                       const std::pair<bool, bool>& rec_form,
+                       const bool                   trans_inv) const;
+    
+    /// Adds point dependent factors of three-center overlap like integrals to code lines container.
+    /// R(PC), R(GA), R(GB), and R(GC) are computed in single vectorized pass over ket side,
+    /// reusing bra-ket pair factors and evaluating product center G once per point. In point-batched
+    /// compute function, each point of batch fills its own copy of ket side lanes.
+    /// @param lines The code lines container to which point factors are added.
+    /// @param integral The base two center integral.
+    /// @param point_batch The flag for point-batched compute function.
+    void _add_point_factors(      VCodeLines&  lines,
+                            const I2CIntegral& integral,
+                            const bool         point_batch) const;
+    
+    /// Checks if integral is three-center overlap like integral (G(r), GX(r), GR2(r), GR.R2(r) integrands).
+    /// @param integral The base two center integral.
+    /// @return True if integral is three-center overlap like integral, False otherwise.
+    bool _is_three_center_overlap(const I2CIntegral& integral) const;
     
     /// Adds ket loop start definitions to code lines container.
     /// @param lines The code lines container to which loop start definition are added.
     /// @param integral The base two center integral.
     /// @param rec_form The recursion form for two center integrals (summation, convolution flags).
+    /// @param prim_screening The primitive pairs screening threshold exponent (0 disables screening).
     void _add_ket_loop_start(      VCodeLines&            lines,
                              const I2CIntegral&           integral,
-                             const std::pair<bool, bool>& rec_form) const;
+                             const std::pair<bool, bool>& rec_form,
+                             const int                    prim_screening) const;
+    
+    /// Adds primitive pairs screening test to code lines container. The bra primitive is skipped
+    /// if its (s|s) integral bound with every ket primitive in SIMD batch is negligible.
+    /// @param lines The code lines container to which screening test is added.
+    /// @param integral The base two center integral.
+    /// @param prim_screening The primitive pairs screening threshold exponent.
+    void _add_prim_screening(      VCodeLines&  lines,
+                             const I2CIntegral& integral,
+                             const int          prim_screening) const;
+    
+    /// Gets (s|s) integral bound expression of primitive pair for primitive pairs screening.
+    /// @param integral The base two center integral.
+    /// @return The bound expression in terms of a_exp, a_norm, b_exps[l], b_norms[l], fe, fz, and r2ab.
+    std::string _get_prim_screening_bound(const I2CIntegral& integral) const;
     
     /// Adds ket loop end definitions to code lines container.
     /// @param lines The code lines container to which loop start definition are added.
@@ -95,20 +150,24 @@ class T2CFuncBodyDriver
     /// @param integral The base two center integral.
     /// @param rec_form The recursion form for two center integrals (summation, convolution flags).
     /// @param use_rs The flag for use of range-separated Coulomb interactions.
+    /// @param point_batch The flag for point-batched compute function.
     void _add_sum_loop_start(      VCodeLines&            lines,
                              const I2CIntegral&           integral,
                              const std::pair<bool, bool>& rec_form,
-                             const bool                   use_rs) const;
+                             const bool                   use_rs,
+                             const bool                   point_batch) const;
     
     /// Adds sum loop end definitions to code lines container.
     /// @param lines The code lines container to which loop start definition are added.
     /// @param integrals The set of inetrgals.
     /// @param integral The base two center integral.
     /// @param rec_form The recursion form for two center integrals (summation, convolution flags).
+    /// @param point_batch The flag for point-batched compute function.
     void _add_sum_loop_end(      VCodeLines&            lines,
                            const SI2CIntegrals&         integrals,
                            const I2CIntegral&           integral,
-                           const std::pair<bool, bool>& rec_form) const;
+                           const std::pair<bool, bool>& rec_form,
+                           const bool                   point_batch) const;
     
     /// Adds auxilary integrals.
     /// @param lines The code lines container to which loop start definition are added.
@@ -116,21 +175,25 @@ class T2CFuncBodyDriver
     /// @param integral The base two center integral.
     /// @param rec_form The recursion form for two center integrals (summation, convolution flags).
     /// @param in_sum_loop The flag indicating call from inside summation loop.
+    /// @param point_batch The flag for point-batched compute function.
     void _add_auxilary_integrals(      VCodeLines&            lines,
                                  const SI2CIntegrals&         integrals,
                                  const I2CIntegral&           integral,
                                  const std::pair<bool, bool>& rec_form,
-                                 const bool                   in_sum_loop) const;
+                                 const bool                   in_sum_loop,
+                                 const bool                   point_batch) const;
     
     /// Adds call tree for recursion.
     /// @param lines The code lines container to which loop start definition are added.
     /// @param integrals The set of inetrgals.
     /// @param integral The base two center integral.
     /// @param rec_form The recursion form for two center integrals (summation, convolution flags).
+    /// @param point_batch The flag for point-batched compute function.
     void _add_call_tree(      VCodeLines&            lines,
                         const SI2CIntegrals&         integrals,
                         const I2CIntegral&           integral,
-                        const std::pair<bool, bool>& rec_form) const;
+                        const std::pair<bool, bool>& rec_form,
+                        const bool                   point_batch) const;
     
     /// Adds call tree for recursion.
     /// @param lines The code lines container to which loop start definition are added.
@@ -251,13 +314,31 @@ public:
     /// @param geom_drvs The geometrical derivative of bra side, integrand, and  ket side.
     /// @param rec_form The recursion form for two center integrals (summation, convolution flags).
     /// @param use_rs The flag for use of range-separated Coulomb interactions.
+    /// @param prim_screening The primitive pairs screening threshold exponent n, i.e. threshold 10^-n (0 disables screening).
+    /// @param trans_inv The flag to add first order ket side derivatives as negative of bra side ones.
     void write_func_body(      std::ofstream&         fstream,
                          const SI2CIntegrals&         geom_integrals,
                          const SI2CIntegrals&         vrr_integrals,
                          const I2CIntegral&           integral,
                          const std::array<int, 3>& geom_drvs, 
                          const std::pair<bool, bool>& rec_form,
-                         const bool                   use_rs) const;
+                         const bool                   use_rs,
+                         const int                    prim_screening,
+                         const bool                   trans_inv) const;
+    
+    /// Writes body of point-batched compute function of three-center overlap like integrals. Each
+    /// SIMD lane batch holds ket side primitives of point_batch external Gaussians, so vertical
+    /// recursion runs once per batch of points instead of once per point.
+    /// @param fstream the file stream.
+    /// @param vrr_integrals The set of inetrgals in vertical recursion.
+    /// @param integral The base two center integral.
+    /// @param prim_screening The primitive pairs screening threshold exponent n, i.e. threshold 10^-n (0 disables screening).
+    /// @param point_batch The number of external Gaussians computed together in SIMD lanes.
+    void write_point_batch_func_body(      std::ofstream& fstream,
+                                     const SI2CIntegrals& vrr_integrals,
+                                     const I2CIntegral&   integral,
+                                     const int            prim_screening,
+                                     const int            point_batch) const;
 };
 
 #endif /* t2c_body_hpp */
@@ -17,6 +17,7 @@
 #include "t2c_cpu_generators.hpp"
 
 #include <iostream>
+#include <stdexcept>
 
 #include "string_formater.hpp"
 #include "file_stream.hpp"
@@ -48,7 +49,9 @@ T2CCPUGenerator::generate(const std::string&           label,
                           const int                    max_ang_mom,
                           const std::array<int, 3>&    geom_drvs,
                           const std::pair<bool, bool>& rec_form,
-                          const bool                   use_rs) const
+                          const bool                   use_rs,
+                          const int                    prim_screening,
+                          const int                    point_batch) const
 {
     if (_is_available(label))
     {
@@ -68,13 +71,25 @@ T2CCPUGenerator::generate(const std::string&           label,
                             
                             std::cout << "XXX : " << integral.label() << " : " << integrals.size() << std::endl;
 
-                            _write_cpp_header(integrals, integral, rec_form, use_rs);
+                            _write_cpp_header(integrals, integral, rec_form, use_rs, prim_screening);
+                            
+                            if (point_batch > 0)
+                            {
+                                _write_point_batch_cpp_header(integrals, integral, prim_screening, point_batch);
+                            }
                             
                             if (((i + j) >= 0) && (!use_rs))
                             {
-                                _write_prim_cpp_header(integral, rec_form);
+                                _write_prim_cpp_header(integral, rec_form, false);
                                     
-                                _write_prim_cpp_file(integral);
+                                _write_prim_cpp_file(integral, false);
+                                
+                                if ((point_batch > 0) && t2c::need_point_exponent(integral))
+                                {
+                                    _write_prim_cpp_header(integral, rec_form, true);
+                                    
+                                    _write_prim_cpp_file(integral, true);
+                                }
                             }
                         }
                     }
@@ -84,11 +99,7 @@ T2CCPUGenerator::generate(const std::string&           label,
     }
     else
     {
-        std::cerr << "*** ERROR *** Unsupported type of two-center integral: ";
-        
-        std::cerr << label << " !!!" << std::endl;
-        
-        std::exit(EXIT_FAILURE);
+        throw std::invalid_argument("Unsupported type of two-center integral: " + label);
     }
 }
 
@@ -425,8 +436,11 @@ T2CCPUGenerator::_generate_integral_group(const I2CIntegral&        integral,
 std::string
 T2CCPUGenerator::_file_name(const I2CIntegral&           integral,
                             const std::pair<bool, bool>& rec_form,
-                            const bool                   use_rs) const
+                            const bool                   use_rs,
+                            const bool                   point_batch) const
 {
+    if (point_batch) return t2c::integral_label(integral) + "PointBatchRec" + integral.label();
+    
     std::string label = (use_rs) ? "ErfRec" : "Rec";
     
     label += integral.label();
@@ -442,17 +456,18 @@ void
 T2CCPUGenerator::_write_cpp_header(const SI2CIntegrals&         integrals,
                                    const I2CIntegral&           integral,
                                    const std::pair<bool, bool>& rec_form,
-                                   const bool                   use_rs) const
+                                   const bool                   use_rs,
+                                   const int                    prim_screening) const
 {
-    auto fname = _file_name(integral, rec_form, use_rs) + ".hpp";
+    auto fname = _file_name(integral, rec_form, use_rs, false) + ".hpp";
         
     std::ofstream fstream;
                
     fstream.open(fname.c_str(), std::ios_base::trunc);
     
-    _write_hpp_defines(fstream, integral, rec_form, use_rs, false, true);
+    _write_hpp_defines(fstream, integral, rec_form, use_rs, false, false, true);
     
-    _write_hpp_includes(fstream, integrals, integral, rec_form, use_rs);
+    _write_hpp_includes(fstream, integrals, integral, rec_form, use_rs, prim_screening, false);
     
     _write_namespace(fstream, integral, true);
     
@@ -468,13 +483,54 @@ T2CCPUGenerator::_write_cpp_header(const SI2CIntegrals&         integrals,
     
     auto geom_drvs = std::array<int, 3>{0, 0, 0};
     
-    func_drv.write_func_body(fstream, {}, integrals, integral, geom_drvs, rec_form, use_rs);
+    func_drv.write_func_body(fstream, {}, integrals, integral, geom_drvs, rec_form, use_rs, prim_screening, false);
+    
+    fstream << std::endl;
+
+    _write_namespace(fstream, integral, false);
+        
+    _write_hpp_defines(fstream, integral, rec_form, use_rs, false, false, false);
+    
+    fstream.close();
+}
+
+void
+T2CCPUGenerator::_write_point_batch_cpp_header(const SI2CIntegrals& integrals,
+                                               const I2CIntegral&   integral,
+                                               const int            prim_screening,
+                                               const int            point_batch) const
+{
+    const std::pair<bool, bool> rec_form({true, false});
+    
+    auto fname = _file_name(integral, rec_form, false, true) + ".hpp";
+        
+    std::ofstream fstream;
+               
+    fstream.open(fname.c_str(), std::ios_base::trunc);
+    
+    _write_hpp_defines(fstream, integral, rec_form, false, false, true, true);
+    
+    _write_hpp_includes(fstream, integrals, integral, rec_form, false, prim_screening, true);
+    
+    _write_namespace(fstream, integral, true);
+    
+    T2CDocuDriver docs_drv;
+    
+    T2CDeclDriver decl_drv;
+    
+    T2CFuncBodyDriver func_drv;
+
+    docs_drv.write_point_batch_doc_str(fstream, integral);
+    
+    decl_drv.write_point_batch_func_decl(fstream, integral, false);
+    
+    func_drv.write_point_batch_func_body(fstream, integrals, integral, prim_screening, point_batch);
     
     fstream << std::endl;
 
     _write_namespace(fstream, integral, false);
         
-    _write_hpp_defines(fstream, integral, rec_form, use_rs, false, false);
+    _write_hpp_defines(fstream, integral, rec_form, false, false, true, false);
     
     fstream.close();
 }
@@ -485,9 +541,15 @@ T2CCPUGenerator::_write_hpp_defines(      std::ofstream&         fstream,
                                     const std::pair<bool, bool>& rec_form,
                                     const bool                   use_rs, 
                                     const bool                   is_prim_rec, 
+                                    const bool                   point_batch,
                                     const bool                   start) const
 {
-    auto fname = (is_prim_rec) ? t2c::prim_file_name(integral) : _file_name(integral, rec_form, use_rs) + "_hpp";
+    auto fname = _file_name(integral, rec_form, use_rs, point_batch) + "_hpp";
+    
+    if (is_prim_rec)
+    {
+        fname = (point_batch) ? t2c::point_batch_prim_file_name(integral) : t2c::prim_file_name(integral);
+    }
     
     auto lines = VCodeLines();
  
@@ -510,10 +572,22 @@ T2CCPUGenerator::_write_hpp_includes(      std::ofstream&         fstream,
                                      const SI2CIntegrals&         integrals,
                                      const I2CIntegral&           integral,
                                      const std::pair<bool, bool>& rec_form,
-                                     const bool                   use_rs) const
+                                     const bool                   use_rs,
+                                     const int                    prim_screening,
+                                     const bool                   point_batch) const
 {
     auto lines = VCodeLines();
     
+    if (point_batch)
+    {
+        lines.push_back({0, 0, 1, "#include <algorithm>"});
+    }
+    
+    if (prim_screening > 0)
+    {
+        lines.push_back({0, 0, 1, "#include <cmath>"});
+    }
+    
     lines.push_back({0, 0, 1, "#include <cstddef>"});
     
     lines.push_back({0, 0, 1, "#include <array>"});
@@ -542,7 +616,14 @@ T2CCPUGenerator::_write_hpp_includes(      std::ofstream&         fstream,
     
     for (const auto& rint : rints)
     {
-        lines.push_back({0, 0, 1, "#include \"" + t2c::prim_file_name(rint) + ".hpp\""});
+        if (point_batch && t2c::need_point_exponent(rint))
+        {
+            lines.push_back({0, 0, 1, "#include \"" + t2c::point_batch_prim_file_name(rint) + ".hpp\""});
+        }
+        else
+        {
+            lines.push_back({0, 0, 1, "#include \"" + t2c::prim_file_name(rint) + ".hpp\""});
+        }
     }
     
     if ((integral.integrand().name() == "A")  ||
@@ -584,15 +665,16 @@ T2CCPUGenerator::_write_namespace(      std::ofstream& fstream,
 
 void
 T2CCPUGenerator::_write_prim_cpp_header(const I2CIntegral&           integral,
-                                        const std::pair<bool, bool>& rec_form) const
+                                        const std::pair<bool, bool>& rec_form,
+                                        const bool                   point_batch) const
 {
-    auto fname = t2c::prim_file_name(integral) + ".hpp";
+    auto fname = ((point_batch) ? t2c::point_batch_prim_file_name(integral) : t2c::prim_file_name(integral)) + ".hpp";
         
     std::ofstream fstream;
                
     fstream.open(fname.c_str(), std::ios_base::trunc);
     
-    _write_hpp_defines(fstream, integral, rec_form, false, true, true);
+    _write_hpp_defines(fstream, integral, rec_form, false, true, point_batch, true);
     
     _write_prim_hpp_includes(fstream, integral);
     
@@ -600,15 +682,24 @@ T2CCPUGenerator::_write_prim_cpp_header(const I2CIntegral&           integral,
     
     T2CPrimDocuDriver docs_drv;
     
-    docs_drv.write_doc_str(fstream, integral);
-    
     T2CPrimDeclDriver decl_drv;
     
-    decl_drv.write_func_decl(fstream, integral, true);
+    if (point_batch)
+    {
+        docs_drv.write_point_batch_doc_str(fstream, integral);
+        
+        decl_drv.write_point_batch_func_decl(fstream, integral, true);
+    }
+    else
+    {
+        docs_drv.write_doc_str(fstream, integral);
+        
+        decl_drv.write_func_decl(fstream, integral, true);
+    }
     
     _write_namespace(fstream, integral, false);
     
-    _write_hpp_defines(fstream, integral, rec_form, false, true, false);
+    _write_hpp_defines(fstream, integral, rec_form, false, true, point_batch, false);
     
     fstream.close();
 }
@@ -625,25 +716,35 @@ T2CCPUGenerator::_write_prim_hpp_includes(      std::ofstream& fstream,
 }
 
 void
-T2CCPUGenerator::_write_prim_cpp_file(const I2CIntegral& integral) const
+T2CCPUGenerator::_write_prim_cpp_file(const I2CIntegral& integral,
+                                      const bool         point_batch) const
 {
-    auto fname = t2c::prim_file_name(integral) + ".cpp";
+    auto fname = ((point_batch) ? t2c::point_batch_prim_file_name(integral) : t2c::prim_file_name(integral)) + ".cpp";
         
     std::ofstream fstream;
         
     fstream.open(fname.c_str(), std::ios_base::trunc);
         
-    _write_prim_cpp_includes(fstream, integral);
+    _write_prim_cpp_includes(fstream, integral, point_batch);
 
     _write_namespace(fstream, integral, true);
 
     T2CPrimDeclDriver decl_drv;
     
-    decl_drv.write_func_decl(fstream, integral, false);
-
     T2CPrimFuncBodyDriver func_drv;
-
-    func_drv.write_func_body(fstream, integral);
+    
+    if (point_batch)
+    {
+        decl_drv.write_point_batch_func_decl(fstream, integral, false);
+        
+        func_drv.write_point_batch_func_body(fstream, integral);
+    }
+    else
+    {
+        decl_drv.write_func_decl(fstream, integral, false);
+        
+        func_drv.write_func_body(fstream, integral);
+    }
     
     fstream << std::endl; 
     
@@ -654,11 +755,14 @@ T2CCPUGenerator::_write_prim_cpp_file(const I2CIntegral& integral) const
 
 void
 T2CCPUGenerator::_write_prim_cpp_includes(      std::ofstream& fstream,
-                                          const I2CIntegral&   integral) const
+                                          const I2CIntegral&   integral,
+                                          const bool           point_batch) const
 {
     auto lines = VCodeLines();
     
-    lines.push_back({0, 0, 2, "#include \"" + t2c::prim_file_name(integral) +  ".hpp\""});
+    const auto fname = (point_batch) ? t2c::point_batch_prim_file_name(integral) : t2c::prim_file_name(integral);
+    
+    lines.push_back({0, 0, 2, "#include \"" + fname +  ".hpp\""});
     
     ost::write_code_lines(fstream, lines);
 }
@@ -52,20 +52,34 @@ class T2CCPUGenerator
     /// @param integral The base two center integral.
     /// @param rec_form The recursion form for two center integrals (summation, convolution flags).
     /// @param use_rs The flag for use of range-separated Coulomb interactions.
+    /// @param point_batch The flag for point-batched recursion.
     /// @return The file name.
     std::string _file_name(const I2CIntegral&           integral,
                            const std::pair<bool, bool>& rec_form,
-                           const bool                   use_rs) const;
+                           const bool                   use_rs,
+                           const bool                   point_batch) const;
     
     /// Writes header file for recursion.
     /// @param integrals The set of unique integrals.
     /// @param integral The base two center integral.
     /// @param rec_form The recursion form for two center integrals (summation, convolution flags).
     /// @param use_rs The flag for use of range-separated Coulomb interactions.
+    /// @param prim_screening The primitive pairs screening threshold exponent (0 disables screening).
     void _write_cpp_header(const SI2CIntegrals&         integrals,
                            const I2CIntegral&           integral,
                            const std::pair<bool, bool>& rec_form,
-                           const bool                   use_rs) const;
+                           const bool                   use_rs,
+                           const int                    prim_screening) const;
+    
+    /// Writes header file for point-batched recursion of three-center overlap like integrals.
+    /// @param integrals The set of unique integrals.
+    /// @param integral The base two center integral.
+    /// @param prim_screening The primitive pairs screening threshold exponent (0 disables screening).
+    /// @param point_batch The number of external Gaussians computed together in SIMD lanes.
+    void _write_point_batch_cpp_header(const SI2CIntegrals& integrals,
+                                       const I2CIntegral&   integral,
+                                       const int            prim_screening,
+                                       const int            point_batch) const;
     
     /// Writes definitions of define for header file.
     /// @param fstream the file stream.
@@ -73,12 +87,14 @@ class T2CCPUGenerator
     /// @param rec_form The recursion form for two center integrals (summation, convolution flags).
     /// @param use_rs The flag for use of range-separated Coulomb interactions.
     /// @param is_prim_rec The flag to indicate primitive recurion.
+    /// @param point_batch The flag for point-batched recursion.
     /// @param start The flag to indicate position of define (start or end).
     void _write_hpp_defines(      std::ofstream&         fstream,
                             const I2CIntegral&           integral,
                             const std::pair<bool, bool>& rec_form,
                             const bool                   use_rs,
                             const bool                   is_prim_rec,
+                            const bool                   point_batch,
                             const bool                   start) const;
     
     /// Writes definitions of includes for header file.
@@ -87,11 +103,15 @@ class T2CCPUGenerator
     /// @param integral The base two center integral.
     /// @param rec_form The recursion form for two center integrals (summation, convolution flags).
     /// @param use_rs The flag for use of range-separated Coulomb interactions.
+    /// @param prim_screening The primitive pairs screening threshold exponent (0 disables screening).
+    /// @param point_batch The flag for point-batched recursion.
     void _write_hpp_includes(      std::ofstream&         fstream,
                              const SI2CIntegrals&         integrals,
                              const I2CIntegral&           integral,
                              const std::pair<bool, bool>& rec_form,
-                             const bool                   use_rs) const;
+                             const bool                   use_rs,
+                             const int                    prim_screening,
+                             const bool                   point_batch) const;
     
     /// Writes namespace definition to file stream.
     /// @param fstream the file stream.
@@ -104,8 +124,10 @@ class T2CCPUGenerator
     /// Writes primitive header file for recursion.
     /// @param integral The base two center integral.
     /// @param rec_form The recursion form for two center integrals (summation, convolution flags).
+    /// @param point_batch The flag for point-batched primitive recursion.
     void _write_prim_cpp_header(const I2CIntegral&           integral,
-                                const std::pair<bool, bool>& rec_form) const;
+                                const std::pair<bool, bool>& rec_form,
+                                const bool                   point_batch) const;
     
     /// Writes definitions of includes for primitive header file.
     /// @param fstream the file stream.
@@ -115,13 +137,17 @@ class T2CCPUGenerator
     
     /// Writes C++ code file for primtive recursion.
     /// @param integral The base two center integral.
-    void _write_prim_cpp_file(const I2CIntegral& integral) const;
+    /// @param point_batch The flag for point-batched primitive recursion.
+    void _write_prim_cpp_file(const I2CIntegral& integral,
+                              const bool         point_batch) const;
     
     /// Writes definitions of includes for primitive header file.
     /// @param fstream the file stream.
     /// @param integral The base two center integral.
+    /// @param point_batch The flag for point-batched primitive recursion.
     void _write_prim_cpp_includes(      std::ofstream& fstream,
-                                  const I2CIntegral&  integral) const;
+                                  const I2CIntegral&  integral,
+                                  const bool          point_batch) const;
     
 public:
     /// Creates a two-center integrals CPU code generator.
@@ -133,11 +159,16 @@ public:
     /// @param geom_drvs The geometrical derivative of bra side, integrand, and  ket side.
     /// @param rec_form The recursion form for two center integrals (summation, convolution flags).
     /// @param use_rs The flag for use of range-separated Coulomb interactions.
+    /// @param prim_screening The primitive pairs screening threshold exponent n, i.e. threshold 10^-n (0 disables screening).
+    /// @param point_batch The number of external Gaussians computed together in SIMD lanes by additional
+    ///                    point-batched kernels of three-center overlap like integrals (0 disables them).
     void generate(const std::string&           label,
                   const int                    max_ang_mom,
                   const std::array<int, 3>&    geom_drvs,
                   const std::pair<bool, bool>& rec_form,
-                  const bool                   use_rs) const;
+                  const bool                   use_rs,
+                  const int                    prim_screening,
+                  const int                    point_batch) const;
 };
 
 #endif /* t2c_cpu_generators_hpp */
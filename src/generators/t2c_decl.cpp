@@ -51,6 +51,77 @@ T2CDeclDriver::write_func_decl(      std::ofstream&         fstream,
 }
 
 
+void
+T2CDeclDriver::write_point_batch_func_decl(      std::ofstream& fstream,
+                                           const I2CIntegral&   integral,
+                                           const bool           terminus) const
+{
+    auto lines = VCodeLines();
+    
+    const auto name = t2c::point_batch_compute_func_name(integral) + "(";
+    
+    const auto spacer = std::string(name.size(), ' ');
+    
+    const auto tsymbol = (terminus) ? ";" : "";
+    
+    lines.push_back({0, 0, 1, "template <class T>"});
+    
+    lines.push_back({0, 0, 1, "auto"});
+    
+    lines.push_back({0, 0, 1, name + "T& distributor,"});
+    
+    lines.push_back({0, 0, 1, spacer + "const CGtoBlock& bra_gto_block,"});
+    
+    lines.push_back({0, 0, 1, spacer + "const CGtoBlock& ket_gto_block,"});
+    
+    lines.push_back({0, 0, 1, spacer + "const std::pair<size_t, size_t>& bra_indices,"});
+    
+    lines.push_back({0, 0, 1, spacer + "const std::pair<size_t, size_t>& ket_indices,"});
+    
+    lines.push_back({0, 0, 1, spacer + "const bool bra_eq_ket) -> void" + tsymbol});
+    
+    ost::write_code_lines(fstream, lines);
+}
+
+void
+T2CDeclDriver::write_grad_func_decl(      std::ofstream&         fstream,
+                                    const I2CIntegral&           integral,
+                                    const std::pair<bool, bool>& rec_form,
+                                    const bool                   use_rs,
+                                    const bool                   terminus) const
+{
+    auto lines = VCodeLines();
+    
+    const auto name = t2c::grad_compute_func_name(integral, rec_form, use_rs) + "(";
+    
+    const auto spacer = std::string(name.size(), ' ');
+    
+    const auto tsymbol = (terminus) ? ";" : "";
+    
+    lines.push_back({0, 0, 1, "template <class T>"});
+    
+    lines.push_back({0, 0, 1, "auto"});
+    
+    lines.push_back({0, 0, 1, name + "T& distributor,"});
+    
+    if (use_rs)
+    {
+        lines.push_back({0, 0, 1, spacer + "const std::vector<double>& omegas,"});
+    }
+    
+    lines.push_back({0, 0, 1, spacer + "const CGtoBlock& bra_gto_block,"});
+    
+    lines.push_back({0, 0, 1, spacer + "const CGtoBlock& ket_gto_block,"});
+    
+    lines.push_back({0, 0, 1, spacer + "const std::pair<size_t, size_t>& bra_indices,"});
+    
+    lines.push_back({0, 0, 1, spacer + "const std::pair<size_t, size_t>& ket_indices,"});
+    
+    lines.push_back({0, 0, 1, spacer + "const bool bra_eq_ket) -> void" + tsymbol});
+    
+    ost::write_code_lines(fstream, lines);
+}
+
 void
 T2CDeclDriver::write_ecp_func_decl(      std::ofstream& fstream,
                                    const I2CIntegral&   integral,
@@ -72,6 +72,26 @@ public:
                          const bool                   use_rs,
                          const bool                   terminus) const;
     
+    /// Writes declaration for point-batched compute function.
+    /// @param fstream the file stream.
+    /// @param integral The base two center integral.
+    /// @param terminus The flag to add termination symbol.
+    void write_point_batch_func_decl(      std::ofstream& fstream,
+                                     const I2CIntegral&   integral,
+                                     const bool           terminus) const;
+    
+    /// Writes declaration for gradient compute function.
+    /// @param fstream the file stream.
+    /// @param integral The base two center integral with first order bra side derivative.
+    /// @param rec_form The recursion form for two center integrals (summation, convolution flags).
+    /// @param use_rs The flag for use of range-separated Coulomb interactions.
+    /// @param terminus The flag to add termination symbol.
+    void write_grad_func_decl(      std::ofstream&         fstream,
+                              const I2CIntegral&           integral,
+                              const std::pair<bool, bool>& rec_form,
+                              const bool                   use_rs,
+                              const bool                   terminus) const;
+    
     /// Writes declaration for compute function.
     /// @param fstream the file stream.
     /// @param integral The base two center integral.
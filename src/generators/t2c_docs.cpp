@@ -48,6 +48,67 @@ T2CDocuDriver::write_doc_str(      std::ofstream&         fstream,
     ost::write_code_lines(fstream, lines);
 }
 
+void
+T2CDocuDriver::write_grad_doc_str(      std::ofstream& fstream,
+                                  const I2CIntegral&   integral,
+                                  const bool           use_rs) const
+{
+    auto lines = VCodeLines();
+    
+    auto label = _get_compute_str(integral, use_rs);
+    
+    label.replace(label.size() - 1, 1, ", followed by ket side derivatives d/dB = -d/dA.");
+    
+    lines.push_back({0, 0, 1, label});
+    
+    for (const auto& label : _get_distributor_str(use_rs))
+    {
+        lines.push_back({0, 0, 1, label});
+    }
+    
+    for (const auto& label : _get_gto_blocks_str(integral))
+    {
+        lines.push_back({0, 0, 1, label});
+    }
+    
+    for (const auto& label : _get_indices_str())
+    {
+        lines.push_back({0, 0, 1, label});
+    }
+    
+    ost::write_code_lines(fstream, lines);
+}
+
+void
+T2CDocuDriver::write_point_batch_doc_str(      std::ofstream& fstream,
+                                         const I2CIntegral&   integral) const
+{
+    auto lines = VCodeLines();
+    
+    auto label = _get_compute_str(integral, false);
+    
+    label.replace(label.size() - 1, 1, ", computing batches of external Gaussians together in SIMD lanes.");
+    
+    lines.push_back({0, 0, 1, label});
+    
+    for (const auto& label : _get_distributor_str(false))
+    {
+        lines.push_back({0, 0, 1, label});
+    }
+    
+    for (const auto& label : _get_gto_blocks_str(integral))
+    {
+        lines.push_back({0, 0, 1, label});
+    }
+    
+    for (const auto& label : _get_indices_str())
+    {
+        lines.push_back({0, 0, 1, label});
+    }
+    
+    ost::write_code_lines(fstream, lines);
+}
+
 void
 T2CDocuDriver::write_ecp_doc_str(      std::ofstream& fstream,
                                  const I2CIntegral&   integral) const
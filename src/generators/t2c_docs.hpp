@@ -61,6 +61,20 @@ public:
                        const std::pair<bool, bool>& rec_form,
                        const bool                   use_rs) const;
     
+    /// Writes documentation string for gradient compute function.
+    /// @param fstream the file stream.
+    /// @param integral The base two center integral with first order bra side derivative.
+    /// @param use_rs The flag for use of range-separated Coulomb interactions.
+    void write_grad_doc_str(      std::ofstream& fstream,
+                            const I2CIntegral&   integral,
+                            const bool           use_rs) const;
+    
+    /// Writes documentation string for point-batched compute function.
+    /// @param fstream the file stream.
+    /// @param integral The base two center integral.
+    void write_point_batch_doc_str(      std::ofstream& fstream,
+                                   const I2CIntegral&   integral) const;
+    
     /// Writes documentation string for compute function.
     /// @param fstream the file stream.
     /// @param integral The base two center integral.
@@ -17,6 +17,7 @@
 #include "t2c_ecp_body.hpp"
 
 #include "t2c_utils.hpp"
+#include "t2c_ecp_utils.hpp"
 
 void
 T2CECPFuncBodyDriver::write_func_body(      std::ofstream& fstream,
@@ -32,6 +33,8 @@ T2CECPFuncBodyDriver::write_func_body(      std::ofstream& fstream,
         lines.push_back({1, 0, 2, label});
     }
     
+    t2c::add_ecp_data_def(lines);
+    
     for (const auto& label : _get_ket_variables_def(integral))
     {
         lines.push_back({1, 0, 2, label});
@@ -90,14 +93,6 @@ T2CECPFuncBodyDriver::_get_gtos_def() const
 
     vstr.push_back("const auto ket_npgtos = ket_gto_block.number_of_primitives();");
     
-    vstr.push_back("// intialize basic ECP data");
-    
-    vstr.push_back("const auto ecp_nppt = ecp_potential.number_of_primitive_potentials();");
-    
-    vstr.push_back("const auto ecp_exps = ecp_potential.get_exponents();");
-        
-    vstr.push_back("const auto ecp_facts = ecp_potential.get_factors();");
-    
     return vstr;
 }
 
@@ -131,7 +126,7 @@ T2CECPFuncBodyDriver::_get_buffers_def(const SI2CIntegrals& integrals,
     
     for (const auto& tint : integrals)
     {
-        icomps += tint.components<T1CPair, T1CPair>().size();
+        icomps += tint.number_of_components();
     }
     
     auto label = "CSimdArray<double> pbuffer(" + std::to_string(icomps) + ", ket_npgtos);";
@@ -140,7 +135,7 @@ T2CECPFuncBodyDriver::_get_buffers_def(const SI2CIntegrals& integrals,
     
     vstr.push_back("// allocate aligned contracted integrals");
     
-    icomps = integral.components<T1CPair, T1CPair>().size();
+    icomps = integral.number_of_components();
         
     label = "CSimdArray<double> cbuffer(" + std::to_string(icomps) + ", 1);";
     
@@ -423,7 +418,7 @@ T2CECPFuncBodyDriver::_get_position(const I2CIntegral&   integral,
     {
         if (tint == integral) return pos;
         
-        pos += tint.components<T1CPair, T1CPair>().size();
+        pos += tint.number_of_components();
     }
     
     return 0;
@@ -448,7 +443,7 @@ T2CECPFuncBodyDriver::_add_reduce_call_tree(      VCodeLines&    lines,
         
         for (const auto& tint : integrals)
         {
-            icomps += tint.components<T1CPair, T1CPair>().size();
+            icomps += tint.number_of_components();
         }
         
         label += std::to_string(icomps)  + ", ";
@@ -507,6 +502,8 @@ T2CECPFuncBodyDriver::write_func_body(      std::ofstream&      fstream,
         lines.push_back({1, 0, 2, label});
     }
     
+    t2c::add_ecp_data_def(lines);
+    
     for (const auto& label : _get_ket_variables_def(integral))
     {
         lines.push_back({1, 0, 2, label});
@@ -550,12 +547,12 @@ T2CECPFuncBodyDriver::_get_buffers_def(const SI2CIntegrals& integrals,
     
     for (const auto& tint : integrals)
     {
-        icomps += tint.components<T1CPair, T1CPair>().size();
+        icomps += tint.number_of_components();
     }
     
     if (_need_geom_drvs(geom_drvs))
     {
-        icomps += integral.components<T1CPair, T1CPair>().size();
+        icomps += integral.number_of_components();
     }
     
     auto label = "CSimdArray<double> pbuffer(" + std::to_string(icomps) + ", ket_npgtos);";
@@ -564,7 +561,7 @@ T2CECPFuncBodyDriver::_get_buffers_def(const SI2CIntegrals& integrals,
     
     vstr.push_back("// allocate aligned contracted integrals");
     
-    icomps = integral.components<T1CPair, T1CPair>().size();
+    icomps = integral.number_of_components();
     
     label = "CSimdArray<double> cbuffer(" + std::to_string(icomps) + ", 1);";
     
@@ -576,7 +573,7 @@ T2CECPFuncBodyDriver::_get_buffers_def(const SI2CIntegrals& integrals,
         
         icomps = t2c::number_of_spherical_components(angpair);
         
-        icomps *= integral.integrand().components().size();
+        icomps *= integral.integrand().number_of_components();
         
         if (const auto prefixes = integral.prefixes(); !prefixes.empty())
         {
@@ -618,7 +615,7 @@ T2CECPFuncBodyDriver::_add_geom_call_tree(      VCodeLines&         lines,
         
         for (const auto& tint : vrr_integrals)
         {
-            icomps += tint.components<T1CPair, T1CPair>().size();
+            icomps += tint.number_of_components();
         }
         
         label += std::to_string(icomps)  + ", ";
@@ -634,11 +631,11 @@ T2CECPFuncBodyDriver::_add_geom_call_tree(      VCodeLines&         lines,
         }
         else
         {
-            label += std::to_string(integral.integrand().shape().components().size()) + ", ";
+            label += std::to_string(integral.integrand().shape().number_of_components()) + ", ";
             
             if (geom_drvs[2] == 0)
             {
-                label += std::to_string(Tensor(integral[1]).components().size()) + ", ";
+                label += std::to_string(Tensor(integral[1]).number_of_components()) + ", ";
             }
             
             if (geom_drvs[2] > 0) label += "pfactors, ";
@@ -17,6 +17,7 @@
 #include "t2c_ecp_cpu_generators.hpp"
 
 #include <iostream>
+#include <stdexcept>
 
 #include "string_formater.hpp"
 #include "file_stream.hpp"
@@ -65,11 +66,7 @@ T2CECPCPUGenerator::generate(const std::string& label,
     }
     else
     {
-        std::cerr << "*** ERROR *** Unsupported type of two-center ECP integral: ";
-        
-        std::cerr << label << " !!!" << std::endl;
-        
-        std::exit(EXIT_FAILURE);
+        throw std::invalid_argument("Unsupported type of two-center ECP integral: " + label);
     }
 }
 
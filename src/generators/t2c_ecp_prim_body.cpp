@@ -141,7 +141,7 @@ T2CECPPrimFuncBodyDriver::_get_buffers_str(const std::vector<R2CDist>& rec_dists
         
         int index = 0;
         
-        for (const auto& tcomp : tint.components<T1CPair, T1CPair>())
+        for (const auto& tcomp : tint.component_range<T1CPair, T1CPair>())
         {
             if (_find_integral(rec_dists, tcomp))
             {
@@ -0,0 +1,69 @@
+// LITMUS: An Automated Molecular Integrals Generator
+// Copyright 2022 Z. Rinkevicius, KTH, Sweden.
+// E-mail: rinkevic@kth.se
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "t2c_ecp_utils.hpp"
+
+namespace t2c { // t2c namespace
+
+void
+add_ecp_data_def(VCodeLines& lines)
+{
+    lines.push_back({1, 0, 2, "// intialize basic ECP data"});
+
+    lines.push_back({1, 0, 2, "const auto ecp_pexps = ecp_potential.get_exponents();"});
+
+    lines.push_back({1, 0, 2, "const auto ecp_pfacts = ecp_potential.get_factors();"});
+
+    lines.push_back({1, 0, 1, "// merge primitive potentials sharing an exponent: the integrals are linear"});
+
+    lines.push_back({1, 0, 2, "// in the potential factors, so each exponent enters the recursion once"});
+
+    lines.push_back({1, 0, 2, "std::vector<double> ecp_exps;"});
+
+    lines.push_back({1, 0, 2, "std::vector<double> ecp_facts;"});
+
+    lines.push_back({1, 0, 1, "for (size_t i = 0; i < ecp_pexps.size(); i++)"});
+
+    lines.push_back({1, 0, 1, "{"});
+
+    lines.push_back({2, 0, 2, "size_t idx = 0;"});
+
+    lines.push_back({2, 0, 2, "while ((idx < ecp_exps.size()) && (ecp_exps[idx] != ecp_pexps[i])) idx++;"});
+
+    lines.push_back({2, 0, 1, "if (idx == ecp_exps.size())"});
+
+    lines.push_back({2, 0, 1, "{"});
+
+    lines.push_back({3, 0, 2, "ecp_exps.push_back(ecp_pexps[i]);"});
+
+    lines.push_back({3, 0, 1, "ecp_facts.push_back(ecp_pfacts[i]);"});
+
+    lines.push_back({2, 0, 1, "}"});
+
+    lines.push_back({2, 0, 1, "else"});
+
+    lines.push_back({2, 0, 1, "{"});
+
+    lines.push_back({3, 0, 1, "ecp_facts[idx] += ecp_pfacts[i];"});
+
+    lines.push_back({2, 0, 1, "}"});
+
+    lines.push_back({1, 0, 2, "}"});
+
+    lines.push_back({1, 0, 2, "const auto ecp_nppt = ecp_exps.size();"});
+}
+
+} // t2c namespace
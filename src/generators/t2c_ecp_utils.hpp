@@ -0,0 +1,31 @@
+// LITMUS: An Automated Molecular Integrals Generator
+// Copyright 2022 Z. Rinkevicius, KTH, Sweden.
+// E-mail: rinkevic@kth.se
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef t2c_ecp_utils_hpp
+#define t2c_ecp_utils_hpp
+
+#include "file_stream.hpp"
+
+namespace t2c { // t2c namespace
+
+/// Adds ECP data definitions, merging primitive potentials with equal
+/// exponents, to code lines container.
+/// @param lines The code lines container to which ECP data definitions are added.
+void add_ecp_data_def(VCodeLines& lines);
+
+} // t2c namespace
+
+#endif /* t2c_ecp_utils_hpp */
@@ -23,9 +23,9 @@ T2CGeomFuncBodyDriver::write_func_body(      std::ofstream& fstream,
     
     const auto ncomps = static_cast<int>(components.size());
     
-    auto bcomps = static_cast<int>(Tensor(integral[0]).components().size());
+    auto bcomps = static_cast<int>(Tensor(integral[0]).number_of_components());
     
-    auto kcomps = static_cast<int>(Tensor(integral[1]).components().size());
+    auto kcomps = static_cast<int>(Tensor(integral[1]).number_of_components());
     
     std::vector<R2CDist> rec_dists;
 
@@ -221,13 +221,13 @@ T2CGeomFuncBodyDriver::_get_buffers_str(const std::vector<R2CDist>& rec_dists,
         
         int index = 0;
         
-        for (const auto& tcomp : tint.components<T1CPair, T1CPair>())
+        for (const auto& tcomp : tint.component_range<T1CPair, T1CPair>())
         {
             auto line = "auto " + _get_component_label(tcomp) + " = pbuffer.data(" + t2c::get_index_label(tint);
             
-            const auto bcomps = Tensor(tint[0]).components().size();
+            const auto bcomps = Tensor(tint[0]).number_of_components();
             
-            const auto kcomps = Tensor(tint[1]).components().size();
+            const auto kcomps = Tensor(tint[1]).number_of_components();
             
             if (integral.prefixes()[1].shape().order() == 0)
             {
@@ -270,9 +270,9 @@ T2CGeomFuncBodyDriver::_get_buffers_str(const I2CIntegral&        integral,
                        " components of targeted buffer : " + integral.label());
     }
     
-    const auto bcomps = static_cast<int>(Tensor(integral[0]).components().size());
+    const auto bcomps = static_cast<int>(Tensor(integral[0]).number_of_components());
     
-    const auto kcomps = static_cast<int>(Tensor(integral[1]).components().size());
+    const auto kcomps = static_cast<int>(Tensor(integral[1]).number_of_components());
     
     for (int i = rec_range[0]; i < rec_range[1]; i++)
     {
@@ -17,6 +17,7 @@
 #include "t2c_geom_cpu_generators.hpp"
 
 #include <iostream>
+#include <stdexcept>
 
 #include "v2i_center_driver.hpp"
 #include "v2i_ovl_driver.hpp"
@@ -41,21 +42,32 @@ T2CGeomCPUGenerator::generate(const std::string&           label,
                               const int                    max_ang_mom,
                               const std::array<int, 3>&    geom_drvs,
                               const std::pair<bool, bool>& rec_form,
-                              const bool                   use_rs) const
+                              const bool                   use_rs,
+                              const int                    prim_screening,
+                              const bool                   trans_inv) const
 {
     if (_is_available(label))
     {
+        if (trans_inv && (!_is_trans_invariant(label, geom_drvs)))
+        {
+            throw std::invalid_argument("Translational invariance requires first order bra or ket derivative of overlap, kinetic energy, or electron repulsion integrals: " + label);
+        }
+        
+        // gradient functions compute bra side derivatives and write ket side ones as their negative
+        
+        const auto rec_drvs = (trans_inv) ? std::array<int, 3>({1, 0, 0}) : geom_drvs;
+        
         for (int i = 0; i <= max_ang_mom; i++)
         {
             for (int j = 0; j <= max_ang_mom; j++)
             {
-                const auto integral = _get_integral(label, {i, j}, geom_drvs);
+                const auto integral = _get_integral(label, {i, j}, rec_drvs);
                         
                 const auto geom_integrals = _generate_geom_integral_group(integral);
              
                 const auto vrr_integrals = _generate_vrr_integral_group(integral, geom_integrals);
                        
-                _write_cpp_header(geom_integrals, vrr_integrals, integral, geom_drvs, rec_form, use_rs);
+                _write_cpp_header(geom_integrals, vrr_integrals, integral, rec_drvs, rec_form, use_rs, prim_screening, trans_inv);
                         
                         std::cout << " *** REFERENCE: " << integral.prefix_label() << " | " << integral.label() << std::endl;
                         
@@ -75,11 +87,7 @@ T2CGeomCPUGenerator::generate(const std::string&           label,
     }
     else
     {
-        std::cerr << "*** ERROR *** Unsupported type of two-center integral: ";
-        
-        std::cerr << label << " !!!" << std::endl;
-        
-        std::exit(EXIT_FAILURE);
+        throw std::invalid_argument("Unsupported type of two-center integral: " + label);
     }
 }
 
@@ -180,6 +188,22 @@ T2CGeomCPUGenerator::_get_integral(const std::string&        label,
     return I2CIntegral();
 }
 
+bool
+T2CGeomCPUGenerator::_is_trans_invariant(const std::string&        label,
+                                         const std::array<int, 3>& geom_drvs) const
+{
+    // only integrands without own center are invariant under translation of A and B
+    
+    const auto name = fstr::lowercase(label);
+    
+    if ((name != "overlap") && (name != "kinetic energy") && (name != "electron repulsion"))
+    {
+        return false;
+    }
+    
+    return (geom_drvs[1] == 0) && ((geom_drvs[0] + geom_drvs[2]) == 1);
+}
+
 SI2CIntegrals
 T2CGeomCPUGenerator::_generate_geom_integral_group(const I2CIntegral& integral) const
 {
@@ -306,17 +330,19 @@ T2CGeomCPUGenerator::_write_cpp_header(const SI2CIntegrals& geom_integrals,
                                        const I2CIntegral&   integral,
                                        const std::array<int, 3>&    geom_drvs,
                                        const std::pair<bool, bool>& rec_form,
-                                       const bool                   use_rs) const
+                                       const bool                   use_rs,
+                                       const int                    prim_screening,
+                                       const bool                   trans_inv) const
 {
-    auto fname = _file_name(integral, rec_form, use_rs) + ".hpp";
+    auto fname = _file_name(integral, rec_form, use_rs, trans_inv) + ".hpp";
         
     std::ofstream fstream;
                
     fstream.open(fname.c_str(), std::ios_base::trunc);
     
-    _write_hpp_defines(fstream, integral, rec_form, use_rs, false, true);
+    _write_hpp_defines(fstream, integral, rec_form, use_rs, trans_inv, false, true);
 
-    _write_hpp_includes(fstream, vrr_integrals, integral, geom_drvs, rec_form, use_rs);
+    _write_hpp_includes(fstream, vrr_integrals, integral, geom_drvs, rec_form, use_rs, prim_screening);
 
     _write_namespace(fstream, integral, true);
 
@@ -326,17 +352,26 @@ T2CGeomCPUGenerator::_write_cpp_header(const SI2CIntegrals& geom_integrals,
 
     T2CFuncBodyDriver func_drv;
 
-    docs_drv.write_doc_str(fstream, integral, rec_form, use_rs);
-
-    decl_drv.write_func_decl(fstream, integral, rec_form, use_rs, false);
-
-    func_drv.write_func_body(fstream, geom_integrals, vrr_integrals, integral, geom_drvs, rec_form, use_rs);
+    if (trans_inv)
+    {
+        docs_drv.write_grad_doc_str(fstream, integral, use_rs);
+        
+        decl_drv.write_grad_func_decl(fstream, integral, rec_form, use_rs, false);
+    }
+    else
+    {
+        docs_drv.write_doc_str(fstream, integral, rec_form, use_rs);
+        
+        decl_drv.write_func_decl(fstream, integral, rec_form, use_rs, false);
+    }
+    
+    func_drv.write_func_body(fstream, geom_integrals, vrr_integrals, integral, geom_drvs, rec_form, use_rs, prim_screening, trans_inv);
 
     fstream << std::endl;
 
     _write_namespace(fstream, integral, false);
 
-    _write_hpp_defines(fstream, integral, rec_form, use_rs, false, false);
+    _write_hpp_defines(fstream, integral, rec_form, use_rs, trans_inv, false, false);
     
     fstream.close();
 }
@@ -344,7 +379,8 @@ T2CGeomCPUGenerator::_write_cpp_header(const SI2CIntegrals& geom_integrals,
 std::string
 T2CGeomCPUGenerator::_file_name(const I2CIntegral&           integral,
                                 const std::pair<bool, bool>& rec_form,
-                                const bool                   use_rs) const
+                                const bool                   use_rs,
+                                const bool                   trans_inv) const
 {
     std::string label = (use_rs) ? "ErfRec" : "Rec";
     
@@ -354,7 +390,11 @@ T2CGeomCPUGenerator::_file_name(const I2CIntegral&           integral,
     
     if (rec_form.second) label = "Conv" + label;
     
-    return t2c::integral_label(integral) + label;
+    auto ilabel = t2c::integral_label(integral);
+    
+    if (trans_inv) ilabel = ilabel.substr(0, ilabel.rfind("Geom")) + "GeomGrad";
+    
+    return ilabel + label;
 }
 
 void
@@ -362,10 +402,11 @@ T2CGeomCPUGenerator::_write_hpp_defines(      std::ofstream&         fstream,
                                         const I2CIntegral&           integral,
                                         const std::pair<bool, bool>& rec_form,
                                         const bool                   use_rs,
+                                        const bool                   trans_inv,
                                         const bool                   is_prim_rec,
                                         const bool                   start) const
 {
-    auto fname = (is_prim_rec) ? t2c::prim_file_name(integral) : _file_name(integral, rec_form, use_rs) + "_hpp";
+    auto fname = (is_prim_rec) ? t2c::prim_file_name(integral) : _file_name(integral, rec_form, use_rs, trans_inv) + "_hpp";
     
     auto lines = VCodeLines();
  
@@ -389,10 +430,16 @@ T2CGeomCPUGenerator::_write_hpp_includes(      std::ofstream&         fstream,
                                          const I2CIntegral&           integral,
                                          const std::array<int, 3>&    geom_drvs,
                                          const std::pair<bool, bool>& rec_form,
-                                         const bool                   use_rs) const
+                                         const bool                   use_rs,
+                                         const int                    prim_screening) const
 {
     auto lines = VCodeLines();
     
+    if (prim_screening > 0)
+    {
+        lines.push_back({0, 0, 1, "#include <cmath>"});
+    }
+    
     lines.push_back({0, 0, 1, "#include <cstddef>"});
     
     lines.push_back({0, 0, 1, "#include <array>"});
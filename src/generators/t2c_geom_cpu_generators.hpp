@@ -42,6 +42,14 @@ class T2CGeomCPUGenerator
                               const std::array<int, 2>& ang_moms,
                               const std::array<int, 3>& geom_drvs) const;
     
+    /// Checks if first order derivatives of two-center integral satisfy translational invariance
+    /// sum rule d/dA + d/dB = 0, i.e. integrand has no center of its own.
+    /// @param label The label of requested two-center integral.
+    /// @param geom_drvs The geometrical derivative of bra side, integrand, and  ket side.
+    /// @return True if ket side derivatives can be obtained from bra side ones, False otherwise.
+    bool _is_trans_invariant(const std::string&        label,
+                             const std::array<int, 3>& geom_drvs) const;
+    
     /// Generates set of integrals required for geometrical derivatives.
     /// @param integral The base four center integral.
     /// @return The set of integrals.
@@ -61,33 +69,41 @@ class T2CGeomCPUGenerator
     /// @param geom_drvs The geometrical derivative of bra side, integrand, and  ket side.
     /// @param rec_form The recursion form for two center integrals (summation, convolution flags).
     /// @param use_rs The flag for use of range-separated Coulomb interactions.
+    /// @param prim_screening The primitive pairs screening threshold exponent (0 disables screening).
+    /// @param trans_inv The flag to write gradient function with ket side derivatives d/dB = -d/dA.
     void _write_cpp_header(const SI2CIntegrals& geom_integrals,
                            const SI2CIntegrals& vrr_integrals,
                            const I2CIntegral&   integral,
                            const std::array<int, 3>&    geom_drvs,
                            const std::pair<bool, bool>& rec_form,
-                           const bool                   use_rs) const;
+                           const bool                   use_rs,
+                           const int                    prim_screening,
+                           const bool                   trans_inv) const;
     
     /// Gets file name of file with recursion functions for two center integral.
     /// @param integral The base two center integral.
     /// @param rec_form The recursion form for two center integrals (summation, convolution flags).
     /// @param use_rs The flag for use of range-separated Coulomb interactions.
+    /// @param trans_inv The flag for gradient function with ket side derivatives d/dB = -d/dA.
     /// @return The file name.
     std::string _file_name(const I2CIntegral&           integral,
                            const std::pair<bool, bool>& rec_form,
-                           const bool                   use_rs) const;
+                           const bool                   use_rs,
+                           const bool                   trans_inv) const;
     
     /// Writes definitions of define for header file.
     /// @param fstream the file stream.
     /// @param integral The base two center integral.
     /// @param rec_form The recursion form for two center integrals (summation, convolution flags).
     /// @param use_rs The flag for use of range-separated Coulomb interactions.
+    /// @param trans_inv The flag for gradient function with ket side derivatives d/dB = -d/dA.
     /// @param is_prim_rec The flag to indicate primitive recurion.
     /// @param start The flag to indicate position of define (start or end).
     void _write_hpp_defines(      std::ofstream&         fstream,
                             const I2CIntegral&           integral,
                             const std::pair<bool, bool>& rec_form,
                             const bool                   use_rs,
+                            const bool                   trans_inv,
                             const bool                   is_prim_rec,
                             const bool                   start) const;
     
@@ -97,12 +113,14 @@ class T2CGeomCPUGenerator
     /// @param integral The base two center integral.
     /// @param rec_form The recursion form for two center integrals (summation, convolution flags).
     /// @param use_rs The flag for use of range-separated Coulomb interactions.
+    /// @param prim_screening The primitive pairs screening threshold exponent (0 disables screening).
     void _write_hpp_includes(      std::ofstream&         fstream,
                              const SI2CIntegrals&         integrals,
                              const I2CIntegral&           integral,
                              const std::array<int, 3>&    geom_drvs,
                              const std::pair<bool, bool>& rec_form,
-                             const bool                   use_rs) const;
+                             const bool                   use_rs,
+                             const int                    prim_screening) const;
     
     /// Writes namespace definition to file stream.
     /// @param fstream the file stream.
@@ -122,11 +140,16 @@ public:
     /// @param geom_drvs The geometrical derivative of bra side, integrand, and  ket side.
     /// @param rec_form The recursion form for two center integrals (summation, convolution flags).
     /// @param use_rs The flag for use of range-separated Coulomb interactions.
+    /// @param prim_screening The primitive pairs screening threshold exponent n, i.e. threshold 10^-n (0 disables screening).
+    /// @param trans_inv The flag to write gradient functions, computing first order bra side derivatives
+    ///                  once and ket side ones as their negative by translational invariance.
     void generate(const std::string&           label,
                   const int                    max_ang_mom,
                   const std::array<int, 3>&    geom_drvs,
                   const std::pair<bool, bool>& rec_form,
-                  const bool                   use_rs) const;
+                  const bool                   use_rs,
+                  const int                    prim_screening,
+                  const bool                   trans_inv) const;
 };
 
 #endif /* t2c_geom_cpu_generators_hpp */
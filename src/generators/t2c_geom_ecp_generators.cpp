@@ -17,6 +17,8 @@
 
 #include "t2c_geom_ecp_generators.hpp"
 
+#include <stdexcept>
+
 #include "string_formater.hpp"
 #include "v2i_center_driver.hpp"
 #include "v2i_translation_driver.hpp"
@@ -64,11 +66,7 @@ T2CECPGeomCPUGenerator::generate(const std::string&        label,
     }
     else
     {
-        std::cerr << "*** ERROR *** Unsupported type of two-center integral: ";
-        
-        std::cerr << label << " !!!" << std::endl;
-        
-        std::exit(EXIT_FAILURE);
+        throw std::invalid_argument("Unsupported type of two-center integral: " + label);
     }
 }
 
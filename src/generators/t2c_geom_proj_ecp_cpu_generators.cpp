@@ -17,6 +17,7 @@
 #include "t2c_geom_proj_ecp_cpu_generators.hpp"
 
 #include <iostream>
+#include <stdexcept>
 
 #include "string_formater.hpp"
 #include "v2i_center_driver.hpp"
@@ -81,11 +82,7 @@ T2CGeomProjECPCPUGenerator::generate(const std::string&        label,
     }
     else
     {
-        std::cerr << "*** ERROR *** Unsupported type of two-center ECP integral: ";
-        
-        std::cerr << label << " !!!" << std::endl;
-        
-        std::exit(EXIT_FAILURE);
+        throw std::invalid_argument("Unsupported type of two-center ECP integral: " + label);
     }
 }
 
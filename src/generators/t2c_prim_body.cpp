@@ -38,6 +38,21 @@
 void
 T2CPrimFuncBodyDriver::write_func_body(      std::ofstream& fstream,
                                        const I2CIntegral&   integral) const
+{
+    _write_func_body(fstream, integral, false);
+}
+
+void
+T2CPrimFuncBodyDriver::write_point_batch_func_body(      std::ofstream& fstream,
+                                                   const I2CIntegral&   integral) const
+{
+    _write_func_body(fstream, integral, true);
+}
+
+void
+T2CPrimFuncBodyDriver::_write_func_body(      std::ofstream& fstream,
+                                        const I2CIntegral&   integral,
+                                        const bool           point_batch) const
 {
     auto lines = VCodeLines();
     
@@ -50,6 +65,13 @@ T2CPrimFuncBodyDriver::write_func_body(      std::ofstream& fstream,
         lines.push_back({1, 0, 2, label});
     }
     
+    if (point_batch)
+    {
+        lines.push_back({1, 0, 2, "// Set up exponents of external Gaussians"});
+        
+        lines.push_back({1, 0, 2, "auto c_exps = factors.data(idx_cexps);"});
+    }
+    
     const auto components = integral.components<T1CPair, T1CPair>();
     
     const auto ncomps = static_cast<int>(components.size());
@@ -79,7 +101,7 @@ T2CPrimFuncBodyDriver::write_func_body(      std::ofstream& fstream,
             lines.push_back({1, 0, 2, label});
         }
         
-        _add_recursion_loop(lines, integral, components, rec_range);
+        _add_recursion_loop(lines, integral, components, rec_range, point_batch);
     }
     else
     {
@@ -94,7 +116,7 @@ T2CPrimFuncBodyDriver::write_func_body(      std::ofstream& fstream,
                 lines.push_back({1, 0, 2, label});
             }
             
-            _add_recursion_loop(lines, integral, components, {i * kcomps, (i + 1) * kcomps});
+            _add_recursion_loop(lines, integral, components, {i * kcomps, (i + 1) * kcomps}, point_batch);
             
             if (i < (ncomps - 1))  lines.push_back({0, 0, 1, ""});;
         }
@@ -221,7 +243,7 @@ T2CPrimFuncBodyDriver::_get_buffers_str(const std::vector<R2CDist>& rec_dists,
         
         int index = 0;
         
-        for (const auto& tcomp : tint.components<T1CPair, T1CPair>())
+        for (const auto& tcomp : tint.component_range<T1CPair, T1CPair>())
         {
             //if (_find_integral(rec_dists, tcomp))
             {
@@ -357,7 +379,8 @@ void
 T2CPrimFuncBodyDriver::_add_recursion_loop(      VCodeLines&         lines,
                                            const I2CIntegral&        integral,
                                            const VT2CIntegrals&      components,
-                                           const std::array<int, 2>& rec_range) const
+                                           const std::array<int, 2>& rec_range,
+                                           const bool                point_batch) const
 {
     std::vector<R2CDist> rec_dists;
     
@@ -368,7 +391,7 @@ T2CPrimFuncBodyDriver::_add_recursion_loop(      VCodeLines&         lines,
     
     // set up recursion loop
     
-    const auto var_str = _get_pragma_str(integral, rec_dists);
+    const auto var_str = _get_pragma_str(integral, rec_dists, point_batch);
     
     lines.push_back({1, 0, 1, "#pragma omp simd aligned(" + var_str + " : 64)"});
     
@@ -376,7 +399,7 @@ T2CPrimFuncBodyDriver::_add_recursion_loop(      VCodeLines&         lines,
     
     lines.push_back({1, 0, 1, "{"});
     
-    _get_factor_lines(lines, rec_dists); 
+    _get_factor_lines(lines, rec_dists, point_batch);
     
     for (size_t i = 0; i < rec_dists.size(); i++)
     {
@@ -396,7 +419,8 @@ T2CPrimFuncBodyDriver::_add_recursion_loop(      VCodeLines&         lines,
 
 std::string
 T2CPrimFuncBodyDriver::_get_pragma_str(const I2CIntegral&          integral,
-                                       const std::vector<R2CDist>& rec_distributions) const
+                                       const std::vector<R2CDist>& rec_distributions,
+                                       const bool                  point_batch) const
 {
     std::set<std::string> tlabels;
     
@@ -438,6 +462,8 @@ T2CPrimFuncBodyDriver::_get_pragma_str(const I2CIntegral&          integral,
         label += tlabel + ", ";
     }
     
+    if (point_batch) label += "c_exps, ";
+    
     if (_need_exponents(integral)) label += "b_exps";
     
     if (label[label.size() - 2] == ',') label.erase(label.end() - 2);
@@ -448,7 +474,8 @@ T2CPrimFuncBodyDriver::_get_pragma_str(const I2CIntegral&          integral,
 // MR: Possibly change for new integral cases
 void
 T2CPrimFuncBodyDriver::_get_factor_lines(                VCodeLines& lines,
-                                         const std::vector<R2CDist>& rec_distributions) const
+                                         const std::vector<R2CDist>& rec_distributions,
+                                         const bool                  point_batch) const
 {
     std::set<std::string> tlabels;
     
@@ -496,7 +523,7 @@ T2CPrimFuncBodyDriver::_get_factor_lines(                VCodeLines& lines,
     
     if (std::find(tlabels.begin(), tlabels.end(), "tce_0") !=  tlabels.end())
     {
-        lines.push_back({2, 0, 2, "const double tce_0 = c_exp;"});
+        lines.push_back({2, 0, 2, (point_batch) ? "const double tce_0 = c_exps[i];" : "const double tce_0 = c_exp;"});
     }
     
     if (std::find(tlabels.begin(), tlabels.end(), "rgc2_0") !=  tlabels.end())
@@ -540,7 +567,14 @@ T2CPrimFuncBodyDriver::_get_factor_lines(                VCodeLines& lines,
     
     if (std::find(tlabels.begin(), tlabels.end(), "gfe_0") !=  tlabels.end())
     {
-        lines.push_back({2, 0, 2, "const double gfe_0 = 0.5 / (a_exp + b_exps[i] + c_exp);"});
+        if (point_batch)
+        {
+            lines.push_back({2, 0, 2, "const double gfe_0 = 0.5 / (a_exp + b_exps[i] + c_exps[i]);"});
+        }
+        else
+        {
+            lines.push_back({2, 0, 2, "const double gfe_0 = 0.5 / (a_exp + b_exps[i] + c_exp);"});
+        }
     }
     
     if (std::find(tlabels.begin(), tlabels.end(), "gfe2_0") !=  tlabels.end())
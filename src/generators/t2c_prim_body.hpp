@@ -72,23 +72,37 @@ class T2CPrimFuncBodyDriver
     /// @param integral The base two center integral.
     /// @param components The vector of integral components.
     /// @param rec_range The recursion range [first, last) in integral components space.
+    /// @param point_batch The flag to read exponents of external Gaussians per element.
     void _add_recursion_loop(      VCodeLines&         lines,
                              const I2CIntegral&        integral,
                              const VT2CIntegrals&      components,
-                             const std::array<int, 2>& rec_range) const;
+                             const std::array<int, 2>& rec_range,
+                             const bool                point_batch) const;
     
     
     /// Adds single loop computation of primitive integrals.
     /// @param lines The code lines container to which loop start definition are added.
     /// @param rec_distributions The recursion distributions.
+    /// @param point_batch The flag to read exponents of external Gaussians per element.
     void _get_factor_lines(                VCodeLines& lines,
-                           const std::vector<R2CDist>& rec_distributions) const;
+                           const std::vector<R2CDist>& rec_distributions,
+                           const bool                  point_batch) const;
     
     /// Gets pragma string for vector of recursion distributions.
     /// @param integral The base two center integral.
     /// @param rec_distributions The recursion distributions.
+    /// @param point_batch The flag to read exponents of external Gaussians per element.
     std::string _get_pragma_str(const I2CIntegral&          integral,
-                                const std::vector<R2CDist>& rec_distributions) const;
+                                const std::vector<R2CDist>& rec_distributions,
+                                const bool                  point_batch) const;
+    
+    /// Writes body of primitive compute function.
+    /// @param fstream the file stream.
+    /// @param integral The base two center integral.
+    /// @param point_batch The flag to read exponents of external Gaussians per element.
+    void _write_func_body(      std::ofstream& fstream,
+                          const I2CIntegral&   integral,
+                          const bool           point_batch) const;
     
     /// Computes VRR recursion for integral component.
     /// @param integral The base two center integral component.
@@ -141,6 +155,13 @@ public:
     /// @param integral The base two center integral.
     void write_func_body(      std::ofstream& fstream,
                          const I2CIntegral&   integral) const;
+    
+    /// Writes body of point-batched primitive compute function, which reads exponents of
+    /// external Gaussians per element instead of single exponent.
+    /// @param fstream the file stream.
+    /// @param integral The base two center integral.
+    void write_point_batch_func_body(      std::ofstream& fstream,
+                                     const I2CIntegral&   integral) const;
 };
 
 #endif /* t2c_prim_body_hpp */
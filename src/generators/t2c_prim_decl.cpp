@@ -28,20 +28,50 @@ T2CPrimDeclDriver::write_func_decl(      std::ofstream&         fstream,
     
     lines.push_back({0, 0, 1, "auto"});
     
-    for (const auto& label : _get_buffers_str(integral))
+    for (const auto& label : _get_buffers_str(integral, false))
     {
         lines.push_back({0, 0, 1, label});
     }
     
     if (integral.is_simple())
     {
-        for (const auto& label : _get_coordinates_str(integral, terminus))
+        for (const auto& label : _get_coordinates_str(integral, terminus, false))
         {
             lines.push_back({0, 0, 1, label});
         }
     }
     
-    for (const auto& label : _get_recursion_variables_str(integral, terminus))
+    for (const auto& label : _get_recursion_variables_str(integral, terminus, false))
+    {
+        lines.push_back({0, 0, 1, label});
+    }
+        
+    ost::write_code_lines(fstream, lines);
+}
+
+void
+T2CPrimDeclDriver::write_point_batch_func_decl(      std::ofstream& fstream,
+                                               const I2CIntegral&   integral,
+                                               const bool           terminus) const
+{
+    auto lines = VCodeLines();
+    
+    lines.push_back({0, 0, 1, "auto"});
+    
+    for (const auto& label : _get_buffers_str(integral, true))
+    {
+        lines.push_back({0, 0, 1, label});
+    }
+    
+    if (integral.is_simple())
+    {
+        for (const auto& label : _get_coordinates_str(integral, terminus, true))
+        {
+            lines.push_back({0, 0, 1, label});
+        }
+    }
+    
+    for (const auto& label : _get_recursion_variables_str(integral, terminus, true))
     {
         lines.push_back({0, 0, 1, label});
     }
@@ -66,13 +96,13 @@ T2CPrimDeclDriver::write_func_decl(      std::ofstream& fstream,
     
     if (integral.second.is_simple())
     {
-        for (const auto& label : _get_coordinates_str(integral.second, terminus))
+        for (const auto& label : _get_coordinates_str(integral.second, terminus, false))
         {
             lines.push_back({0, 0, 1, label});
         }
     }
     
-    for (const auto& label : _get_recursion_variables_str(integral.second, terminus))
+    for (const auto& label : _get_recursion_variables_str(integral.second, terminus, false))
     {
         lines.push_back({0, 0, 1, label});
     }
@@ -81,11 +111,12 @@ T2CPrimDeclDriver::write_func_decl(      std::ofstream& fstream,
 }
 
 std::vector<std::string>
-T2CPrimDeclDriver::_get_buffers_str(const I2CIntegral& integral) const
+T2CPrimDeclDriver::_get_buffers_str(const I2CIntegral& integral,
+                                    const bool         point_batch) const
 {
     std::vector<std::string> vstr;
     
-    auto name = t2c::prim_compute_func_name(integral) + "(";
+    auto name = _get_func_name(integral, point_batch) + "(";
     
     const auto spacer = std::string(name.size(), ' ');
     
@@ -152,13 +183,14 @@ T2CPrimDeclDriver::_get_buffers_str(const M2Integral& integral) const
 
 std::vector<std::string>
 T2CPrimDeclDriver::_get_coordinates_str(const I2CIntegral& integral,
-                                        const bool         terminus) const
+                                        const bool         terminus,
+                                        const bool         point_batch) const
 {
     std::vector<std::string> vstr;
     
     const auto tsymbol = (terminus) ? ";" : "";
     
-    auto name = t2c::prim_compute_func_name(integral) + "(";
+    auto name = _get_func_name(integral, point_batch) + "(";
     
     auto spacer = std::string(name.size(), ' ');
     
@@ -273,7 +305,8 @@ T2CPrimDeclDriver::_get_coordinates_str(const I2CIntegral& integral,
 
 std::vector<std::string>
 T2CPrimDeclDriver::_get_recursion_variables_str(const I2CIntegral& integral,
-                                                const bool         terminus) const
+                                                const bool         terminus,
+                                                const bool         point_batch) const
 {
     std::vector<std::string> vstr;
     
@@ -281,7 +314,7 @@ T2CPrimDeclDriver::_get_recursion_variables_str(const I2CIntegral& integral,
     
     const auto tsymbol = (terminus) ? ";" : "";
     
-    auto name = t2c::prim_compute_func_name(integral) + "(";
+    auto name = _get_func_name(integral, point_batch) + "(";
     
     auto spacer = std::string(name.size(), ' ');
     
@@ -319,7 +352,14 @@ T2CPrimDeclDriver::_get_recursion_variables_str(const I2CIntegral& integral,
             {
                 vstr.push_back(spacer + "const double a_exp,");
                 
-                vstr.push_back(spacer + "const double c_exp) -> void" + tsymbol);
+                if (point_batch)
+                {
+                    vstr.push_back(spacer + "const size_t idx_cexps) -> void" + tsymbol);
+                }
+                else
+                {
+                    vstr.push_back(spacer + "const double c_exp) -> void" + tsymbol);
+                }
             }
             else
             {
@@ -336,6 +376,13 @@ T2CPrimDeclDriver::_get_recursion_variables_str(const I2CIntegral& integral,
     return vstr;
 }
 
+std::string
+T2CPrimDeclDriver::_get_func_name(const I2CIntegral& integral,
+                                  const bool         point_batch) const
+{
+    return (point_batch) ? t2c::point_batch_prim_compute_func_name(integral) : t2c::prim_compute_func_name(integral);
+}
+
 bool
 T2CPrimDeclDriver::_need_exponents(const I2CIntegral& integral) const
 {
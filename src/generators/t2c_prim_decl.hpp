@@ -29,8 +29,10 @@ class T2CPrimDeclDriver
 {
     /// Generates vector of buffer strings.
     /// @param integral The base two center integral.
+    /// @param point_batch The flag for point-batched primitive compute function.
     /// @return The vector of buffer strings.
-    std::vector<std::string> _get_buffers_str(const I2CIntegral& integral) const;
+    std::vector<std::string> _get_buffers_str(const I2CIntegral& integral,
+                                              const bool         point_batch) const;
     
     /// Generates vector of buffer strings.
     /// @param integral The base two center integral.
@@ -40,16 +42,28 @@ class T2CPrimDeclDriver
     /// Generates vector of coordinates strings.
     /// @param integral The base two center integral.
     /// @param terminus The flag to add termination symbol.
+    /// @param point_batch The flag for point-batched primitive compute function.
     /// @return The vector of coordinates strings.
     std::vector<std::string> _get_coordinates_str(const I2CIntegral& integral,
-                                                  const bool         terminus) const;
+                                                  const bool         terminus,
+                                                  const bool         point_batch) const;
     
-    /// Generates vector of recursion variables strings.
+    /// Generates vector of recursion variables strings. Point-batched primitive compute functions
+    /// take index of external Gaussians exponents in primitive factors instead of single exponent.
     /// @param integral The base two center integral.
     /// @param terminus The flag to add termination symbol.
+    /// @param point_batch The flag for point-batched primitive compute function.
     /// @return The vector of recursion variables strings.
     std::vector<std::string> _get_recursion_variables_str(const I2CIntegral& integral,
-                                                          const bool         terminus) const;
+                                                          const bool         terminus,
+                                                          const bool         point_batch) const;
+    
+    /// Gets name of primitive compute function.
+    /// @param integral The base two center integral.
+    /// @param point_batch The flag for point-batched primitive compute function.
+    /// @return The primitive compute function name.
+    std::string _get_func_name(const I2CIntegral& integral,
+                               const bool         point_batch) const;
     
     /// Checks if GTOs exponents are needed for recursion implementation.
     /// @param integral The base two center integral component.
@@ -79,6 +93,14 @@ public:
     void write_func_decl(      std::ofstream& fstream,
                          const M2Integral&    integral,
                          const bool           terminus) const;
+    
+    /// Writes declaration for point-batched primitive compute function of three-center overlap like integral.
+    /// @param fstream the file stream.
+    /// @param integral The base two center integral.
+    /// @param terminus The flag to add termination symbol.
+    void write_point_batch_func_decl(      std::ofstream& fstream,
+                                     const I2CIntegral&   integral,
+                                     const bool           terminus) const;
 };
 
 #endif /* t2c_prim_decl_hpp */
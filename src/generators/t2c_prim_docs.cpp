@@ -39,7 +39,33 @@ T2CPrimDocuDriver::write_doc_str(      std::ofstream& fstream,
         lines.push_back({0, 0, 1, label});
     }
     
-    for (const auto& label : _get_recursion_variables_str(integral))
+    for (const auto& label : _get_recursion_variables_str(integral, false))
+    {
+        lines.push_back({0, 0, 1, label});
+    }
+    
+    ost::write_code_lines(fstream, lines);
+}
+
+void
+T2CPrimDocuDriver::write_point_batch_doc_str(      std::ofstream& fstream,
+                                             const I2CIntegral&   integral) const
+{
+    auto lines = VCodeLines();
+    
+    lines.push_back({0, 0, 1, _get_compute_str(integral)});
+    
+    for (const auto& label : _get_buffers_str(integral))
+    {
+        lines.push_back({0, 0, 1, label});
+    }
+    
+    for (const auto& label : _get_coordinates_str(integral))
+    {
+        lines.push_back({0, 0, 1, label});
+    }
+    
+    for (const auto& label : _get_recursion_variables_str(integral, true))
     {
         lines.push_back({0, 0, 1, label});
     }
@@ -67,7 +93,7 @@ T2CPrimDocuDriver::write_doc_str(      std::ofstream& fstream,
         lines.push_back({0, 0, 1, label});
     }
     
-    for (const auto& label : _get_recursion_variables_str(integral.second))
+    for (const auto& label : _get_recursion_variables_str(integral.second, false))
     {
         lines.push_back({0, 0, 1, label});
     }
@@ -271,7 +297,8 @@ T2CPrimDocuDriver::_get_coordinates_str(const I2CIntegral& integral) const
 }
 
 std::vector<std::string>
-T2CPrimDocuDriver::_get_recursion_variables_str(const I2CIntegral& integral) const
+T2CPrimDocuDriver::_get_recursion_variables_str(const I2CIntegral& integral,
+                                                const bool         point_batch) const
 {
     std::vector<std::string> vstr;
     
@@ -297,7 +324,14 @@ T2CPrimDocuDriver::_get_recursion_variables_str(const I2CIntegral& integral) con
             (integral.integrand().name() == "GR.R2(r)")
             )
         {
-            vstr.push_back("/// @param c_exp The primitive basis function exponent on center C.");
+            if (point_batch)
+            {
+                vstr.push_back("/// @param idx_cexps The index of primitive basis function exponents on centers C in primitive factors buffer.");
+            }
+            else
+            {
+                vstr.push_back("/// @param c_exp The primitive basis function exponent on center C.");
+            }
         }
     }
     
@@ -48,8 +48,10 @@ class T2CPrimDocuDriver
     
     /// Generates vector of recursion variables strings.
     /// @param integral The base two center integral.
+    /// @param point_batch The flag for point-batched primitive compute function.
     /// @return The vector of recursion variables strings.
-    std::vector<std::string> _get_recursion_variables_str(const I2CIntegral& integral) const;
+    std::vector<std::string> _get_recursion_variables_str(const I2CIntegral& integral,
+                                                          const bool         point_batch) const;
     
     /// Checks if distances of (P-C) are required for integration.
     /// @param integral The base two center integral.
@@ -76,6 +78,12 @@ public:
     void write_doc_str(      std::ofstream& fstream,
                        const M2Integral&    integral) const;
     
+    /// Writes documentation string for point-batched primtive compute function.
+    /// @param fstream the file stream.
+    /// @param integral The base two center integral.
+    void write_point_batch_doc_str(      std::ofstream& fstream,
+                                   const I2CIntegral&   integral) const;
+    
 };
 
 #endif /* t2c_prim_docs_hpp */
@@ -17,6 +17,8 @@
 #include "t2c_proj_ecp_body.hpp"
 
 #include "t2c_utils.hpp"
+#include "t2c_ecp_utils.hpp"
+#include "tensor.hpp"
 
 void
 T2CProjECPFuncBodyDriver::write_func_body(      std::ofstream&      fstream,
@@ -34,6 +36,8 @@ T2CProjECPFuncBodyDriver::write_func_body(      std::ofstream&      fstream,
         lines.push_back({1, 0, 2, label});
     }
     
+    t2c::add_ecp_data_def(lines);
+    
     for (const auto& label : _get_ket_variables_def(vrr_integrals))
     {
         lines.push_back({1, 0, 2, label});
@@ -96,14 +100,6 @@ T2CProjECPFuncBodyDriver::_get_gtos_def() const
 
     vstr.push_back("const auto ket_npgtos = ket_gto_block.number_of_primitives();");
     
-    vstr.push_back("// intialize basic ECP data");
-    
-    vstr.push_back("const auto ecp_nppt = ecp_potential.number_of_primitive_potentials();");
-    
-    vstr.push_back("const auto ecp_exps = ecp_potential.get_exponents();");
-        
-    vstr.push_back("const auto ecp_facts = ecp_potential.get_factors();");
-    
     return vstr;
 }
 
@@ -173,7 +169,7 @@ T2CProjECPFuncBodyDriver::_get_buffers_def(const SM2Integrals& integrals,
     
     for (const auto& [pref, tint] : integrals)
     {
-        icomps += tint.components<T1CPair, T1CPair>().size();
+        icomps += tint.number_of_components();
     }
     
     auto label = "CSimdArray<double> pbuffer(" + std::to_string(icomps) + ", ket_npgtos);";
@@ -182,7 +178,7 @@ T2CProjECPFuncBodyDriver::_get_buffers_def(const SM2Integrals& integrals,
     
     vstr.push_back("// allocate aligned contracted integrals");
     
-    icomps = integral.second.components<T1CPair, T1CPair>().size();
+    icomps = integral.second.number_of_components();
     
     label = "CSimdArray<double> cbuffer(" + std::to_string(icomps) + ", 1);";
     
@@ -192,13 +188,13 @@ T2CProjECPFuncBodyDriver::_get_buffers_def(const SM2Integrals& integrals,
     
     icomps = t2c::number_of_spherical_components(angpair);
     
-    icomps *= integral.second.integrand().components().size();
+    icomps *= integral.second.integrand().number_of_components();
     
     if (const auto prefixes = integral.second.prefixes(); !prefixes.empty())
     {
         for (const auto& prefix : prefixes)
         {
-            icomps *= prefix.components().size();
+            icomps *= prefix.number_of_components();
         }
     }
     
@@ -234,6 +230,10 @@ T2CProjECPFuncBodyDriver::_add_loop_start(      VCodeLines& lines,
 
     lines.push_back({2, 0, 2, "pfactors.replicate_points(ket_gto_coords, ket_range, 2, ket_npgtos);"});
     
+    lines.push_back({2, 0, 2, "// |B| depends on the ket block only: computed once, not per bra and ECP primitive"});
+    
+    lines.push_back({2, 0, 2, "t2cfunc::comp_coordinates_norm(pfactors, 5, 2);"});
+    
     lines.push_back({2, 0, 2, "// set up active SIMD width"});
     
     lines.push_back({2, 0, 2, "const auto ket_width = ket_range.second - ket_range.first;"});
@@ -265,6 +265,10 @@ T2CProjECPFuncBodyDriver::_add_loop_start(      VCodeLines& lines,
     }
 
     lines.push_back({3, 0, 2, "const auto r_a = bra_gto_coords[j];"});
+    
+    lines.push_back({3, 0, 2, "// Legendre arguments depend on A and B only: shared by all bra and ECP primitives"});
+    
+    lines.push_back({3, 0, 2, "t2cfunc::comp_legendre_args(pfactors, 6, 2, 5, r_a);"});
 }
 
 void
@@ -327,10 +331,6 @@ T2CProjECPFuncBodyDriver::_add_ket_loop_start(      VCodeLines&   lines,
 
     lines.push_back({5, 0, 2, "const auto c_norm = ecp_facts[l];"});
     
-    lines.push_back({5, 0, 2, "t2cfunc::comp_coordinates_norm(pfactors, 5, 2);"});
-                        
-    lines.push_back({5, 0, 2, "t2cfunc::comp_legendre_args(pfactors, 6, 2, 5, r_a);"});
-                        
     lines.push_back({5, 0, 2, "t2cfunc::comp_gamma_factors(pfactors, 7, 5, r_a, a_exp, c_exp);"});
                         
     lines.push_back({5, 0, 2, "t2cfunc::comp_bessel_args(pfactors, 8, 5, r_a, a_exp, c_exp);"});
@@ -365,7 +365,7 @@ T2CProjECPFuncBodyDriver::_add_reduce_call_tree(      VCodeLines&   lines,
         
     label += std::to_string(_get_position(integral, integrals)) + ", ";
         
-    label += std::to_string(integral.second.components<T1CPair, T1CPair>().size()) + ", ";
+    label += std::to_string(integral.second.number_of_components()) + ", ";
         
     label += "ket_width, ket_npgtos);";
         
@@ -382,7 +382,7 @@ T2CProjECPFuncBodyDriver::_get_position(const M2Integral&   integral,
     {
         if (tint == integral) return pos;
         
-        pos += tint.second.components<T1CPair, T1CPair>().size();
+        pos += tint.second.number_of_components();
     }
     
     return 0;
@@ -560,11 +560,11 @@ T2CProjECPFuncBodyDriver::_add_geom_call_tree(      VCodeLines&         lines,
         }
         else
         {
-            label += std::to_string(integral.second.integrand().shape().components().size()) + ", ";
+            label += std::to_string(integral.second.integrand().shape().number_of_components()) + ", ";
             
             if (geom_drvs[2] == 0)
             {
-                label += std::to_string(Tensor(integral.second[1]).components().size()) + ", ";
+                label += std::to_string(Tensor(integral.second[1]).number_of_components()) + ", ";
             }
             
             if (geom_drvs[2] > 0) label += "factors, ";
@@ -581,3 +581,253 @@ T2CProjECPFuncBodyDriver::_need_geom_drvs(const std::array<int, 3>& geom_drvs) c
 {
     return (geom_drvs[0] + geom_drvs[1] + geom_drvs[2]) > 0;
 }
+
+void
+T2CProjECPFuncBodyDriver::write_table_func_body(      std::ofstream& fstream,
+                                                const M2Integral&    integral) const
+{
+    const auto la = integral.second[0];
+    
+    const auto lb = integral.second[1];
+    
+    const auto l = integral.second.order();
+    
+    const auto ncomps = integral.second.number_of_components();
+    
+    const auto nq = (la + lb + 1) * (l + la + 1) * (l + lb + 1);
+    
+    const auto nbra = Tensor(la).number_of_components() * (2 * l + 1) * (la + 1) * (l + la + 1);
+    
+    const auto nket = Tensor(lb).number_of_components() * (2 * l + 1) * (lb + 1) * (l + lb + 1);
+    
+    auto lines = VCodeLines();
+    
+    lines.push_back({0, 0, 1, "{"});
+    
+    for (const auto& label : _get_gtos_def())
+    {
+        lines.push_back({1, 0, 2, label});
+    }
+    
+    t2c::add_ecp_data_def(lines);
+    
+    lines.push_back({1, 0, 2, "// allocate aligned 2D arrays for ket side"});
+    
+    lines.push_back({1, 0, 2, "CSimdArray<double> pfactors(5, ket_npgtos);"});
+    
+    lines.push_back({1, 0, 2, "// allocate radial integrals Q(N, lambda_a, lambda_b)"});
+    
+    lines.push_back({1, 0, 2, "CSimdArray<double> q_values(" + std::to_string(nq) + ", ket_npgtos);"});
+    
+    lines.push_back({1, 0, 2, "// allocate angular projections of bra and ket functions"});
+    
+    lines.push_back({1, 0, 2, "std::vector<double> bra_projs(" + std::to_string(nbra) + ", 0.0);"});
+    
+    lines.push_back({1, 0, 2, "std::vector<double> ket_projs(" + std::to_string(nket) + " * simd::width<double>(), 0.0);"});
+    
+    lines.push_back({1, 0, 2, "// allocate aligned primitive integrals"});
+    
+    lines.push_back({1, 0, 2, "CSimdArray<double> pbuffer(" + std::to_string(ncomps) + ", ket_npgtos);"});
+    
+    lines.push_back({1, 0, 2, "// allocate aligned contracted integrals"});
+    
+    lines.push_back({1, 0, 2, "CSimdArray<double> cbuffer(" + std::to_string(ncomps) + ", 1);"});
+    
+    if ((la + lb) > 0)
+    {
+        const auto nsph = t2c::number_of_spherical_components(std::array<int, 2>({la, lb}));
+        
+        lines.push_back({1, 0, 2, "CSimdArray<double> sbuffer(" + std::to_string(nsph) + ", 1);"});
+    }
+    
+    lines.push_back({1, 0, 2, "// set up ket partitioning"});
+
+    lines.push_back({1, 0, 2, "const auto ket_dim = ket_indices.second - ket_indices.first;"});
+
+    lines.push_back({1, 0, 2, "const auto ket_blocks = batch::number_of_batches(ket_dim, simd::width<double>());"});
+
+    lines.push_back({1, 0, 1, "for (size_t i = 0; i < ket_blocks; i++)"});
+                    
+    lines.push_back({1, 0, 1, "{"});
+    
+    lines.push_back({2, 0, 2, "auto ket_range = batch::batch_range(i, ket_dim, simd::width<double>(), ket_indices.first);"});
+
+    lines.push_back({2, 0, 2, "pfactors.load(ket_gto_exps, ket_range, 0, ket_npgtos);"});
+
+    lines.push_back({2, 0, 2, "pfactors.load(ket_gto_norms, ket_range, 1, ket_npgtos);"});
+
+    lines.push_back({2, 0, 2, "pfactors.replicate_points(ket_gto_coords, ket_range, 2, ket_npgtos);"});
+    
+    lines.push_back({2, 0, 2, "// set up active SIMD width"});
+    
+    lines.push_back({2, 0, 2, "const auto ket_width = ket_range.second - ket_range.first;"});
+    
+    lines.push_back({2, 0, 2, "q_values.set_active_width(ket_width);"});
+    
+    if ((la + lb) > 0)
+    {
+        lines.push_back({2, 0, 2, "sbuffer.set_active_width(ket_width);"});
+    }
+    
+    lines.push_back({2, 0, 2, "cbuffer.set_active_width(ket_width);"});
+    
+    lines.push_back({2, 0, 2, "pbuffer.set_active_width(ket_width);"});
+    
+    lines.push_back({2, 0, 2, "// angular projections depend on B only: computed once per ket block"});
+    
+    lines.push_back({2, 0, 1, "for (size_t n = 0; n < ket_width; n++)"});
+    
+    lines.push_back({2, 0, 1, "{"});
+    
+    lines.push_back({3, 0, 2, "const auto r_b = ket_gto_coords[ket_range.first + n].coordinates();"});
+    
+    lines.push_back({3, 0, 1, "t2pecp::comp_angular_projections<" + std::to_string(lb) + ">(&ket_projs[n * " + std::to_string(nket) + "], " + std::to_string(l) + ", r_b[0], r_b[1], r_b[2]);"});
+    
+    lines.push_back({2, 0, 2, "}"});
+    
+    lines.push_back({2, 0, 2, "// loop over contracted basis functions on bra side"});
+    
+    lines.push_back({2, 0, 1, "for (auto j = bra_indices.first; j < bra_indices.second; j++)"});
+    
+    lines.push_back({2, 0, 1, "{"});
+        
+    lines.push_back({3, 0, 2, "cbuffer.zero();"});
+    
+    if ((la + lb) > 0)
+    {
+        lines.push_back({3, 0, 2, "sbuffer.zero();"});
+    }
+
+    lines.push_back({3, 0, 2, "const auto r_a = bra_gto_coords[j];"});
+    
+    lines.push_back({3, 0, 2, "// angular projections depend on A only: shared by all bra and ECP primitives"});
+    
+    lines.push_back({3, 0, 2, "const auto xyz = r_a.coordinates();"});
+    
+    lines.push_back({3, 0, 2, "t2pecp::comp_angular_projections<" + std::to_string(la) + ">(bra_projs.data(), " + std::to_string(l) + ", xyz[0], xyz[1], xyz[2]);"});
+    
+    lines.push_back({3, 0, 1, "for (size_t k = 0; k < bra_npgtos; k++)"});
+    
+    lines.push_back({3, 0, 1, "{"});
+    
+    lines.push_back({4, 0, 2, "const auto a_exp = bra_gto_exps[k * bra_ncgtos + j];"});
+
+    lines.push_back({4, 0, 2, "const auto a_norm = bra_gto_norms[k * bra_ncgtos + j];"});
+    
+    lines.push_back({4, 0, 1, "for (size_t l = 0; l < ecp_nppt; l++)"});
+    
+    lines.push_back({4, 0, 1, "{"});
+    
+    lines.push_back({5, 0, 2, "const auto c_exp = ecp_exps[l];"});
+
+    lines.push_back({5, 0, 2, "const auto c_norm = ecp_facts[l];"});
+    
+    std::string label = "t2pecp::comp_radial_integrals(q_values, " + std::to_string(la + lb) + ", ";
+    
+    label += std::to_string(l + la) + ", " + std::to_string(l + lb) + ", pfactors, 2, r_a, a_exp, c_exp);";
+    
+    lines.push_back({5, 0, 2, label});
+    
+    _add_table_contraction(lines, integral);
+    
+    lines.push_back({5, 0, 1, "t2cfunc::reduce(cbuffer, 0, pbuffer, 0, " + std::to_string(ncomps) + ", ket_width, ket_npgtos);"});
+    
+    lines.push_back({4, 0, 1, "}"});
+    
+    lines.push_back({3, 0, 2, "}"});
+  
+    _add_loop_end(lines, integral);
+    
+    lines.push_back({0, 0, 1, "}"});
+    
+    ost::write_code_lines(fstream, lines);
+}
+
+void
+T2CProjECPFuncBodyDriver::_add_table_contraction(      VCodeLines& lines,
+                                                 const M2Integral& integral) const
+{
+    const auto la = integral.second[0];
+    
+    const auto lb = integral.second[1];
+    
+    const auto l = integral.second.order();
+    
+    const auto ncart_b = std::to_string(Tensor(lb).number_of_components());
+    
+    const auto nproj = std::to_string(2 * l + 1);
+    
+    const auto nlam_a = std::to_string(l + la + 1);
+    
+    const auto nlam_b = std::to_string(l + lb + 1);
+    
+    const auto nket = std::to_string(Tensor(lb).number_of_components() * (2 * l + 1) * (lb + 1) * (l + lb + 1));
+    
+    lines.push_back({5, 0, 2, "// sum_m sum T_a(m, n_a, lambda_a) T_b(m, n_b, lambda_b) Q(n_a + n_b, lambda_a, lambda_b)"});
+    
+    lines.push_back({5, 0, 2, "const auto nelems = pbuffer.number_of_active_elements();"});
+    
+    lines.push_back({5, 0, 2, "const auto ket_norms = pfactors.data(1);"});
+    
+    lines.push_back({5, 0, 1, "for (size_t a = 0; a < " + std::to_string(Tensor(la).number_of_components()) + "; a++)"});
+    
+    lines.push_back({5, 0, 1, "{"});
+    
+    lines.push_back({6, 0, 1, "for (size_t b = 0; b < " + ncart_b + "; b++)"});
+    
+    lines.push_back({6, 0, 1, "{"});
+    
+    lines.push_back({7, 0, 2, "auto vals = pbuffer.data(a * " + ncart_b + " + b);"});
+    
+    lines.push_back({7, 0, 1, "for (size_t e = 0; e < nelems; e++)"});
+    
+    lines.push_back({7, 0, 1, "{"});
+    
+    lines.push_back({8, 0, 2, "const auto t_b = &ket_projs[(e % ket_width) * " + nket + " + b * " + std::to_string((2 * l + 1) * (lb + 1) * (l + lb + 1)) + "];"});
+    
+    lines.push_back({8, 0, 2, "double fab = 0.0;"});
+    
+    lines.push_back({8, 0, 1, "for (size_t m = 0; m < " + nproj + "; m++)"});
+    
+    lines.push_back({8, 0, 1, "{"});
+    
+    lines.push_back({9, 0, 1, "for (size_t na = 0; na < " + std::to_string(la + 1) + "; na++)"});
+    
+    lines.push_back({9, 0, 1, "{"});
+    
+    lines.push_back({10, 0, 1, "for (size_t ka = 0; ka < " + nlam_a + "; ka++)"});
+    
+    lines.push_back({10, 0, 1, "{"});
+    
+    lines.push_back({11, 0, 2, "const auto t_a = bra_projs[((a * " + nproj + " + m) * " + std::to_string(la + 1) + " + na) * " + nlam_a + " + ka];"});
+    
+    lines.push_back({11, 0, 2, "if (t_a == 0.0) continue;"});
+    
+    lines.push_back({11, 0, 1, "for (size_t nb = 0; nb < " + std::to_string(lb + 1) + "; nb++)"});
+    
+    lines.push_back({11, 0, 1, "{"});
+    
+    lines.push_back({12, 0, 1, "for (size_t kb = 0; kb < " + nlam_b + "; kb++)"});
+    
+    lines.push_back({12, 0, 1, "{"});
+    
+    lines.push_back({13, 0, 1, "fab += t_a * t_b[(m * " + std::to_string(lb + 1) + " + nb) * " + nlam_b + " + kb] * q_values.data(((na + nb) * " + nlam_a + " + ka) * " + nlam_b + " + kb)[e];"});
+    
+    lines.push_back({12, 0, 1, "}"});
+    
+    lines.push_back({11, 0, 1, "}"});
+    
+    lines.push_back({10, 0, 1, "}"});
+    
+    lines.push_back({9, 0, 1, "}"});
+    
+    lines.push_back({8, 0, 2, "}"});
+    
+    lines.push_back({8, 0, 1, "vals[e] = a_norm * c_norm * ket_norms[e] * fab;"});
+    
+    lines.push_back({7, 0, 1, "}"});
+    
+    lines.push_back({6, 0, 1, "}"});
+    
+    lines.push_back({5, 0, 2, "}"});
+}
@@ -130,6 +130,12 @@ class T2CProjECPFuncBodyDriver
                              const M2Integral&         integral,
                              const std::array<int, 3>& geom_drvs) const;
     
+    /// Adds contraction of angular projections with radial integrals to code lines container.
+    /// @param lines The code lines container to which contraction is added.
+    /// @param integral The base two center integral.
+    void _add_table_contraction(      VCodeLines& lines,
+                                const M2Integral& integral) const;
+    
     /// Checks if geometrical derivatives are needed.
     /// @param geom_drvs The geometrical derivative of bra side, integrand, and  ket side.
     bool _need_geom_drvs(const std::array<int, 3>& geom_drvs) const;
@@ -148,6 +154,13 @@ public:
                          const SM2Integrals&       vrr_integrals,
                          const M2Integral&         integral,
                          const std::array<int, 3>& geom_drvs) const;
+    
+    /// Writes body of projected ECP compute function, which reads angular factors from
+    /// angular integral tables instead of running vertical recursion.
+    /// @param fstream the file stream.
+    /// @param integral The base two center integral.
+    void write_table_func_body(      std::ofstream& fstream,
+                               const M2Integral&    integral) const;
 };
 
 #endif /* t2c_proj_ecp_body_hpp */
@@ -16,7 +16,12 @@
 
 #include "t2c_proj_ecp_cpu_generators.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
 #include <iostream>
+#include <sstream>
+#include <stdexcept>
 
 #include "string_formater.hpp"
 #include "file_stream.hpp"
@@ -28,14 +33,19 @@
 #include "t2c_docs.hpp"
 #include "t2c_decl.hpp"
 #include "t2c_proj_ecp_body.hpp"
+#include "spherical_harmonics.hpp"
+#include "tensor.hpp"
 
 void
 T2CProjECPCPUGenerator::generate(const std::string& label,
                                  const int          max_ang_mom,
-                                 const int          proj_ang_mom) const
+                                 const int          proj_ang_mom,
+                                 const bool         angular_tables) const
 {
     if (_is_available(label))
     {
+        if (angular_tables) _write_angular_tables(max_ang_mom, proj_ang_mom);
+        
         #pragma omp parallel
         {
             #pragma omp single nowait
@@ -52,21 +62,10 @@ T2CProjECPCPUGenerator::generate(const std::string& label,
                                 
                                 const auto integrals = _generate_integral_group(integral);
                                 
-                                std::cout << " *** " << integral.second.label() << "_" << integral.second.order() << " *** " << std::endl;
+                                _write_cpp_header(integrals, integral, angular_tables);
                                 
-                                for (const auto& [order, tint] : integrals)
+                                if ((!angular_tables) && ((i + j) > 0))
                                 {
-                                    std::cout << "> " << tint.label() << "_" << tint.order() << " : " ;
-                                    
-                                    std::cout << "(" << order[0] << ",";
-                                    
-                                    std::cout << order[1] << ","  << order[2] << ")" << std::endl;
-                                }
-                                
-                                if ((i + j) > 0)
-                                {
-                                    //_write_cpp_header(integrals, integral);
-                                    
                                     _write_prim_cpp_header(integral);
                                     
                                     _write_prim_cpp_file(integral);
@@ -80,11 +79,7 @@ T2CProjECPCPUGenerator::generate(const std::string& label,
     }
     else
     {
-        std::cerr << "*** ERROR *** Unsupported type of two-center ECP integral: ";
-        
-        std::cerr << label << " !!!" << std::endl;
-        
-        std::exit(EXIT_FAILURE);
+        throw std::invalid_argument("Unsupported type of two-center ECP integral: " + label);
     }
 }
 
@@ -147,7 +142,8 @@ T2CProjECPCPUGenerator::_generate_integral_group(const M2Integral& integral) con
 
 void
 T2CProjECPCPUGenerator::_write_cpp_header(const SM2Integrals& integrals,
-                                          const M2Integral&   integral) const
+                                          const M2Integral&   integral,
+                                          const bool          angular_tables) const
 {
     auto fname = _file_name(integral) + ".hpp";
         
@@ -157,7 +153,7 @@ T2CProjECPCPUGenerator::_write_cpp_header(const SM2Integrals& integrals,
     
     _write_hpp_defines(fstream, integral, false, true);
     
-    _write_hpp_includes(fstream, integrals, integral);
+    _write_hpp_includes(fstream, integrals, integral, angular_tables);
     
     _write_namespace(fstream, integral, true);
    
@@ -171,7 +167,14 @@ T2CProjECPCPUGenerator::_write_cpp_header(const SM2Integrals& integrals,
 
     decl_drv.write_proj_ecp_func_decl(fstream, integral, false);
 
-    func_drv.write_func_body(fstream, {}, integrals, integral, {0, 0, 0});
+    if (angular_tables)
+    {
+        func_drv.write_table_func_body(fstream, integral);
+    }
+    else
+    {
+        func_drv.write_func_body(fstream, {}, integrals, integral, {0, 0, 0});
+    }
     
     fstream << std::endl;
 
@@ -182,10 +185,406 @@ T2CProjECPCPUGenerator::_write_cpp_header(const SM2Integrals& integrals,
     fstream.close();
 }
 
+void
+T2CProjECPCPUGenerator::_write_angular_tables(const int max_ang_mom,
+                                              const int proj_ang_mom) const
+{
+    const auto max_lambda = max_ang_mom + proj_ang_mom;
+    
+    const auto nmonomials = (max_ang_mom + 1) * (max_ang_mom + 2) * (max_ang_mom + 3) / 6;
+    
+    // values in (l, m), (lambda, mu), monomial order: monomials run over orders
+    // 0, ..., max_ang_mom, each in canonical tensor order.
+    
+    std::vector<std::string> values;
+    
+    for (int l = 0; l <= proj_ang_mom; l++)
+    {
+        for (int m = -l; m <= l; m++)
+        {
+            for (int lambda = 0; lambda <= max_lambda; lambda++)
+            {
+                for (int mu = -lambda; mu <= lambda; mu++)
+                {
+                    for (int order = 0; order <= max_ang_mom; order++)
+                    {
+                        for (const auto& monomial : Tensor(order).components())
+                        {
+                            std::ostringstream value;
+                            
+                            value << std::setprecision(17) << sphar::angular_integral(l, m, lambda, mu, monomial);
+                            
+                            values.push_back(value.str());
+                        }
+                    }
+                }
+            }
+        }
+    }
+    
+    const std::string fname = "ProjectedCorePotentialAngularTables";
+    
+    auto lines = VCodeLines();
+    
+    lines.push_back({0, 0, 1, "#ifndef " + fname + "_hpp"});
+    
+    lines.push_back({0, 0, 2, "#define " + fname + "_hpp"});
+    
+    lines.push_back({0, 0, 1, "#include <array>"});
+    
+    lines.push_back({0, 0, 1, "#include <cmath>"});
+    
+    lines.push_back({0, 0, 2, "#include <cstddef>"});
+    
+    lines.push_back({0, 0, 2, "namespace t2pecp { // t2pecp namespace"});
+    
+    lines.push_back({0, 0, 1, "/// The maximum projector angular momentum l of the angular integral tables."});
+    
+    lines.push_back({0, 0, 2, "constexpr int angular_max_proj = " + std::to_string(proj_ang_mom) + ";"});
+    
+    lines.push_back({0, 0, 1, "/// The maximum expansion angular momentum lambda of the angular integral tables."});
+    
+    lines.push_back({0, 0, 2, "constexpr int angular_max_lambda = " + std::to_string(max_lambda) + ";"});
+    
+    lines.push_back({0, 0, 1, "/// The maximum order of Cartesian monomials in the angular integral tables."});
+    
+    lines.push_back({0, 0, 2, "constexpr int angular_max_order = " + std::to_string(max_ang_mom) + ";"});
+    
+    lines.push_back({0, 0, 1, "/// The number of Cartesian monomials of orders 0, ..., angular_max_order."});
+    
+    lines.push_back({0, 0, 2, "constexpr int angular_nmonomials = " + std::to_string(nmonomials) + ";"});
+    
+    lines.push_back({0, 0, 1, "/// Gets index of angular integral in angular integrals table."});
+    
+    lines.push_back({0, 0, 1, "/// @param l The angular momentum of projector."});
+    
+    lines.push_back({0, 0, 1, "/// @param m The order of projector."});
+    
+    lines.push_back({0, 0, 1, "/// @param lambda The angular momentum of expansion."});
+    
+    lines.push_back({0, 0, 1, "/// @param mu The order of expansion."});
+    
+    lines.push_back({0, 0, 1, "/// @param i The power of x in Cartesian monomial."});
+    
+    lines.push_back({0, 0, 1, "/// @param j The power of y in Cartesian monomial."});
+    
+    lines.push_back({0, 0, 1, "/// @param k The power of z in Cartesian monomial."});
+    
+    lines.push_back({0, 0, 1, "/// @return The index of angular integral."});
+    
+    lines.push_back({0, 0, 1, "constexpr auto"});
+    
+    lines.push_back({0, 0, 1, "angular_integral_index(const int l, const int m, const int lambda, const int mu, const int i, const int j, const int k) -> size_t"});
+    
+    lines.push_back({0, 0, 1, "{"});
+    
+    lines.push_back({1, 0, 2, "const auto order = i + j + k;"});
+    
+    lines.push_back({1, 0, 2, "const auto mono = order * (order + 1) * (order + 2) / 6 + (order - i) * (order - i + 1) / 2 + k;"});
+    
+    lines.push_back({1, 0, 2, "const auto proj = l * l + l + m;"});
+    
+    lines.push_back({1, 0, 2, "const auto expn = lambda * lambda + lambda + mu;"});
+    
+    lines.push_back({1, 0, 1, "return static_cast<size_t>((proj * (angular_max_lambda + 1) * (angular_max_lambda + 1) + expn) * angular_nmonomials + mono);"});
+    
+    lines.push_back({0, 0, 2, "}"});
+    
+    lines.push_back({0, 0, 1, "/// The angular integrals int Y_{l,m}(u) Y_{lambda,mu}(u) u_x^i u_y^j u_z^k dOmega of"});
+    
+    lines.push_back({0, 0, 1, "/// unit-normalized real spherical harmonics over the unit sphere, indexed by"});
+    
+    lines.push_back({0, 0, 1, "/// angular_integral_index. They depend on angular momenta only, so the kernels"});
+    
+    lines.push_back({0, 0, 1, "/// only evaluate radial integrals at run time."});
+    
+    lines.push_back({0, 0, 1, "constexpr std::array<double, " + std::to_string(values.size()) + "> angular_integrals = {"});
+    
+    for (size_t i = 0; i < values.size(); i += 4)
+    {
+        const auto last = std::min(i + 4, values.size());
+        
+        auto label = values[i];
+        
+        for (size_t j = i + 1; j < last; j++)
+        {
+            label += ", " + values[j];
+        }
+        
+        lines.push_back({1, 0, 1, label + ((last == values.size()) ? "" : ",")});
+    }
+    
+    lines.push_back({0, 0, 2, "};"});
+    
+    lines.push_back({0, 0, 1, "/// Computes unit-normalized real spherical harmonic Y_{lambda,mu}(u)."});
+    
+    lines.push_back({0, 0, 1, "/// @param lambda The angular momentum of spherical harmonic."});
+    
+    lines.push_back({0, 0, 1, "/// @param mu The order of spherical harmonic."});
+    
+    lines.push_back({0, 0, 1, "/// @param ux The Cartesian X component of unit vector."});
+    
+    lines.push_back({0, 0, 1, "/// @param uy The Cartesian Y component of unit vector."});
+    
+    lines.push_back({0, 0, 1, "/// @param uz The Cartesian Z component of unit vector."});
+    
+    lines.push_back({0, 0, 1, "/// @return The value of spherical harmonic (zero for lambda > angular_max_lambda)."});
+    
+    lines.push_back({0, 0, 1, "inline auto"});
+    
+    lines.push_back({0, 0, 1, "real_spherical_harmonic(const int lambda, const int mu, const double ux, const double uy, const double uz) -> double"});
+    
+    lines.push_back({0, 0, 1, "{"});
+    
+    lines.push_back({1, 0, 1, "switch (lambda * lambda + lambda + mu)"});
+    
+    lines.push_back({1, 0, 1, "{"});
+    
+    const std::string axes("xyz");
+    
+    for (int lambda = 0; lambda <= max_lambda; lambda++)
+    {
+        const auto fnorm = std::sqrt(static_cast<double>(2 * lambda + 1) / (4.0 * std::acos(-1.0)));
+        
+        for (int mu = -lambda; mu <= lambda; mu++)
+        {
+            std::string label = "case " + std::to_string(lambda * lambda + lambda + mu) + ": return ";
+            
+            bool first = true;
+            
+            for (const auto& [tcomp, tfact] : sphar::spherical_factors(lambda, mu))
+            {
+                const auto fval = fnorm * tfact.value();
+                
+                std::ostringstream value;
+                
+                value << std::setprecision(17) << std::fabs(fval);
+                
+                if (first)
+                {
+                    label += ((fval < 0.0) ? "-" : "") + value.str();
+                }
+                else
+                {
+                    label += ((fval < 0.0) ? " - " : " + ") + value.str();
+                }
+                
+                for (const auto axis : axes)
+                {
+                    for (int i = 0; i < tcomp[axis]; i++) label += std::string(" * u") + axis;
+                }
+                
+                first = false;
+            }
+            
+            lines.push_back({2, 0, 1, label + ";"});
+        }
+    }
+    
+    lines.push_back({2, 0, 1, "default: return 0.0;"});
+    
+    lines.push_back({1, 0, 1, "}"});
+    
+    lines.push_back({0, 0, 2, "}"});
+    
+    lines.push_back({0, 0, 1, "/// Computes binomial coefficient C(n, k)."});
+    
+    lines.push_back({0, 0, 1, "/// @param n The upper index of binomial coefficient."});
+    
+    lines.push_back({0, 0, 1, "/// @param k The lower index of binomial coefficient."});
+    
+    lines.push_back({0, 0, 1, "/// @return The binomial coefficient."});
+    
+    lines.push_back({0, 0, 1, "constexpr auto"});
+    
+    lines.push_back({0, 0, 1, "angular_binomial(const int n, const int k) -> double"});
+    
+    lines.push_back({0, 0, 1, "{"});
+    
+    lines.push_back({1, 0, 2, "double value = 1.0;"});
+    
+    lines.push_back({1, 0, 2, "for (int i = 1; i <= k; i++) value = value * (n - k + i) / i;"});
+    
+    lines.push_back({1, 0, 1, "return value;"});
+    
+    lines.push_back({0, 0, 2, "}"});
+    
+    lines.push_back({0, 0, 1, "/// Computes integer power x^n (with 0^0 = 1)."});
+    
+    lines.push_back({0, 0, 1, "/// @param x The base of power."});
+    
+    lines.push_back({0, 0, 1, "/// @param n The non-negative exponent of power."});
+    
+    lines.push_back({0, 0, 1, "/// @return The power x^n."});
+    
+    lines.push_back({0, 0, 1, "constexpr auto"});
+    
+    lines.push_back({0, 0, 1, "angular_power(const double x, const int n) -> double"});
+    
+    lines.push_back({0, 0, 1, "{"});
+    
+    lines.push_back({1, 0, 2, "double value = 1.0;"});
+    
+    lines.push_back({1, 0, 2, "for (int i = 0; i < n; i++) value *= x;"});
+    
+    lines.push_back({1, 0, 1, "return value;"});
+    
+    lines.push_back({0, 0, 2, "}"});
+    
+    lines.push_back({0, 0, 1, "/// Computes angular projections of Cartesian components of shell with angular momentum L,"});
+    
+    lines.push_back({0, 0, 1, "/// centered at A = (x, y, z) relative to ECP center, onto projector with angular momentum l."});
+    
+    lines.push_back({0, 0, 1, "/// Expanding (r - A)^a about ECP center and exp(2 alpha A.r) in spherical Bessel functions"});
+    
+    lines.push_back({0, 0, 1, "/// leaves radial powers r^n, Bessel orders lambda, and the exponent independent factors"});
+    
+    lines.push_back({0, 0, 1, "///"});
+    
+    lines.push_back({0, 0, 1, "///     T(a, m, n, lambda) = sum_{i + j + k = n} C(a_x, i) C(a_y, j) C(a_z, k) (-x)^(a_x - i) (-y)^(a_y - j) (-z)^(a_z - k)"});
+    
+    lines.push_back({0, 0, 1, "///                          sum_mu Y_{lambda,mu}(A / |A|) Omega(l, m, lambda, mu, i, j, k),"});
+    
+    lines.push_back({0, 0, 1, "///"});
+    
+    lines.push_back({0, 0, 1, "/// stored at ((a * (2l + 1) + m + l) * (L + 1) + n) * (l + L + 1) + lambda."});
+    
+    lines.push_back({0, 0, 1, "/// @param projs The angular projections (overwritten)."});
+    
+    lines.push_back({0, 0, 1, "/// @param l The angular momentum of projector."});
+    
+    lines.push_back({0, 0, 1, "/// @param x The Cartesian X coordinate of shell center."});
+    
+    lines.push_back({0, 0, 1, "/// @param y The Cartesian Y coordinate of shell center."});
+    
+    lines.push_back({0, 0, 1, "/// @param z The Cartesian Z coordinate of shell center."});
+    
+    lines.push_back({0, 0, 1, "template <int L>"});
+    
+    lines.push_back({0, 0, 1, "inline auto"});
+    
+    lines.push_back({0, 0, 1, "comp_angular_projections(double* projs, const int l, const double x, const double y, const double z) -> void"});
+    
+    lines.push_back({0, 0, 1, "{"});
+    
+    lines.push_back({1, 0, 2, "static_assert(L <= angular_max_order, \"angular momentum exceeds angular integral tables\");"});
+    
+    lines.push_back({1, 0, 2, "const auto nlambda = l + L + 1;"});
+    
+    lines.push_back({1, 0, 2, "const auto r = std::sqrt(x * x + y * y + z * z);"});
+    
+    lines.push_back({1, 0, 1, "// direction of A is arbitrary at ECP center, where only lambda = 0 survives"});
+    
+    lines.push_back({1, 0, 2, "const auto ux = (r > 0.0) ? x / r : 0.0;"});
+    
+    lines.push_back({1, 0, 2, "const auto uy = (r > 0.0) ? y / r : 0.0;"});
+    
+    lines.push_back({1, 0, 2, "const auto uz = (r > 0.0) ? z / r : 1.0;"});
+    
+    lines.push_back({1, 0, 2, "std::array<double, (angular_max_lambda + 1) * (angular_max_lambda + 1)> ylm{};"});
+    
+    lines.push_back({1, 0, 1, "for (int lambda = 0; lambda < nlambda; lambda++)"});
+    
+    lines.push_back({1, 0, 1, "{"});
+    
+    lines.push_back({2, 0, 1, "for (int mu = -lambda; mu <= lambda; mu++)"});
+    
+    lines.push_back({2, 0, 1, "{"});
+    
+    lines.push_back({3, 0, 1, "ylm[lambda * lambda + lambda + mu] = real_spherical_harmonic(lambda, mu, ux, uy, uz);"});
+    
+    lines.push_back({2, 0, 1, "}"});
+    
+    lines.push_back({1, 0, 2, "}"});
+    
+    lines.push_back({1, 0, 2, "for (int i = 0; i < (L + 1) * (L + 2) / 2 * (2 * l + 1) * (L + 1) * nlambda; i++) projs[i] = 0.0;"});
+    
+    lines.push_back({1, 0, 2, "int a = 0;"});
+    
+    lines.push_back({1, 0, 1, "for (int ax = L; ax >= 0; ax--)"});
+    
+    lines.push_back({1, 0, 1, "{"});
+    
+    lines.push_back({2, 0, 1, "for (int ay = L - ax; ay >= 0; ay--, a++)"});
+    
+    lines.push_back({2, 0, 1, "{"});
+    
+    lines.push_back({3, 0, 2, "const auto az = L - ax - ay;"});
+    
+    lines.push_back({3, 0, 1, "for (int i = 0; i <= ax; i++)"});
+    
+    lines.push_back({3, 0, 1, "{"});
+    
+    lines.push_back({4, 0, 1, "for (int j = 0; j <= ay; j++)"});
+    
+    lines.push_back({4, 0, 1, "{"});
+    
+    lines.push_back({5, 0, 1, "for (int k = 0; k <= az; k++)"});
+    
+    lines.push_back({5, 0, 1, "{"});
+    
+    lines.push_back({6, 0, 1, "const auto fact = angular_binomial(ax, i) * angular_binomial(ay, j) * angular_binomial(az, k)"});
+    
+    lines.push_back({6, 0, 2, "                * angular_power(-x, ax - i) * angular_power(-y, ay - j) * angular_power(-z, az - k);"});
+    
+    lines.push_back({6, 0, 2, "if (fact == 0.0) continue;"});
+    
+    lines.push_back({6, 0, 2, "const auto n = i + j + k;"});
+    
+    lines.push_back({6, 0, 1, "for (int m = -l; m <= l; m++)"});
+    
+    lines.push_back({6, 0, 1, "{"});
+    
+    lines.push_back({7, 0, 1, "for (int lambda = 0; lambda < nlambda; lambda++)"});
+    
+    lines.push_back({7, 0, 1, "{"});
+    
+    lines.push_back({8, 0, 2, "double fang = 0.0;"});
+    
+    lines.push_back({8, 0, 1, "for (int mu = -lambda; mu <= lambda; mu++)"});
+    
+    lines.push_back({8, 0, 1, "{"});
+    
+    lines.push_back({9, 0, 1, "fang += ylm[lambda * lambda + lambda + mu] * angular_integrals[angular_integral_index(l, m, lambda, mu, i, j, k)];"});
+    
+    lines.push_back({8, 0, 2, "}"});
+    
+    lines.push_back({8, 0, 1, "projs[((a * (2 * l + 1) + m + l) * (L + 1) + n) * nlambda + lambda] += fact * fang;"});
+    
+    lines.push_back({7, 0, 1, "}"});
+    
+    lines.push_back({6, 0, 1, "}"});
+    
+    lines.push_back({5, 0, 1, "}"});
+    
+    lines.push_back({4, 0, 1, "}"});
+    
+    lines.push_back({3, 0, 1, "}"});
+    
+    lines.push_back({2, 0, 1, "}"});
+    
+    lines.push_back({1, 0, 1, "}"});
+    
+    lines.push_back({0, 0, 2, "}"});
+    
+    lines.push_back({0, 0, 2, "} // t2pecp namespace"});
+    
+    lines.push_back({0, 0, 1, "#endif /* " + fname + "_hpp */"});
+    
+    std::ofstream fstream;
+    
+    fstream.open((fname + ".hpp").c_str(), std::ios_base::trunc);
+    
+    ost::write_code_lines(fstream, lines);
+    
+    fstream.close();
+}
+
 void
 T2CProjECPCPUGenerator::_write_hpp_includes(      std::ofstream& fstream,
                                             const SM2Integrals&  integrals,
-                                            const M2Integral&    integral) const
+                                            const M2Integral&    integral,
+                                            const bool           angular_tables) const
 {
     auto lines = VCodeLines();
     
@@ -205,13 +604,22 @@ T2CProjECPCPUGenerator::_write_hpp_includes(      std::ofstream& fstream,
     
     std::set<std::string> plabels;
     
-    plabels.insert("ProjectedCorePotentialPrimRecSS");
-    
-    for (const auto& tint : integrals)
+    if (angular_tables)
     {
-        if ((tint.second[0] + tint.second[1]) > 0)
+        plabels.insert("ProjectedCorePotentialAngularTables");
+        
+        plabels.insert("ProjectedCorePotentialRadialFunc");
+    }
+    else
+    {
+        plabels.insert("ProjectedCorePotentialPrimRecSS");
+        
+        for (const auto& tint : integrals)
         {
-            plabels.insert(t2c::prim_file_name(tint));
+            if ((tint.second[0] + tint.second[1]) > 0)
+            {
+                plabels.insert(t2c::prim_file_name(tint));
+            }
         }
     }
     
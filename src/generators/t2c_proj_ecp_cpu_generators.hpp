@@ -51,16 +51,26 @@ class T2CProjECPCPUGenerator
     /// Writes header file for recursion.
     /// @param integrals The set of unique VRR integrals.
     /// @param integral The base two center integral.
+    /// @param angular_tables The flag to use angular integral tables in compute function.
     void _write_cpp_header(const SM2Integrals& integrals,
-                           const M2Integral&   integral) const;
+                           const M2Integral&   integral,
+                           const bool          angular_tables) const;
     
     /// Writes definitions of includes for header file.
     /// @param fstream the file stream.
     /// @param integrals The set of unique VRR integrals.
     /// @param integral The base two center integral.
+    /// @param angular_tables The flag to use angular integral tables in compute function.
     void _write_hpp_includes(      std::ofstream& fstream,
                              const SM2Integrals&  integrals,
-                             const M2Integral&    integral) const;
+                             const M2Integral&    integral,
+                             const bool           angular_tables) const;
+    
+    /// Writes header file with angular integral tables and angular projection functions.
+    /// @param max_ang_mom The maximum angular momentum of A and B centers.
+    /// @param proj_ang_mom The maximum angular momentum of projector on center C.
+    void _write_angular_tables(const int max_ang_mom,
+                               const int proj_ang_mom) const;
     
     /// Writes primitive header file for recursion.
     /// @param integral The base two center integral.
@@ -113,9 +123,11 @@ public:
     /// @param label The label of requested two-center integral.
     /// @param max_ang_mom The maximum angular momentum of A and B centers.
     /// @param proj_ang_mom The maximum angular momentum of projector on center C.
+    /// @param angular_tables The flag to write angular integral tables and table driven compute functions.
     void generate(const std::string& label,
                   const int          max_ang_mom,
-                  const int          proj_ang_mom) const;
+                  const int          proj_ang_mom,
+                  const bool         angular_tables) const;
 };
 
 #endif /* t2c_proj_ecp_cpu_generators_hpp */
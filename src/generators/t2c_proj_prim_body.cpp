@@ -201,7 +201,7 @@ T2CProjECPPrimFuncBodyDriver::_get_buffers_str(const std::vector<R2CDist>& rec_d
         
         int index = 0;
         
-        for (const auto& tcomp : tint.second.components<T1CPair, T1CPair>())
+        for (const auto& tcomp : tint.second.component_range<T1CPair, T1CPair>())
         {
             const auto line = "auto " + _get_component_label(tcomp, tint.first) + " = pbuffer.data(";
                 
@@ -237,7 +237,7 @@ T2CProjECPPrimFuncBodyDriver::_get_red_buffers_str(const std::vector<R2CDist>& r
         
         int index = 0;
         
-        for (const auto& tcomp : tint.second.components<T1CPair, T1CPair>())
+        for (const auto& tcomp : tint.second.component_range<T1CPair, T1CPair>())
         {
             const auto line = "auto " + _get_component_label(tcomp, tint.first) + " = pbuffer.data(";
                 
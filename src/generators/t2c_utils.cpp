@@ -511,6 +511,33 @@ grid_compute_func_name(const I2CIntegral&           integral,
     return fstr::lowercase(label);
 }
 
+std::string
+grid_batch_compute_func_name(const I2CIntegral& integral,
+                             const bool         use_rs)
+{
+    const auto label = t2c::grid_compute_func_name(integral, use_rs);
+    
+    return "comp_on_grid_batch_" + label.substr(std::string("comp_on_grid_").size());
+}
+
+std::string
+point_batch_compute_func_name(const I2CIntegral& integral)
+{
+    const auto label = t2c::compute_func_name(integral, {true, false}, false);
+    
+    return "comp_point_batch_" + label.substr(std::string("comp_sum_").size());
+}
+
+std::string
+grad_compute_func_name(const I2CIntegral&           integral,
+                       const std::pair<bool, bool>& rec_form,
+                       const bool                   use_rs)
+{
+    const auto label = t2c::compute_func_name(integral, rec_form, use_rs);
+    
+    return label.substr(0, label.rfind("_geom_")) + "_geom_grad_" + fstr::lowercase(integral.label());
+}
+
 std::string
 geom_compute_func_name(const I2CIntegral&        integral,
                        const std::array<int, 3>& geom_drvs)
@@ -561,6 +588,12 @@ grid_prim_file_name(const I2CIntegral& integral)
     return t2c::integral_label(integral) + "GridPrimRec" + integral.label();
 }
 
+std::string
+point_batch_prim_file_name(const I2CIntegral& integral)
+{
+    return t2c::integral_label(integral) + "PointBatchPrimRec" + integral.label();
+}
+
 std::string
 geom_file_name(const I2CIntegral& integral,
                const std::array<int, 3>& geom_drvs)
@@ -853,6 +886,24 @@ grid_prim_compute_func_name(const I2CIntegral& integral)
     return fstr::lowercase(label);
 }
 
+std::string
+point_batch_prim_compute_func_name(const I2CIntegral& integral)
+{
+    const auto label = t2c::prim_compute_func_name(integral);
+    
+    return "comp_prim_point_batch_" + label.substr(std::string("comp_prim_").size());
+}
+
+bool
+need_point_exponent(const I2CIntegral& integral)
+{
+    const auto name = integral.integrand().name();
+    
+    if ((name == "GX(r)") || (name == "GR2(r)") || (name == "GR.R2(r)")) return true;
+    
+    return (name == "G(r)") && ((integral[0] + integral[1]) != 1);
+}
+
 // May need to amend this for new integral cases
 SI2CIntegrals
 get_integrals(const I2CIntegral& integral)
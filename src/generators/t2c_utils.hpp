@@ -80,6 +80,30 @@ std::string compute_func_name(const I2CIntegral&           integral,
 std::string grid_compute_func_name(const I2CIntegral& integral,
                                    const bool         use_rs);
 
+/// Generates grid-batched compute function name, i.e. the name of the function
+/// evaluating all basis function pairs of a GTOs block range on a block of grid points.
+/// @param integral The base two center integral.
+/// @param use_rs The flag for use of range-separated Coulomb interactions.
+/// @return The compute function name.
+std::string grid_batch_compute_func_name(const I2CIntegral& integral,
+                                         const bool         use_rs);
+
+/// Generates point-batched compute function name, i.e. the name of the function
+/// evaluating three-center overlap like integrals on batches of external Gaussians.
+/// @param integral The base two center integral.
+/// @return The compute function name.
+std::string point_batch_compute_func_name(const I2CIntegral& integral);
+
+/// Generates gradient compute function name, i.e. the name of the function evaluating
+/// first order bra side derivatives and ket side ones obtained by translational invariance.
+/// @param integral The base two center integral with first order bra side derivative.
+/// @param rec_form The recursion form for two center integrals (summation, convolution flags).
+/// @param use_rs The flag for use of range-separated Coulomb interactions.
+/// @return The compute function name.
+std::string grad_compute_func_name(const I2CIntegral&           integral,
+                                   const std::pair<bool, bool>& rec_form,
+                                   const bool                   use_rs);
+
 /// Generates compute function  name.
 /// @param integral The base two center integral.
 /// @param geom_drvs The geometrical derivative of bra and  ket sides.
@@ -107,6 +131,11 @@ std::string hrr_file_name(const I2CIntegral& integral);
 /// @return The primitive file name.
 std::string grid_prim_file_name(const I2CIntegral& integral);
 
+/// Generates point-batched primitive file name.
+/// @param integral The base two center integral.
+/// @return The primitive file name.
+std::string point_batch_prim_file_name(const I2CIntegral& integral);
+
 /// Generates primitive file name.
 /// @param integral The base two center integral.
 /// @param geom_drvs The geometrical derivative of bra and  ket sides.
@@ -202,6 +231,17 @@ std::string hrr_compute_func_name(const I2CIntegral& integral);
 /// @return The primitive compute function name.
 std::string grid_prim_compute_func_name(const I2CIntegral& integral);
 
+/// Generates point-batched primitive compute function name.
+/// @param integral The base two center integral.
+/// @return The primitive compute function name.
+std::string point_batch_prim_compute_func_name(const I2CIntegral& integral);
+
+/// Checks if primitive compute function of three-center overlap like integral takes exponent
+/// of external Gaussian, which varies across lanes of point-batched compute functions.
+/// @param integral The base two center integral.
+/// @return True if primitive compute function takes exponent of external Gaussian, False otherwise.
+bool need_point_exponent(const I2CIntegral& integral);
+
 /// Gets arguments list for primitive function call.
 /// @param integral The base two center integral.
 SI2CIntegrals get_integrals(const I2CIntegral& integral);
@@ -232,7 +232,7 @@ T3CFuncBodyDriver::_get_all_components(const SI3CIntegrals& integrals) const
     
     for (const auto& tint : integrals)
     {
-        tcomps += tint.components<T1CPair, T2CPair>().size();
+        tcomps += tint.number_of_components();
     }
     
     return tcomps;
@@ -587,7 +587,7 @@ T3CFuncBodyDriver::_get_index(const size_t         start,
     {
         if (tint == integral) return index;
         
-        index += tint.components<T1CPair, T2CPair>().size();
+        index += tint.number_of_components();
     }
     
     return 0;
@@ -679,7 +679,7 @@ T3CFuncBodyDriver::_add_ket_loop_end(      VCodeLines&  lines,
             
             label += std::to_string(_get_index(0, tint, vrr_integrals)) + ", ";
             
-            label += std::to_string(tint.components<T1CPair, T2CPair>().size()) + ", ";
+            label += std::to_string(tint.number_of_components()) + ", ";
             
             label += "ket_width, ket_npgtos);";
             
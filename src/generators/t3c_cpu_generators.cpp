@@ -16,6 +16,8 @@
 
 #include "t3c_cpu_generators.hpp"
 
+#include <stdexcept>
+
 #include "string_formater.hpp"
 #include "file_stream.hpp"
 
@@ -83,11 +85,7 @@ T3CCPUGenerator::generate(const std::string& label,
     }
     else
     {
-        std::cerr << "*** ERROR *** Unsupported type of four-center integral: ";
-        
-        std::cerr << label << " !!!" << std::endl;
-        
-        std::exit(EXIT_FAILURE);
+        throw std::invalid_argument("Unsupported type of four-center integral: " + label);
     }
 }
 
@@ -244,7 +244,7 @@ T3CGeomFuncBodyDriver::_get_all_components(const SI3CIntegrals& integrals) const
     
     for (const auto& tint : integrals)
     {
-        tcomps += tint.components<T1CPair, T2CPair>().size();
+        tcomps += tint.number_of_components();
     }
     
     return tcomps;
@@ -281,7 +281,7 @@ T3CGeomFuncBodyDriver::_get_cart_buffers_def(const SG3Terms&    cterms,
     
     for (const auto& term : cterms)
     {
-        tcomps += term.second.components<T1CPair, T2CPair>().size();
+        tcomps += term.second.number_of_components();
     }
     
     std::string label = "CSimdArray<double> cbuffer";
@@ -317,7 +317,7 @@ T3CGeomFuncBodyDriver::_get_half_spher_buffers_def(const SG3Terms&    skterms,
         
         for (const auto& prefix : tint.prefixes())
         {
-            icomps *= prefix.components().size();
+            icomps *= prefix.number_of_components();
         }
         
         tcomps += icomps;
@@ -347,7 +347,7 @@ T3CGeomFuncBodyDriver::_get_spher_buffers_def(const I3CIntegral& integral) const
     
     for (const auto& prefix : integral.prefixes())
     {
-        tcomps *= prefix.components().size();
+        tcomps *= prefix.number_of_components();
     }
     
     std::string label = "CSimdArray<double> ";
@@ -550,7 +550,7 @@ T3CGeomFuncBodyDriver::_add_ket_loop_end(      VCodeLines&    lines,
                 
             label += std::to_string(_get_index(0, tint, vrr_integrals)) + ", ";
                 
-            label += std::to_string(tint.components<T1CPair, T2CPair>().size()) + ", ";
+            label += std::to_string(tint.number_of_components()) + ", ";
                 
             label += "ket_width, ket_npgtos);";
                 
@@ -572,7 +572,7 @@ T3CGeomFuncBodyDriver::_add_ket_loop_end(      VCodeLines&    lines,
            
             label +=  std::to_string(_get_index(0, tint, vrr_integrals)) + ", ";
            
-            label +=  std::to_string(_get_index(0, tint, vrr_integrals) + tint.components<T1CPair, T2CPair>().size()) + "});";
+            label +=  std::to_string(_get_index(0, tint, vrr_integrals) + tint.number_of_components()) + "});";
            
             lines.push_back({4, 0, 2, label});
         }
@@ -594,7 +594,7 @@ T3CGeomFuncBodyDriver::_add_ket_loop_end(      VCodeLines&    lines,
                 
             label += std::to_string(_get_index(0, tint, vrr_integrals)) + ", ";
                 
-            label += std::to_string(tint.components<T1CPair, T2CPair>().size()) + ", ";
+            label += std::to_string(tint.number_of_components()) + ", ";
                 
             label += "ket_width, ket_npgtos);";
                 
@@ -616,7 +616,7 @@ T3CGeomFuncBodyDriver::_add_ket_loop_end(      VCodeLines&    lines,
             
             label +=  std::to_string(_get_index(0, tint, vrr_integrals)) + ", ";
            
-            label +=  std::to_string(_get_index(0, tint, vrr_integrals) + tint.components<T1CPair, T2CPair>().size()) + "});";
+            label +=  std::to_string(_get_index(0, tint, vrr_integrals) + tint.number_of_components()) + "});";
            
             lines.push_back({4, 0, 2, label});
         }
@@ -636,7 +636,7 @@ T3CGeomFuncBodyDriver::_add_ket_loop_end(      VCodeLines&    lines,
             
             label += std::to_string(_get_index(0, tint, vrr_integrals)) + ", ";
             
-            label += std::to_string(tint.components<T1CPair, T2CPair>().size()) + ", ";
+            label += std::to_string(tint.number_of_components()) + ", ";
             
             label += "ket_width, ket_npgtos);";
             
@@ -713,7 +713,7 @@ T3CGeomFuncBodyDriver::_get_index(const size_t         start,
     {
         if (tint == integral) return index;
         
-        index += tint.components<T1CPair, T2CPair>().size();
+        index += tint.number_of_components();
     }
     
     return 0;
@@ -791,7 +791,7 @@ T3CGeomFuncBodyDriver::_get_index(const G3Term&   term,
     {
         if (term == cterm) return index;
         
-        index += cterm.second.components<T1CPair, T2CPair>().size();
+        index += cterm.second.number_of_components();
     }
     
     return 0;
@@ -806,7 +806,7 @@ T3CGeomFuncBodyDriver::_add_ket_trafo_call_tree(      VCodeLines&  lines,
     
     for (const auto& prefix : integral.prefixes())
     {
-        gcomps *= prefix.components().size();
+        gcomps *= prefix.number_of_components();
     }
     
     auto angpair = std::array<int, 2>({integral[1], integral[2]});
@@ -874,7 +874,7 @@ T3CGeomFuncBodyDriver::_get_half_spher_index(const G3Term&   term,
         
         for (const auto& prefix : tint.prefixes())
         {
-            icomps *= prefix.components().size();
+            icomps *= prefix.number_of_components();
         }
         
         index += icomps;
@@ -1,6 +1,7 @@
 #include "t3c_geom_cpu_generators.hpp"
 
 #include <iostream>
+#include <stdexcept>
 
 #include "string_formater.hpp"
 #include "file_stream.hpp"
@@ -99,11 +100,7 @@ T3CGeomCPUGenerator::generate(const std::string&        label,
     }
     else
     {
-        std::cerr << "*** ERROR *** Unsupported type of three-center integral: ";
-        
-        std::cerr << label << " !!!" << std::endl;
-        
-        std::exit(EXIT_FAILURE);
+        throw std::invalid_argument("Unsupported type of three-center integral: " + label);
     }
 }
 
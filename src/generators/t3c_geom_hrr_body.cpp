@@ -151,7 +151,7 @@ T3CGeomHrrFuncBodyDriver::_get_bra_buffers_str(const std::vector<R3CDist>& rec_d
         
         int index = 0;
         
-        for (const auto& tcomp : tint.components<T1CPair, T2CPair>())
+        for (const auto& tcomp : tint.component_range<T1CPair, T2CPair>())
         {
             std::string line;
             
@@ -255,7 +255,7 @@ T3CGeomHrrFuncBodyDriver::_get_full_bra_component_label(const T3CIntegral& integ
 std::string
 T3CGeomHrrFuncBodyDriver::_get_bra_offset_def(const I3CIntegral& integral) const
 {
-    const auto tlabel = std::to_string(integral.components<T1CPair, T2CPair>().size());
+    const auto tlabel = std::to_string(integral.number_of_components());
     
     auto label = "const auto " + _get_bra_offset_label(integral) + " = ";
     
@@ -267,7 +267,7 @@ T3CGeomHrrFuncBodyDriver::_get_bra_offset_def(const I3CIntegral& integral) const
 std::string
 T3CGeomHrrFuncBodyDriver::_get_full_bra_offset_def(const I3CIntegral& integral) const
 {
-    const auto tlabel = std::to_string(integral.components<T1CPair, T2CPair>().size());
+    const auto tlabel = std::to_string(integral.number_of_components());
     
     auto label = "const auto " + _get_full_bra_offset_label(integral) + " = ";
     
@@ -606,7 +606,7 @@ T3CGeomHrrFuncBodyDriver::_get_ket_buffers_str(const std::vector<R3CDist>& rec_d
             
             int index = 0;
             
-            for (const auto& tcomp : tint.components<T1CPair, T2CPair>())
+            for (const auto& tcomp : tint.component_range<T1CPair, T2CPair>())
             {
                 //if (_find_integral(rec_dists, tcomp))
                 //{
@@ -641,7 +641,7 @@ T3CGeomHrrFuncBodyDriver::_get_ket_buffers_str(const std::vector<R3CDist>& rec_d
                 
                 int index = 0;
                 
-                for (const auto& tcomp : tint.components<T1CPair, T2CPair>())
+                for (const auto& tcomp : tint.component_range<T1CPair, T2CPair>())
                 {
                     const auto line = "auto " + _get_ket_component_label(tcomp) + " = " + label;
                     
@@ -662,7 +662,7 @@ T3CGeomHrrFuncBodyDriver::_get_ket_buffers_str(const std::vector<R3CDist>& rec_d
                 
                 int index = 0;
                 
-                for (const auto& tcomp : tint.components<T1CPair, T2CPair>())
+                for (const auto& tcomp : tint.component_range<T1CPair, T2CPair>())
                 {
                     //if (_find_integral(rec_dists, tcomp))
                     //{
@@ -700,7 +700,7 @@ T3CGeomHrrFuncBodyDriver::_get_ket_component_label(const T3CIntegral& integral)
 std::string
 T3CGeomHrrFuncBodyDriver::_get_ket_offset_def(const I3CIntegral& integral) const
 {
-    // const auto tlabel = std::to_string(integral.components<T2CPair, T2CPair>().size());
+    // const auto tlabel = std::to_string(integral.number_of_components());
     
     const auto bcomps = t2c::number_of_cartesian_components(integral[1]);
     
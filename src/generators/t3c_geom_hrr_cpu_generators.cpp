@@ -16,6 +16,8 @@
 
 #include "t3c_geom_hrr_cpu_generators.hpp"
 
+#include <stdexcept>
+
 #include "string_formater.hpp"
 #include "file_stream.hpp"
 
@@ -60,11 +62,7 @@ T3CGeomHrrCPUGenerator::generate(const std::string&        label,
     }
     else
     {
-        std::cerr << "*** ERROR *** Unsupported type of three-center integral: ";
-        
-        std::cerr << label << " !!!" << std::endl;
-        
-        std::exit(EXIT_FAILURE);
+        throw std::invalid_argument("Unsupported type of three-center integral: " + label);
     }
 }
 
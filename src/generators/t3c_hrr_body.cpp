@@ -108,7 +108,7 @@ T3CHrrFuncBodyDriver::_get_ket_buffers_str(const std::vector<R3CDist>& rec_dists
         
         int index = 0;
         
-        for (const auto& tcomp : tint.components<T1CPair, T2CPair>())
+        for (const auto& tcomp : tint.component_range<T1CPair, T2CPair>())
         {
             if (_find_integral(rec_dists, tcomp))
             {
@@ -358,7 +358,7 @@ T3CHrrFuncBodyDriver::_get_ket_component_label(const T3CIntegral& integral) cons
 std::string
 T3CHrrFuncBodyDriver::_get_ket_offset_def(const I3CIntegral& integral) const
 {
-    const auto tlabel = std::to_string(integral.components<T1CPair, T2CPair>().size());
+    const auto tlabel = std::to_string(integral.number_of_components());
     
     auto label = "const auto " + _get_ket_offset_label(integral) + " = ";
     
@@ -139,7 +139,7 @@ T3CPrimFuncBodyDriver::_get_buffers_str(const std::vector<R3CDist>& rec_dists,
         
         int index = 0;
         
-        for (const auto& tcomp : tint.components<T1CPair, T2CPair>())
+        for (const auto& tcomp : tint.component_range<T1CPair, T2CPair>())
         {
             if (_find_integral(rec_dists, tcomp))
             {
@@ -18,6 +18,15 @@
 
 #include "t2c_utils.hpp"
 #include "t4c_utils.hpp"
+#include "spherical_harmonics.hpp"
+#include "tensor.hpp"
+
+#include <algorithm>
+#include <map>
+#include <set>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
 
 void
 T4CFuncBodyDriver::write_func_body(      std::ofstream& fstream,
@@ -131,7 +140,7 @@ T4CFuncBodyDriver::write_diag_func_body(      std::ofstream& fstream,
         lines.push_back({1, 0, 2, label});
     }
     
-    for (const auto& label : _get_half_spher_buffers_def(bra_integrals, ket_integrals, integral))
+    for (const auto& label : _get_diag_half_spher_buffers_def(ket_integrals, integral))
     {
         lines.push_back({1, 0, 2, label});
     }
@@ -163,11 +172,9 @@ T4CFuncBodyDriver::write_diag_func_body(      std::ofstream& fstream,
     
     _add_ket_hrr_call_tree(lines, bra_integrals, ket_integrals, 2);
     
-    _add_ket_trafo_call_tree(lines, bra_integrals, ket_integrals, integral, 2);
+    _add_diag_ket_trafo_call_tree(lines, bra_integrals, ket_integrals, integral);
     
-    _add_bra_hrr_call_tree(lines, bra_integrals,  ket_integrals, integral, 2);
-    
-    _add_diag_bra_trafo_call_tree(lines, bra_integrals,  ket_integrals, integral);
+    _add_diag_bra_trafo_call_tree(lines, ket_integrals, integral);
 
 //    
 //    _add_ket_trafo_call_tree(lines, bra_integrals, ket_integrals, integral);
@@ -734,6 +741,25 @@ T4CFuncBodyDriver::_get_half_spher_buffers_integrals(const SI4CIntegrals& bra_in
     return tints;
 }
 
+SI4CIntegrals
+T4CFuncBodyDriver::_get_diag_half_spher_buffers_integrals(const SI4CIntegrals& ket_integrals,
+                                                          const I4CIntegral&   integral) const
+{
+    SI4CIntegrals tints;
+    
+    for (const auto& tint : ket_integrals)
+    {
+        if ((tint[0] == 0) && (tint[2] == integral[2]) && (tint[3] == integral[3]))
+        {
+            tints.insert(tint);
+        }
+    }
+    
+    if (integral[0] == 0) tints.insert(integral);
+    
+    return tints;
+}
+
 std::vector<std::string>
 T4CFuncBodyDriver::_get_prim_buffers_def(const SI4CIntegrals& integrals,
                                          const I4CIntegral&   integral) const
@@ -865,7 +891,7 @@ T4CFuncBodyDriver::_get_full_cart_buffers_def(const SI4CIntegrals& integrals,
             
     label += t4c::get_buffer_label(integral, "cart");
             
-    const auto tcomps = integral.components<T2CPair, T2CPair>().size();
+    const auto tcomps = integral.number_of_components();
         
     label += "(" + std::to_string(tcomps) + ", ket_dim);";
             
@@ -953,32 +979,20 @@ T4CFuncBodyDriver::_get_half_spher_buffers_def(const SI4CIntegrals& bra_integral
 }
 
 std::vector<std::string>
-T4CFuncBodyDriver::_get_diag_half_spher_buffers_def(const SI4CIntegrals& bra_integrals,
-                                                    const SI4CIntegrals& ket_integrals,
+T4CFuncBodyDriver::_get_diag_half_spher_buffers_def(const SI4CIntegrals& ket_integrals,
                                                     const I4CIntegral&   integral) const
 {
     std::vector<std::string> vstr;
     
     vstr.push_back("// allocate aligned half transformed integrals");
     
-    for (const auto& tint : _get_half_spher_buffers_integrals(bra_integrals, ket_integrals, integral))
-    {
-        std::string label = "CSimdArray<double> ";
-                
-        label += t4c::get_buffer_label(tint, "ket_spher");
-                
-        auto angpair = std::array<int, 2>({tint[2], tint[3]});
-                
-        auto tcomps = t2c::number_of_spherical_components(angpair);
+    auto tcomps = _get_all_half_spher_components(_get_diag_half_spher_buffers_integrals(ket_integrals, integral));
+    
+    std::string label = "CSimdArray<double> ";
             
-        angpair = std::array<int, 2>({tint[0], tint[1]});
-                
-        tcomps *= t2c::number_of_cartesian_components(angpair);
-                
-        label += "(" + std::to_string(tcomps) + ", 1);";
-                
-        vstr.push_back(label);
-    }
+    label += "skbuffer(" + std::to_string(tcomps) + ", 1);";
+            
+    vstr.push_back(label);
         
     return vstr;
 }
@@ -1048,7 +1062,7 @@ T4CFuncBodyDriver::_get_full_spher_buffers_def(const I4CIntegral& integral) cons
     
     for (const auto& prefix : integral.prefixes())
     {
-        tcomps *= prefix.components().size();
+        tcomps *= prefix.number_of_components();
     }
                     
     label += "(" + std::to_string(tcomps) + ", ket_dim);";
@@ -1771,7 +1785,7 @@ T4CFuncBodyDriver::_add_ket_loop_end(      VCodeLines&  lines,
             
             label += std::to_string(_get_index(0, tint, vrr_integrals)) + ", ";
             
-            label += std::to_string(tint.components<T2CPair, T2CPair>().size()) + ", ";
+            label += std::to_string(tint.number_of_components()) + ", ";
             
             label += "ket_width, ket_npgtos);";
             
@@ -1801,7 +1815,7 @@ T4CFuncBodyDriver::_add_ket_loop_end(      VCodeLines&  lines,
 //            
 //            label += std::to_string(_get_index(vstart, tint, vrr_integrals)) + ", ";
 //            
-//            label += std::to_string(tint.components<T2CPair, T2CPair>().size()) + ", ";
+//            label += std::to_string(tint.number_of_components()) + ", ";
 //            
 //            label += "ket_width, ket_npgtos);";
 //            
@@ -1846,7 +1860,7 @@ T4CFuncBodyDriver::_add_diag_ket_loop_end(      VCodeLines&    lines,
             
             label += std::to_string(_get_index(0, tint, vrr_integrals)) + ", ";
             
-            label += std::to_string(tint.components<T2CPair, T2CPair>().size()) + ", ";
+            label += std::to_string(tint.number_of_components()) + ", ";
             
             label += "ket_width, npgtos);";
             
@@ -2327,15 +2341,7 @@ T4CFuncBodyDriver::_add_ket_trafo_call_tree(      VCodeLines&  lines,
         {
             if ((tint[0] == 0) && (tint[2] == integral[2]) && (tint[3] == integral[3]))
             {
-                std::string label = "t4cfunc::ket_transform<" + std::to_string(tint[2]) + ", " + std::to_string(tint[3]) + ">";
-                
-                label += "(skbuffer, "  + std::to_string(_get_half_spher_index(0, tint, skints)) + ", ";
-                
-                label += "ckbuffer, " + std::to_string(_get_index(0, tint, ckints))  + ", ";
-                
-                label += std::to_string(tint[0]) + ", " + std::to_string(tint[1]) + ");";
-                
-                lines.push_back({spacer, 0, 2, label});
+                _add_sparse_ket_trafo(lines, _get_half_spher_index(0, tint, skints), "ckbuffer", _get_index(0, tint, ckints), tint, spacer);
                 
                 nterms++;
             }
@@ -2391,15 +2397,7 @@ T4CFuncBodyDriver::_add_ket_trafo_call_tree(      VCodeLines&  lines,
         {
             if ((tint[0] == 0) && (tint[2] == 0))
             {
-                std::string label = "t4cfunc::ket_transform<" + std::to_string(tint[2]) + ", " + std::to_string(tint[3]) + ">";
-                    
-                label += "(skbuffer, "  +  std::to_string(_get_half_spher_index(0, tint, skints)) + ", ";
-                
-                label += "cbuffer, " + std::to_string(_get_index(0, tint, cints))  + ", ";
-                
-                label += std::to_string(tint[0]) + ", " + std::to_string(tint[1]) + ");";
-                    
-                lines.push_back({spacer, 0, 2, label});
+                _add_sparse_ket_trafo(lines, _get_half_spher_index(0, tint, skints), "cbuffer", _get_index(0, tint, cints), tint, spacer);
                 
                 nterms++;
             }
@@ -2445,15 +2443,7 @@ T4CFuncBodyDriver::_add_ket_trafo_call_tree(      VCodeLines&  lines,
 //        
 //        const auto cstart = _get_all_components(cints);
         
-        std::string label = "t4cfunc::ket_transform<" + std::to_string(integral[2]) + ", " + std::to_string(integral[3]) + ">";
-            
-        label += "(skbuffer, "  +  std::to_string(_get_half_spher_index(0, integral, skints)) + ", ";
-        
-        label += "cbuffer, " + std::to_string(_get_index(0, integral, cints))  + ", ";
-        
-        label += std::to_string(integral[0]) + ", " + std::to_string(integral[1]) + ");";
-            
-        lines.push_back({spacer, 0, 2, label});
+        _add_sparse_ket_trafo(lines, _get_half_spher_index(0, integral, skints), "cbuffer", _get_index(0, integral, cints), integral, spacer);
         
 //        lines.push_back({3, 0, 1, "if constexpr (N == 3)"});
 //        
@@ -2473,6 +2463,109 @@ T4CFuncBodyDriver::_add_ket_trafo_call_tree(      VCodeLines&  lines,
     }
 }
 
+void
+T4CFuncBodyDriver::_add_sparse_ket_trafo(      VCodeLines&  lines,
+                                         const size_t       skindex,
+                                         const std::string& source,
+                                         const size_t       cindex,
+                                         const I4CIntegral& integral,
+                                         const size_t       spacer) const
+{
+    const auto ccomps = static_cast<size_t>((integral[2] + 1) * (integral[2] + 2) * (integral[3] + 1) * (integral[3] + 2) / 4);
+    
+    const auto abcomps = static_cast<size_t>((integral[0] + 1) * (integral[0] + 2) * (integral[1] + 1) * (integral[1] + 2) / 4);
+    
+    const size_t nsph_cd = (2 * integral[2] + 1) * (2 * integral[3] + 1);
+    
+    // spherical ket rows of (ab|cd) block, sources as offsets into Cartesian (cd) block
+    
+    std::vector<std::string> targets;
+    
+    std::vector<std::vector<t4c::SparseTerm>> rows;
+    
+    std::vector<size_t> sources;
+    
+    for (int i = 0; i < 2 * integral[2] + 1; i++)
+    {
+        for (int j = 0; j < 2 * integral[3] + 1; j++)
+        {
+            std::vector<t4c::SparseTerm> terms;
+            
+            for (const auto& [cart_cd, coef] : t4c::spherical_pair_terms(integral[2], integral[3], i, j))
+            {
+                terms.push_back({"c_" + std::to_string(cart_cd), coef});
+                
+                if (std::find(sources.begin(), sources.end(), cart_cd) == sources.end()) sources.push_back(cart_cd);
+            }
+            
+            targets.push_back(std::to_string(i * (2 * integral[3] + 1) + j));
+            
+            rows.push_back(terms);
+        }
+    }
+    
+    std::sort(sources.begin(), sources.end());
+    
+    lines.push_back({spacer, 0, 1, "// sparse ket transformation (" + Tensor(integral[0]).label() + Tensor(integral[1]).label() + "|"
+                                   + Tensor(integral[2]).label() + Tensor(integral[3]).label() + ")"});
+    
+    lines.push_back({spacer, 0, 1, "for (size_t ab = 0; ab < " + std::to_string(abcomps) + "; ab++)"});
+    
+    lines.push_back({spacer, 0, 1, "{"});
+    
+    lines.push_back({spacer + 1, 0, 1, "const auto cart_off = " + std::to_string(cindex) + " + " + std::to_string(ccomps) + " * ab;"});
+    
+    lines.push_back({spacer + 1, 0, 2, "const auto spher_off = " + std::to_string(skindex) + " + " + std::to_string(nsph_cd) + " * ab;"});
+    
+    for (size_t i = 0; i < sources.size(); i++)
+    {
+        const auto row = sources[i];
+        
+        const auto nlines = ((i + 1) == sources.size()) ? 2 : 1;
+        
+        lines.push_back({spacer + 1, 0, nlines, "const auto c_" + std::to_string(row) + " = " + source + ".data(cart_off + " + std::to_string(row) + ");"});
+    }
+    
+    for (auto& target : targets) target = "spher_off + " + target;
+    
+    _add_sparse_rows(lines, "skbuffer", targets, "", rows, spacer + 1);
+    
+    lines.push_back({spacer, 0, 2, "}"});
+}
+
+void
+T4CFuncBodyDriver::_add_sparse_rows(      VCodeLines&                           lines,
+                                    const std::string&                    target,
+                                    const std::vector<std::string>&       targets,
+                                    const std::string&                    suffix,
+                                    const std::vector<std::vector<t4c::SparseTerm>>& rows,
+                                    const size_t                          spacer) const
+{
+    for (size_t i = 0; i < targets.size(); i++)
+    {
+        const auto nlines = ((i + 1) == targets.size()) ? 2 : 1;
+        
+        lines.push_back({spacer, 0, nlines, "auto s_" + std::to_string(i) + " = " + target + ".data(" + targets[i] + suffix + ");"});
+    }
+    
+    lines.push_back({spacer, 0, 2, "const auto nelems = " + target + ".number_of_active_elements();"});
+    
+    lines.push_back({spacer, 0, 1, "#pragma omp simd"});
+    
+    lines.push_back({spacer, 0, 1, "for (size_t k = 0; k < nelems; k++)"});
+    
+    lines.push_back({spacer, 0, 1, "{"});
+    
+    for (size_t i = 0; i < rows.size(); i++)
+    {
+        const auto nlines = ((i + 1) == rows.size()) ? 1 : 2;
+        
+        lines.push_back({spacer + 1, 0, nlines, "s_" + std::to_string(i) + "[k] = " + t4c::sparse_sum(rows[i]) + ";"});
+    }
+    
+    lines.push_back({spacer, 0, 1, "}"});
+}
+
 void
 T4CFuncBodyDriver::_add_bra_hrr_call_tree(      VCodeLines&  lines,
                                           const SI4CIntegrals& bra_integrals,
@@ -2625,25 +2718,231 @@ T4CFuncBodyDriver::_add_bra_trafo_call_tree(      VCodeLines&    lines,
 //    lines.push_back({3, 0, 1, "}"});
 }
 
-void 
-T4CFuncBodyDriver::_add_diag_bra_trafo_call_tree(      VCodeLines&  lines,
+std::vector<std::vector<t4c::DiagTerm>>
+T4CFuncBodyDriver::_get_diag_terms(const SI4CIntegrals& ket_integrals,
+                                   const I4CIntegral&   integral) const
+{
+    const auto skints = _get_diag_half_spher_buffers_integrals(ket_integrals, integral);
+
+    const auto acomps = Tensor(integral[0]).components();
+
+    const auto bcomps = Tensor(integral[1]).components();
+
+    const int nsph_b = 2 * integral[1] + 1;
+
+    const auto nsph_ab = static_cast<size_t>((2 * integral[0] + 1) * nsph_b);
+
+    const auto binomial = [](const int n, const int k) -> int {
+
+        int value = 1;
+
+        for (int i = 1; i <= k; i++) value = value * (n - k + i) / i;
+
+        return value;
+    };
+
+    std::vector<std::vector<t4c::DiagTerm>> terms;
+
+    for (int i = 0; i < 2 * integral[0] + 1; i++)
+    {
+        for (int j = 0; j < nsph_b; j++)
+        {
+            const auto ij = static_cast<size_t>(i * nsph_b + j);
+
+            std::vector<t4c::DiagTerm> tterms;
+
+            for (const auto& [cart_ab, coef] : t4c::spherical_pair_terms(integral[0], integral[1], i, j))
+            {
+                const auto acomp = acomps[cart_ab / bcomps.size()];
+
+                const auto bcomp = bcomps[cart_ab % bcomps.size()];
+
+                // bra HRR in closed form: (a, b| = sum_k C(a, k) (-AB)^(a - k) (0, b + k| along each axis
+
+                for (int kx = 0; kx <= acomp['x']; kx++)
+                {
+                    for (int ky = 0; ky <= acomp['y']; ky++)
+                    {
+                        for (int kz = 0; kz <= acomp['z']; kz++)
+                        {
+                            const auto bkcomp = TensorComponent(bcomp['x'] + kx, bcomp['y'] + ky, bcomp['z'] + kz);
+
+                            const std::array<int, 3> powers({acomp['x'] - kx, acomp['y'] - ky, acomp['z'] - kz});
+
+                            auto factor = coef.factor * Fraction(binomial(acomp['x'], kx) * binomial(acomp['y'], ky) * binomial(acomp['z'], kz));
+
+                            if ((powers[0] + powers[1] + powers[2]) % 2 == 1) factor = factor * Fraction(-1);
+
+                            const auto bkint = std::find_if(skints.begin(), skints.end(), [&](const I4CIntegral& tint) {
+
+                                return tint[1] == bkcomp.order();
+                            });
+
+                            if (bkint == skints.end())
+                            {
+                                throw std::invalid_argument("T4CFuncBodyDriver: missing half transformed integral for diagonal " + integral.label());
+                            }
+
+                            const auto bkcomps = Tensor(bkcomp.order()).components();
+
+                            const auto bkindex = static_cast<size_t>(std::find(bkcomps.begin(), bkcomps.end(), bkcomp) - bkcomps.begin());
+
+                            const auto row = _get_half_spher_index(0, *bkint, skints) + bkindex * nsph_ab + ij;
+
+                            tterms.push_back({row, sphar::SphericalFactor(factor, coef.radicand), powers});
+                        }
+                    }
+                }
+            }
+
+            terms.push_back(tterms);
+        }
+    }
+
+    return terms;
+}
+
+void
+T4CFuncBodyDriver::_add_diag_ket_trafo_call_tree(      VCodeLines&  lines,
                                                  const SI4CIntegrals& bra_integrals,
                                                  const SI4CIntegrals& ket_integrals,
                                                  const I4CIntegral&   integral) const
 {
-    const auto skints = _get_half_spher_buffers_integrals(bra_integrals, ket_integrals, integral);
-    
-    //const auto skstart = _get_all_half_spher_components(skints);
-    
-    std::string label = "t4cfunc::bra_transform<" + std::to_string(integral[0]) + ", " + std::to_string(integral[1]) + ">";
-        
-    label += "(sbuffer, 0, skbuffer, ";
-    
-    label += std::to_string(_get_half_spher_index(0, integral, skints)) + ", ";
-    
-    label += std::to_string(integral[2]) + ", " + std::to_string(integral[3]) + ");";
-        
-    lines.push_back({2, 0, 2, label});
+    const auto skints = _get_diag_half_spher_buffers_integrals(ket_integrals, integral);
+
+    // half transformed rows read by diagonal components
+
+    std::set<size_t> rows;
+
+    for (const auto& tterms : _get_diag_terms(ket_integrals, integral))
+    {
+        for (const auto& tterm : tterms) rows.insert(std::get<0>(tterm));
+    }
+
+    const std::string source = (integral[2] > 0) ? "ckbuffer" : "cbuffer";
+
+    const auto ncart_cd = static_cast<size_t>((integral[2] + 1) * (integral[2] + 2) * (integral[3] + 1) * (integral[3] + 2) / 4);
+
+    const int nsph_d = 2 * integral[3] + 1;
+
+    const auto nsph_cd = static_cast<size_t>((2 * integral[2] + 1) * nsph_d);
+
+    lines.push_back({2, 0, 1, "// ket transformation pruned to half transformed rows of diagonal (ab|ab) components"});
+
+    size_t nrows = 0;
+
+    for (const auto& tint : skints)
+    {
+        const auto cindex = (integral[2] > 0) ? _get_index(0, tint, _get_contr_buffers_integrals(ket_integrals))
+                                              : _get_index(0, tint, _get_cart_buffer_integrals(bra_integrals, ket_integrals));
+
+        const auto skindex = _get_half_spher_index(0, tint, skints);
+
+        const auto nbcomps = static_cast<size_t>((tint[1] + 1) * (tint[1] + 2) / 2);
+
+        for (size_t b = 0; b < nbcomps; b++)
+        {
+            for (size_t ij = 0; ij < nsph_cd; ij++)
+            {
+                const auto row = skindex + b * nsph_cd + ij;
+
+                if (rows.find(row) == rows.end()) continue;
+
+                std::string label = "skbuffer.data(" + std::to_string(row) + ")[0] = ";
+
+                bool first = true;
+
+                const auto m = static_cast<int>(ij) / nsph_d;
+
+                const auto n = static_cast<int>(ij) % nsph_d;
+
+                for (const auto& [cart_cd, coef] : t4c::spherical_pair_terms(integral[2], integral[3], m, n))
+                {
+                    if (!first) label += " + ";
+
+                    const auto unit = (coef.radicand == 1) && (coef.factor == Fraction(1));
+
+                    if (!unit) label += t4c::spherical_coef_label(coef) + " * ";
+
+                    label += source + ".data(" + std::to_string(cindex + b * ncart_cd + cart_cd) + ")[0]";
+
+                    first = false;
+                }
+
+                nrows++;
+
+                lines.push_back({2, 0, (nrows == rows.size()) ? 2 : 1, label + ";"});
+            }
+        }
+    }
+}
+
+void
+T4CFuncBodyDriver::_add_diag_bra_trafo_call_tree(      VCodeLines&  lines,
+                                                 const SI4CIntegrals& ket_integrals,
+                                                 const I4CIntegral&   integral) const
+{
+    const auto terms = _get_diag_terms(ket_integrals, integral);
+
+    const auto nsph_ab = terms.size();
+
+    // R(AB) components appearing in bra HRR terms
+
+    std::array<bool, 3> axes({false, false, false});
+
+    for (const auto& tterms : terms)
+    {
+        for (const auto& tterm : tterms)
+        {
+            for (int i = 0; i < 3; i++)
+            {
+                if (std::get<2>(tterm)[i] > 0) axes[i] = true;
+            }
+        }
+    }
+
+    const std::array<std::string, 3> labels({"ab_x", "ab_y", "ab_z"});
+
+    if (axes[0] || axes[1] || axes[2])
+    {
+        lines.push_back({2, 0, 2, "const auto xyz = r_ab.coordinates();"});
+
+        for (int i = 0; i < 3; i++)
+        {
+            if (axes[i]) lines.push_back({2, 0, 2, "const auto " + labels[i] + " = xyz[" + std::to_string(i) + "];"});
+        }
+    }
+
+    lines.push_back({2, 0, 1, "// bra HRR and transformation pruned to diagonal (ab|ab) spherical components"});
+
+    for (size_t ij = 0; ij < nsph_ab; ij++)
+    {
+        std::string label = "sbuffer.data(" + std::to_string(ij * nsph_ab + ij) + ")[0] = ";
+
+        bool first = true;
+
+        for (const auto& [row, coef, powers] : terms[ij])
+        {
+            if (!first) label += " + ";
+
+            const auto unit = (coef.radicand == 1) && (coef.factor == Fraction(1));
+
+            if (!unit) label += t4c::spherical_coef_label(coef) + " * ";
+
+            for (int i = 0; i < 3; i++)
+            {
+                for (int n = 0; n < powers[i]; n++) label += labels[i] + " * ";
+            }
+
+            label += "skbuffer.data(" + std::to_string(row) + ")[0]";
+
+            first = false;
+        }
+
+        if (first) label += "0.0";
+
+        lines.push_back({2, 0, ((ij + 1) == nsph_ab) ? 2 : 1, label + ";"});
+    }
 }
 
 void
@@ -2748,7 +3047,7 @@ T4CFuncBodyDriver::_get_index(const size_t         start,
     {
         if (tint == integral) return index;
         
-        index += tint.components<T2CPair, T2CPair>().size();
+        index += tint.number_of_components();
     }
     
     return 0;
@@ -2786,7 +3085,7 @@ T4CFuncBodyDriver::_get_all_components(const SI4CIntegrals& integrals) const
     
     for (const auto& tint : integrals)
     {
-        tcomps += tint.components<T2CPair, T2CPair>().size();
+        tcomps += tint.number_of_components();
     }
     
     return tcomps;
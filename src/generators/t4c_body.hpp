@@ -24,6 +24,8 @@
 
 #include "t4c_defs.hpp"
 #include "file_stream.hpp"
+#include "spherical_harmonics.hpp"
+#include "t4c_utils.hpp"
 
 // Four-center compute function body generators for CPU.
 class T4CFuncBodyDriver
@@ -155,15 +157,30 @@ class T4CFuncBodyDriver
                                                          const SI4CIntegrals& ket_integrals,
                                                          const I4CIntegral&   integral) const;
     
-    /// Generates vector of half transformed buffers in compute function.
-    /// @param bra_integrals The set of unique integrals for bra horizontal recursion.
+    /// Generates vector of half transformed buffers in diagonal compute function,
+    /// holding only (0b'|ab) integrals, since bra HRR is expanded in place.
     /// @param ket_integrals The set of unique integrals for ket horizontal recursion.
     /// @param integral The base two center integral.
     /// @return The vector of buffers in compute function.
-    std::vector<std::string> _get_diag_half_spher_buffers_def(const SI4CIntegrals& bra_integrals,
-                                                              const SI4CIntegrals& ket_integrals,
+    std::vector<std::string> _get_diag_half_spher_buffers_def(const SI4CIntegrals& ket_integrals,
                                                               const I4CIntegral&   integral) const;
     
+    /// Gets set of half transformed (0b'|ab) integrals of diagonal compute function.
+    /// @param ket_integrals The set of unique integrals for ket horizontal recursion.
+    /// @param integral The base two center integral.
+    /// @return The set of half transformed integrals.
+    SI4CIntegrals _get_diag_half_spher_buffers_integrals(const SI4CIntegrals& ket_integrals,
+                                                         const I4CIntegral&   integral) const;
+    
+    /// Gets terms of diagonal (ab|ab) spherical components: bra spherical components are
+    /// expanded into Cartesian ones and then by bra HRR, (a + 1_i, b| = (a, b + 1_i| - AB_i (a, b|,
+    /// into half transformed (0b'|ab) integrals.
+    /// @param ket_integrals The set of unique integrals for ket horizontal recursion.
+    /// @param integral The base two center integral.
+    /// @return The vector of terms for each diagonal component.
+    std::vector<std::vector<t4c::DiagTerm>> _get_diag_terms(const SI4CIntegrals& ket_integrals,
+                                                            const I4CIntegral&   integral) const;
+    
     /// Generates vector of half transformed buffers in compute function.
     /// @param integrals The set of unique integrals for ket horizontal recursion.
     /// @param integral The base two center integral.
@@ -378,6 +395,36 @@ class T4CFuncBodyDriver
                                   const I4CIntegral&   integral,
                                   const size_t         spacer) const;
     
+    /// Adds sparse ket side transformation of (ab|cd) integrals: only non-zero
+    /// Cartesian to spherical coefficients are applied, with equal coefficients
+    /// grouped, and half transformed integrals are assigned (not accumulated).
+    /// @param lines The code lines container to which transformation is added.
+    /// @param skindex The index of half transformed integrals in skbuffer.
+    /// @param source The label of buffer with Cartesian ket integrals.
+    /// @param cindex The index of Cartesian ket integrals in source buffer.
+    /// @param integral The transformed four center integral.
+    /// @param spacer The tabulation spacer.
+    void _add_sparse_ket_trafo(      VCodeLines&  lines,
+                               const size_t       skindex,
+                               const std::string& source,
+                               const size_t       cindex,
+                               const I4CIntegral& integral,
+                               const size_t       spacer) const;
+    
+    /// Adds vectorized loop assigning sparse sums to rows of target buffer.
+    /// @param lines The code lines container to which loop is added.
+    /// @param target The label of target buffer.
+    /// @param targets The row index expressions of target buffer.
+    /// @param suffix The suffix appended to every row index expression.
+    /// @param rows The sparse terms of every target row.
+    /// @param spacer The tabulation spacer.
+    void _add_sparse_rows(      VCodeLines&                                                            lines,
+                          const std::string&                                                     target,
+                          const std::vector<std::string>&                                        targets,
+                          const std::string&                                                     suffix,
+                          const std::vector<std::vector<std::pair<std::string, sphar::SphericalFactor>>>& rows,
+                          const size_t                                                           spacer) const;
+    
     /// Adds call tree for bra horizontal recursion.
     /// @param lines The code lines container to which loop start definition are added.
     /// @param bra_integrals The set of unique integrals for bra horizontal recursion.
@@ -407,16 +454,28 @@ class T4CFuncBodyDriver
                                   const SI4CIntegrals& ket_integrals,
                                   const I4CIntegral&   integral) const;
     
-    /// Adds call tree for bra side transformation.
-    /// @param lines The code lines container to which loop start definition are added.
+    /// Adds ket side transformation pruned to half transformed (0b'|ab) rows feeding
+    /// diagonal (ab|ab) spherical components; remaining rows are not computed.
+    /// @param lines The code lines container to which transformation is added.
     /// @param bra_integrals The set of unique integrals for bra horizontal recursion.
     /// @param ket_integrals The set of unique integrals for ket horizontal recursion.
     /// @param integral The base two center integral.
-    void _add_diag_bra_trafo_call_tree(      VCodeLines&  lines,
+    void _add_diag_ket_trafo_call_tree(      VCodeLines&  lines,
                                        const SI4CIntegrals& bra_integrals,
                                        const SI4CIntegrals& ket_integrals,
                                        const I4CIntegral&   integral) const;
     
+    /// Adds bra side HRR and transformation pruned to diagonal (ab|ab) spherical components.
+    /// Only spherical components with matching bra and ket indices are computed, directly
+    /// from half transformed (0b'|ab) integrals; remaining components of spherical buffer
+    /// stay zero.
+    /// @param lines The code lines container to which transformation is added.
+    /// @param ket_integrals The set of unique integrals for ket horizontal recursion.
+    /// @param integral The base two center integral.
+    void _add_diag_bra_trafo_call_tree(      VCodeLines&  lines,
+                                       const SI4CIntegrals& ket_integrals,
+                                       const I4CIntegral&   integral) const;
+    
     /// Adds call for full transformation.
     /// @param lines The code lines container to which loop start definition are added.
     /// @param integral The base two center integral.
@@ -17,6 +17,7 @@
 #include "t4c_cpu_generators.hpp"
 
 #include <iostream>
+#include <stdexcept>
 
 #include "string_formater.hpp"
 #include "file_stream.hpp"
@@ -106,11 +107,7 @@ T4CCPUGenerator::generate(const std::string& label,
     }
     else
     {
-        std::cerr << "*** ERROR *** Unsupported type of four-center integral: ";
-        
-        std::cerr << label << " !!!" << std::endl;
-        
-        std::exit(EXIT_FAILURE);
+        throw std::invalid_argument("Unsupported type of four-center integral: " + label);
     }
 }
 
@@ -17,6 +17,7 @@
 #include "t4c_diag_cpu_generators.hpp"
 
 #include <iostream>
+#include <stdexcept>
 
 #include "string_formater.hpp"
 #include "file_stream.hpp"
@@ -62,11 +63,7 @@ T4CDiagCPUGenerator::generate(const std::string& label,
     }
     else
     {
-        std::cerr << "*** ERROR *** Unsupported type of four-center integral: ";
-        
-        std::cerr << label << " !!!" << std::endl;
-        
-        std::exit(EXIT_FAILURE);
+        throw std::invalid_argument("Unsupported type of four-center integral: " + label);
     }
 }
 
@@ -196,7 +193,7 @@ T4CDiagCPUGenerator::_write_cpp_header(const SI4CIntegrals& bra_integrals,
     
     _write_hpp_defines(fstream, integral, true);
     
-    _write_hpp_includes(fstream, bra_integrals, ket_integrals, vrr_integrals, integral);
+    _write_hpp_includes(fstream, ket_integrals, vrr_integrals, integral);
     
     _write_namespace(fstream, integral, true);
     
@@ -246,13 +243,14 @@ T4CDiagCPUGenerator::_write_hpp_defines(      std::ofstream& fstream,
 
 void
 T4CDiagCPUGenerator::_write_hpp_includes(      std::ofstream& fstream,
-                                     const SI4CIntegrals& bra_integrals,
                                      const SI4CIntegrals& ket_integrals,
                                      const SI4CIntegrals& vrr_integrals,
                                      const I4CIntegral&   integral) const
 {
     auto lines = VCodeLines();
     
+    lines.push_back({0, 0, 1, "#include <cmath>"});
+    
     lines.push_back({0, 0, 1, "#include <cstddef>"});
     
     lines.push_back({0, 0, 1, "#include <vector>"});
@@ -277,14 +275,6 @@ T4CDiagCPUGenerator::_write_hpp_includes(      std::ofstream& fstream,
         }
     }
     
-    for (const auto& tint : bra_integrals)
-    {
-        if ((tint[0] > 0) && (tint[2] == integral[2]) && (tint[3] == integral[3]))
-        {
-            labels.insert(t4c::bra_hrr_file_name(tint));
-        }
-    }
-    
     for (const auto& label : labels)
     {
         lines.push_back({0, 0, 1, "#include \"" + label + ".hpp\""});
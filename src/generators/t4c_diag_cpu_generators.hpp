@@ -82,14 +82,13 @@ class T4CDiagCPUGenerator
                             const I4CIntegral&   integral,
                             const bool           start) const;
     
-    /// Writes definitions of includes for header file.
+    /// Writes definitions of includes for header file: diagonal kernels expand
+    /// bra horizontal recursion inline, so only ket recursions are included.
     /// @param fstream the file stream.
-    /// @param bra_integrals The set of unique integrals for bra horizontal recursion.
     /// @param ket_integrals The set of unique integrals for ket horizontal recursion.
     /// @param vrr_integrals The set of unique integrals for vertical recursion.
     /// @param integral The base two center integral.
     void _write_hpp_includes(      std::ofstream& fstream,
-                             const SI4CIntegrals& bra_integrals,
                              const SI4CIntegrals& ket_integrals,
                              const SI4CIntegrals& vrr_integrals,
                              const I4CIntegral&   integral) const;
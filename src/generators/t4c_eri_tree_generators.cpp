@@ -17,65 +17,164 @@
 #include "t4c_eri_tree_generators.hpp"
 
 #include <iostream>
+#include <algorithm>
+#include <stdexcept>
 
 #include "string_formater.hpp"
 #include "file_stream.hpp"
 
 #include "t4c_utils.hpp"
+#include "t2c_utils.hpp"
+#include "eri_cost_model.hpp"
+#include "v4i_eri_driver.hpp"
 
 void
 T4CCallTreeGenerator::generate(const std::string& label,
-                               const int          max_ang_mom) const
+                               const int          max_ang_mom,
+                               const int          max_geom_order) const
 {
-    std::string fname = "CallTreeFile.tmp";
-        
-    std::ofstream fstream;
-               
-    fstream.open(fname.c_str(), std::ios_base::trunc);
+    if (!_is_available(label))
+    {
+        throw std::invalid_argument("Unsupported type of four-center integral: " + label);
+    }
+    
+    // table entries run over (family, order, la, lb, lc, ld) with ld fastest; quadruples without
+    // compute function (la > lb for undifferentiated integrals, lc > ld) are left empty
+    
+    const auto labels = std::vector<std::string>({label});
+    
+    std::vector<std::pair<std::string, I4CIntegral>> entries;
     
     SI4CIntegrals integrals;
     
-    if (_is_available(label))
+    for (const auto& tlabel : labels)
     {
-        for (int i = 0; i <= max_ang_mom; i++)
+        for (int n = 0; n <= max_geom_order; n++)
         {
-            for (int j = i; j <= max_ang_mom; j++)
+            for (int i = 0; i <= max_ang_mom; i++)
             {
-                for (int k = 0; k <= max_ang_mom; k++)
+                for (int j = 0; j <= max_ang_mom; j++)
                 {
-                    for (int l = k; l <= max_ang_mom; l++)
+                    for (int k = 0; k <= max_ang_mom; k++)
                     {
-                        integrals.insert(_get_integral(label, {i, j, k, l}));
+                        for (int l = 0; l <= max_ang_mom; l++)
+                        {
+                            const auto integral = _get_integral(tlabel, {i, j, k, l}, n);
+                            
+                            if (((n == 0) && (i > j)) || (k > l))
+                            {
+                                entries.push_back({std::string(), integral});
+                            }
+                            else
+                            {
+                                entries.push_back({tlabel, integral});
+                                
+                                integrals.insert(integral);
+                            }
+                        }
                     }
                 }
             }
         }
     }
-
+    
+    std::string fname = "T4CDispatchTable.hpp";
+        
+    std::ofstream fstream;
+               
+    fstream.open(fname.c_str(), std::ios_base::trunc);
+    
     auto lines = VCodeLines();
     
+    lines.push_back({0, 0, 1, "#ifndef T4CDispatchTable_hpp"});
+    
+    lines.push_back({0, 0, 2, "#define T4CDispatchTable_hpp"});
+    
+    lines.push_back({0, 0, 1, "#include <array>"});
+    
+    lines.push_back({0, 0, 1, "#include <cstddef>"});
+    
+    lines.push_back({0, 0, 2, "#include <utility>"});
+    
+    lines.push_back({0, 0, 1, "#include \"GtoPairBlock.hpp\""});
+    
     for (const auto& integral : integrals)
     {
         lines.push_back({0, 0, 1, "#include \"" + _file_name(integral) + ".hpp\""});
     }
     
-    fstream << std::endl;
+    lines.push_back({0, 0, 1, ""});
     
-    for (const auto& integral : integrals)
+    lines.push_back({0, 0, 2, "namespace t4cdisp { // t4cdisp namespace"});
+    
+    ost::write_code_lines(fstream, lines);
+    
+    _write_table_defs(fstream, labels, max_ang_mom, max_geom_order);
+    
+    lines.clear();
+    
+    const auto nentries = std::to_string(entries.size());
+    
+    lines.push_back({0, 0, 1, "/// The compute functions indexed by index(family, order, la, lb, lc, ld), nullptr if not available."});
+    
+    lines.push_back({0, 0, 1, "template <class T>"});
+    
+    lines.push_back({0, 0, 1, "inline constexpr std::array<Kernel<T>, " + nentries + "> kernels = {"});
+    
+    for (size_t i = 0; i < entries.size(); i++)
     {
-        lines.push_back({0, 0, 1, "if ((bra_angmoms == std::array<int, 2>({" + std::to_string(integral[0]) + ", " + std::to_string(integral[1]) + "})) &&"});
+        const auto& [tlabel, integral] = entries[i];
         
-        lines.push_back({0, 0, 1, "    (ket_angmoms == std::array<int, 2>({" + std::to_string(integral[2]) + ", " + std::to_string(integral[3]) + "})))"});
+        const auto tsymbol = std::string(((i + 1) == entries.size()) ? "" : ",");
         
-        lines.push_back({0, 0, 1, "{"});
+        const auto comment = " // " + std::to_string(integral.prefixes_order().empty() ? 0 : integral.prefixes_order()[0]) + " " + integral.label();
         
-        lines.push_back({1, 0, 2, t4c::namespace_label(integral) + "::" + t4c::compute_func_name(integral) +  "(distributor, bra_gto_pair_block, ket_gto_pair_block, bra_range, ket_range);"});
+        if (tlabel.empty())
+        {
+            lines.push_back({1, 0, 1, "nullptr" + tsymbol + comment});
+        }
+        else
+        {
+            const auto func = "&" + t4c::namespace_label(integral) + "::" + t4c::compute_func_name(integral) + "<T>";
             
-        lines.push_back({1, 0, 1, "return;"});
+            if (integral.prefixes().empty())
+            {
+                lines.push_back({1, 0, 1, func + tsymbol + comment});
+            }
+            else
+            {
+                lines.push_back({1, 0, 1, "&without_bra_eq_ket<T, " + func + ">" + tsymbol + comment});
+            }
+        }
+    }
+    
+    lines.push_back({0, 0, 2, "};"});
+    
+    lines.push_back({0, 0, 1, "/// The cost metadata of compute functions indexed by index(family, order, la, lb, lc, ld)."});
+    
+    lines.push_back({0, 0, 1, "inline constexpr std::array<KernelCost, " + nentries + "> costs = {{"});
+    
+    for (size_t i = 0; i < entries.size(); i++)
+    {
+        const auto& [tlabel, integral] = entries[i];
+        
+        const auto tsymbol = std::string(((i + 1) == entries.size()) ? "" : ",");
         
-        lines.push_back({0, 0, 2, "}"});
+        lines.push_back({1, 0, 1, (tlabel.empty() ? std::string("{0, 0, 0, 0}") : _get_cost_str(integral)) + tsymbol});
     }
     
+    lines.push_back({0, 0, 2, "}};"});
+    
+    ost::write_code_lines(fstream, lines);
+    
+    _write_table_funcs(fstream);
+    
+    lines.clear();
+    
+    lines.push_back({0, 0, 2, "} // t4cdisp namespace"});
+    
+    lines.push_back({0, 0, 1, "#endif /* T4CDispatchTable_hpp */"});
+    
     ost::write_code_lines(fstream, lines);
     
     fstream.close();
@@ -91,19 +190,35 @@ T4CCallTreeGenerator::_is_available(const std::string& label) const
 
 I4CIntegral
 T4CCallTreeGenerator::_get_integral(const std::string&        label,
-                                    const std::array<int, 4>& ang_moms) const
+                                    const std::array<int, 4>& ang_moms,
+                                    const int                 geom_order) const
 {
     // bra and ket sides
 
     const auto bpair = I2CPair("GA", ang_moms[0], "GB", ang_moms[1]);
 
     const auto kpair = I2CPair("GC", ang_moms[2], "GD", ang_moms[3]);
+    
+    // geometrical derivatives on A center
+
+    VOperators prefixes;
+    
+    if (geom_order > 0)
+    {
+        prefixes.push_back(Operator("d/dR", Tensor(geom_order)));
+        
+        prefixes.push_back(Operator("d/dR", Tensor(0)));
+        
+        prefixes.push_back(Operator("d/dR", Tensor(0)));
+        
+        prefixes.push_back(Operator("d/dR", Tensor(0)));
+    }
 
     // electron repulsion integrals
 
     if (fstr::lowercase(label) == "electron repulsion")
     {
-        return I4CIntegral(bpair, kpair, Operator("1/|r-r'|"), 0, {});
+        return I4CIntegral(bpair, kpair, Operator("1/|r-r'|"), 0, prefixes);
     }
     
     return I4CIntegral();
@@ -116,3 +231,295 @@ T4CCallTreeGenerator::_file_name(const I4CIntegral& integral) const
     
     return t4c::integral_label(integral) + label;
 }
+
+std::string
+T4CCallTreeGenerator::_family_label(const std::string& label) const
+{
+    auto flabel = fstr::lowercase(label);
+    
+    std::replace(flabel.begin(), flabel.end(), ' ', '_');
+    
+    return flabel;
+}
+
+std::string
+T4CCallTreeGenerator::_get_cost_str(const I4CIntegral& integral) const
+{
+    const auto order = integral.prefixes_order().empty() ? 0 : integral.prefixes_order()[0];
+    
+    const auto gcomps = Tensor(order).number_of_components();
+    
+    const auto ang_moms = std::array<int, 4>({integral[0], integral[1], integral[2], integral[3]});
+    
+    const auto ccomps = gcomps * t2c::number_of_cartesian_components(ang_moms);
+    
+    const auto scomps = gcomps * t2c::number_of_spherical_components(ang_moms);
+    
+    const auto border = integral[0] + integral[1] + integral[2] + integral[3] + order;
+    
+    // operations are estimated for the dominant prefix-free (a + n, b|cd) integral of derivative expansion
+    
+    const auto tint = I4CIntegral(I2CPair("GA", integral[0] + order, "GB", integral[1]),
+                                  I2CPair("GC", integral[2], "GD", integral[3]),
+                                  integral.integrand(), 0, {});
+    
+    V4IElectronRepulsionDriver eri_drv;
+    
+    const auto bra_ints = eri_drv.create_bra_hrr_recursion({tint,});
+    
+    SI4CIntegrals ket_ints;
+    
+    for (const auto& bint : bra_ints)
+    {
+        if ((bint[0] == 0) && (bint[2] > 0))
+        {
+            const auto kints = eri_drv.create_ket_hrr_recursion({bint,});
+            
+            ket_ints.insert(kints.cbegin(), kints.cend());
+        }
+    }
+    
+    SI4CIntegrals base_ints;
+    
+    for (const auto& hint : bra_ints)
+    {
+        if ((hint[0] == 0) && (hint[2] == 0)) base_ints.insert(hint);
+    }
+    
+    for (const auto& hint : ket_ints)
+    {
+        if ((hint[0] == 0) && (hint[2] == 0)) base_ints.insert(hint);
+    }
+    
+    const auto flops = cost::obara_saika_flops(bra_ints, ket_ints, eri_drv.create_vrr_recursion(base_ints));
+    
+    return "{" + std::to_string(ccomps) + ", " + std::to_string(scomps) + ", " + std::to_string(border) + ", " + std::to_string(flops) + "}";
+}
+
+void
+T4CCallTreeGenerator::_write_table_defs(      std::ofstream&            fstream,
+                                        const std::vector<std::string>& labels,
+                                        const int                       max_ang_mom,
+                                        const int                       max_geom_order) const
+{
+    auto lines = VCodeLines();
+    
+    lines.push_back({0, 0, 1, "/// The integral families of dispatch table."});
+    
+    lines.push_back({0, 0, 1, "enum class Family : size_t"});
+    
+    lines.push_back({0, 0, 1, "{"});
+    
+    for (size_t i = 0; i < labels.size(); i++)
+    {
+        const auto tsymbol = std::string(((i + 1) == labels.size()) ? "" : ",");
+        
+        lines.push_back({1, 0, 1, _family_label(labels[i]) + " = " + std::to_string(i) + tsymbol});
+    }
+    
+    lines.push_back({0, 0, 2, "};"});
+    
+    lines.push_back({0, 0, 1, "/// The number of integral families in dispatch table."});
+    
+    lines.push_back({0, 0, 2, "inline constexpr size_t number_of_families = " + std::to_string(labels.size()) + ";"});
+    
+    lines.push_back({0, 0, 1, "/// The maximum angular momentum of A, B, C, and D centers in dispatch table."});
+    
+    lines.push_back({0, 0, 2, "inline constexpr int max_ang_mom = " + std::to_string(max_ang_mom) + ";"});
+    
+    lines.push_back({0, 0, 1, "/// The maximum order of geometrical derivative on A center in dispatch table."});
+    
+    lines.push_back({0, 0, 2, "inline constexpr int max_geom_order = " + std::to_string(max_geom_order) + ";"});
+    
+    lines.push_back({0, 0, 1, "/// The compute function of four-center integrals for bra and ket GTO pair blocks."});
+    
+    lines.push_back({0, 0, 1, "template <class T>"});
+    
+    lines.push_back({0, 0, 1, "using Kernel = void (*)(T&,"});
+    
+    lines.push_back({0, 0, 1, "                        const CGtoPairBlock&,"});
+    
+    lines.push_back({0, 0, 1, "                        const CGtoPairBlock&,"});
+    
+    lines.push_back({0, 0, 1, "                        const std::pair<size_t, size_t>&,"});
+    
+    lines.push_back({0, 0, 1, "                        const std::pair<size_t, size_t>&,"});
+    
+    lines.push_back({0, 0, 2, "                        const bool);"});
+    
+    lines.push_back({0, 0, 1, "/// The compile-time cost metadata of compute function."});
+    
+    lines.push_back({0, 0, 1, "struct KernelCost"});
+    
+    lines.push_back({0, 0, 1, "{"});
+    
+    lines.push_back({1, 0, 1, "/// The number of Cartesian components, including geometrical ones."});
+    
+    lines.push_back({1, 0, 2, "size_t cart_comps;"});
+    
+    lines.push_back({1, 0, 1, "/// The number of spherical components, including geometrical ones."});
+    
+    lines.push_back({1, 0, 2, "size_t spher_comps;"});
+    
+    lines.push_back({1, 0, 1, "/// The maximum order of Boys function."});
+    
+    lines.push_back({1, 0, 2, "int boys_order;"});
+    
+    lines.push_back({1, 0, 1, "/// The estimated number of floating point operations per primitive quadruple."});
+    
+    lines.push_back({1, 0, 1, "long flops;"});
+    
+    lines.push_back({0, 0, 2, "};"});
+    
+    lines.push_back({0, 0, 1, "/// Adapts compute function without bra/ket symmetry flag to dispatch table signature."});
+    
+    lines.push_back({0, 0, 1, "template <class T, void (*F)(T&, const CGtoPairBlock&, const CGtoPairBlock&, const std::pair<size_t, size_t>&, const std::pair<size_t, size_t>&)>"});
+    
+    lines.push_back({0, 0, 1, "inline auto"});
+    
+    lines.push_back({0, 0, 1, "without_bra_eq_ket(T& distributor,"});
+    
+    lines.push_back({0, 0, 1, "                   const CGtoPairBlock& bra_gto_pair_block,"});
+    
+    lines.push_back({0, 0, 1, "                   const CGtoPairBlock& ket_gto_pair_block,"});
+    
+    lines.push_back({0, 0, 1, "                   const std::pair<size_t, size_t>& bra_range,"});
+    
+    lines.push_back({0, 0, 1, "                   const std::pair<size_t, size_t>& ket_range,"});
+    
+    lines.push_back({0, 0, 1, "                   const bool) -> void"});
+    
+    lines.push_back({0, 0, 1, "{"});
+    
+    lines.push_back({1, 0, 1, "F(distributor, bra_gto_pair_block, ket_gto_pair_block, bra_range, ket_range);"});
+    
+    lines.push_back({0, 0, 2, "}"});
+    
+    lines.push_back({0, 0, 1, "/// Gets position of compute function in dispatch table."});
+    
+    lines.push_back({0, 0, 1, "constexpr auto"});
+    
+    lines.push_back({0, 0, 1, "index(const Family family, const int order, const int la, const int lb, const int lc, const int ld) -> size_t"});
+    
+    lines.push_back({0, 0, 1, "{"});
+    
+    lines.push_back({1, 0, 1, "constexpr size_t nang = max_ang_mom + 1;"});
+    
+    lines.push_back({0, 0, 1, ""});
+    
+    lines.push_back({1, 0, 1, "const auto forder = static_cast<size_t>(family) * (max_geom_order + 1) + static_cast<size_t>(order);"});
+    
+    lines.push_back({0, 0, 1, ""});
+    
+    lines.push_back({1, 0, 1, "return (((forder * nang + la) * nang + lb) * nang + lc) * nang + ld;"});
+    
+    lines.push_back({0, 0, 2, "}"});
+    
+    ost::write_code_lines(fstream, lines);
+}
+
+void
+T4CCallTreeGenerator::_write_table_funcs(std::ofstream& fstream) const
+{
+    auto lines = VCodeLines();
+    
+    lines.push_back({0, 0, 1, "/// Checks if family, derivative order, and angular momenta are within dispatch table."});
+    
+    lines.push_back({0, 0, 1, "constexpr auto"});
+    
+    lines.push_back({0, 0, 1, "in_table(const Family family, const int order, const int la, const int lb, const int lc, const int ld) -> bool"});
+    
+    lines.push_back({0, 0, 1, "{"});
+    
+    lines.push_back({1, 0, 1, "if (static_cast<size_t>(family) >= number_of_families) return false;"});
+    
+    lines.push_back({0, 0, 1, ""});
+    
+    lines.push_back({1, 0, 1, "if ((order < 0) || (order > max_geom_order)) return false;"});
+    
+    lines.push_back({0, 0, 1, ""});
+    
+    lines.push_back({1, 0, 1, "for (const auto angmom : {la, lb, lc, ld})"});
+    
+    lines.push_back({1, 0, 1, "{"});
+    
+    lines.push_back({2, 0, 1, "if ((angmom < 0) || (angmom > max_ang_mom)) return false;"});
+    
+    lines.push_back({1, 0, 2, "}"});
+    
+    lines.push_back({1, 0, 1, "return true;"});
+    
+    lines.push_back({0, 0, 2, "}"});
+    
+    lines.push_back({0, 0, 1, "/// Gets compute function for family, derivative order, and angular momenta, nullptr if not available."});
+    
+    lines.push_back({0, 0, 1, "template <class T>"});
+    
+    lines.push_back({0, 0, 1, "constexpr auto"});
+    
+    lines.push_back({0, 0, 1, "kernel(const Family family, const int order, const int la, const int lb, const int lc, const int ld) -> Kernel<T>"});
+    
+    lines.push_back({0, 0, 1, "{"});
+    
+    lines.push_back({1, 0, 1, "return in_table(family, order, la, lb, lc, ld) ? kernels<T>[index(family, order, la, lb, lc, ld)] : nullptr;"});
+    
+    lines.push_back({0, 0, 2, "}"});
+    
+    lines.push_back({0, 0, 1, "/// Gets cost metadata for family, derivative order, and angular momenta, zero if not available."});
+    
+    lines.push_back({0, 0, 1, "constexpr auto"});
+    
+    lines.push_back({0, 0, 1, "cost(const Family family, const int order, const int la, const int lb, const int lc, const int ld) -> KernelCost"});
+    
+    lines.push_back({0, 0, 1, "{"});
+    
+    lines.push_back({1, 0, 1, "return in_table(family, order, la, lb, lc, ld) ? costs[index(family, order, la, lb, lc, ld)] : KernelCost{0, 0, 0, 0};"});
+    
+    lines.push_back({0, 0, 2, "}"});
+    
+    lines.push_back({0, 0, 1, "/// Computes four-center integrals for bra and ket GTO pair blocks by table lookup."});
+    
+    lines.push_back({0, 0, 1, "/// @return True if compute function is available, false otherwise."});
+    
+    lines.push_back({0, 0, 1, "template <class T>"});
+    
+    lines.push_back({0, 0, 1, "inline auto"});
+    
+    lines.push_back({0, 0, 1, "compute(T& distributor,"});
+    
+    lines.push_back({0, 0, 1, "        const Family family,"});
+    
+    lines.push_back({0, 0, 1, "        const int order,"});
+    
+    lines.push_back({0, 0, 1, "        const std::array<int, 2>& bra_angmoms,"});
+    
+    lines.push_back({0, 0, 1, "        const std::array<int, 2>& ket_angmoms,"});
+    
+    lines.push_back({0, 0, 1, "        const CGtoPairBlock& bra_gto_pair_block,"});
+    
+    lines.push_back({0, 0, 1, "        const CGtoPairBlock& ket_gto_pair_block,"});
+    
+    lines.push_back({0, 0, 1, "        const std::pair<size_t, size_t>& bra_range,"});
+    
+    lines.push_back({0, 0, 1, "        const std::pair<size_t, size_t>& ket_range,"});
+    
+    lines.push_back({0, 0, 1, "        const bool bra_eq_ket) -> bool"});
+    
+    lines.push_back({0, 0, 1, "{"});
+    
+    lines.push_back({1, 0, 1, "if (const auto func = kernel<T>(family, order, bra_angmoms[0], bra_angmoms[1], ket_angmoms[0], ket_angmoms[1]))"});
+    
+    lines.push_back({1, 0, 1, "{"});
+    
+    lines.push_back({2, 0, 2, "func(distributor, bra_gto_pair_block, ket_gto_pair_block, bra_range, ket_range, bra_eq_ket);"});
+    
+    lines.push_back({2, 0, 1, "return true;"});
+    
+    lines.push_back({1, 0, 2, "}"});
+    
+    lines.push_back({1, 0, 1, "return false;"});
+    
+    lines.push_back({0, 0, 2, "}"});
+    
+    ost::write_code_lines(fstream, lines);
+}
@@ -26,7 +26,7 @@
 
 #include "t4c_defs.hpp"
 
-// Geometrical derivatives of four-center integrals code generator for CPU.
+// Dispatch table of four-center integrals code generator for CPU.
 class T4CCallTreeGenerator
 {
     /// Checks if recursion is available for four-center inetgral with given label.
@@ -36,24 +36,54 @@ class T4CCallTreeGenerator
     /// Gets four-center inetgral with requested label.
     /// @param label The label of requested four-center integral.
     /// @param ang_moms The angular momentum of  A, B, C, and D centers.
+    /// @param geom_order The order of geometrical derivative on A center.
     /// @return The four-center integral.
     I4CIntegral _get_integral(const std::string&        label,
-                              const std::array<int, 4>& ang_moms) const;
+                              const std::array<int, 4>& ang_moms,
+                              const int                 geom_order) const;
     
     /// Gets file name of file with recursion functions for two center integral.
     /// @param integral The base two center integral.
     /// @return The file name.
     std::string _file_name(const I4CIntegral& integral) const;
+    
+    /// Gets enumerator label of integral family.
+    /// @param label The label of four-center integral.
+    /// @return The enumerator label.
+    std::string _family_label(const std::string& label) const;
+    
+    /// Generates cost metadata initializer of compute function.
+    /// @param integral The four-center integral.
+    /// @return The initializer of cost metadata.
+    std::string _get_cost_str(const I4CIntegral& integral) const;
+    
+    /// Writes definitions of types and indexing functions of dispatch table.
+    /// @param fstream the file stream.
+    /// @param labels The labels of integral families.
+    /// @param max_ang_mom The maximum angular momentum of A, B, C and D centers.
+    /// @param max_geom_order The maximum order of geometrical derivative.
+    void _write_table_defs(      std::ofstream&            fstream,
+                           const std::vector<std::string>& labels,
+                           const int                       max_ang_mom,
+                           const int                       max_geom_order) const;
+    
+    /// Writes lookup and dispatch functions of dispatch table.
+    /// @param fstream the file stream.
+    void _write_table_funcs(std::ofstream& fstream) const;
         
 public:
     /// Creates a geometrical derivatives of four-center integrals CPU code generator.
     T4CCallTreeGenerator() = default;
      
-    /// Generates call tree for selected four-center integrals up to given angular momentum (inclusive)  on A, B, C, and D centers.
+    /// Generates dispatch table for selected four-center integrals up to given angular momentum (inclusive)  on A, B, C, and D centers.
+    /// The table is a constexpr array of compute function pointers indexed by integral family, order of geometrical derivative on
+    /// A center, and angular momenta (la, lb, lc, ld), with matching array of compile-time cost metadata.
     /// @param label The label of requested two-center integral.
     /// @param max_ang_mom The maximum angular momentum of A, B, C and D centers.
+    /// @param max_geom_order The maximum order of geometrical derivative on A center.
     void generate(const std::string& label,
-                  const int          max_ang_mom) const;
+                  const int          max_ang_mom,
+                  const int          max_geom_order) const;
 };
 
 #endif /* t4c_eri_tree_generators_hpp */
@@ -13,18 +13,141 @@ T4CGeomFuncBodyDriver::write_func_body(      std::ofstream& fstream,
                                        const SG4Terms&      ckterms,
                                        const SG4Terms&      skterms,
                                        const SI4CIntegrals& vrr_integrals,
+                                       const I4CIntegral&   integral,
+                                       const int            prim_screening) const
+{
+    auto lines = VCodeLines();
+    
+    lines.push_back({0, 0, 1, "{"});
+    
+    for (const auto& label : _get_gto_pairs_def(false))
+    {
+        lines.push_back({1, 0, 2, label});
+    }
+    
+    for (const auto& label : _get_ket_variables_def(integral, false))
+    {
+        lines.push_back({1, 0, 2, label});
+    }
+    
+    for (const auto& label : _get_prim_buffers_def(vrr_integrals, integral))
+    {
+        lines.push_back({1, 0, 2, label});
+    }
+    
+    for (const auto& label : _get_cart_buffers_def(cterms, integral, false))
+    {
+        lines.push_back({1, 0, 2, label});
+    }
+   
+    for (const auto& label : _get_contr_buffers_def(ckterms, integral, false))
+    {
+        lines.push_back({1, 0, 2, label});
+    }
+    
+    for (const auto& label : _get_half_spher_buffers_def(skterms, integral, false))
+    {
+        lines.push_back({1, 0, 2, label});
+    }
+    
+    for (const auto& label : _get_spher_buffers_def(integral, false))
+    {
+        lines.push_back({1, 0, 2, label});
+    }
+    
+    for (const auto& label : _get_boys_function_def(integral, "distributor"))
+    {
+        lines.push_back({1, 0, 2, label});
+    }
+    
+    _add_loop_start(lines, integral, prim_screening, true);
+    
+    _add_ket_loop_start(lines, integral, prim_screening);
+    
+    _add_auxilary_integrals(lines, vrr_integrals, integral, 4);
+    
+    _add_vrr_call_tree(lines, vrr_integrals, integral, 4);
+    
+    _add_ket_loop_end(lines, cterms, vrr_integrals, integral, false);
+
+    _add_ket_hrr_call_tree(lines, cterms, ckterms, integral, 3);
+
+    _add_ket_trafo_call_tree(lines, cterms, ckterms, skterms, integral, 3);
+
+    _add_bra_hrr_call_tree(lines, skterms, integral, 3);
+    
+    _add_bra_geom_hrr_call_tree(lines, skterms, integral, 3);
+    
+    _add_bra_trafo_call_tree(lines, skterms, integral);
+    
+    _add_loop_end(lines, integral);
+    
+    lines.push_back({0, 0, 1, "}"});
+    
+    ost::write_code_lines(fstream, lines);
+}
+
+void
+T4CGeomFuncBodyDriver::write_func_body(      std::ofstream& fstream,
+                                       const SI4CIntegrals& geom_integrals,
                                        const I4CIntegral&   integral) const
 {
     auto lines = VCodeLines();
     
     lines.push_back({0, 0, 1, "{"});
     
-    for (const auto& label : _get_gto_pairs_def())
+    lines.push_back({1, 0, 2, "const auto ndims = " + t4c::get_geom_buffer_label(integral) + ".number_of_active_elements();"});
+    
+    for (const auto& label : _get_buffers_str(geom_integrals, integral))
+    {
+        lines.push_back({1, 0, 2, label});
+    }
+    
+    // derivatives of base integral are computed in blocks of base integral components
+    
+    const auto components = integral.components<T2CPair, T2CPair>();
+    
+    const auto rgroup = _generate_integral_group(components, integral);
+    
+    const auto bcomps = static_cast<int>(integral.base().components<T2CPair, T2CPair>().size());
+    
+    const auto ncomps = static_cast<int>(rgroup.expansions());
+    
+    for (int i = 0; i < ncomps; i += bcomps)
+    {
+        _add_recursion_loop(lines, rgroup, integral, {i, std::min(i + bcomps, ncomps)});
+        
+        if ((i + bcomps) < ncomps) lines.push_back({0, 0, 1, ""});
+    }
+    
+    lines.push_back({0, 0, 1, "}"});
+    
+    ost::write_code_lines(fstream, lines);
+}
+
+void
+T4CGeomFuncBodyDriver::write_fused_func_body(      std::ofstream&            fstream,
+                                             const SG4Terms&                 cterms,
+                                             const SG4Terms&                 ckterms,
+                                             const SG4Terms&                 skterms,
+                                             const SI4CIntegrals&            vrr_integrals,
+                                             const std::vector<I4CIntegral>& integrals,
+                                             const int                       prim_screening) const
+{
+    // ket factors, Boys function orders, and loops are set up for widest integral
+    
+    const auto integral = _get_anchor_integral(integrals);
+    
+    auto lines = VCodeLines();
+    
+    lines.push_back({0, 0, 1, "{"});
+    
+    for (const auto& label : _get_gto_pairs_def(false))
     {
         lines.push_back({1, 0, 2, label});
     }
     
-    for (const auto& label : _get_ket_variables_def(integral))
+    for (const auto& label : _get_ket_variables_def(integral, false))
     {
         lines.push_back({1, 0, 2, label});
     }
@@ -34,40 +157,126 @@ T4CGeomFuncBodyDriver::write_func_body(      std::ofstream& fstream,
         lines.push_back({1, 0, 2, label});
     }
     
-    for (const auto& label : _get_cart_buffers_def(cterms, integral))
+    for (const auto& label : _get_cart_buffers_def(cterms, integral, false))
     {
         lines.push_back({1, 0, 2, label});
     }
    
-    for (const auto& label : _get_contr_buffers_def(ckterms, integral))
+    for (const auto& label : _get_contr_buffers_def(ckterms, integral, false))
     {
         lines.push_back({1, 0, 2, label});
     }
     
-    for (const auto& label : _get_half_spher_buffers_def(skterms, integral))
+    for (const auto& label : _get_half_spher_buffers_def(skterms, integral, false))
     {
         lines.push_back({1, 0, 2, label});
     }
     
-    for (const auto& label : _get_spher_buffers_def(integral))
+    for (const auto& label : _get_fused_spher_buffers_def(integrals))
     {
         lines.push_back({1, 0, 2, label});
     }
     
-    for (const auto& label : _get_boys_function_def(integral))
+    // range separation factor is taken from first distributor
+    
+    for (const auto& label : _get_boys_function_def(integral, t4c::distributor_label(integrals.front())))
     {
         lines.push_back({1, 0, 2, label});
     }
     
-    _add_loop_start(lines, integral);
+    _add_loop_start(lines, integral, prim_screening, true);
     
-    _add_ket_loop_start(lines, integral);
+    _add_ket_loop_start(lines, integral, prim_screening);
     
     _add_auxilary_integrals(lines, vrr_integrals, integral, 4);
     
     _add_vrr_call_tree(lines, vrr_integrals, integral, 4);
     
-    _add_ket_loop_end(lines, cterms, vrr_integrals, integral);
+    _add_ket_loop_end(lines, cterms, vrr_integrals, integral, false);
+
+    _add_ket_hrr_call_tree(lines, cterms, ckterms, integral, 3);
+
+    _add_ket_trafo_call_tree(lines, cterms, ckterms, skterms, integral, 3);
+
+    _add_bra_hrr_call_tree(lines, skterms, integral, 3);
+    
+    _add_bra_geom_hrr_call_tree(lines, skterms, integral, 3);
+    
+    _add_fused_bra_trafo_call_tree(lines, skterms, integrals);
+    
+    _add_loop_end(lines, integral);
+    
+    lines.push_back({0, 0, 1, "}"});
+    
+    ost::write_code_lines(fstream, lines);
+}
+
+void
+T4CGeomFuncBodyDriver::write_flat_func_body(      std::ofstream& fstream,
+                                            const SG4Terms&      cterms,
+                                            const SG4Terms&      ckterms,
+                                            const SG4Terms&      skterms,
+                                            const SI4CIntegrals& vrr_integrals,
+                                            const I4CIntegral&   integral,
+                                            const int            prim_screening) const
+{
+    auto lines = VCodeLines();
+    
+    lines.push_back({0, 0, 1, "{"});
+    
+    for (const auto& label : _get_gto_pairs_def(true))
+    {
+        lines.push_back({1, 0, 2, label});
+    }
+    
+    _add_flat_ket_lanes(lines);
+    
+    for (const auto& label : _get_ket_variables_def(integral, true))
+    {
+        lines.push_back({1, 0, 2, label});
+    }
+    
+    for (const auto& label : _get_prim_buffers_def(vrr_integrals, integral))
+    {
+        lines.push_back({1, 0, 2, label});
+    }
+    
+    for (const auto& label : _get_cart_buffers_def(cterms, integral, true))
+    {
+        lines.push_back({1, 0, 2, label});
+    }
+   
+    for (const auto& label : _get_contr_buffers_def(ckterms, integral, true))
+    {
+        lines.push_back({1, 0, 2, label});
+    }
+    
+    for (const auto& label : _get_half_spher_buffers_def(skterms, integral, true))
+    {
+        lines.push_back({1, 0, 2, label});
+    }
+    
+    for (const auto& label : _get_spher_buffers_def(integral, true))
+    {
+        lines.push_back({1, 0, 2, label});
+    }
+    
+    for (const auto& label : _get_boys_function_def(integral, "distributor"))
+    {
+        lines.push_back({1, 0, 2, label});
+    }
+    
+    _add_flat_loop_start(lines, integral, prim_screening);
+    
+    _add_ket_loop_start(lines, integral, prim_screening);
+    
+    _add_auxilary_integrals(lines, vrr_integrals, integral, 4);
+    
+    _add_vrr_call_tree(lines, vrr_integrals, integral, 4);
+    
+    // primitive lanes are contracted by segmented reduction
+    
+    _add_ket_loop_end(lines, cterms, vrr_integrals, integral, true);
 
     _add_ket_hrr_call_tree(lines, cterms, ckterms, integral, 3);
 
@@ -79,6 +288,90 @@ T4CGeomFuncBodyDriver::write_func_body(      std::ofstream& fstream,
     
     _add_bra_trafo_call_tree(lines, skterms, integral);
     
+    _add_flat_loop_end(lines);
+    
+    lines.push_back({0, 0, 1, "}"});
+    
+    ost::write_code_lines(fstream, lines);
+}
+
+void
+T4CGeomFuncBodyDriver::write_jk_func_body(      std::ofstream& fstream,
+                                          const SG4Terms&      cterms,
+                                          const SG4Terms&      ckterms,
+                                          const SG4Terms&      skterms,
+                                          const SI4CIntegrals& vrr_integrals,
+                                          const I4CIntegral&   integral,
+                                          const int            prim_screening) const
+{
+    auto lines = VCodeLines();
+    
+    lines.push_back({0, 0, 1, "{"});
+    
+    for (const auto& label : _get_gto_pairs_def(false))
+    {
+        lines.push_back({1, 0, 2, label});
+    }
+    
+    lines.push_back({1, 0, 2, "// strides of spherical components in accumulator indexing"});
+    
+    for (const auto& center : {"a", "b", "c", "d"})
+    {
+        lines.push_back({1, 0, (center[0] == 'd') ? 2 : 1, "const auto " + std::string(center) + "_dim = " + std::string(center) + "_indices[0];"});
+    }
+    
+    for (const auto& label : _get_ket_variables_def(integral, false))
+    {
+        lines.push_back({1, 0, 2, label});
+    }
+    
+    for (const auto& label : _get_prim_buffers_def(vrr_integrals, integral))
+    {
+        lines.push_back({1, 0, 2, label});
+    }
+    
+    for (const auto& label : _get_cart_buffers_def(cterms, integral, false))
+    {
+        lines.push_back({1, 0, 2, label});
+    }
+   
+    for (const auto& label : _get_contr_buffers_def(ckterms, integral, false))
+    {
+        lines.push_back({1, 0, 2, label});
+    }
+    
+    for (const auto& label : _get_half_spher_buffers_def(skterms, integral, false))
+    {
+        lines.push_back({1, 0, 2, label});
+    }
+    
+    for (const auto& label : _get_boys_function_def(integral, "accumulator"))
+    {
+        lines.push_back({1, 0, 2, label});
+    }
+    
+    // spherical integrals are accumulated directly, so sbuffer is never sized or zeroed
+    
+    _add_loop_start(lines, integral, prim_screening, false);
+    
+    _add_ket_loop_start(lines, integral, prim_screening);
+    
+    _add_auxilary_integrals(lines, vrr_integrals, integral, 4);
+    
+    _add_vrr_call_tree(lines, vrr_integrals, integral, 4);
+    
+    _add_ket_loop_end(lines, cterms, vrr_integrals, integral, false);
+
+    _add_ket_hrr_call_tree(lines, cterms, ckterms, integral, 3);
+
+    _add_ket_trafo_call_tree(lines, cterms, ckterms, skterms, integral, 3);
+
+    _add_bra_hrr_call_tree(lines, skterms, integral, 3);
+    
+    _add_bra_geom_hrr_call_tree(lines, skterms, integral, 3);
+    
+    _add_jk_bra_trafo_call_tree(lines, skterms, integral);
+    
     _add_loop_end(lines, integral);
     
     lines.push_back({0, 0, 1, "}"});
@@ -87,7 +380,7 @@ T4CGeomFuncBodyDriver::write_func_body(      std::ofstream& fstream,
 }
 
 std::vector<std::string>
-T4CGeomFuncBodyDriver::_get_gto_pairs_def() const
+T4CGeomFuncBodyDriver::_get_gto_pairs_def(const bool flat_lanes) const
 {
     std::vector<std::string> vstr;
     
@@ -112,6 +405,10 @@ T4CGeomFuncBodyDriver::_get_gto_pairs_def() const
     vstr.push_back("const auto bra_ncgtos = bra_gto_pair_block.number_of_contracted_pairs();");
         
     vstr.push_back("const auto bra_npgtos = bra_gto_pair_block.number_of_primitive_pairs();");
+    
+    // ket side data of flattened ket lanes is set up from all ket pair blocks
+    
+    if (flat_lanes) return vstr;
         
     vstr.push_back("// intialize GTOs data on ket side");
         
@@ -137,7 +434,8 @@ T4CGeomFuncBodyDriver::_get_gto_pairs_def() const
 }
 
 std::vector<std::string>
-T4CGeomFuncBodyDriver::_get_ket_variables_def(const I4CIntegral& integral) const
+T4CGeomFuncBodyDriver::_get_ket_variables_def(const I4CIntegral& integral,
+                                              const bool         flat_lanes) const
 {
     std::vector<std::string> vstr;
     
@@ -159,7 +457,7 @@ T4CGeomFuncBodyDriver::_get_ket_variables_def(const I4CIntegral& integral) const
   
     if (_need_hrr_for_ket(integral))
     {
-        vstr.push_back("CSimdArray<double> cfactors(9, 1);");
+        vstr.push_back("CSimdArray<double> cfactors(9, " + _get_columns_str(flat_lanes) + ");");
     }
     
     return vstr;
@@ -302,7 +600,7 @@ T4CGeomFuncBodyDriver::_get_index(const size_t         start,
     {
         if (tint == integral) return index;
         
-        index += tint.components<T2CPair, T2CPair>().size();
+        index += tint.number_of_components();
     }
     
     return 0;
@@ -318,7 +616,7 @@ T4CGeomFuncBodyDriver::_get_index(const G4Term&   term,
     {
         if (term == cterm) return index;
         
-        index += cterm.second.components<T2CPair, T2CPair>().size();
+        index += cterm.second.number_of_components();
     }
     
     return 0;
@@ -384,7 +682,7 @@ T4CGeomFuncBodyDriver::_get_half_spher_index(const G4Term&   term,
         
         for (const auto& prefix : tint.prefixes())
         {
-            icomps *= prefix.components().size();
+            icomps *= prefix.number_of_components();
         }
         
         index += icomps;
@@ -414,7 +712,7 @@ T4CGeomFuncBodyDriver::_get_geom_half_spher_index(const size_t         start,
         
         for (const auto& prefix : tint.prefixes())
         {
-            icomps *= prefix.components().size();
+            icomps *= prefix.number_of_components();
         }
         
         index += icomps;
@@ -450,11 +748,11 @@ T4CGeomFuncBodyDriver::_get_buffers_str(const SI4CIntegrals& geom_integrals,
         
         int index = 0;
         
-        for (const auto& tcomp : tint.components<T2CPair, T2CPair>())
+        for (const auto& tcomp : tint.component_range<T2CPair, T2CPair>())
         {
             const auto line = "auto " + _get_component_label(tcomp) + " = " + label;
                 
-            vstr.push_back(line + "[" + std::to_string(index) + "];");
+            vstr.push_back(line + ".data(" + std::to_string(index) + ");");
             
             index++;
         }
@@ -466,11 +764,11 @@ T4CGeomFuncBodyDriver::_get_buffers_str(const SI4CIntegrals& geom_integrals,
     
     int index = 0;
     
-    for (const auto& tcomp : integral.components<T2CPair, T2CPair>())
+    for (const auto& tcomp : integral.component_range<T2CPair, T2CPair>())
     {
         const auto line = "auto " + _get_component_label(tcomp) + " = " + label;
             
-        vstr.push_back(line + "[" + std::to_string(index) + "];");
+        vstr.push_back(line + ".data(" + std::to_string(index) + ");");
         
         index++;
     }
@@ -656,7 +954,8 @@ T4CGeomFuncBodyDriver::_get_prim_buffers_def(const SI4CIntegrals& integrals,
 
 std::vector<std::string>
 T4CGeomFuncBodyDriver::_get_cart_buffers_def(const SG4Terms&    cterms,
-                                             const I4CIntegral& integral) const
+                                             const I4CIntegral& integral,
+                                             const bool         flat_lanes) const
 {
     std::vector<std::string> vstr;
     
@@ -666,12 +965,12 @@ T4CGeomFuncBodyDriver::_get_cart_buffers_def(const SG4Terms&    cterms,
     
     for (const auto& term : cterms)
     {
-        tcomps += term.second.components<T2CPair, T2CPair>().size();
+        tcomps += term.second.number_of_components();
     }
     
     std::string label = "CSimdArray<double> cbuffer";
     
-    label += "(" + std::to_string(tcomps) + ", 1);";
+    label += "(" + std::to_string(tcomps) + ", " + _get_columns_str(flat_lanes) + ");";
     
     vstr.push_back(label);
     
@@ -680,7 +979,8 @@ T4CGeomFuncBodyDriver::_get_cart_buffers_def(const SG4Terms&    cterms,
 
 std::vector<std::string>
 T4CGeomFuncBodyDriver::_get_contr_buffers_def(const SG4Terms&    ckterms,
-                                              const I4CIntegral& integral) const
+                                              const I4CIntegral& integral,
+                                              const bool         flat_lanes) const
 {
     std::vector<std::string> vstr;
     
@@ -688,7 +988,7 @@ T4CGeomFuncBodyDriver::_get_contr_buffers_def(const SG4Terms&    ckterms,
     
     for (const auto& term : ckterms)
     {
-        tcomps += term.second.components<T2CPair, T2CPair>().size();
+        tcomps += term.second.number_of_components();
     }
     
     if (tcomps > 0)
@@ -697,7 +997,7 @@ T4CGeomFuncBodyDriver::_get_contr_buffers_def(const SG4Terms&    ckterms,
         
         std::string label = "CSimdArray<double> ";
         
-        label += "ckbuffer(" + std::to_string(tcomps) + ", 1);";
+        label += "ckbuffer(" + std::to_string(tcomps) + ", " + _get_columns_str(flat_lanes) + ");";
         
         vstr.push_back(label);
     }
@@ -748,7 +1048,8 @@ T4CGeomFuncBodyDriver::_get_contr_buffers_integrals(const SI4CIntegrals& integra
 
 std::vector<std::string>
 T4CGeomFuncBodyDriver::_get_half_spher_buffers_def(const SG4Terms&    skterms,
-                                                   const I4CIntegral& integral) const
+                                                   const I4CIntegral& integral,
+                                                   const bool         flat_lanes) const
 {
     std::vector<std::string> vstr;
     
@@ -770,7 +1071,7 @@ T4CGeomFuncBodyDriver::_get_half_spher_buffers_def(const SG4Terms&    skterms,
         
         for (const auto& prefix : tint.prefixes())
         {
-            icomps *= prefix.components().size();
+            icomps *= prefix.number_of_components();
         }
         
         tcomps += icomps;
@@ -778,7 +1079,7 @@ T4CGeomFuncBodyDriver::_get_half_spher_buffers_def(const SG4Terms&    skterms,
     
     std::string label = "CSimdArray<double> ";
             
-    label += "skbuffer(" + std::to_string(tcomps) + ", 1);";
+    label += "skbuffer(" + std::to_string(tcomps) + ", " + _get_columns_str(flat_lanes) + ");";
             
     vstr.push_back(label);
         
@@ -786,7 +1087,8 @@ T4CGeomFuncBodyDriver::_get_half_spher_buffers_def(const SG4Terms&    skterms,
 }
 
 std::vector<std::string>
-T4CGeomFuncBodyDriver::_get_spher_buffers_def(const I4CIntegral& integral) const
+T4CGeomFuncBodyDriver::_get_spher_buffers_def(const I4CIntegral& integral,
+                                              const bool         flat_lanes) const
 {
     std::vector<std::string> vstr;
     
@@ -802,7 +1104,57 @@ T4CGeomFuncBodyDriver::_get_spher_buffers_def(const I4CIntegral& integral) const
     
     for (const auto& prefix : integral.prefixes())
     {
-        tcomps *= prefix.components().size();
+        tcomps *= prefix.number_of_components();
+    }
+    
+    std::string label = "CSimdArray<double> ";
+                    
+    label += "sbuffer(" + std::to_string(tcomps) + ", " + _get_columns_str(flat_lanes) + ");";
+                    
+    vstr.push_back(label);
+   
+    return vstr;
+}
+
+I4CIntegral
+T4CGeomFuncBodyDriver::_get_anchor_integral(const std::vector<I4CIntegral>& integrals) const
+{
+    // ket side derivatives require ket horizontal recursion and (Q-D) distances for any angular momentum
+    
+    auto anchor = integrals.front();
+    
+    for (const auto& tint : integrals)
+    {
+        const auto aorders = anchor.prefixes_order();
+        
+        const auto torders = tint.prefixes_order();
+        
+        const auto akorder = aorders[2] + aorders[3];
+        
+        const auto tkorder = torders[2] + torders[3];
+        
+        const auto aorder = aorders[0] + aorders[1] + akorder;
+        
+        const auto torder = torders[0] + torders[1] + tkorder;
+        
+        if ((tkorder > akorder) || ((tkorder == akorder) && (torder > aorder))) anchor = tint;
+    }
+    
+    return anchor;
+}
+
+std::vector<std::string>
+T4CGeomFuncBodyDriver::_get_fused_spher_buffers_def(const std::vector<I4CIntegral>& integrals) const
+{
+    std::vector<std::string> vstr;
+    
+    vstr.push_back("// allocate aligned spherical integrals");
+    
+    size_t tcomps = 0;
+    
+    for (const auto& integral : integrals)
+    {
+        tcomps += _get_all_spher_components(integral);
     }
     
     std::string label = "CSimdArray<double> ";
@@ -815,7 +1167,8 @@ T4CGeomFuncBodyDriver::_get_spher_buffers_def(const I4CIntegral& integral) const
 }
 
 std::vector<std::string>
-T4CGeomFuncBodyDriver::_get_boys_function_def(const I4CIntegral& integral) const
+T4CGeomFuncBodyDriver::_get_boys_function_def(const I4CIntegral& integral,
+                                              const std::string& omega_source) const
 {
     std::vector<std::string> vstr;
     
@@ -832,55 +1185,322 @@ T4CGeomFuncBodyDriver::_get_boys_function_def(const I4CIntegral& integral) const
 
     vstr.push_back("CSimdArray<double> bf_data(" + std::to_string(order + 2) + ", ket_npgtos);");
     
-    vstr.push_back("// set up range seperation factor");
-
-    vstr.push_back("const auto use_rs = distributor.need_omega();");
+    vstr.push_back("// set up range seperation factor");
+
+    vstr.push_back("const auto use_rs = " + omega_source + ".need_omega();");
+
+    vstr.push_back("const auto omega = " + omega_source + ".get_omega();");
+       
+    return vstr;
+}
+
+void
+T4CGeomFuncBodyDriver::_add_loop_start(      VCodeLines&    lines,
+                                       const I4CIntegral&   integral,
+                                       const int            prim_screening,
+                                       const bool           use_sbuffer) const
+{
+    lines.push_back({1, 0, 2, "// set up ket partitioning"});
+
+    lines.push_back({1, 0, 2, "const auto ket_dim = ket_indices.second - ket_indices.first;"});
+
+    lines.push_back({1, 0, 2, "const auto ket_blocks = batch::number_of_batches(ket_dim, simd::width<double>());"});
+
+    lines.push_back({1, 0, 1, "for (size_t i = 0; i < ket_blocks; i++)"});
+                    
+    lines.push_back({1, 0, 1, "{"});
+    
+    lines.push_back({2, 0, 2, "auto ket_range = batch::batch_range(i, ket_dim, simd::width<double>(), ket_indices.first);"});
+
+    lines.push_back({2, 0, 2, "pfactors.load(c_vec_exps, ket_range, 0, ket_npgtos);"});
+    
+    lines.push_back({2, 0, 2, "pfactors.load(d_vec_exps, ket_range, 1, ket_npgtos);"});
+ 
+    lines.push_back({2, 0, 2, "pfactors.load(cd_vec_ovls, ket_range, 2, ket_npgtos);"});
+    
+    lines.push_back({2, 0, 2, "pfactors.load(cd_vec_norms, ket_range, 3, ket_npgtos);"});
+    
+    lines.push_back({2, 0, 2, "pfactors.replicate_points(c_coords, ket_range, 4, ket_npgtos);"});
+    
+    lines.push_back({2, 0, 2, "pfactors.replicate_points(d_coords, ket_range, 7, ket_npgtos);"});
+    
+    if (_need_hrr_for_ket(integral))
+    {
+        lines.push_back({2, 0, 2, "cfactors.replicate_points(c_coords, ket_range, 0, 1);"});
+        
+        lines.push_back({2, 0, 2, "cfactors.replicate_points(d_coords, ket_range, 3, 1);"});
+        
+        lines.push_back({2, 0, 2, "t4cfunc::comp_distances_cd(cfactors, 6, 0, 3);"});
+    }
+   
+    lines.push_back({2, 0, 2, "// set up active SIMD width"});
+    
+    lines.push_back({2, 0, 2, "const auto ket_width = ket_range.second - ket_range.first;"});
+    
+    lines.push_back({2, 0, 2, "pbuffer.set_active_width(ket_width);"});
+    
+    lines.push_back({2, 0, 2, "cbuffer.set_active_width(ket_width);"});
+    
+    if (_need_hrr_for_ket(integral))
+    {
+        lines.push_back({2, 0, 2, "ckbuffer.set_active_width(ket_width);"});
+    }
+    
+    lines.push_back({2, 0, 2, "skbuffer.set_active_width(ket_width);"});
+    
+    if (use_sbuffer)
+    {
+        lines.push_back({2, 0, 2, "sbuffer.set_active_width(ket_width);"});
+    }
+    
+    lines.push_back({2, 0, 2, "bf_data.set_active_width(ket_width);"});
+      
+    if (prim_screening > 0)
+    {
+        _add_prim_screening_bound(lines);
+    }
+    
+    _add_bra_loop_start(lines, integral, use_sbuffer);
+}
+
+void
+T4CGeomFuncBodyDriver::_add_loop_end(      VCodeLines&  lines,
+                                     const I4CIntegral& integral) const
+{
+    lines.push_back({2, 0, 1, "}"});
+   
+    lines.push_back({1, 0, 2, "}"});
+}
+
+void
+T4CGeomFuncBodyDriver::_add_prim_screening_bound(VCodeLines& lines) const
+{
+    // (ss|ss) = 2 / sqrt(pi) S_ab N_ab S_cd N_cd sqrt(pq / (p + q)) F_0(T) and sqrt(pq / (p + q)) <= min(sqrt(p), sqrt(q)),
+    // so the ket side of bound is reduced over batch once for either branch of the minimum
+    
+    lines.push_back({2, 0, 1, "// screen primitive pairs: largest ket primitive pair prefactors in batch"});
+    
+    lines.push_back({2, 0, 2, "const auto c_exps = pfactors.data(0);"});
+    
+    lines.push_back({2, 0, 2, "const auto d_exps = pfactors.data(1);"});
+    
+    lines.push_back({2, 0, 2, "const auto cd_ovls = pfactors.data(2);"});
+    
+    lines.push_back({2, 0, 2, "const auto cd_norms = pfactors.data(3);"});
+    
+    lines.push_back({2, 0, 2, "const auto cd_nelems = pbuffer.number_of_active_elements();"});
+    
+    lines.push_back({2, 0, 2, "double cd_fmax = 0.0;"});
+    
+    lines.push_back({2, 0, 2, "double cd_qmax = 0.0;"});
+    
+    lines.push_back({2, 0, 1, "#pragma omp simd aligned(c_exps, d_exps, cd_ovls, cd_norms : 64) reduction(max : cd_fmax, cd_qmax)"});
+    
+    lines.push_back({2, 0, 1, "for (size_t l = 0; l < cd_nelems; l++)"});
+    
+    lines.push_back({2, 0, 1, "{"});
+    
+    lines.push_back({3, 0, 2, "const auto fss = std::fabs(cd_ovls[l] * cd_norms[l]);"});
+    
+    lines.push_back({3, 0, 2, "const auto fqs = fss * std::sqrt(c_exps[l] + d_exps[l]);"});
+    
+    lines.push_back({3, 0, 2, "cd_fmax = (fss > cd_fmax) ? fss : cd_fmax;"});
+    
+    lines.push_back({3, 0, 1, "cd_qmax = (fqs > cd_qmax) ? fqs : cd_qmax;"});
+    
+    lines.push_back({2, 0, 2, "}"});
+}
+
+void
+T4CGeomFuncBodyDriver::_add_bra_loop_start(      VCodeLines&  lines,
+                                           const I4CIntegral& integral,
+                                           const bool         use_sbuffer) const
+{
+    lines.push_back({2, 0, 2, "// loop over basis function pairs on bra side"});
+
+    lines.push_back({2, 0, 1, "for (auto j = bra_indices.first; j < bra_indices.second; j++)"});
+
+    lines.push_back({2, 0, 1, "{"});
+    
+    lines.push_back({3, 0, 2, "// zero integral buffers"});
+    
+    lines.push_back({3, 0, 2, "cbuffer.zero();"});
+    
+    if (_need_hrr_for_ket(integral))
+    {
+        lines.push_back({3, 0, 2, "ckbuffer.zero();"});
+    }
+    
+    lines.push_back({3, 0, 2, "skbuffer.zero();"});
+    
+    if (use_sbuffer)
+    {
+        lines.push_back({3, 0, 2, "sbuffer.zero();"});
+    }
+
+    lines.push_back({3, 0, 2, "// set up coordinates on bra side"});
+
+    lines.push_back({3, 0, 2, "const auto r_a = a_coords[j];"});
+    
+    lines.push_back({3, 0, 2, "const auto r_b = b_coords[j];"});
+    
+    lines.push_back({3, 0, 2, "const auto a_xyz = r_a.coordinates();"});
+    
+    lines.push_back({3, 0, 2, "const auto b_xyz = r_b.coordinates();"});
+
+    if (_need_hrr_for_bra(integral))
+    {
+        lines.push_back({3, 0, 2, "const auto r_ab = TPoint<double>({a_xyz[0] - b_xyz[0], a_xyz[1] - b_xyz[1], a_xyz[2] - b_xyz[2]});"});
+    }
+}
+
+void
+T4CGeomFuncBodyDriver::_add_flat_ket_lanes(VCodeLines& lines) const
+{
+    lines.push_back({1, 0, 1, "// flatten primitive lanes of ket pairs: ket blocks share angular momenta and are sorted"});
+    
+    lines.push_back({1, 0, 2, "// by number of primitive pairs, primitive lanes of each contracted pair are contiguous"});
+    
+    lines.push_back({1, 0, 2, "std::vector<TPoint<double>> c_coords;"});
+    
+    lines.push_back({1, 0, 2, "std::vector<TPoint<double>> d_coords;"});
+    
+    lines.push_back({1, 0, 2, "std::vector<double> c_lane_exps;"});
+    
+    lines.push_back({1, 0, 2, "std::vector<double> d_lane_exps;"});
+    
+    lines.push_back({1, 0, 2, "std::vector<double> cd_lane_norms;"});
+    
+    lines.push_back({1, 0, 2, "std::vector<double> cd_lane_ovls;"});
+    
+    lines.push_back({1, 0, 2, "std::vector<size_t> ket_lane_pairs;"});
+    
+    lines.push_back({1, 0, 2, "std::vector<size_t> ket_offsets({0});"});
+    
+    lines.push_back({1, 0, 1, "// leading entries of orbital indices, which do not belong to pairs, are taken from first ket block"});
+    
+    lines.push_back({1, 0, 2, "const auto ket_ncgtos = ket_gto_pair_blocks.front().number_of_contracted_pairs();"});
+    
+    lines.push_back({1, 0, 2, "auto c_indices = ket_gto_pair_blocks.front().bra_orbital_indices();"});
+    
+    lines.push_back({1, 0, 2, "auto d_indices = ket_gto_pair_blocks.front().ket_orbital_indices();"});
+    
+    lines.push_back({1, 0, 2, "c_indices.resize(c_indices.size() - ket_ncgtos);"});
+    
+    lines.push_back({1, 0, 2, "d_indices.resize(d_indices.size() - ket_ncgtos);"});
+    
+    lines.push_back({1, 0, 2, "size_t ket_npgtos = 1;"});
+    
+    lines.push_back({1, 0, 1, "for (const auto& ket_gto_pair_block : ket_gto_pair_blocks)"});
+    
+    lines.push_back({1, 0, 1, "{"});
+    
+    lines.push_back({2, 0, 2, "const auto block_c_coords = ket_gto_pair_block.bra_coordinates();"});
+    
+    lines.push_back({2, 0, 2, "const auto block_d_coords = ket_gto_pair_block.ket_coordinates();"});
+    
+    lines.push_back({2, 0, 2, "const auto block_c_exps = ket_gto_pair_block.bra_exponents();"});
+    
+    lines.push_back({2, 0, 2, "const auto block_d_exps = ket_gto_pair_block.ket_exponents();"});
+    
+    lines.push_back({2, 0, 2, "const auto block_cd_norms = ket_gto_pair_block.normalization_factors();"});
+    
+    lines.push_back({2, 0, 2, "const auto block_cd_ovls = ket_gto_pair_block.overlap_factors();"});
+    
+    lines.push_back({2, 0, 2, "const auto block_c_indices = ket_gto_pair_block.bra_orbital_indices();"});
+    
+    lines.push_back({2, 0, 2, "const auto block_d_indices = ket_gto_pair_block.ket_orbital_indices();"});
+    
+    lines.push_back({2, 0, 2, "const auto ncgtos = ket_gto_pair_block.number_of_contracted_pairs();"});
+    
+    lines.push_back({2, 0, 2, "const auto npgtos = ket_gto_pair_block.number_of_primitive_pairs();"});
+    
+    lines.push_back({2, 0, 2, "const auto c_start = block_c_indices.size() - ncgtos;"});
+    
+    lines.push_back({2, 0, 2, "const auto d_start = block_d_indices.size() - ncgtos;"});
+    
+    lines.push_back({2, 0, 1, "for (size_t m = 0; m < ncgtos; m++)"});
+    
+    lines.push_back({2, 0, 1, "{"});
+    
+    lines.push_back({3, 0, 1, "for (size_t k = 0; k < npgtos; k++)"});
+    
+    lines.push_back({3, 0, 1, "{"});
+    
+    lines.push_back({4, 0, 2, "c_lane_exps.push_back(block_c_exps[k * ncgtos + m]);"});
+    
+    lines.push_back({4, 0, 2, "d_lane_exps.push_back(block_d_exps[k * ncgtos + m]);"});
+    
+    lines.push_back({4, 0, 2, "cd_lane_norms.push_back(block_cd_norms[k * ncgtos + m]);"});
+    
+    lines.push_back({4, 0, 2, "cd_lane_ovls.push_back(block_cd_ovls[k * ncgtos + m]);"});
+    
+    lines.push_back({4, 0, 1, "ket_lane_pairs.push_back(c_coords.size());"});
+    
+    lines.push_back({3, 0, 2, "}"});
+    
+    lines.push_back({3, 0, 2, "c_coords.push_back(block_c_coords[m]);"});
+    
+    lines.push_back({3, 0, 2, "d_coords.push_back(block_d_coords[m]);"});
+    
+    lines.push_back({3, 0, 2, "c_indices.push_back(block_c_indices[c_start + m]);"});
+    
+    lines.push_back({3, 0, 2, "d_indices.push_back(block_d_indices[d_start + m]);"});
+    
+    lines.push_back({3, 0, 1, "ket_offsets.push_back(ket_offsets.back() + npgtos);"});
+    
+    lines.push_back({2, 0, 2, "}"});
+    
+    lines.push_back({2, 0, 1, "ket_npgtos = std::max(ket_npgtos, npgtos);"});
+    
+    lines.push_back({1, 0, 2, "}"});
+    
+    lines.push_back({1, 0, 2, "const auto ket_dim = c_coords.size();"});
+}
 
-    vstr.push_back("const auto omega = distributor.get_omega();");
-       
-    return vstr;
+std::string
+T4CGeomFuncBodyDriver::_get_columns_str(const bool flat_lanes) const
+{
+    // contracted buffers hold up to SIMD width times ket_npgtos pairs of flattened batch
+    
+    return (flat_lanes) ? "ket_npgtos" : "1";
 }
 
 void
-T4CGeomFuncBodyDriver::_add_loop_start(      VCodeLines&    lines,
-                                       const I4CIntegral&   integral) const
+T4CGeomFuncBodyDriver::_add_flat_loop_start(      VCodeLines&  lines,
+                                            const I4CIntegral& integral,
+                                            const int          prim_screening) const
 {
-    lines.push_back({1, 0, 2, "// set up ket partitioning"});
+    lines.push_back({1, 0, 2, "// set up ket partitioning: batch packs contracted pairs while their primitive lanes fit"});
 
-    lines.push_back({1, 0, 2, "const auto ket_dim = ket_indices.second - ket_indices.first;"});
-
-    lines.push_back({1, 0, 2, "const auto ket_blocks = batch::number_of_batches(ket_dim, simd::width<double>());"});
+    lines.push_back({1, 0, 2, "const auto ket_lanes = simd::width<double>() * ket_npgtos;"});
+    
+    lines.push_back({1, 0, 2, "size_t ket_first = 0;"});
 
-    lines.push_back({1, 0, 1, "for (size_t i = 0; i < ket_blocks; i++)"});
+    lines.push_back({1, 0, 1, "while (ket_first < ket_dim)"});
                     
     lines.push_back({1, 0, 1, "{"});
     
-    lines.push_back({2, 0, 2, "auto ket_range = batch::batch_range(i, ket_dim, simd::width<double>(), ket_indices.first);"});
-
-    lines.push_back({2, 0, 2, "pfactors.load(c_vec_exps, ket_range, 0, ket_npgtos);"});
+    lines.push_back({2, 0, 2, "auto ket_last = ket_first + 1;"});
     
-    lines.push_back({2, 0, 2, "pfactors.load(d_vec_exps, ket_range, 1, ket_npgtos);"});
- 
-    lines.push_back({2, 0, 2, "pfactors.load(cd_vec_ovls, ket_range, 2, ket_npgtos);"});
+    lines.push_back({2, 0, 2, "while ((ket_last < ket_dim) && ((ket_offsets[ket_last + 1] - ket_offsets[ket_first]) <= ket_lanes)) ket_last++;"});
     
-    lines.push_back({2, 0, 2, "pfactors.load(cd_vec_norms, ket_range, 3, ket_npgtos);"});
+    lines.push_back({2, 0, 2, "const auto ket_range = std::pair<size_t, size_t>{ket_first, ket_last};"});
     
-    lines.push_back({2, 0, 2, "pfactors.replicate_points(c_coords, ket_range, 4, ket_npgtos);"});
+    lines.push_back({2, 0, 2, "const auto lane_first = ket_offsets[ket_first];"});
     
-    lines.push_back({2, 0, 2, "pfactors.replicate_points(d_coords, ket_range, 7, ket_npgtos);"});
+    lines.push_back({2, 0, 2, "const auto lane_last = ket_offsets[ket_last];"});
+    
+    lines.push_back({2, 0, 2, "// set up active SIMD width: primitive lanes are padded to multiple of ket_npgtos"});
+    
+    lines.push_back({2, 0, 2, "const auto ket_width = batch::number_of_batches(lane_last - lane_first, ket_npgtos);"});
+    
+    lines.push_back({2, 0, 2, "pfactors.set_active_width(ket_width);"});
     
     if (_need_hrr_for_ket(integral))
     {
-        lines.push_back({2, 0, 2, "cfactors.replicate_points(c_coords, ket_range, 0, 1);"});
-        
-        lines.push_back({2, 0, 2, "cfactors.replicate_points(d_coords, ket_range, 3, 1);"});
-        
-        lines.push_back({2, 0, 2, "t4cfunc::comp_distances_cd(cfactors, 6, 0, 3);"});
+        lines.push_back({2, 0, 2, "cfactors.set_active_width(ket_width);"});
     }
-   
-    lines.push_back({2, 0, 2, "// set up active SIMD width"});
-    
-    lines.push_back({2, 0, 2, "const auto ket_width = ket_range.second - ket_range.first;"});
     
     lines.push_back({2, 0, 2, "pbuffer.set_active_width(ket_width);"});
     
@@ -896,54 +1516,142 @@ T4CGeomFuncBodyDriver::_add_loop_start(      VCodeLines&    lines,
     lines.push_back({2, 0, 2, "sbuffer.set_active_width(ket_width);"});
     
     lines.push_back({2, 0, 2, "bf_data.set_active_width(ket_width);"});
-      
-    lines.push_back({2, 0, 2, "// loop over basis function pairs on bra side"});
-
-    lines.push_back({2, 0, 1, "for (auto j = bra_indices.first; j < bra_indices.second; j++)"});
-
+    
+    lines.push_back({2, 0, 2, "// load primitive lanes, padding lanes repeat last lane with zero normalization factor"});
+    
+    lines.push_back({2, 0, 2, "const auto ket_nelems = pfactors.number_of_active_elements();"});
+    
+    lines.push_back({2, 0, 1, "for (size_t l = 0; l < ket_nelems; l++)"});
+    
     lines.push_back({2, 0, 1, "{"});
     
-    lines.push_back({3, 0, 2, "// zero integral buffers"});
+    lines.push_back({3, 0, 2, "const auto m = std::min(lane_first + l, lane_last - 1);"});
     
-    lines.push_back({3, 0, 2, "cbuffer.zero();"});
+    lines.push_back({3, 0, 2, "const auto c_xyz = c_coords[ket_lane_pairs[m]].coordinates();"});
+    
+    lines.push_back({3, 0, 2, "const auto d_xyz = d_coords[ket_lane_pairs[m]].coordinates();"});
+    
+    lines.push_back({3, 0, 2, "pfactors.data(0)[l] = c_lane_exps[m];"});
+    
+    lines.push_back({3, 0, 2, "pfactors.data(1)[l] = d_lane_exps[m];"});
+    
+    lines.push_back({3, 0, 2, "pfactors.data(2)[l] = cd_lane_ovls[m];"});
+    
+    lines.push_back({3, 0, 2, "pfactors.data(3)[l] = ((lane_first + l) < lane_last) ? cd_lane_norms[m] : 0.0;"});
+    
+    for (int i = 0; i < 3; i++)
+    {
+        lines.push_back({3, 0, 2, "pfactors.data(" + std::to_string(4 + i) + ")[l] = c_xyz[" + std::to_string(i) + "];"});
+    }
+    
+    for (int i = 0; i < 3; i++)
+    {
+        lines.push_back({3, 0, (i < 2) ? 2 : 1, "pfactors.data(" + std::to_string(7 + i) + ")[l] = d_xyz[" + std::to_string(i) + "];"});
+    }
+    
+    lines.push_back({2, 0, 2, "}"});
     
     if (_need_hrr_for_ket(integral))
     {
-        lines.push_back({3, 0, 2, "ckbuffer.zero();"});
+        lines.push_back({2, 0, 2, "const auto cd_dims = cfactors.number_of_active_elements();"});
+        
+        lines.push_back({2, 0, 1, "for (size_t l = 0; l < cd_dims; l++)"});
+        
+        lines.push_back({2, 0, 1, "{"});
+        
+        lines.push_back({3, 0, 2, "const auto m = std::min(ket_first + l, ket_last - 1);"});
+        
+        lines.push_back({3, 0, 2, "const auto c_xyz = c_coords[m].coordinates();"});
+        
+        lines.push_back({3, 0, 2, "const auto d_xyz = d_coords[m].coordinates();"});
+        
+        for (int i = 0; i < 3; i++)
+        {
+            lines.push_back({3, 0, 2, "cfactors.data(" + std::to_string(i) + ")[l] = c_xyz[" + std::to_string(i) + "];"});
+        }
+        
+        for (int i = 0; i < 3; i++)
+        {
+            lines.push_back({3, 0, (i < 2) ? 2 : 1, "cfactors.data(" + std::to_string(3 + i) + ")[l] = d_xyz[" + std::to_string(i) + "];"});
+        }
+        
+        lines.push_back({2, 0, 2, "}"});
+        
+        lines.push_back({2, 0, 2, "t4cfunc::comp_distances_cd(cfactors, 6, 0, 3);"});
     }
     
-    lines.push_back({3, 0, 2, "skbuffer.zero();"});
+    lines.push_back({2, 0, 1, "// segmented reduction of primitive lanes into contracted pairs of batch"});
     
-    lines.push_back({3, 0, 2, "sbuffer.zero();"});
-
-    lines.push_back({3, 0, 2, "// set up coordinates on bra side"});
-
-    lines.push_back({3, 0, 2, "const auto r_a = a_coords[j];"});
+    lines.push_back({2, 0, 1, "const auto reduce_lanes = [&](const size_t cindex, const size_t pindex, const size_t ncomps) -> void"});
     
-    lines.push_back({3, 0, 2, "const auto r_b = b_coords[j];"});
+    lines.push_back({2, 0, 1, "{"});
     
-    lines.push_back({3, 0, 2, "const auto a_xyz = r_a.coordinates();"});
+    lines.push_back({3, 0, 1, "for (size_t n = 0; n < ncomps; n++)"});
     
-    lines.push_back({3, 0, 2, "const auto b_xyz = r_b.coordinates();"});
+    lines.push_back({3, 0, 1, "{"});
+    
+    lines.push_back({4, 0, 2, "auto cvals = cbuffer.data(cindex + n);"});
+    
+    lines.push_back({4, 0, 2, "const auto pvals = pbuffer.data(pindex + n);"});
+    
+    lines.push_back({4, 0, 1, "for (auto m = ket_range.first; m < ket_range.second; m++)"});
+    
+    lines.push_back({4, 0, 1, "{"});
+    
+    lines.push_back({5, 0, 1, "for (auto l = ket_offsets[m]; l < ket_offsets[m + 1]; l++)"});
+    
+    lines.push_back({5, 0, 1, "{"});
+    
+    lines.push_back({6, 0, 1, "cvals[m - ket_range.first] += pvals[l - lane_first];"});
+    
+    lines.push_back({5, 0, 1, "}"});
+    
+    lines.push_back({4, 0, 1, "}"});
+    
+    lines.push_back({3, 0, 1, "}"});
+    
+    lines.push_back({2, 0, 2, "};"});
+      
+    if (prim_screening > 0)
+    {
+        _add_prim_screening_bound(lines);
+    }
+    
+    _add_bra_loop_start(lines, integral, true);
+}
 
-    if (_need_hrr_for_bra(integral))
+std::string
+T4CGeomFuncBodyDriver::_get_reduce_str(const size_t cindex,
+                                       const size_t pindex,
+                                       const size_t ncomps,
+                                       const bool   flat_lanes) const
+{
+    if (flat_lanes)
     {
-        lines.push_back({3, 0, 2, "const auto r_ab = TPoint<double>({a_xyz[0] - b_xyz[0], a_xyz[1] - b_xyz[1], a_xyz[2] - b_xyz[2]});"});
+        return "reduce_lanes(" + std::to_string(cindex) + ", " + std::to_string(pindex) + ", " + std::to_string(ncomps) + ");";
     }
+    
+    std::string label = "t2cfunc::reduce(cbuffer, " + std::to_string(cindex) + ", pbuffer, ";
+    
+    label += std::to_string(pindex) + ", " + std::to_string(ncomps) + ", ket_width, ket_npgtos);";
+    
+    return label;
 }
 
 void
-T4CGeomFuncBodyDriver::_add_loop_end(      VCodeLines&  lines,
-                                     const I4CIntegral& integral) const
+T4CGeomFuncBodyDriver::_add_flat_loop_end(VCodeLines& lines) const
 {
-    lines.push_back({2, 0, 1, "}"});
+    lines.push_back({2, 0, 2, "}"});
+    
+    lines.push_back({2, 0, 1, "ket_first = ket_last;"});
    
     lines.push_back({1, 0, 2, "}"});
 }
 
 void
 T4CGeomFuncBodyDriver::_add_ket_loop_start(      VCodeLines&  lines,
-                                           const I4CIntegral& integral) const
+                                           const I4CIntegral& integral,
+                                           const int          prim_screening) const
 {
     auto geom_orders = integral.prefixes_order();
     
@@ -959,6 +1667,15 @@ T4CGeomFuncBodyDriver::_add_ket_loop_start(      VCodeLines&  lines,
         
     lines.push_back({4, 0, 2, "const auto ab_ovl = ab_vec_ovls[k * bra_ncgtos + j];"});
     
+    if (prim_screening > 0)
+    {
+        lines.push_back({4, 0, 1, "// screen primitive pairs: skip bra primitive pair if (ss|ss) bound is negligible for all ket primitive pairs"});
+        
+        lines.push_back({4, 0, 2, "const auto fbound = 1.1283791670955126 * std::fabs(ab_ovl * ab_norm) * std::min(std::sqrt(a_exp + b_exp) * cd_fmax, cd_qmax);"});
+        
+        lines.push_back({4, 0, 2, "if (fbound < 1.0e-" + std::to_string(prim_screening) + ") continue;"});
+    }
+    
     lines.push_back({4, 0, 2, "const auto p_x = (a_xyz[0] * a_exp + b_xyz[0] * b_exp) / (a_exp + b_exp);"});
     
     lines.push_back({4, 0, 2, "const auto p_y = (a_xyz[1] * a_exp + b_xyz[1] * b_exp) / (a_exp + b_exp);"});
@@ -1045,7 +1762,8 @@ void
 T4CGeomFuncBodyDriver::_add_ket_loop_end(      VCodeLines&    lines,
                                          const SG4Terms&      cterms,
                                          const SI4CIntegrals& vrr_integrals,
-                                         const I4CIntegral&   integral) const
+                                         const I4CIntegral&   integral,
+                                         const bool           flat_lanes) const
 {
     // non-scaled integrals
     
@@ -1055,17 +1773,7 @@ T4CGeomFuncBodyDriver::_add_ket_loop_end(      VCodeLines&    lines,
         {
             const auto tint = term.second;
             
-            std::string label = "t2cfunc::reduce(cbuffer, ";
-                
-            label +=  std::to_string(_get_index(term, cterms)) + ", ";
-                
-            label += "pbuffer, ";
-                
-            label += std::to_string(_get_index(0, tint, vrr_integrals)) + ", ";
-                
-            label += std::to_string(tint.components<T2CPair, T2CPair>().size()) + ", ";
-                
-            label += "ket_width, ket_npgtos);";
+            const auto label = _get_reduce_str(_get_index(term, cterms), _get_index(0, tint, vrr_integrals), tint.number_of_components(), flat_lanes);
                 
             lines.push_back({4, 0, 2, label});
         }
@@ -1083,7 +1791,7 @@ T4CGeomFuncBodyDriver::_add_ket_loop_end(      VCodeLines&    lines,
            
             label +=  std::to_string(_get_index(0, tint, vrr_integrals)) + ", ";
            
-            label +=  std::to_string(_get_index(0, tint, vrr_integrals) + tint.components<T2CPair, T2CPair>().size()) + "});";
+            label +=  std::to_string(_get_index(0, tint, vrr_integrals) + tint.number_of_components()) + "});";
            
             lines.push_back({4, 0, 2, label});
         }
@@ -1095,17 +1803,7 @@ T4CGeomFuncBodyDriver::_add_ket_loop_end(      VCodeLines&    lines,
         {
             const auto tint = term.second;
             
-            std::string label = "t2cfunc::reduce(cbuffer, ";
-                
-            label +=  std::to_string(_get_index(term, cterms)) + ", ";
-                
-            label += "pbuffer, ";
-                
-            label += std::to_string(_get_index(0, tint, vrr_integrals)) + ", ";
-                
-            label += std::to_string(tint.components<T2CPair, T2CPair>().size()) + ", ";
-                
-            label += "ket_width, ket_npgtos);";
+            const auto label = _get_reduce_str(_get_index(term, cterms), _get_index(0, tint, vrr_integrals), tint.number_of_components(), flat_lanes);
                 
             lines.push_back({4, 0, 2, label});
         }
@@ -1134,7 +1832,7 @@ T4CGeomFuncBodyDriver::_add_ket_loop_end(      VCodeLines&    lines,
            
             label +=  std::to_string(_get_index(0, tint, vrr_integrals)) + ", ";
            
-            label +=  std::to_string(_get_index(0, tint, vrr_integrals) + tint.components<T2CPair, T2CPair>().size()) + "});";
+            label +=  std::to_string(_get_index(0, tint, vrr_integrals) + tint.number_of_components()) + "});";
            
             lines.push_back({4, 0, 2, label});
         }
@@ -1146,17 +1844,7 @@ T4CGeomFuncBodyDriver::_add_ket_loop_end(      VCodeLines&    lines,
         {
             const auto tint = term.second;
             
-            std::string label = "t2cfunc::reduce(cbuffer, ";
-                
-            label +=  std::to_string(_get_index(term, cterms)) + ", ";
-                
-            label += "pbuffer, ";
-                
-            label += std::to_string(_get_index(0, tint, vrr_integrals)) + ", ";
-                
-            label += std::to_string(tint.components<T2CPair, T2CPair>().size()) + ", ";
-                
-            label += "ket_width, ket_npgtos);";
+            const auto label = _get_reduce_str(_get_index(term, cterms), _get_index(0, tint, vrr_integrals), tint.number_of_components(), flat_lanes);
                 
             lines.push_back({4, 0, 2, label});
         }
@@ -1185,7 +1873,7 @@ T4CGeomFuncBodyDriver::_add_ket_loop_end(      VCodeLines&    lines,
                 
             label +=  std::to_string(_get_index(0, tint, vrr_integrals)) + ", ";
            
-            label +=  std::to_string(_get_index(0, tint, vrr_integrals) + tint.components<T2CPair, T2CPair>().size()) + "});";
+            label +=  std::to_string(_get_index(0, tint, vrr_integrals) + tint.number_of_components()) + "});";
            
             lines.push_back({4, 0, 2, label});
         }
@@ -1197,17 +1885,7 @@ T4CGeomFuncBodyDriver::_add_ket_loop_end(      VCodeLines&    lines,
         {
             const auto tint = term.second;
             
-            std::string label = "t2cfunc::reduce(cbuffer, ";
-            
-            label +=  std::to_string(_get_index(term, cterms)) + ", ";
-            
-            label += "pbuffer, ";
-            
-            label += std::to_string(_get_index(0, tint, vrr_integrals)) + ", ";
-            
-            label += std::to_string(tint.components<T2CPair, T2CPair>().size()) + ", ";
-            
-            label += "ket_width, ket_npgtos);";
+            const auto label = _get_reduce_str(_get_index(term, cterms), _get_index(0, tint, vrr_integrals), tint.number_of_components(), flat_lanes);
             
             lines.push_back({4, 0, 2, label});
         }
@@ -1234,7 +1912,7 @@ T4CGeomFuncBodyDriver::_add_ket_loop_end(      VCodeLines&    lines,
             
             label +=  std::to_string(_get_index(0, tint, vrr_integrals)) + ", ";
            
-            label +=  std::to_string(_get_index(0, tint, vrr_integrals) + tint.components<T2CPair, T2CPair>().size()) + "});";
+            label +=  std::to_string(_get_index(0, tint, vrr_integrals) + tint.number_of_components()) + "});";
            
             lines.push_back({4, 0, 2, label});
         }
@@ -1246,17 +1924,7 @@ T4CGeomFuncBodyDriver::_add_ket_loop_end(      VCodeLines&    lines,
         {
             const auto tint = term.second;
             
-            std::string label = "t2cfunc::reduce(cbuffer, ";
-            
-            label +=  std::to_string(_get_index(term, cterms)) + ", ";
-            
-            label += "pbuffer, ";
-            
-            label += std::to_string(_get_index(0, tint, vrr_integrals)) + ", ";
-            
-            label += std::to_string(tint.components<T2CPair, T2CPair>().size()) + ", ";
-            
-            label += "ket_width, ket_npgtos);";
+            const auto label = _get_reduce_str(_get_index(term, cterms), _get_index(0, tint, vrr_integrals), tint.number_of_components(), flat_lanes);
             
             lines.push_back({4, 0, 2, label});
         }
@@ -1293,7 +1961,7 @@ T4CGeomFuncBodyDriver::_add_ket_loop_end(      VCodeLines&    lines,
            
             label +=  std::to_string(_get_index(0, tint, vrr_integrals)) + ", ";
            
-            label +=  std::to_string(_get_index(0, tint, vrr_integrals) + tint.components<T2CPair, T2CPair>().size()) + "});";
+            label +=  std::to_string(_get_index(0, tint, vrr_integrals) + tint.number_of_components()) + "});";
            
             lines.push_back({4, 0, 2, label});
         }
@@ -1305,17 +1973,7 @@ T4CGeomFuncBodyDriver::_add_ket_loop_end(      VCodeLines&    lines,
         {
             const auto tint = term.second;
             
-            std::string label = "t2cfunc::reduce(cbuffer, ";
-            
-            label +=  std::to_string(_get_index(term, cterms)) + ", ";
-            
-            label += "pbuffer, ";
-            
-            label += std::to_string(_get_index(0, tint, vrr_integrals)) + ", ";
-            
-            label += std::to_string(tint.components<T2CPair, T2CPair>().size()) + ", ";
-            
-            label += "ket_width, ket_npgtos);";
+            const auto label = _get_reduce_str(_get_index(term, cterms), _get_index(0, tint, vrr_integrals), tint.number_of_components(), flat_lanes);
             
             lines.push_back({4, 0, 2, label});
         }
@@ -1343,7 +2001,7 @@ T4CGeomFuncBodyDriver::_add_ket_loop_end(      VCodeLines&    lines,
                 
             label +=  std::to_string(_get_index(0, tint, vrr_integrals)) + ", ";
            
-            label +=  std::to_string(_get_index(0, tint, vrr_integrals) + tint.components<T2CPair, T2CPair>().size()) + "});";
+            label +=  std::to_string(_get_index(0, tint, vrr_integrals) + tint.number_of_components()) + "});";
            
             lines.push_back({4, 0, 2, label});
         }
@@ -1355,17 +2013,7 @@ T4CGeomFuncBodyDriver::_add_ket_loop_end(      VCodeLines&    lines,
         {
             const auto tint = term.second;
             
-            std::string label = "t2cfunc::reduce(cbuffer, ";
-                
-            label +=  std::to_string(_get_index(term, cterms)) + ", ";
-                
-            label += "pbuffer, ";
-                
-            label += std::to_string(_get_index(0, tint, vrr_integrals)) + ", ";
-                
-            label += std::to_string(tint.components<T2CPair, T2CPair>().size()) + ", ";
-                
-            label += "ket_width, ket_npgtos);";
+            const auto label = _get_reduce_str(_get_index(term, cterms), _get_index(0, tint, vrr_integrals), tint.number_of_components(), flat_lanes);
                 
             lines.push_back({4, 0, 2, label});
         }
@@ -1530,7 +2178,7 @@ T4CGeomFuncBodyDriver::_add_ket_trafo_call_tree(      VCodeLines&  lines,
         {
             if (term.first[2] > 0)
             {
-                const auto gcomps = Tensor(term.first[2]).components().size();
+                const auto gcomps = static_cast<size_t>(Tensor(term.first[2]).number_of_components());
                
                 const auto ccomps = t2c::number_of_cartesian_components(std::array<int, 2>{tint[0], tint[1]});
                 
@@ -1585,7 +2233,7 @@ T4CGeomFuncBodyDriver::_add_ket_trafo_call_tree(      VCodeLines&  lines,
             
             if (gorders[2] > 0)
             {
-                const auto gcomps = Tensor(gorders[2]).components().size();
+                const auto gcomps = static_cast<size_t>(Tensor(gorders[2]).number_of_components());
                
                 const auto bcomps = t2c::number_of_cartesian_components(std::array<int, 2>{tint[0], tint[1]});
                 
@@ -1626,7 +2274,7 @@ T4CGeomFuncBodyDriver::_add_bra_hrr_call_tree(      VCodeLines&  lines,
         {
             if (term.first[2] > 0)
             {
-                const auto gcomps = Tensor(term.first[2]).components().size();
+                const auto gcomps = static_cast<size_t>(Tensor(term.first[2]).number_of_components());
                 
                 for (size_t i = 0; i < gcomps; i++)
                 {
@@ -1665,7 +2313,7 @@ T4CGeomFuncBodyDriver::_add_bra_hrr_call_tree(      VCodeLines&  lines,
         
         if ((tint[0] > 0) && tint.prefixes_order() == std::vector<int>({0, 0, 1, 0}))
         {
-            const auto gcomps = Tensor(tint.prefixes_order()[2]).components().size();
+            const auto gcomps = static_cast<size_t>(Tensor(tint.prefixes_order()[2]).number_of_components());
             
             std::cout << "Transform : " << tint.label()  << " : " << gcomps << std::endl;
             
@@ -1949,7 +2597,7 @@ T4CGeomFuncBodyDriver::_add_bra_trafo_call_tree(      VCodeLines&  lines,
     
     for (const auto& prefix : integral.prefixes())
     {
-        gcomps *= prefix.components().size();
+        gcomps *= prefix.number_of_components();
     }
     
     auto angpair = std::array<int, 2>({integral[0], integral[1]});
@@ -1994,6 +2642,178 @@ T4CGeomFuncBodyDriver::_add_bra_trafo_call_tree(      VCodeLines&  lines,
     lines.push_back({3, 0, 1, label});
 }
 
+void
+T4CGeomFuncBodyDriver::_add_fused_bra_trafo_call_tree(      VCodeLines&               lines,
+                                                      const SG4Terms&                 skterms,
+                                                      const std::vector<I4CIntegral>& integrals) const
+{
+    size_t soffset = 0;
+    
+    for (const auto& integral : integrals)
+    {
+        size_t gcomps = 1;
+        
+        for (const auto& prefix : integral.prefixes())
+        {
+            gcomps *= prefix.number_of_components();
+        }
+        
+        auto angpair = std::array<int, 2>({integral[0], integral[1]});
+        
+        auto bccomps = t2c::number_of_cartesian_components(angpair);
+        
+        auto bscomps = t2c::number_of_spherical_components(angpair);
+        
+        angpair = std::array<int, 2>({integral[2], integral[3]});
+        
+        auto kscomps = t2c::number_of_spherical_components(angpair);
+        
+        auto gterm = t4c::prune_term(G4Term({std::array<int, 4>({0, 0, 0, 0}), integral}));
+        
+        const auto gindex = _get_half_spher_index(gterm, skterms);
+        
+        for (size_t i = 0; i < gcomps; i++)
+        {
+            std::string label = "t4cfunc::bra_transform<" + std::to_string(integral[0]) + ", " + std::to_string(integral[1]) + ">";
+           
+            label += "(sbuffer, " + std::to_string(soffset + i * bscomps * kscomps) + ", skbuffer, ";
+           
+            label += std::to_string(gindex + i * bccomps * kscomps) + ", ";
+           
+            label += std::to_string(integral[2]) + ", " + std::to_string(integral[3]) + ");";
+           
+            lines.push_back({3, 0, 2, label});
+        }
+        
+        std::string label = t4c::distributor_label(integral) + ".distribute(sbuffer, " + std::to_string(soffset);
+        
+        label += ", a_indices, b_indices, c_indices, d_indices, ";
+        
+        label += std::to_string(integral[0]) + ", ";
+        
+        label += std::to_string(integral[1]) + ", ";
+        
+        label += std::to_string(integral[2]) + ", ";
+        
+        label += std::to_string(integral[3]) + ", ";
+        
+        label += "j, ket_range);";
+        
+        lines.push_back({3, 0, (&integral == &integrals.back()) ? 1 : 2, label});
+        
+        soffset += gcomps * bscomps * kscomps;
+    }
+}
+
+void
+T4CGeomFuncBodyDriver::_add_jk_bra_trafo_call_tree(      VCodeLines&  lines,
+                                                   const SG4Terms&    skterms,
+                                                   const I4CIntegral& integral) const
+{
+    size_t gcomps = 1;
+    
+    for (const auto& prefix : integral.prefixes())
+    {
+        gcomps *= prefix.number_of_components();
+    }
+    
+    auto angpair = std::array<int, 2>({integral[0], integral[1]});
+    
+    const auto bccomps = t2c::number_of_cartesian_components(angpair);
+    
+    angpair = std::array<int, 2>({integral[2], integral[3]});
+    
+    const auto kscomps = t2c::number_of_spherical_components(angpair);
+    
+    auto gterm = t4c::prune_term(G4Term({std::array<int, 4>({0, 0, 0, 0}), integral}));
+    
+    const auto gindex = _get_half_spher_index(gterm, skterms);
+    
+    // spherical bra rows of (ab|cd) block from half transformed (ab|cd) rows
+    
+    std::vector<std::pair<std::string, std::vector<t4c::SparseTerm>>> rows;
+    
+    std::vector<size_t> sources;
+    
+    const auto index_str = [](const std::string& gto, const std::string& dim, const int comp) {
+        return (comp == 0) ? gto : gto + " + " + std::to_string(comp) + " * " + dim;
+    };
+    
+    for (int i = 0; i < 2 * integral[0] + 1; i++)
+    {
+        for (int j = 0; j < 2 * integral[1] + 1; j++)
+        {
+            std::vector<t4c::SparseTerm> terms;
+            
+            for (const auto& [cart_ab, coef] : t4c::spherical_pair_terms(integral[0], integral[1], i, j))
+            {
+                terms.push_back({"c_" + std::to_string(cart_ab), coef});
+                
+                if (std::find(sources.begin(), sources.end(), cart_ab) == sources.end()) sources.push_back(cart_ab);
+            }
+            
+            rows.push_back({index_str("a_gto", "a_dim", i) + ", " + index_str("b_gto", "b_dim", j), terms});
+        }
+    }
+    
+    std::sort(sources.begin(), sources.end());
+    
+    lines.push_back({3, 0, 2, "// fused bra transformation and J/K accumulation (" + Tensor(integral[0]).label() + Tensor(integral[1]).label() + "|"
+                              + Tensor(integral[2]).label() + Tensor(integral[3]).label() + ")"});
+    
+    lines.push_back({3, 0, 1, "const auto a_gto = a_indices[j + 1];"});
+    
+    lines.push_back({3, 0, 2, "const auto b_gto = b_indices[j + 1];"});
+    
+    lines.push_back({3, 0, 1, "for (size_t g = 0; g < " + std::to_string(gcomps) + "; g++)"});
+    
+    lines.push_back({3, 0, 1, "{"});
+    
+    lines.push_back({4, 0, 1, "for (size_t cd = 0; cd < " + std::to_string(kscomps) + "; cd++)"});
+    
+    lines.push_back({4, 0, 1, "{"});
+    
+    const auto gstride = std::to_string(bccomps * kscomps);
+    
+    for (size_t i = 0; i < sources.size(); i++)
+    {
+        const auto row = gindex + sources[i] * kscomps;
+        
+        const auto nlines = ((i + 1) == sources.size()) ? 2 : 1;
+        
+        lines.push_back({5, 0, nlines, "const auto c_" + std::to_string(sources[i]) + " = skbuffer.data(" + std::to_string(row) + " + g * " + gstride + " + cd);"});
+    }
+    
+    const auto dscomps = std::to_string(2 * integral[3] + 1);
+    
+    lines.push_back({5, 0, 1, "const auto c_off = (cd / " + dscomps + ") * c_dim;"});
+    
+    lines.push_back({5, 0, 2, "const auto d_off = (cd % " + dscomps + ") * d_dim;"});
+    
+    lines.push_back({5, 0, 1, "for (size_t k = 0; k < ket_width; k++)"});
+    
+    lines.push_back({5, 0, 1, "{"});
+    
+    lines.push_back({6, 0, 1, "const auto i_c = c_off + c_indices[ket_range.first + k + 1];"});
+    
+    lines.push_back({6, 0, 2, "const auto i_d = d_off + d_indices[ket_range.first + k + 1];"});
+    
+    for (size_t i = 0; i < rows.size(); i++)
+    {
+        const auto nlines = ((i + 1) == rows.size()) ? 1 : 2;
+        
+        const auto& [indices, terms] = rows[i];
+        
+        lines.push_back({6, 0, nlines, "accumulator.accumulate(g, " + indices + ", i_c, i_d, " + t4c::sparse_sum(terms) + ");"});
+    }
+    
+    lines.push_back({5, 0, 1, "}"});
+    
+    lines.push_back({4, 0, 1, "}"});
+    
+    lines.push_back({3, 0, 1, "}"});
+}
+
 std::string
 T4CGeomFuncBodyDriver::_get_vrr_arguments(const size_t start,
                                           const SI4CIntegrals& integrals,
@@ -2318,7 +3138,7 @@ T4CGeomFuncBodyDriver::_get_all_components(const SI4CIntegrals& integrals) const
     
     for (const auto& tint : integrals)
     {
-        tcomps += tint.components<T2CPair, T2CPair>().size();
+        tcomps += tint.number_of_components();
     }
     
     return tcomps;
@@ -2362,7 +3182,7 @@ T4CGeomFuncBodyDriver::_get_all_geom_half_spher_components(const SI4CIntegrals&
         
         for (const auto& prefix : tint.prefixes())
         {
-            icomps *= prefix.components().size();
+            icomps *= prefix.number_of_components();
         }
         
         tcomps += icomps;
@@ -2384,7 +3204,7 @@ T4CGeomFuncBodyDriver::_get_all_spher_components(const I4CIntegral& integral) co
     
     for (const auto& prefix : integral.prefixes())
     {
-        tcomps *= prefix.components().size();
+        tcomps *= prefix.number_of_components();
     }
     
     return tcomps;
@@ -2401,7 +3221,7 @@ T4CGeomFuncBodyDriver::_get_geom20_cart_2a_size(const SI4CIntegrals& bra_integra
     {
         if (((tint[0] + tint[2]) == 0) && (tint[1] >= integral[1]) && (tint[1] <= (integral[0] + integral[1])))
         {
-            tcomp += tint.components<T2CPair, T2CPair>().size();
+            tcomp += tint.number_of_components();
         }
     }
     
@@ -2418,7 +3238,7 @@ T4CGeomFuncBodyDriver::_get_geom20_contr_2a_size(const SI4CIntegrals& integrals,
     {
         if ((tint[0] == 0) && (tint[1] >= integral[1]) && (tint[1] <= (integral[0] + integral[1])) && (tint[2] > 0))
         {
-            tcomps += tint.components<T2CPair, T2CPair>().size();
+            tcomps += tint.number_of_components();
         }
     }
     
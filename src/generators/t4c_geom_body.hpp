@@ -14,13 +14,16 @@
 class T4CGeomFuncBodyDriver
 {
     /// Generates vector of strings with GTOs definitions in compute function.
+    /// @param flat_lanes The flag to omit ket side data, which is set up from flattened ket primitive lanes.
     /// @return The vector of strings with GTOS definitions in compute function.
-    std::vector<std::string> _get_gto_pairs_def() const;
+    std::vector<std::string> _get_gto_pairs_def(const bool flat_lanes) const;
     
     /// Generates vector of ket factors in compute function.
     /// @param integral The base four center integral.
+    /// @param flat_lanes The flag to size buffers for flattened ket primitive lanes.
     /// @return The vector of ket factors in compute function.
-    std::vector<std::string> _get_ket_variables_def(const I4CIntegral& integral) const;
+    std::vector<std::string> _get_ket_variables_def(const I4CIntegral& integral,
+                                                    const bool         flat_lanes) const;
     
     /// Checks if coordinates of center W are required for integration.
     /// @param integral The base four center integral.
@@ -211,39 +214,53 @@ class T4CGeomFuncBodyDriver
     /// Generates vector of Cartesian buffers in compute function.
     /// @param cterms The set of filtered geometrical terms.
     /// @param integral The base two center integral.
+    /// @param flat_lanes The flag to size buffers for flattened ket primitive lanes.
     /// @return The vector of buffers in compute function.
     std::vector<std::string> _get_cart_buffers_def(const SG4Terms&    cterms,
-                                                   const I4CIntegral& integral) const;
+                                                   const I4CIntegral& integral,
+                                                   const bool         flat_lanes) const;
     
     /// Generates vector of contracted buffers in compute function.
     /// @param ckterms The set of filtered geometrical terms.
     /// @param integral The base two center integral.
+    /// @param flat_lanes The flag to size buffers for flattened ket primitive lanes.
     /// @return The vector of buffers in compute function.
     std::vector<std::string> _get_contr_buffers_def(const SG4Terms&    ckterms,
-                                                    const I4CIntegral& integral) const;
+                                                    const I4CIntegral& integral,
+                                                    const bool         flat_lanes) const;
     
     /// Generates vector of half transformed buffers in compute function.
     /// @param skterms The set of filtered geometrical terms.
     /// @param integral The base two center integral.
+    /// @param flat_lanes The flag to size buffers for flattened ket primitive lanes.
     /// @return The vector of buffers in compute function.
     std::vector<std::string> _get_half_spher_buffers_def(const SG4Terms&    skterms,
-                                                         const I4CIntegral& integral) const;
+                                                         const I4CIntegral& integral,
+                                                         const bool         flat_lanes) const;
     
     /// Generates vector of half transformed buffers in compute function.
     /// @param integral The base two center integral.
+    /// @param flat_lanes The flag to size buffers for flattened ket primitive lanes.
     /// @return The vector of buffers in compute function.
-    std::vector<std::string> _get_spher_buffers_def(const I4CIntegral& integral) const;
+    std::vector<std::string> _get_spher_buffers_def(const I4CIntegral& integral,
+                                                    const bool         flat_lanes) const;
     
     /// Generates vector of Boys function definitions in compute function.
     /// @param integral The base two center integral.
+    /// @param omega_source The name of object providing range separation factor.
     /// @return The vector of Boys function definitions in compute function.
-    std::vector<std::string> _get_boys_function_def(const I4CIntegral& integral) const;
+    std::vector<std::string> _get_boys_function_def(const I4CIntegral& integral,
+                                                    const std::string& omega_source) const;
     
     /// Adds loop start definitions to code lines container.
     /// @param lines The code lines container to which loop start definition are added.
     /// @param integral The base two center integral.
+    /// @param prim_screening The primitive pairs screening threshold exponent (0 disables screening).
+    /// @param use_sbuffer The flag to set up spherical integrals buffer.
     void _add_loop_start(      VCodeLines&  lines,
-                         const I4CIntegral& integral) const;
+                         const I4CIntegral& integral,
+                         const int          prim_screening,
+                         const bool         use_sbuffer) const;
     
     /// Adds loop end definitions to code lines container.
     /// @param lines The code lines container to which loop start definition are added.
@@ -251,21 +268,69 @@ class T4CGeomFuncBodyDriver
     void _add_loop_end(      VCodeLines&  lines,
                        const I4CIntegral& integral) const;
     
+    /// Adds primitive pairs screening bound over ket batch to code lines container.
+    /// @param lines The code lines container to which screening bound is added.
+    void _add_prim_screening_bound(VCodeLines& lines) const;
+    
+    /// Adds bra loop start definitions to code lines container.
+    /// @param lines The code lines container to which loop start definition are added.
+    /// @param integral The base two center integral.
+    /// @param use_sbuffer The flag to zero spherical integrals buffer.
+    void _add_bra_loop_start(      VCodeLines&  lines,
+                             const I4CIntegral& integral,
+                             const bool         use_sbuffer) const;
+    
+    /// Adds flattening of ket primitive lanes over ket pair blocks to code lines container.
+    /// @param lines The code lines container to which flattening code is added.
+    void _add_flat_ket_lanes(VCodeLines& lines) const;
+    
+    /// Gets number of columns of contracted buffers.
+    /// @param flat_lanes The flag to size buffers for flattened ket primitive lanes.
+    /// @return The number of columns of contracted buffers.
+    std::string _get_columns_str(const bool flat_lanes) const;
+    
+    /// Adds loop start definitions over flattened ket primitive lanes to code lines container.
+    /// @param lines The code lines container to which loop start definition are added.
+    /// @param integral The base two center integral.
+    /// @param prim_screening The primitive pairs screening threshold exponent (0 disables screening).
+    void _add_flat_loop_start(      VCodeLines&  lines,
+                              const I4CIntegral& integral,
+                              const int          prim_screening) const;
+    
+    /// Generates contraction call of primitive integrals.
+    /// @param cindex The index of contracted integrals in Cartesian buffer.
+    /// @param pindex The index of primitive integrals in primitive buffer.
+    /// @param ncomps The number of integral components.
+    /// @param flat_lanes The flag to use segmented reduction over flattened ket primitive lanes.
+    /// @return The contraction call.
+    std::string _get_reduce_str(const size_t cindex,
+                                const size_t pindex,
+                                const size_t ncomps,
+                                const bool   flat_lanes) const;
+    
+    /// Adds loop end definitions over flattened ket primitive lanes to code lines container.
+    /// @param lines The code lines container to which loop end definition are added.
+    void _add_flat_loop_end(VCodeLines& lines) const;
+    
     /// Adds ket loop start definitions to code lines container.
     /// @param lines The code lines container to which loop start definition are added.
     /// @param integral The base two center integral.
+    /// @param prim_screening The primitive pairs screening threshold exponent (0 disables screening).
     void _add_ket_loop_start(      VCodeLines&  lines,
-                             const I4CIntegral& integral) const;
+                             const I4CIntegral& integral,
+                             const int          prim_screening) const;
     
     /// Adds ket loop end definitions to code lines container.
     /// @param lines The code lines container to which loop start definition are added.
     /// @param cterms The set of filtered geometrical terms.
     /// @param vrr_integrals The set of unique integrals for vertical recursion.
     /// @param integral The base two center integral.
+    /// @param flat_lanes The flag to use segmented reduction over flattened ket primitive lanes.
     void _add_ket_loop_end(      VCodeLines&    lines,
                            const SG4Terms&      cterms,
                            const SI4CIntegrals& vrr_integrals,
-                           const I4CIntegral&   integral) const;
+                           const I4CIntegral&   integral,
+                           const bool           flat_lanes) const;
     
     /// Adds auxilary integrals.
     /// @param lines The code lines container to which loop start definition are added.
@@ -427,6 +492,32 @@ class T4CGeomFuncBodyDriver
     /// @param integral The base four center integral.
     size_t _get_geom20_half_spher_size(const I4CIntegral& integral) const;
 
+    /// Selects integral which requires widest set of ket factors from vector of integrals.
+    /// @param integrals The vector of geometrical derivative integrals.
+    /// @return The selected integral.
+    I4CIntegral _get_anchor_integral(const std::vector<I4CIntegral>& integrals) const;
+    
+    /// Generates vector of spherical buffers in fused compute function.
+    /// @param integrals The vector of geometrical derivative integrals.
+    /// @return The vector of buffers in compute function.
+    std::vector<std::string> _get_fused_spher_buffers_def(const std::vector<I4CIntegral>& integrals) const;
+    
+    /// Adds call tree for bra side transformation of all integrals in fused compute function.
+    /// @param lines The code lines container to which loop start definition are added.
+    /// @param skterms The set of filtered geometrical terms.
+    /// @param integrals The vector of geometrical derivative integrals.
+    void _add_fused_bra_trafo_call_tree(      VCodeLines&               lines,
+                                        const SG4Terms&                 skterms,
+                                        const std::vector<I4CIntegral>& integrals) const;
+    
+    /// Adds bra side transformation fused with J/K accumulation, which never stores spherical integrals.
+    /// @param lines The code lines container to which transformation is added.
+    /// @param skterms The set of filtered geometrical terms.
+    /// @param integral The base four center integral.
+    void _add_jk_bra_trafo_call_tree(      VCodeLines&  lines,
+                                     const SG4Terms&    skterms,
+                                     const I4CIntegral& integral) const;
+
 public:
     /// Creates a two-center compute function body generator.
     T4CGeomFuncBodyDriver() = default;
@@ -438,12 +529,71 @@ public:
     /// @param skterms The set of filtered geometrical terms.
     /// @param vrr_integrals The set of unique integrals for vertical recursion.
     /// @param integral The base four center integral.
+    /// @param prim_screening The primitive pairs screening threshold exponent n, i.e. threshold 10^-n (0 disables screening).
     void write_func_body(      std::ofstream& fstream,
                          const SG4Terms&      cterms,
                          const SG4Terms&      ckterms,
                          const SG4Terms&      skterms,
                          const SI4CIntegrals& vrr_integrals,
+                         const I4CIntegral&   integral,
+                         const int            prim_screening) const;
+    
+    /// Writes body of geometrical derivatives compute function.
+    /// @param fstream the file stream.
+    /// @param geom_integrals The set of unique integrals for geometrical recursion.
+    /// @param integral The base four center integral.
+    void write_func_body(      std::ofstream& fstream,
+                         const SI4CIntegrals& geom_integrals,
                          const I4CIntegral&   integral) const;
+    
+    /// Writes body of fused compute function, which computes all geometrical derivative
+    /// integrals from single vertical recursion and shared horizontal recursion buffers.
+    /// @param fstream the file stream.
+    /// @param cterms The set of filtered geometrical terms of all integrals.
+    /// @param ckterms The set of filtered geometrical terms of all integrals.
+    /// @param skterms The set of filtered geometrical terms of all integrals.
+    /// @param vrr_integrals The set of unique integrals for vertical recursion.
+    /// @param integrals The vector of geometrical derivative integrals.
+    /// @param prim_screening The primitive pairs screening threshold exponent n, i.e. threshold 10^-n (0 disables screening).
+    void write_fused_func_body(      std::ofstream&            fstream,
+                               const SG4Terms&                 cterms,
+                               const SG4Terms&                 ckterms,
+                               const SG4Terms&                 skterms,
+                               const SI4CIntegrals&            vrr_integrals,
+                               const std::vector<I4CIntegral>& integrals,
+                               const int                       prim_screening) const;
+    
+    /// Writes body of compute function over flattened ket primitive lanes.
+    /// @param fstream the file stream.
+    /// @param cterms The set of filtered geometrical terms.
+    /// @param ckterms The set of filtered geometrical terms.
+    /// @param skterms The set of filtered geometrical terms.
+    /// @param vrr_integrals The set of unique integrals for vertical recursion.
+    /// @param integral The base four center integral.
+    /// @param prim_screening The primitive pairs screening threshold exponent n, i.e. threshold 10^-n (0 disables screening).
+    void write_flat_func_body(      std::ofstream& fstream,
+                              const SG4Terms&      cterms,
+                              const SG4Terms&      ckterms,
+                              const SG4Terms&      skterms,
+                              const SI4CIntegrals& vrr_integrals,
+                              const I4CIntegral&   integral,
+                              const int            prim_screening) const;
+    
+    /// Writes body of compute function accumulating J/K contributions into Fock matrices.
+    /// @param fstream the file stream.
+    /// @param cterms The set of filtered geometrical terms.
+    /// @param ckterms The set of filtered geometrical terms.
+    /// @param skterms The set of filtered geometrical terms.
+    /// @param vrr_integrals The set of unique integrals for vertical recursion.
+    /// @param integral The base four center integral.
+    /// @param prim_screening The primitive pairs screening threshold exponent n, i.e. threshold 10^-n (0 disables screening).
+    void write_jk_func_body(      std::ofstream& fstream,
+                            const SG4Terms&      cterms,
+                            const SG4Terms&      ckterms,
+                            const SG4Terms&      skterms,
+                            const SI4CIntegrals& vrr_integrals,
+                            const I4CIntegral&   integral,
+                            const int            prim_screening) const;
 };
 
 #endif /* t4c_geom_body_hpp */
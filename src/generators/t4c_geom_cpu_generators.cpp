@@ -17,6 +17,7 @@
 #include "t4c_geom_cpu_generators.hpp"
 
 #include <iostream>
+#include <stdexcept>
 
 #include "string_formater.hpp"
 #include "file_stream.hpp"
@@ -27,6 +28,7 @@
 #include "t4c_geom_body.hpp"
 #include "v4i_center_driver.hpp"
 #include "v4i_geom10_eri_driver.hpp"
+#include "v4i_geom01_eri_driver.hpp"
 #include "v4i_geom20_eri_driver.hpp"
 #include "v4i_geom11_eri_driver.hpp"
 #include "v4i_geom1010_eri_driver.hpp"
@@ -35,7 +37,8 @@
 void
 T4CGeomCPUGenerator::generate(const std::string&        label,
                               const int                 max_ang_mom,
-                              const std::array<int, 5>& geom_drvs) const
+                              const std::array<int, 5>& geom_drvs,
+                              const int                 prim_screening) const
 {
     if (_is_available(label))
     {
@@ -53,13 +56,7 @@ T4CGeomCPUGenerator::generate(const std::string&        label,
                         
                         const auto geom_integrals = _generate_geom_integral_group(integral);
                         
-                        auto geom_terms = _generate_geom_terms_group(geom_integrals);
-                        
-                        _prune_terms_group(geom_terms);
-                        
-                        _add_bra_hrr_terms_group(geom_terms);
-                        
-                        _add_ket_hrr_terms_group(geom_terms);
+                        const auto geom_terms = _generate_hrr_terms_group(integral);
                         
                         const auto cterms = _filter_cbuffer_terms(geom_terms);
                         
@@ -69,7 +66,7 @@ T4CGeomCPUGenerator::generate(const std::string&        label,
                         
                         const auto vrr_integrals = _generate_vrr_integral_group(geom_terms);
                                                                     
-                        _write_cpp_header(cterms, ckterms, skterms, vrr_integrals, integral);
+                        _write_cpp_header(cterms, ckterms, skterms, vrr_integrals, integral, prim_screening);
                         
 //                       if ((i == 2) && (j == 2) && (k == 2) && (l == 2))
 //                        {
@@ -139,11 +136,143 @@ T4CGeomCPUGenerator::generate(const std::string&        label,
     }
     else
     {
-        std::cerr << "*** ERROR *** Unsupported type of four-center integral: ";
-        
-        std::cerr << label << " !!!" << std::endl;
-        
-        std::exit(EXIT_FAILURE);
+        throw std::invalid_argument("Unsupported type of four-center integral: " + label);
+    }
+}
+
+void
+T4CGeomCPUGenerator::generate_hessian(const std::string& label,
+                                      const int          max_ang_mom,
+                                      const int          prim_screening) const
+{
+    if (_is_available(label))
+    {
+        for (int i = 0; i <= max_ang_mom; i++)
+        {
+            for (int j = 0; j <= max_ang_mom; j++)
+            {
+                for (int k = 0; k <= max_ang_mom; k++)
+                {
+                    for (int l = 0; l <= max_ang_mom; l++)
+                    {
+                        const auto integrals = _get_hessian_integrals(label, {i, j, k, l});
+                        
+                        // shared terms are computed once for all derivative integrals
+                        
+                        SG4Terms geom_terms;
+                        
+                        SG4Terms skterms;
+                        
+                        for (const auto& integral : integrals)
+                        {
+                            const auto terms = _generate_hrr_terms_group(integral);
+                            
+                            geom_terms.insert(terms.cbegin(), terms.cend());
+                            
+                            const auto sterms = _filter_skbuffer_terms(integral, terms);
+                            
+                            skterms.insert(sterms.cbegin(), sterms.cend());
+                        }
+                        
+                        const auto cterms = _filter_cbuffer_terms(geom_terms);
+                        
+                        const auto ckterms = _filter_ckbuffer_terms(geom_terms);
+                        
+                        const auto vrr_integrals = _generate_vrr_integral_group(geom_terms);
+                        
+                        _write_hessian_cpp_header(cterms, ckterms, skterms, vrr_integrals, integrals, prim_screening);
+                    }
+                }
+            }
+        }
+    }
+    else
+    {
+        throw std::invalid_argument("Unsupported type of four-center integral: " + label);
+    }
+}
+
+void
+T4CGeomCPUGenerator::generate_flat(const std::string&        label,
+                                   const int                 max_ang_mom,
+                                   const std::array<int, 5>& geom_drvs,
+                                   const int                 prim_screening) const
+{
+    if (_is_available(label))
+    {
+        for (int i = 0; i <= max_ang_mom; i++)
+        {
+            for (int j = 0; j <= max_ang_mom; j++)
+            {
+                for (int k = 0; k <= max_ang_mom; k++)
+                {
+                    const auto lstart = ((geom_drvs[3] + geom_drvs[4]) > 0) ? 0 : k;
+                    
+                    for (int l = lstart; l <= max_ang_mom; l++)
+                    {
+                        const auto integral = _get_integral(label, {i, j, k, l}, geom_drvs);
+                        
+                        const auto geom_terms = _generate_hrr_terms_group(integral);
+                        
+                        const auto cterms = _filter_cbuffer_terms(geom_terms);
+                        
+                        const auto ckterms = _filter_ckbuffer_terms(geom_terms);
+                        
+                        const auto skterms = _filter_skbuffer_terms(integral, geom_terms);
+                        
+                        const auto vrr_integrals = _generate_vrr_integral_group(geom_terms);
+                        
+                        _write_flat_cpp_header(cterms, ckterms, skterms, vrr_integrals, integral, prim_screening);
+                    }
+                }
+            }
+        }
+    }
+    else
+    {
+        throw std::invalid_argument("Unsupported type of four-center integral: " + label);
+    }
+}
+
+void
+T4CGeomCPUGenerator::generate_jk(const std::string&        label,
+                                 const int                 max_ang_mom,
+                                 const std::array<int, 5>& geom_drvs,
+                                 const int                 prim_screening) const
+{
+    if (_is_available(label))
+    {
+        for (int i = 0; i <= max_ang_mom; i++)
+        {
+            for (int j = 0; j <= max_ang_mom; j++)
+            {
+                for (int k = 0; k <= max_ang_mom; k++)
+                {
+                    const auto lstart = ((geom_drvs[3] + geom_drvs[4]) > 0) ? 0 : k;
+                    
+                    for (int l = lstart; l <= max_ang_mom; l++)
+                    {
+                        const auto integral = _get_integral(label, {i, j, k, l}, geom_drvs);
+                        
+                        const auto geom_terms = _generate_hrr_terms_group(integral);
+                        
+                        const auto cterms = _filter_cbuffer_terms(geom_terms);
+                        
+                        const auto ckterms = _filter_ckbuffer_terms(geom_terms);
+                        
+                        const auto skterms = _filter_skbuffer_terms(integral, geom_terms);
+                        
+                        const auto vrr_integrals = _generate_vrr_integral_group(geom_terms);
+                        
+                        _write_jk_cpp_header(cterms, ckterms, skterms, vrr_integrals, integral, prim_screening);
+                    }
+                }
+            }
+        }
+    }
+    else
+    {
+        throw std::invalid_argument("Unsupported type of four-center integral: " + label);
     }
 }
 
@@ -186,6 +315,26 @@ T4CGeomCPUGenerator::_get_integral(const std::string&        label,
     return I4CIntegral();
 }
 
+std::vector<I4CIntegral>
+T4CGeomCPUGenerator::_get_hessian_integrals(const std::string&        label,
+                                            const std::array<int, 4>& ang_moms) const
+{
+    std::vector<I4CIntegral> tints;
+    
+    const auto geom_drvs = std::vector<std::array<int, 5>>({{1, 0, 0, 0, 0},
+                                                            {0, 1, 0, 0, 0},
+                                                            {2, 0, 0, 0, 0},
+                                                            {1, 1, 0, 0, 0},
+                                                            {1, 0, 0, 1, 0}});
+    
+    for (const auto& geom_drv : geom_drvs)
+    {
+        tints.push_back(_get_integral(label, ang_moms, geom_drv));
+    }
+    
+    return tints;
+}
+
 SI4CIntegrals
 T4CGeomCPUGenerator::_generate_geom_integral_group(const I4CIntegral& integral) const
 {
@@ -200,6 +349,13 @@ T4CGeomCPUGenerator::_generate_geom_integral_group(const I4CIntegral& integral)
         tints = geom_drv.apply_bra_hrr_recursion(integral);
     }
     
+    if (geom_order == std::vector<int>({0, 1, 0, 0}))
+    {
+        V4IGeom01ElectronRepulsionDriver geom_drv;
+        
+        tints = geom_drv.apply_bra_hrr_recursion(integral);
+    }
+    
     if (geom_order == std::vector<int>({2, 0, 0, 0}))
     {
         V4IGeom20ElectronRepulsionDriver geom_drv;
@@ -434,6 +590,20 @@ T4CGeomCPUGenerator::_generate_geom_terms_group(const SI4CIntegrals& integrals)
     return terms;
 }
 
+SG4Terms
+T4CGeomCPUGenerator::_generate_hrr_terms_group(const I4CIntegral& integral) const
+{
+    auto terms = _generate_geom_terms_group(_generate_geom_integral_group(integral));
+    
+    _prune_terms_group(terms);
+    
+    _add_bra_hrr_terms_group(terms);
+    
+    _add_ket_hrr_terms_group(terms);
+    
+    return terms;
+}
+
 void
 T4CGeomCPUGenerator::_add_bra_hrr_terms_group(SG4Terms& terms) const
 {
@@ -873,12 +1043,31 @@ T4CGeomCPUGenerator::_file_name(const I4CIntegral& integral) const
     return t4c::integral_label(integral) + label;
 }
 
+std::string
+T4CGeomCPUGenerator::_hessian_file_name(const I4CIntegral& integral) const
+{
+    return t4c::integral_label(integral.base()) + "GeomHessianRec" + integral.label();
+}
+
+std::string
+T4CGeomCPUGenerator::_flat_file_name(const I4CIntegral& integral) const
+{
+    return t4c::integral_label(integral) + "FlatRec" + integral.label();
+}
+
+std::string
+T4CGeomCPUGenerator::_jk_file_name(const I4CIntegral& integral) const
+{
+    return t4c::integral_label(integral) + "JKRec" + integral.label();
+}
+
 void
 T4CGeomCPUGenerator::_write_cpp_header(const SG4Terms&      cterms,
                                        const SG4Terms&      ckterms,
                                        const SG4Terms&      skterms,
                                        const SI4CIntegrals& vrr_integrals,
-                                       const I4CIntegral& integral) const
+                                       const I4CIntegral&   integral,
+                                       const int            prim_screening) const
 {
     auto fname = _file_name(integral) + ".hpp";
         
@@ -886,9 +1075,9 @@ T4CGeomCPUGenerator::_write_cpp_header(const SG4Terms&      cterms,
                
     fstream.open(fname.c_str(), std::ios_base::trunc);
     
-    _write_hpp_defines(fstream, integral, true);
+    _write_hpp_defines(fstream, _file_name(integral), true);
     
-    _write_hpp_includes(fstream, ckterms, skterms, vrr_integrals, integral);
+    _write_hpp_includes(fstream, ckterms, skterms, vrr_integrals, integral, prim_screening, false, false);
     
     _write_namespace(fstream, integral, true);
     
@@ -902,35 +1091,162 @@ T4CGeomCPUGenerator::_write_cpp_header(const SG4Terms&      cterms,
     
     decl_drv.write_func_decl(fstream, integral, false);
     
-    func_drv.write_func_body(fstream, cterms, ckterms, skterms, vrr_integrals, integral);
+    func_drv.write_func_body(fstream, cterms, ckterms, skterms, vrr_integrals, integral, prim_screening);
+    
+    fstream << std::endl;
+
+    _write_namespace(fstream, integral, false);
+        
+    _write_hpp_defines(fstream, _file_name(integral), false);
+    
+    fstream.close();
+}
+
+void
+T4CGeomCPUGenerator::_write_hessian_cpp_header(const SG4Terms&                 cterms,
+                                               const SG4Terms&                 ckterms,
+                                               const SG4Terms&                 skterms,
+                                               const SI4CIntegrals&            vrr_integrals,
+                                               const std::vector<I4CIntegral>& integrals,
+                                               const int                       prim_screening) const
+{
+    const auto integral = integrals.front();
+    
+    auto fname = _hessian_file_name(integral) + ".hpp";
+        
+    std::ofstream fstream;
+               
+    fstream.open(fname.c_str(), std::ios_base::trunc);
+    
+    _write_hpp_defines(fstream, _hessian_file_name(integral), true);
+    
+    // all integrals share angular momenta, so first integral selects half transformed terms
+    
+    _write_hpp_includes(fstream, ckterms, skterms, vrr_integrals, integral, prim_screening, false, false);
+    
+    _write_namespace(fstream, integral, true);
+    
+    T4CGeomDocuDriver docs_drv;
+    
+    T4CGeomDeclDriver decl_drv;
+    
+    T4CGeomFuncBodyDriver func_drv;
+
+    docs_drv.write_fused_doc_str(fstream, integrals);
+    
+    decl_drv.write_fused_func_decl(fstream, integrals, false);
+    
+    func_drv.write_fused_func_body(fstream, cterms, ckterms, skterms, vrr_integrals, integrals, prim_screening);
+    
+    fstream << std::endl;
+
+    _write_namespace(fstream, integral, false);
+        
+    _write_hpp_defines(fstream, _hessian_file_name(integral), false);
+    
+    fstream.close();
+}
+
+void
+T4CGeomCPUGenerator::_write_flat_cpp_header(const SG4Terms&      cterms,
+                                            const SG4Terms&      ckterms,
+                                            const SG4Terms&      skterms,
+                                            const SI4CIntegrals& vrr_integrals,
+                                            const I4CIntegral&   integral,
+                                            const int            prim_screening) const
+{
+    auto fname = _flat_file_name(integral) + ".hpp";
+        
+    std::ofstream fstream;
+               
+    fstream.open(fname.c_str(), std::ios_base::trunc);
+    
+    _write_hpp_defines(fstream, _flat_file_name(integral), true);
+    
+    _write_hpp_includes(fstream, ckterms, skterms, vrr_integrals, integral, prim_screening, true, false);
+    
+    _write_namespace(fstream, integral, true);
+    
+    T4CGeomDocuDriver docs_drv;
+    
+    T4CGeomDeclDriver decl_drv;
+    
+    T4CGeomFuncBodyDriver func_drv;
+
+    docs_drv.write_flat_doc_str(fstream, integral);
+    
+    decl_drv.write_flat_func_decl(fstream, integral, false);
+    
+    func_drv.write_flat_func_body(fstream, cterms, ckterms, skterms, vrr_integrals, integral, prim_screening);
     
     fstream << std::endl;
 
     _write_namespace(fstream, integral, false);
         
-    _write_hpp_defines(fstream, integral, false);
+    _write_hpp_defines(fstream, _flat_file_name(integral), false);
+    
+    fstream.close();
+}
+
+void
+T4CGeomCPUGenerator::_write_jk_cpp_header(const SG4Terms&      cterms,
+                                          const SG4Terms&      ckterms,
+                                          const SG4Terms&      skterms,
+                                          const SI4CIntegrals& vrr_integrals,
+                                          const I4CIntegral&   integral,
+                                          const int            prim_screening) const
+{
+    auto fname = _jk_file_name(integral) + ".hpp";
+        
+    std::ofstream fstream;
+               
+    fstream.open(fname.c_str(), std::ios_base::trunc);
+    
+    _write_hpp_defines(fstream, _jk_file_name(integral), true);
+    
+    _write_hpp_includes(fstream, ckterms, skterms, vrr_integrals, integral, prim_screening, false, true);
+    
+    _write_namespace(fstream, integral, true);
+    
+    T4CGeomDocuDriver docs_drv;
+    
+    T4CGeomDeclDriver decl_drv;
+    
+    T4CGeomFuncBodyDriver func_drv;
+
+    docs_drv.write_jk_doc_str(fstream, integral);
+    
+    decl_drv.write_jk_func_decl(fstream, integral, false);
+    
+    func_drv.write_jk_func_body(fstream, cterms, ckterms, skterms, vrr_integrals, integral, prim_screening);
+    
+    fstream << std::endl;
+
+    _write_namespace(fstream, integral, false);
+        
+    _write_hpp_defines(fstream, _jk_file_name(integral), false);
     
     fstream.close();
 }
 
 void
 T4CGeomCPUGenerator::_write_hpp_defines(      std::ofstream& fstream,
-                                        const I4CIntegral&   integral,
+                                        const std::string&   fname,
                                         const bool           start) const
 {
-    auto fname = _file_name(integral) + "_hpp";
+    const auto label = fname + "_hpp";
     
     auto lines = VCodeLines();
  
     if (start)
     {
-        lines.push_back({0, 0, 1, "#ifndef " + fname});
+        lines.push_back({0, 0, 1, "#ifndef " + label});
         
-        lines.push_back({0, 0, 2, "#define " + fname});
+        lines.push_back({0, 0, 2, "#define " + label});
     }
     else
     {
-        lines.push_back({0, 0, 1, "#endif /* " + fname + " */"});
+        lines.push_back({0, 0, 1, "#endif /* " + label + " */"});
     }
     
     ost::write_code_lines(fstream, lines);
@@ -941,15 +1257,37 @@ T4CGeomCPUGenerator::_write_hpp_includes(      std::ofstream& fstream,
                                          const SG4Terms&      ckterms,
                                          const SG4Terms&      skterms,
                                          const SI4CIntegrals& vrr_integrals,
-                                         const I4CIntegral&   integral) const
+                                         const I4CIntegral&   integral,
+                                         const int            prim_screening,
+                                         const bool           flat_lanes,
+                                         const bool           jk_accumulate) const
 {
     auto lines = VCodeLines();
     
+    if (flat_lanes || (prim_screening > 0))
+    {
+        lines.push_back({0, 0, 1, "#include <algorithm>"});
+    }
+    
     lines.push_back({0, 0, 1, "#include <array>"});
     
+    if ((prim_screening > 0) || jk_accumulate)
+    {
+        lines.push_back({0, 0, 1, "#include <cmath>"});
+    }
+    
     lines.push_back({0, 0, 1, "#include <cstddef>"});
+    
+    if (flat_lanes)
+    {
+        lines.push_back({0, 0, 1, "#include <utility>"});
         
-    lines.push_back({0, 0, 2, "#include <utility>"});
+        lines.push_back({0, 0, 2, "#include <vector>"});
+    }
+    else
+    {
+        lines.push_back({0, 0, 2, "#include <utility>"});
+    }
     
     std::set<std::string> labels;
         
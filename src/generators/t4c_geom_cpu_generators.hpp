@@ -47,11 +47,23 @@ class T4CGeomCPUGenerator
     /// @return The set of integrals.
     SI4CIntegrals _generate_geom_integral_group(const I4CIntegral& integral) const;
     
+    /// Gets vector of four-center integrals computed by fused geometrical Hessian function.
+    /// @param label The label of requested four-center integral.
+    /// @param ang_moms The angular momentum of  A, B, C, and D centers.
+    /// @return The vector of gradient and second derivative integrals.
+    std::vector<I4CIntegral> _get_hessian_integrals(const std::string&        label,
+                                                    const std::array<int, 4>& ang_moms) const;
+    
     /// Generates set of geometrical terms required for geometrical derivatives.
     /// @param integrals The set of four center integrals.
     /// @return The set of geometrical terms.
     SG4Terms _generate_geom_terms_group(const SI4CIntegrals& integrals) const;
     
+    /// Generates set of geometrical terms, including horizontal recursion terms, for geometrical derivative integral.
+    /// @param integral The base four center integral.
+    /// @return The set of geometrical terms.
+    SG4Terms _generate_hrr_terms_group(const I4CIntegral& integral) const;
+    
     /// Adds bra horizontal recursion to geometrical terms.
     /// @param terms The set of geometrical terms.
     void _add_bra_hrr_terms_group(SG4Terms& terms) const;
@@ -134,24 +146,83 @@ class T4CGeomCPUGenerator
     /// @return The file name.
     std::string _file_name(const I4CIntegral& integral) const;
     
+    /// Gets file name of file with fused geometrical Hessian function for four center integral.
+    /// @param integral The base four center integral.
+    /// @return The file name.
+    std::string _hessian_file_name(const I4CIntegral& integral) const;
+    
+    /// Gets file name of file with compute function over flattened ket primitive lanes for four center integral.
+    /// @param integral The base four center integral.
+    /// @return The file name.
+    std::string _flat_file_name(const I4CIntegral& integral) const;
+    
+    /// Gets file name of file with J/K accumulating compute function for four center integral.
+    /// @param integral The base four center integral.
+    /// @return The file name.
+    std::string _jk_file_name(const I4CIntegral& integral) const;
+    
     /// Writes header file for recursion.
     /// @param cterms The set of filtered geometrical terms.
     /// @param ckterms The set of filtered geometrical terms.
     /// @param skterms The set of filtered geometrical terms.
     /// @param vrr_integrals The set of unique integrals for vertical recursion.
     /// @param integral The base two center integral.
+    /// @param prim_screening The primitive pairs screening threshold exponent (0 disables screening).
     void _write_cpp_header(const SG4Terms&      cterms,
                            const SG4Terms&      ckterms,
                            const SG4Terms&      skterms,
                            const SI4CIntegrals& vrr_integrals,
-                           const I4CIntegral&   integral) const;
+                           const I4CIntegral&   integral,
+                           const int            prim_screening) const;
+    
+    /// Writes header file for fused geometrical Hessian function.
+    /// @param cterms The set of filtered geometrical terms of all integrals.
+    /// @param ckterms The set of filtered geometrical terms of all integrals.
+    /// @param skterms The set of filtered geometrical terms of all integrals.
+    /// @param vrr_integrals The set of unique integrals for vertical recursion.
+    /// @param integrals The vector of geometrical derivative integrals.
+    /// @param prim_screening The primitive pairs screening threshold exponent (0 disables screening).
+    void _write_hessian_cpp_header(const SG4Terms&                 cterms,
+                                   const SG4Terms&                 ckterms,
+                                   const SG4Terms&                 skterms,
+                                   const SI4CIntegrals&            vrr_integrals,
+                                   const std::vector<I4CIntegral>& integrals,
+                                   const int                       prim_screening) const;
+    
+    /// Writes header file for compute function over flattened ket primitive lanes.
+    /// @param cterms The set of filtered geometrical terms.
+    /// @param ckterms The set of filtered geometrical terms.
+    /// @param skterms The set of filtered geometrical terms.
+    /// @param vrr_integrals The set of unique integrals for vertical recursion.
+    /// @param integral The base four center integral.
+    /// @param prim_screening The primitive pairs screening threshold exponent (0 disables screening).
+    void _write_flat_cpp_header(const SG4Terms&      cterms,
+                                const SG4Terms&      ckterms,
+                                const SG4Terms&      skterms,
+                                const SI4CIntegrals& vrr_integrals,
+                                const I4CIntegral&   integral,
+                                const int            prim_screening) const;
+    
+    /// Writes header file for compute function accumulating J/K contributions.
+    /// @param cterms The set of filtered geometrical terms.
+    /// @param ckterms The set of filtered geometrical terms.
+    /// @param skterms The set of filtered geometrical terms.
+    /// @param vrr_integrals The set of unique integrals for vertical recursion.
+    /// @param integral The base four center integral.
+    /// @param prim_screening The primitive pairs screening threshold exponent (0 disables screening).
+    void _write_jk_cpp_header(const SG4Terms&      cterms,
+                              const SG4Terms&      ckterms,
+                              const SG4Terms&      skterms,
+                              const SI4CIntegrals& vrr_integrals,
+                              const I4CIntegral&   integral,
+                              const int            prim_screening) const;
     
     /// Writes definitions of define for header file.
     /// @param fstream the file stream.
-    /// @param integral The base two center integral.
+    /// @param fname The file name.
     /// @param start The flag to indicate position of define (start or end).
     void _write_hpp_defines(      std::ofstream& fstream,
-                            const I4CIntegral&   integral,
+                            const std::string&   fname,
                             const bool           start) const;
     
     /// Writes definitions of includes for header file.
@@ -160,11 +231,17 @@ class T4CGeomCPUGenerator
     /// @param skterms The set of filtered geometrical terms.
     /// @param vrr_integrals The set of unique integrals for vertical recursion.
     /// @param integral The base two center integral.
+    /// @param prim_screening The primitive pairs screening threshold exponent (0 disables screening).
+    /// @param flat_lanes The flag to include headers of compute function over flattened ket primitive lanes.
+    /// @param jk_accumulate The flag to include headers of compute function accumulating J/K contributions.
     void _write_hpp_includes(      std::ofstream& fstream,
                              const SG4Terms&      ckterms,
                              const SG4Terms&      skterms,
                              const SI4CIntegrals& vrr_integrals,
-                             const I4CIntegral&   integral) const;
+                             const I4CIntegral&   integral,
+                             const int            prim_screening,
+                             const bool           flat_lanes,
+                             const bool           jk_accumulate) const;
     
     /// Writes namespace definition to file stream.
     /// @param fstream the file stream.
@@ -186,9 +263,47 @@ public:
     /// @param label The label of requested two-center integral.
     /// @param max_ang_mom The maximum angular momentum of A, B, C and D centers.
     /// @param geom_drvs The geometrical derivative of bra side, integrand, and  ket side.
+    /// @param prim_screening The primitive pairs screening threshold exponent n, i.e. threshold 10^-n (0 disables screening).
     void generate(const std::string&        label,
                   const int                 max_ang_mom,
-                  const std::array<int, 5>& geom_drvs) const;
+                  const std::array<int, 5>& geom_drvs,
+                  const int                 prim_screening) const;
+    
+    /// Generates fused geometrical Hessian functions for selected four-center integrals up to given angular
+    /// momentum (inclusive) on A, B, C, and D centers. Each function computes (10|, (01|, (20|, (11|, and (10|10)
+    /// derivatives of single quadruple from one vertical recursion and shared horizontal recursion buffers.
+    /// @param label The label of requested four-center integral.
+    /// @param max_ang_mom The maximum angular momentum of A, B, C and D centers.
+    /// @param prim_screening The primitive pairs screening threshold exponent n, i.e. threshold 10^-n (0 disables screening).
+    void generate_hessian(const std::string& label,
+                          const int          max_ang_mom,
+                          const int          prim_screening) const;
+    
+    /// Generates compute functions over flattened ket primitive lanes for selected four-center integrals up
+    /// to given angular momentum (inclusive) on A, B, C, and D centers. Each function takes all ket pair blocks
+    /// of quadruple, sorted by number of primitive pairs, and packs primitive lanes of pairs with different
+    /// contraction depth into shared SIMD batches, which are contracted by segmented reduction.
+    /// @param label The label of requested four-center integral.
+    /// @param max_ang_mom The maximum angular momentum of A, B, C and D centers.
+    /// @param geom_drvs The geometrical derivative of bra side, integrand, and  ket side.
+    /// @param prim_screening The primitive pairs screening threshold exponent n, i.e. threshold 10^-n (0 disables screening).
+    void generate_flat(const std::string&        label,
+                       const int                 max_ang_mom,
+                       const std::array<int, 5>& geom_drvs,
+                       const int                 prim_screening) const;
+    
+    /// Generates compute functions accumulating J/K contributions for selected four-center integrals up to
+    /// given angular momentum (inclusive) on A, B, C, and D centers. The bra transformation is fused with
+    /// accumulation, so each spherical integral is handed to accumulator as soon as it is formed and the
+    /// spherical integrals buffer is never stored.
+    /// @param label The label of requested four-center integral.
+    /// @param max_ang_mom The maximum angular momentum of A, B, C and D centers.
+    /// @param geom_drvs The geometrical derivative of bra side, integrand, and  ket side.
+    /// @param prim_screening The primitive pairs screening threshold exponent n, i.e. threshold 10^-n (0 disables screening).
+    void generate_jk(const std::string&        label,
+                     const int                 max_ang_mom,
+                     const std::array<int, 5>& geom_drvs,
+                     const int                 prim_screening) const;
 };
 
 #endif /* t4c_geom_cpu_generators_hpp */
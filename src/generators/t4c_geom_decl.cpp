@@ -48,6 +48,122 @@ T4CGeomDeclDriver::write_func_decl(      std::ofstream& fstream,
     ost::write_code_lines(fstream, lines);
 }
 
+void
+T4CGeomDeclDriver::write_func_decl(      std::ofstream& fstream,
+                                   const SI4CIntegrals& geom_integrals,
+                                   const I4CIntegral&   integral,
+                                   const bool           terminus) const
+{
+    auto lines = VCodeLines();
+    
+    lines.push_back({0, 0, 1, "auto"});
+    
+    for (const auto& label : _get_buffers_str(geom_integrals, integral))
+    {
+        lines.push_back({0, 0, 1, label});
+    }
+    
+    for (const auto& label : _get_recursion_variables_str(integral, terminus))
+    {
+        lines.push_back({0, 0, 1, label});
+    }
+    
+    ost::write_code_lines(fstream, lines);
+}
+
+void
+T4CGeomDeclDriver::write_fused_func_decl(      std::ofstream&            fstream,
+                                         const std::vector<I4CIntegral>& integrals,
+                                         const bool                      terminus) const
+{
+    auto lines = VCodeLines();
+    
+    lines.push_back({0, 0, 1, "template <class T>"});
+    
+    lines.push_back({0, 0, 1, "inline auto"});
+    
+    auto name = t4c::hessian_compute_func_name(integrals.front()) + "(";
+    
+    const auto spacer = std::string(name.size(), ' ');
+    
+    for (const auto& tint : integrals)
+    {
+        lines.push_back({0, 0, 1, name + "T& " + t4c::distributor_label(tint) + ","});
+        
+        name = spacer;
+    }
+    
+    lines.push_back({0, 0, 1, spacer + "const CGtoPairBlock& bra_gto_pair_block,"});
+        
+    lines.push_back({0, 0, 1, spacer + "const CGtoPairBlock& ket_gto_pair_block,"});
+    
+    const auto tsymbol = (terminus) ? ";" : "";
+    
+    lines.push_back({0, 0, 1, spacer + "const std::pair<size_t, size_t>& bra_indices,"});
+        
+    lines.push_back({0, 0, 1, spacer + "const std::pair<size_t, size_t>& ket_indices) -> void" + tsymbol});
+    
+    ost::write_code_lines(fstream, lines);
+}
+
+void
+T4CGeomDeclDriver::write_flat_func_decl(      std::ofstream& fstream,
+                                        const I4CIntegral&   integral,
+                                        const bool           terminus) const
+{
+    auto lines = VCodeLines();
+    
+    lines.push_back({0, 0, 1, "template <class T>"});
+    
+    lines.push_back({0, 0, 1, "inline auto"});
+    
+    const auto name = t4c::flat_compute_func_name(integral) + "(";
+    
+    const auto spacer = std::string(name.size(), ' ');
+    
+    const auto tsymbol = (terminus) ? ";" : "";
+    
+    lines.push_back({0, 0, 1, name + "T& distributor,"});
+    
+    lines.push_back({0, 0, 1, spacer + "const CGtoPairBlock& bra_gto_pair_block,"});
+        
+    lines.push_back({0, 0, 1, spacer + "const std::vector<CGtoPairBlock>& ket_gto_pair_blocks,"});
+    
+    lines.push_back({0, 0, 1, spacer + "const std::pair<size_t, size_t>& bra_indices) -> void" + tsymbol});
+    
+    ost::write_code_lines(fstream, lines);
+}
+
+void
+T4CGeomDeclDriver::write_jk_func_decl(      std::ofstream& fstream,
+                                      const I4CIntegral&   integral,
+                                      const bool           terminus) const
+{
+    auto lines = VCodeLines();
+    
+    lines.push_back({0, 0, 1, "template <class T>"});
+    
+    lines.push_back({0, 0, 1, "inline auto"});
+    
+    const auto name = t4c::jk_compute_func_name(integral) + "(";
+    
+    const auto spacer = std::string(name.size(), ' ');
+    
+    const auto tsymbol = (terminus) ? ";" : "";
+    
+    lines.push_back({0, 0, 1, name + "T& accumulator,"});
+    
+    lines.push_back({0, 0, 1, spacer + "const CGtoPairBlock& bra_gto_pair_block,"});
+        
+    lines.push_back({0, 0, 1, spacer + "const CGtoPairBlock& ket_gto_pair_block,"});
+    
+    lines.push_back({0, 0, 1, spacer + "const std::pair<size_t, size_t>& bra_indices,"});
+        
+    lines.push_back({0, 0, 1, spacer + "const std::pair<size_t, size_t>& ket_indices) -> void" + tsymbol});
+    
+    ost::write_code_lines(fstream, lines);
+}
+
 std::vector<std::string>
 T4CGeomDeclDriver::_get_matrices_str(const I4CIntegral& integral) const
 {
@@ -69,6 +69,40 @@ public:
     void write_func_decl(      std::ofstream& fstream,
                          const I4CIntegral&   integral,
                          const bool           terminus) const;
+    
+    /// Writes declaration for geometrical derivatives compute function.
+    /// @param fstream the file stream.
+    /// @param geom_integrals The set of unique integrals for geometrical recursion.
+    /// @param integral The base four center integral.
+    /// @param terminus The flag to add termination symbol.
+    void write_func_decl(      std::ofstream& fstream,
+                         const SI4CIntegrals& geom_integrals,
+                         const I4CIntegral&   integral,
+                         const bool           terminus) const;
+    
+    /// Writes declaration for fused geometrical Hessian compute function.
+    /// @param fstream the file stream.
+    /// @param integrals The vector of geometrical derivative integrals computed by function.
+    /// @param terminus The flag to add termination symbol.
+    void write_fused_func_decl(      std::ofstream&            fstream,
+                               const std::vector<I4CIntegral>& integrals,
+                               const bool                      terminus) const;
+    
+    /// Writes declaration for compute function over flattened ket primitive lanes.
+    /// @param fstream the file stream.
+    /// @param integral The base four center integral.
+    /// @param terminus The flag to add termination symbol.
+    void write_flat_func_decl(      std::ofstream& fstream,
+                              const I4CIntegral&   integral,
+                              const bool           terminus) const;
+    
+    /// Writes declaration for compute function accumulating J/K contributions.
+    /// @param fstream the file stream.
+    /// @param integral The base four center integral.
+    /// @param terminus The flag to add termination symbol.
+    void write_jk_func_decl(      std::ofstream& fstream,
+                            const I4CIntegral&   integral,
+                            const bool           terminus) const;
 };
 
 #endif /* t4c_geom_decl_hpp */
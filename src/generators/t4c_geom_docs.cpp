@@ -45,6 +45,115 @@ T4CGeomDocuDriver::write_doc_str(      std::ofstream& fstream,
     ost::write_code_lines(fstream, lines);
 }
 
+void
+T4CGeomDocuDriver::write_doc_str(      std::ofstream& fstream,
+                                 const SI4CIntegrals& geom_integrals,
+                                 const I4CIntegral&   integral) const
+{
+    auto lines = VCodeLines();
+    
+    lines.push_back({0, 0, 1, _get_compute_str(integral)});
+    
+    for (const auto& label : _get_buffers_str(geom_integrals, integral))
+    {
+        lines.push_back({0, 0, 1, label});
+    }
+    
+    for (const auto& label : _get_recursion_variables_str(integral))
+    {
+        lines.push_back({0, 0, 1, label});
+    }
+    
+    ost::write_code_lines(fstream, lines);
+}
+
+void
+T4CGeomDocuDriver::write_fused_doc_str(      std::ofstream&            fstream,
+                                       const std::vector<I4CIntegral>& integrals) const
+{
+    auto lines = VCodeLines();
+    
+    const auto integral = integrals.front();
+    
+    std::string label = "/// @brief Computes (" + Tensor(integral[0]).label() + Tensor(integral[1]).label() + "|";
+    
+    label += t4c::integrand_label(integral.integrand()) + "|" + Tensor(integral[2]).label() + Tensor(integral[3]).label() + ")  integral derivatives";
+    
+    lines.push_back({0, 0, 1, label + " sharing single vertical recursion."});
+    
+    for (const auto& tint : integrals)
+    {
+        label = "/// @param " + t4c::distributor_label(tint) + " The pointer to Fock matrix/matrices distributor of ";
+        
+        lines.push_back({0, 0, 1, label + t4c::prefixes_label(tint) + " integral derivatives."});
+    }
+    
+    for (const auto& label : _get_gto_pair_blocks_str(integral))
+    {
+        lines.push_back({0, 0, 1, label});
+    }
+        
+    for (const auto& label : _get_indices_str())
+    {
+        lines.push_back({0, 0, 1, label});
+    }
+    
+    ost::write_code_lines(fstream, lines);
+}
+
+void
+T4CGeomDocuDriver::write_flat_doc_str(      std::ofstream& fstream,
+                                      const I4CIntegral&   integral) const
+{
+    auto lines = VCodeLines();
+    
+    auto label = _get_compute_str(integral);
+    
+    label.replace(label.size() - 1, 1, " over flattened ket primitive lanes.");
+    
+    lines.push_back({0, 0, 1, label});
+    
+    for (const auto& label : _get_matrices_str(integral))
+    {
+        lines.push_back({0, 0, 1, label});
+    }
+    
+    lines.push_back({0, 0, 1, "/// @param bra_gto_pair_block The GTOs pair block on bra side."});
+    
+    lines.push_back({0, 0, 1, "/// @param ket_gto_pair_blocks The GTOs pair blocks on ket side, sorted by number of primitive pairs."});
+    
+    lines.push_back({0, 0, 1, "/// @param bra_indices The range [bra_first, bra_last) of basis function pairs on bra side."});
+    
+    ost::write_code_lines(fstream, lines);
+}
+
+void
+T4CGeomDocuDriver::write_jk_doc_str(      std::ofstream& fstream,
+                                    const I4CIntegral&   integral) const
+{
+    auto lines = VCodeLines();
+    
+    auto label = _get_compute_str(integral);
+    
+    label.replace(label.size() - 1, 1, " and accumulates them into Fock matrices.");
+    
+    lines.push_back({0, 0, 1, label});
+    
+    lines.push_back({0, 0, 1, "/// @param accumulator The J/K accumulator, providing range separation factor and adding one spherical integral (ab|cd) to Fock matrices."});
+
+    for (const auto& label : _get_gto_pair_blocks_str(integral))
+    {
+        lines.push_back({0, 0, 1, label});
+    }
+        
+    for (const auto& label : _get_indices_str())
+    {
+        lines.push_back({0, 0, 1, label});
+    }
+    
+    ost::write_code_lines(fstream, lines);
+}
+
 std::string
 T4CGeomDocuDriver::_get_compute_str(const I4CIntegral& integral) const
 {
@@ -72,6 +72,32 @@ public:
     void write_doc_str(      std::ofstream& fstream,
                        const I4CIntegral&   integral) const;
     
+    /// Writes documentation string for geometrical derivatives compute function.
+    /// @param fstream the file stream.
+    /// @param geom_integrals The set of unique integrals for geometrical recursion.
+    /// @param integral The base four center integral.
+    void write_doc_str(      std::ofstream& fstream,
+                       const SI4CIntegrals& geom_integrals,
+                       const I4CIntegral&   integral) const;
+    
+    /// Writes documentation string for fused geometrical Hessian compute function.
+    /// @param fstream the file stream.
+    /// @param integrals The vector of geometrical derivative integrals computed by function.
+    void write_fused_doc_str(      std::ofstream&            fstream,
+                             const std::vector<I4CIntegral>& integrals) const;
+    
+    /// Writes documentation string for compute function over flattened ket primitive lanes.
+    /// @param fstream the file stream.
+    /// @param integral The base four center integral.
+    void write_flat_doc_str(      std::ofstream& fstream,
+                            const I4CIntegral&   integral) const;
+    
+    /// Writes documentation string for compute function accumulating J/K contributions.
+    /// @param fstream the file stream.
+    /// @param integral The base four center integral.
+    void write_jk_doc_str(      std::ofstream& fstream,
+                          const I4CIntegral&   integral) const;
+    
 };
 
 #endif /* t4c_geom_docs_hpp */
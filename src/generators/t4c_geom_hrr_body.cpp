@@ -80,7 +80,7 @@ T4CGeomHrrFuncBodyDriver::write_ket_func_body(      std::ofstream& fstream,
     
     for (const auto& prefix : integral.prefixes())
     {
-        gcomps *= prefix.components().size();
+        gcomps *= prefix.number_of_components();
     }
     
     for (int i = 0; i < bcomps *  gcomps; i++)
@@ -503,7 +503,7 @@ T4CGeomHrrFuncBodyDriver::_get_ket_buffers_str(const std::vector<R4CDist>& rec_d
         
         int index = 0;
         
-        for (const auto& tcomp : tint.components<T2CPair, T2CPair>())
+        for (const auto& tcomp : tint.component_range<T2CPair, T2CPair>())
         {
             //if (_find_integral(rec_dists, tcomp))
             //{
@@ -542,7 +542,7 @@ T4CGeomHrrFuncBodyDriver::_get_ket_geom_buffers_str(const std::vector<R4CDist>&
             
             int index = 0;
             
-            for (const auto& tcomp : tint.components<T2CPair, T2CPair>())
+            for (const auto& tcomp : tint.component_range<T2CPair, T2CPair>())
             {
                 //if (_find_integral(rec_dists, tcomp))
                 //{
@@ -577,7 +577,7 @@ T4CGeomHrrFuncBodyDriver::_get_ket_geom_buffers_str(const std::vector<R4CDist>&
                 
                 int index = 0;
                 
-                for (const auto& tcomp : tint.components<T2CPair, T2CPair>())
+                for (const auto& tcomp : tint.component_range<T2CPair, T2CPair>())
                 {
                     const auto line = "auto " + _get_ket_component_label(tcomp) + " = " + label;
                     
@@ -598,7 +598,7 @@ T4CGeomHrrFuncBodyDriver::_get_ket_geom_buffers_str(const std::vector<R4CDist>&
                 
                 int index = 0;
                 
-                for (const auto& tcomp : tint.components<T2CPair, T2CPair>())
+                for (const auto& tcomp : tint.component_range<T2CPair, T2CPair>())
                 {
                     //if (_find_integral(rec_dists, tcomp))
                     //{
@@ -696,7 +696,7 @@ T4CGeomHrrFuncBodyDriver::_get_bra_buffers_str(const std::vector<R4CDist>& rec_d
         
         int index = 0;
         
-        for (const auto& tcomp : tint.components<T2CPair, T2CPair>())
+        for (const auto& tcomp : tint.component_range<T2CPair, T2CPair>())
         {
 //            if (_find_integral(rec_dists, tcomp))
 //            {
@@ -824,7 +824,7 @@ T4CGeomHrrFuncBodyDriver::_get_ket_component_label(const T4CIntegral& integral)
 std::string
 T4CGeomHrrFuncBodyDriver::_get_bra_offset_def(const I4CIntegral& integral) const
 {
-    const auto tlabel = std::to_string(integral.components<T2CPair, T2CPair>().size());
+    const auto tlabel = std::to_string(integral.number_of_components());
     
     auto label = "const auto " + _get_bra_offset_label(integral) + " = ";
     
@@ -836,7 +836,7 @@ T4CGeomHrrFuncBodyDriver::_get_bra_offset_def(const I4CIntegral& integral) const
 std::string
 T4CGeomHrrFuncBodyDriver::_get_full_bra_offset_def(const I4CIntegral& integral) const
 {
-    const auto tlabel = std::to_string(integral.components<T2CPair, T2CPair>().size());
+    const auto tlabel = std::to_string(integral.number_of_components());
     
     auto label = "const auto " + _get_full_bra_offset_label(integral) + " = ";
     
@@ -848,7 +848,7 @@ T4CGeomHrrFuncBodyDriver::_get_full_bra_offset_def(const I4CIntegral& integral)
 std::string
 T4CGeomHrrFuncBodyDriver::_get_ket_offset_def(const I4CIntegral& integral) const
 {
-    // const auto tlabel = std::to_string(integral.components<T2CPair, T2CPair>().size());
+    // const auto tlabel = std::to_string(integral.number_of_components());
     
     const auto bcomps = t2c::number_of_cartesian_components(integral[2]);
     
@@ -16,6 +16,8 @@
 
 #include "t4c_geom_hrr_cpu_generators.hpp"
 
+#include <stdexcept>
+
 #include "string_formater.hpp"
 #include "file_stream.hpp"
 
@@ -106,11 +108,7 @@ T4CGeomHrrCPUGenerator::generate(const std::string&        label,
     }
     else
     {
-        std::cerr << "*** ERROR *** Unsupported type of four-center integral: ";
-        
-        std::cerr << label << " !!!" << std::endl;
-        
-        std::exit(EXIT_FAILURE);
+        throw std::invalid_argument("Unsupported type of four-center integral: " + label);
     }
 }
 
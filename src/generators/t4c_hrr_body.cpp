@@ -192,7 +192,7 @@ T4CHrrFuncBodyDriver::_get_ket_buffers_str(const std::vector<R4CDist>& rec_dists
         
         int index = 0;
         
-        for (const auto& tcomp : tint.components<T2CPair, T2CPair>())
+        for (const auto& tcomp : tint.component_range<T2CPair, T2CPair>())
         {
             if (_find_integral(rec_dists, tcomp))
             {
@@ -248,7 +248,7 @@ T4CHrrFuncBodyDriver::_get_bra_buffers_str(const std::vector<R4CDist>& rec_dists
         
         int index = 0;
         
-        for (const auto& tcomp : tint.components<T2CPair, T2CPair>())
+        for (const auto& tcomp : tint.component_range<T2CPair, T2CPair>())
         {
             if (_find_integral(rec_dists, tcomp))
             {
@@ -647,7 +647,7 @@ T4CHrrFuncBodyDriver::_get_ket_component_label(const T4CIntegral& integral) cons
 std::string
 T4CHrrFuncBodyDriver::_get_ket_offset_def(const I4CIntegral& integral) const
 {
-    const auto tlabel = std::to_string(integral.components<T2CPair, T2CPair>().size());
+    const auto tlabel = std::to_string(integral.number_of_components());
     
     auto label = "const auto " + _get_ket_offset_label(integral) + " = ";
     
@@ -679,7 +679,7 @@ T4CHrrFuncBodyDriver::_get_bra_component_label(const T4CIntegral& integral) cons
 std::string
 T4CHrrFuncBodyDriver::_get_bra_offset_def(const I4CIntegral& integral) const
 {
-    const auto tlabel = std::to_string(integral.components<T2CPair, T2CPair>().size());
+    const auto tlabel = std::to_string(integral.number_of_components());
     
     auto label = "const auto " + _get_bra_offset_label(integral) + " = ";
     
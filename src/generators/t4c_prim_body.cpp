@@ -148,7 +148,7 @@ T4CPrimFuncBodyDriver::_get_buffers_str(const std::vector<R4CDist>& rec_dists,
         
         int index = 0;
         
-        for (const auto& tcomp : tint.components<T2CPair, T2CPair>())
+        for (const auto& tcomp : tint.component_range<T2CPair, T2CPair>())
         {
             if (_find_integral(rec_dists, tcomp))
             {
@@ -16,7 +16,10 @@
 
 #include "t4c_utils.hpp"
 
+#include <algorithm>
+
 #include "string_formater.hpp"
+#include "tensor.hpp"
 
 #include "v4i_eri_driver.hpp"
 #include "t4c_center_driver.hpp"
@@ -130,6 +133,39 @@ diag_compute_func_name(const I4CIntegral& integral)
     return fstr::lowercase(label);
 }
 
+std::string
+hessian_compute_func_name(const I4CIntegral& integral)
+{
+    auto label = "comp_" + t4c::integral_split_label(integral) + "_geom_hessian_" + integral.label();
+        
+    return fstr::lowercase(label);
+}
+
+std::string
+flat_compute_func_name(const I4CIntegral& integral)
+{
+    return "comp_flat_" + t4c::compute_func_name(integral).substr(5);
+}
+
+std::string
+jk_compute_func_name(const I4CIntegral& integral)
+{
+    return "comp_jk_" + t4c::compute_func_name(integral).substr(5);
+}
+
+std::string
+distributor_label(const I4CIntegral& integral)
+{
+    std::string label = "distributor_geom";
+    
+    for (const auto& prefix : integral.prefixes())
+    {
+        label += std::to_string(prefix.shape().order());
+    }
+    
+    return label;
+}
+
 std::string
 get_buffer_label(const I4CIntegral& integral,
                  const std::string& prefix)
@@ -788,4 +824,103 @@ prune_term(const G4Term& term)
     return term;
 }
 
+std::string
+spherical_coef_label(const sphar::SphericalFactor& coef)
+{
+    std::string label = std::to_string(coef.factor.numerator()) + ".0";
+    
+    if (coef.factor.denominator() != 1) label += " / " + std::to_string(coef.factor.denominator()) + ".0";
+    
+    if (coef.radicand != 1) label += " * std::sqrt(" + std::to_string(coef.radicand) + ".0)";
+    
+    return "(" + label + ")";
+}
+
+std::vector<std::pair<size_t, sphar::SphericalFactor>>
+spherical_pair_terms(const int cang, const int dang, const int m, const int n)
+{
+    std::vector<std::pair<size_t, sphar::SphericalFactor>> terms;
+    
+    const auto ctcomps = Tensor(cang).components();
+    
+    const auto dtcomps = Tensor(dang).components();
+    
+    const auto dcomps = dtcomps.size();
+    
+    for (const auto& term : sphar::two_center_spherical_factors(cang, dang, m, n))
+    {
+        const auto cindex = static_cast<size_t>(std::find(ctcomps.begin(), ctcomps.end(), term.bra) - ctcomps.begin());
+        
+        const auto dindex = static_cast<size_t>(std::find(dtcomps.begin(), dtcomps.end(), term.ket) - dtcomps.begin());
+        
+        terms.push_back({cindex * dcomps + dindex, term.factor});
+    }
+    
+    return terms;
+}
+
+std::string
+sparse_sum(const std::vector<SparseTerm>& terms)
+{
+    std::vector<std::pair<sphar::SphericalFactor, std::vector<SparseTerm>>> groups;
+    
+    for (const auto& [row, coef] : terms)
+    {
+        const auto mag = sphar::SphericalFactor(coef.factor.abs(), coef.radicand);
+        
+        auto group = std::find_if(groups.begin(), groups.end(), [&](const auto& tgroup) { return tgroup.first == mag; });
+        
+        if (group == groups.end())
+        {
+            groups.push_back({mag, {}});
+            
+            group = groups.end() - 1;
+        }
+        
+        group->second.push_back({row, coef});
+    }
+    
+    std::string label;
+    
+    for (const auto& [mag, gterms] : groups)
+    {
+        // sign of leading term is moved in front of group
+        
+        const bool negative = gterms[0].second.factor < Fraction(0);
+        
+        std::string sum;
+        
+        for (const auto& [row, coef] : gterms)
+        {
+            const bool minus = (coef.factor < Fraction(0)) != negative;
+            
+            if (sum.empty())
+            {
+                sum = row + "[k]";
+            }
+            else
+            {
+                sum += (minus ? " - " : " + ") + row + "[k]";
+            }
+        }
+        
+        const bool unit = (mag.radicand == 1) && (mag.factor == Fraction(1));
+        
+        if ((gterms.size() > 1) && (negative || !unit)) sum = "(" + sum + ")";
+        
+        if (!unit) sum = spherical_coef_label(mag) + " * " + sum;
+        
+        if (label.empty())
+        {
+            label = (negative ? "-" : "") + sum;
+        }
+        else
+        {
+            label += (negative ? " - " : " + ") + sum;
+        }
+    }
+    
+    return label.empty() ? "0.0" : label;
+}
+
 } // t4c namespace
@@ -19,8 +19,12 @@
 
 #include <string>
 #include <array>
+#include <tuple>
+#include <utility>
+#include <vector>
 
 #include "t4c_defs.hpp"
+#include "spherical_harmonics.hpp"
 
 namespace t4c { // t4c namespace
 
@@ -58,6 +62,26 @@ std::string compute_func_name(const I4CIntegral& integral);
 /// @return The compute function name.
 std::string diag_compute_func_name(const I4CIntegral& integral);
 
+/// Generates fused geometrical Hessian compute function name.
+/// @param integral The base four center integral.
+/// @return The fused compute function name.
+std::string hessian_compute_func_name(const I4CIntegral& integral);
+
+/// Generates flattened ket lanes compute function name.
+/// @param integral The base four center integral.
+/// @return The flattened ket lanes compute function name.
+std::string flat_compute_func_name(const I4CIntegral& integral);
+
+/// Generates J/K accumulating compute function name.
+/// @param integral The base four center integral.
+/// @return The J/K accumulating compute function name.
+std::string jk_compute_func_name(const I4CIntegral& integral);
+
+/// Generates distributor label for geometrical derivative integral.
+/// @param integral The base four center integral.
+/// @return The distributor label.
+std::string distributor_label(const I4CIntegral& integral);
+
 /// Generates integral buffer label.
 /// @param integral The base two center integral.
 /// @return The string with integral label.
@@ -196,6 +220,38 @@ std::string get_full_hrr_index(const I4CIntegral& integral,
 /// @return The pruned geometrical recursion term.
 G4Term prune_term(const G4Term& term);
 
+/// One non-zero term of a sparse Cartesian-to-spherical transformation: source
+/// row label and exact coefficient.
+using SparseTerm = std::pair<std::string, sphar::SphericalFactor>;
+
+/// One term of diagonal (ab|ab) spherical component expanded by bra HRR down to
+/// half transformed (0b'|ab) integrals: row in half transformed buffer, exact
+/// coefficient, and powers of R(AB) components.
+using DiagTerm = std::tuple<size_t, sphar::SphericalFactor, std::array<int, 3>>;
+
+/// Gets exact transformation coefficient as floating point expression.
+/// @param coef The transformation coefficient.
+/// @return The coefficient expression, e.g. "(1.0 / 2.0 * std::sqrt(3.0))".
+std::string spherical_coef_label(const sphar::SphericalFactor& coef);
+
+/// Gets the non-zero terms of spherical (m, n) component of (c|d) pair, with
+/// source rows given as offsets into Cartesian (c|d) block.
+/// @param cang The angular momentum of center C.
+/// @param dang The angular momentum of center D.
+/// @param m The spherical component of center C.
+/// @param n The spherical component of center D.
+/// @return The vector of (Cartesian offset, coefficient) terms.
+std::vector<std::pair<size_t, sphar::SphericalFactor>> spherical_pair_terms(const int cang,
+                                                                            const int dang,
+                                                                            const int m,
+                                                                            const int n);
+
+/// Gets sum of sparse terms with equal coefficient magnitudes grouped together,
+/// i.e. c1 * (a[k] - b[k]) + c2 * e[k].
+/// @param terms The sparse terms.
+/// @return The sum expression indexed by k.
+std::string sparse_sum(const std::vector<SparseTerm>& terms);
+
 } // t4c namespace
 
 #endif /* t4c_utils_hpp */
@@ -0,0 +1,645 @@
+// LITMUS: An Automated Molecular Integrals Generator
+// Copyright 2022 Z. Rinkevicius, KTH, Sweden.
+// E-mail: rinkevic@kth.se
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "three_center_emitters.hpp"
+
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "config.hpp"
+#include "emitter_utils.hpp"
+#include "file_stream.hpp"
+#include "operator.hpp"
+#include "string_formater.hpp"
+#include "tensor.hpp"
+
+#include "v3i_eri_driver.hpp"
+
+namespace {  // C++/CPU emitter helpers
+
+/// The naming tags for an integrand operator: the (C++17 nested) namespace the
+/// kernel lives in and the CamelCase label used in its file name.
+struct OperatorTags
+{
+    /// The fully-qualified kernel namespace, e.g. "os3c::eri".
+    std::string ns;
+
+    /// The CamelCase operator label used in file names, e.g. "ElectronRepulsion".
+    std::string file_label;
+
+    /// The human-readable operator caption for documentation.
+    std::string caption;
+};
+
+/// Maps an integrand operator to its naming tags. Only the operators the
+/// three-center generator currently supports are named; the rest fall through to
+/// a thrown error. The switch carries no default, so a new OperatorType trips
+/// -Wswitch here.
+/// @param op The integrand operator type.
+/// @return The naming tags for the operator.
+OperatorTags
+operator_tags(cfg::OperatorType op)
+{
+    switch (op)
+    {
+        case cfg::OperatorType::electron_repulsion:
+            return {"os3c::eri", "ElectronRepulsion", "electron repulsion"};
+
+        case cfg::OperatorType::long_range_electron_repulsion:
+            return {"os3c::erf", "LongRangeElectronRepulsion", "long-range electron repulsion"};
+
+        case cfg::OperatorType::short_range_electron_repulsion:
+            return {"os3c::erfc", "ShortRangeElectronRepulsion", "short-range electron repulsion"};
+
+        // remaining operators have no three-center kernel yet
+        case cfg::OperatorType::overlap:
+        case cfg::OperatorType::kinetic_energy:
+        case cfg::OperatorType::nuclear_potential:
+        case cfg::OperatorType::dipole_momentum:
+        case cfg::OperatorType::linear_momentum:
+        case cfg::OperatorType::three_center_overlap:
+        case cfg::OperatorType::three_center_r2:
+        case cfg::OperatorType::three_center_r_dot_r2:
+        case cfg::OperatorType::local_ecp:
+        case cfg::OperatorType::projected_ecp:
+            break;
+    }
+
+    throw cfg::ConfigError("three-center emitter: operator '" + cfg::to_string(op) +
+                           "' has no three-center kernel naming");
+}
+
+/// The lowercase spectroscopic shell label (s, p, d, f, ...) of an angular
+/// momentum.
+/// @param ang_mom The angular momentum.
+/// @return The lowercase shell label.
+std::string
+shell_label(int ang_mom)
+{
+    return fstr::lowercase(Tensor(ang_mom).label());
+}
+
+/// The number of Cartesian components of a shell of angular momentum l,
+/// (l + 1)(l + 2)/2.
+/// @param l The angular momentum.
+/// @return The Cartesian component count.
+int
+cartesian_count(int l)
+{
+    return (l + 1) * (l + 2) / 2;
+}
+
+/// The Cartesian row count of a three-center integral block (A|o|cd).
+/// @param integral The three-center integral.
+/// @return The Cartesian component count of the block.
+int
+cartesian_rows(const I3CIntegral& integral)
+{
+    return cartesian_count(integral[0]) * cartesian_count(integral[1]) * cartesian_count(integral[2]);
+}
+
+/// The order-indexed name of a primitive integral, e.g. (P|o|SD)^1 -> "psd_1".
+/// @param integral The three-center integral.
+/// @return The primitive variable name.
+std::string
+primitive_name(const I3CIntegral& integral)
+{
+    return shell_label(integral[0]) + shell_label(integral[1]) + shell_label(integral[2]) + "_" +
+           std::to_string(integral.order());
+}
+
+/// The name of a contracted Cartesian integral block, e.g. (P|o|PD) -> "cppd".
+/// @param integral The three-center integral.
+/// @return The contracted variable name.
+std::string
+contracted_name(const I3CIntegral& integral)
+{
+    return "c" + shell_label(integral[0]) + shell_label(integral[1]) + shell_label(integral[2]);
+}
+
+/// The kernel function name for a target integral, e.g. "compute_p_p_d".
+/// @param integral The target three-center integral.
+/// @return The function name.
+std::string
+kernel_func_name(const I3CIntegral& integral)
+{
+    return "compute_" + shell_label(integral[0]) + "_" + shell_label(integral[1]) + "_" +
+           shell_label(integral[2]);
+}
+
+/// The base file name (no extension) for a target integral's kernel, e.g.
+/// "ObaraSaikaThreeCenterElectronRepulsionPPD"; the .hpp/.cpp pair share it.
+/// @param run_config The run configuration (selects operator and precision).
+/// @param integral The target three-center integral.
+/// @return The base file name.
+std::string
+kernel_file_name(const cfg::RunConfiguration& run_config, const I3CIntegral& integral)
+{
+    return "ObaraSaikaThreeCenter" + operator_tags(run_config.operator_type).file_label +
+           Tensor(integral[0]).label() + Tensor(integral[1]).label() + Tensor(integral[2]).label() +
+           emit::precision_file_tag(run_config.precision);
+}
+
+/// The return type of a kernel for a storage form. The switch carries no
+/// default, so a new StorageForm trips -Wswitch here.
+/// @param form The storage form.
+/// @param precision The precision (selects the contracted value type).
+/// @return The return type name.
+std::string
+return_type(cfg::StorageForm form, cfg::Precision precision)
+{
+    switch (form)
+    {
+        case cfg::StorageForm::veloxchem_sparse:
+            return "osfunc::CArray<" + cfg::accumulator_type(precision) + ">";
+    }
+
+    return std::string();  // unreachable: every StorageForm is handled above
+}
+
+/// The input parameters of a kernel for a signature, as "type name" fragments.
+/// The screened signature takes a block of auxiliary basis functions on the bra
+/// and the screened pair block on the ket. The switch carries no default, so a
+/// new Signature trips -Wswitch here.
+/// @param signature The kernel signature convention.
+/// @return The input parameter fragments.
+std::vector<std::string>
+input_params(cfg::Signature signature)
+{
+    switch (signature)
+    {
+        case cfg::Signature::veloxchem_screened:
+            return {"const osfunc::CBasisFunctionBlock& aux", "const osfunc::CBasisFunctionPair& pair"};
+    }
+
+    return {};  // unreachable: every Signature is handled above
+}
+
+/// The header includes a kernel needs for its return and input types.
+/// @param run_config The run configuration (selects storage form and signature).
+/// @return The include lines (with quotes).
+std::vector<std::string>
+kernel_includes(const cfg::RunConfiguration& run_config)
+{
+    std::vector<std::string> vstr;
+
+    switch (run_config.storage_form)
+    {
+        case cfg::StorageForm::veloxchem_sparse:
+            vstr.push_back("#include \"Array.hpp\"");
+            break;
+    }
+
+    switch (run_config.signature)
+    {
+        case cfg::Signature::veloxchem_screened:
+            vstr.push_back("#include \"BasisFunctionBlock.hpp\"");
+            vstr.push_back("#include \"BasisFunctionPair.hpp\"");
+            break;
+    }
+
+    return vstr;
+}
+
+/// Formats a three-center integral as a "(A|operator|CD)" caption for use in
+/// generated comments.
+/// @param integral The three-center integral.
+/// @return The caption.
+std::string
+integral_caption(const I3CIntegral& integral)
+{
+    return "(" + Tensor(integral[0]).label() + "|" + integral.integrand().name() + "|" +
+           Tensor(integral[1]).label() + Tensor(integral[2]).label() + ")";
+}
+
+/// The three-center emitter for the C++ language on CPU hardware. Produces a
+/// header/definition pair whose body lays out the Boys-seeded workflow (Boys
+/// values -> bra and ket VRR -> contraction -> ket HRR -> spherical store) over
+/// an auxiliary basis function block and a screened pair block.
+class CppCpuThreeCenterEmitter : public ThreeCenterEmitter
+{
+    /// Writes the kernel declaration header (.hpp).
+    void _write_hpp(const cfg::RunConfiguration& run_config,
+                    const I3CIntegral&           integral,
+                    ost::OutputSink&             sink) const;
+
+    /// Writes the kernel definition (.cpp) carrying the computation workflow.
+    void _write_cpp(const cfg::RunConfiguration& run_config,
+                    const I3CIntegral&           integral,
+                    const SI3CIntegrals&         hrr_ints,
+                    const SI3CIntegrals&         vrr_base_ints,
+                    const SI3CIntegrals&         vrr_rest_ints,
+                    ost::OutputSink&             sink) const;
+
+    /// The kernel signature, as code lines, broken across lines and aligned
+    /// under the function name when there is more than one input parameter.
+    /// @param run_config The run configuration (selects inputs and return type).
+    /// @param integral The target integral (names the function).
+    /// @param terminus Whether to terminate with a ';' (declaration).
+    /// @return The signature lines.
+    std::vector<std::string> _signature_lines(const cfg::RunConfiguration& run_config,
+                                               const I3CIntegral&           integral,
+                                               const bool                   terminus) const;
+
+public:
+    void emit(const cfg::RunConfiguration& run_config,
+              const I3CIntegral&           integral,
+              const SI3CIntegrals&         hrr_ints,
+              const SI3CIntegrals&         vrr_base_ints,
+              const SI3CIntegrals&         vrr_rest_ints,
+              ost::OutputSink&             sink) const override;
+};
+
+std::vector<std::string>
+CppCpuThreeCenterEmitter::_signature_lines(const cfg::RunConfiguration& run_config,
+                                           const I3CIntegral&           integral,
+                                           const bool                   terminus) const
+{
+    std::vector<std::string> vstr;
+
+    const auto name = kernel_func_name(integral) + "(";
+
+    const auto spacer = std::string(name.size(), ' ');
+
+    auto params = input_params(run_config.signature);
+
+    if (cfg::is_range_separated(run_config.operator_type))
+    {
+        params.insert(params.end(), {"const double omega", "const double alpha", "const double beta"});
+    }
+
+    const auto tail = ") -> " + return_type(run_config.storage_form, run_config.precision) + (terminus ? ";" : "");
+
+    for (std::size_t i = 0; i < params.size(); i++)
+    {
+        const auto head = (i == 0) ? name : spacer;
+
+        const auto last = (i + 1 == params.size());
+
+        vstr.push_back(head + params[i] + (last ? tail : ","));
+    }
+
+    return vstr;
+}
+
+void
+CppCpuThreeCenterEmitter::_write_hpp(const cfg::RunConfiguration& run_config,
+                                     const I3CIntegral&           integral,
+                                     ost::OutputSink&             sink) const
+{
+    const auto tags = operator_tags(run_config.operator_type);
+
+    const auto ns = emit::precision_namespace(tags.ns, run_config.precision);
+
+    const auto base = kernel_file_name(run_config, integral);
+
+    const auto guard = base + "_hpp";
+
+    auto lines = VCodeLines();
+
+    lines.push_back({0, 0, 1, "#ifndef " + guard});
+    lines.push_back({0, 0, 2, "#define " + guard});
+
+    for (const auto& include : kernel_includes(run_config))
+    {
+        lines.push_back({0, 0, 1, include});
+    }
+    lines.push_back({0, 0, 1, ""});
+
+    lines.push_back({0, 0, 2, "namespace " + ns + " {  // " + tags.caption +
+                                  " three-center integrals"});
+
+    lines.push_back({0, 0, 1, "/// @brief Computes " + integral_caption(integral) +
+                                  " integrals for a block of auxiliary basis functions and a"});
+    lines.push_back({0, 0, 1, "/// screened pair of basis functions."});
+    lines.push_back({0, 0, 1, "/// @param aux The block of auxiliary basis functions."});
+    lines.push_back({0, 0, 1, "/// @param pair The screened pair of basis functions."});
+
+    for (const auto& label : emit::range_separation_docs(run_config.operator_type))
+    {
+        lines.push_back({0, 0, 1, label});
+    }
+
+    lines.push_back({0, 0, 1, "/// @return The matrix of computed integrals, one (auxiliary function, pair)"});
+    lines.push_back({0, 0, 1, "///         combination per column."});
+
+    lines.push_back({0, 0, 1, "auto"});
+
+    for (const auto& label : _signature_lines(run_config, integral, true))
+    {
+        lines.push_back({0, 0, 1, label});
+    }
+
+    lines.push_back({0, 0, 2, "}  // namespace " + ns});
+
+    lines.push_back({0, 0, 1, "#endif /* " + guard + " */"});
+
+    std::ostringstream fstream;
+
+    ost::write_code_lines(fstream, lines);
+
+    sink.write({base + ".hpp", fstream.str()});
+}
+
+void
+CppCpuThreeCenterEmitter::_write_cpp(const cfg::RunConfiguration& run_config,
+                                     const I3CIntegral&           integral,
+                                     const SI3CIntegrals&         hrr_ints,
+                                     const SI3CIntegrals&         vrr_base_ints,
+                                     const SI3CIntegrals&         vrr_rest_ints,
+                                     ost::OutputSink&             sink) const
+{
+    const auto tags = operator_tags(run_config.operator_type);
+
+    const auto ns = emit::precision_namespace(tags.ns, run_config.precision);
+
+    const auto base = kernel_file_name(run_config, integral);
+
+    // primitive integrals are held in the primitive type, contracted integrals
+    // and the result in the accumulator type; the kernel headers are tagged to
+    // match.
+    const auto type = cfg::primitive_type(run_config.precision);
+
+    const auto acc_type = cfg::accumulator_type(run_config.precision);
+
+    const auto cart_tag = (type == "float") ? std::string("Fp32") : std::string();
+
+    const auto hrr_tag = (acc_type == "float") ? std::string("Fp32") : std::string();
+
+    const int la = integral[0];
+
+    const int lc = integral[1];
+
+    const int ld = integral[2];
+
+    const int lmax = la + lc + ld;
+
+    const int nspher = (2 * la + 1) * (2 * lc + 1) * (2 * ld + 1);
+
+    // order the VRR closure, the HRR base and the HRR steps by total angular
+    // momentum, lowest first: every recursion term sits strictly below the
+    // integral it builds.
+    const auto by_l = [](const I3CIntegral& a, const I3CIntegral& b) {
+        const auto la = a[0] + a[1] + a[2];
+
+        const auto lb = b[0] + b[1] + b[2];
+
+        if (la != lb) return la < lb;
+
+        return a < b;
+    };
+
+    std::vector<I3CIntegral> vrr_ordered(vrr_base_ints.begin(), vrr_base_ints.end());
+
+    vrr_ordered.insert(vrr_ordered.end(), vrr_rest_ints.begin(), vrr_rest_ints.end());
+
+    std::sort(vrr_ordered.begin(), vrr_ordered.end(), by_l);
+
+    std::vector<I3CIntegral> base_ordered(vrr_base_ints.begin(), vrr_base_ints.end());
+
+    std::sort(base_ordered.begin(), base_ordered.end(), by_l);
+
+    // the ket HRR steps are the HRR group above the c = 0 seed row, lowest c
+    // first (each step consumes the row below it).
+    std::vector<I3CIntegral> hrr_ordered;
+
+    for (const auto& tint : hrr_ints)
+    {
+        if (tint[1] > 0) hrr_ordered.push_back(tint);
+    }
+
+    std::sort(hrr_ordered.begin(), hrr_ordered.end(), [](const I3CIntegral& a, const I3CIntegral& b) {
+        if (a[1] != b[1]) return a[1] < b[1];
+
+        return a < b;
+    });
+
+    const auto eri_drv = V3IElectronRepulsionDriver();
+
+    // build the body and the set of os3c kernel headers it calls.
+    auto body = VCodeLines();
+
+    std::set<std::string> headers;
+
+    body.push_back({1, 0, 1, "// number of auxiliary functions and screened atom pairs"});
+    body.push_back({1, 0, 1, "const auto ncols = aux.number_of_functions() * pair.number_of_pairs();"});
+    body.push_back({0, 0, 1, ""});
+
+    body.push_back({1, 0, 1, "// spherical (2*la+1) x (2*lc+1) x (2*ld+1) result, one (auxiliary function,"});
+    body.push_back({1, 0, 1, "// pair) combination per column"});
+    body.push_back({1, 0, 1, "osfunc::CArray<" + acc_type + "> buffer(" + std::to_string(nspher) +
+                                 ", ncols);"});
+    body.push_back({0, 0, 1, ""});
+
+    body.push_back({1, 0, 1, "// number of primitive (auxiliary, pair) combinations per column"});
+    body.push_back({1, 0, 1, "const auto nprims = aux.number_of_primitives() * pair.number_of_primitive_pairs();"});
+    body.push_back({0, 0, 1, ""});
+
+    emit::add_eri_seeds(body, run_config.operator_type, type, "aux, pair", "sss", lmax, "|PQ|");
+
+    if (lmax == 0)
+    {
+        // (s|ss): the contracted zeroth-order seeds are the spherical result.
+        body.push_back({1, 0, 1, "// (s|ss): the contracted zeroth-order seeds are the result"});
+        body.push_back({1, 0, 1, "osfunc::contract(buffer, sss_0);"});
+    }
+    else
+    {
+        // the bra VRR steps with WA = W - A, the ket VRR with QD = Q - D and
+        // WQ = W - Q; only the distances some step consumes are computed.
+        const auto has_bra_vrr = std::any_of(vrr_ordered.begin(), vrr_ordered.end(), [](const I3CIntegral& tint) {
+            return tint[0] > 0;
+        });
+
+        const auto has_ket_vrr = std::any_of(vrr_ordered.begin(), vrr_ordered.end(), [](const I3CIntegral& tint) {
+            return (tint[0] == 0) && (tint[2] > 0);
+        });
+
+        body.push_back({1, 0, 1, "// W - A, Q - D and W - Q distances consumed by the vertical recurrence"});
+
+        if (has_bra_vrr)
+        {
+            body.push_back({1, 0, 1, "const auto wa = " + emit::osfunc_call("compute_wa", type) + "(aux, pair);"});
+        }
+
+        if (has_ket_vrr)
+        {
+            body.push_back({1, 0, 1, "const auto qd = " + emit::osfunc_call("compute_qd", type) + "(pair);"});
+            body.push_back({1, 0, 1, "const auto wq = " + emit::osfunc_call("compute_wq", type) + "(aux, pair);"});
+        }
+
+        body.push_back({0, 0, 1, ""});
+
+        // vertical recurrence: each step takes exactly the terms the
+        // V3IElectronRepulsionDriver expands it into, in the driver's order.
+        body.push_back({1, 0, 1, "// vertical recurrence: order-indexed primitive Cartesian integrals"});
+
+        for (const auto& tint : vrr_ordered)
+        {
+            if ((tint[0] + tint[2]) == 0) continue;  // the (s|ss)^m seeds are "sss_m"
+
+            const auto bra = (tint[0] > 0);
+
+            std::string args = "aux, pair, ";
+
+            for (const auto& rint : (bra ? eri_drv.bra_vrr(tint) : eri_drv.ket_vrr(tint)))
+            {
+                args += primitive_name(rint) + ", ";
+            }
+
+            args += bra ? "wa, " : "qd, wq, ";
+
+            const auto name = primitive_name(tint);
+
+            body.push_back({1, 0, 1, "osfunc::CArray<" + type + "> " + name + "(nprims * " +
+                                         std::to_string(cartesian_rows(tint)) + ", ncols);"});
+            body.push_back({1, 0, 1, "os3c::vrr::eri::compute_" + shell_label(tint[0]) + "_" +
+                                         shell_label(tint[2]) + "(" + args + name + ");"});
+
+            headers.insert("ObaraSaikaThreeCenterElectronRepulsionVrr" + Tensor(tint[0]).label() +
+                           Tensor(tint[2]).label() + cart_tag + ".hpp");
+        }
+
+        body.push_back({0, 0, 1, ""});
+
+        // contract the zeroth-order VRR integrals the ket HRR consumes.
+        body.push_back({1, 0, 1, "// contract the base integrals consumed by the horizontal recurrence"});
+
+        for (const auto& tint : base_ordered)
+        {
+            body.push_back({1, 0, 1, "osfunc::CArray<" + acc_type + "> " + contracted_name(tint) + "(" +
+                                         std::to_string(cartesian_rows(tint)) + ", ncols);"});
+            body.push_back({1, 0, 1, "osfunc::contract(" + contracted_name(tint) + ", " +
+                                         primitive_name(tint) + ");"});
+        }
+
+        body.push_back({0, 0, 1, ""});
+
+        // ket horizontal recurrence: (A|c,d) from (A|c-1,d+1) and (A|c-1,d) with
+        // CD distances; the x kernels are generic in the auxiliary momentum.
+        if (!hrr_ordered.empty())
+        {
+            body.push_back({1, 0, 1, "// ket horizontal recurrence on contracted Cartesian integrals"});
+            body.push_back({1, 0, 1, "const auto cd = " + emit::osfunc_call("compute_cd", acc_type) + "(pair);"});
+
+            for (const auto& tint : hrr_ordered)
+            {
+                std::string args = std::to_string(cartesian_count(tint[0])) + ", ";
+
+                for (const auto& rint : eri_drv.ket_hrr(tint))
+                {
+                    args += contracted_name(rint) + ", ";
+                }
+
+                const auto name = contracted_name(tint);
+
+                body.push_back({1, 0, 1, "osfunc::CArray<" + acc_type + "> " + name + "(" +
+                                             std::to_string(cartesian_rows(tint)) + ", ncols);"});
+                body.push_back({1, 0, 1, "os3c::hrr::compute_x_" + shell_label(tint[1]) + "_" +
+                                             shell_label(tint[2]) + "(" + args + "cd, " + name + ");"});
+
+                headers.insert("ObaraSaikaThreeCenterHrrX" + Tensor(tint[1]).label() +
+                               Tensor(tint[2]).label() + hrr_tag + ".hpp");
+            }
+
+            body.push_back({0, 0, 1, ""});
+        }
+
+        body.push_back({1, 0, 1, "// transform to spherical form"});
+        body.push_back({1, 0, 1, "osfunc::transform<" + std::to_string(la) + ", " + std::to_string(lc) + ", " +
+                                     std::to_string(ld) + ">(buffer, " + contracted_name(integral) + ");"});
+
+        headers.insert("CartesianToSphericalFunc.hpp");
+    }
+
+    body.push_back({0, 0, 1, ""});
+    body.push_back({1, 0, 1, "return buffer;"});
+
+    // assemble the file: includes, namespace, signature, body.
+    auto lines = VCodeLines();
+
+    lines.push_back({0, 0, 2, "#include \"" + base + ".hpp\""});
+
+    lines.push_back({0, 0, 1, "#include \"ObaraSaikaFunc.hpp\""});
+
+    for (const auto& header : headers) lines.push_back({0, 0, 1, "#include \"" + header + "\""});
+
+    lines.push_back({0, 0, 1, ""});
+
+    lines.push_back({0, 0, 2, "namespace " + ns + " {  // " + tags.caption +
+                                  " three-center integrals"});
+
+    lines.push_back({0, 0, 1, "auto"});
+
+    for (const auto& label : _signature_lines(run_config, integral, false))
+    {
+        lines.push_back({0, 0, 1, label});
+    }
+
+    lines.push_back({0, 0, 1, "{"});
+
+    for (const auto& line : body) lines.push_back(line);
+
+    lines.push_back({0, 0, 2, "}"});
+
+    lines.push_back({0, 0, 1, "}  // namespace " + ns});
+
+    std::ostringstream fstream;
+
+    ost::write_code_lines(fstream, lines);
+
+    sink.write({base + ".cpp", fstream.str()});
+}
+
+void
+CppCpuThreeCenterEmitter::emit(const cfg::RunConfiguration& run_config,
+                               const I3CIntegral&           integral,
+                               const SI3CIntegrals&         hrr_ints,
+                               const SI3CIntegrals&         vrr_base_ints,
+                               const SI3CIntegrals&         vrr_rest_ints,
+                               ost::OutputSink&             sink) const
+{
+    _write_hpp(run_config, integral, sink);
+
+    _write_cpp(run_config, integral, hrr_ints, vrr_base_ints, vrr_rest_ints, sink);
+}
+
+}  // namespace
+
+std::unique_ptr<ThreeCenterEmitter>
+make_three_center_emitter(const cfg::RunConfiguration& run_config)
+{
+    switch (run_config.hardware)
+    {
+        case cfg::Hardware::cpu:
+        {
+            switch (run_config.language)
+            {
+                case cfg::Language::cpp:
+                    return std::make_unique<CppCpuThreeCenterEmitter>();
+            }
+
+            break;
+        }
+    }
+
+    throw cfg::ConfigError("three-center generator: no emitter for hardware '" +
+                           cfg::to_string(run_config.hardware) + "' and language '" +
+                           cfg::to_string(run_config.language) + "'");
+}
@@ -0,0 +1,53 @@
+// LITMUS: An Automated Molecular Integrals Generator
+// Copyright 2022 Z. Rinkevicius, KTH, Sweden.
+// E-mail: rinkevic@kth.se
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef three_center_emitters_hpp
+#define three_center_emitters_hpp
+
+#include <memory>
+
+#include "output_sink.hpp"
+#include "run_configuration.hpp"
+#include "t3c_defs.hpp"
+
+class ThreeCenterEmitter
+{
+public:
+    virtual ~ThreeCenterEmitter() = default;
+
+    /// Emits the source files that compute the target three-center integral.
+    /// @param run_config The validated run configuration (selects the signature
+    ///        and storage form the emitted kernel branches on).
+    /// @param integral The target three-center integral (A|o|cd).
+    /// @param hrr_ints The ket HRR integrals, from the (A|o|0d') seeds up to the
+    ///        target.
+    /// @param vrr_base_ints The VRR base integrals (seeds) HRR consumes.
+    /// @param vrr_rest_ints The remaining VRR integrals generated to evaluate the
+    ///        base (the full VRR group minus the base).
+    /// @param sink The output sink receiving the emitted files.
+    virtual void emit(const cfg::RunConfiguration& run_config,
+                      const I3CIntegral&           integral,
+                      const SI3CIntegrals&         hrr_ints,
+                      const SI3CIntegrals&         vrr_base_ints,
+                      const SI3CIntegrals&         vrr_rest_ints,
+                      ost::OutputSink&             sink) const = 0;
+};
+
+std::unique_ptr<ThreeCenterEmitter>
+make_three_center_emitter(const cfg::RunConfiguration& run_config);
+
+#endif /* three_center_emitters_hpp */
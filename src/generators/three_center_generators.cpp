@@ -0,0 +1,202 @@
+// LITMUS: An Automated Molecular Integrals Generator
+// Copyright 2022 Z. Rinkevicius, KTH, Sweden.
+// E-mail: rinkevic@kth.se
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "three_center_generators.hpp"
+
+#include <iostream>
+
+#include <string>
+
+#include "config.hpp"
+#include "operator.hpp"
+#include "tensor.hpp"
+
+#include "three_center_emitters.hpp"
+
+#include "v3i_eri_driver.hpp"
+
+I3CIntegral
+ThreeCenterGenerator::_get_integral(const cfg::RunConfiguration& run_config,
+                                    const std::array<int, 3>&    ang_moms) const
+{
+    // auxiliary (A) bra and (C, D) ket pair expansion centers
+
+    const auto bra = I1CPair("GA", ang_moms[0]);
+
+    const auto ket = I2CPair("GC", ang_moms[1], "GD", ang_moms[2]);
+
+    // select the integrand operator from the configured operator type
+
+    switch (run_config.operator_type)
+    {
+        case cfg::OperatorType::electron_repulsion:
+            return I3CIntegral(bra, ket, Operator("1/|r-r'|"), 0, {});
+
+        case cfg::OperatorType::long_range_electron_repulsion:
+            return I3CIntegral(bra, ket, Operator("erf(w|r-r'|)/|r-r'|"), 0, {});
+
+        case cfg::OperatorType::short_range_electron_repulsion:
+            return I3CIntegral(bra, ket, Operator("erfc(w|r-r'|)/|r-r'|"), 0, {});
+
+        // remaining operators are not handled by this routine yet
+        case cfg::OperatorType::overlap:
+        case cfg::OperatorType::kinetic_energy:
+        case cfg::OperatorType::nuclear_potential:
+        case cfg::OperatorType::dipole_momentum:
+        case cfg::OperatorType::linear_momentum:
+        case cfg::OperatorType::three_center_overlap:
+        case cfg::OperatorType::three_center_r2:
+        case cfg::OperatorType::three_center_r_dot_r2:
+        case cfg::OperatorType::local_ecp:
+        case cfg::OperatorType::projected_ecp:
+            break;
+    }
+
+    throw cfg::ConfigError("three-center generator: operator '" +
+                           cfg::to_string(run_config.operator_type) +
+                           "' is not supported for three-center integrals");
+}
+
+SI3CIntegrals
+ThreeCenterGenerator::_generate_hrr_integral_group(const cfg::RunConfiguration& run_config,
+                                                   const I3CIntegral&           integral) const
+{
+    // the ket HRR transfers momentum from D to C: (A|c,d) from (A|c-1,d+1) and
+    // (A|c-1,d). The driver closes on the c = 0 row.
+
+    switch (run_config.operator_type)
+    {
+        case cfg::OperatorType::electron_repulsion:
+        case cfg::OperatorType::long_range_electron_repulsion:
+        case cfg::OperatorType::short_range_electron_repulsion:
+        {
+            return V3IElectronRepulsionDriver().create_ket_hrr_recursion({integral,});
+        }
+
+        // remaining operators are not handled by this routine yet
+        case cfg::OperatorType::overlap:
+        case cfg::OperatorType::kinetic_energy:
+        case cfg::OperatorType::nuclear_potential:
+        case cfg::OperatorType::dipole_momentum:
+        case cfg::OperatorType::linear_momentum:
+        case cfg::OperatorType::three_center_overlap:
+        case cfg::OperatorType::three_center_r2:
+        case cfg::OperatorType::three_center_r_dot_r2:
+        case cfg::OperatorType::local_ecp:
+        case cfg::OperatorType::projected_ecp:
+            break;
+    }
+
+    throw cfg::ConfigError("three-center generator: operator '" +
+                           cfg::to_string(run_config.operator_type) +
+                           "' is not supported for three-center integrals");
+}
+
+SI3CIntegrals
+ThreeCenterGenerator::_generate_vrr_base_integral_group(const SI3CIntegrals& hrr_ints) const
+{
+    SI3CIntegrals tints;
+
+    for (const auto& tint : hrr_ints)
+    {
+        if (tint[1] == 0) tints.insert(tint);
+    }
+
+    return tints;
+}
+
+SI3CIntegrals
+ThreeCenterGenerator::_generate_vrr_integral_group(const cfg::RunConfiguration& run_config,
+                                                   const SI3CIntegrals&         base) const
+{
+    switch (run_config.operator_type)
+    {
+        case cfg::OperatorType::electron_repulsion:
+        case cfg::OperatorType::long_range_electron_repulsion:
+        case cfg::OperatorType::short_range_electron_repulsion:
+        {
+            return V3IElectronRepulsionDriver().create_vrr_recursion(base);
+        }
+
+        // remaining operators are not handled by this routine yet
+        case cfg::OperatorType::overlap:
+        case cfg::OperatorType::kinetic_energy:
+        case cfg::OperatorType::nuclear_potential:
+        case cfg::OperatorType::dipole_momentum:
+        case cfg::OperatorType::linear_momentum:
+        case cfg::OperatorType::three_center_overlap:
+        case cfg::OperatorType::three_center_r2:
+        case cfg::OperatorType::three_center_r_dot_r2:
+        case cfg::OperatorType::local_ecp:
+        case cfg::OperatorType::projected_ecp:
+            break;
+    }
+
+    throw cfg::ConfigError("three-center generator: operator '" +
+                           cfg::to_string(run_config.operator_type) +
+                           "' is not supported for three-center integrals");
+}
+
+void
+ThreeCenterGenerator::generate(const cfg::RunConfiguration& run_config) const
+{
+    ost::DirectorySink sink;
+
+    generate(run_config, sink);
+}
+
+void
+ThreeCenterGenerator::generate(const cfg::RunConfiguration& run_config,
+                               ost::OutputSink&             sink) const
+{
+    // loop over the auxiliary (A) and ket pair (C, D) angular momenta, with
+    // D >= C as the ket pair is symmetric; for each target split the work into
+    // the ket HRR integrals, the VRR base integrals consumed by HRR, and the
+    // remaining VRR integrals produced to evaluate that base.
+
+    const auto emitter = make_three_center_emitter(run_config);
+
+    for (int i = run_config.min_ang_mom; i <= run_config.max_ang_mom; i++)
+    {
+        for (int j = run_config.min_ang_mom; j <= run_config.max_ang_mom; j++)
+        {
+            for (int k = j; k <= run_config.max_ang_mom; k++)
+            {
+                const auto integral = _get_integral(run_config, {i, j, k});
+
+                const auto hrr_ints = _generate_hrr_integral_group(run_config, integral);
+
+                const auto vrr_base_ints = _generate_vrr_base_integral_group(hrr_ints);
+
+                const auto vrr_ints = _generate_vrr_integral_group(run_config, vrr_base_ints);
+
+                SI3CIntegrals vrr_rest_ints;
+
+                for (const auto& tint : vrr_ints)
+                {
+                    if (vrr_base_ints.count(tint) == 0) vrr_rest_ints.insert(tint);
+                }
+
+                emitter->emit(run_config, integral, hrr_ints, vrr_base_ints, vrr_rest_ints, sink);
+
+                std::cout << "Generated " << integral.label() << " kernel ("
+                          << hrr_ints.size() << " HRR, " << vrr_base_ints.size() << " VRR base, "
+                          << vrr_rest_ints.size() << " VRR rest)" << std::endl;
+            }
+        }
+    }
+}
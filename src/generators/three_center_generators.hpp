@@ -0,0 +1,81 @@
+// LITMUS: An Automated Molecular Integrals Generator
+// Copyright 2022 Z. Rinkevicius, KTH, Sweden.
+// E-mail: rinkevic@kth.se
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef three_center_generators_hpp
+#define three_center_generators_hpp
+
+#include <array>
+
+#include "output_sink.hpp"
+#include "run_configuration.hpp"
+#include "t3c_defs.hpp"
+
+class ThreeCenterGenerator
+{
+    /// Builds the base three-center integral (A|o|cd) for the configured operator
+    /// and the given angular momenta.
+    /// @param run_config The run configuration (selects the integrand operator).
+    /// @param ang_moms The angular momenta of the auxiliary (A) and the ket pair
+    ///        (C, D) centers.
+    /// @return The three-center integral.
+    I3CIntegral _get_integral(const cfg::RunConfiguration& run_config,
+                              const std::array<int, 3>&    ang_moms) const;
+
+    /// Builds the ket HRR integrals for a target (A|o|cd): the target itself and
+    /// every (A|o|c'd') the horizontal recurrence transfers momentum through,
+    /// down to the (A|o|0d') seeds (which belong to the VRR base group).
+    /// @param run_config The run configuration (selects the recursion driver).
+    /// @param integral The target three-center integral (A|o|cd).
+    /// @return The set of HRR transfer integrals.
+    SI3CIntegrals _generate_hrr_integral_group(const cfg::RunConfiguration& run_config,
+                                               const I3CIntegral&           integral) const;
+
+    /// Selects the VRR base integrals consumed by the ket HRR: the (A|o|0d')
+    /// members of the HRR group, (A|o|0d)...(A|o|0,c+d).
+    /// @param hrr_ints The HRR integral group of a target.
+    /// @return The set of VRR base integrals needed by HRR.
+    SI3CIntegrals _generate_vrr_base_integral_group(const SI3CIntegrals& hrr_ints) const;
+
+    /// Runs the vertical recursion down from the given VRR base integrals: the
+    /// bra VRR reduces the auxiliary center to (0|o|0d)^m, the ket VRR reduces
+    /// those to the (0|o|00)^m seeds.
+    /// @param run_config The run configuration (selects the recursion driver).
+    /// @param base The VRR base integrals (output from HRR) to recurse down from.
+    /// @return The complete set of VRR integrals.
+    SI3CIntegrals _generate_vrr_integral_group(const cfg::RunConfiguration& run_config,
+                                               const SI3CIntegrals&         base) const;
+
+public:
+    /// Creates a three-center integrals code generator.
+    ThreeCenterGenerator() = default;
+
+    /// Generates the selected three-center integrals over the configured
+    /// angular-momentum range [min_ang_mom, max_ang_mom] on the A, C and D
+    /// centers (D >= C, the ket pair is symmetric) into the current working
+    /// directory.
+    /// @param run_config The validated run configuration.
+    void generate(const cfg::RunConfiguration& run_config) const;
+
+    /// Generates the selected three-center integrals over the configured
+    /// angular-momentum range into an output sink.
+    /// @param run_config The validated run configuration.
+    /// @param sink The output sink receiving the emitted files.
+    void generate(const cfg::RunConfiguration& run_config,
+                  ost::OutputSink&             sink) const;
+};
+
+#endif /* three_center_generators_hpp */
@@ -17,11 +17,13 @@
 #include "two_center_emitters.hpp"
 
 #include <algorithm>
-#include <fstream>
+#include <cctype>
+#include <sstream>
 #include <string>
 #include <vector>
 
 #include "config.hpp"
+#include "emitter_utils.hpp"
 #include "file_stream.hpp"
 #include "operator.hpp"
 #include "string_formater.hpp"
@@ -63,6 +65,12 @@ operator_tags(cfg::OperatorType op)
         case cfg::OperatorType::electron_repulsion:
             return {"os2c::eri", "ElectronRepulsion", "electron repulsion"};
 
+        case cfg::OperatorType::long_range_electron_repulsion:
+            return {"os2c::erf", "LongRangeElectronRepulsion", "long-range electron repulsion"};
+
+        case cfg::OperatorType::short_range_electron_repulsion:
+            return {"os2c::erfc", "ShortRangeElectronRepulsion", "short-range electron repulsion"};
+
         // remaining operators have no two-center kernel yet
         case cfg::OperatorType::nuclear_potential:
         case cfg::OperatorType::dipole_momentum:
@@ -111,28 +119,29 @@ kernel_func_name(const I2CIntegral& integral)
 
 /// The base file name (no extension) for a target integral's kernel, e.g.
 /// "ObaraSaikaTwoCenterOverlapPP"; the .hpp/.cpp pair share it.
-/// @param op The integrand operator type.
+/// @param run_config The run configuration (selects operator and precision).
 /// @param integral The target two-center integral.
 /// @return The base file name.
 std::string
-kernel_file_name(cfg::OperatorType op, const I2CIntegral& integral)
+kernel_file_name(const cfg::RunConfiguration& run_config, const I2CIntegral& integral)
 {
-    return "ObaraSaikaTwoCenter" + operator_tags(op).file_label + Tensor(integral[0]).label() +
-           Tensor(integral[1]).label();
+    return "ObaraSaikaTwoCenter" + operator_tags(run_config.operator_type).file_label + Tensor(integral[0]).label() +
+           Tensor(integral[1]).label() + emit::precision_file_tag(run_config.precision);
 }
 
 /// The return type of a kernel for a storage form. The storage form selects the
 /// container the integral block is returned in. The switch carries no default,
 /// so a new StorageForm trips -Wswitch here.
 /// @param form The storage form.
+/// @param precision The precision (selects the contracted value type).
 /// @return The return type name.
 std::string
-return_type(cfg::StorageForm form)
+return_type(cfg::StorageForm form, cfg::Precision precision)
 {
     switch (form)
     {
         case cfg::StorageForm::veloxchem_sparse:
-            return "osfunc::CArray<double>";
+            return "osfunc::CArray<" + cfg::accumulator_type(precision) + ">";
     }
 
     return std::string();  // unreachable: every StorageForm is handled above
@@ -206,14 +215,50 @@ class CppCpuTwoCenterEmitter : public TwoCenterEmitter
 {
     /// Writes the kernel declaration header (.hpp).
     void _write_hpp(const cfg::RunConfiguration& run_config,
-                    const I2CIntegral&           integral) const;
+                    const I2CIntegral&           integral,
+                    ost::OutputSink&             sink) const;
 
     /// Writes the kernel definition (.cpp) carrying the computation workflow.
     void _write_cpp(const cfg::RunConfiguration& run_config,
                     const I2CIntegral&           integral,
                     const SI2CIntegrals&         hrr_ints,
                     const SI2CIntegrals&         vrr_base_ints,
-                    const SI2CIntegrals&         vrr_rest_ints) const;
+                    const SI2CIntegrals&         vrr_rest_ints,
+                    ost::OutputSink&             sink) const;
+
+    /// Adds the Boys-seeded electron repulsion workflow to a kernel body: Boys
+    /// argument and function values, the order-indexed (s|o|s)^m seeds, one
+    /// Cartesian VRR step per (0|o|k)^m (or (k|o|0)^m) integral of the
+    /// V2IElectronRepulsionDriver closure, contraction, and the HRR transfer or
+    /// Cartesian-to-spherical store.
+    /// @param body The kernel body lines to append to.
+    /// @param headers The kernel headers the body calls (extended in place).
+    /// @param run_config The run configuration (selects the value types).
+    /// @param integral The target integral.
+    /// @param vrr_ordered The VRR closure, lowest total momentum first.
+    /// @param base_ordered The VRR base integrals, lowest total momentum first.
+    void _add_eri_workflow(VCodeLines&                     body,
+                           std::set<std::string>&          headers,
+                           const cfg::RunConfiguration&    run_config,
+                           const I2CIntegral&              integral,
+                           const std::vector<I2CIntegral>& vrr_ordered,
+                           const std::vector<I2CIntegral>& base_ordered) const;
+
+    /// Adds the contraction of the VRR base integrals and the HRR transfer (with
+    /// the Cartesian-to-spherical transform fused) into the result buffer.
+    /// @param body The kernel body lines to append to.
+    /// @param headers The kernel headers the body calls (extended in place).
+    /// @param integral The target integral (both sides carry momentum).
+    /// @param base_ordered The VRR base integrals, lowest total momentum first.
+    /// @param suffix The suffix of the primitive base names (e.g. "_0" for the
+    ///        zeroth order of an order-indexed recurrence).
+    /// @param acc_type The contracted value type.
+    void _add_hrr_transfer(VCodeLines&                     body,
+                           std::set<std::string>&          headers,
+                           const I2CIntegral&              integral,
+                           const std::vector<I2CIntegral>& base_ordered,
+                           const std::string&              suffix,
+                           const std::string&              acc_type) const;
 
     /// The kernel signature, as code lines: "compute_<la>_<lb>(<inputs>) ->
     /// <return>", broken across lines and aligned under the function name when
@@ -231,7 +276,8 @@ public:
               const I2CIntegral&           integral,
               const SI2CIntegrals&         hrr_ints,
               const SI2CIntegrals&         vrr_base_ints,
-              const SI2CIntegrals&         vrr_rest_ints) const override;
+              const SI2CIntegrals&         vrr_rest_ints,
+              ost::OutputSink&             sink) const override;
 };
 
 std::vector<std::string>
@@ -245,9 +291,14 @@ CppCpuTwoCenterEmitter::_signature_lines(const cfg::RunConfiguration& run_config
 
     const auto spacer = std::string(name.size(), ' ');
 
-    const auto params = input_params(run_config.signature);
+    auto params = input_params(run_config.signature);
+
+    if (cfg::is_range_separated(run_config.operator_type))
+    {
+        params.insert(params.end(), {"const double omega", "const double alpha", "const double beta"});
+    }
 
-    const auto tail = ") -> " + return_type(run_config.storage_form) + (terminus ? ";" : "");
+    const auto tail = ") -> " + return_type(run_config.storage_form, run_config.precision) + (terminus ? ";" : "");
 
     for (std::size_t i = 0; i < params.size(); i++)
     {
@@ -263,17 +314,16 @@ CppCpuTwoCenterEmitter::_signature_lines(const cfg::RunConfiguration& run_config
 
 void
 CppCpuTwoCenterEmitter::_write_hpp(const cfg::RunConfiguration& run_config,
-                                   const I2CIntegral&           integral) const
+                                   const I2CIntegral&           integral,
+                                   ost::OutputSink&             sink) const
 {
     const auto tags = operator_tags(run_config.operator_type);
 
-    const auto base = kernel_file_name(run_config.operator_type, integral);
-
-    const auto guard = base + "_hpp";
+    const auto ns = emit::precision_namespace(tags.ns, run_config.precision);
 
-    std::ofstream fstream;
+    const auto base = kernel_file_name(run_config, integral);
 
-    fstream.open((base + ".hpp").c_str(), std::ios_base::trunc);
+    const auto guard = base + "_hpp";
 
     auto lines = VCodeLines();
 
@@ -286,12 +336,18 @@ CppCpuTwoCenterEmitter::_write_hpp(const cfg::RunConfiguration& run_config,
     }
     lines.push_back({0, 0, 1, ""});
 
-    lines.push_back({0, 0, 2, "namespace " + tags.ns + " {  // " + tags.caption +
+    lines.push_back({0, 0, 2, "namespace " + ns + " {  // " + tags.caption +
                                   " two-center integrals"});
 
     lines.push_back({0, 0, 1, "/// @brief Computes " + integral_caption(integral) +
                                   " integrals for a screened pair of basis functions."});
     lines.push_back({0, 0, 1, "/// @param pair The screened pair of basis functions."});
+
+    for (const auto& label : emit::range_separation_docs(run_config.operator_type))
+    {
+        lines.push_back({0, 0, 1, label});
+    }
+
     lines.push_back({0, 0, 1, "/// @return The matrix of computed integrals."});
 
     lines.push_back({0, 0, 1, "auto"});
@@ -301,13 +357,15 @@ CppCpuTwoCenterEmitter::_write_hpp(const cfg::RunConfiguration& run_config,
         lines.push_back({0, 0, 1, label});
     }
 
-    lines.push_back({0, 0, 2, "}  // namespace " + tags.ns});
+    lines.push_back({0, 0, 2, "}  // namespace " + ns});
 
     lines.push_back({0, 0, 1, "#endif /* " + guard + " */"});
 
+    std::ostringstream fstream;
+
     ost::write_code_lines(fstream, lines);
 
-    fstream.close();
+    sink.write({base + ".hpp", fstream.str()});
 }
 
 void
@@ -315,11 +373,27 @@ CppCpuTwoCenterEmitter::_write_cpp(const cfg::RunConfiguration& run_config,
                                    const I2CIntegral&           integral,
                                    const SI2CIntegrals&         hrr_ints,
                                    const SI2CIntegrals&         vrr_base_ints,
-                                   const SI2CIntegrals&         vrr_rest_ints) const
+                                   const SI2CIntegrals&         vrr_rest_ints,
+                                   ost::OutputSink&             sink) const
 {
     const auto tags = operator_tags(run_config.operator_type);
 
-    const auto base = kernel_file_name(run_config.operator_type, integral);
+    const auto ns = emit::precision_namespace(tags.ns, run_config.precision);
+
+    const auto base = kernel_file_name(run_config, integral);
+
+    // primitive integrals are held in the primitive type, contracted integrals
+    // and the result in the accumulator type.
+    const auto type = cfg::primitive_type(run_config.precision);
+
+    const auto acc_type = cfg::accumulator_type(run_config.precision);
+
+    // kernel headers: the Cartesian VRR is primitive, the HRR contracted (tagged
+    // in _add_hrr_transfer), and the spherical VRR spans both, so it is tagged by
+    // the precision itself.
+    const auto cart_tag = (type == "float") ? std::string("Fp32") : std::string();
+
+    const auto sph_tag = emit::precision_file_tag(run_config.precision);
 
     const int la = integral[0];
 
@@ -363,11 +437,16 @@ CppCpuTwoCenterEmitter::_write_cpp(const cfg::RunConfiguration& run_config,
     body.push_back({0, 0, 1, ""});
 
     body.push_back({1, 0, 1, "// spherical (2*la+1) x (2*lb+1) result, one atom pair per column"});
-    body.push_back({1, 0, 1, "osfunc::CArray<double> buffer(" + std::to_string(nspher) +
+    body.push_back({1, 0, 1, "osfunc::CArray<" + acc_type + "> buffer(" + std::to_string(nspher) +
                                  ", npairs);"});
     body.push_back({0, 0, 1, ""});
 
-    if (run_config.operator_type != cfg::OperatorType::overlap)
+    if ((run_config.operator_type == cfg::OperatorType::electron_repulsion) ||
+        cfg::is_range_separated(run_config.operator_type))
+    {
+        _add_eri_workflow(body, headers, run_config, integral, vrr_ordered, base_ordered);
+    }
+    else if (run_config.operator_type != cfg::OperatorType::overlap)
     {
         // only the overlap VRR/HRR kernels are generated so far; other operators
         // return the zeroed buffer until their kernels exist.
@@ -377,13 +456,13 @@ CppCpuTwoCenterEmitter::_write_cpp(const cfg::RunConfiguration& run_config,
     {
         // (s|s): the contracted primitive overlaps are the spherical result.
         body.push_back({1, 0, 1, "// (s|s): the contracted primitive overlaps are the result"});
-        body.push_back({1, 0, 1, "osfunc::contract(buffer, osfunc::compute_overlap(pair));"});
+        body.push_back({1, 0, 1, "osfunc::contract(buffer, " + emit::osfunc_call("compute_overlap", type) + "(pair));"});
     }
     else
     {
         body.push_back({1, 0, 1, "// primitive (s|s) seed and Pc (" + dist + ") distances"});
-        body.push_back({1, 0, 1, "const auto ss = osfunc::compute_overlap(pair);"});
-        body.push_back({1, 0, 1, "const auto " + dist + " = osfunc::compute_" + dist + "(pair);"});
+        body.push_back({1, 0, 1, "const auto ss = " + emit::osfunc_call("compute_overlap", type) + "(pair);"});
+        body.push_back({1, 0, 1, "const auto " + dist + " = " + emit::osfunc_call("compute_" + dist, type) + "(pair);"});
         body.push_back({0, 0, 1, ""});
 
         if (!has_hrr)
@@ -396,7 +475,7 @@ CppCpuTwoCenterEmitter::_write_cpp(const cfg::RunConfiguration& run_config,
             body.push_back({1, 0, 1, tags.ns + "::compute_" + shell_label(lval) + "_sph(pair, ss, " +
                                          dist + ", buffer);"});
 
-            headers.insert("ObaraSaikaTwoCenterOverlapVrrSph" + Tensor(lval).label() + ".hpp");
+            headers.insert("ObaraSaikaTwoCenterOverlapVrrSph" + Tensor(lval).label() + sph_tag + ".hpp");
         }
         else
         {
@@ -427,47 +506,17 @@ CppCpuTwoCenterEmitter::_write_cpp(const cfg::RunConfiguration& run_config,
                     args += (kb ? ("s" + shell_label(m)) : (shell_label(m) + "s")) + ", ";
                 }
 
-                body.push_back({1, 0, 1, "osfunc::CArray<double> " + name + "(nprims * " +
+                body.push_back({1, 0, 1, "osfunc::CArray<" + type + "> " + name + "(nprims * " +
                                              std::to_string(rows) + ", npairs);"});
                 body.push_back({1, 0, 1, "os2c::vrr::ovl::compute_" + shell_label(lval) + "(" + args +
                                              dist + ", " + name + ");"});
 
-                headers.insert("ObaraSaikaTwoCenterOverlapVrrCart" + Tensor(lval).label() + ".hpp");
+                headers.insert("ObaraSaikaTwoCenterOverlapVrrCart" + Tensor(lval).label() + cart_tag + ".hpp");
             }
 
             body.push_back({0, 0, 1, ""});
 
-            // contract the base integrals the HRR consumes.
-            body.push_back({1, 0, 1, "// contract the base integrals consumed by the horizontal recurrence"});
-
-            for (const auto& tint : base_ordered)
-            {
-                const auto name = shell_label(tint[0]) + shell_label(tint[1]);
-
-                const auto rows = cartesian_count(tint[0]) * cartesian_count(tint[1]);
-
-                body.push_back({1, 0, 1, "osfunc::CArray<double> c" + name + "(" +
-                                             std::to_string(rows) + ", npairs);"});
-                body.push_back({1, 0, 1, "osfunc::contract(c" + name + ", " + name + ");"});
-            }
-
-            body.push_back({0, 0, 1, ""});
-
-            // horizontal recurrence with the transform fused; it transfers momentum
-            // between the centers using the AB distances.
-            std::string args = "";
-
-            for (const auto& tint : base_ordered)
-            {
-                args += "c" + shell_label(tint[0]) + shell_label(tint[1]) + ", ";
-            }
-
-            body.push_back({1, 0, 1, "// horizontal recurrence (Cartesian-to-spherical transform fused)"});
-            body.push_back({1, 0, 1, "const auto ab = osfunc::compute_ab(pair);"});
-            body.push_back({1, 0, 1, "os2c::hrr::compute_" + shell_label(la) + "_" + shell_label(lb) +
-                                         "(" + args + "ab, buffer);"});
-
-            headers.insert("ObaraSaikaTwoCenterHrr" + Tensor(la).label() + Tensor(lb).label() + ".hpp");
+            _add_hrr_transfer(body, headers, integral, base_ordered, "", acc_type);
         }
     }
 
@@ -475,10 +524,6 @@ CppCpuTwoCenterEmitter::_write_cpp(const cfg::RunConfiguration& run_config,
     body.push_back({1, 0, 1, "return buffer;"});
 
     // assemble the file: includes, namespace, signature, body.
-    std::ofstream fstream;
-
-    fstream.open((base + ".cpp").c_str(), std::ios_base::trunc);
-
     auto lines = VCodeLines();
 
     lines.push_back({0, 0, 2, "#include \"" + base + ".hpp\""});
@@ -489,7 +534,7 @@ CppCpuTwoCenterEmitter::_write_cpp(const cfg::RunConfiguration& run_config,
 
     lines.push_back({0, 0, 1, ""});
 
-    lines.push_back({0, 0, 2, "namespace " + tags.ns + " {  // " + tags.caption +
+    lines.push_back({0, 0, 2, "namespace " + ns + " {  // " + tags.caption +
                                   " two-center integrals"});
 
     lines.push_back({0, 0, 1, "auto"});
@@ -505,11 +550,164 @@ CppCpuTwoCenterEmitter::_write_cpp(const cfg::RunConfiguration& run_config,
 
     lines.push_back({0, 0, 2, "}"});
 
-    lines.push_back({0, 0, 1, "}  // namespace " + tags.ns});
+    lines.push_back({0, 0, 1, "}  // namespace " + ns});
+
+    std::ostringstream fstream;
 
     ost::write_code_lines(fstream, lines);
 
-    fstream.close();
+    sink.write({base + ".cpp", fstream.str()});
+}
+
+void
+CppCpuTwoCenterEmitter::_add_hrr_transfer(VCodeLines&                     body,
+                                          std::set<std::string>&          headers,
+                                          const I2CIntegral&              integral,
+                                          const std::vector<I2CIntegral>& base_ordered,
+                                          const std::string&              suffix,
+                                          const std::string&              acc_type) const
+{
+    const int la = integral[0];
+
+    const int lb = integral[1];
+
+    const auto hrr_tag = (acc_type == "float") ? std::string("Fp32") : std::string();
+
+    // contract the base integrals the HRR consumes.
+    body.push_back({1, 0, 1, "// contract the base integrals consumed by the horizontal recurrence"});
+
+    for (const auto& tint : base_ordered)
+    {
+        const auto name = shell_label(tint[0]) + shell_label(tint[1]);
+
+        const auto rows = cartesian_count(tint[0]) * cartesian_count(tint[1]);
+
+        body.push_back({1, 0, 1, "osfunc::CArray<" + acc_type + "> c" + name + "(" +
+                                     std::to_string(rows) + ", npairs);"});
+        body.push_back({1, 0, 1, "osfunc::contract(c" + name + ", " + name + suffix + ");"});
+    }
+
+    body.push_back({0, 0, 1, ""});
+
+    // horizontal recurrence with the transform fused; it transfers momentum
+    // between the centers using the AB distances.
+    std::string args = "";
+
+    for (const auto& tint : base_ordered)
+    {
+        args += "c" + shell_label(tint[0]) + shell_label(tint[1]) + ", ";
+    }
+
+    body.push_back({1, 0, 1, "// horizontal recurrence (Cartesian-to-spherical transform fused)"});
+    body.push_back({1, 0, 1, "const auto ab = " + emit::osfunc_call("compute_ab", acc_type) + "(pair);"});
+    body.push_back({1, 0, 1, "os2c::hrr::compute_" + shell_label(la) + "_" + shell_label(lb) +
+                                 "(" + args + "ab, buffer);"});
+
+    headers.insert("ObaraSaikaTwoCenterHrr" + Tensor(la).label() + Tensor(lb).label() + hrr_tag + ".hpp");
+}
+
+void
+CppCpuTwoCenterEmitter::_add_eri_workflow(VCodeLines&                     body,
+                                          std::set<std::string>&          headers,
+                                          const cfg::RunConfiguration&    run_config,
+                                          const I2CIntegral&              integral,
+                                          const std::vector<I2CIntegral>& vrr_ordered,
+                                          const std::vector<I2CIntegral>& base_ordered) const
+{
+    const auto type = cfg::primitive_type(run_config.precision);
+
+    const auto acc_type = cfg::accumulator_type(run_config.precision);
+
+    const auto cart_tag = (type == "float") ? std::string("Fp32") : std::string();
+
+    const int la = integral[0];
+
+    const int lb = integral[1];
+
+    const int lmax = la + lb;
+
+    // the ket VRR (la <= lb) steps with WB = W - B, the bra VRR with WA = W - A.
+    const auto dist = (la <= lb) ? std::string("wb") : std::string("wa");
+
+    // the order-indexed name of a primitive integral, e.g. (0|o|p)^1 -> "sp_1".
+    const auto name_of = [](const int bra, const int ket, const int order) {
+        return shell_label(bra) + shell_label(ket) + "_" + std::to_string(order);
+    };
+
+    body.push_back({1, 0, 1, "// number of primitive pairs"});
+    body.push_back({1, 0, 1, "const auto nprims = pair.number_of_primitive_pairs();"});
+    body.push_back({0, 0, 1, ""});
+
+    emit::add_eri_seeds(body, run_config.operator_type, type, "pair", "ss", lmax, "|AB|");
+
+    if (lmax == 0)
+    {
+        // (s|s): the contracted zeroth-order seeds are the spherical result.
+        body.push_back({1, 0, 1, "// (s|s): the contracted zeroth-order seeds are the result"});
+        body.push_back({1, 0, 1, "osfunc::contract(buffer, ss_0);"});
+
+        return;
+    }
+
+    const auto center = std::string(1, static_cast<char>(std::toupper(dist[1])));
+
+    body.push_back({1, 0, 1, "// W" + center + " = W - " + center + " distances"});
+    body.push_back({1, 0, 1, "const auto " + dist + " = " + emit::osfunc_call("compute_" + dist, type) + "(pair);"});
+    body.push_back({0, 0, 1, ""});
+
+    // vertical recurrence: (0|o|k)^m from (0|o|k-1)^(m+1), (0|o|k-2)^m and
+    // (0|o|k-2)^(m+1), exactly the terms V2IElectronRepulsionDriver expands.
+    body.push_back({1, 0, 1, "// vertical recurrence: order-indexed primitive Cartesian integrals"});
+
+    for (const auto& tint : vrr_ordered)
+    {
+        const auto lval = tint[0] + tint[1];
+
+        if (lval == 0) continue;  // the (s|s)^m seeds are "ss_m"
+
+        const auto kb = (tint[0] == 0);
+
+        const auto order = tint.order();
+
+        const auto lower = [&](const int l, const int m) {
+            return kb ? name_of(0, l, m) : name_of(l, 0, m);
+        };
+
+        std::string args = "pair, " + lower(lval - 1, order + 1) + ", ";
+
+        if (lval >= 2) args += lower(lval - 2, order) + ", " + lower(lval - 2, order + 1) + ", ";
+
+        const auto name = name_of(tint[0], tint[1], order);
+
+        body.push_back({1, 0, 1, "osfunc::CArray<" + type + "> " + name + "(nprims * " +
+                                     std::to_string(cartesian_count(lval)) + ", npairs);"});
+        body.push_back({1, 0, 1, "os2c::vrr::eri::compute_" + shell_label(lval) + "(" + args + dist + ", " +
+                                     name + ");"});
+
+        headers.insert("ObaraSaikaTwoCenterElectronRepulsionVrrCart" + Tensor(lval).label() + cart_tag + ".hpp");
+    }
+
+    body.push_back({0, 0, 1, ""});
+
+    if ((la > 0) && (lb > 0))
+    {
+        _add_hrr_transfer(body, headers, integral, base_ordered, "_0", acc_type);
+    }
+    else
+    {
+        // (s|lb) or (la|s): the single base integral is the target; contract and
+        // transform it to spherical form.
+        const auto name = shell_label(la) + shell_label(lb);
+
+        body.push_back({1, 0, 1, "// contract and transform to spherical form"});
+        body.push_back({1, 0, 1, "osfunc::CArray<" + acc_type + "> c" + name + "(" +
+                                     std::to_string(cartesian_count(la) * cartesian_count(lb)) + ", npairs);"});
+        body.push_back({1, 0, 1, "osfunc::contract(c" + name + ", " + name + "_0);"});
+        body.push_back({1, 0, 1, "osfunc::transform<" + std::to_string(la) + ", " + std::to_string(lb) +
+                                     ">(buffer, c" + name + ");"});
+
+        headers.insert("CartesianToSphericalFunc.hpp");
+    }
 }
 
 void
@@ -517,11 +715,12 @@ CppCpuTwoCenterEmitter::emit(const cfg::RunConfiguration& run_config,
                              const I2CIntegral&           integral,
                              const SI2CIntegrals&         hrr_ints,
                              const SI2CIntegrals&         vrr_base_ints,
-                             const SI2CIntegrals&         vrr_rest_ints) const
+                             const SI2CIntegrals&         vrr_rest_ints,
+                             ost::OutputSink&             sink) const
 {
-    _write_hpp(run_config, integral);
+    _write_hpp(run_config, integral, sink);
 
-    _write_cpp(run_config, integral, hrr_ints, vrr_base_ints, vrr_rest_ints);
+    _write_cpp(run_config, integral, hrr_ints, vrr_base_ints, vrr_rest_ints, sink);
 }
 
 }  // namespace
@@ -19,6 +19,7 @@
 
 #include <memory>
 
+#include "output_sink.hpp"
 #include "run_configuration.hpp"
 #include "t2c_defs.hpp"
 
@@ -44,11 +45,13 @@ public:
     /// @param vrr_base_ints The VRR base integrals (seeds) HRR consumes.
     /// @param vrr_rest_ints The remaining VRR integrals generated to evaluate the
     ///        base (the full VRR group minus the base).
+    /// @param sink The output sink receiving the emitted files.
     virtual void emit(const cfg::RunConfiguration& run_config,
                       const I2CIntegral&           integral,
                       const SI2CIntegrals&         hrr_ints,
                       const SI2CIntegrals&         vrr_base_ints,
-                      const SI2CIntegrals&         vrr_rest_ints) const = 0;
+                      const SI2CIntegrals&         vrr_rest_ints,
+                      ost::OutputSink&             sink) const = 0;
 };
 
 /// Selects the two-center emitter for a run configuration.
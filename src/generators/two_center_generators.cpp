@@ -53,6 +53,12 @@ TwoCenterGenerator::_get_integral(const cfg::RunConfiguration& run_config,
         case cfg::OperatorType::electron_repulsion:
             return I2CIntegral(bra, ket, Operator("1/|r-r'|"), 0, {});
 
+        case cfg::OperatorType::long_range_electron_repulsion:
+            return I2CIntegral(bra, ket, Operator("erf(w|r-r'|)/|r-r'|"), 0, {});
+
+        case cfg::OperatorType::short_range_electron_repulsion:
+            return I2CIntegral(bra, ket, Operator("erfc(w|r-r'|)/|r-r'|"), 0, {});
+
         // remaining operators are not handled by this routine yet
         case cfg::OperatorType::nuclear_potential:
         case cfg::OperatorType::dipole_momentum:
@@ -127,6 +133,8 @@ TwoCenterGenerator::_generate_vrr_integral_group(const cfg::RunConfiguration& ru
         }
 
         case cfg::OperatorType::electron_repulsion:
+        case cfg::OperatorType::long_range_electron_repulsion:
+        case cfg::OperatorType::short_range_electron_repulsion:
         {
             return V2IElectronRepulsionDriver().create_recursion(base);
         }
@@ -190,6 +198,15 @@ TwoCenterGenerator::_generate_hrr_integral_group(const cfg::RunConfiguration& ru
 
 void
 TwoCenterGenerator::generate(const cfg::RunConfiguration& run_config) const
+{
+    ost::DirectorySink sink;
+
+    generate(run_config, sink);
+}
+
+void
+TwoCenterGenerator::generate(const cfg::RunConfiguration& run_config,
+                             ost::OutputSink&             sink) const
 {
     // loop over the angular-momentum range on the bra (A) and ket (B) sides; for
     // each target integral split the work into three groups: the HRR transfer
@@ -221,7 +238,7 @@ TwoCenterGenerator::generate(const cfg::RunConfiguration& run_config) const
                 if (vrr_base_ints.count(tint) == 0) vrr_rest_ints.insert(tint);
             }
 
-            emitter->emit(run_config, integral, hrr_ints, vrr_base_ints, vrr_rest_ints);
+            emitter->emit(run_config, integral, hrr_ints, vrr_base_ints, vrr_rest_ints, sink);
 
             std::cout << "Generated " << integral.label() << " kernel ("
                       << hrr_ints.size() << " HRR, " << vrr_base_ints.size() << " VRR base, "
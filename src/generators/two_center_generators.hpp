@@ -19,6 +19,7 @@
 
 #include <array>
 
+#include "output_sink.hpp"
 #include "run_configuration.hpp"
 #include "t2c_defs.hpp"
 
@@ -72,9 +73,17 @@ public:
     TwoCenterGenerator() = default;
 
     /// Generates the selected two-center integrals over the configured
-    /// angular-momentum range [min_ang_mom, max_ang_mom] on the A and B centers.
+    /// angular-momentum range [min_ang_mom, max_ang_mom] on the A and B centers
+    /// into the current working directory.
     /// @param run_config The validated run configuration.
     void generate(const cfg::RunConfiguration& run_config) const;
+
+    /// Generates the selected two-center integrals over the configured
+    /// angular-momentum range into an output sink.
+    /// @param run_config The validated run configuration.
+    /// @param sink The output sink receiving the emitted files.
+    void generate(const cfg::RunConfiguration& run_config,
+                  ost::OutputSink&             sink) const;
 };
 
 #endif /* two_center_generators_hpp */
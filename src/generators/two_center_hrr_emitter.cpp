@@ -17,6 +17,8 @@
 #include "two_center_hrr_emitter.hpp"
 
 #include <algorithm>
+#include <cmath>
+#include <iomanip>
 #include <map>
 #include <numeric>
 #include <set>
@@ -191,6 +193,15 @@ terminating_decimal(const Fraction& value)
     return digits.substr(0, digits.size() - places) + "." + fraction;
 }
 
+/// The floating-point literal of a terminating rational in the kernel's value
+/// type, e.g. 3/8 -> "0.375" (double) or "0.375f" (float), so float kernels are
+/// not promoted to double arithmetic.
+std::string
+decimal_literal(const Fraction& value, const std::string& type)
+{
+    return terminating_decimal(value) + ((type == "float") ? "f" : "");
+}
+
 /// The hoisted-constant name of a non-terminating rational, e.g. 1/3 -> "q1_3".
 std::string
 rational_name(const Fraction& value)
@@ -214,6 +225,7 @@ struct Contribution
     int                      radicand;    // square-free radical of the transform coefficient
     std::string              row;         // base integral row pointer (e.g. "sg_4")
     std::vector<std::string> ab_factors;  // AB-distance pointers (e.g. {"ab_x", "ab_x"})
+    int                      index;       // row index over all base integrals, in hrr_bases order
 };
 
 /// The coefficient-and-row part of a contribution (no sign, no AB factors), e.g.
@@ -221,7 +233,7 @@ struct Contribution
 /// 0.5); non-terminating rationals and square roots use the hoisted constants
 /// (q1_3, f3) declared once outside the loops.
 std::string
-magnitude_body(const Contribution& c)
+magnitude_body(const Contribution& c, const std::string& type)
 {
     std::string body;
 
@@ -229,7 +241,7 @@ magnitude_body(const Contribution& c)
 
     if (!(mag == Fraction(1)))
     {
-        body += (is_terminating(mag) ? terminating_decimal(mag) : rational_name(mag)) + " * ";
+        body += (is_terminating(mag) ? decimal_literal(mag, type) : rational_name(mag)) + " * ";
     }
 
     if (c.radicand != 1) body += "f" + std::to_string(c.radicand) + " * ";
@@ -255,9 +267,9 @@ ab_product_body(const std::vector<std::string>& ab_factors)
 
 /// The full magnitude (no sign) of a contribution, AB factors appended.
 std::string
-contribution_body(const Contribution& c)
+contribution_body(const Contribution& c, const std::string& type)
 {
-    std::string body = magnitude_body(c);
+    std::string body = magnitude_body(c, type);
 
     for (const auto& ab : c.ab_factors) body += " * " + ab + "[i]";
 
@@ -308,53 +320,28 @@ hrr_bases(const int la, const int lb)
     return bases;
 }
 
-/// The kernel signature "void compute_<la>_<lb>(<inputs>)" (no body, no ';'), with
-/// the base-integral CArrays, the AB distances, and the target out-parameter.
-std::string
-signature_text(const int la, const int lb)
+/// The contributions of the base-integral rows to every spherical target
+/// component of a (la|lb) target (bra-major flat index), with the
+/// Cartesian->spherical transform folded into the horizontal recurrence.
+std::vector<std::vector<Contribution>>
+spherical_rows(const int la, const int lb)
 {
-    const auto name = "compute_" + shell_label(la) + "_" + shell_label(lb);
+    const bool bra_incremented = (la <= lb);
 
-    const auto indent = std::string(name.size() + 6, ' ');  // align under "void name("
+    const int target_size = (2 * la + 1) * (2 * lb + 1);
 
-    std::ostringstream os;
+    // the row offset of every base integral within the concatenated bases.
 
-    os << "void " << name << "(";
+    std::map<std::pair<int, int>, int> base_offsets;
+
+    int nrows = 0;
 
     for (const auto& [bl, kl] : hrr_bases(la, lb))
     {
-        os << "const osfunc::CArray<double>& " << shell_label(bl) << shell_label(kl) << ",\n"
-           << indent;
-    }
+        base_offsets[{bl, kl}] = nrows;
 
-    os << "const osfunc::CArray<double>& ab,\n";
-    os << indent << "      osfunc::CArray<double>& " << shell_label(la) << shell_label(lb) << ")";
-
-    return os.str();
-}
-
-}  // namespace
-
-std::string
-format_hrr_signature(const int la, const int lb)
-{
-    return signature_text(la, lb);
-}
-
-std::string
-format_hrr_kernel(const int la, const int lb)
-{
-    const bool bra_incremented = (la <= lb);
-
-    // the target carries (2*la + 1) * (2*lb + 1) spherical components per block.
-
-    const int target_size = (2 * la + 1) * (2 * lb + 1);
-
-    // the base integrals the recurrence consumes, one CArray parameter each.
-
-    const auto bases = hrr_bases(la, lb);
-
-    const auto target = shell_label(la) + shell_label(lb);
+        nrows += cartesian_count(bl) * cartesian_count(kl);
+    }
 
     // the horizontal recurrence of every Cartesian target component, keyed by its
     // (bra, ket) Cartesian components.
@@ -365,7 +352,7 @@ format_hrr_kernel(const int la, const int lb)
 
     std::map<std::pair<TensorComponent, TensorComponent>, std::vector<R2CTerm>> hrr;
 
-    for (const auto& comp : integral.components<T1CPair, T1CPair>())
+    for (const auto& comp : integral.component_range<T1CPair, T1CPair>())
     {
         hrr.emplace(std::make_pair(comp[0], comp[1]),
                     fully_reduce(drv, R2CTerm(comp), bra_incremented));
@@ -402,9 +389,21 @@ format_hrr_kernel(const int la, const int lb)
                 const auto key = std::make_pair(row, ab_key);
 
                 if (const auto it = acc.find(key); it != acc.end())
+                {
                     it->second.coeff = it->second.coeff + coeff;
+                }
                 else
-                    acc.emplace(key, Contribution{coeff, term.factor.radicand, row, ab_factors});
+                {
+                    const auto& base = rterm.integral();
+
+                    const auto bl = base[0].order();
+
+                    const auto kl = base[1].order();
+
+                    const auto flat = component_index(bl, base[0]) * cartesian_count(kl) + component_index(kl, base[1]);
+
+                    acc.emplace(key, Contribution{coeff, term.factor.radicand, row, ab_factors, base_offsets.at({bl, kl}) + flat});
+                }
             }
         }
 
@@ -416,11 +415,72 @@ format_hrr_kernel(const int la, const int lb)
         }
     }
 
+    return rows;
+}
+
+/// The kernel signature "void compute_<la>_<lb>(<inputs>)" (no body, no ';'), with
+/// the base-integral CArrays, the AB distances, and the target out-parameter.
+std::string
+signature_text(const int la, const int lb, const std::string& type)
+{
+    const auto name = "compute_" + shell_label(la) + "_" + shell_label(lb);
+
+    const auto indent = std::string(name.size() + 6, ' ');  // align under "void name("
+
+    std::ostringstream os;
+
+    os << "void " << name << "(";
+
+    for (const auto& [bl, kl] : hrr_bases(la, lb))
+    {
+        os << "const osfunc::CArray<" << type << ">& " << shell_label(bl) << shell_label(kl) << ",\n"
+           << indent;
+    }
+
+    os << "const osfunc::CArray<" << type << ">& ab,\n";
+    os << indent << "      osfunc::CArray<" << type << ">& " << shell_label(la) << shell_label(lb) << ")";
+
+    return os.str();
+}
+
+}  // namespace
+
+std::string
+format_hrr_signature(const int la, const int lb, const cfg::Precision precision)
+{
+    return signature_text(la, lb, cfg::accumulator_type(precision));
+}
+
+std::string
+format_hrr_kernel(const int la, const int lb, const cfg::Precision precision)
+{
+    const bool bra_incremented = (la <= lb);
+
+    // the recurrence transfers contracted integrals, so it runs in the accumulator type.
+
+    const auto type = cfg::accumulator_type(precision);
+
+    const auto fsuffix = (type == "float") ? std::string("f") : std::string();
+
+    // the target carries (2*la + 1) * (2*lb + 1) spherical components per block.
+
+    const int target_size = (2 * la + 1) * (2 * lb + 1);
+
+    // the base integrals the recurrence consumes, one CArray parameter each.
+
+    const auto bases = hrr_bases(la, lb);
+
+    const auto target = shell_label(la) + shell_label(lb);
+
+    // the contributions of the base rows to every spherical target component.
+
+    const auto rows = spherical_rows(la, lb);
+
     // emit the kernel.
 
     std::ostringstream os;
 
-    os << signature_text(la, lb) << "\n";
+    os << signature_text(la, lb, type) << "\n";
     os << "{\n";
 
     os << "    // number of spherical components in the target integral\n";
@@ -460,13 +520,13 @@ format_hrr_kernel(const int la, const int lb)
 
         for (const auto r : radicals)
         {
-            os << "    const double f" << r << " = std::sqrt(" << r << ".0);\n";
+            os << "    const " << type << " f" << r << " = std::sqrt(" << r << ".0" << fsuffix << ");\n";
         }
 
         for (const auto& [key, value] : rationals)
         {
-            os << "    const double " << rational_name(value) << " = (" << value.numerator()
-               << ".0 / " << value.denominator() << ".0);\n";
+            os << "    const " << type << " " << rational_name(value) << " = (" << value.numerator() << ".0"
+               << fsuffix << " / " << value.denominator() << ".0" << fsuffix << ");\n";
         }
 
         os << "\n";
@@ -631,7 +691,7 @@ format_hrr_kernel(const int la, const int lb)
 
                         const auto imag = magnitude(ic);
 
-                        if (!(imag == Fraction(1))) inner += terminating_decimal(imag) + " * ";
+                        if (!(imag == Fraction(1))) inner += decimal_literal(imag, type) + " * ";
 
                         inner += terms[t].row + "[i]";
                     }
@@ -640,7 +700,7 @@ format_hrr_kernel(const int la, const int lb)
 
                     if (!(g == Fraction(1)))
                     {
-                        outer += (is_terminating(g) ? terminating_decimal(g) : rational_name(g)) + " * ";
+                        outer += (is_terminating(g) ? decimal_literal(g, type) : rational_name(g)) + " * ";
                     }
 
                     if (radicand != 1) outer += "f" + std::to_string(radicand) + " * ";
@@ -655,14 +715,14 @@ format_hrr_kernel(const int la, const int lb)
                 {
                     for (const auto& contrib : terms)
                     {
-                        summands.push_back({contrib.coeff.numerator() < 0, contribution_body(contrib)});
+                        summands.push_back({contrib.coeff.numerator() < 0, contribution_body(contrib, type)});
                     }
                 }
             }
 
             os << lead;
 
-            if (summands.empty()) os << "0.0";
+            if (summands.empty()) os << "0.0" << fsuffix;
 
             // one summand per line, the operator leading each continuation line.
             for (std::size_t s = 0; s < summands.size(); s++)
@@ -690,3 +750,202 @@ format_hrr_kernel(const int la, const int lb)
 
     return os.str();
 }
+
+std::string
+format_hrr_template_kernel()
+{
+    std::ostringstream os;
+
+    os << "/// One term of a spherical target component:\n";
+    os << "/// coef * base[row] * AB_x^px * AB_y^py * AB_z^pz.\n";
+    os << "struct HrrTerm\n";
+    os << "{\n";
+    os << "    int    row;\n";
+    os << "    double coef;\n";
+    os << "    int    px;\n";
+    os << "    int    py;\n";
+    os << "    int    pz;\n";
+    os << "};\n\n";
+
+    os << "/// The coefficient table of a (LA|LB) target, specialized in\n";
+    os << "/// ObaraSaikaTwoCenterHrrTable<LA><LB>.hpp.\n";
+    os << "template <int LA, int LB>\n";
+    os << "struct HrrTable;\n\n";
+
+    os << "namespace detail {  // template kernel building blocks\n\n";
+
+    os << "template <int N, class T>\n";
+    os << "inline T\n";
+    os << "ipow(const T x)\n";
+    os << "{\n";
+    os << "    if constexpr (N == 0)\n";
+    os << "        return T(1);\n";
+    os << "    else\n";
+    os << "        return x * ipow<N - 1>(x);\n";
+    os << "}\n\n";
+
+    os << "template <class Table, std::size_t K, class T>\n";
+    os << "inline T\n";
+    os << "term(const std::array<const T*, Table::nrows>& rows, const T ab_x, const T ab_y, const T ab_z, const std::size_t i)\n";
+    os << "{\n";
+    os << "    constexpr auto t = Table::terms[K];\n\n";
+    os << "    return static_cast<T>(t.coef) * rows[t.row][i] * ipow<t.px>(ab_x) * ipow<t.py>(ab_y) * ipow<t.pz>(ab_z);\n";
+    os << "}\n\n";
+
+    os << "template <class Table, std::size_t C, class T, std::size_t... K>\n";
+    os << "inline void\n";
+    os << "component(std::index_sequence<K...>,\n";
+    os << "          const std::array<const T*, Table::nrows>& rows,\n";
+    os << "          const T* ab_x,\n";
+    os << "          const T* ab_y,\n";
+    os << "          const T* ab_z,\n";
+    os << "          T*       target,\n";
+    os << "          const std::size_t npairs)\n";
+    os << "{\n";
+    os << "    constexpr auto first = static_cast<std::size_t>(Table::offsets[C]);\n\n";
+    os << "    #pragma omp simd\n";
+    os << "    for (std::size_t i = 0; i < npairs; i++)\n";
+    os << "    {\n";
+    os << "        target[i] = (T(0) + ... + term<Table, first + K>(rows, ab_x[i], ab_y[i], ab_z[i], i));\n";
+    os << "    }\n";
+    os << "}\n\n";
+
+    os << "template <class Table, class T, std::size_t NC, std::size_t... C>\n";
+    os << "inline void\n";
+    os << "components(std::index_sequence<C...>,\n";
+    os << "           const std::array<const T*, Table::nrows>& rows,\n";
+    os << "           const T* ab_x,\n";
+    os << "           const T* ab_y,\n";
+    os << "           const T* ab_z,\n";
+    os << "           const std::array<T*, NC>& targets,\n";
+    os << "           const std::size_t npairs)\n";
+    os << "{\n";
+    os << "    (component<Table, C>(std::make_index_sequence<Table::offsets[C + 1] - Table::offsets[C]>{},\n";
+    os << "                         rows, ab_x, ab_y, ab_z, targets[C], npairs), ...);\n";
+    os << "}\n\n";
+
+    os << "}  // namespace detail\n\n";
+
+    os << "/// Computes the spherical (LA|LB) target from the contracted Cartesian base\n";
+    os << "/// integrals by the horizontal recurrence tabulated in HrrTable<LA, LB>.\n";
+    os << "/// The bases are passed in the order of the explicit compute_<la>_<lb> kernel.\n";
+    os << "/// @param ab The AB distances.\n";
+    os << "/// @param target The spherical target integrals.\n";
+    os << "/// @param bases The contracted Cartesian base integrals.\n";
+    os << "template <int LA, int LB, class T, class... Bases>\n";
+    os << "void\n";
+    os << "compute(const osfunc::CArray<T>& ab, osfunc::CArray<T>& target, const Bases&... bases)\n";
+    os << "{\n";
+    os << "    using Table = HrrTable<LA, LB>;\n\n";
+    os << "    static_assert(sizeof...(Bases) == Table::base_sizes.size(), \"wrong number of base integrals\");\n\n";
+    os << "    // number of spherical components in the target integral\n";
+    os << "    constexpr std::size_t ncomps = (2 * LA + 1) * (2 * LB + 1);\n\n";
+    os << "    const auto nblocks = target.nrows() / ncomps;\n\n";
+    os << "    const auto npairs = target.ncols();\n\n";
+    os << "    const std::array<const osfunc::CArray<T>*, sizeof...(Bases)> bptrs = {&bases...};\n\n";
+    os << "    const T* ab_x = ab.row(0);\n";
+    os << "    const T* ab_y = ab.row(1);\n";
+    os << "    const T* ab_z = ab.row(2);\n\n";
+    os << "    for (std::size_t iblock = 0; iblock < nblocks; iblock++)\n";
+    os << "    {\n";
+    os << "        std::array<const T*, Table::nrows> rows;\n\n";
+    os << "        std::size_t irow = 0;\n\n";
+    os << "        for (std::size_t b = 0; b < bptrs.size(); b++)\n";
+    os << "        {\n";
+    os << "            const auto nrows = static_cast<std::size_t>(Table::base_sizes[b]);\n\n";
+    os << "            for (std::size_t r = 0; r < nrows; r++) rows[irow++] = bptrs[b]->row(iblock * nrows + r);\n";
+    os << "        }\n\n";
+    os << "        std::array<T*, ncomps> targets;\n\n";
+    os << "        for (std::size_t c = 0; c < ncomps; c++) targets[c] = target.row(iblock * ncomps + c);\n\n";
+    os << "        detail::components<Table>(std::make_index_sequence<ncomps>{}, rows, ab_x, ab_y, ab_z, targets, npairs);\n";
+    os << "    }\n";
+    os << "}\n";
+
+    return os.str();
+}
+
+std::string
+format_hrr_table(const int la, const int lb)
+{
+    const auto bases = hrr_bases(la, lb);
+
+    const auto rows = spherical_rows(la, lb);
+
+    int nrows = 0;
+
+    for (const auto& [bl, kl] : bases) nrows += cartesian_count(bl) * cartesian_count(kl);
+
+    std::ostringstream os;
+
+    os << "template <>\n";
+    os << "struct HrrTable<" << la << ", " << lb << ">\n";
+    os << "{\n";
+
+    os << "    /// Cartesian components of the base integrals";
+
+    for (std::size_t i = 0; i < bases.size(); i++)
+    {
+        os << (i ? ", " : " ") << "(" << shell_label(bases[i].first) << "|" << shell_label(bases[i].second) << ")";
+    }
+
+    os << ".\n";
+    os << "    static constexpr std::array<int, " << bases.size() << "> base_sizes = {";
+
+    for (std::size_t i = 0; i < bases.size(); i++)
+    {
+        os << (i ? ", " : "") << cartesian_count(bases[i].first) * cartesian_count(bases[i].second);
+    }
+
+    os << "};\n\n";
+
+    os << "    /// Number of base integral rows per block.\n";
+    os << "    static constexpr std::size_t nrows = " << nrows << ";\n\n";
+
+    os << "    /// First term of each spherical target component (and the end).\n";
+    os << "    static constexpr std::array<int, " << rows.size() + 1 << "> offsets = {";
+
+    std::size_t nterms = 0;
+
+    for (std::size_t c = 0; c <= rows.size(); c++)
+    {
+        os << (c ? ", " : "") << nterms;
+
+        if (c < rows.size()) nterms += rows[c].size();
+    }
+
+    os << "};\n\n";
+
+    os << "    /// Terms of the spherical target components, in component order.\n";
+    os << "    static constexpr std::array<HrrTerm, " << std::max<std::size_t>(nterms, 1) << "> terms = {{\n";
+
+    for (std::size_t c = 0; c < rows.size(); c++)
+    {
+        for (const auto& contrib : rows[c])
+        {
+            const auto value = static_cast<long double>(contrib.coeff.numerator()) / contrib.coeff.denominator()
+                             * std::sqrt(static_cast<long double>(contrib.radicand));
+
+            std::ostringstream coef;
+
+            coef << std::setprecision(17) << static_cast<double>(value);
+
+            auto literal = coef.str();
+
+            if (literal.find_first_of(".e") == std::string::npos) literal += ".0";
+
+            const auto power = [&contrib](const std::string& axis) {
+                return std::count(contrib.ab_factors.begin(), contrib.ab_factors.end(), axis);
+            };
+
+            os << "        {" << contrib.index << ", " << literal << ", " << power("ab_x") << ", "
+               << power("ab_y") << ", " << power("ab_z") << "},  // component " << c << "\n";
+        }
+    }
+
+    if (nterms == 0) os << "        {0, 0.0, 0, 0, 0},\n";
+
+    os << "    }};\n";
+    os << "};\n";
+
+    return os.str();
+}
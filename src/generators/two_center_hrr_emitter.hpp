@@ -19,21 +19,42 @@
 
 #include <string>
 
+#include "run_configuration.hpp"
+
 /// Builds the source of an os2c::hrr Cartesian horizontal-recurrence kernel for a
 /// two-center target (la|lb). The kernel takes one contracted Cartesian CArray per
 /// base integral the recurrence consumes, the AB distances CArray, and writes the
 /// Cartesian target into an out-parameter. The angular momentum is incremented on
-/// the bra side when la <= lb, on the ket side otherwise.
+/// the bra side when la <= lb, on the ket side otherwise. The kernel works on
+/// contracted integrals, so its value type is the precision's accumulator type.
 /// @param la The bra angular momentum.
 /// @param lb The ket angular momentum.
+/// @param precision The kernel precision.
 /// @return The generated kernel source.
-std::string format_hrr_kernel(const int la, const int lb);
+std::string format_hrr_kernel(const int la, const int lb, const cfg::Precision precision = cfg::Precision::fp64);
 
 /// Builds the kernel signature "void compute_<la>_<lb>(<inputs>)" (no body, no
 /// terminator), for the declaration in the matching header.
 /// @param la The bra angular momentum.
 /// @param lb The ket angular momentum.
+/// @param precision The kernel precision.
 /// @return The signature text.
-std::string format_hrr_signature(const int la, const int lb);
+std::string format_hrr_signature(const int la, const int lb, const cfg::Precision precision = cfg::Precision::fp64);
+
+/// Builds the body of the compile-time specialized os2c::hrr kernel header: the
+/// HrrTerm table entry, the HrrTable<LA, LB> primary template, and the generic
+/// compute<LA, LB>() kernel. The kernel walks the constexpr table of a target
+/// with std::index_sequence, so every component loop and coefficient is fixed
+/// at compile time; it is generic in the value type of the CArrays.
+/// @return The generated header body (within namespace os2c::hrr).
+std::string format_hrr_template_kernel();
+
+/// Builds the HrrTable<la, lb> specialization consumed by the template kernel:
+/// the Cartesian sizes of the base integrals and, per spherical target
+/// component, the sparse terms coefficient * base row * AB_x^i AB_y^j AB_z^k.
+/// @param la The bra angular momentum.
+/// @param lb The ket angular momentum.
+/// @return The generated specialization (within namespace os2c::hrr).
+std::string format_hrr_table(const int la, const int lb);
 
 #endif /* two_center_hrr_emitter_hpp */
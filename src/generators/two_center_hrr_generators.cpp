@@ -16,7 +16,7 @@
 
 #include "two_center_hrr_generators.hpp"
 
-#include <fstream>
+#include <sstream>
 #include <iostream>
 #include <string>
 
@@ -26,10 +26,14 @@
 namespace {  // two-center HRR generator helpers
 
 /// The base file name (no extension) of a (la|lb) kernel, e.g. (1|1) -> "...PP".
+/// Single-precision kernels carry an "Fp32" suffix; mixed precision transfers
+/// contracted (double) integrals and so shares the fp64 kernels.
 std::string
-kernel_file_name(const int la, const int lb)
+kernel_file_name(const int la, const int lb, const cfg::Precision precision)
 {
-    return "ObaraSaikaTwoCenterHrr" + Tensor(la).label() + Tensor(lb).label();
+    const auto suffix = (cfg::accumulator_type(precision) == "float") ? "Fp32" : "";
+
+    return "ObaraSaikaTwoCenterHrr" + Tensor(la).label() + Tensor(lb).label() + suffix;
 }
 
 /// Whether a (la|lb) target is emitted for the requested recursion type. HRR needs
@@ -62,53 +66,105 @@ selected(const cfg::RecursionType type, const int la, const int lb)
 
 /// Writes the kernel declaration header (.hpp).
 void
-write_hpp(const int la, const int lb)
+write_hpp(const int la, const int lb, const cfg::Precision precision, ost::OutputSink& sink)
 {
-    const auto base = kernel_file_name(la, lb);
+    const auto base = kernel_file_name(la, lb, precision);
 
     const auto guard = base + "_hpp";
 
-    std::ofstream fstream;
-
-    fstream.open((base + ".hpp").c_str(), std::ios_base::trunc);
+    std::ostringstream fstream;
 
     fstream << "#ifndef " << guard << "\n";
     fstream << "#define " << guard << "\n\n";
     fstream << "#include \"Array.hpp\"\n\n";
     fstream << "namespace os2c::hrr {  // horizontal recurrence\n\n";
-    fstream << format_hrr_signature(la, lb) << ";\n\n";
+    fstream << format_hrr_signature(la, lb, precision) << ";\n\n";
     fstream << "}  // namespace os2c::hrr\n\n";
     fstream << "#endif /* " << guard << " */\n";
 
-    fstream.close();
+    sink.write({base + ".hpp", fstream.str()});
 }
 
 /// Writes the kernel definition (.cpp).
 void
-write_cpp(const int la, const int lb)
+write_cpp(const int la, const int lb, const cfg::Precision precision, ost::OutputSink& sink)
 {
-    const auto base = kernel_file_name(la, lb);
-
-    std::ofstream fstream;
+    const auto base = kernel_file_name(la, lb, precision);
 
-    fstream.open((base + ".cpp").c_str(), std::ios_base::trunc);
+    std::ostringstream fstream;
 
     fstream << "#include \"" << base << ".hpp\"\n\n";
     fstream << "#include <cmath>\n\n";
     fstream << "namespace os2c::hrr {  // horizontal recurrence\n\n";
-    fstream << format_hrr_kernel(la, lb) << "\n";
+    fstream << format_hrr_kernel(la, lb, precision) << "\n";
     fstream << "}  // namespace os2c::hrr\n";
 
-    fstream.close();
+    sink.write({base + ".cpp", fstream.str()});
+}
+
+/// Writes the header of the compile-time specialized kernel template, shared by
+/// every table.
+void
+write_template_kernel(ost::OutputSink& sink)
+{
+    std::ostringstream fstream;
+
+    fstream << "#ifndef ObaraSaikaTwoCenterHrrKernel_hpp\n";
+    fstream << "#define ObaraSaikaTwoCenterHrrKernel_hpp\n\n";
+    fstream << "#include <array>\n";
+    fstream << "#include <cstddef>\n";
+    fstream << "#include <utility>\n\n";
+    fstream << "#include \"Array.hpp\"\n\n";
+    fstream << "namespace os2c::hrr {  // horizontal recurrence\n\n";
+    fstream << format_hrr_template_kernel() << "\n";
+    fstream << "}  // namespace os2c::hrr\n\n";
+    fstream << "#endif /* ObaraSaikaTwoCenterHrrKernel_hpp */\n";
+
+    sink.write({"ObaraSaikaTwoCenterHrrKernel.hpp", fstream.str()});
+}
+
+/// Writes the constexpr coefficient table of a (la|lb) target (.hpp only). The
+/// table is precision independent: the kernel instantiates in the CArray type.
+void
+write_table(const int la, const int lb, ost::OutputSink& sink)
+{
+    const auto base = "ObaraSaikaTwoCenterHrrTable" + Tensor(la).label() + Tensor(lb).label();
+
+    const auto guard = base + "_hpp";
+
+    std::ostringstream fstream;
+
+    fstream << "#ifndef " << guard << "\n";
+    fstream << "#define " << guard << "\n\n";
+    fstream << "#include \"ObaraSaikaTwoCenterHrrKernel.hpp\"\n\n";
+    fstream << "namespace os2c::hrr {  // horizontal recurrence\n\n";
+    fstream << format_hrr_table(la, lb) << "\n";
+    fstream << "}  // namespace os2c::hrr\n\n";
+    fstream << "#endif /* " << guard << " */\n";
+
+    sink.write({base + ".hpp", fstream.str()});
 }
 
 }  // namespace
 
 void
 TwoCenterHrrGenerator::generate(const cfg::RunConfiguration& run_config) const
+{
+    ost::DirectorySink sink;
+
+    generate(run_config, sink);
+}
+
+void
+TwoCenterHrrGenerator::generate(const cfg::RunConfiguration& run_config,
+                                ost::OutputSink&             sink) const
 {
     const auto type = *run_config.recursion_type;
 
+    const bool templated = (run_config.kernel_form == cfg::KernelForm::templated);
+
+    if (templated) write_template_kernel(sink);
+
     int count = 0;
 
     for (int la = run_config.min_ang_mom; la <= run_config.max_ang_mom; la++)
@@ -117,11 +173,20 @@ TwoCenterHrrGenerator::generate(const cfg::RunConfiguration& run_config) const
         {
             if (!selected(type, la, lb)) continue;
 
-            write_hpp(la, lb);
+            if (templated)
+            {
+                write_table(la, lb, sink);
+
+                std::cout << "Generated " << Tensor(la).label() << Tensor(lb).label() << " kernel table" << std::endl;
+            }
+            else
+            {
+                write_hpp(la, lb, run_config.precision, sink);
 
-            write_cpp(la, lb);
+                write_cpp(la, lb, run_config.precision, sink);
 
-            std::cout << "Generated " << kernel_file_name(la, lb) << " kernel" << std::endl;
+                std::cout << "Generated " << kernel_file_name(la, lb, run_config.precision) << " kernel" << std::endl;
+            }
 
             count++;
         }
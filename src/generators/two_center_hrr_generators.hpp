@@ -17,6 +17,7 @@
 #ifndef two_center_hrr_generators_hpp
 #define two_center_hrr_generators_hpp
 
+#include "output_sink.hpp"
 #include "run_configuration.hpp"
 
 /// Generates the os2c::hrr two-center horizontal-recurrence kernels that fold the
@@ -24,7 +25,9 @@
 /// consume the contracted Cartesian base integrals (reduced to one side at s) and
 /// the AB distances, and write the spherical target. The recursion_type selects
 /// which transfers to emit: hrr_bra (bra side, la <= lb), hrr_ket (ket side,
-/// la > lb), or hrr_bra_ket (both).
+/// la > lb), or hrr_bra_ket (both). With kernel_form = templated the generator
+/// instead writes one shared compute<LA, LB>() template header plus a constexpr
+/// coefficient table header per target, and no .cpp files.
 class TwoCenterHrrGenerator
 {
 public:
@@ -36,6 +39,12 @@ public:
     /// working directory.
     /// @param run_config The new-style run configuration (recursion_type set).
     void generate(const cfg::RunConfiguration& run_config) const;
+
+    /// Writes the same kernels into an output sink.
+    /// @param run_config The new-style run configuration.
+    /// @param sink The output sink receiving the emitted files.
+    void generate(const cfg::RunConfiguration& run_config,
+                  ost::OutputSink&             sink) const;
 };
 
 #endif /* two_center_hrr_generators_hpp */
@@ -69,7 +69,7 @@ component_index(const int l, const TensorComponent& component)
 /// (no body, no terminator): the pair, the lower (s|lb-1)/(s|lb-2) integrals, the
 /// Pc distances, and the Cartesian target out-parameter.
 std::string
-signature_cartesian_text(const int lb)
+signature_cartesian_text(const int lb, const std::string& type)
 {
     const auto name = "compute_" + shell_label(lb);
 
@@ -78,21 +78,22 @@ signature_cartesian_text(const int lb)
     std::ostringstream os;
 
     os << "void " << name << "(const osfunc::CBasisFunctionPair& pair,\n";
-    os << indent << "const osfunc::CArray<double>& s" << shell_label(lb - 1) << ",\n";
+    os << indent << "const osfunc::CArray<" << type << ">& s" << shell_label(lb - 1) << ",\n";
 
-    if (lb >= 2) os << indent << "const osfunc::CArray<double>& s" << shell_label(lb - 2) << ",\n";
+    if (lb >= 2) os << indent << "const osfunc::CArray<" << type << ">& s" << shell_label(lb - 2) << ",\n";
 
-    os << indent << "const osfunc::CArray<double>& pc,\n";
-    os << indent << "      osfunc::CArray<double>& s" << shell_label(lb) << ")";
+    os << indent << "const osfunc::CArray<" << type << ">& pc,\n";
+    os << indent << "      osfunc::CArray<" << type << ">& s" << shell_label(lb) << ")";
 
     return os.str();
 }
 
 /// The signature "void compute_<lb>_sph(...)" of the full spherical VRR kernel (no
 /// body, no terminator): the pair, the (s|s) seed, the Pc distances, and the
-/// spherical target out-parameter.
+/// spherical target out-parameter. The primitive inputs and the contracted output
+/// may differ in type (mixed precision).
 std::string
-signature_spherical_text(const int lb)
+signature_spherical_text(const int lb, const std::string& type, const std::string& acc_type)
 {
     const auto name = "compute_" + shell_label(lb) + "_sph";
 
@@ -101,9 +102,9 @@ signature_spherical_text(const int lb)
     std::ostringstream os;
 
     os << "void " << name << "(const osfunc::CBasisFunctionPair& pair,\n";
-    os << indent << "const osfunc::CArray<double>& ss,\n";
-    os << indent << "const osfunc::CArray<double>& pc,\n";
-    os << indent << "      osfunc::CArray<double>& s" << shell_label(lb) << ")";
+    os << indent << "const osfunc::CArray<" << type << ">& ss,\n";
+    os << indent << "const osfunc::CArray<" << type << ">& pc,\n";
+    os << indent << "      osfunc::CArray<" << acc_type << ">& s" << shell_label(lb) << ")";
 
     return os.str();
 }
@@ -159,6 +160,23 @@ terminating_decimal(const Fraction& value)
     return digits.substr(0, digits.size() - places) + "." + fraction;
 }
 
+/// The literal suffix of a floating-point type: "f" for float, none for double.
+std::string
+literal_suffix(const std::string& type)
+{
+    return (type == "float") ? "f" : "";
+}
+
+/// The fe = 1/(2 eta) expression of a primitive pair. The exponents are stored in
+/// double, so the factor is formed in double and narrowed once for float.
+std::string
+fe_expression(const std::string& type)
+{
+    const std::string expr = "1.0 / (2.0 * (bra_exps[p] + ket_exps[q]))";
+
+    return (type == "float") ? "static_cast<float>(" + expr + ")" : expr;
+}
+
 /// The hoisted-constant name of a non-terminating rational, e.g. 1/3 -> "q1_3".
 std::string
 rational_name(const Fraction& value)
@@ -234,7 +252,7 @@ pc_pointer(const Factor& factor)
 /// coefficient, e.g. "fe * pc_x[i] * pc_y[i]" (the coefficient is emitted by the
 /// caller, the seed t_ss[i] appended afterwards).
 std::string
-factor_body(const Contribution& c)
+factor_body(const Contribution& c, const std::string& fsuffix)
 {
     std::string body;
 
@@ -242,7 +260,7 @@ factor_body(const Contribution& c)
 
     for (const auto& a : c.pc) body += (body.empty() ? "" : " * ") + a + "[i]";
 
-    if (body.empty()) body = "1.0";  // pure constant (degenerate)
+    if (body.empty()) body = "1.0" + fsuffix;  // pure constant (degenerate)
 
     return body;
 }
@@ -274,10 +292,18 @@ group_gcd(const std::vector<Contribution>& terms)
 }  // namespace
 
 std::string
-format_vrr_spherical_kernel(const int lb)
+format_vrr_spherical_kernel(const int lb, const cfg::Precision precision)
 {
     const auto target = "s" + shell_label(lb);
 
+    // primitive inputs are read in the primitive type, the contracted rows (and
+    // every constant folded into them) are accumulated in the accumulator type.
+    const auto type = cfg::primitive_type(precision);
+
+    const auto acc_type = cfg::accumulator_type(precision);
+
+    const auto fsuffix = literal_suffix(acc_type);
+
     const auto nspher = 2 * lb + 1;
 
     // the full ket VRR reduction of every Cartesian (s|lb) component, keyed by the
@@ -289,7 +315,7 @@ format_vrr_spherical_kernel(const int lb)
 
     std::map<TensorComponent, std::vector<R2CTerm>> reductions;
 
-    for (const auto& comp : integral.components<T1CPair, T1CPair>())
+    for (const auto& comp : integral.component_range<T1CPair, T1CPair>())
     {
         reductions[comp[1]] = fully_reduce_ket(drv, R2CTerm(comp));
     }
@@ -352,7 +378,7 @@ format_vrr_spherical_kernel(const int lb)
 
     std::ostringstream os;
 
-    os << signature_spherical_text(lb) << "\n";
+    os << signature_spherical_text(lb, type, acc_type) << "\n";
     os << "{\n";
 
     os << "    // bra and ket contracted basis functions\n";
@@ -381,7 +407,10 @@ format_vrr_spherical_kernel(const int lb)
     {
         os << "    // transformation factors\n";
 
-        for (const auto r : radicals) os << "    const double f" << r << " = std::sqrt(" << r << ".0);\n";
+        for (const auto r : radicals)
+        {
+            os << "    const " << acc_type << " f" << r << " = std::sqrt(" << r << ".0" << fsuffix << ");\n";
+        }
 
         os << "\n";
     }
@@ -417,7 +446,7 @@ format_vrr_spherical_kernel(const int lb)
 
     if (uses_fe)
     {
-        os << "            const auto fe = 1.0 / (2.0 * (bra_exps[p] + ket_exps[q]));   // 1 / (2 eta)\n\n";
+        os << "            const auto fe = " << fe_expression(acc_type) << ";   // 1 / (2 eta)\n\n";
     }
 
     os << "            auto t_ss = ss.row(ip);          // (s|s) primitive overlap (contraction folded in)\n";
@@ -463,7 +492,7 @@ format_vrr_spherical_kernel(const int lb)
 
         if (terms.empty())
         {
-            os << prefix << "0.0;\n";
+            os << prefix << "0.0" << fsuffix << ";\n";
 
             os << "            }\n";
 
@@ -483,13 +512,13 @@ format_vrr_spherical_kernel(const int lb)
         // the factored-out coefficient: sign, rational GCD, radical.
         if (first_neg) prefix += "-";
 
-        if (!(g == Fraction(1))) prefix += terminating_decimal(g) + " * ";
+        if (!(g == Fraction(1))) prefix += terminating_decimal(g) + fsuffix + " * ";
 
         if (radicand != 1) prefix += "f" + std::to_string(radicand) + " * ";
 
         if (terms.size() == 1)
         {
-            os << prefix << factor_body(terms[0]) << " * t_ss[i];\n";
+            os << prefix << factor_body(terms[0], fsuffix) << " * t_ss[i];\n";
         }
         else
         {
@@ -520,9 +549,9 @@ format_vrr_spherical_kernel(const int lb)
 
                 const auto imag = magnitude(ic);
 
-                if (!(imag == Fraction(1))) os << terminating_decimal(imag) << " * ";
+                if (!(imag == Fraction(1))) os << terminating_decimal(imag) << fsuffix << " * ";
 
-                os << factor_body(terms[t]);
+                os << factor_body(terms[t], fsuffix);
             }
 
             os << ") * t_ss[i];\n";
@@ -552,10 +581,15 @@ lower_row_name(const T2CIntegral& integral)
 }  // namespace
 
 std::string
-format_vrr_cartesian_kernel(const int lb)
+format_vrr_cartesian_kernel(const int lb, const cfg::Precision precision)
 {
     const auto target = "s" + shell_label(lb);
 
+    // the kernel is per-primitive, so it works in the primitive type throughout.
+    const auto type = cfg::primitive_type(precision);
+
+    const auto fsuffix = literal_suffix(type);
+
     const auto ntarget = cartesian_count(lb);
 
     // the lower (s|lb-1) and (s|lb-2) Cartesian integrals the single step consumes.
@@ -576,7 +610,7 @@ format_vrr_cartesian_kernel(const int lb)
 
     std::ostringstream os;
 
-    os << signature_cartesian_text(lb) << "\n";
+    os << signature_cartesian_text(lb, type) << "\n";
     os << "{\n";
 
     os << "    // bra and ket contracted basis functions\n";
@@ -598,7 +632,7 @@ format_vrr_cartesian_kernel(const int lb)
 
     os << "            const auto ip = p * ket.number_of_primitive_functions() + q;\n\n";
 
-    os << "            const auto fe = 1.0 / (2.0 * (bra_exps[p] + ket_exps[q]));   // 1 / (2 eta)\n\n";
+    os << "            const auto fe = " << fe_expression(type) << ";   // 1 / (2 eta)\n\n";
 
     // input and output row pointers, offset by ip times the integral's component count.
     for (const auto& [order, label] : inputs)
@@ -683,7 +717,7 @@ format_vrr_cartesian_kernel(const int lb)
             if (t == 0) { if (neg) os << "-"; }
             else os << (neg ? " - " : " + ");
 
-            if (!(mag == Fraction(1))) os << terminating_decimal(mag) << " * ";
+            if (!(mag == Fraction(1))) os << terminating_decimal(mag) << fsuffix << " * ";
 
             if (!pc_factor.empty()) os << pc_factor << "[i] * ";
 
@@ -704,13 +738,13 @@ format_vrr_cartesian_kernel(const int lb)
 }
 
 std::string
-format_vrr_cartesian_signature(const int lb)
+format_vrr_cartesian_signature(const int lb, const cfg::Precision precision)
 {
-    return signature_cartesian_text(lb);
+    return signature_cartesian_text(lb, cfg::primitive_type(precision));
 }
 
 std::string
-format_vrr_spherical_signature(const int lb)
+format_vrr_spherical_signature(const int lb, const cfg::Precision precision)
 {
-    return signature_spherical_text(lb);
+    return signature_spherical_text(lb, cfg::primitive_type(precision), cfg::accumulator_type(precision));
 }
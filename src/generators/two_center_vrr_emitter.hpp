@@ -19,14 +19,18 @@
 
 #include <string>
 
+#include "run_configuration.hpp"
+
 /// Builds the source of an os2c::ovl spherical two-center VRR kernel: it builds the
 /// (s|lb) overlap from the (s|s) seed via the Obara-Saika ket vertical recurrence,
 /// fully reduced, and folds in the Cartesian-to-spherical transform so the result
 /// is the spherical (s|lb) block. The kernel contracts over the primitive basis
 /// functions of the pair.
 /// @param lb The ket angular momentum.
+/// @param precision The precision: the primitive inputs use cfg::primitive_type,
+/// the contracted result cfg::accumulator_type.
 /// @return The generated kernel source.
-std::string format_vrr_spherical_kernel(const int lb);
+std::string format_vrr_spherical_kernel(const int lb, const cfg::Precision precision = cfg::Precision::fp64);
 
 /// Builds the source of an os2c::vrr::ovl single-step Cartesian two-center VRR
 /// kernel: it builds the primitive Cartesian (s|lb) overlap from the lower
@@ -34,19 +38,22 @@ std::string format_vrr_spherical_kernel(const int lb);
 /// kernel is per-primitive (the fe = 1/(2 eta) factor is retained), so the result
 /// is contracted downstream.
 /// @param lb The ket angular momentum.
+/// @param precision The precision; the kernel works in cfg::primitive_type.
 /// @return The generated kernel source.
-std::string format_vrr_cartesian_kernel(const int lb);
+std::string format_vrr_cartesian_kernel(const int lb, const cfg::Precision precision = cfg::Precision::fp64);
 
 /// Builds the spherical VRR kernel signature "void compute_<lb>_sph(...)" (no
 /// body, no terminator), for the declaration in the matching header.
 /// @param lb The ket angular momentum.
+/// @param precision The precision of the kernel.
 /// @return The signature text.
-std::string format_vrr_spherical_signature(const int lb);
+std::string format_vrr_spherical_signature(const int lb, const cfg::Precision precision = cfg::Precision::fp64);
 
 /// Builds the Cartesian VRR kernel signature "void compute_<lb>(...)" (no body, no
 /// terminator), for the declaration in the matching header.
 /// @param lb The ket angular momentum.
+/// @param precision The precision of the kernel.
 /// @return The signature text.
-std::string format_vrr_cartesian_signature(const int lb);
+std::string format_vrr_cartesian_signature(const int lb, const cfg::Precision precision = cfg::Precision::fp64);
 
 #endif /* two_center_vrr_emitter_hpp */
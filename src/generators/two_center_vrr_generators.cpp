@@ -16,7 +16,7 @@
 
 #include "two_center_vrr_generators.hpp"
 
-#include <fstream>
+#include <sstream>
 #include <iostream>
 #include <string>
 
@@ -26,8 +26,8 @@
 namespace {  // two-center VRR generator helpers
 
 /// The naming/emission traits of a VRR flavor: the file-name tag, the kernel
-/// namespace and its documentation, whether the source needs <cmath>, and the
-/// signature/definition emitters.
+/// namespace and its documentation, whether the source needs <cmath>, the
+/// signature/definition emitters, and the precision the kernels are emitted in.
 struct VrrFlavor
 {
     std::string file_tag;   // "Cart" or "Sph"
@@ -35,26 +35,36 @@ struct VrrFlavor
     std::string caption;    // namespace comment
     bool        needs_math;  // the spherical kernels use std::sqrt
 
-    std::string (*signature)(const int);
-    std::string (*kernel)(const int);
+    std::string (*signature)(const int, const cfg::Precision);
+    std::string (*kernel)(const int, const cfg::Precision);
+
+    cfg::Precision precision;
+    std::string    precision_tag;  // file-name suffix, empty for fp64 kernels
 };
 
 /// The flavor traits for the configured recursion type. The switch carries no
 /// default, so a new RecursionType trips -Wswitch here.
 /// @param type The recursion type (a vrr_* value).
+/// @param precision The configured precision.
 /// @return The flavor traits.
 VrrFlavor
-flavor(const cfg::RecursionType type)
+flavor(const cfg::RecursionType type, const cfg::Precision precision)
 {
+    // the Cartesian kernel is purely primitive, so fp32 and mixed share one float
+    // kernel; the spherical kernel also contracts and so differs for all three.
+    const auto cart_tag = (cfg::primitive_type(precision) == "float") ? "Fp32" : "";
+
+    const auto sph_tag = (precision == cfg::Precision::fp64) ? "" : (precision == cfg::Precision::fp32) ? "Fp32" : "Mixed";
+
     switch (type)
     {
         case cfg::RecursionType::vrr_cartesian:
             return {"Cart", "os2c::vrr::ovl", "overlap Cartesian vertical recurrence",
-                    false, format_vrr_cartesian_signature, format_vrr_cartesian_kernel};
+                    false, format_vrr_cartesian_signature, format_vrr_cartesian_kernel, precision, cart_tag};
 
         case cfg::RecursionType::vrr_spherical:
             return {"Sph", "os2c::ovl", "overlap spherical vertical recurrence",
-                    true, format_vrr_spherical_signature, format_vrr_spherical_kernel};
+                    true, format_vrr_spherical_signature, format_vrr_spherical_kernel, precision, sph_tag};
 
         // the HRR recursion types are handled by the HRR generator, not here.
         case cfg::RecursionType::hrr_bra_ket:
@@ -68,56 +78,52 @@ flavor(const cfg::RecursionType type)
 }
 
 /// The base file name (no extension) of a (s|lb) kernel, e.g. lb = 2, "Cart" ->
-/// "ObaraSaikaTwoCenterOverlapVrrCartD".
+/// "ObaraSaikaTwoCenterOverlapVrrCartD" (or "...CartDFp32" for float kernels).
 std::string
 kernel_file_name(const VrrFlavor& flv, const int lb)
 {
-    return "ObaraSaikaTwoCenterOverlapVrr" + flv.file_tag + Tensor(lb).label();
+    return "ObaraSaikaTwoCenterOverlapVrr" + flv.file_tag + Tensor(lb).label() + flv.precision_tag;
 }
 
 /// Writes the kernel declaration header (.hpp).
 void
-write_hpp(const VrrFlavor& flv, const int lb)
+write_hpp(const VrrFlavor& flv, const int lb, ost::OutputSink& sink)
 {
     const auto base = kernel_file_name(flv, lb);
 
     const auto guard = base + "_hpp";
 
-    std::ofstream fstream;
-
-    fstream.open((base + ".hpp").c_str(), std::ios_base::trunc);
+    std::ostringstream fstream;
 
     fstream << "#ifndef " << guard << "\n";
     fstream << "#define " << guard << "\n\n";
     fstream << "#include \"Array.hpp\"\n";
     fstream << "#include \"BasisFunctionPair.hpp\"\n\n";
     fstream << "namespace " << flv.ns << " {  // " << flv.caption << "\n\n";
-    fstream << flv.signature(lb) << ";\n\n";
+    fstream << flv.signature(lb, flv.precision) << ";\n\n";
     fstream << "}  // namespace " << flv.ns << "\n\n";
     fstream << "#endif /* " << guard << " */\n";
 
-    fstream.close();
+    sink.write({base + ".hpp", fstream.str()});
 }
 
 /// Writes the kernel definition (.cpp).
 void
-write_cpp(const VrrFlavor& flv, const int lb)
+write_cpp(const VrrFlavor& flv, const int lb, ost::OutputSink& sink)
 {
     const auto base = kernel_file_name(flv, lb);
 
-    std::ofstream fstream;
-
-    fstream.open((base + ".cpp").c_str(), std::ios_base::trunc);
+    std::ostringstream fstream;
 
     fstream << "#include \"" << base << ".hpp\"\n\n";
 
     if (flv.needs_math) fstream << "#include <cmath>\n\n";
 
     fstream << "namespace " << flv.ns << " {  // " << flv.caption << "\n\n";
-    fstream << flv.kernel(lb) << "\n";
+    fstream << flv.kernel(lb, flv.precision) << "\n";
     fstream << "}  // namespace " << flv.ns << "\n";
 
-    fstream.close();
+    sink.write({base + ".cpp", fstream.str()});
 }
 
 }  // namespace
@@ -125,7 +131,16 @@ write_cpp(const VrrFlavor& flv, const int lb)
 void
 TwoCenterVrrGenerator::generate(const cfg::RunConfiguration& run_config) const
 {
-    const auto flv = flavor(*run_config.recursion_type);
+    ost::DirectorySink sink;
+
+    generate(run_config, sink);
+}
+
+void
+TwoCenterVrrGenerator::generate(const cfg::RunConfiguration& run_config,
+                                ost::OutputSink&             sink) const
+{
+    const auto flv = flavor(*run_config.recursion_type, run_config.precision);
 
     // the vertical recurrence builds the ket, so lb must be at least 1.
     const auto min_lb = (run_config.min_ang_mom < 1) ? 1 : run_config.min_ang_mom;
@@ -134,9 +149,9 @@ TwoCenterVrrGenerator::generate(const cfg::RunConfiguration& run_config) const
 
     for (int lb = min_lb; lb <= run_config.max_ang_mom; lb++)
     {
-        write_hpp(flv, lb);
+        write_hpp(flv, lb, sink);
 
-        write_cpp(flv, lb);
+        write_cpp(flv, lb, sink);
 
         std::cout << "Generated " << kernel_file_name(flv, lb) << " kernel" << std::endl;
 
@@ -17,6 +17,7 @@
 #ifndef two_center_vrr_generators_hpp
 #define two_center_vrr_generators_hpp
 
+#include "output_sink.hpp"
 #include "run_configuration.hpp"
 
 /// Generates the two-center overlap vertical-recurrence kernels that build the
@@ -35,6 +36,12 @@ public:
     /// @param run_config The new-style run configuration (recursion_type set to a
     /// vrr_* value).
     void generate(const cfg::RunConfiguration& run_config) const;
+
+    /// Writes the same kernels into an output sink.
+    /// @param run_config The new-style run configuration.
+    /// @param sink The output sink receiving the emitted files.
+    void generate(const cfg::RunConfiguration& run_config,
+                  ost::OutputSink&             sink) const;
 };
 
 #endif /* two_center_vrr_generators_hpp */
@@ -14,16 +14,29 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
 #include <array>
+#include <atomic>
 #include <chrono>
 #include <cstddef>
+#include <exception>
+#include <filesystem>
+#include <fstream>
 #include <iostream>
+#include <map>
+#include <mutex>
+#include <sstream>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
 #include "config.hpp"
+#include "kernel_registry.hpp"
+#include "ltm.hpp"
+#include "output_sink.hpp"
 #include "run_configuration.hpp"
+#include "string_formater.hpp"
 
 #include "t2c_cpu_generators.hpp"
 #include "t2c_geom_cpu_generators.hpp"
@@ -44,9 +57,6 @@
 #include "t2c_proj_ecp_cpu_generators.hpp"
 #include "t2c_geom_proj_ecp_cpu_generators.hpp"
 
-#include "two_center_generators.hpp"
-#include "two_center_hrr_generators.hpp"
-#include "two_center_vrr_generators.hpp"
 #include "spherical_momentum_generators.hpp"
 
 namespace {  // run-driver helpers
@@ -64,6 +74,8 @@ print_usage(std::ostream& os)
     os << "Litmus - an automated molecular integrals generator.\n\n"
        << "Usage:\n"
        << "  litmus run <config-file>   Generate integrals described by the config file.\n"
+       << "  litmus dedup <directory>   Rewrite generated kernels whose bodies duplicate\n"
+       << "                             another kernel as calls to that kernel.\n"
        << "  litmus --help              Show this help.\n\n"
        << "Generated source files are written to the current working directory.\n\n"
        << "Config file (minimal TOML subset: 'key = value', '#' comments). The\n"
@@ -80,11 +92,54 @@ print_usage(std::ostream& os)
        << "  aux_lmax   auxiliary angular momentum for t3c types (int, default lmax+2).\n"
        << "  proj_lmax  projector angular momentum for t2c_proj_ecp (int, default 0).\n"
        << "  rec_form   recursion form for t2c types (2-entry int array, default [1, 0]).\n"
-       << "  use_rs     range-separation flag for t2c/g2c types (bool, default false).\n\n"
+       << "  use_rs     range-separation flag for t2c/g2c types (bool, default false).\n"
+       << "  prim_screening\n"
+       << "             primitive-pair screening for t2c_cpu and geometric t4c_cpu types:\n"
+       << "             skip primitive pairs with integral bound below 1.0e-n (int n,\n"
+       << "             default 0 = off).\n"
+       << "  trans_inv  translational invariance for first order t2c_cpu 'geom': write\n"
+       << "             ...GeomGrad... kernels computing d/dA of overlap, kinetic energy,\n"
+       << "             or electron repulsion integrals once and d/dB = -d/dA from it\n"
+       << "             (bool, default false).\n"
+       << "  point_batch\n"
+       << "             point-batched three-center overlap/r2/r.r2 kernels for t2c_cpu\n"
+       << "             types: besides the per-point Sum kernels, emit kernels whose SIMD\n"
+       << "             lanes hold ket primitives of n external Gaussians, so recursion runs\n"
+       << "             once per n points (int n, default 0 = off; summation rec_form only).\n"
+       << "  fuse_hessian\n"
+       << "             fused geometric Hessian kernels for t4c_cpu types: one call per\n"
+       << "             quadruple computes the 10, 01, 20, 11, and 1010 derivatives from a\n"
+       << "             single VRR pass (bool, default false; excludes 'geom').\n"
+       << "  flat_ket_lanes\n"
+       << "             flattened ket lanes for t4c_cpu geometric kernels: one call takes\n"
+       << "             all ket pair blocks sorted by primitive count and packs primitive\n"
+       << "             lanes of pairs with different contraction depth into shared SIMD\n"
+       << "             batches (bool, default false; requires non-zero 'geom').\n"
+       << "  jk_accumulate\n"
+       << "             J/K accumulating t4c_cpu geometric kernels: the bra spherical\n"
+       << "             transformation is fused with Fock matrix accumulation, so no\n"
+       << "             spherical integrals buffer is stored (bool, default false;\n"
+       << "             requires non-zero 'geom').\n"
+       << "  geom_order maximum order of geometrical derivative on center A for the\n"
+       << "             t4c_call_tree dispatch table (int, default 0).\n"
+       << "  grid_batch grid-batched kernels for g2c_cpu types: one call evaluates all\n"
+       << "             basis function pairs of bra/ket GTOs block ranges on a block of\n"
+       << "             grid points (bool, default false).\n"
+       << "  grid_screening\n"
+       << "             grid-point screening for batched g2c_cpu kernels: skip primitive\n"
+       << "             pairs with (s|A|s) bound over the point block below 1.0e-n, using\n"
+       << "             the smallest P-to-point distance (int n, default 0 = off).\n\n"
+       << "Multiple runs: each '[[run]]' header opens a run table holding one of the\n"
+       << "schemas below; keys above the first header are defaults shared by all\n"
+       << "runs. The runs execute concurrently in one process, except that runs of\n"
+       << "one generator family (the 'type' prefix before the first '_', e.g. all\n"
+       << "t4c* types; or the same 'integral_type'/'recursion_type') execute in order.\n"
+       << "  jobs       maximum number of concurrent runs (int, default: the number\n"
+       << "             of hardware threads).\n\n"
        << "New-style schema (key 'integral_type' or 'recursion_type'; spellings are\n"
        << "case- and separator-insensitive, e.g. 'two_center' == 'TwoCenter'):\n"
        << "  integral_type  integral arity: two_center|2c, three_center|3c,\n"
-       << "                 four_center|4c. Only two_center is wired in so far.\n"
+       << "                 four_center|4c.\n"
        << "  recursion_type two-center recurrence kernels: hrr_bra_ket, hrr_bra,\n"
        << "                 hrr_ket (os2c::hrr), vrr_cartesian, vrr_spherical\n"
        << "                 (os2c::vrr::ovl / os2c::ovl overlap VRR).\n"
@@ -92,15 +147,29 @@ print_usage(std::ostream& os)
        << "  max_ang_mom    maximum angular momentum (int, required).\n"
        << "  min_ang_mom    minimum angular momentum (int, default 0).\n"
        << "  operator_type  integrand (default overlap): overlap, kinetic_energy,\n"
-       << "                 nuclear_potential, electron_repulsion, dipole_momentum,\n"
+       << "                 nuclear_potential, electron_repulsion,\n"
+       << "                 long_range_electron_repulsion (erf),\n"
+       << "                 short_range_electron_repulsion (erfc), dipole_momentum,\n"
        << "                 linear_momentum, local_ecp, projected_ecp,\n"
        << "                 three_center_overlap, three_center_r2,\n"
        << "                 three_center_r_dot_r2. two_center supports overlap,\n"
-       << "                 kinetic_energy, electron_repulsion.\n"
+       << "                 kinetic_energy and the electron repulsion family;\n"
+       << "                 three_center and four_center support the electron\n"
+       << "                 repulsion family (erf/erfc kernels take omega, alpha,\n"
+       << "                 beta and compute alpha/r + beta erf(c)(omega r)/r).\n"
        << "  hardware       target hardware (default cpu): cpu.\n"
        << "  language       target language (default C++): C++.\n"
        << "  storage_form   result container (default VeloxChemSparse).\n"
-       << "  signature      kernel signature (default VeloxChemScreened).\n";
+       << "  signature      kernel signature (default VeloxChemScreened).\n"
+       << "  precision      kernel precision (default fp64): fp64, fp32, or mixed\n"
+       << "                 (fp32 primitives accumulated into fp64 results). The\n"
+       << "                 legacy 'type' schema emits fp64 kernels only and\n"
+       << "                 rejects any other precision.\n"
+       << "  kernel_form    HRR kernel form (default unrolled): unrolled, or\n"
+       << "                 templated (constexpr tables + compute<LA, LB>()).\n"
+       << "  eri_method     four-center ERI scheme (default obara_saika):\n"
+       << "                 obara_saika, rys (Rys quadrature), or auto (cheaper\n"
+       << "                 of the two per quadruple by operation count).\n";
 }
 
 /// Reads the 'geom' key as a fixed-arity array, validating its length.
@@ -144,6 +213,179 @@ read_rec_form(const cfg::Config& config)
     return {values[0] != 0, values[1] != 0};
 }
 
+/// Reads the 'prim_screening' key as a screening threshold exponent.
+/// @param config The parsed configuration.
+/// @return The exponent n of threshold 1.0e-n (0, i.e. no screening, when absent).
+int
+read_prim_screening(const cfg::Config& config)
+{
+    const auto value = config.get_int("prim_screening", 0);
+
+    if (value < 0)
+    {
+        throw cfg::ConfigError("config: 'prim_screening' must be non-negative, got " +
+                               std::to_string(value));
+    }
+
+    return value;
+}
+
+/// Reads the 'point_batch' key as a number of external Gaussians per SIMD lane batch.
+/// @param config The parsed configuration.
+/// @return The number of points in batch (0, i.e. no point-batched kernels, when absent).
+int
+read_point_batch(const cfg::Config& config)
+{
+    const auto value = config.get_int("point_batch", 0);
+
+    if (value < 0)
+    {
+        throw cfg::ConfigError("config: 'point_batch' must be non-negative, got " +
+                               std::to_string(value));
+    }
+
+    return value;
+}
+
+/// Reads the 'grid_screening' key as a screening threshold exponent.
+/// @param config The parsed configuration.
+/// @return The exponent n of threshold 1.0e-n (0, i.e. no screening, when absent).
+int
+read_grid_screening(const cfg::Config& config)
+{
+    const auto value = config.get_int("grid_screening", 0);
+
+    if (value < 0)
+    {
+        throw cfg::ConfigError("config: 'grid_screening' must be non-negative, got " +
+                               std::to_string(value));
+    }
+
+    return value;
+}
+
+/// Reads the 'jobs' key as the maximum number of concurrent runs.
+/// @param config The parsed configuration.
+/// @return The number of jobs (the number of hardware threads when absent).
+int
+read_jobs(const cfg::Config& config)
+{
+    const auto value = config.get_int("jobs", std::max(1, static_cast<int>(std::thread::hardware_concurrency())));
+
+    if (value < 1)
+    {
+        throw cfg::ConfigError("config: 'jobs' must be positive, got " + std::to_string(value));
+    }
+
+    return value;
+}
+
+/// Gets the scheduling lane of a run. Runs of one generator family emit
+/// overlapping files (e.g. t4c_cpu, t4c_diag_cpu and t4c_geom_cpu all write
+/// the shared t4c HRR kernels), so every legacy type of a family (the prefix
+/// before the first '_', e.g. t4c) shares one lane. New-style runs are keyed
+/// on the parsed integral or recursion type, so that spellings such as
+/// "four_center" and "4c" share a lane.
+/// @param config The run configuration.
+/// @return The lane label.
+std::string
+run_lane(const cfg::Config& config)
+{
+    if (config.has("integral_type") || config.has("recursion_type"))
+    {
+        try
+        {
+            const auto run_config = cfg::make_run_configuration(config);
+
+            if (run_config.integral_type) return "integral_type = " + cfg::to_string(*run_config.integral_type);
+
+            return "recursion_type = " + cfg::to_string(*run_config.recursion_type);
+        }
+        catch (const cfg::ConfigError&)
+        {
+            // an invalid run fails validation before writing any file, so any lane will do
+
+            return "invalid";
+        }
+    }
+
+    const auto type = config.get_string("type", "");
+
+    return "type = " + type.substr(0, type.find('_')) + "*";
+}
+
+/// Stream buffer collecting the output of each thread separately, so that the
+/// output of concurrently executing runs can be written out as whole blocks.
+/// No put area is set, so the shared state of the buffer is never modified.
+class RunOutputBuffer : public std::streambuf
+{
+   public:
+    /// Takes the output collected on the calling thread.
+    /// @return The collected output.
+    std::string
+    take()
+    {
+        return std::exchange(_text(), std::string());
+    }
+
+   protected:
+    int_type
+    overflow(int_type ch) override
+    {
+        if (!traits_type::eq_int_type(ch, traits_type::eof())) _text().push_back(traits_type::to_char_type(ch));
+
+        return traits_type::not_eof(ch);
+    }
+
+    std::streamsize
+    xsputn(const char* chars, std::streamsize nchars) override
+    {
+        _text().append(chars, static_cast<std::size_t>(nchars));
+
+        return nchars;
+    }
+
+   private:
+    /// Gets the output of the calling thread collected by this buffer.
+    std::string&
+    _text()
+    {
+        thread_local std::map<const RunOutputBuffer*, std::string> texts;
+
+        return texts[this];
+    }
+};
+
+/// Redirects a stream into a run output buffer for the lifetime of the guard.
+class RunOutputGuard
+{
+    std::ostream& _stream;
+
+    std::streambuf* _target;
+
+   public:
+    /// Creates a guard redirecting a stream.
+    /// @param stream The redirected stream.
+    /// @param buffer The buffer collecting the output.
+    RunOutputGuard(std::ostream& stream, RunOutputBuffer& buffer) : _stream(stream), _target(stream.rdbuf(&buffer)) {}
+
+    RunOutputGuard(const RunOutputGuard&) = delete;
+
+    RunOutputGuard& operator=(const RunOutputGuard&) = delete;
+
+    ~RunOutputGuard() { _stream.rdbuf(_target); }
+
+    /// Writes text to the original buffer of the stream.
+    /// @param text The text to write.
+    void
+    write(const std::string& text)
+    {
+        _target->sputn(text.data(), static_cast<std::streamsize>(text.size()));
+
+        _target->pubsync();
+    }
+};
+
 /// True if every geometric-derivative order is zero (i.e. a plain integral run).
 template <std::size_t N>
 bool
@@ -179,7 +421,10 @@ describe(const cfg::RunConfiguration& run_config)
               << "  ang_mom       = [" << run_config.min_ang_mom << ", "
               << run_config.max_ang_mom << "]\n"
               << "  storage_form  = " << cfg::to_string(run_config.storage_form) << "\n"
-              << "  signature     = " << cfg::to_string(run_config.signature) << "\n";
+              << "  signature     = " << cfg::to_string(run_config.signature) << "\n"
+              << "  precision     = " << cfg::to_string(run_config.precision) << "\n"
+              << "  kernel_form   = " << cfg::to_string(run_config.kernel_form) << "\n"
+              << "  eri_method    = " << cfg::to_string(run_config.eri_method) << "\n";
 }
 
 /// Dispatches a parsed configuration to the matching code generator.
@@ -189,8 +434,7 @@ int
 run(const cfg::Config& config)
 {
     // new-style configuration: an integral_type or recursion_type key selects the
-    // orthogonal-field schema. Not every generator is wired in yet; validate and
-    // report.
+    // orthogonal-field schema, generated through the libltm interface.
 
     if (config.has("integral_type") || config.has("recursion_type"))
     {
@@ -198,40 +442,17 @@ run(const cfg::Config& config)
 
         describe(run_config);
 
-        if (run_config.recursion_type)
-        {
-            switch (*run_config.recursion_type)
-            {
-                case cfg::RecursionType::hrr_bra_ket:
-                case cfg::RecursionType::hrr_bra:
-                case cfg::RecursionType::hrr_ket:
-                    TwoCenterHrrGenerator().generate(run_config);
-                    return 0;
-
-                case cfg::RecursionType::vrr_cartesian:
-                case cfg::RecursionType::vrr_spherical:
-                    TwoCenterVrrGenerator().generate(run_config);
-                    return 0;
-            }
-        }
+        ost::DirectorySink sink;
 
-        switch (*run_config.integral_type)
-        {
-            case cfg::IntegralType::two_center:
-                TwoCenterGenerator().generate(run_config);
-                return 0;
-
-            case cfg::IntegralType::three_center:
-            case cfg::IntegralType::four_center:
-                std::cout << "litmus: configuration is valid; "
-                          << cfg::to_string(*run_config.integral_type)
-                          << " generators are not wired in yet." << std::endl;
-                return 0;
-        }
+        ltm::generate(run_config, sink);
+
+        return 0;
     }
 
     const auto type = config.get_string("type");
 
+    cfg::check_legacy_precision(config, type);
+
     const auto integral = config.get_string("integral", "none");
 
     const auto lmax = config.get_int("lmax", 0);
@@ -246,13 +467,32 @@ run(const cfg::Config& config)
 
         const auto use_rs = config.get_bool("use_rs", false);
 
+        const auto prim_screening = read_prim_screening(config);
+
+        const auto trans_inv = config.get_bool("trans_inv", false);
+
+        const auto point_batch = read_point_batch(config);
+
+        if ((point_batch > 0) &&
+            ((fstr::lowercase(integral).rfind("three center", 0) != 0) || ((geom[0] + geom[2]) != 0) ||
+             !rec_form.first || rec_form.second || use_rs))
+        {
+            throw cfg::ConfigError("config: 'point_batch' applies to three center t2c_cpu integrals "
+                                   "without 'geom' on bra or ket, in summation rec_form, without 'use_rs'");
+        }
+
+        if (trans_inv && ((geom[1] != 0) || ((geom[0] + geom[2]) != 1)))
+        {
+            throw cfg::ConfigError("config: 'trans_inv' applies to t2c_cpu 'geom' [1, 0, 0] or [0, 0, 1]");
+        }
+
         if ((geom[0] + geom[2]) == 0)
         {
-            T2CCPUGenerator().generate(integral, lmax, geom, rec_form, use_rs);
+            T2CCPUGenerator().generate(integral, lmax, geom, rec_form, use_rs, prim_screening, point_batch);
         }
         else
         {
-            T2CGeomCPUGenerator().generate(integral, lmax, geom, rec_form, use_rs);
+            T2CGeomCPUGenerator().generate(integral, lmax, geom, rec_form, use_rs, prim_screening, trans_inv);
         }
 
         return 0;
@@ -278,13 +518,66 @@ run(const cfg::Config& config)
     {
         const auto geom = read_geom<5>(config, type);
 
-        if (is_plain(geom))
+        const auto prim_screening = read_prim_screening(config);
+
+        if (config.get_bool("fuse_hessian", false))
+        {
+            if (!is_plain(geom))
+            {
+                throw cfg::ConfigError("config: 'fuse_hessian' emits all first and second derivative "
+                                       "patterns and cannot be combined with 'geom'");
+            }
+
+            if (config.get_bool("flat_ket_lanes", false))
+            {
+                throw cfg::ConfigError("config: 'fuse_hessian' cannot be combined with 'flat_ket_lanes'");
+            }
+
+            if (config.get_bool("jk_accumulate", false))
+            {
+                throw cfg::ConfigError("config: 'fuse_hessian' cannot be combined with 'jk_accumulate'");
+            }
+
+            T4CGeomCPUGenerator().generate_hessian(integral, lmax, prim_screening);
+        }
+        else if (config.get_bool("flat_ket_lanes", false))
         {
+            if (is_plain(geom))
+            {
+                throw cfg::ConfigError("config: 'flat_ket_lanes' applies to geometric derivative "
+                                       "kernels and requires a non-zero 'geom'");
+            }
+
+            if (config.get_bool("jk_accumulate", false))
+            {
+                throw cfg::ConfigError("config: 'flat_ket_lanes' cannot be combined with 'jk_accumulate'");
+            }
+
+            T4CGeomCPUGenerator().generate_flat(integral, lmax, geom, prim_screening);
+        }
+        else if (config.get_bool("jk_accumulate", false))
+        {
+            if (is_plain(geom))
+            {
+                throw cfg::ConfigError("config: 'jk_accumulate' applies to geometric derivative "
+                                       "kernels and requires a non-zero 'geom'");
+            }
+
+            T4CGeomCPUGenerator().generate_jk(integral, lmax, geom, prim_screening);
+        }
+        else if (is_plain(geom))
+        {
+            if (prim_screening > 0)
+            {
+                throw cfg::ConfigError("config: 'prim_screening' applies to geometric derivative "
+                                       "kernels of t4c_cpu and requires a non-zero 'geom'");
+            }
+
             T4CCPUGenerator().generate(integral, lmax);
         }
         else
         {
-            T4CGeomCPUGenerator().generate(integral, lmax, geom);
+            T4CGeomCPUGenerator().generate(integral, lmax, geom, prim_screening);
         }
 
         return 0;
@@ -313,7 +606,15 @@ run(const cfg::Config& config)
 
     if (type == "t4c_call_tree")
     {
-        T4CCallTreeGenerator().generate(integral, lmax);
+        const auto geom_order = config.get_int("geom_order", 0);
+
+        if (geom_order < 0)
+        {
+            throw cfg::ConfigError("config: 'geom_order' must be non-negative, got " +
+                                   std::to_string(geom_order));
+        }
+
+        T4CCallTreeGenerator().generate(integral, lmax, geom_order);
 
         return 0;
     }
@@ -355,9 +656,18 @@ run(const cfg::Config& config)
 
         const auto use_rs = config.get_bool("use_rs", false);
 
+        const auto grid_batch = config.get_bool("grid_batch", false);
+
+        const auto grid_screening = read_grid_screening(config);
+
+        if ((grid_screening > 0) && (!grid_batch))
+        {
+            throw cfg::ConfigError("config: 'grid_screening' requires 'grid_batch = true'");
+        }
+
         if (is_plain(geom))
         {
-            G2CCPUGenerator().generate(integral, lmax, geom, use_rs);
+            G2CCPUGenerator().generate(integral, lmax, geom, use_rs, grid_batch, grid_screening);
 
             return 0;
         }
@@ -389,9 +699,17 @@ run(const cfg::Config& config)
 
         const auto proj_lmax = config.get_int("proj_lmax", 0);
 
+        const auto angular_tables = config.get_bool("angular_tables", false);
+
+        if (angular_tables && (!is_plain(geom)))
+        {
+            throw cfg::ConfigError("config: 'angular_tables' drives plain projected ECP kernels only "
+                                   "and cannot be combined with 'geom'");
+        }
+
         if (is_plain(geom))
         {
-            T2CProjECPCPUGenerator().generate(integral, lmax, proj_lmax);
+            T2CProjECPCPUGenerator().generate(integral, lmax, proj_lmax, angular_tables);
         }
         else
         {
@@ -416,6 +734,125 @@ run(const cfg::Config& config)
     return 1;
 }
 
+/// Executes the runs of a multi-run configuration on a pool of worker threads.
+/// Runs within a lane execute in declaration order; lanes execute concurrently.
+/// The standard and error output of each run is collected and written out as
+/// one block when the run completes.
+/// @param runs The run configurations.
+/// @param jobs The maximum number of concurrently executing runs.
+/// @return The process exit code (0 if every run succeeded, 1 otherwise).
+int
+run_all(const std::vector<cfg::Config>& runs, const int jobs)
+{
+    std::vector<std::vector<std::size_t>> lanes;
+
+    std::map<std::string, std::size_t> lane_indices;
+
+    for (std::size_t i = 0; i < runs.size(); i++)
+    {
+        const auto [it, added] = lane_indices.emplace(run_lane(runs[i]), lanes.size());
+
+        if (added) lanes.emplace_back();
+
+        lanes[it->second].push_back(i);
+    }
+
+    std::vector<int> codes(runs.size(), 1);
+
+    std::atomic<std::size_t> next_lane{0};
+
+    std::mutex output_mutex;
+
+    RunOutputBuffer out_buffer, err_buffer;
+
+    RunOutputGuard out_guard(std::cout, out_buffer);
+
+    RunOutputGuard err_guard(std::cerr, err_buffer);
+
+    const auto worker = [&]() {
+        for (auto lane = next_lane++; lane < lanes.size(); lane = next_lane++)
+        {
+            for (const auto irun : lanes[lane])
+            {
+                try
+                {
+                    codes[irun] = run(runs[irun]);
+                }
+                catch (const std::exception& error)
+                {
+                    std::cerr << "litmus: run " << irun + 1 << ": " << error.what() << std::endl;
+                }
+
+                std::lock_guard<std::mutex> lock(output_mutex);
+
+                out_guard.write(out_buffer.take());
+
+                err_guard.write(err_buffer.take());
+            }
+        }
+    };
+
+    const auto nthreads = std::min(static_cast<std::size_t>(jobs), lanes.size());
+
+    std::vector<std::thread> threads;
+
+    for (std::size_t i = 1; i < nthreads; i++) threads.emplace_back(worker);
+
+    worker();
+
+    for (auto& thread : threads) thread.join();
+
+    const auto failed = std::count_if(codes.begin(), codes.end(), [](const int code) { return code != 0; });
+
+    return (failed == 0) ? 0 : 1;
+}
+
+/// Deduplicates the kernel definitions among the .cpp files of a directory.
+/// Kernels whose normalized bodies match an earlier kernel (in file-name order)
+/// are rewritten in place as forwarding definitions, and a report is printed.
+/// @param directory The directory holding generated files.
+/// @return The process exit code (0 on success, 1 if the directory is missing).
+int
+dedup(const std::string& directory)
+{
+    if (!std::filesystem::is_directory(directory))
+    {
+        std::cerr << "litmus: '" << directory << "' is not a directory." << std::endl;
+
+        return 1;
+    }
+
+    std::vector<std::filesystem::path> paths;
+
+    for (const auto& entry : std::filesystem::directory_iterator(directory))
+    {
+        if (entry.is_regular_file() && (entry.path().extension() == ".cpp")) paths.push_back(entry.path());
+    }
+
+    std::sort(paths.begin(), paths.end());
+
+    ost::KernelRegistry registry;
+
+    for (const auto& path : paths)
+    {
+        std::ifstream fstream(path);
+
+        std::stringstream buffer;
+
+        buffer << fstream.rdbuf();
+
+        registry.add({path.filename().string(), buffer.str()});
+    }
+
+    ost::DirectorySink sink(directory);
+
+    for (const auto& file : registry.forwarded_files()) sink.write(file);
+
+    std::cout << registry.report();
+
+    return 0;
+}
+
 }  // namespace
 
 int
@@ -430,9 +867,11 @@ main(int argc, char** argv)
         return args.empty() ? 1 : 0;
     }
 
+    if ((args[0] == "dedup") && (args.size() == 2)) return dedup(args[1]);
+
     if ((args[0] != "run") || (args.size() != 2))
     {
-        std::cerr << "litmus: expected 'litmus run <config-file>'.\n\n";
+        std::cerr << "litmus: expected 'litmus run <config-file>' or 'litmus dedup <directory>'.\n\n";
 
         print_usage(std::cerr);
 
@@ -443,9 +882,11 @@ main(int argc, char** argv)
     {
         const auto config = cfg::parse_file(args[1]);
 
+        const auto runs = config.runs();
+
         const auto stime = std::chrono::high_resolution_clock::now();
 
-        const auto rc = run(config);
+        const auto rc = (runs.size() == 1) ? run(runs[0]) : run_all(runs, read_jobs(config));
 
         const auto etime = std::chrono::high_resolution_clock::now();
 
@@ -459,6 +900,12 @@ main(int argc, char** argv)
     {
         std::cerr << "litmus: " << error.what() << std::endl;
 
+        return 1;
+    }
+    catch (const std::exception& error)
+    {
+        std::cerr << "litmus: " << error.what() << std::endl;
+
         return 1;
     }
 }
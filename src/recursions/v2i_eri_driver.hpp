@@ -30,6 +30,7 @@ public:
     V2IElectronRepulsionDriver() = default;
     
     /// Check if integral is for two-center nuclear potential integral.
+    /// The erf and erfc attenuated Coulomb operators are accepted as well.
     /// @param integral The integral to check.
     /// @return True if reccursion expansion belongs to overlap recursion, False otherwise.
     bool is_electron_repulsion(const I2CIntegral& integral) const;
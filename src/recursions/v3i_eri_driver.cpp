@@ -24,7 +24,14 @@ V3IElectronRepulsionDriver::is_electron_repulsion(const I3CIntegral& integral) c
         return false;
     }
     
-    if (integral.integrand() != Operator("1/|r-r'|"))
+    // the erf/erfc attenuated operators share the Coulomb recursion: the
+    // attenuation is folded into the order-indexed (ss|ss)^m seeds
+    
+    const auto integrand = integral.integrand();
+    
+    if ((integrand != Operator("1/|r-r'|")) &&
+        (integrand != Operator("erf(w|r-r'|)/|r-r'|")) &&
+        (integrand != Operator("erfc(w|r-r'|)/|r-r'|")))
     {
         return false;
     }
@@ -30,6 +30,7 @@ public:
     V3IElectronRepulsionDriver() = default;
     
     /// Check if integral is for four-center electron repulsion integral.
+    /// The erf and erfc attenuated Coulomb operators are accepted as well.
     /// @param integral The integral to check.
     /// @return True if reccursion expansion belongs to electron repulsion recursion, False otherwise.
     bool is_electron_repulsion(const I3CIntegral& integral) const;
@@ -156,3 +156,29 @@ TEST(IntegralTest, DiagComponentsPairEqualShells)
 
     EXPECT_EQ(comps.size(), 3u);
 }
+
+TEST(IntegralTest, LazyComponentsMatchComponentsVector)
+{
+    // prefixes vary slowest (the last prefix fastest), then the integrand, bra, ket.
+    const auto integral = TwoCenter(OneCenter("a", 2), OneCenter("b", 1), Operator("X", Tensor(1)), 1,
+                                    {prefix_op(1), prefix_op(2)});
+
+    EXPECT_EQ(integral.number_of_components(), 3 * 6 * 3 * 6 * 3);
+
+    const auto comps = integral.components<OneCenterComponent, OneCenterComponent>();
+
+    ASSERT_EQ(comps.size(), static_cast<size_t>(integral.number_of_components()));
+
+    size_t i = 0;
+    for (const auto& tcomp : integral.component_range<OneCenterComponent, OneCenterComponent>())
+    {
+        EXPECT_EQ(tcomp, comps[i]) << i;
+        i++;
+    }
+    EXPECT_EQ(i, comps.size());
+
+    // a view over a temporary keeps its own copy of the integral.
+    const auto range = make_integral(1, 1).component_range<OneCenterComponent, OneCenterComponent>();
+    EXPECT_EQ(range.size(), 9u);
+    EXPECT_EQ(range[4], (make_integral(1, 1).components<OneCenterComponent, OneCenterComponent>()[4]));
+}
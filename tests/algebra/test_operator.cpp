@@ -51,3 +51,14 @@ TEST(OperatorTest, ComponentCountMatchesShape)
     EXPECT_EQ(Operator("X", Tensor(0)).components().size(), 1u);
     EXPECT_EQ(Operator("X", Tensor(1)).components().size(), 3u);
 }
+
+TEST(OperatorTest, LazyComponentsMatchComponentsVector)
+{
+    const auto op    = Operator("d/dA", Tensor(2), "bra", 0);
+    const auto comps = op.components();
+
+    ASSERT_EQ(op.number_of_components(), 6);
+    ASSERT_EQ(op.component_range().size(), comps.size());
+
+    for (int i = 0; i < 6; i++) EXPECT_EQ(op.component_range()[i], comps[i]);
+}
@@ -284,3 +284,42 @@ TEST(SphericalHarmonicsTest, TwoCenterTransformOutOfRangeIsEmpty)
     EXPECT_TRUE(two_center_spherical_factors(1, 2, 0, 5).empty());  // ket index > 2*lb
     EXPECT_TRUE(two_center_spherical_factors(-1, 2, 0, 0).empty());
 }
+
+TEST(SphericalHarmonicsTest, AngularIntegralsAreOrthonormal)
+{
+    const auto one = TensorComponent(0, 0, 0);
+
+    for (int l = 0; l <= 3; l++)
+    {
+        for (int m = -l; m <= l; m++)
+        {
+            for (int lambda = 0; lambda <= 3; lambda++)
+            {
+                for (int mu = -lambda; mu <= lambda; mu++)
+                {
+                    const auto expected = ((l == lambda) && (m == mu)) ? 1.0 : 0.0;
+
+                    EXPECT_NEAR(angular_integral(l, m, lambda, mu, one), expected, 1.0e-14);
+                }
+            }
+        }
+    }
+}
+
+TEST(SphericalHarmonicsTest, AngularIntegralsWithMonomials)
+{
+    // int Y_00 Y_10 z dOmega = 1 / sqrt(3), and u_z moves Y_10 onto Y_00 and Y_20 only.
+    EXPECT_NEAR(angular_integral(0, 0, 1, 0, TensorComponent(0, 0, 1)), 1.0 / std::sqrt(3.0), 1.0e-15);
+    EXPECT_NEAR(angular_integral(2, 0, 1, 0, TensorComponent(0, 0, 1)), 2.0 / std::sqrt(15.0), 1.0e-15);
+    EXPECT_EQ(angular_integral(1, 0, 1, 0, TensorComponent(0, 0, 1)), 0.0);
+    EXPECT_EQ(angular_integral(3, 0, 1, 0, TensorComponent(0, 0, 1)), 0.0);
+
+    // u_x^2 + u_y^2 + u_z^2 = 1 on the unit sphere.
+    const auto rsq = angular_integral(2, 1, 2, 1, TensorComponent(2, 0, 0)) +
+                     angular_integral(2, 1, 2, 1, TensorComponent(0, 2, 0)) +
+                     angular_integral(2, 1, 2, 1, TensorComponent(0, 0, 2));
+    EXPECT_NEAR(rsq, 1.0, 1.0e-14);
+
+    // out-of-range orders give zero.
+    EXPECT_EQ(angular_integral(1, 2, 1, 0, TensorComponent(0, 0, 0)), 0.0);
+}
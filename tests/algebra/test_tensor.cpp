@@ -53,3 +53,23 @@ TEST(TensorTest, Equality)
     EXPECT_EQ(Tensor(2), Tensor(TensorComponent(1, 1, 0)));
     EXPECT_NE(Tensor(1), Tensor(2));
 }
+
+TEST(TensorTest, LazyComponentsMatchComponentsVector)
+{
+    // closed-form count and index access agree with the recursive build.
+    for (int order = 0; order <= 8; order++)
+    {
+        const auto tensor = Tensor(order);
+        const auto comps  = tensor.components();
+
+        ASSERT_EQ(static_cast<size_t>(tensor.number_of_components()), comps.size());
+
+        size_t i = 0;
+        for (const auto tcomp : tensor.component_range())
+        {
+            EXPECT_EQ(tcomp, comps[i]) << order << " " << i;
+            i++;
+        }
+        EXPECT_EQ(i, comps.size());
+    }
+}
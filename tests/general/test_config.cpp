@@ -137,3 +137,46 @@ TEST(ConfigTest, MissingFileThrows)
 {
     EXPECT_THROW(cfg::parse_file("/nonexistent/litmus/run.toml"), ConfigError);
 }
+
+TEST(ConfigTest, PlainConfigIsSingleRun)
+{
+    const auto runs = cfg::parse_string("type = t4c_cpu\nlmax = 2").runs();
+
+    ASSERT_EQ(runs.size(), 1u);
+    EXPECT_EQ(runs[0].get_string("type"), "t4c_cpu");
+    EXPECT_EQ(runs[0].get_int("lmax"), 2);
+}
+
+TEST(ConfigTest, RunTablesInheritTopLevelKeys)
+{
+    const auto config = cfg::parse_string(R"(
+        integral = "electron repulsion"
+        lmax     = 2
+
+        [[run]]
+        type = "t4c_cpu"
+
+        [[run]]      # overrides the shared lmax
+        type = "t4c_diag_cpu"
+        lmax = 4
+    )");
+
+    const auto runs = config.runs();
+
+    ASSERT_EQ(runs.size(), 2u);
+    EXPECT_EQ(runs[0].get_string("type"), "t4c_cpu");
+    EXPECT_EQ(runs[0].get_string("integral"), "electron repulsion");
+    EXPECT_EQ(runs[0].get_int("lmax"), 2);
+    EXPECT_EQ(runs[1].get_string("type"), "t4c_diag_cpu");
+    EXPECT_EQ(runs[1].get_string("integral"), "electron repulsion");
+    EXPECT_EQ(runs[1].get_int("lmax"), 4);
+
+    // run tables do not leak into the top-level table
+    EXPECT_FALSE(config.has("type"));
+}
+
+TEST(ConfigTest, UnsupportedTableHeaderThrows)
+{
+    EXPECT_THROW(cfg::parse_string("[run]\ntype = t2c_cpu"), ConfigError);
+    EXPECT_THROW(cfg::parse_string("[[job]]\ntype = t2c_cpu"), ConfigError);
+}
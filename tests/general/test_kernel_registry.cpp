@@ -0,0 +1,96 @@
+// LITMUS: An Automated Molecular Integrals Generator
+// Copyright 2022 Z. Rinkevicius, KTH, Sweden.
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "kernel_registry.hpp"
+
+namespace {
+
+// A single-kernel definition file in the layout the generators emit.
+ost::GeneratedFile
+kernel_file(const std::string& stem, const std::string& ns, const std::string& name,
+            const std::string& param, const std::string& body)
+{
+    return {stem + ".cpp",
+            "#include \"" + stem + ".hpp\"\n\n"
+            "namespace " + ns + " { // " + ns + " namespace\n\n"
+            "auto\n" + name + "(CSimdArray<double>& pbuffer,\n"
+            "    const size_t " + param + ") -> void\n"
+            "{\n" + body + "}\n\n"
+            "} // " + ns + " namespace\n"};
+}
+
+}  // namespace
+
+TEST(KernelRegistryTest, ForwardsKernelsEqualUpToNames)
+{
+    ost::KernelRegistry registry;
+
+    // same body up to kernel, parameter, and local names (and comments)
+    registry.add(kernel_file("RecPS", "ovlrec", "comp_ps", "idx_rpa",
+                             "    // R(PA)\n    auto pa_x = pbuffer.data(idx_rpa);\n    pa_x[0] = 2.0;\n"));
+    registry.add(kernel_file("RecSP", "ovlrec", "comp_sp", "idx_rpb",
+                             "    // R(PB)\n    auto pb_x = pbuffer.data(idx_rpb);\n    pb_x[0] = 2.0;\n"));
+
+    // a different constant is a different kernel
+    registry.add(kernel_file("RecSD", "ovlrec", "comp_sd", "idx_rpb",
+                             "    auto pb_x = pbuffer.data(idx_rpb);\n    pb_x[0] = 3.0;\n"));
+
+    EXPECT_EQ(registry.number_of_kernels(), 3u);
+    EXPECT_EQ(registry.number_of_duplicates(), 1u);
+
+    const auto files = registry.forwarded_files();
+
+    ASSERT_EQ(files.size(), 1u);
+    EXPECT_EQ(files[0].name, "RecSP.cpp");
+    EXPECT_NE(files[0].content.find("#include \"RecPS.hpp\""), std::string::npos);
+    EXPECT_NE(files[0].content.find("comp_sp(CSimdArray<double>& pbuffer,"), std::string::npos);
+    EXPECT_NE(files[0].content.find("ovlrec::comp_ps(pbuffer, idx_rpb);"), std::string::npos);
+    EXPECT_EQ(files[0].content.find("return"), std::string::npos);
+
+    EXPECT_NE(registry.report().find("RecPS.cpp <- RecSP.cpp"), std::string::npos);
+}
+
+TEST(KernelRegistryTest, MatchesAcrossNamespacesOnlyWithoutLocalCalls)
+{
+    ost::KernelRegistry registry;
+
+    registry.add(kernel_file("OvlA", "ovlrec", "comp_a", "idx", "    pbuffer.data(idx)[0] = 1.0;\n"));
+    registry.add(kernel_file("KinA", "kinrec", "comp_a", "idx", "    pbuffer.data(idx)[0] = 1.0;\n"));
+
+    // an unqualified call resolves in the kernel's own namespace
+    registry.add(kernel_file("OvlB", "ovlrec", "comp_b", "idx", "    helper(pbuffer, idx);\n"));
+    registry.add(kernel_file("KinB", "kinrec", "comp_b", "idx", "    helper(pbuffer, idx);\n"));
+
+    const auto files = registry.forwarded_files();
+
+    ASSERT_EQ(files.size(), 1u);
+    EXPECT_EQ(files[0].name, "KinA.cpp");
+    EXPECT_NE(files[0].content.find("namespace kinrec {"), std::string::npos);
+    EXPECT_NE(files[0].content.find("ovlrec::comp_a(pbuffer, idx);"), std::string::npos);
+}
+
+TEST(KernelRegistryTest, PassesThroughNonKernelFiles)
+{
+    ost::KernelRegistry registry;
+
+    registry.add({"Kernel.hpp", "auto\nf(int x) -> void;\n"});
+    registry.add({"Empty.cpp", "namespace t4c_geom { // t4c_geom namespace\n\n} // t4c_geom namespace\n"});
+    registry.add({"Unnamed.cpp", "auto\nf(const size_t) -> void\n{\n}\n"});
+
+    EXPECT_EQ(registry.number_of_kernels(), 0u);
+
+    const auto files = registry.files();
+
+    ASSERT_EQ(files.size(), 3u);
+    EXPECT_EQ(files[0].content, "auto\nf(int x) -> void;\n");
+}
+
+TEST(KernelRegistryTest, HashIsFnv1a)
+{
+    EXPECT_EQ(ost::fnv1a_hash(""), 14695981039346656037ULL);
+    EXPECT_EQ(ost::fnv1a_hash("a"), 0xaf63dc4c8601ec8cULL);
+}
@@ -0,0 +1,54 @@
+// LITMUS: An Automated Molecular Integrals Generator
+// Copyright 2022 Z. Rinkevicius, KTH, Sweden.
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#include "output_sink.hpp"
+
+TEST(OutputSinkTest, MemorySinkKeepsFirstWriteOrder)
+{
+    ost::MemorySink sink;
+
+    sink.write({"a.hpp", "first"});
+    sink.write({"b.cpp", "second"});
+    sink.write({"a.hpp", "rewritten"});
+
+    const auto files = sink.files();
+
+    ASSERT_EQ(files.size(), 2u);
+    EXPECT_EQ(files[0].name, "a.hpp");
+    EXPECT_EQ(files[0].content, "rewritten");
+    EXPECT_EQ(files[1].name, "b.cpp");
+    EXPECT_EQ(files[1].content, "second");
+}
+
+TEST(OutputSinkTest, DirectorySinkWritesIntoDirectory)
+{
+    const auto dir = std::filesystem::path(testing::TempDir()) / "litmus_output_sink";
+
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+
+    ost::DirectorySink sink(dir.string());
+
+    sink.write({"kernel.hpp", "// kernel\n"});
+
+    std::ifstream in(dir / "kernel.hpp");
+    std::stringstream buffer;
+    buffer << in.rdbuf();
+
+    EXPECT_EQ(buffer.str(), "// kernel\n");
+}
+
+TEST(OutputSinkTest, DirectorySinkThrowsOnMissingDirectory)
+{
+    ost::DirectorySink sink("/nonexistent/litmus/output");
+
+    EXPECT_THROW(sink.write({"kernel.hpp", ""}), std::runtime_error);
+}
@@ -0,0 +1,184 @@
+// LITMUS: An Automated Molecular Integrals Generator
+// Copyright 2022 Z. Rinkevicius, KTH, Sweden.
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <string>
+
+#include "reference_integrals.hpp"
+
+using refint::Primitive;
+
+namespace {
+
+constexpr long double pi = 3.141592653589793238462643383279502884L;
+
+Primitive
+s_primitive(const long double exponent, const std::array<long double, 3>& center)
+{
+    Primitive prim;
+    prim.exponent = exponent;
+    prim.center   = center;
+    return prim;
+}
+
+// Central finite difference of an integral along one center coordinate.
+template <std::size_t N, class F>
+long double
+finite_difference(const F& func, std::array<Primitive, N> prims, const std::size_t index, const int axis)
+{
+    const long double step = 1.0e-5L;
+
+    prims[index].center[axis] += step;
+    const auto upper = func(prims);
+
+    prims[index].center[axis] -= 2.0L * step;
+    const auto lower = func(prims);
+
+    return (upper - lower) / (2.0L * step);
+}
+
+}  // namespace
+
+TEST(ReferenceIntegralsTest, BoysFunctionLimits)
+{
+    // F_n(0) = 1 / (2n + 1)
+    EXPECT_NEAR(static_cast<double>(refint::boys_function(0, 0.0L)), 1.0, 1.0e-15);
+    EXPECT_NEAR(static_cast<double>(refint::boys_function(3, 0.0L)), 1.0 / 7.0, 1.0e-15);
+
+    // F_0(t) = sqrt(pi / t) erf(sqrt(t)) / 2 on both sides of the series cutoff
+    for (const auto t : {0.5L, 12.0L, 49.9L, 50.1L, 300.0L})
+    {
+        const auto ref = 0.5L * std::sqrt(pi / t) * std::erf(std::sqrt(t));
+        EXPECT_NEAR(static_cast<double>(refint::boys_function(0, t)), static_cast<double>(ref), 1.0e-15) << t;
+    }
+
+    // downward relation F_n = (2t F_{n+1} + exp(-t)) / (2n + 1)
+    for (const auto t : {0.3L, 20.0L, 80.0L})
+    {
+        const auto lhs = refint::boys_function(4, t);
+        const auto rhs = (2.0L * t * refint::boys_function(5, t) + std::exp(-t)) / 9.0L;
+        EXPECT_NEAR(static_cast<double>(lhs / rhs), 1.0, 1.0e-15) << t;
+    }
+}
+
+TEST(ReferenceIntegralsTest, SShellClosedForms)
+{
+    const auto a = s_primitive(0.8L, {0.0L, 0.0L, 0.0L});
+    const auto b = s_primitive(1.3L, {0.4L, -0.2L, 0.9L});
+
+    const auto p   = a.exponent + b.exponent;
+    const auto mu  = a.exponent * b.exponent / p;
+    const auto r2  = 0.4L * 0.4L + 0.2L * 0.2L + 0.9L * 0.9L;
+    const auto sab = std::pow(pi / p, 1.5L) * std::exp(-mu * r2);
+
+    EXPECT_NEAR(static_cast<double>(refint::overlap({a, b})), static_cast<double>(sab), 1.0e-15);
+
+    // (s|T|s) = mu (3 - 2 mu R^2) (s|s)
+    const auto tab = mu * (3.0L - 2.0L * mu * r2) * sab;
+    EXPECT_NEAR(static_cast<double>(refint::kinetic_energy({a, b})), static_cast<double>(tab), 1.0e-15);
+
+    // (s|1/|r-C||s) at C = P is 2 pi / p exp(-mu R^2)
+    std::array<long double, 3> pc;
+    for (int i = 0; i < 3; i++) pc[i] = (a.exponent * a.center[i] + b.exponent * b.center[i]) / p;
+    const auto vab = 2.0L * pi / p * std::exp(-mu * r2);
+    EXPECT_NEAR(static_cast<double>(refint::nuclear_potential({a, b}, pc)), static_cast<double>(vab), 1.0e-15);
+
+    // (ss|ss) with coincident product centers is 2 pi^5/2 / (p q sqrt(p + q)) K_ab K_cd
+    const auto eri = 2.0L * std::pow(pi, 2.5L) / (p * p * std::sqrt(2.0L * p)) * std::exp(-2.0L * mu * r2);
+    EXPECT_NEAR(static_cast<double>(refint::electron_repulsion({a, b, a, b})), static_cast<double>(eri), 1.0e-14);
+}
+
+TEST(ReferenceIntegralsTest, SymmetricUnderBraKetExchange)
+{
+    std::mt19937 engine(7);
+
+    for (int l = 0; l <= 3; l++)
+    {
+        const auto a = refint::random_primitive(engine, l);
+        const auto b = refint::random_primitive(engine, 2);
+        const auto c = refint::random_primitive(engine, 1);
+        const auto d = refint::random_primitive(engine, l);
+
+        EXPECT_NEAR(static_cast<double>(refint::overlap({a, b})), static_cast<double>(refint::overlap({b, a})), 1.0e-14);
+        EXPECT_NEAR(static_cast<double>(refint::kinetic_energy({a, b})), static_cast<double>(refint::kinetic_energy({b, a})), 1.0e-13);
+
+        const auto abcd = refint::electron_repulsion({a, b, c, d});
+        EXPECT_NEAR(static_cast<double>(abcd), static_cast<double>(refint::electron_repulsion({c, d, a, b})), 1.0e-13);
+        EXPECT_NEAR(static_cast<double>(abcd), static_cast<double>(refint::electron_repulsion({b, a, d, c})), 1.0e-13);
+    }
+}
+
+TEST(ReferenceIntegralsTest, GeomDerivativeMatchesFiniteDifference)
+{
+    std::mt19937 engine(11);
+
+    const auto ovl = [](const std::array<Primitive, 2>& prims) { return refint::overlap(prims); };
+    const auto eri = [](const std::array<Primitive, 4>& prims) { return refint::electron_repulsion(prims); };
+
+    const std::array<Primitive, 2> pair = {refint::random_primitive(engine, 2), refint::random_primitive(engine, 1)};
+
+    for (int axis = 0; axis < 3; axis++)
+    {
+        const auto drv = refint::geom_derivative(ovl, pair, {{0, axis}});
+        EXPECT_NEAR(static_cast<double>(drv), static_cast<double>(finite_difference(ovl, pair, 0, axis)), 1.0e-8);
+    }
+
+    const std::array<Primitive, 4> quad = {refint::random_primitive(engine, 1),
+                                           refint::random_primitive(engine, 0),
+                                           refint::random_primitive(engine, 2),
+                                           refint::random_primitive(engine, 1)};
+
+    const auto drv = refint::geom_derivative(eri, quad, {{2, 1}});
+    EXPECT_NEAR(static_cast<double>(drv), static_cast<double>(finite_difference(eri, quad, 2, 1)), 1.0e-8);
+}
+
+TEST(ReferenceIntegralsTest, GeomDerivativesAreTranslationallyInvariant)
+{
+    std::mt19937 engine(5);
+
+    const auto kin = [](const std::array<Primitive, 2>& prims) { return refint::kinetic_energy(prims); };
+    const auto eri = [](const std::array<Primitive, 4>& prims) { return refint::electron_repulsion(prims); };
+
+    const std::array<Primitive, 2> pair = {refint::random_primitive(engine, 1), refint::random_primitive(engine, 2)};
+
+    const auto ka = refint::geom_derivative(kin, pair, {{0, 2}});
+    const auto kb = refint::geom_derivative(kin, pair, {{1, 2}});
+    EXPECT_NEAR(static_cast<double>(ka + kb), 0.0, 1.0e-13);
+
+    const std::array<Primitive, 4> quad = {refint::random_primitive(engine, 1),
+                                           refint::random_primitive(engine, 1),
+                                           refint::random_primitive(engine, 0),
+                                           refint::random_primitive(engine, 2)};
+
+    long double sum = 0.0L;
+    for (std::size_t i = 0; i < 4; i++) sum += refint::geom_derivative(eri, quad, {{i, 0}});
+    EXPECT_NEAR(static_cast<double>(sum), 0.0, 1.0e-12);
+
+    // second derivatives: sum_B d^2/dA_x dB_x = 0 as well
+    long double hsum = 0.0L;
+    for (std::size_t i = 0; i < 4; i++) hsum += refint::geom_derivative(eri, quad, {{0, 0}, {i, 0}});
+    EXPECT_NEAR(static_cast<double>(hsum), 0.0, 1.0e-11);
+}
+
+TEST(ReferenceIntegralsTest, ErrorStatsReportAbsoluteAndUlpErrors)
+{
+    refint::ErrorStats stats;
+
+    stats.add(1.0, 1.0L);
+    EXPECT_EQ(stats.count(), 1u);
+    EXPECT_EQ(stats.max_abs(), 0.0);
+    EXPECT_EQ(stats.max_ulp(), 0.0);
+
+    // two ulps above 1.0
+    stats.add(1.0 + 2.0 * std::numeric_limits<double>::epsilon(), 1.0L);
+    EXPECT_EQ(stats.count(), 2u);
+    EXPECT_DOUBLE_EQ(stats.max_abs(), 2.0 * std::numeric_limits<double>::epsilon());
+    EXPECT_DOUBLE_EQ(stats.max_ulp(), 2.0);
+
+    EXPECT_NE(stats.summary().find("2 values"), std::string::npos);
+}
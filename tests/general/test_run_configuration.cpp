@@ -28,6 +28,7 @@ using cfg::Hardware;
 using cfg::IntegralType;
 using cfg::Language;
 using cfg::OperatorType;
+using cfg::Precision;
 using cfg::RecursionType;
 using cfg::Signature;
 using cfg::StorageForm;
@@ -50,6 +51,7 @@ TEST(RunConfigurationTest, AppliesDefaults)
     EXPECT_EQ(run_config.language, Language::cpp);
     EXPECT_EQ(run_config.storage_form, StorageForm::veloxchem_sparse);
     EXPECT_EQ(run_config.signature, Signature::veloxchem_screened);
+    EXPECT_EQ(run_config.precision, Precision::fp64);
 }
 
 TEST(RunConfigurationTest, ReadsAllExplicitFields)
@@ -156,6 +158,10 @@ TEST(RunConfigurationTest, ParsesEveryOperatorType)
         {"kinetic energy", OperatorType::kinetic_energy},
         {"nuclear_potential", OperatorType::nuclear_potential},
         {"electron repulsion", OperatorType::electron_repulsion},
+        {"long_range_electron_repulsion", OperatorType::long_range_electron_repulsion},
+        {"erf electron repulsion", OperatorType::long_range_electron_repulsion},
+        {"short range electron repulsion", OperatorType::short_range_electron_repulsion},
+        {"erfc_electron_repulsion", OperatorType::short_range_electron_repulsion},
         {"dipole_momentum", OperatorType::dipole_momentum},
         {"linear momentum", OperatorType::linear_momentum},
         {"local", OperatorType::local_ecp},
@@ -182,6 +188,8 @@ TEST(RunConfigurationTest, OperatorTypeToStringMatchesGeneratorLabels)
     EXPECT_EQ(cfg::to_string(OperatorType::kinetic_energy), "kinetic energy");
     EXPECT_EQ(cfg::to_string(OperatorType::nuclear_potential), "nuclear potential");
     EXPECT_EQ(cfg::to_string(OperatorType::electron_repulsion), "electron repulsion");
+    EXPECT_EQ(cfg::to_string(OperatorType::long_range_electron_repulsion), "long range electron repulsion");
+    EXPECT_EQ(cfg::to_string(OperatorType::short_range_electron_repulsion), "short range electron repulsion");
     EXPECT_EQ(cfg::to_string(OperatorType::dipole_momentum), "dipole momentum");
     EXPECT_EQ(cfg::to_string(OperatorType::linear_momentum), "linear momentum");
     EXPECT_EQ(cfg::to_string(OperatorType::local_ecp), "local");
@@ -210,6 +218,72 @@ TEST(RunConfigurationTest, UnknownEnumValuesThrow)
     EXPECT_THROW(bad("integral_type = \"two_center\"\nlanguage = \"rust\""), ConfigError);
     EXPECT_THROW(bad("integral_type = \"two_center\"\nstorage_form = \"dense\""), ConfigError);
     EXPECT_THROW(bad("integral_type = \"two_center\"\nsignature = \"plain\""), ConfigError);
+    EXPECT_THROW(bad("integral_type = \"two_center\"\nprecision = \"fp16\""), ConfigError);
+}
+
+TEST(RunConfigurationTest, ParsesPrecisionAndValueTypes)
+{
+    const auto precision_of = [](const std::string& value) {
+        return cfg::make_run_configuration(cfg::parse_string("integral_type = \"two_center\"\nmax_ang_mom = 1\nprecision = \"" +
+                                                             value + "\""))
+            .precision;
+    };
+
+    EXPECT_EQ(precision_of("fp64"), Precision::fp64);
+    EXPECT_EQ(precision_of("double"), Precision::fp64);
+    EXPECT_EQ(precision_of("FP32"), Precision::fp32);
+    EXPECT_EQ(precision_of("single"), Precision::fp32);
+    EXPECT_EQ(precision_of("mixed"), Precision::mixed);
+
+    // mixed computes primitives in float and accumulates contractions in double
+    EXPECT_EQ(cfg::primitive_type(Precision::fp64), "double");
+    EXPECT_EQ(cfg::accumulator_type(Precision::fp64), "double");
+    EXPECT_EQ(cfg::primitive_type(Precision::fp32), "float");
+    EXPECT_EQ(cfg::accumulator_type(Precision::fp32), "float");
+    EXPECT_EQ(cfg::primitive_type(Precision::mixed), "float");
+    EXPECT_EQ(cfg::accumulator_type(Precision::mixed), "double");
+}
+
+TEST(RunConfigurationTest, KernelFormIsTemplatedOnlyForHrr)
+{
+    const auto hrr = cfg::make_run_configuration(cfg::parse_string("recursion_type = \"hrr_bra\"\nmax_ang_mom = 2"));
+    EXPECT_EQ(hrr.kernel_form, cfg::KernelForm::unrolled);
+
+    const auto templated = cfg::make_run_configuration(
+        cfg::parse_string("recursion_type = \"hrr_bra\"\nmax_ang_mom = 2\nkernel_form = \"Template\""));
+    EXPECT_EQ(templated.kernel_form, cfg::KernelForm::templated);
+    EXPECT_EQ(cfg::to_string(templated.kernel_form), "templated");
+
+    EXPECT_THROW(cfg::make_run_configuration(
+                     cfg::parse_string("recursion_type = \"hrr_bra\"\nmax_ang_mom = 2\nkernel_form = \"inline\"")),
+                 ConfigError);
+    EXPECT_THROW(cfg::make_run_configuration(
+                     cfg::parse_string("recursion_type = \"vrr_cartesian\"\nmax_ang_mom = 2\nkernel_form = \"templated\"")),
+                 ConfigError);
+    EXPECT_THROW(cfg::make_run_configuration(
+                     cfg::parse_string("integral_type = \"two_center\"\nmax_ang_mom = 2\nkernel_form = \"templated\"")),
+                 ConfigError);
+}
+
+TEST(RunConfigurationTest, EriMethodIsForFourCenterElectronRepulsion)
+{
+    const std::string eri4c = "integral_type = \"four_center\"\noperator_type = \"electron_repulsion\"\nmax_ang_mom = 2";
+
+    EXPECT_EQ(cfg::make_run_configuration(cfg::parse_string(eri4c)).eri_method, cfg::EriMethod::obara_saika);
+
+    const auto rys = cfg::make_run_configuration(cfg::parse_string(eri4c + "\neri_method = \"Rys\""));
+    EXPECT_EQ(rys.eri_method, cfg::EriMethod::rys);
+    EXPECT_EQ(cfg::to_string(rys.eri_method), "rys");
+
+    const auto automatic = cfg::make_run_configuration(cfg::parse_string(eri4c + "\neri_method = \"automatic\""));
+    EXPECT_EQ(automatic.eri_method, cfg::EriMethod::automatic);
+    EXPECT_EQ(cfg::to_string(automatic.eri_method), "auto");
+
+    EXPECT_THROW(cfg::make_run_configuration(cfg::parse_string(eri4c + "\neri_method = \"hgp\"")), ConfigError);
+    EXPECT_THROW(cfg::make_run_configuration(cfg::parse_string(
+                     "integral_type = \"three_center\"\noperator_type = \"electron_repulsion\"\nmax_ang_mom = 2\n"
+                     "eri_method = \"rys\"")),
+                 ConfigError);
 }
 
 TEST(RunConfigurationTest, InconsistentAngularMomentumThrows)
@@ -229,6 +303,31 @@ TEST(RunConfigurationTest, InconsistentAngularMomentumThrows)
                  ConfigError);
 }
 
+TEST(RunConfigurationTest, LegacyRunsAcceptOnlyFp64)
+{
+    EXPECT_NO_THROW(cfg::check_legacy_precision(cfg::parse_string(R"(type = "t2c_cpu")"), "t2c_cpu"));
+
+    EXPECT_NO_THROW(cfg::check_legacy_precision(cfg::parse_string(R"(
+                        type      = "t4c_cpu"
+                        precision = "double"
+                    )"),
+                                                "t4c_cpu"));
+
+    EXPECT_THROW(cfg::check_legacy_precision(cfg::parse_string(R"(
+                     type      = "t3c_cpu"
+                     precision = "fp32"
+                 )"),
+                                             "t3c_cpu"),
+                 ConfigError);
+
+    EXPECT_THROW(cfg::check_legacy_precision(cfg::parse_string(R"(
+                     type      = "t2c_cpu"
+                     precision = "mixed"
+                 )"),
+                                             "t2c_cpu"),
+                 ConfigError);
+}
+
 TEST(RunConfigurationTest, ToStringRoundTrips)
 {
     EXPECT_EQ(cfg::to_string(Hardware::cpu), "cpu");
@@ -241,4 +340,5 @@ TEST(RunConfigurationTest, ToStringRoundTrips)
     EXPECT_EQ(cfg::to_string(RecursionType::hrr_ket), "hrr_ket");
     EXPECT_EQ(cfg::to_string(StorageForm::veloxchem_sparse), "VeloxChemSparse");
     EXPECT_EQ(cfg::to_string(Signature::veloxchem_screened), "VeloxChemScreened");
+    EXPECT_EQ(cfg::to_string(Precision::mixed), "mixed");
 }
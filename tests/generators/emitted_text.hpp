@@ -0,0 +1,191 @@
+// LITMUS: An Automated Molecular Integrals Generator
+// Copyright 2022 Z. Rinkevicius, KTH, Sweden.
+
+#ifndef emitted_text_hpp
+#define emitted_text_hpp
+
+#include <algorithm>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace testing_util {  // testing_util namespace
+
+/// Captures the text a legacy emitter writes to a std::ofstream.
+/// @param name The unique scratch file name.
+/// @param write The callable writing to the file stream.
+/// @return The emitted text.
+template <class F>
+std::string
+emitted_text(const std::string& name, const F& write)
+{
+    const auto path = std::filesystem::temp_directory_path() / ("litmus_test_" + name);
+
+    {
+        std::ofstream fstream(path, std::ios_base::trunc);
+
+        write(fstream);
+    }
+
+    std::ifstream istream(path);
+
+    std::string text((std::istreambuf_iterator<char>(istream)), std::istreambuf_iterator<char>());
+
+    std::filesystem::remove(path);
+
+    return text;
+}
+
+/// Runs a legacy generator in a scratch working directory and reads one of the files it writes.
+/// @param name The unique scratch directory name.
+/// @param fname The name of the generated file to read.
+/// @param generate The callable running the generator.
+/// @return The text of the generated file, empty if it was not written.
+template <class F>
+std::string
+generated_text(const std::string& name, const std::string& fname, const F& generate)
+{
+    const auto cwd = std::filesystem::current_path();
+
+    const auto path = std::filesystem::temp_directory_path() / ("litmus_test_" + name);
+
+    std::filesystem::remove_all(path);
+
+    std::filesystem::create_directories(path);
+
+    std::filesystem::current_path(path);
+
+    generate();
+
+    std::filesystem::current_path(cwd);
+
+    std::ifstream istream(path / fname);
+
+    std::string text((std::istreambuf_iterator<char>(istream)), std::istreambuf_iterator<char>());
+
+    istream.close();
+
+    std::filesystem::remove_all(path);
+
+    return text;
+}
+
+/// Runs a legacy generator in a scratch working directory and lists the files it writes.
+/// @param name The unique scratch directory name.
+/// @param generate The callable running the generator.
+/// @return The sorted names of generated files.
+template <class F>
+std::vector<std::string>
+generated_files(const std::string& name, const F& generate)
+{
+    const auto cwd = std::filesystem::current_path();
+
+    const auto path = std::filesystem::temp_directory_path() / ("litmus_test_" + name);
+
+    std::filesystem::remove_all(path);
+
+    std::filesystem::create_directories(path);
+
+    std::filesystem::current_path(path);
+
+    generate();
+
+    std::filesystem::current_path(cwd);
+
+    std::vector<std::string> fnames;
+
+    for (const auto& entry : std::filesystem::directory_iterator(path))
+    {
+        fnames.push_back(entry.path().filename().string());
+    }
+
+    std::filesystem::remove_all(path);
+
+    std::sort(fnames.begin(), fnames.end());
+
+    return fnames;
+}
+
+/// Runs a legacy generator in a scratch working directory and compiles driver.cpp next to the
+/// generated files with the compiler of the build (LITMUS_TEST_CXX_COMPILER), then runs it.
+/// @param name The unique scratch directory name.
+/// @param generate The callable running the generator.
+/// @param sources The extra source files (name to text), including driver.cpp.
+/// @param run The flag to run the compiled driver (syntax check only otherwise).
+/// @return True if the driver compiled and, when requested, exited with zero status.
+template <class F>
+bool
+compiles_generated(const std::string& name, const F& generate, const std::map<std::string, std::string>& sources, const bool run)
+{
+    const auto cwd = std::filesystem::current_path();
+
+    const auto path = std::filesystem::temp_directory_path() / ("litmus_test_" + name);
+
+    std::filesystem::remove_all(path);
+
+    std::filesystem::create_directories(path);
+
+    std::filesystem::current_path(path);
+
+    generate();
+
+    std::filesystem::current_path(cwd);
+
+    for (const auto& [fname, text] : sources)
+    {
+        std::ofstream(path / fname, std::ios_base::trunc) << text;
+    }
+
+    const auto driver = (path / "driver").string();
+
+    auto command = std::string(LITMUS_TEST_CXX_COMPILER) + " -std=c++17 -I" + path.string() + " " + (path / "driver.cpp").string();
+
+    command += (run) ? " -o " + driver : " -fsyntax-only";
+
+    auto status = std::system((command + " > " + (path / "compile.log").string() + " 2>&1").c_str());
+
+    if (status != 0)
+    {
+        std::ifstream istream(path / "compile.log");
+
+        std::cerr << istream.rdbuf();
+    }
+    else if (run)
+    {
+        status = std::system(driver.c_str());
+    }
+
+    std::filesystem::remove_all(path);
+
+    return status == 0;
+}
+
+/// True if haystack contains needle.
+inline bool
+contains(const std::string& haystack, const std::string& needle)
+{
+    return haystack.find(needle) != std::string::npos;
+}
+
+/// Counts non-overlapping occurrences of needle in haystack.
+inline size_t
+count(const std::string& haystack, const std::string& needle)
+{
+    size_t n = 0;
+
+    for (auto pos = haystack.find(needle); pos != std::string::npos; pos = haystack.find(needle, pos + needle.size()))
+    {
+        n++;
+    }
+
+    return n;
+}
+
+}  // namespace testing_util
+
+#endif /* emitted_text_hpp */
@@ -0,0 +1,189 @@
+// LITMUS: An Automated Molecular Integrals Generator
+// Copyright 2022 Z. Rinkevicius, KTH, Sweden.
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "eri_cost_model.hpp"
+#include "four_center_generators.hpp"
+#include "ltm.hpp"
+#include "operator.hpp"
+#include "run_configuration.hpp"
+
+namespace {
+
+cfg::RunConfiguration
+eri_config(int min_ang_mom, int max_ang_mom)
+{
+    cfg::RunConfiguration run_config;
+    run_config.integral_type = cfg::IntegralType::four_center;
+    run_config.operator_type = cfg::OperatorType::electron_repulsion;
+    run_config.min_ang_mom   = min_ang_mom;
+    run_config.max_ang_mom   = max_ang_mom;
+    return run_config;
+}
+
+// Generates into memory and returns the content of one emitted file (empty if
+// it was not emitted).
+std::string
+emitted(const cfg::RunConfiguration& run_config, const std::string& name)
+{
+    for (const auto& file : ltm::generate(run_config))
+    {
+        if (file.name == name) return file.content;
+    }
+
+    return std::string();
+}
+
+}  // namespace
+
+TEST(FourCenterEmittersTest, AngularMomentumSubsetSelectsQuadruples)
+{
+    // [0, 1]: bra and ket pairs SS, SP, PP (B >= A, D >= C) -> 9 quadruples.
+    ost::MemorySink full;
+
+    FourCenterGenerator().generate(eri_config(0, 1), full);
+
+    EXPECT_EQ(full.files().size(), 18u);
+
+    // [1, 1]: only (PP|PP).
+    ost::MemorySink high;
+
+    FourCenterGenerator().generate(eri_config(1, 1), high);
+
+    ASSERT_EQ(high.files().size(), 2u);
+    EXPECT_EQ(high.files()[0].name.find("ObaraSaikaFourCenterElectronRepulsionPPPP"), 0u);
+}
+
+TEST(FourCenterEmittersTest, PairBlockSignature)
+{
+    const auto hpp = emitted(eri_config(0, 1), "ObaraSaikaFourCenterElectronRepulsionSPSP.hpp");
+
+    EXPECT_NE(hpp.find("namespace os4c::eri {"), std::string::npos);
+    EXPECT_NE(hpp.find("compute_s_p_s_p(const osfunc::CBasisFunctionPair& bra,\n"
+                       "                const osfunc::CBasisFunctionPair& ket) -> osfunc::CArray<double>;"),
+              std::string::npos);
+}
+
+TEST(FourCenterEmittersTest, VrrThenKetHrrThenBraHrr)
+{
+    const auto pppp = emitted(eri_config(1, 1), "ObaraSaikaFourCenterElectronRepulsionPPPP.cpp");
+
+    EXPECT_NE(pppp.find("// Boys function arguments T = rho |PQ|^2 and values F_m(T), m = 0, ..., 4"),
+              std::string::npos);
+    EXPECT_NE(pppp.find("const auto bf = osfunc::compute_boys_function(bt, 4);"), std::string::npos);
+
+    // bra VRR with PB/WP, ket VRR with QD/WQ, as V4IElectronRepulsionDriver
+    // expands them.
+    EXPECT_NE(pppp.find("os4c::vrr::eri::compute_s_p(bra, ket, ssss_1, ssss_2, qd, wq, sssp_1);"),
+              std::string::npos);
+    EXPECT_NE(pppp.find("os4c::vrr::eri::compute_d_d(bra, ket, "), std::string::npos);
+    EXPECT_NE(pppp.find(", pb, wp, sdsd_0);"), std::string::npos);
+
+    // the ket HRR builds the (0b|pp) row before the bra HRR consumes it.
+    EXPECT_NE(pppp.find("os4c::hrr::compute_xx_p_p(6, csdsp, csdsd, cd, csdpp);"), std::string::npos);
+    EXPECT_NE(pppp.find("os4c::hrr::compute_p_p_xx(9, csppp, csdpp, ab, cpppp);"), std::string::npos);
+    EXPECT_LT(pppp.find("compute_xx_p_p(6"), pppp.find("compute_p_p_xx(9"));
+
+    // sparse ket then bra half transformation instead of the dense osfunc::transform.
+    EXPECT_EQ(pppp.find("osfunc::transform"), std::string::npos);
+    EXPECT_NE(pppp.find("const auto c_4 = cpppp.data(9 * ab + 4);"), std::string::npos);
+    EXPECT_NE(pppp.find("auto s_0 = buffer.data(9 * 0 + cd);"), std::string::npos);
+    EXPECT_LT(pppp.find("compute_p_p_xx(9"), pppp.find("osfunc::CArray<double> half(81, ncols);"));
+}
+
+TEST(FourCenterEmittersTest, SparseTransformReadsNonZeroFactors)
+{
+    const auto pdpd = emitted(eri_config(1, 2), "ObaraSaikaFourCenterElectronRepulsionPDPD.cpp");
+
+    // ket half (pd|p'd'): d(0) reads xy only, d(2) groups the equal xx and yy factors.
+    EXPECT_NE(pdpd.find("const auto c_17 = cpdpd.data(18 * ab + 17);"), std::string::npos);
+    EXPECT_NE(pdpd.find("s_0[k] = (1.0 * std::sqrt(3.0)) * c_7[k];"), std::string::npos);
+    EXPECT_NE(pdpd.find("s_2[k] = -(1.0 / 2.0) * (c_6[k] + c_9[k]) + c_11[k];"), std::string::npos);
+    EXPECT_NE(pdpd.find("s_4[k] = (1.0 / 2.0 * std::sqrt(3.0)) * (c_6[k] - c_9[k]);"), std::string::npos);
+
+    // bra half (p'd'|p'd') loops over the 15 spherical ket rows.
+    EXPECT_NE(pdpd.find("for (std::size_t cd = 0; cd < 15; cd++)"), std::string::npos);
+    EXPECT_NE(pdpd.find("auto s_14 = buffer.data(15 * 14 + cd);"), std::string::npos);
+    EXPECT_EQ(pdpd.find("(0.0) *"), std::string::npos);
+    EXPECT_EQ(pdpd.find("osfunc::transform"), std::string::npos);
+    EXPECT_EQ(pdpd.find("CartesianToSphericalFunc.hpp"), std::string::npos);
+}
+
+TEST(FourCenterEmittersTest, LongRangeKernelFusesAttenuatedSeeds)
+{
+    auto run_config = eri_config(1, 1);
+
+    run_config.operator_type = cfg::OperatorType::long_range_electron_repulsion;
+
+    const auto pppp = emitted(run_config, "ObaraSaikaFourCenterLongRangeElectronRepulsionPPPP.cpp");
+
+    EXPECT_NE(pppp.find("namespace os4c::erf {"), std::string::npos);
+    EXPECT_NE(pppp.find("const auto bf_w = osfunc::compute_boys_function(bt_w, 4);"), std::string::npos);
+    EXPECT_NE(pppp.find("const auto ssss_4 = osfunc::compute_range_separated_electron_repulsion(bra, ket, bf, "
+                        "bf_w, 4, omega, alpha, beta);"),
+              std::string::npos);
+
+    // one pass through the Coulomb recurrences serves both terms.
+    EXPECT_NE(pppp.find("os4c::vrr::eri::compute_s_p(bra, ket, ssss_1, ssss_2, qd, wq, sssp_1);"),
+              std::string::npos);
+    EXPECT_NE(pppp.find("os4c::hrr::compute_p_p_xx(9, csppp, csdpp, ab, cpppp);"), std::string::npos);
+}
+
+TEST(FourCenterEmittersTest, RysKernelAssemblesTwoDimensionalIntegrals)
+{
+    auto run_config = eri_config(1, 1);
+
+    run_config.eri_method = cfg::EriMethod::rys;
+
+    ost::MemorySink sink;
+
+    FourCenterGenerator().generate(run_config, sink);
+
+    // the (PP|PP) kernel pair plus the shared 2D recursion header.
+    ASSERT_EQ(sink.files().size(), 3u);
+    EXPECT_EQ(sink.files()[2].name, "RysFourCenterRecursions.hpp");
+    EXPECT_NE(sink.files()[2].content.find("vrr_2d(const T c00, const T d00, const T b00, const T b10, const T b01, T* g)"),
+              std::string::npos);
+
+    const auto hpp = emitted(run_config, "RysFourCenterElectronRepulsionPPPP.hpp");
+
+    EXPECT_NE(hpp.find("namespace rys4c::eri {"), std::string::npos);
+    EXPECT_NE(hpp.find("compute_p_p_p_p(const osfunc::CBasisFunctionPair& bra,"), std::string::npos);
+
+    // L = 4 needs three roots; the 2D tables span G(2, 2) and I(1, 1, 1, 1).
+    const auto pppp = emitted(run_config, "RysFourCenterElectronRepulsionPPPP.cpp");
+
+    EXPECT_NE(pppp.find("osfunc::compute_rys_quadrature(bra, ket, 3);"), std::string::npos);
+    EXPECT_NE(pppp.find("rys4c::vrr_2d<2, 2>(c00_x[i], d00_x[i], b00[i], b10[i], b01[i], gx);"), std::string::npos);
+    EXPECT_NE(pppp.find("rys4c::hrr_2d<1, 1, 1, 1>(gz, ab_z[i], cd_z[i], iz);"), std::string::npos);
+
+    // (px px|px px) takes Ix(1, 1, 1, 1) and Iy(0, 0, 0, 0), Iz(0, 0, 0, 0).
+    EXPECT_NE(pppp.find("static constexpr int index[81][3] = {\n        {15, 0, 0}, "), std::string::npos);
+    EXPECT_NE(pppp.find("osfunc::contract(cpppp, prim);"), std::string::npos);
+    EXPECT_EQ(pppp.find("osfunc::transform"), std::string::npos);
+    EXPECT_LT(pppp.find("osfunc::contract(cpppp, prim);"), pppp.find("osfunc::CArray<double> half(81, ncols);"));
+}
+
+TEST(FourCenterEmittersTest, CostModelPicksObaraSaikaAtLowAngularMomentum)
+{
+    const auto quadruple = [](int la, int lb, int lc, int ld) {
+        return I4CIntegral(I2CPair("GA", la, "GB", lb), I2CPair("GC", lc, "GD", ld), Operator("1/|r-r'|"), 0, {});
+    };
+
+    EXPECT_EQ(cost::rys_roots(quadruple(0, 0, 0, 0)), 1);
+    EXPECT_EQ(cost::rys_roots(quadruple(1, 2, 1, 2)), 4);
+    EXPECT_LT(cost::rys_flops(quadruple(1, 1, 1, 1)), cost::rys_flops(quadruple(2, 2, 2, 2)));
+
+    // automatic mode keeps (PP|PP) on Obara-Saika and moves (DD|DD) to Rys.
+    auto run_config = eri_config(1, 2);
+
+    run_config.eri_method = cfg::EriMethod::automatic;
+
+    EXPECT_FALSE(emitted(run_config, "ObaraSaikaFourCenterElectronRepulsionPPPP.cpp").empty());
+    EXPECT_TRUE(emitted(run_config, "RysFourCenterElectronRepulsionPPPP.cpp").empty());
+    EXPECT_FALSE(emitted(run_config, "RysFourCenterElectronRepulsionDDDD.cpp").empty());
+    EXPECT_FALSE(emitted(run_config, "RysFourCenterRecursions.hpp").empty());
+}
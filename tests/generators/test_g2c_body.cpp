@@ -0,0 +1,75 @@
+// LITMUS: An Automated Molecular Integrals Generator
+// Copyright 2022 Z. Rinkevicius, KTH, Sweden.
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "emitted_text.hpp"
+#include "g2c_body.hpp"
+#include "v2i_npot_driver.hpp"
+
+using testing_util::contains;
+using testing_util::count;
+using testing_util::emitted_text;
+
+namespace {
+
+/// Emits grid-batched (P|A|D) body with given screening threshold exponent.
+std::string
+batch_body(const int grid_screening)
+{
+    const auto integral = I2CIntegral(I1CPair("GA", 1), I1CPair("GB", 2), Operator("A"), 0, {});
+
+    SI2CIntegrals vrr_integrals;
+
+    for (const auto& tint : V2INuclearPotentialDriver().create_recursion({integral}))
+    {
+        if (tint.integrand().name() != "1") vrr_integrals.insert(tint);
+    }
+
+    return emitted_text("g2c_batch_" + std::to_string(grid_screening), [&](std::ofstream& fstream) {
+        G2CFuncBodyDriver().write_batch_func_body(fstream, vrr_integrals, integral, grid_screening);
+    });
+}
+
+}  // namespace
+
+TEST(G2CFuncBodyDriverTest, BatchBodyLoopsOverBlockRanges)
+{
+    const auto text = batch_body(0);
+
+    EXPECT_TRUE(contains(text, "for (auto bra_igto = bra_range.first; bra_igto < bra_range.second; bra_igto++)"));
+    EXPECT_TRUE(contains(text, "for (auto ket_igto = ket_range.first; ket_igto < ket_range.second; ket_igto++)"));
+
+    // contracted integrals are reset once per basis function pair, not per primitive
+    EXPECT_EQ(count(text, "cart_buffer.zero();"), 1u);
+
+    // (P|A|D) has 5 * 3 spherical rows per pair
+    EXPECT_TRUE(contains(text, "const auto spher_row = ((bra_igto - bra_range.first) * ket_dim + ket_igto - ket_range.first) * 15;"));
+    EXPECT_TRUE(contains(text, "t2cfunc::transform<1, 2>(spher_buffer, spher_row, cart_buffer, "));
+
+    // primitive loops of single pair kernel are nested inside pair loops
+    EXPECT_TRUE(contains(text, "\n            for (size_t i = 0; i < bra_npgtos; i++)"));
+
+    EXPECT_FALSE(contains(text, "rmin2"));
+}
+
+TEST(G2CFuncBodyDriverTest, BatchBodyScreensPrimitivePairsOverPointBlock)
+{
+    const auto text = batch_body(10);
+
+    // bound uses smallest P-to-point distance of block, after R(PC) is computed
+    const auto dist = text.find("t2cfunc::comp_distances_pc(cart_buffer, 0, gcoords_x, gcoords_y, gcoords_z, p_x, p_y, p_z);");
+    const auto bound = text.find("#pragma omp simd reduction(min : rmin2)");
+
+    ASSERT_NE(dist, std::string::npos);
+    ASSERT_NE(bound, std::string::npos);
+    EXPECT_LT(dist, bound);
+
+    EXPECT_TRUE(contains(text, "const auto fbound = std::fabs(fovl) * std::min(2.0 * std::sqrt((a_exp + b_exp) / fpi), 1.0 / std::sqrt(rmin2));"));
+    EXPECT_TRUE(contains(text, "if (fbound < 1.0e-10) continue;"));
+
+    // screening skips Boys function evaluation of negligible primitive pairs
+    EXPECT_LT(text.find("if (fbound < 1.0e-10) continue;"), text.find("bf_table.compute(cart_buffer, 4, 3);"));
+}
@@ -0,0 +1,91 @@
+// LITMUS: An Automated Molecular Integrals Generator
+// Copyright 2022 Z. Rinkevicius, KTH, Sweden.
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "config.hpp"
+#include "ltm.hpp"
+#include "run_configuration.hpp"
+
+namespace {
+
+cfg::RunConfiguration
+two_center_config(int max_ang_mom)
+{
+    cfg::RunConfiguration run_config;
+    run_config.integral_type = cfg::IntegralType::two_center;
+    run_config.operator_type = cfg::OperatorType::overlap;
+    run_config.max_ang_mom   = max_ang_mom;
+    return run_config;
+}
+
+}  // namespace
+
+TEST(LtmTest, GeneratesTwoCenterKernelsInMemory)
+{
+    const auto files = ltm::generate(two_center_config(1));
+
+    // a header/definition pair per (la|lb) target: SS, SP, PS, PP
+    ASSERT_EQ(files.size(), 8u);
+
+    EXPECT_EQ(files[0].name, "ObaraSaikaTwoCenterOverlapSS.hpp");
+    EXPECT_EQ(files[1].name, "ObaraSaikaTwoCenterOverlapSS.cpp");
+
+    for (const auto& file : files) EXPECT_FALSE(file.content.empty()) << file.name;
+
+    EXPECT_NE(files[1].content.find("#include \"ObaraSaikaTwoCenterOverlapSS.hpp\""), std::string::npos);
+
+    // nothing is written to the working directory
+    EXPECT_FALSE(std::filesystem::exists("ObaraSaikaTwoCenterOverlapSS.hpp"));
+}
+
+TEST(LtmTest, DirectorySinkMatchesMemorySink)
+{
+    const auto dir = std::filesystem::path(testing::TempDir()) / "litmus_ltm_sink";
+
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+
+    cfg::RunConfiguration run_config;
+    run_config.recursion_type = cfg::RecursionType::hrr_bra;
+    run_config.max_ang_mom    = 1;
+
+    ost::DirectorySink sink(dir.string());
+
+    ltm::generate(run_config, sink);
+
+    const auto files = ltm::generate(run_config);
+
+    ASSERT_FALSE(files.empty());
+
+    for (const auto& file : files)
+    {
+        std::ifstream in(dir / file.name);
+        std::stringstream buffer;
+        buffer << in.rdbuf();
+        EXPECT_EQ(buffer.str(), file.content) << file.name;
+    }
+}
+
+TEST(LtmTest, EveryIntegralTypeIsWiredIn)
+{
+    auto run_config = two_center_config(0);
+    run_config.operator_type = cfg::OperatorType::electron_repulsion;
+
+    for (const auto type : {cfg::IntegralType::three_center, cfg::IntegralType::four_center})
+    {
+        run_config.integral_type = type;
+
+        EXPECT_EQ(ltm::generate(run_config).size(), 2u);
+    }
+
+    // operators without a generator for the arity are rejected by the generator
+    run_config.operator_type = cfg::OperatorType::overlap;
+
+    EXPECT_THROW(ltm::generate(run_config), cfg::ConfigError);
+}
@@ -0,0 +1,336 @@
+// LITMUS: An Automated Molecular Integrals Generator
+// Copyright 2022 Z. Rinkevicius, KTH, Sweden.
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cmath>
+#include <random>
+#include <regex>
+#include <stdexcept>
+#include <string>
+
+#include "emitted_text.hpp"
+#include "reference_integrals.hpp"
+#include "t2c_cpu_generators.hpp"
+#include "t2c_geom_cpu_generators.hpp"
+
+using testing_util::contains;
+using testing_util::count;
+using testing_util::generated_text;
+
+namespace {
+
+/// Generates first order geometrical derivatives of (P|P) overlap files and reads one of them.
+std::string
+overlap_geom_text(const std::string& name, const std::string& fname, const std::array<int, 3>& geom_drvs, const bool trans_inv)
+{
+    return generated_text(name, fname, [geom_drvs, trans_inv] {
+        T2CGeomCPUGenerator().generate("overlap", 1, geom_drvs, {true, false}, false, 0, trans_inv);
+    });
+}
+
+/// Generates (P|G(r)|P) three-center overlap files and reads one of them.
+std::string
+three_center_overlap_text(const std::string& name, const std::string& fname, const int point_batch)
+{
+    return generated_text(name, fname, [point_batch] {
+        T2CCPUGenerator().generate("three center overlap", 1, {0, 0, 0}, {true, false}, false, 0, point_batch);
+    });
+}
+
+/// Generates (P|O|P) integral files with primitive pairs screening and reads one of them.
+std::string
+prim_screening_text(const std::string& name, const std::string& fname, const std::string& integral)
+{
+    return generated_text(name, fname, [integral] {
+        T2CCPUGenerator().generate(integral, 1, {0, 0, 0}, {true, false}, false, 3, 0);
+    });
+}
+
+/// The constant pi in extended precision.
+constexpr long double pi = 3.141592653589793238462643383279502884L;
+
+/// (s|s) bounds of primitive pair as emitted by primitive pairs screening, per operator.
+struct PrimBounds
+{
+    long double fe, fz, r2ab, fnorm;
+
+    PrimBounds(const std::array<refint::Primitive, 2>& prims, const long double a_norm, const long double b_norm)
+        : fe(prims[0].exponent + prims[1].exponent)
+        , fz(prims[0].exponent * prims[1].exponent / fe)
+        , r2ab(0.0L)
+        , fnorm(std::fabs(a_norm * b_norm))
+    {
+        for (int i = 0; i < 3; i++)
+        {
+            r2ab += (prims[0].center[i] - prims[1].center[i]) * (prims[0].center[i] - prims[1].center[i]);
+        }
+    }
+
+    long double overlap() const { return fnorm * (pi / fe) * std::sqrt(pi / fe) * std::exp(-fz * r2ab); }
+
+    long double kinetic_energy() const { return fz * (3.0L + 2.0L * fz * r2ab) * overlap(); }
+
+    long double nuclear_potential() const { return fnorm * (2.0L * pi / fe) * std::exp(-fz * r2ab); }
+
+    long double electron_repulsion(const long double a_exp, const long double b_exp) const
+    {
+        const auto fboys = (fz * r2ab > 0.25L * pi) ? 0.5L * std::sqrt(pi / (fz * r2ab)) : 1.0L;
+
+        return fnorm * 2.0L * std::pow(pi, 2.5L) / (a_exp * b_exp * std::sqrt(fe)) * fboys;
+    }
+};
+
+/// Normalization factor of primitive s function.
+long double
+s_norm(const long double exponent)
+{
+    return std::pow(2.0L * exponent / pi, 0.75L);
+}
+
+}  // namespace
+
+TEST(T2CFuncBodyDriverTest, PrimScreeningBoundsCarryOperatorPrefactors)
+{
+    const std::string fexp = " * std::exp(-fz * r2ab)";
+
+    const std::string fovl = "(3.141592653589793 / fe) * std::sqrt(3.141592653589793 / fe)" + fexp;
+
+    const auto ovl = prim_screening_text("t2c_screen_ovl", "OverlapSumRecPP.hpp", "overlap");
+
+    const auto kin = prim_screening_text("t2c_screen_kin", "KineticEnergySumRecPP.hpp", "kinetic energy");
+
+    const auto npot = prim_screening_text("t2c_screen_npot", "NuclearPotentialSumRecPP.hpp", "nuclear potential");
+
+    const auto eri = prim_screening_text("t2c_screen_eri", "TwoCenterElectronRepulsionSumRecPP.hpp", "electron repulsion");
+
+    ASSERT_FALSE(ovl.empty());
+    ASSERT_FALSE(kin.empty());
+    ASSERT_FALSE(npot.empty());
+    ASSERT_FALSE(eri.empty());
+
+    EXPECT_TRUE(contains(ovl, "const auto fss = std::fabs(a_norm * b_norms[l]) * " + fovl + ";"));
+    EXPECT_TRUE(contains(kin, "const auto fss = std::fabs(a_norm * b_norms[l]) * fz * (3.0 + 2.0 * fz * r2ab) * " + fovl + ";"));
+    EXPECT_TRUE(contains(npot, "const auto fss = std::fabs(a_norm * b_norms[l]) * (6.283185307179586 / fe)" + fexp + ";"));
+    EXPECT_TRUE(contains(eri, "const auto fss = std::fabs(a_norm * b_norms[l]) * 34.98683665524972 / (a_exp * b_exps[l] * std::sqrt(fe)) * ((fz * r2ab > 0.7853981633974483) ? 0.886226925452758 / std::sqrt(fz * r2ab) : 1.0);"));
+
+    for (const auto& text : {ovl, kin, npot, eri})
+    {
+        EXPECT_TRUE(contains(text, "if (fmax < 1.0e-3) continue;"));
+    }
+
+    // bounds hold for (s|O|s) of random primitive pairs, from diffuse to tight exponents
+    std::mt19937 engine(28);
+
+    for (int sample = 0; sample < 32; sample++)
+    {
+        std::array<refint::Primitive, 2> prims = {refint::random_primitive(engine, 0), refint::random_primitive(engine, 0)};
+
+        if (sample % 2 == 0)
+        {
+            prims[0].exponent *= 0.01L;
+
+            prims[1].exponent *= 0.01L;
+        }
+
+        const PrimBounds bounds(prims, 1.0L, 1.0L);
+
+        const auto point = refint::random_primitive(engine, 0).center;
+
+        refint::Primitive sa, sb;
+
+        sa.exponent = 0.0L;
+
+        sa.center = prims[0].center;
+
+        sb.exponent = 0.0L;
+
+        sb.center = prims[1].center;
+
+        EXPECT_LE(refint::overlap(prims), bounds.overlap() * (1.0L + 1.0e-12L)) << sample;
+        EXPECT_LE(std::fabs(refint::kinetic_energy(prims)), bounds.kinetic_energy() * (1.0L + 1.0e-12L)) << sample;
+        EXPECT_LE(refint::nuclear_potential(prims, point), bounds.nuclear_potential() * (1.0L + 1.0e-12L)) << sample;
+        EXPECT_LE(refint::electron_repulsion({prims[0], sa, prims[1], sb}),
+                  bounds.electron_repulsion(prims[0].exponent, prims[1].exponent) * (1.0L + 1.0e-12L)) << sample;
+    }
+}
+
+TEST(T2CFuncBodyDriverTest, PrimScreeningKeepsDiffusePairs)
+{
+    // two normalized diffuse s functions 10 bohr apart overlap by exp(-1/2)
+    std::array<refint::Primitive, 2> prims = {refint::Primitive(), refint::Primitive()};
+
+    prims[0].exponent = 0.01L;
+
+    prims[1].exponent = 0.01L;
+
+    prims[1].center = {0.0L, 0.0L, 10.0L};
+
+    const auto a_norm = s_norm(prims[0].exponent);
+
+    const auto b_norm = s_norm(prims[1].exponent);
+
+    const auto fovl = a_norm * b_norm * refint::overlap(prims);
+
+    EXPECT_NEAR(static_cast<double>(fovl), std::exp(-0.5), 1.0e-12);
+
+    const PrimBounds bounds(prims, a_norm, b_norm);
+
+    // Gaussian product prefactor alone is below 1.0e-3 and would drop pair,
+    // the (s|s) bound keeps it
+    EXPECT_LT(static_cast<double>(a_norm * b_norm * std::exp(-bounds.fz * bounds.r2ab)), 1.0e-3);
+    EXPECT_NEAR(static_cast<double>(bounds.overlap()), static_cast<double>(fovl), 1.0e-12);
+    EXPECT_GT(static_cast<double>(bounds.overlap()), 1.0e-3);
+    EXPECT_GT(static_cast<double>(bounds.kinetic_energy()), 1.0e-3);
+    EXPECT_GT(static_cast<double>(bounds.nuclear_potential()), 1.0e-3);
+    EXPECT_GT(static_cast<double>(bounds.electron_repulsion(prims[0].exponent, prims[1].exponent)), 1.0e-3);
+}
+
+TEST(T2CFuncBodyDriverTest, PointBatchBodyRunsRecursionOncePerPointBatch)
+{
+    const auto text = three_center_overlap_text("t2c_point_batch", "ThreeCenterOverlapPointBatchRecPP.hpp", 4);
+
+    ASSERT_FALSE(text.empty());
+
+    EXPECT_TRUE(contains(text, "comp_point_batch_overlap_pp(T& distributor,"));
+    EXPECT_TRUE(contains(text, "const size_t npblock = 4;"));
+    EXPECT_TRUE(contains(text, "#include <algorithm>"));
+    EXPECT_TRUE(contains(text, "#include \"ThreeCenterOverlapPointBatchPrimRecPP.hpp\""));
+
+    // SIMD lanes hold ket side primitives of all points in batch
+    EXPECT_TRUE(contains(text, "CSimdArray<double> pbuffer(14, npblock * ket_npgtos);"));
+    EXPECT_TRUE(contains(text, "std::copy(fvals, fvals + ket_lanes, fvals + p * ket_lanes);"));
+
+    // point loop steps over batches, each point fills its own copy of ket side lanes
+    const auto point_loop = text.find("for (size_t l = 0; l < npoints; l += npblock)");
+
+    ASSERT_NE(point_loop, std::string::npos);
+    EXPECT_LT(point_loop, text.find("for (size_t m = p * ket_lanes; m < (p + 1) * ket_lanes; m++)"));
+    EXPECT_TRUE(contains(text, "const auto g_fact = ((l + p) < npoints) ? exgtos[npoints + ipt] : 0.0;"));
+
+    // exponents and normalization factors of points follow ket side factors
+    std::smatch match;
+
+    ASSERT_TRUE(std::regex_search(text, match, std::regex(R"(CSimdArray<double> factors\((\d+), npblock \* ket_npgtos\);)")));
+
+    const auto idx_cexps = std::to_string(std::stoul(match[1].str()) - 2);
+
+    const auto idx_cfacts = std::to_string(std::stoul(match[1].str()) - 1);
+
+    EXPECT_TRUE(contains(text, "auto g_exps = factors.data(" + idx_cexps + ");"));
+    EXPECT_TRUE(contains(text, "auto g_facts = factors.data(" + idx_cfacts + ");"));
+
+    // recursion and reduction run once per batch, reading point exponents from factors
+    EXPECT_TRUE(contains(text, "t3ovlrec::comp_prim_point_batch_overlap_ss(pbuffer, 1, 0, factors, 17, a_exp, " + idx_cexps + ", " + idx_cfacts + ");"));
+    EXPECT_TRUE(contains(text, "t3ovlrec::comp_prim_point_batch_overlap_pp(pbuffer, 5, 1, 2, factors, 11, a_exp, " + idx_cexps + ");"));
+    EXPECT_TRUE(contains(text, "t3ovlrec::comp_prim_overlap_sp(pbuffer, 2, 1, factors, 14);"));
+    EXPECT_EQ(count(text, "t2cfunc::reduce("), 1u);
+    EXPECT_TRUE(contains(text, "t2cfunc::reduce(cbuffer, pbuffer, 5, ket_width, npblock * ket_npgtos);"));
+    EXPECT_FALSE(contains(text, "exgtos[l]"));
+}
+
+TEST(T2CFuncBodyDriverTest, PointBatchPrimitivesReadPointExponentsPerLane)
+{
+    const auto decl = three_center_overlap_text("t2c_point_batch_prim_hpp", "ThreeCenterOverlapPointBatchPrimRecPP.hpp", 4);
+
+    const auto body = three_center_overlap_text("t2c_point_batch_prim_cpp", "ThreeCenterOverlapPointBatchPrimRecPP.cpp", 4);
+
+    ASSERT_FALSE(decl.empty());
+    ASSERT_FALSE(body.empty());
+
+    EXPECT_TRUE(contains(decl, "/// @param idx_cexps "));
+    EXPECT_TRUE(contains(decl, "comp_prim_point_batch_overlap_pp(CSimdArray<double>& pbuffer,"));
+    EXPECT_TRUE(contains(decl, "const size_t idx_cexps) -> void;"));
+    EXPECT_FALSE(contains(decl, "c_exp)"));
+
+    EXPECT_TRUE(contains(body, "auto c_exps = factors.data(idx_cexps);"));
+    EXPECT_TRUE(contains(body, "const double gfe_0 = 0.5 / (a_exp + b_exps[i] + c_exps[i]);"));
+    EXPECT_TRUE(std::regex_search(body, std::regex(R"(#pragma omp simd aligned\([^)]*c_exps[^)]*: 64\))")));
+}
+
+TEST(T2CFuncBodyDriverTest, PointBatchKeepsPerPointSumKernel)
+{
+    const auto plain = three_center_overlap_text("t2c_point_batch_off", "ThreeCenterOverlapSumRecPP.hpp", 0);
+
+    const auto batched = three_center_overlap_text("t2c_point_batch_on", "ThreeCenterOverlapSumRecPP.hpp", 4);
+
+    ASSERT_FALSE(plain.empty());
+    EXPECT_EQ(plain, batched);
+    EXPECT_TRUE(contains(plain, "for (size_t l = 0; l < npoints; l++)"));
+    EXPECT_TRUE(contains(plain, "t3ovlrec::comp_prim_overlap_pp(pbuffer, 5, 1, 2, factors, 11, a_exp, exgtos[l]);"));
+
+    const auto none = three_center_overlap_text("t2c_point_batch_none", "ThreeCenterOverlapPointBatchRecPP.hpp", 0);
+
+    EXPECT_TRUE(none.empty());
+}
+
+TEST(T2CFuncBodyDriverTest, GradientBodyWritesKetDerivativesAsNegativeBraDerivatives)
+{
+    const auto bra = overlap_geom_text("t2c_geom_bra", "OverlapGeom100SumRecPP.hpp", {1, 0, 0}, false);
+
+    const auto grad = overlap_geom_text("t2c_geom_grad", "OverlapGeomGradSumRecPP.hpp", {0, 0, 1}, true);
+
+    ASSERT_FALSE(bra.empty());
+    ASSERT_FALSE(grad.empty());
+
+    EXPECT_TRUE(contains(grad, "comp_sum_overlap_geom_grad_pp(T& distributor,"));
+
+    // bra side recursion runs once, exactly as in standalone d/dA function
+    const std::string geom_call = "t2cgeom::comp_prim_op_geom_10_px(pbuffer, 34, 1, 16, 1, 3, a_exp);";
+
+    EXPECT_EQ(count(bra, "t2cgeom::"), 1u);
+    EXPECT_EQ(count(grad, "t2cgeom::"), 1u);
+    EXPECT_TRUE(contains(bra, geom_call));
+    EXPECT_TRUE(contains(grad, geom_call));
+
+    // 3 x 9 spherical d/dA rows are followed by 3 x 9 d/dB rows, d/dA + d/dB = 0 row by row
+    EXPECT_TRUE(contains(grad, "CSimdArray<double> sbuffer(27, 1);"));
+    EXPECT_TRUE(contains(grad, "CSimdArray<double> gbuffer(54, 1);"));
+    EXPECT_TRUE(contains(grad, "for (size_t n = 0; n < 27; n++)"));
+    EXPECT_TRUE(contains(grad, "const auto avals = sbuffer.data(n);"));
+    EXPECT_TRUE(contains(grad, "auto ga_vals = gbuffer.data(n);"));
+    EXPECT_TRUE(contains(grad, "auto gb_vals = gbuffer.data(27 + n);"));
+    EXPECT_TRUE(contains(grad, "ga_vals[k] = avals[k];"));
+    EXPECT_TRUE(contains(grad, "gb_vals[k] = -avals[k];"));
+    EXPECT_TRUE(contains(grad, "distributor.distribute(gbuffer, bra_gto_indices, ket_gto_indices, 1, 1, j, ket_range, bra_eq_ket);"));
+
+    // no separate d/dB function is written
+    EXPECT_TRUE(overlap_geom_text("t2c_geom_grad_ket", "OverlapGeom001SumRecPP.hpp", {0, 0, 1}, true).empty());
+
+    // negated rows are exact ket side derivatives: d/dA + d/dB = 0 for all (p|p) components
+    std::mt19937 engine(11);
+
+    const auto ovl = [](const std::array<refint::Primitive, 2>& prims) { return refint::overlap(prims); };
+
+    for (int i = 0; i < 3; i++)
+    {
+        for (int j = 0; j < 3; j++)
+        {
+            std::array<refint::Primitive, 2> pair = {refint::random_primitive(engine, 0), refint::random_primitive(engine, 0)};
+
+            pair[0].powers[i] = 1;
+
+            pair[1].powers[j] = 1;
+
+            for (int axis = 0; axis < 3; axis++)
+            {
+                const auto da = refint::geom_derivative(ovl, pair, {{0, axis}});
+
+                const auto db = refint::geom_derivative(ovl, pair, {{1, axis}});
+
+                EXPECT_NEAR(static_cast<double>(da + db), 0.0, 1.0e-14) << i << " " << j << " " << axis;
+            }
+        }
+    }
+}
+
+TEST(T2CFuncBodyDriverTest, GradientBodyRejectsIntegrandsWithOwnCenter)
+{
+    const auto text = generated_text("t2c_geom_grad_npot", "NuclearPotentialGeomGradSumRecSS.hpp", [] {
+        EXPECT_THROW(T2CGeomCPUGenerator().generate("nuclear potential", 0, {1, 0, 0}, {true, false}, false, 0, true), std::invalid_argument);
+        EXPECT_THROW(T2CGeomCPUGenerator().generate("overlap", 0, {2, 0, 0}, {true, false}, false, 0, true), std::invalid_argument);
+    });
+
+    EXPECT_TRUE(text.empty());
+}
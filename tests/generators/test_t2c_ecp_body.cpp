@@ -0,0 +1,232 @@
+// LITMUS: An Automated Molecular Integrals Generator
+// Copyright 2022 Z. Rinkevicius, KTH, Sweden.
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "emitted_text.hpp"
+#include "file_stream.hpp"
+#include "t2c_ecp_cpu_generators.hpp"
+#include "t2c_ecp_utils.hpp"
+#include "t2c_proj_ecp_cpu_generators.hpp"
+
+using testing_util::compiles_generated;
+using testing_util::contains;
+using testing_util::count;
+using testing_util::emitted_text;
+using testing_util::generated_text;
+
+namespace {
+
+/// Emits shared ECP data definitions on their own.
+std::string
+ecp_data_def()
+{
+    return emitted_text("t2c_ecp_data_def", [](std::ofstream& fstream) {
+        auto lines = VCodeLines();
+
+        t2c::add_ecp_data_def(lines);
+
+        ost::write_code_lines(fstream, lines);
+    });
+}
+
+}  // namespace
+
+TEST(T2CECPFuncBodyDriverTest, ECPDataMergesEqualExponents)
+{
+    const auto text = ecp_data_def();
+
+    EXPECT_TRUE(contains(text, "while ((idx < ecp_exps.size()) && (ecp_exps[idx] != ecp_pexps[i])) idx++;"));
+    EXPECT_TRUE(contains(text, "ecp_facts[idx] += ecp_pfacts[i];"));
+    EXPECT_TRUE(contains(text, "const auto ecp_nppt = ecp_exps.size();"));
+}
+
+TEST(T2CECPFuncBodyDriverTest, LocalAndProjectedBodiesShareECPData)
+{
+    const auto data = ecp_data_def();
+
+    const auto local = generated_text("t2c_ecp_local", "LocalCorePotentialPP.hpp", [] {
+        T2CECPCPUGenerator().generate("local", 1);
+    });
+
+    const auto projected = generated_text("t2c_ecp_projected", "ProjectedCorePotentialPPForP.hpp", [] {
+        T2CProjECPCPUGenerator().generate("projected", 1, 1, false);
+    });
+
+    ASSERT_FALSE(data.empty());
+    EXPECT_TRUE(contains(local, data));
+    EXPECT_TRUE(contains(projected, data));
+
+    // primitive loop runs over merged exponents, not over raw potential primitives
+    EXPECT_TRUE(contains(local, "for (size_t l = 0; l < ecp_nppt; l++)"));
+    EXPECT_TRUE(contains(projected, "for (size_t l = 0; l < ecp_nppt; l++)"));
+    EXPECT_TRUE(contains(projected, "const auto c_norm = ecp_facts[l];"));
+}
+
+TEST(T2CProjECPFuncBodyDriverTest, BodyHoistsKetNormAndLegendreArguments)
+{
+    const auto text = generated_text("t2c_ecp_hoisting", "ProjectedCorePotentialPPForP.hpp", [] {
+        T2CProjECPCPUGenerator().generate("projected", 1, 1, false);
+    });
+
+    ASSERT_FALSE(text.empty());
+
+    const auto ket_loop = text.find("for (size_t i = 0; i < ket_blocks; i++)");
+    const auto bra_loop = text.find("for (auto j = bra_indices.first; j < bra_indices.second; j++)");
+    const auto prim_loop = text.find("for (size_t k = 0; k < bra_npgtos; k++)");
+    const auto ecp_loop = text.find("for (size_t l = 0; l < ecp_nppt; l++)");
+
+    ASSERT_NE(ket_loop, std::string::npos);
+    ASSERT_NE(bra_loop, std::string::npos);
+    ASSERT_NE(prim_loop, std::string::npos);
+    ASSERT_NE(ecp_loop, std::string::npos);
+
+    // |B| is computed once per ket block, outside of bra loop
+    const auto norm = text.find("t2cfunc::comp_coordinates_norm(pfactors, 5, 2);");
+
+    EXPECT_EQ(count(text, "t2cfunc::comp_coordinates_norm("), 1u);
+    EXPECT_LT(ket_loop, norm);
+    EXPECT_LT(norm, bra_loop);
+
+    // Legendre arguments are computed once per bra function, outside of primitive loops
+    const auto legendre = text.find("t2cfunc::comp_legendre_args(pfactors, 6, 2, 5, r_a);");
+
+    EXPECT_EQ(count(text, "t2cfunc::comp_legendre_args("), 1u);
+    EXPECT_LT(bra_loop, legendre);
+    EXPECT_LT(legendre, prim_loop);
+
+    // only exponent dependent factors remain inside ECP primitive loop
+    EXPECT_LT(ecp_loop, text.find("t2cfunc::comp_gamma_factors(pfactors, 7, 5, r_a, a_exp, c_exp);"));
+    EXPECT_LT(ecp_loop, text.find("t2cfunc::comp_l_vals(l_values, 1, pfactors, 8, 6);"));
+}
+
+TEST(T2CProjECPFuncBodyDriverTest, GeneratorWritesNoUnusedAngularTables)
+{
+    const auto text = generated_text("t2c_ecp_no_tables", "ProjectedCorePotentialAngularTables.hpp", [] {
+        T2CProjECPCPUGenerator().generate("projected", 1, 1, false);
+    });
+
+    EXPECT_TRUE(text.empty());
+}
+
+TEST(T2CProjECPFuncBodyDriverTest, TableDrivenBodyReadsAngularProjections)
+{
+    const auto text = generated_text("t2c_ecp_table_body", "ProjectedCorePotentialPSForP.hpp", [] {
+        T2CProjECPCPUGenerator().generate("projected", 1, 1, true);
+    });
+
+    ASSERT_FALSE(text.empty());
+
+    EXPECT_TRUE(contains(text, "#include \"ProjectedCorePotentialAngularTables.hpp\""));
+    EXPECT_TRUE(contains(text, "#include \"ProjectedCorePotentialRadialFunc.hpp\""));
+
+    // no primitive recursion: angular factors come from the tables
+    EXPECT_FALSE(contains(text, "ProjectedCorePotentialPrimRec"));
+    EXPECT_FALSE(contains(text, "comp_prim_projected_core_potential_ss"));
+
+    // (p| projections per bra function, (s| projections per ket lane, both outside primitive loops
+    const auto ket_projs = text.find("t2pecp::comp_angular_projections<0>(&ket_projs[n * 6], 1, r_b[0], r_b[1], r_b[2]);");
+    const auto bra_loop = text.find("for (auto j = bra_indices.first; j < bra_indices.second; j++)");
+    const auto bra_projs = text.find("t2pecp::comp_angular_projections<1>(bra_projs.data(), 1, xyz[0], xyz[1], xyz[2]);");
+    const auto prim_loop = text.find("for (size_t k = 0; k < bra_npgtos; k++)");
+    const auto radial = text.find("t2pecp::comp_radial_integrals(q_values, 1, 2, 1, pfactors, 2, r_a, a_exp, c_exp);");
+
+    ASSERT_NE(ket_projs, std::string::npos);
+    ASSERT_NE(bra_projs, std::string::npos);
+    ASSERT_NE(radial, std::string::npos);
+
+    EXPECT_LT(ket_projs, bra_loop);
+    EXPECT_LT(bra_projs, prim_loop);
+    EXPECT_LT(prim_loop, radial);
+
+    // Q(N, lambda_a, lambda_b) with N <= 1, lambda_a <= 2, lambda_b <= 1
+    EXPECT_TRUE(contains(text, "CSimdArray<double> q_values(12, ket_npgtos);"));
+    EXPECT_TRUE(contains(text, "std::vector<double> bra_projs(54, 0.0);"));
+    EXPECT_TRUE(contains(text, "fab += t_a * t_b[(m * 1 + nb) * 2 + kb] * q_values.data(((na + nb) * 3 + ka) * 2 + kb)[e];"));
+    EXPECT_TRUE(contains(text, "t2cfunc::reduce(cbuffer, 0, pbuffer, 0, 3, ket_width, ket_npgtos);"));
+    EXPECT_TRUE(contains(text, "distributor.distribute(sbuffer, bra_gto_indices, ket_gto_indices, 1, 0, j, ket_range, bra_eq_ket);"));
+}
+
+TEST(T2CProjECPFuncBodyDriverTest, AngularTablesCoverProjectorsUpToProjLmax)
+{
+    const auto text = generated_text("t2c_ecp_tables", "ProjectedCorePotentialAngularTables.hpp", [] {
+        T2CProjECPCPUGenerator().generate("projected", 2, 1, true);
+    });
+
+    ASSERT_FALSE(text.empty());
+
+    EXPECT_TRUE(contains(text, "constexpr int angular_max_proj = 1;"));
+    EXPECT_TRUE(contains(text, "constexpr int angular_max_lambda = 3;"));
+    EXPECT_TRUE(contains(text, "constexpr int angular_max_order = 2;"));
+    EXPECT_TRUE(contains(text, "constexpr int angular_nmonomials = 10;"));
+
+    // (l, m) pairs 4, (lambda, mu) pairs 16, monomials 10
+    EXPECT_TRUE(contains(text, "constexpr std::array<double, 640> angular_integrals = {"));
+
+    EXPECT_TRUE(contains(text, "case 15: return "));
+    EXPECT_FALSE(contains(text, "case 16: return "));
+}
+
+TEST(T2CProjECPFuncBodyDriverTest, AngularProjectionsReduceToSphericalHarmonics)
+{
+    // s shell: T(0, m, 0, lambda) = delta(lambda, l) Y_{l,m}(A / |A|); p_x shell with l = 0:
+    // T(x, 0, 0, 0) = -A_x Y_{0,0} and T(x, 0, 1, 1) = u_x / sqrt(4 pi).
+    const std::string driver = R"(
+#include <cmath>
+#include <cstdio>
+
+#include "ProjectedCorePotentialAngularTables.hpp"
+
+int
+main()
+{
+    const double x = 0.3, y = -0.4, z = 1.2;
+
+    const double r = std::sqrt(x * x + y * y + z * z);
+
+    const double fpi = 4.0 * std::acos(-1.0);
+
+    int nerrors = 0;
+
+    const auto check = [&](const double value, const double ref) {
+        if (std::fabs(value - ref) > 1.0e-12) nerrors++;
+    };
+
+    double sprojs[2 * 3 * 3];
+
+    t2pecp::comp_angular_projections<0>(sprojs, 2, x, y, z);
+
+    for (int m = -2; m <= 2; m++)
+    {
+        for (int lambda = 0; lambda < 3; lambda++)
+        {
+            const auto ref = (lambda == 2) ? t2pecp::real_spherical_harmonic(2, m, x / r, y / r, z / r) : 0.0;
+
+            check(sprojs[(m + 2) * 3 + lambda], ref);
+        }
+    }
+
+    check(sprojs[(0 + 2) * 3 + 2], std::sqrt(5.0 / fpi) * 0.5 * (3.0 * z * z / (r * r) - 1.0));
+
+    double pprojs[3 * 1 * 2 * 2];
+
+    t2pecp::comp_angular_projections<1>(pprojs, 0, x, y, z);
+
+    check(pprojs[0], -x / std::sqrt(fpi));
+
+    check(pprojs[1], 0.0);
+
+    check(pprojs[2], 0.0);
+
+    check(pprojs[3], x / (r * std::sqrt(fpi)));
+
+    return nerrors;
+}
+)";
+
+    EXPECT_TRUE(compiles_generated("t2c_ecp_tables_run", [] {
+        T2CProjECPCPUGenerator().generate("projected", 2, 2, true);
+    }, {{"driver.cpp", driver}}, true));
+}
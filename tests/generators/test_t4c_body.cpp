@@ -0,0 +1,298 @@
+// LITMUS: An Automated Molecular Integrals Generator
+// Copyright 2022 Z. Rinkevicius, KTH, Sweden.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <iterator>
+#include <map>
+#include <regex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "emitted_text.hpp"
+#include "spherical_harmonics.hpp"
+#include "t4c_diag_cpu_generators.hpp"
+#include "tensor.hpp"
+
+using testing_util::generated_text;
+
+namespace {
+
+/// Linear combination of source rows c_n[k] plus constant.
+struct Linear
+{
+    double constant = 0.0;
+
+    std::map<size_t, double> coefs;
+};
+
+/// Evaluates emitted sparse sum, e.g. -(1.0 / 2.0 * std::sqrt(3.0)) * (c_6[k] + c_9[k]) + c_11[k]
+/// or (1.0 / 2.0) * ckbuffer.data(6)[0] + ckbuffer.data(11)[0], into coefficients of its source rows.
+class SparseSumParser
+{
+    std::string _text;
+
+    size_t _pos = 0;
+
+    void
+    _skip()
+    {
+        while ((_pos < _text.size()) && std::isspace(static_cast<unsigned char>(_text[_pos]))) _pos++;
+    }
+
+    bool
+    _accept(const std::string& token)
+    {
+        _skip();
+
+        if (_text.compare(_pos, token.size(), token) != 0) return false;
+
+        _pos += token.size();
+
+        return true;
+    }
+
+    static Linear
+    _scale(const Linear& value, const double factor)
+    {
+        auto result = value;
+
+        result.constant *= factor;
+
+        for (auto& [row, coef] : result.coefs) coef *= factor;
+
+        return result;
+    }
+
+    Linear
+    _factor()
+    {
+        if (_accept("-")) return _scale(_factor(), -1.0);
+
+        if (_accept("std::sqrt("))
+        {
+            auto value = _sum();
+
+            _accept(")");
+
+            value.constant = std::sqrt(value.constant);
+
+            return value;
+        }
+
+        if (_accept("("))
+        {
+            auto value = _sum();
+
+            _accept(")");
+
+            return value;
+        }
+
+        Linear value;
+
+        if (_accept("c_") || _accept("ckbuffer.data("))
+        {
+            const auto first = _pos;
+
+            while (std::isdigit(static_cast<unsigned char>(_text[_pos]))) _pos++;
+
+            value.coefs[std::stoul(_text.substr(first, _pos - first))] = 1.0;
+
+            if (!_accept("[k]")) _accept(")[0]");
+        }
+        else
+        {
+            size_t len = 0;
+
+            value.constant = std::stod(_text.substr(_pos), &len);
+
+            _pos += len;
+        }
+
+        return value;
+    }
+
+    Linear
+    _product()
+    {
+        auto value = _factor();
+
+        while (true)
+        {
+            if (_accept("*"))
+            {
+                const auto rhs = _factor();
+
+                value = value.coefs.empty() ? _scale(rhs, value.constant) : _scale(value, rhs.constant);
+            }
+            else if (_accept("/"))
+            {
+                value = _scale(value, 1.0 / _factor().constant);
+            }
+            else
+            {
+                return value;
+            }
+        }
+    }
+
+    Linear
+    _sum()
+    {
+        auto value = _product();
+
+        while (true)
+        {
+            double sign = 0.0;
+
+            if (_accept("+")) sign = 1.0;
+            else if (_accept("-")) sign = -1.0;
+            else return value;
+
+            const auto rhs = _scale(_product(), sign);
+
+            value.constant += rhs.constant;
+
+            for (const auto& [row, coef] : rhs.coefs) value.coefs[row] += coef;
+        }
+    }
+
+   public:
+    explicit SparseSumParser(const std::string& text) : _text(text) {}
+
+    Linear
+    parse()
+    {
+        return _sum();
+    }
+};
+
+/// Gets index of Cartesian component in canonical tensor order.
+size_t
+cart_index(const int angmom, const TensorComponent& tcomp)
+{
+    const auto tcomps = Tensor(angmom).components();
+
+    return static_cast<size_t>(std::find(tcomps.begin(), tcomps.end(), tcomp) - tcomps.begin());
+}
+
+}  // namespace
+
+TEST(T4CFuncBodyDriverTest, DiagSparseKetRowsMatchSphericalFactors)
+{
+    const auto text = generated_text("t4c_diag_sparse", "ElectronRepulsionDiagRecDDDD.hpp", [] {
+        T4CDiagCPUGenerator().generate("electron repulsion", 2);
+    });
+
+    ASSERT_FALSE(text.empty());
+
+    // half transformation of (sd|dd) reads Cartesian |dd) block written by ket HRR
+    std::smatch match;
+
+    ASSERT_TRUE(std::regex_search(text, match, std::regex(R"(comp_ket_hrr_electron_repulsion_xxdd\(ckbuffer, (\d+),)")));
+
+    const auto cindex = std::stoul(match[1].str());
+
+    const auto first = text.find("// ket transformation pruned");
+
+    ASSERT_NE(first, std::string::npos);
+
+    const auto block = text.substr(first, text.find("// bra HRR and transformation pruned", first) - first);
+
+    const std::regex row_pattern(R"(skbuffer\.data\((\d+)\)\[0\] = ([^;]+);)");
+
+    std::map<size_t, Linear> rows;
+
+    for (auto it = std::sregex_iterator(block.begin(), block.end(), row_pattern); it != std::sregex_iterator(); ++it)
+    {
+        rows[std::stoul((*it)[1].str())] = SparseSumParser((*it)[2].str()).parse();
+    }
+
+    // (sd|dd) rows are 6 x 25 spherical rows of |dd), only some of them are read by diagonal
+    size_t nsd = 0;
+
+    for (const auto& [row, value] : rows)
+    {
+        if (row >= 150) continue;
+
+        const auto b = row / 25;
+
+        const auto i = static_cast<int>(row % 25) / 5;
+
+        const auto j = static_cast<int>(row % 25) % 5;
+
+        const auto terms = sphar::two_center_spherical_factors(2, 2, i, j);
+
+        // only non-zero Cartesian terms are read, each with its exact coefficient
+        ASSERT_EQ(value.coefs.size(), terms.size()) << row;
+
+        EXPECT_EQ(value.constant, 0.0);
+
+        for (const auto& term : terms)
+        {
+            const auto cart_cd = cindex + b * 36 + cart_index(2, term.bra) * 6 + cart_index(2, term.ket);
+
+            ASSERT_EQ(value.coefs.count(cart_cd), 1u) << row << " " << cart_cd;
+
+            EXPECT_NEAR(value.coefs.at(cart_cd), term.factor.value(), 1.0e-13) << row << " " << cart_cd;
+        }
+
+        nsd++;
+    }
+
+    EXPECT_GT(nsd, 0u);
+    EXPECT_LT(nsd, 150u);
+    EXPECT_FALSE(std::regex_search(block, std::regex(R"(\(0\.0\) \*)")));
+    EXPECT_FALSE(std::regex_search(text, std::regex(R"(t4cfunc::ket_transform)")));
+}
+
+TEST(T4CFuncBodyDriverTest, DiagKernelPrunesOffDiagonalIntermediates)
+{
+    const auto text = generated_text("t4c_diag_pruned", "ElectronRepulsionDiagRecPDPD.hpp", [] {
+        T4CDiagCPUGenerator().generate("electron repulsion", 2);
+    });
+
+    ASSERT_FALSE(text.empty());
+
+    // bra HRR is expanded inline, so (pd| and (pf| intermediates of full kernel are gone
+    EXPECT_FALSE(testing_util::contains(text, "comp_bra_hrr_electron_repulsion_"));
+    EXPECT_FALSE(std::regex_search(text, std::regex(R"(ContrRec[SPDFG][SPDFG]XX)")));
+    EXPECT_TRUE(testing_util::contains(text, "comp_ket_hrr_electron_repulsion_xxpd"));
+
+    // half transformed buffer holds (sd| and (sf| blocks, of which only diagonal reads are computed
+    EXPECT_TRUE(testing_util::contains(text, "CSimdArray<double> skbuffer(240, 1);"));
+
+    const std::regex skrow(R"(skbuffer\.data\(\d+\)\[0\] = )");
+
+    EXPECT_EQ(std::distance(std::sregex_iterator(text.begin(), text.end(), skrow), std::sregex_iterator()), 48);
+
+    EXPECT_TRUE(testing_util::contains(text, "sbuffer.data(0)[0] = (-1.0 * std::sqrt(3.0)) * ab_y * skbuffer.data(15)[0] + (1.0 * std::sqrt(3.0)) * skbuffer.data(135)[0];"));
+
+    // only diagonal (ab|ab) components of 15 x 15 spherical block are written
+    const std::regex srow(R"((^|[^k])sbuffer\.data\((\d+)\)\[0\] = )");
+
+    std::vector<size_t> written;
+
+    for (auto it = std::sregex_iterator(text.begin(), text.end(), srow); it != std::sregex_iterator(); ++it)
+    {
+        written.push_back(std::stoul((*it)[2].str()));
+    }
+
+    ASSERT_EQ(written.size(), 15u);
+
+    for (size_t ij = 0; ij < 15; ij++) EXPECT_EQ(written[ij], ij * 16);
+}
+
+TEST(T4CFuncBodyDriverTest, DiagGeneratorThrowsOnUnsupportedIntegral)
+{
+    const auto text = generated_text("t4c_diag_unsupported", "UnsupportedDiagRecSSSS.hpp", [] {
+        EXPECT_THROW(T4CDiagCPUGenerator().generate("unsupported", 0), std::invalid_argument);
+    });
+
+    EXPECT_TRUE(text.empty());
+}
@@ -0,0 +1,322 @@
+// LITMUS: An Automated Molecular Integrals Generator
+// Copyright 2022 Z. Rinkevicius, KTH, Sweden.
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <map>
+#include <regex>
+#include <string>
+#include <vector>
+
+#include "emitted_text.hpp"
+#include "eri_cost_model.hpp"
+#include "t4c_eri_tree_generators.hpp"
+#include "v4i_eri_driver.hpp"
+
+using testing_util::compiles_generated;
+using testing_util::contains;
+using testing_util::generated_text;
+
+namespace {
+
+/// Estimates Obara-Saika operation count of (ab|cd) electron repulsion integral.
+long
+os_flops(const int la, const int lb, const int lc, const int ld)
+{
+    const auto integral = I4CIntegral(I2CPair("GA", la, "GB", lb), I2CPair("GC", lc, "GD", ld), Operator("1/|r-r'|"), 0, {});
+
+    V4IElectronRepulsionDriver eri_drv;
+
+    const auto bra_ints = eri_drv.create_bra_hrr_recursion({integral,});
+
+    SI4CIntegrals ket_ints;
+
+    for (const auto& bint : bra_ints)
+    {
+        if ((bint[0] == 0) && (bint[2] > 0))
+        {
+            const auto kints = eri_drv.create_ket_hrr_recursion({bint,});
+
+            ket_ints.insert(kints.cbegin(), kints.cend());
+        }
+    }
+
+    SI4CIntegrals base_ints;
+
+    for (const auto& tints : {bra_ints, ket_ints})
+    {
+        for (const auto& tint : tints)
+        {
+            if ((tint[0] == 0) && (tint[2] == 0)) base_ints.insert(tint);
+        }
+    }
+
+    return cost::obara_saika_flops(bra_ints, ket_ints, eri_drv.create_vrr_recursion(base_ints));
+}
+
+/// Emits dispatch table of (ab|cd) electron repulsion integrals with s and p shells and first derivatives.
+std::string
+dispatch_table()
+{
+    return generated_text("t4c_dispatch_table", "T4CDispatchTable.hpp", [] {
+        T4CCallTreeGenerator().generate("electron repulsion", 1, 1);
+    });
+}
+
+}  // namespace
+
+TEST(T4CCallTreeGeneratorTest, KernelsFollowIndexLayout)
+{
+    const auto text = dispatch_table();
+
+    ASSERT_FALSE(text.empty());
+
+    EXPECT_TRUE(contains(text, "inline constexpr std::array<Kernel<T>, 32> kernels = {"));
+    EXPECT_TRUE(contains(text, "return (((forder * nang + la) * nang + lb) * nang + lc) * nang + ld;"));
+
+    // entries run over (order, la, lb, lc, ld) with ld fastest
+    const std::regex entry_pattern(R"(    ([^\n]+?),? // (\d) ([SP]{4})\n)");
+
+    std::vector<std::string> labels;
+
+    std::vector<bool> missing;
+
+    for (auto it = std::sregex_iterator(text.begin(), text.end(), entry_pattern); it != std::sregex_iterator(); ++it)
+    {
+        labels.push_back((*it)[2].str() + (*it)[3].str());
+
+        missing.push_back((*it)[1].str() == "nullptr");
+    }
+
+    ASSERT_EQ(labels.size(), 32u);
+
+    const std::string shells("SP");
+
+    size_t pos = 0;
+
+    for (int order = 0; order <= 1; order++)
+    {
+        for (int la = 0; la <= 1; la++)
+        {
+            for (int lb = 0; lb <= 1; lb++)
+            {
+                for (int lc = 0; lc <= 1; lc++)
+                {
+                    for (int ld = 0; ld <= 1; ld++)
+                    {
+                        const auto label = std::to_string(order) + shells[la] + shells[lb] + shells[lc] + shells[ld];
+
+                        EXPECT_EQ(labels[pos], label);
+
+                        // no compute functions for la > lb without derivatives, and for lc > ld
+                        EXPECT_EQ(missing[pos], ((order == 0) && (la > lb)) || (lc > ld)) << label;
+
+                        pos++;
+                    }
+                }
+            }
+        }
+    }
+
+    // geometrical kernels are adapted to plain kernel signature
+    EXPECT_TRUE(contains(text, "    &erirec::comp_electron_repulsion_pppp<T>, // 0 PPPP\n"));
+    EXPECT_TRUE(contains(text, "    &without_bra_eq_ket<T, &erirec::comp_electron_repulsion_geom1000_pssp<T>>, // 1 PSSP\n"));
+}
+
+TEST(T4CCallTreeGeneratorTest, CostsMatchObaraSaikaEstimate)
+{
+    const auto text = dispatch_table();
+
+    ASSERT_FALSE(text.empty());
+
+    const auto start = text.find("inline constexpr std::array<KernelCost, 32> costs = {{");
+
+    ASSERT_NE(start, std::string::npos);
+
+    const auto block = text.substr(start, text.find("}};", start) - start);
+
+    const std::regex cost_pattern(R"(\{(\d+), (\d+), (\d+), (\d+)\})");
+
+    std::vector<std::array<long, 4>> costs;
+
+    for (auto it = std::sregex_iterator(block.begin(), block.end(), cost_pattern); it != std::sregex_iterator(); ++it)
+    {
+        costs.push_back({std::stol((*it)[1].str()), std::stol((*it)[2].str()), std::stol((*it)[3].str()), std::stol((*it)[4].str())});
+    }
+
+    ASSERT_EQ(costs.size(), 32u);
+
+    size_t pos = 0;
+
+    for (int order = 0; order <= 1; order++)
+    {
+        for (int la = 0; la <= 1; la++)
+        {
+            for (int lb = 0; lb <= 1; lb++)
+            {
+                for (int lc = 0; lc <= 1; lc++)
+                {
+                    for (int ld = 0; ld <= 1; ld++)
+                    {
+                        const auto& tcost = costs[pos++];
+
+                        if (((order == 0) && (la > lb)) || (lc > ld))
+                        {
+                            EXPECT_EQ(tcost, (std::array<long, 4>({0, 0, 0, 0})));
+
+                            continue;
+                        }
+
+                        // s and p shells have equal numbers of Cartesian and spherical components
+                        const auto ncomps = static_cast<long>((order == 0) ? 1 : 3) * (2 * la + 1) * (2 * lb + 1) * (2 * lc + 1) * (2 * ld + 1);
+
+                        EXPECT_EQ(tcost[0], ncomps);
+                        EXPECT_EQ(tcost[1], ncomps);
+                        EXPECT_EQ(tcost[2], la + lb + lc + ld + order);
+
+                        // derivative kernels are estimated by their dominant (a + 1, b| integrals
+                        EXPECT_EQ(tcost[3], os_flops(la + order, lb, lc, ld));
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST(T4CCallTreeGeneratorTest, EmittedHeaderCompilesAndDispatches)
+{
+    const auto text = dispatch_table();
+
+    ASSERT_FALSE(text.empty());
+
+    // stand-in runtime: pair blocks and compute functions recording their calls
+
+    std::string stubs = "#include <cstddef>\n#include <utility>\n\nclass CGtoPairBlock\n{\n};\n\n";
+
+    std::map<std::string, std::string> sources;
+
+    const std::regex include_pattern(R"re(#include "(\w+\.hpp)")re");
+
+    for (auto it = std::sregex_iterator(text.begin(), text.end(), include_pattern); it != std::sregex_iterator(); ++it)
+    {
+        sources[(*it)[1].str()] = "";
+    }
+
+    // pair blocks, 9 plain and 12 derivative kernels
+    ASSERT_EQ(sources.size(), 22u);
+
+    const std::regex func_pattern(R"((without_bra_eq_ket<T, )?&(\w+)::(\w+)<T>)");
+
+    for (auto it = std::sregex_iterator(text.begin(), text.end(), func_pattern); it != std::sregex_iterator(); ++it)
+    {
+        const auto flag = !(*it)[1].matched;
+
+        stubs += "namespace " + (*it)[2].str() + " {\ntemplate <class T>\ninline auto\n" + (*it)[3].str();
+
+        stubs += "(T& distributor, const CGtoPairBlock&, const CGtoPairBlock&, const std::pair<size_t, size_t>&, const std::pair<size_t, size_t>&";
+
+        stubs += (flag) ? ", const bool bra_eq_ket) -> void\n{\n" : ") -> void\n{\n";
+
+        stubs += "distributor.name = \"" + (*it)[3].str() + "\";\n";
+
+        if (flag) stubs += "distributor.bra_eq_ket = bra_eq_ket;\n";
+
+        stubs += "}\n}\n\n";
+    }
+
+    sources["GtoPairBlock.hpp"] = stubs;
+
+    sources["driver.cpp"] = R"(
+#include <string>
+
+#include "T4CDispatchTable.hpp"
+
+struct Recorder
+{
+    std::string name;
+
+    bool bra_eq_ket = false;
+};
+
+using namespace t4cdisp;
+
+constexpr auto eri = Family::electron_repulsion;
+
+static_assert(index(eri, 0, 0, 0, 0, 0) == 0);
+static_assert(index(eri, 0, 0, 0, 0, 1) == 1);
+static_assert(index(eri, 0, 1, 0, 0, 0) == 8);
+static_assert(index(eri, 1, 0, 0, 0, 0) == 16);
+static_assert((index(eri, 1, 1, 1, 1, 1) + 1) == kernels<Recorder>.size());
+static_assert(kernels<Recorder>.size() == costs.size());
+
+static_assert(in_table(eri, 1, 1, 1, 1, 1));
+static_assert(!in_table(eri, 2, 0, 0, 0, 0));
+static_assert(!in_table(eri, -1, 0, 0, 0, 0));
+static_assert(!in_table(eri, 0, 2, 0, 0, 0));
+static_assert(!in_table(eri, 0, 0, 0, 0, -1));
+
+int
+main()
+{
+    int nerrors = 0;
+
+    size_t pos = 0;
+
+    for (int order = 0; order <= 1; order++)
+    {
+        for (int la = 0; la <= 1; la++)
+        {
+            for (int lb = 0; lb <= 1; lb++)
+            {
+                for (int lc = 0; lc <= 1; lc++)
+                {
+                    for (int ld = 0; ld <= 1; ld++)
+                    {
+                        if (index(eri, order, la, lb, lc, ld) != pos++) nerrors++;
+
+                        const bool missing = ((order == 0) && (la > lb)) || (lc > ld);
+
+                        if ((kernel<Recorder>(eri, order, la, lb, lc, ld) == nullptr) != missing) nerrors++;
+
+                        if ((cost(eri, order, la, lb, lc, ld).flops == 0) != missing) nerrors++;
+                    }
+                }
+            }
+        }
+    }
+
+    if (kernel<Recorder>(eri, 0, 2, 0, 0, 0) != nullptr) nerrors++;
+
+    if (kernel<Recorder>(eri, 2, 0, 0, 0, 0) != nullptr) nerrors++;
+
+    if (cost(eri, 0, 0, 0, 0, 2).cart_comps != 0) nerrors++;
+
+    const CGtoPairBlock bra_pairs, ket_pairs;
+
+    Recorder plain;
+
+    if (!compute(plain, eri, 0, {1, 1}, {1, 1}, bra_pairs, ket_pairs, {0, 1}, {0, 1}, true)) nerrors++;
+
+    if ((plain.name != "comp_electron_repulsion_pppp") || (!plain.bra_eq_ket)) nerrors++;
+
+    Recorder geom;
+
+    if (!compute(geom, eri, 1, {1, 0}, {0, 1}, bra_pairs, ket_pairs, {0, 1}, {0, 1}, true)) nerrors++;
+
+    if ((geom.name != "comp_electron_repulsion_geom1000_pssp") || geom.bra_eq_ket) nerrors++;
+
+    Recorder none;
+
+    if (compute(none, eri, 0, {1, 0}, {0, 0}, bra_pairs, ket_pairs, {0, 1}, {0, 1}, false)) nerrors++;
+
+    if (!none.name.empty()) nerrors++;
+
+    return nerrors;
+}
+)";
+
+    EXPECT_TRUE(compiles_generated("t4c_dispatch_compile", [] {
+        T4CCallTreeGenerator().generate("electron repulsion", 1, 1);
+    }, sources, true));
+}
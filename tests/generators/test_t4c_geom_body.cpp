@@ -0,0 +1,338 @@
+// LITMUS: An Automated Molecular Integrals Generator
+// Copyright 2022 Z. Rinkevicius, KTH, Sweden.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <map>
+#include <regex>
+#include <string>
+#include <vector>
+
+#include "emitted_text.hpp"
+#include "t4c_geom_cpu_generators.hpp"
+
+using testing_util::contains;
+using testing_util::count;
+using testing_util::generated_files;
+using testing_util::generated_text;
+
+namespace {
+
+/// The (10|10) derivative of (pp|pp) electron repulsion integrals.
+const std::array<int, 5> geom1010 = {1, 0, 0, 1, 0};
+
+/// Collects integer captures of regex group over all matches in text.
+std::vector<size_t>
+captures(const std::string& text, const std::regex& pattern, const size_t group)
+{
+    std::vector<size_t> values;
+
+    for (auto it = std::sregex_iterator(text.begin(), text.end(), pattern); it != std::sregex_iterator(); ++it)
+    {
+        values.push_back(std::stoul((*it)[group].str()));
+    }
+
+    return values;
+}
+
+}  // namespace
+
+TEST(T4CGeomFuncBodyDriverTest, JKBodyOmitsSphericalBuffer)
+{
+    const auto text = generated_text("t4c_jk_sbuffer", "ElectronRepulsionGeom1010JKRecPPPP.hpp", [] {
+        T4CGeomCPUGenerator().generate_jk("electron repulsion", 1, geom1010, 0);
+    });
+
+    ASSERT_FALSE(text.empty());
+
+    // skbuffer is still set up, sbuffer is never allocated, sized, zeroed, or distributed
+    EXPECT_TRUE(contains(text, "skbuffer.set_active_width(ket_width);"));
+    EXPECT_TRUE(contains(text, "skbuffer.zero();"));
+    EXPECT_FALSE(std::regex_search(text, std::regex("[^k]sbuffer")));
+    EXPECT_FALSE(contains(text, "distributor"));
+}
+
+TEST(T4CGeomFuncBodyDriverTest, JKBraTransformMatchesStandardOffsets)
+{
+    const auto standard = generated_text("t4c_jk_standard", "ElectronRepulsionGeom1010RecPPPP.hpp", [] {
+        T4CGeomCPUGenerator().generate("electron repulsion", 1, geom1010, 0);
+    });
+
+    const auto jk = generated_text("t4c_jk_fused", "ElectronRepulsionGeom1010JKRecPPPP.hpp", [] {
+        T4CGeomCPUGenerator().generate_jk("electron repulsion", 1, geom1010, 0);
+    });
+
+    // source offsets of skbuffer in standard bra_transform<1, 1> calls, one per geometrical component
+    const auto offsets = captures(standard, std::regex(R"(t4cfunc::bra_transform<1, 1>\(sbuffer, \d+, skbuffer, (\d+), 1, 1\);)"), 1);
+
+    ASSERT_EQ(offsets.size(), 9u);
+
+    const auto gcomps = captures(jk, std::regex(R"(for \(size_t g = 0; g < (\d+); g\+\+\))"), 1);
+
+    ASSERT_EQ(gcomps, std::vector<size_t>({9}));
+
+    // fused rows read c_<cart_ab> = skbuffer.data(row + g * stride + cd)
+    const std::regex row_pattern(R"(const auto c_(\d+) = skbuffer\.data\((\d+) \+ g \* (\d+) \+ cd\);)");
+
+    std::map<size_t, std::pair<size_t, size_t>> rows;
+
+    for (auto it = std::sregex_iterator(jk.begin(), jk.end(), row_pattern); it != std::sregex_iterator(); ++it)
+    {
+        rows[std::stoul((*it)[1].str())] = {std::stoul((*it)[2].str()), std::stoul((*it)[3].str())};
+    }
+
+    // all 3 x 3 Cartesian (pp| rows are read, each 9 spherical |pp) components apart
+    ASSERT_EQ(rows.size(), 9u);
+
+    const auto [row0, stride] = rows.at(0);
+
+    EXPECT_EQ(stride, 81u);
+
+    for (const auto& [cart_ab, row] : rows)
+    {
+        EXPECT_EQ(row.first, row0 + cart_ab * 9) << cart_ab;
+        EXPECT_EQ(row.second, stride) << cart_ab;
+    }
+
+    for (size_t g = 0; g < offsets.size(); g++)
+    {
+        EXPECT_EQ(offsets[g], row0 + g * stride) << g;
+    }
+
+    // Fock indices use spherical component strides of each center
+    EXPECT_TRUE(contains(jk, "const auto c_off = (cd / 3) * c_dim;"));
+    EXPECT_TRUE(contains(jk, "const auto d_off = (cd % 3) * d_dim;"));
+    EXPECT_TRUE(contains(jk, "accumulator.accumulate(g, a_gto + 2 * a_dim, b_gto + 2 * b_dim, i_c, i_d, "));
+}
+
+TEST(T4CGeomFuncBodyDriverTest, FlatBodyReducesLanesPerContractedPair)
+{
+    const auto standard = generated_text("t4c_flat_standard", "ElectronRepulsionGeom1010RecPPPP.hpp", [] {
+        T4CGeomCPUGenerator().generate("electron repulsion", 1, geom1010, 0);
+    });
+
+    const auto flat = generated_text("t4c_flat_lanes", "ElectronRepulsionGeom1010FlatRecPPPP.hpp", [] {
+        T4CGeomCPUGenerator().generate_flat("electron repulsion", 1, geom1010, 0);
+    });
+
+    ASSERT_FALSE(flat.empty());
+
+    // every contraction of standard body becomes segmented reduction with same buffer indices
+    const std::regex reduce_pattern(R"(t2cfunc::reduce\(cbuffer, (\d+), pbuffer, (\d+), (\d+), ket_width, ket_npgtos\);)");
+
+    const std::regex lanes_pattern(R"(reduce_lanes\((\d+), (\d+), (\d+)\);)");
+
+    std::vector<std::string> reduced, segmented;
+
+    for (auto it = std::sregex_iterator(standard.begin(), standard.end(), reduce_pattern); it != std::sregex_iterator(); ++it)
+    {
+        reduced.push_back((*it)[1].str() + ":" + (*it)[2].str() + ":" + (*it)[3].str());
+    }
+
+    for (auto it = std::sregex_iterator(flat.begin(), flat.end(), lanes_pattern); it != std::sregex_iterator(); ++it)
+    {
+        segmented.push_back((*it)[1].str() + ":" + (*it)[2].str() + ":" + (*it)[3].str());
+    }
+
+    ASSERT_FALSE(reduced.empty());
+    EXPECT_EQ(reduced, segmented);
+    EXPECT_FALSE(contains(flat, "t2cfunc::reduce("));
+
+    // each contracted pair of batch sums its own contiguous primitive lanes
+    EXPECT_TRUE(contains(flat, "for (auto l = ket_offsets[m]; l < ket_offsets[m + 1]; l++)"));
+    EXPECT_TRUE(contains(flat, "cvals[m - ket_range.first] += pvals[l - lane_first];"));
+}
+
+TEST(T4CGeomFuncBodyDriverTest, FlatBodyPacksPairsIntoLaneBatches)
+{
+    const auto flat = generated_text("t4c_flat_packing", "ElectronRepulsionGeom1010FlatRecPPPP.hpp", [] {
+        T4CGeomCPUGenerator().generate_flat("electron repulsion", 1, geom1010, 0);
+    });
+
+    ASSERT_FALSE(flat.empty());
+
+    // ket side data comes from all ket pair blocks, not from single block
+    EXPECT_FALSE(contains(flat, "const auto c_coords = ket_gto_pair_block.bra_coordinates();"));
+    EXPECT_TRUE(contains(flat, "for (const auto& ket_gto_pair_block : ket_gto_pair_blocks)"));
+    EXPECT_TRUE(contains(flat, "ket_offsets.push_back(ket_offsets.back() + npgtos);"));
+
+    // batch grows while primitive lanes of its pairs fit into SIMD width times largest pair count
+    EXPECT_TRUE(contains(flat, "const auto ket_lanes = simd::width<double>() * ket_npgtos;"));
+    EXPECT_TRUE(contains(flat, "while ((ket_last < ket_dim) && ((ket_offsets[ket_last + 1] - ket_offsets[ket_first]) <= ket_lanes)) ket_last++;"));
+    EXPECT_TRUE(contains(flat, "pfactors.data(3)[l] = ((lane_first + l) < lane_last) ? cd_lane_norms[m] : 0.0;"));
+
+    // contracted buffers hold pairs of whole batch
+    EXPECT_TRUE(std::regex_search(flat, std::regex(R"(CSimdArray<double> cbuffer\(\d+, ket_npgtos\);)")));
+    EXPECT_TRUE(std::regex_search(flat, std::regex(R"(CSimdArray<double> skbuffer\(\d+, ket_npgtos\);)")));
+    EXPECT_TRUE(std::regex_search(flat, std::regex(R"(CSimdArray<double> sbuffer\(\d+, ket_npgtos\);)")));
+    EXPECT_TRUE(contains(flat, "ket_first = ket_last;"));
+}
+
+TEST(T4CGeomFuncBodyDriverTest, PrimScreeningBoundsBraPairsBeforeBoysFunction)
+{
+    const auto text = generated_text("t4c_prim_screening", "ElectronRepulsionGeom1010RecPPPP.hpp", [] {
+        T4CGeomCPUGenerator().generate("electron repulsion", 1, geom1010, 12);
+    });
+
+    ASSERT_FALSE(text.empty());
+
+    // ket side of bound is reduced once per batch, before bra loop
+    const auto ket_bound = text.find("#pragma omp simd aligned(c_exps, d_exps, cd_ovls, cd_norms : 64) reduction(max : cd_fmax, cd_qmax)");
+    const auto bra_loop = text.find("for (auto j = bra_indices.first; j < bra_indices.second; j++)");
+
+    ASSERT_NE(ket_bound, std::string::npos);
+    ASSERT_NE(bra_loop, std::string::npos);
+    EXPECT_LT(ket_bound, bra_loop);
+    EXPECT_TRUE(contains(text, "const auto fqs = fss * std::sqrt(c_exps[l] + d_exps[l]);"));
+
+    // bound carries (ss|ss) Coulomb factor 2 / sqrt(pi) sqrt(pq / (p + q))
+    const auto bound = text.find("const auto fbound = 1.1283791670955126 * std::fabs(ab_ovl * ab_norm) * std::min(std::sqrt(a_exp + b_exp) * cd_fmax, cd_qmax);");
+    const auto skip = text.find("if (fbound < 1.0e-12) continue;");
+
+    ASSERT_NE(bound, std::string::npos);
+    ASSERT_NE(skip, std::string::npos);
+    EXPECT_LT(bra_loop, bound);
+    EXPECT_LT(bound, skip);
+
+    // skipped primitive pairs do not evaluate Boys function or VRR
+    EXPECT_LT(skip, text.find("t4cfunc::comp_boys_args("));
+    EXPECT_LT(skip, text.find("erirec::comp_prim_electron_repulsion_ssss("));
+    EXPECT_TRUE(contains(text, "#include <algorithm>"));
+    EXPECT_TRUE(contains(text, "#include <cmath>"));
+}
+
+TEST(T4CGeomFuncBodyDriverTest, NoPrimScreeningWithoutThreshold)
+{
+    const auto text = generated_text("t4c_no_prim_screening", "ElectronRepulsionGeom1010RecPPPP.hpp", [] {
+        T4CGeomCPUGenerator().generate("electron repulsion", 1, geom1010, 0);
+    });
+
+    ASSERT_FALSE(text.empty());
+
+    EXPECT_FALSE(contains(text, "cd_fmax"));
+    EXPECT_FALSE(contains(text, "fbound"));
+}
+
+TEST(T4CGeomFuncBodyDriverTest, HessianWritesOneHeaderPerQuadruple)
+{
+    const auto fnames = generated_files("t4c_hessian_files", [] {
+        T4CGeomCPUGenerator().generate_hessian("electron repulsion", 1, 0);
+    });
+
+    // all 2^4 quadruples of s and p shells, (cd) symmetry is not used, and no per-pattern headers
+    ASSERT_EQ(fnames.size(), 16u);
+
+    for (const auto abcd : {"SSSS", "SPSP", "PSSP", "PPPS", "SSPP", "PPPP"})
+    {
+        EXPECT_TRUE(std::find(fnames.begin(), fnames.end(), "ElectronRepulsionGeomHessianRec" + std::string(abcd) + ".hpp") != fnames.end());
+    }
+
+    for (const auto& fname : fnames)
+    {
+        EXPECT_EQ(fname.rfind("ElectronRepulsionGeomHessianRec", 0), 0u);
+    }
+}
+
+TEST(T4CGeomFuncBodyDriverTest, HessianBuildsRecursionBuffersOnce)
+{
+    const auto text = generated_text("t4c_hessian_buffers", "ElectronRepulsionGeomHessianRecSPSP.hpp", [] {
+        T4CGeomCPUGenerator().generate_hessian("electron repulsion", 1, 0);
+    });
+
+    ASSERT_FALSE(text.empty());
+
+    // one set of VRR/HRR buffers and one loop nest serve all five derivative patterns
+    for (const auto buffer : {"pbuffer", "cbuffer", "ckbuffer", "skbuffer", "sbuffer"})
+    {
+        EXPECT_EQ(count(text, "CSimdArray<double> " + std::string(buffer) + "("), 1u);
+    }
+
+    EXPECT_EQ(count(text, "for (size_t i = 0; i < ket_blocks; i++)"), 1u);
+    EXPECT_EQ(count(text, "for (auto j = bra_indices.first; j < bra_indices.second; j++)"), 1u);
+    EXPECT_EQ(count(text, "for (int k = 0; k < bra_npgtos; k++)"), 1u);
+
+    // every VRR, ket HRR, and bra HRR call is emitted once
+    const std::regex call_pattern(R"(erirec::comp_(prim|ket_hrr|bra_hrr)_electron_repulsion_\w+\([^;]*\);)");
+
+    std::map<std::string, size_t> calls;
+
+    for (auto it = std::sregex_iterator(text.begin(), text.end(), call_pattern); it != std::sregex_iterator(); ++it)
+    {
+        calls[(*it)[0].str()]++;
+    }
+
+    ASSERT_FALSE(calls.empty());
+
+    for (const auto& [call, ncalls] : calls)
+    {
+        EXPECT_EQ(ncalls, 1u) << call;
+    }
+
+    EXPECT_TRUE(contains(text, "erirec::comp_bra_hrr_electron_repulsion_"));
+    EXPECT_TRUE(contains(text, "erirec::comp_prim_electron_repulsion_ssss("));
+}
+
+TEST(T4CGeomFuncBodyDriverTest, HessianDistributesDisjointSphericalSlices)
+{
+    const auto text = generated_text("t4c_hessian_slices", "ElectronRepulsionGeomHessianRecSPSP.hpp", [] {
+        T4CGeomCPUGenerator().generate_hessian("electron repulsion", 1, 0);
+    });
+
+    ASSERT_FALSE(text.empty());
+
+    // (sp|sp) blocks hold 3 x 3 spherical components per geometrical component
+    const auto sbuffer = captures(text, std::regex(R"(CSimdArray<double> sbuffer\((\d+), 1\);)"), 1);
+
+    ASSERT_EQ(sbuffer, std::vector<size_t>({270}));
+
+    const std::regex distribute_pattern(R"(distributor_geom(\d{4})\.distribute\(sbuffer, (\d+), )");
+
+    std::vector<std::string> patterns;
+
+    std::vector<size_t> offsets;
+
+    for (auto it = std::sregex_iterator(text.begin(), text.end(), distribute_pattern); it != std::sregex_iterator(); ++it)
+    {
+        patterns.push_back((*it)[1].str());
+
+        offsets.push_back(std::stoul((*it)[2].str()));
+    }
+
+    ASSERT_EQ(patterns, std::vector<std::string>({"1000", "0100", "2000", "1100", "1010"}));
+
+    // 3, 3, 6, 9, and 9 geometrical components
+    ASSERT_EQ(offsets, std::vector<size_t>({0, 27, 54, 108, 189}));
+
+    offsets.push_back(270);
+
+    // bra transforms preceding each distribute write only into slice of that pattern
+    const std::regex transform_pattern(R"(t4cfunc::bra_transform<0, 1>\(sbuffer, (\d+), skbuffer, \d+, 0, 1\);)");
+
+    std::vector<size_t> rows(270, 0);
+
+    size_t pos = 0;
+
+    for (size_t i = 0; i < 5; i++)
+    {
+        const auto end = text.find("distributor_geom" + patterns[i] + ".distribute(", pos);
+
+        ASSERT_NE(end, std::string::npos);
+
+        const auto block = text.substr(pos, end - pos);
+
+        for (const auto row : captures(block, transform_pattern, 1))
+        {
+            EXPECT_GE(row, offsets[i]);
+            EXPECT_LT(row, offsets[i + 1]);
+
+            for (size_t k = row; k < row + 9; k++) rows[k]++;
+        }
+
+        pos = end + 1;
+    }
+
+    // slices cover sbuffer exactly once
+    EXPECT_EQ(std::count(rows.begin(), rows.end(), 1), 270);
+}
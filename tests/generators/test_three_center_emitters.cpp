@@ -0,0 +1,94 @@
+// LITMUS: An Automated Molecular Integrals Generator
+// Copyright 2022 Z. Rinkevicius, KTH, Sweden.
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "config.hpp"
+#include "ltm.hpp"
+#include "run_configuration.hpp"
+#include "three_center_generators.hpp"
+
+namespace {
+
+cfg::RunConfiguration
+eri_config(int max_ang_mom)
+{
+    cfg::RunConfiguration run_config;
+    run_config.integral_type = cfg::IntegralType::three_center;
+    run_config.operator_type = cfg::OperatorType::electron_repulsion;
+    run_config.max_ang_mom   = max_ang_mom;
+    return run_config;
+}
+
+// Generates into memory and returns the content of one emitted file (empty if
+// it was not emitted).
+std::string
+emitted(const cfg::RunConfiguration& run_config, const std::string& name)
+{
+    for (const auto& file : ltm::generate(run_config))
+    {
+        if (file.name == name) return file.content;
+    }
+
+    return std::string();
+}
+
+}  // namespace
+
+TEST(ThreeCenterEmittersTest, EmitsKernelsForSymmetricKetPairs)
+{
+    ost::MemorySink sink;
+
+    ThreeCenterGenerator().generate(eri_config(1), sink);
+
+    // A in {S, P} times the ket pairs SS, SP, PP (D >= C): six .hpp/.cpp pairs.
+    EXPECT_EQ(sink.files().size(), 12u);
+
+    const auto hpp = emitted(eri_config(1), "ObaraSaikaThreeCenterElectronRepulsionPPP.hpp");
+    EXPECT_NE(hpp.find("namespace os3c::eri {"), std::string::npos);
+    EXPECT_NE(hpp.find("compute_p_p_p(const osfunc::CBasisFunctionBlock& aux,\n"
+                       "              const osfunc::CBasisFunctionPair& pair) -> osfunc::CArray<double>;"),
+              std::string::npos);
+    EXPECT_NE(hpp.find("#include \"BasisFunctionBlock.hpp\""), std::string::npos);
+
+    EXPECT_TRUE(emitted(eri_config(1), "ObaraSaikaThreeCenterElectronRepulsionSPS.cpp").empty());
+}
+
+TEST(ThreeCenterEmittersTest, BoysSeededVrrThenKetHrr)
+{
+    const auto ppp = emitted(eri_config(1), "ObaraSaikaThreeCenterElectronRepulsionPPP.cpp");
+
+    // Boys values up to m = la + lc + ld seed (s|ss)^m.
+    EXPECT_NE(ppp.find("const auto bf = osfunc::compute_boys_function(bt, 3);"), std::string::npos);
+    EXPECT_NE(ppp.find("const auto sss_3 = osfunc::compute_electron_repulsion(aux, pair, bf, 3);"),
+              std::string::npos);
+
+    // ket VRR with QD/WQ, bra VRR with WA, arguments as V3IElectronRepulsionDriver
+    // expands them.
+    EXPECT_NE(ppp.find("os3c::vrr::eri::compute_s_d(aux, pair, sss_1, sss_2, ssp_1, ssp_2, qd, wq, ssd_1);"),
+              std::string::npos);
+    EXPECT_NE(ppp.find("os3c::vrr::eri::compute_p_d(aux, pair, ssp_1, ssd_1, wa, psd_0);"), std::string::npos);
+    EXPECT_LT(ppp.find("ssd_1);"), ppp.find("psd_0);"));
+
+    // contracted (P|SP), (P|SD) feed the ket HRR, then the spherical transform.
+    EXPECT_NE(ppp.find("osfunc::contract(cpsd, psd_0);"), std::string::npos);
+    EXPECT_NE(ppp.find("os3c::hrr::compute_x_p_p(3, cpsp, cpsd, cd, cppp);"), std::string::npos);
+    EXPECT_NE(ppp.find("osfunc::transform<1, 1, 1>(buffer, cppp);"), std::string::npos);
+
+    // (S|SS) is the contracted zeroth-order seed.
+    const auto sss = emitted(eri_config(1), "ObaraSaikaThreeCenterElectronRepulsionSSS.cpp");
+    EXPECT_NE(sss.find("osfunc::contract(buffer, sss_0);"), std::string::npos);
+    EXPECT_EQ(sss.find("os3c::vrr::"), std::string::npos);
+}
+
+TEST(ThreeCenterEmittersTest, UnsupportedOperatorThrows)
+{
+    auto run_config = eri_config(0);
+    run_config.operator_type = cfg::OperatorType::overlap;
+
+    ost::MemorySink sink;
+
+    EXPECT_THROW(ThreeCenterGenerator().generate(run_config, sink), cfg::ConfigError);
+}
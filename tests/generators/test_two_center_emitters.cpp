@@ -154,8 +154,8 @@ TEST(TwoCenterEmittersTest, OverlapEmitsWorkflowOtherOperatorsStub)
     const auto ovl = read_file(ovl_dir / "ObaraSaikaTwoCenterOverlapSS.cpp");
     EXPECT_NE(ovl.find("osfunc::contract(buffer, osfunc::compute_overlap(pair));"), std::string::npos);
 
-    // only the overlap kernels are generated so far; other operators return the
-    // zeroed buffer with a TODO and call no kernels.
+    // the kinetic energy kernels are not generated yet; it returns the zeroed
+    // buffer with a TODO and calls no kernels.
     const auto kin_dir =
         generate_in_temp_dir(config_for(cfg::OperatorType::kinetic_energy, 0), "kin_seed");
     const auto kin = read_file(kin_dir / "ObaraSaikaTwoCenterKineticEnergySS.cpp");
@@ -166,8 +166,56 @@ TEST(TwoCenterEmittersTest, OverlapEmitsWorkflowOtherOperatorsStub)
     const auto eri_dir =
         generate_in_temp_dir(config_for(cfg::OperatorType::electron_repulsion, 0), "eri_seed");
     const auto eri = read_file(eri_dir / "ObaraSaikaTwoCenterElectronRepulsionSS.cpp");
-    EXPECT_NE(eri.find("not generated yet"), std::string::npos);
+    EXPECT_EQ(eri.find("not generated yet"), std::string::npos);
     EXPECT_EQ(eri.find("osfunc::compute_overlap"), std::string::npos);
+    EXPECT_NE(eri.find("osfunc::contract(buffer, ss_0);"), std::string::npos);
+}
+
+TEST(TwoCenterEmittersTest, ElectronRepulsionSeedsBoysThenOrderIndexedVrr)
+{
+    const auto dir = generate_in_temp_dir(config_for(cfg::OperatorType::electron_repulsion, 1), "eri");
+
+    // (P|1/|r-r'||P): F_m(T) for m = 0..2 seeds (s|s)^m, the ket VRR builds the
+    // (0|k)^m closure with WB, and the zeroth orders are contracted for the HRR.
+    const auto pp = read_file(dir / "ObaraSaikaTwoCenterElectronRepulsionPP.cpp");
+    EXPECT_NE(pp.find("// Boys function arguments T = rho |AB|^2 and values F_m(T), m = 0, ..., 2"),
+              std::string::npos);
+    EXPECT_NE(pp.find("const auto bt = osfunc::compute_boys_argument(pair);"), std::string::npos);
+    EXPECT_NE(pp.find("const auto bf = osfunc::compute_boys_function(bt, 2);"), std::string::npos);
+    EXPECT_NE(pp.find("const auto ss_2 = osfunc::compute_electron_repulsion(pair, bf, 2);"), std::string::npos);
+    EXPECT_NE(pp.find("const auto wb = osfunc::compute_wb(pair);"), std::string::npos);
+    EXPECT_NE(pp.find("os2c::vrr::eri::compute_p(pair, ss_1, wb, sp_0);"), std::string::npos);
+    EXPECT_NE(pp.find("os2c::vrr::eri::compute_d(pair, sp_1, ss_0, ss_1, wb, sd_0);"), std::string::npos);
+    EXPECT_LT(pp.find("compute_p(pair, ss_2, wb, sp_1)"), pp.find("compute_d(pair, sp_1"));
+    EXPECT_NE(pp.find("osfunc::contract(csd, sd_0);"), std::string::npos);
+    EXPECT_NE(pp.find("os2c::hrr::compute_p_p(csp, csd, ab, buffer);"), std::string::npos);
+    EXPECT_NE(pp.find("#include \"ObaraSaikaTwoCenterElectronRepulsionVrrCartD.hpp\""), std::string::npos);
+
+    // (P|1/|r-r'||S): the bra is built with WA, then contracted and transformed.
+    const auto ps = read_file(dir / "ObaraSaikaTwoCenterElectronRepulsionPS.cpp");
+    EXPECT_NE(ps.find("os2c::vrr::eri::compute_p(pair, ss_1, wa, ps_0);"), std::string::npos);
+    EXPECT_NE(ps.find("osfunc::transform<1, 0>(buffer, cps);"), std::string::npos);
+    EXPECT_EQ(ps.find("os2c::hrr::"), std::string::npos);
+}
+
+TEST(TwoCenterEmittersTest, RangeSeparatedOperatorsFuseSeedsAndReuseCoulombVrr)
+{
+    const auto dir = generate_in_temp_dir(config_for(cfg::OperatorType::short_range_electron_repulsion, 1), "erfc");
+
+    // the header takes the runtime omega, alpha, beta after the pair.
+    const auto hpp = read_file(dir / "ObaraSaikaTwoCenterShortRangeElectronRepulsionPP.hpp");
+    EXPECT_NE(hpp.find("namespace os2c::erfc {"), std::string::npos);
+    EXPECT_NE(hpp.find("const double beta) -> osfunc::CArray<double>;"), std::string::npos);
+
+    // erfc = 1 - erf enters as the weights (alpha + beta, -beta) of the fused
+    // seeds, and the Coulomb VRR is reused unchanged.
+    const auto pp = read_file(dir / "ObaraSaikaTwoCenterShortRangeElectronRepulsionPP.cpp");
+    EXPECT_NE(pp.find("const auto bt_w = osfunc::compute_boys_argument(pair, omega);"), std::string::npos);
+    EXPECT_NE(pp.find("const auto ss_2 = osfunc::compute_range_separated_electron_repulsion(pair, bf, bf_w, 2, "
+                      "omega, alpha + beta, -beta);"),
+              std::string::npos);
+    EXPECT_NE(pp.find("os2c::vrr::eri::compute_d(pair, sp_1, ss_0, ss_1, wb, sd_0);"), std::string::npos);
+    EXPECT_EQ(pp.find("compute_electron_repulsion("), std::string::npos);
 }
 
 TEST(TwoCenterEmittersTest, HrrTargetsBuildCartesianVrrLadderThenContract)
@@ -241,3 +289,35 @@ TEST(TwoCenterEmittersTest, MakeEmitterRejectsNothingForSupportedCpuCpp)
     // the default configuration targets cpu/C++, for which an emitter exists.
     EXPECT_NO_THROW({ generate_in_temp_dir(overlap_config(0), "supported"); });
 }
+
+TEST(TwoCenterEmittersTest, PrecisionSelectsTypesNamesAndKernels)
+{
+    auto run_config = overlap_config(1);
+
+    run_config.precision = cfg::Precision::fp32;
+
+    const auto dir = generate_in_temp_dir(run_config, "fp32");
+
+    // the workflow is tagged and namespaced by precision, so it never clashes with fp64.
+    const auto hpp = read_file(dir / "ObaraSaikaTwoCenterOverlapPPFp32.hpp");
+    EXPECT_NE(hpp.find("namespace os2c::ovl::fp32"), std::string::npos);
+    EXPECT_NE(hpp.find("-> osfunc::CArray<float>;"), std::string::npos);
+
+    const auto pp = read_file(dir / "ObaraSaikaTwoCenterOverlapPPFp32.cpp");
+    EXPECT_NE(pp.find("osfunc::compute_overlap<float>(pair)"), std::string::npos);
+    EXPECT_NE(pp.find("osfunc::CArray<float> sp(nprims * 3, npairs);"), std::string::npos);
+    EXPECT_NE(pp.find("#include \"ObaraSaikaTwoCenterOverlapVrrCartPFp32.hpp\""), std::string::npos);
+    EXPECT_NE(pp.find("#include \"ObaraSaikaTwoCenterHrrPPFp32.hpp\""), std::string::npos);
+    EXPECT_EQ(pp.find("double"), std::string::npos);
+
+    // mixed: float primitives, double contraction and result.
+    run_config.precision = cfg::Precision::mixed;
+
+    const auto mixed = read_file(generate_in_temp_dir(run_config, "mixed") / "ObaraSaikaTwoCenterOverlapPPMixed.cpp");
+    EXPECT_NE(mixed.find("osfunc::compute_overlap<float>(pair)"), std::string::npos);
+    EXPECT_NE(mixed.find("osfunc::CArray<float> sp(nprims * 3, npairs);"), std::string::npos);
+    EXPECT_NE(mixed.find("osfunc::CArray<double> csp(3, npairs);"), std::string::npos);
+    EXPECT_NE(mixed.find("osfunc::compute_ab(pair)"), std::string::npos);
+    EXPECT_NE(mixed.find("-> osfunc::CArray<double>\n{"), std::string::npos);
+    EXPECT_NE(mixed.find("#include \"ObaraSaikaTwoCenterHrrPP.hpp\""), std::string::npos);
+}
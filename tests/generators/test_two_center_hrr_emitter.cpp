@@ -213,3 +213,70 @@ TEST(TwoCenterHrrGeneratorTest, RecursionTypeSelectsTransferSide)
     EXPECT_TRUE(std::filesystem::exists(ket / "ObaraSaikaTwoCenterHrrDP.hpp"));
     EXPECT_FALSE(std::filesystem::exists(ket / "ObaraSaikaTwoCenterHrrPD.hpp"));
 }
+
+TEST(TwoCenterHrrEmitterTest, Fp32KernelUsesFloatTypesAndLiterals)
+{
+    const auto src = format_hrr_kernel(2, 2, cfg::Precision::fp32);
+
+    EXPECT_TRUE(contains(src, "const osfunc::CArray<float>& sd,"));
+    EXPECT_TRUE(contains(src, "0.25f * (sd_0[i] + sd_3[i] - 2.0f * sd_5[i]) * ab_x[i] * ab_x[i]"));
+    EXPECT_FALSE(contains(src, "double"));
+
+    // mixed precision transfers contracted integrals, so it keeps the double kernel.
+    EXPECT_EQ(format_hrr_kernel(2, 2, cfg::Precision::mixed), format_hrr_kernel(2, 2));
+}
+
+TEST(TwoCenterHrrGeneratorTest, Fp32TagsFileNames)
+{
+    auto run_config = hrr_config(cfg::RecursionType::hrr_bra_ket, 1, 1);
+
+    run_config.precision = cfg::Precision::fp32;
+
+    const auto dir = generate_in_temp_dir(run_config, "fp32");
+    EXPECT_TRUE(std::filesystem::exists(dir / "ObaraSaikaTwoCenterHrrPPFp32.hpp"));
+    EXPECT_TRUE(contains(read_file(dir / "ObaraSaikaTwoCenterHrrPPFp32.cpp"), "#include \"ObaraSaikaTwoCenterHrrPPFp32.hpp\""));
+}
+
+TEST(TwoCenterHrrEmitterTest, TableTabulatesSparseSphericalTerms)
+{
+    const auto table = format_hrr_table(1, 2);
+
+    EXPECT_TRUE(contains(table, "struct HrrTable<1, 2>"));
+    EXPECT_TRUE(contains(table, "base_sizes = {6, 10};"));
+    EXPECT_TRUE(contains(table, "nrows = 16;"));
+
+    // CSR offsets: one entry per spherical component plus the end
+    EXPECT_TRUE(contains(table, "std::array<int, 16> offsets = {0, 2, 4, 10,"));
+
+    // sqrt(3) (s|d) row coefficients carry the AB power, the (s|f) rows none
+    EXPECT_TRUE(contains(table, "{1, -1.7320508075688772, 0, 1, 0},  // component 0"));
+    EXPECT_TRUE(contains(table, "{9, 1.7320508075688772, 0, 0, 0},  // component 0"));
+}
+
+TEST(TwoCenterHrrEmitterTest, TemplateKernelFoldsTermsAtCompileTime)
+{
+    const auto kernel = format_hrr_template_kernel();
+
+    EXPECT_TRUE(contains(kernel, "struct HrrTerm"));
+    EXPECT_TRUE(contains(kernel, "template <int LA, int LB>\nstruct HrrTable;"));
+    EXPECT_TRUE(contains(kernel, "constexpr auto t = Table::terms[K];"));
+    EXPECT_TRUE(contains(kernel, "(T(0) + ... + term<Table, first + K>("));
+    EXPECT_TRUE(contains(kernel, "compute(const osfunc::CArray<T>& ab, osfunc::CArray<T>& target, const Bases&... bases)"));
+}
+
+TEST(TwoCenterHrrGeneratorTest, TemplatedFormWritesTablesOnly)
+{
+    auto run_config = hrr_config(cfg::RecursionType::hrr_bra, 1, 2);
+
+    run_config.kernel_form = cfg::KernelForm::templated;
+
+    const auto dir = generate_in_temp_dir(run_config, "templated");
+    EXPECT_TRUE(std::filesystem::exists(dir / "ObaraSaikaTwoCenterHrrKernel.hpp"));
+    EXPECT_TRUE(std::filesystem::exists(dir / "ObaraSaikaTwoCenterHrrTablePD.hpp"));
+    EXPECT_FALSE(std::filesystem::exists(dir / "ObaraSaikaTwoCenterHrrTableDP.hpp"));
+    EXPECT_FALSE(std::filesystem::exists(dir / "ObaraSaikaTwoCenterHrrPD.cpp"));
+
+    const auto table = read_file(dir / "ObaraSaikaTwoCenterHrrTablePD.hpp");
+    EXPECT_TRUE(contains(table, "#include \"ObaraSaikaTwoCenterHrrKernel.hpp\""));
+    EXPECT_TRUE(contains(table, "namespace os2c::hrr {"));
+}
@@ -191,3 +191,45 @@ TEST(TwoCenterVrrGeneratorTest, SphericalWritesKernelPairs)
     const auto cpp = read_file(dir / "ObaraSaikaTwoCenterOverlapVrrSphD.cpp");
     EXPECT_TRUE(contains(cpp, "#include <cmath>"));
 }
+
+TEST(TwoCenterVrrEmitterTest, PrecisionSelectsValueTypesAndLiterals)
+{
+    // fp32: float throughout, float literals, fe narrowed from the double exponents.
+    const auto cart = format_vrr_cartesian_kernel(3, cfg::Precision::fp32);
+
+    EXPECT_TRUE(contains(cart, "const osfunc::CArray<float>& sd,"));
+    EXPECT_TRUE(contains(cart, "osfunc::CArray<float>& sf)"));
+    EXPECT_TRUE(contains(cart, "const auto fe = static_cast<float>(1.0 / (2.0 * (bra_exps[p] + ket_exps[q])));"));
+    EXPECT_TRUE(contains(cart, "sf_0[i] = pc_x[i] * sd_0[i] + 2.0f * fe * sp_0[i];"));
+    EXPECT_FALSE(contains(cart, "double"));
+
+    // mixed: float primitive inputs, double contracted result and constants.
+    const auto sph = format_vrr_spherical_kernel(2, cfg::Precision::mixed);
+
+    EXPECT_TRUE(contains(sph, "const osfunc::CArray<float>& ss,"));
+    EXPECT_TRUE(contains(sph, "osfunc::CArray<double>& sd)"));
+    EXPECT_TRUE(contains(sph, "const double f3 = std::sqrt(3.0);"));
+
+    const auto sph32 = format_vrr_spherical_kernel(2, cfg::Precision::fp32);
+
+    EXPECT_TRUE(contains(sph32, "const float f3 = std::sqrt(3.0f);"));
+    EXPECT_TRUE(contains(sph32, "sd_2[i] += -0.5f * (pc_x[i] * pc_x[i]"));
+    EXPECT_EQ(format_vrr_spherical_signature(2, cfg::Precision::fp32).find("double"), std::string::npos);
+}
+
+TEST(TwoCenterVrrGeneratorTest, PrecisionTagsFileNames)
+{
+    auto run_config = vrr_config(cfg::RecursionType::vrr_spherical, 1, 1);
+
+    run_config.precision = cfg::Precision::mixed;
+
+    auto dir = generate_in_temp_dir(run_config, "sph_mixed");
+    EXPECT_TRUE(std::filesystem::exists(dir / "ObaraSaikaTwoCenterOverlapVrrSphPMixed.cpp"));
+
+    // the Cartesian kernel is primitive only, so mixed shares the float kernel.
+    run_config.recursion_type = cfg::RecursionType::vrr_cartesian;
+
+    dir = generate_in_temp_dir(run_config, "cart_mixed");
+    EXPECT_TRUE(std::filesystem::exists(dir / "ObaraSaikaTwoCenterOverlapVrrCartPFp32.cpp"));
+    EXPECT_FALSE(std::filesystem::exists(dir / "ObaraSaikaTwoCenterOverlapVrrCartP.cpp"));
+}
@@ -0,0 +1,151 @@
+// LITMUS: An Automated Molecular Integrals Generator
+// Copyright 2022 Z. Rinkevicius, KTH, Sweden.
+
+#ifndef recursion_values_hpp
+#define recursion_values_hpp
+
+#include <array>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "reference_integrals.hpp"
+#include "t2c_defs.hpp"
+
+namespace testing_util {  // testing_util namespace
+
+/// Numerical values of two-center recursion factors for a primitive pair and,
+/// where needed, an external point C.
+class PairFactors
+{
+    /// The bra and ket exponents.
+    long double _a_exp, _b_exp;
+
+    /// The distances P - A, P - B, and P - C.
+    std::array<long double, 3> _pa, _pb, _pc;
+
+public:
+    /// Sets up factors of primitive pair.
+    /// @param prims The bra (a) and ket (b) primitives.
+    /// @param point The external point C.
+    PairFactors(const std::array<refint::Primitive, 2>& prims, const std::array<long double, 3>& point = {})
+        : _a_exp(prims[0].exponent), _b_exp(prims[1].exponent)
+    {
+        const auto eta = _a_exp + _b_exp;
+
+        for (int i = 0; i < 3; i++)
+        {
+            const auto p = (_a_exp * prims[0].center[i] + _b_exp * prims[1].center[i]) / eta;
+
+            _pa[i] = p - prims[0].center[i];
+
+            _pb[i] = p - prims[1].center[i];
+
+            _pc[i] = p - point[i];
+        }
+    }
+
+    /// Gets value of recursion factor.
+    /// @param fact The recursion factor.
+    /// @return The value of factor.
+    long double
+    value(const Factor& fact) const
+    {
+        const auto name = fact.name();
+
+        const auto eta = _a_exp + _b_exp;
+
+        const auto zeta = _a_exp * _b_exp / eta;
+
+        const auto axis = fact.label().back() - 'x';
+
+        if (name == "PA") return _pa[axis];
+
+        if (name == "PB") return _pb[axis];
+
+        if (name == "PC") return _pc[axis];
+
+        if (name == "1/eta") return 0.5L / eta;
+
+        if (name == "zeta") return zeta;
+
+        if (name == "b_e") return _a_exp;
+
+        if (name == "k_e") return _b_exp;
+
+        if (name == "1/b_e") return 0.5L / _a_exp;
+
+        if (name == "1/k_e") return 0.5L / _b_exp;
+
+        if (name == "zeta/b_e^2") return 0.5L * zeta / (_a_exp * _a_exp);
+
+        if (name == "zeta/k_e^2") return 0.5L * zeta / (_b_exp * _b_exp);
+
+        throw std::invalid_argument("Unknown recursion factor: " + name);
+    }
+};
+
+/// Gets primitives carrying Cartesian powers of recursion term components.
+/// @param term The recursion term.
+/// @param prims The bra (a) and ket (b) primitives.
+/// @return The primitives with powers of term.
+inline std::array<refint::Primitive, 2>
+term_primitives(const R2CTerm& term, std::array<refint::Primitive, 2> prims)
+{
+    for (int i = 0; i < 2; i++)
+    {
+        prims[i].powers = {term[i]['x'], term[i]['y'], term[i]['z']};
+    }
+
+    return prims;
+}
+
+/// Numerically evaluates recursion term: terms are expanded by driver until it
+/// returns std::nullopt, then leaf integrals are summed with their prefactors
+/// and numerical values of recursion factors.
+/// @param term The recursion term.
+/// @param factors The numerical values of recursion factors.
+/// @param expand The callable expanding term, or returning std::nullopt for leaf term.
+/// @param leaf The callable evaluating leaf term without prefactor and factors.
+/// @return The value of recursion term.
+template <class Expand, class Leaf>
+long double
+evaluate_recursion(const R2CTerm& term, const PairFactors& factors, const Expand& expand, const Leaf& leaf)
+{
+    std::vector<R2CTerm> work{term};
+
+    long double value = 0.0L;
+
+    while (!work.empty())
+    {
+        std::vector<R2CTerm> next;
+
+        for (const auto& tterm : work)
+        {
+            if (const std::optional<R2CDist> dist = expand(tterm))
+            {
+                for (size_t i = 0; i < dist->terms(); i++) next.push_back((*dist)[i]);
+
+                continue;
+            }
+
+            auto tval = static_cast<long double>(tterm.prefactor().numerator()) / tterm.prefactor().denominator();
+
+            for (const auto& fact : tterm.factors())
+            {
+                for (int n = 0; n < tterm.factor_order(fact); n++) tval *= factors.value(fact);
+            }
+
+            value += tval * leaf(tterm);
+        }
+
+        work = next;
+    }
+
+    return value;
+}
+
+}  // namespace testing_util
+
+#endif /* recursion_values_hpp */
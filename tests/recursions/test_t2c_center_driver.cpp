@@ -3,9 +3,16 @@
 
 #include <gtest/gtest.h>
 
+#include <array>
+#include <optional>
+#include <random>
 #include <set>
 #include <string>
+#include <utility>
+#include <vector>
 
+#include "recursion_values.hpp"
+#include "reference_integrals.hpp"
 #include "t2c_center_driver.hpp"
 #include "t2c_defs.hpp"
 
@@ -48,6 +55,46 @@ std::set<std::string> factor_names(const R2CDist& dist)
 const TensorComponent S(0, 0, 0);
 const TensorComponent Px(1, 0, 0);
 
+// Numerically evaluates the geometric-derivative recursion of
+// (d/dA^p0 a|d/dB^p1 b) for a primitive pair: reduces the bra prefix and then
+// the ket prefix with the driver and sums the reduced overlap terms.
+long double evaluate_recursion(const T2CCenterDriver& drv, const std::array<refint::Primitive, 2>& prims,
+                               const TensorComponent& p0, const TensorComponent& p1)
+{
+    const auto& [ax, ay, az] = prims[0].powers;
+    const auto& [bx, by, bz] = prims[1].powers;
+
+    const auto expand = [&](const R2CTerm& term) -> std::optional<R2CDist> {
+        for (const int index : {0, 1})
+        {
+            if (!drv.is_auxilary(term, index)) return drv.apply_bra_ket_vrr(term, index);
+        }
+
+        return std::nullopt;
+    };
+
+    const auto leaf = [&](const R2CTerm& term) { return refint::overlap(testing_util::term_primitives(term, prims)); };
+
+    return testing_util::evaluate_recursion(center_term(TensorComponent(ax, ay, az), TensorComponent(bx, by, bz), p0, p1),
+                                            testing_util::PairFactors(prims), expand, leaf);
+}
+
+// Reference geometric derivatives of overlap for the bra/ket prefix shapes.
+std::vector<refint::GeomDerivative> geom_derivatives(const TensorComponent& p0, const TensorComponent& p1)
+{
+    std::vector<refint::GeomDerivative> drvs;
+
+    for (const auto& [index, prefix] : {std::pair{0, p0}, std::pair{1, p1}})
+    {
+        for (int axis = 0; axis < 3; axis++)
+        {
+            for (int n = 0; n < prefix["xyz"[axis]]; n++) drvs.push_back({index, axis});
+        }
+    }
+
+    return drvs;
+}
+
 }  // namespace
 
 TEST(T2CCenterDriverTest, IsAuxilaryFromPrefixOrder)
@@ -111,3 +158,35 @@ TEST(T2CCenterDriverTest, CreateRecursionBuildsOneExpansionPerIntegral)
 
     EXPECT_EQ(drv.create_recursion(vints).expansions(), 1u);
 }
+
+TEST(T2CCenterDriverTest, RecursionMatchesReferenceIntegrals)
+{
+    const T2CCenterDriver drv;
+
+    std::mt19937 engine(2026);
+
+    refint::ErrorStats stats;
+
+    const auto ovl = [](const std::array<refint::Primitive, 2>& prims) { return refint::overlap(prims); };
+
+    const std::vector<std::pair<TensorComponent, TensorComponent>> prefixes = {
+        {Px, S}, {S, TensorComponent(0, 1, 0)}, {Px, TensorComponent(0, 0, 1)}, {TensorComponent(1, 1, 0), Px}};
+
+    for (int la = 0; la <= 2; la++)
+    {
+        for (int lb = 0; lb <= 2; lb++)
+        {
+            for (const auto& [p0, p1] : prefixes)
+            {
+                const std::array<refint::Primitive, 2> prims = {refint::random_primitive(engine, la),
+                                                                refint::random_primitive(engine, lb)};
+
+                stats.add(static_cast<double>(evaluate_recursion(drv, prims, p0, p1)),
+                          refint::geom_derivative(ovl, prims, geom_derivatives(p0, p1)));
+            }
+        }
+    }
+
+    EXPECT_EQ(stats.count(), 36u);
+    EXPECT_LT(stats.max_abs(), 1.0e-12) << stats.summary();
+}
@@ -3,9 +3,14 @@
 
 #include <gtest/gtest.h>
 
+#include <array>
+#include <optional>
+#include <random>
 #include <set>
 #include <string>
 
+#include "recursion_values.hpp"
+#include "reference_integrals.hpp"
 #include "t2c_eri_driver.hpp"
 #include "t2c_defs.hpp"
 
@@ -32,6 +37,58 @@ std::set<std::string> factor_names(const R2CDist& dist)
     return names;
 }
 
+// Two-center electron repulsion integral (a|1/|r-r'||b), taken from the
+// four-center reference with unit (zero exponent) s functions on A and B.
+long double eri_reference(const std::array<refint::Primitive, 2>& prims)
+{
+    refint::Primitive sa, sb;
+
+    sa.exponent = 0.0L;
+
+    sa.center = prims[0].center;
+
+    sb.exponent = 0.0L;
+
+    sb.center = prims[1].center;
+
+    return refint::electron_repulsion({prims[0], sa, prims[1], sb});
+}
+
+// Numerically evaluates the electron-repulsion recursion of (a|1/|r-r'||b) for a
+// primitive pair: reduces the term to (s|s)^(m) with the driver, taking
+// (s|s)^(m) = (s|s) F_m(T) / F_0(T) with T = zeta |AB|^2.
+long double evaluate_recursion(const T2CElectronRepulsionDriver& drv, const std::array<refint::Primitive, 2>& prims)
+{
+    const auto& [ax, ay, az] = prims[0].powers;
+    const auto& [bx, by, bz] = prims[1].powers;
+
+    const auto expand = [&](const R2CTerm& term) -> std::optional<R2CDist> {
+        if ((term[0].order() + term[1].order()) == 0) return std::nullopt;
+
+        return (term[0].order() > 0) ? drv.apply_bra_vrr(term) : drv.apply_ket_vrr(term);
+    };
+
+    const auto zeta = prims[0].exponent * prims[1].exponent / (prims[0].exponent + prims[1].exponent);
+
+    long double targ = 0.0L;
+
+    for (int i = 0; i < 3; i++)
+    {
+        const auto ab = prims[0].center[i] - prims[1].center[i];
+
+        targ += zeta * ab * ab;
+    }
+
+    const auto leaf = [&](const R2CTerm& term) {
+        const auto fss = eri_reference(testing_util::term_primitives(term, prims));
+
+        return fss * refint::boys_function(term.order(), targ) / refint::boys_function(0, targ);
+    };
+
+    return testing_util::evaluate_recursion(eri_term(TensorComponent(ax, ay, az), TensorComponent(bx, by, bz)),
+                                            testing_util::PairFactors(prims), expand, leaf);
+}
+
 }  // namespace
 
 TEST(T2CElectronRepulsionDriverTest, IsElectronRepulsion)
@@ -102,3 +159,29 @@ TEST(T2CElectronRepulsionDriverTest, CreateRecursionBuildsOneExpansionPerIntegra
 
     EXPECT_EQ(drv.create_recursion(vints).expansions(), 1u);
 }
+
+TEST(T2CElectronRepulsionDriverTest, RecursionMatchesReferenceIntegrals)
+{
+    const T2CElectronRepulsionDriver drv;
+
+    std::mt19937 engine(2025);
+
+    refint::ErrorStats stats;
+
+    for (int la = 0; la <= 3; la++)
+    {
+        for (int lb = 0; lb <= 3; lb++)
+        {
+            for (int sample = 0; sample < 4; sample++)
+            {
+                const std::array<refint::Primitive, 2> prims = {refint::random_primitive(engine, la),
+                                                                refint::random_primitive(engine, lb)};
+
+                stats.add(static_cast<double>(evaluate_recursion(drv, prims)), eri_reference(prims));
+            }
+        }
+    }
+
+    EXPECT_EQ(stats.count(), 64u);
+    EXPECT_LT(stats.max_abs(), 1.0e-12) << stats.summary();
+}
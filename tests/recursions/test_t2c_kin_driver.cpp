@@ -3,9 +3,14 @@
 
 #include <gtest/gtest.h>
 
+#include <array>
+#include <optional>
+#include <random>
 #include <set>
 #include <string>
 
+#include "recursion_values.hpp"
+#include "reference_integrals.hpp"
 #include "t2c_kin_driver.hpp"
 #include "t2c_defs.hpp"
 
@@ -40,6 +45,32 @@ std::set<std::string> term_operators(const R2CDist& dist)
     return names;
 }
 
+// Numerically evaluates the kinetic-energy recursion of (a|T|b) for a primitive
+// pair: reduces kinetic terms to (s|T|s) with the driver and sums them with the
+// overlap terms, both taken from reference integrals.
+long double evaluate_recursion(const T2CKineticEnergyDriver& drv, const std::array<refint::Primitive, 2>& prims)
+{
+    const auto& [ax, ay, az] = prims[0].powers;
+    const auto& [bx, by, bz] = prims[1].powers;
+
+    const auto expand = [&](const R2CTerm& term) -> std::optional<R2CDist> {
+        if (term.integrand().name() != "T") return std::nullopt;
+
+        if ((term[0].order() + term[1].order()) == 0) return std::nullopt;
+
+        return (term[0].order() > 0) ? drv.apply_bra_vrr(term) : drv.apply_ket_vrr(term);
+    };
+
+    const auto leaf = [&](const R2CTerm& term) {
+        const auto tprims = testing_util::term_primitives(term, prims);
+
+        return (term.integrand().name() == "T") ? refint::kinetic_energy(tprims) : refint::overlap(tprims);
+    };
+
+    return testing_util::evaluate_recursion(kin_term(TensorComponent(ax, ay, az), TensorComponent(bx, by, bz)),
+                                            testing_util::PairFactors(prims), expand, leaf);
+}
+
 }  // namespace
 
 TEST(T2CKineticEnergyDriverTest, IsKineticEnergy)
@@ -111,3 +142,29 @@ TEST(T2CKineticEnergyDriverTest, CreateRecursionBuildsOneExpansionPerIntegral)
 
     EXPECT_EQ(drv.create_recursion(vints).expansions(), 1u);
 }
+
+TEST(T2CKineticEnergyDriverTest, RecursionMatchesReferenceIntegrals)
+{
+    const T2CKineticEnergyDriver drv;
+
+    std::mt19937 engine(2023);
+
+    refint::ErrorStats stats;
+
+    for (int la = 0; la <= 3; la++)
+    {
+        for (int lb = 0; lb <= 3; lb++)
+        {
+            for (int sample = 0; sample < 4; sample++)
+            {
+                const std::array<refint::Primitive, 2> prims = {refint::random_primitive(engine, la),
+                                                                refint::random_primitive(engine, lb)};
+
+                stats.add(static_cast<double>(evaluate_recursion(drv, prims)), refint::kinetic_energy(prims));
+            }
+        }
+    }
+
+    EXPECT_EQ(stats.count(), 64u);
+    EXPECT_LT(stats.max_abs(), 1.0e-12) << stats.summary();
+}
@@ -4,9 +4,14 @@
 #include <gtest/gtest.h>
 
 #include <algorithm>
+#include <array>
+#include <optional>
+#include <random>
 #include <set>
 #include <string>
 
+#include "recursion_values.hpp"
+#include "reference_integrals.hpp"
 #include "t2c_npot_driver.hpp"
 #include "t2c_defs.hpp"
 
@@ -42,6 +47,43 @@ int max_term_order(const R2CDist& dist)
     return order;
 }
 
+// Numerically evaluates the nuclear-potential recursion of (a|A|b) for a
+// primitive pair and a unit charge at C: reduces the term to (s|A|s)^(m) with
+// the driver, taking (s|A|s)^(m) = (s|A|s) F_m(T) / F_0(T) with T = (a + b) |PC|^2.
+long double evaluate_recursion(const T2CNuclearPotentialDriver&   drv,
+                               const std::array<refint::Primitive, 2>& prims,
+                               const std::array<long double, 3>&       point)
+{
+    const auto& [ax, ay, az] = prims[0].powers;
+    const auto& [bx, by, bz] = prims[1].powers;
+
+    const auto expand = [&](const R2CTerm& term) -> std::optional<R2CDist> {
+        if ((term[0].order() + term[1].order()) == 0) return std::nullopt;
+
+        return (term[0].order() > 0) ? drv.apply_bra_vrr(term) : drv.apply_ket_vrr(term);
+    };
+
+    const auto eta = prims[0].exponent + prims[1].exponent;
+
+    long double targ = 0.0L;
+
+    for (int i = 0; i < 3; i++)
+    {
+        const auto pc = (prims[0].exponent * prims[0].center[i] + prims[1].exponent * prims[1].center[i]) / eta - point[i];
+
+        targ += eta * pc * pc;
+    }
+
+    const auto leaf = [&](const R2CTerm& term) {
+        const auto fss = refint::nuclear_potential(testing_util::term_primitives(term, prims), point);
+
+        return fss * refint::boys_function(term.order(), targ) / refint::boys_function(0, targ);
+    };
+
+    return testing_util::evaluate_recursion(npot_term(TensorComponent(ax, ay, az), TensorComponent(bx, by, bz)),
+                                            testing_util::PairFactors(prims, point), expand, leaf);
+}
+
 }  // namespace
 
 TEST(T2CNuclearPotentialDriverTest, IsNuclearPotential)
@@ -120,3 +162,32 @@ TEST(T2CNuclearPotentialDriverTest, CreateRecursionBuildsOneExpansionPerIntegral
 
     EXPECT_EQ(drv.create_recursion(vints).expansions(), 1u);
 }
+
+TEST(T2CNuclearPotentialDriverTest, RecursionMatchesReferenceIntegrals)
+{
+    const T2CNuclearPotentialDriver drv;
+
+    std::mt19937 engine(2024);
+
+    refint::ErrorStats stats;
+
+    for (int la = 0; la <= 3; la++)
+    {
+        for (int lb = 0; lb <= 3; lb++)
+        {
+            for (int sample = 0; sample < 4; sample++)
+            {
+                const std::array<refint::Primitive, 2> prims = {refint::random_primitive(engine, la),
+                                                                refint::random_primitive(engine, lb)};
+
+                const auto point = refint::random_primitive(engine, 0).center;
+
+                stats.add(static_cast<double>(evaluate_recursion(drv, prims, point)),
+                          refint::nuclear_potential(prims, point));
+            }
+        }
+    }
+
+    EXPECT_EQ(stats.count(), 64u);
+    EXPECT_LT(stats.max_abs(), 1.0e-12) << stats.summary();
+}
@@ -3,9 +3,15 @@
 
 #include <gtest/gtest.h>
 
+#include <array>
+#include <optional>
+#include <random>
 #include <set>
 #include <string>
+#include <vector>
 
+#include "recursion_values.hpp"
+#include "reference_integrals.hpp"
 #include "t2c_ovl_driver.hpp"
 #include "t2c_defs.hpp"
 
@@ -30,6 +36,26 @@ std::set<std::string> factor_names(const R2CDist& dist)
     return names;
 }
 
+// Numerically evaluates the overlap recursion of (a|b) for a primitive pair:
+// fully reduces the term to (s|s) with the driver and sums the reduced terms
+// with reference (s|s).
+long double evaluate_recursion(const T2COverlapDriver& drv, const std::array<refint::Primitive, 2>& prims)
+{
+    const auto& [ax, ay, az] = prims[0].powers;
+    const auto& [bx, by, bz] = prims[1].powers;
+
+    const auto expand = [&](const R2CTerm& term) -> std::optional<R2CDist> {
+        if ((term[0].order() + term[1].order()) == 0) return std::nullopt;
+
+        return (term[0].order() > 0) ? drv.apply_bra_vrr(term) : drv.apply_ket_vrr(term);
+    };
+
+    const auto leaf = [&](const R2CTerm& term) { return refint::overlap(testing_util::term_primitives(term, prims)); };
+
+    return testing_util::evaluate_recursion(ovl_term(TensorComponent(ax, ay, az), TensorComponent(bx, by, bz)),
+                                            testing_util::PairFactors(prims), expand, leaf);
+}
+
 }  // namespace
 
 TEST(T2COverlapDriverTest, IsOverlap)
@@ -114,3 +140,29 @@ TEST(T2COverlapDriverTest, CreateRecursionBuildsOneExpansionPerIntegral)
 
     EXPECT_EQ(group.expansions(), 1u);
 }
+
+TEST(T2COverlapDriverTest, RecursionMatchesReferenceIntegrals)
+{
+    const T2COverlapDriver drv;
+
+    std::mt19937 engine(2022);
+
+    refint::ErrorStats stats;
+
+    for (int la = 0; la <= 3; la++)
+    {
+        for (int lb = 0; lb <= 3; lb++)
+        {
+            for (int sample = 0; sample < 4; sample++)
+            {
+                const std::array<refint::Primitive, 2> prims = {refint::random_primitive(engine, la),
+                                                                refint::random_primitive(engine, lb)};
+
+                stats.add(static_cast<double>(evaluate_recursion(drv, prims)), refint::overlap(prims));
+            }
+        }
+    }
+
+    EXPECT_EQ(stats.count(), 64u);
+    EXPECT_LT(stats.max_abs(), 1.0e-13) << stats.summary();
+}
@@ -3,9 +3,15 @@
 
 #include <gtest/gtest.h>
 
+#include <array>
+#include <cmath>
+#include <map>
+#include <random>
 #include <set>
 #include <string>
+#include <vector>
 
+#include "reference_integrals.hpp"
 #include "t4c_center_driver.hpp"
 #include "t4c_defs.hpp"
 
@@ -121,3 +127,112 @@ TEST(T4CCenterDriverTest, CreateRecursionBuildsOneExpansionPerIntegral)
 
     EXPECT_EQ(drv.create_recursion(vints).expansions(), 1u);
 }
+
+namespace {
+
+const std::array<char, 3> axes = {'x', 'y', 'z'};
+
+// Evaluates a center expansion numerically: each term is its prefactor times the
+// exponent factors times the prefix-free reference ERI over shifted primitives.
+long double evaluate(const R4CDist& dist, const std::array<refint::Primitive, 4>& prims)
+{
+    const std::map<std::string, std::size_t> centers = {{"ba_e", 0}, {"bb_e", 1}, {"kc_e", 2}, {"kd_e", 3}};
+
+    long double value = 0.0L;
+
+    for (size_t i = 0; i < dist.terms(); i++)
+    {
+        const auto term = dist[i];
+
+        const auto tint = term.integral();
+
+        for (const auto order : tint.prefixes_order())
+        {
+            EXPECT_EQ(order, 0);
+        }
+
+        auto shifted = prims;
+
+        for (int j = 0; j < 4; j++)
+        {
+            for (int k = 0; k < 3; k++)
+            {
+                shifted[j].powers[k] = tint[j][axes[k]];
+            }
+        }
+
+        const auto frac = term.prefactor();
+
+        auto fact = static_cast<long double>(frac.numerator()) / frac.denominator();
+
+        for (const auto& factor : term.factors())
+        {
+            fact *= std::pow(prims[centers.at(factor.name())].exponent, term.factor_order(factor));
+        }
+
+        value += fact * refint::electron_repulsion(shifted);
+    }
+
+    return value;
+}
+
+// Unrolls the per-center prefix shapes into reference derivative requests.
+std::vector<refint::GeomDerivative> derivatives(const std::array<TensorComponent, 4>& prefixes)
+{
+    std::vector<refint::GeomDerivative> drvs;
+
+    for (std::size_t i = 0; i < 4; i++)
+    {
+        for (int k = 0; k < 3; k++)
+        {
+            for (int n = 0; n < prefixes[i][axes[k]]; n++) drvs.push_back({i, k});
+        }
+    }
+
+    return drvs;
+}
+
+}  // namespace
+
+TEST(T4CCenterDriverTest, ThirdOrderExpansionsMatchReference)
+{
+    const T4CCenterDriver drv;
+
+    std::mt19937 engine(13);
+
+    const TensorComponent Py(0, 1, 0);
+    const TensorComponent Dxz(1, 0, 1);
+
+    const auto eri = [](const std::array<refint::Primitive, 4>& prims) { return refint::electron_repulsion(prims); };
+
+    // third derivatives on a single center, split over three centers, and 2 + 1
+    const std::vector<std::array<TensorComponent, 4>> patterns = {{TensorComponent(2, 1, 0), S, S, S},
+                                                                  {Px, Py, TensorComponent(0, 0, 1), S},
+                                                                  {S, Dxz, S, Py},
+                                                                  {S, S, S, TensorComponent(0, 0, 3)}};
+
+    const std::array<TensorComponent, 4> shells = {Px, S, Dxz, Py};
+
+    std::array<refint::Primitive, 4> prims;
+
+    for (int i = 0; i < 4; i++)
+    {
+        prims[i] = refint::random_primitive(engine, 0);
+
+        for (int k = 0; k < 3; k++) prims[i].powers[k] = shells[i][axes[k]];
+    }
+
+    for (const auto& pattern : patterns)
+    {
+        const auto tint = center_term(shells[0], shells[1], shells[2], shells[3],
+                                      pattern[0], pattern[1], pattern[2], pattern[3]).integral();
+
+        const auto rgroup = drv.create_recursion(VT4CIntegrals({tint}));
+
+        ASSERT_EQ(rgroup.expansions(), 1u);
+
+        const auto ref = refint::geom_derivative(eri, prims, derivatives(pattern));
+
+        EXPECT_NEAR(static_cast<double>(evaluate(rgroup[0], prims) / ref), 1.0, 1.0e-12);
+    }
+}